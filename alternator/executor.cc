@@ -1914,12 +1914,23 @@ static future<> do_batch_write(service::storage_proxy& proxy,
         return rmw_operation::get_write_isolation_for_schema(schema) == rmw_operation::write_isolation::LWT_ALWAYS;
     });
     if (!needs_lwt) {
-        // Do a normal write, without LWT:
+        // Do a normal write, without LWT.
+        // Items of the same partition are joined into one mutation, so the
+        // coordinator sends one write per partition to each replica rather
+        // than one per item.
         std::vector<mutation> mutations;
         mutations.reserve(mutation_builders.size());
+        std::unordered_map<schema_decorated_key, size_t, schema_decorated_key_hash, schema_decorated_key_equal>
+            partition_mutations(mutation_builders.size(), schema_decorated_key_hash{}, schema_decorated_key_equal{});
         api::timestamp_type now = api::new_timestamp();
         for (auto& b : mutation_builders) {
-            mutations.push_back(b.second.build(b.first, now));
+            auto m = b.second.build(b.first, now);
+            auto [it, added] = partition_mutations.try_emplace(schema_decorated_key{b.first, m.decorated_key()}, mutations.size());
+            if (added) {
+                mutations.push_back(std::move(m));
+            } else {
+                mutations[it->second].apply(std::move(m));
+            }
         }
         return proxy.mutate(std::move(mutations),
                 db::consistency_level::LOCAL_QUORUM,
@@ -3259,36 +3270,60 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
 
     // If we got here, all "requests" are valid, so let's start the
     // requests for the different partitions all in parallel.
-    std::vector<future<std::vector<rjson::value>>> response_futures;
+    // Tables without a clustering key read every item of the partition,
+    // so all their partitions can share one read command, with one range
+    // per partition, and one result to convert. The clustering key
+    // bounds of a slice can't differ by partition, so tables with a
+    // clustering key still get one read per partition.
+    struct read_group {
+        const table_requests* rs;
+        // Pointers to entries of rs->requests
+        std::vector<const decltype(table_requests::requests)::value_type*> partitions;
+    };
+    std::vector<read_group> groups;
     for (const auto& rs : requests) {
-        for (const auto &r : rs.requests) {
-            auto& pk = r.first;
-            auto& cks = r.second;
-            dht::partition_range_vector partition_ranges{dht::partition_range(dht::decorate_key(*rs.schema, pk))};
-            std::vector<query::clustering_range> bounds;
-            if (rs.schema->clustering_key_size() == 0) {
-                bounds.push_back(query::clustering_range::make_open_ended_both_sides());
-            } else {
-                for (auto& ck : cks) {
-                    bounds.push_back(query::clustering_range::make_singular(ck.first));
-                }
+        if (rs.schema->clustering_key_size() == 0) {
+            auto& g = groups.emplace_back(read_group{&rs, {}});
+            for (const auto& r : rs.requests) {
+                g.partitions.push_back(&r);
+            }
+        } else {
+            for (const auto& r : rs.requests) {
+                groups.push_back(read_group{&rs, {&r}});
             }
-            auto regular_columns = boost::copy_range<query::column_id_vector>(
-                    rs.schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
-            auto selection = cql3::selection::selection::wildcard(rs.schema);
-            auto partition_slice = query::partition_slice(std::move(bounds), {}, std::move(regular_columns), selection->get_query_options());
-            auto command = ::make_lw_shared<query::read_command>(rs.schema->id(), rs.schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
-                    query::tombstone_limit(_proxy.get_tombstone_limit()));
-            command->allow_limit = db::allow_per_partition_rate_limit::yes;
-            future<std::vector<rjson::value>> f = _proxy.query(rs.schema, std::move(command), std::move(partition_ranges), rs.cl,
-                    service::storage_proxy::coordinator_query_options(executor::default_timeout(), permit, client_state, trace_state)).then(
-                    [schema = rs.schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = rs.attrs_to_get] (service::storage_proxy::coordinator_query_result qr) mutable {
-                utils::get_local_injector().inject("alternator_batch_get_item", [] { throw std::runtime_error("batch_get_item injection"); });
-                return describe_multi_item(std::move(schema), std::move(partition_slice), std::move(selection), std::move(qr.query_result), std::move(attrs_to_get));
-            });
-            response_futures.push_back(std::move(f));
         }
     }
+    std::vector<future<std::vector<rjson::value>>> response_futures;
+    for (const auto& g : groups) {
+        const auto& rs = *g.rs;
+        dht::partition_range_vector partition_ranges;
+        partition_ranges.reserve(g.partitions.size());
+        for (auto* r : g.partitions) {
+            partition_ranges.emplace_back(dht::decorate_key(*rs.schema, r->first));
+        }
+        std::vector<query::clustering_range> bounds;
+        if (rs.schema->clustering_key_size() == 0) {
+            bounds.push_back(query::clustering_range::make_open_ended_both_sides());
+        } else {
+            for (auto& ck : g.partitions.front()->second) {
+                bounds.push_back(query::clustering_range::make_singular(ck.first));
+            }
+        }
+        auto regular_columns = boost::copy_range<query::column_id_vector>(
+                rs.schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
+        auto selection = cql3::selection::selection::wildcard(rs.schema);
+        auto partition_slice = query::partition_slice(std::move(bounds), {}, std::move(regular_columns), selection->get_query_options());
+        auto command = ::make_lw_shared<query::read_command>(rs.schema->id(), rs.schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
+                query::tombstone_limit(_proxy.get_tombstone_limit()));
+        command->allow_limit = db::allow_per_partition_rate_limit::yes;
+        future<std::vector<rjson::value>> f = _proxy.query(rs.schema, std::move(command), std::move(partition_ranges), rs.cl,
+                service::storage_proxy::coordinator_query_options(executor::default_timeout(), permit, client_state, trace_state)).then(
+                [schema = rs.schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = rs.attrs_to_get] (service::storage_proxy::coordinator_query_result qr) mutable {
+            utils::get_local_injector().inject("alternator_batch_get_item", [] { throw std::runtime_error("batch_get_item injection"); });
+            return describe_multi_item(std::move(schema), std::move(partition_slice), std::move(selection), std::move(qr.query_result), std::move(attrs_to_get));
+        });
+        response_futures.push_back(std::move(f));
+    }
 
     // Wait for all requests to complete, and then return the response.
     // In case of full failure (no reads succeeded), an arbitrary error
@@ -3301,42 +3336,41 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
     rjson::add(response, "UnprocessedKeys", rjson::empty_object());
 
     auto fut_it = response_futures.begin();
-    for (const auto& rs : requests) {
-        auto table = table_name(*rs.schema);
-        for (const auto &r : rs.requests) {
-            auto& pk = r.first;
-            auto& cks = r.second;
-            auto& fut = *fut_it;
-            ++fut_it;
-            try {
-                std::vector<rjson::value> results = co_await std::move(fut);
-                some_succeeded = true;
-                if (!response["Responses"].HasMember(table)) {
-                    rjson::add_with_string_name(response["Responses"], table, rjson::empty_array());
-                }
-                for (rjson::value& json : results) {
-                    rjson::push_back(response["Responses"][table], std::move(json));
-                }
-            } catch(...) {
-                eptr = std::current_exception();
-                // This read of potentially several rows in one partition,
-                // failed. We need to add the row key(s) to UnprocessedKeys.
-                if (!response["UnprocessedKeys"].HasMember(table)) {
-                    // Add the table's entry in UnprocessedKeys. Need to copy
-                    // all the table's parameters from the request except the
-                    // Keys field, which we start empty and then build below.
-                    rjson::add_with_string_name(response["UnprocessedKeys"], table, rjson::empty_object());
-                    rjson::value& unprocessed_item = response["UnprocessedKeys"][table];
-                    rjson::value& request_item = request_items[table];
-                    for (auto it = request_item.MemberBegin(); it != request_item.MemberEnd(); ++it) {
-                        if (it->name != "Keys") {
-                            rjson::add_with_string_name(unprocessed_item,
-                                rjson::to_string_view(it->name), rjson::copy(it->value));
-                        }
+    for (const auto& g : groups) {
+        auto table = table_name(*g.rs->schema);
+        auto& fut = *fut_it;
+        ++fut_it;
+        try {
+            std::vector<rjson::value> results = co_await std::move(fut);
+            some_succeeded = true;
+            if (!response["Responses"].HasMember(table)) {
+                rjson::add_with_string_name(response["Responses"], table, rjson::empty_array());
+            }
+            for (rjson::value& json : results) {
+                rjson::push_back(response["Responses"][table], std::move(json));
+            }
+        } catch(...) {
+            eptr = std::current_exception();
+            // This read of potentially several rows in one or more
+            // partitions failed. We need to add the row key(s) to
+            // UnprocessedKeys.
+            if (!response["UnprocessedKeys"].HasMember(table)) {
+                // Add the table's entry in UnprocessedKeys. Need to copy
+                // all the table's parameters from the request except the
+                // Keys field, which we start empty and then build below.
+                rjson::add_with_string_name(response["UnprocessedKeys"], table, rjson::empty_object());
+                rjson::value& unprocessed_item = response["UnprocessedKeys"][table];
+                rjson::value& request_item = request_items[table];
+                for (auto it = request_item.MemberBegin(); it != request_item.MemberEnd(); ++it) {
+                    if (it->name != "Keys") {
+                        rjson::add_with_string_name(unprocessed_item,
+                            rjson::to_string_view(it->name), rjson::copy(it->value));
                     }
-                    rjson::add_with_string_name(unprocessed_item, "Keys", rjson::empty_array());
                 }
-                for (auto& ck : cks) {
+                rjson::add_with_string_name(unprocessed_item, "Keys", rjson::empty_array());
+            }
+            for (auto* r : g.partitions) {
+                for (auto& ck : r->second) {
                     rjson::push_back(response["UnprocessedKeys"][table]["Keys"], std::move(*ck.second));
                 }
             }
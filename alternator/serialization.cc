@@ -190,14 +190,23 @@ bytes serialize_item(const rjson::value& item) {
     }
     auto it = item.MemberBegin();
     type_info type_info = type_info_from_string(rjson::to_string_view(it->name)); // JSON keys are guaranteed to be strings
+    const int8_t type_byte = int8_t(type_info.atype);
 
     if (type_info.atype == alternator_type::NOT_SUPPORTED_YET) {
         slogger.trace("Non-optimal serialization of type {}", it->name);
-        return bytes{int8_t(type_info.atype)} + to_bytes(rjson::print(item));
+        return rjson::print_to_bytes(item, bytes_view(&type_byte, 1));
+    }
+    // Strings are the most common attributes, serialize them with a single allocation
+    if (type_info.atype == alternator_type::S && it->value.IsString()) {
+        auto str = rjson::to_string_view(it->value);
+        bytes ret(bytes::initialized_later(), 1 + str.size());
+        ret[0] = type_byte;
+        std::copy_n(reinterpret_cast<const int8_t*>(str.data()), str.size(), ret.begin() + 1);
+        return ret;
     }
 
     bytes_ostream bo;
-    bo.write(bytes{int8_t(type_info.atype)});
+    bo.write(bytes_view(&type_byte, 1));
     visit(*type_info.dtype, from_json_visitor{it->value, bo});
 
     return bytes(bo.linearize());
@@ -210,7 +219,7 @@ struct to_json_visitor {
 
     void operator()(const reversed_type_impl& t) const { visit(*t.underlying_type(), to_json_visitor{deserialized, type_ident, bv}); };
     void operator()(const decimal_type_impl& t) const {
-        auto s = to_json_string(*decimal_type, bytes(bv));
+        auto s = to_json_string(*decimal_type, bv);
         //FIXME(sarna): unnecessary copy
         rjson::add_with_string_name(deserialized, type_ident, rjson::from_string(s));
     }
@@ -221,9 +230,16 @@ struct to_json_visitor {
         std::string b64 = base64_encode(bv);
         rjson::add_with_string_name(deserialized, type_ident, rjson::from_string(b64));
     }
+    void operator()(const boolean_type_impl& t) const {
+        if (bv.size() != 1) {
+            rjson::add_with_string_name(deserialized, type_ident, rjson::parse(to_json_string(t, bv)));
+            return;
+        }
+        rjson::add_with_string_name(deserialized, type_ident, rjson::value(bv[0] != 0));
+    }
     // default
     void operator()(const abstract_type& t) const {
-        rjson::add_with_string_name(deserialized, type_ident, rjson::parse(to_json_string(t, bytes(bv))));
+        rjson::add_with_string_name(deserialized, type_ident, rjson::parse(to_json_string(t, bv)));
     }
 };
 
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <map>
 #include <type_traits>
 #include <boost/lexical_cast.hpp>
 #include <boost/io/ios_state.hpp>
@@ -805,7 +806,99 @@ struct rapidjson::internal::TypeHelper<ValueType, alternator::event_id>
 {};
 
 namespace alternator {
-    
+
+static const bytes timestamp_column_name = cdc::log_meta_column_name_bytes("time");
+static const bytes op_column_name = cdc::log_meta_column_name_bytes("operation");
+static const bytes eor_column_name = cdc::log_meta_column_name_bytes("end_of_batch");
+
+// What GetRecords reads from a CDC log table and how it converts the rows
+// to records. It only depends on the schemas of the log and base tables, so
+// it is built once per pair of schema versions, not for each call: stream
+// consumers poll GetRecords on every shard in a tight loop.
+struct get_records_plan {
+    std::optional<attrs_to_get> key_names;
+    std::optional<attrs_to_get> attr_names;
+    query::column_id_vector regular_columns;
+    ::shared_ptr<cql3::selection::selection> selection;
+    stream_view_type type;
+    // How many log rows a record can take: key-only allows for delete + insert
+    unsigned rows_per_record = 2;
+    // Positions of the CDC metadata columns in the result set rows
+    size_t op_index;
+    size_t ts_index;
+    size_t eor_index;
+
+    get_records_plan(const schema_ptr& schema, const schema& base);
+
+    static lw_shared_ptr<const get_records_plan> get(const schema_ptr& schema, const schema_ptr& base);
+};
+
+get_records_plan::get_records_plan(const schema_ptr& schema, const schema& base)
+    : key_names(boost::copy_range<attrs_to_get>(
+        boost::range::join(base.partition_key_columns(), base.clustering_key_columns())
+        | boost::adaptors::transformed([&] (const column_definition& cdef) {
+            return std::make_pair<std::string, attrs_to_get_node>(cdef.name_as_text(), {}); })))
+    // Include all base table columns as values (in case pre or post is enabled).
+    // This will include attributes not stored in the frozen map column
+    , attr_names(boost::copy_range<attrs_to_get>(base.regular_columns()
+        // this will include the :attrs column, which we will also force evaluating.
+        // But not having this set empty forces out any cdc columns from actual result
+        | boost::adaptors::transformed([] (const column_definition& cdef) {
+            return std::make_pair<std::string, attrs_to_get_node>(cdef.name_as_text(), {}); })))
+    , type(cdc_options_to_steam_view_type(base.cdc_options()))
+{
+    std::vector<const column_definition*> columns;
+    columns.reserve(schema->all_columns().size());
+
+    auto pks = schema->partition_key_columns();
+    auto cks = schema->clustering_key_columns();
+
+    std::transform(pks.begin(), pks.end(), std::back_inserter(columns), [](auto& c) { return &c; });
+    std::transform(cks.begin(), cks.end(), std::back_inserter(columns), [](auto& c) { return &c; });
+
+    regular_columns = boost::copy_range<query::column_id_vector>(schema->regular_columns()
+        | boost::adaptors::filtered([](const column_definition& cdef) { return cdef.name() == op_column_name || cdef.name() == eor_column_name || !cdc::is_cdc_metacolumn_name(cdef.name_as_text()); })
+        | boost::adaptors::transformed([&] (const column_definition& cdef) { columns.emplace_back(&cdef); return cdef.id; })
+    );
+
+    selection = cql3::selection::selection::for_columns(schema, std::move(columns));
+
+    auto& opts = base.cdc_options();
+    if (opts.preimage()) {
+        ++rows_per_record;
+    }
+    if (opts.postimage()) {
+        ++rows_per_record;
+    }
+
+    auto& names = selection->get_result_metadata()->get_names();
+    auto index_of = [&] (const bytes& name) -> size_t {
+        return std::distance(names.begin(), std::find_if(names.begin(), names.end(), [&] (const lw_shared_ptr<cql3::column_specification>& cdef) {
+            return cdef->name->name() == name;
+        }));
+    };
+    op_index = index_of(op_column_name);
+    ts_index = index_of(timestamp_column_name);
+    eor_index = index_of(eor_column_name);
+}
+
+lw_shared_ptr<const get_records_plan> get_records_plan::get(const schema_ptr& schema, const schema_ptr& base) {
+    // Entries of dropped or altered tables are not looked up again, drop
+    // them all once there are more than the streams a shard is likely to
+    // serve concurrently.
+    static constexpr size_t max_cached_plans = 256;
+    static thread_local std::map<std::pair<table_schema_version, table_schema_version>, lw_shared_ptr<const get_records_plan>> plans;
+
+    auto key = std::make_pair(schema->version(), base->version());
+    if (auto it = plans.find(key); it != plans.end()) {
+        return it->second;
+    }
+    if (plans.size() >= max_cached_plans) {
+        plans.clear();
+    }
+    return plans.emplace(key, make_lw_shared<const get_records_plan>(schema, *base)).first->second;
+}
+
 future<executor::request_return_type> executor::get_records(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request) {
     _stats.api_operations.get_records++;
     auto start_time = std::chrono::steady_clock::now();
@@ -846,82 +939,29 @@ future<executor::request_return_type> executor::get_records(client_state& client
     using bound = typename query::clustering_range::bound;
     bounds.push_back(query::clustering_range::make(bound(lo, iter.inclusive), bound(hi, false)));
 
-    static const bytes timestamp_column_name = cdc::log_meta_column_name_bytes("time");
-    static const bytes op_column_name = cdc::log_meta_column_name_bytes("operation");
-    static const bytes eor_column_name = cdc::log_meta_column_name_bytes("end_of_batch");
-
-    std::optional<attrs_to_get> key_names = boost::copy_range<attrs_to_get>(
-        boost::range::join(std::move(base->partition_key_columns()), std::move(base->clustering_key_columns()))
-        | boost::adaptors::transformed([&] (const column_definition& cdef) {
-            return std::make_pair<std::string, attrs_to_get_node>(cdef.name_as_text(), {}); })
-    );
-    // Include all base table columns as values (in case pre or post is enabled).
-    // This will include attributes not stored in the frozen map column
-    std::optional<attrs_to_get> attr_names = boost::copy_range<attrs_to_get>(base->regular_columns()
-        // this will include the :attrs column, which we will also force evaluating. 
-        // But not having this set empty forces out any cdc columns from actual result 
-        | boost::adaptors::transformed([] (const column_definition& cdef) {
-            return std::make_pair<std::string, attrs_to_get_node>(cdef.name_as_text(), {}); })
-    );
-
-    std::vector<const column_definition*> columns;
-    columns.reserve(schema->all_columns().size());
-
-    auto pks = schema->partition_key_columns();
-    auto cks = schema->clustering_key_columns();
-
-    std::transform(pks.begin(), pks.end(), std::back_inserter(columns), [](auto& c) { return &c; });
-    std::transform(cks.begin(), cks.end(), std::back_inserter(columns), [](auto& c) { return &c; });
-
-    auto regular_columns = boost::copy_range<query::column_id_vector>(schema->regular_columns() 
-        | boost::adaptors::filtered([](const column_definition& cdef) { return cdef.name() == op_column_name || cdef.name() == eor_column_name || !cdc::is_cdc_metacolumn_name(cdef.name_as_text()); })
-        | boost::adaptors::transformed([&] (const column_definition& cdef) { columns.emplace_back(&cdef); return cdef.id; })
-    );
-
-    stream_view_type type = cdc_options_to_steam_view_type(base->cdc_options());
-
-    auto selection = cql3::selection::selection::for_columns(schema, std::move(columns));
+    auto plan = get_records_plan::get(schema, base);
     auto partition_slice = query::partition_slice(
         std::move(bounds)
-        , {}, std::move(regular_columns), selection->get_query_options());
-
-	auto& opts = base->cdc_options();
-	auto mul = 2; // key-only, allow for delete + insert
-    if (opts.preimage()) {
-        ++mul;
-    }
-    if (opts.postimage()) {
-        ++mul;
-    }
+        , {}, plan->regular_columns, plan->selection->get_query_options());
     auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
-            query::tombstone_limit(_proxy.get_tombstone_limit()), query::row_limit(limit * mul));
+            query::tombstone_limit(_proxy.get_tombstone_limit()), query::row_limit(limit * plan->rows_per_record));
 
     return _proxy.query(schema, std::move(command), std::move(partition_ranges), cl, service::storage_proxy::coordinator_query_options(default_timeout(), std::move(permit), client_state)).then(
-            [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), start_time = std::move(start_time), limit, key_names = std::move(key_names), attr_names = std::move(attr_names), type, iter, high_ts] (service::storage_proxy::coordinator_query_result qr) mutable {       
+            [this, schema, partition_slice = std::move(partition_slice), plan = std::move(plan), start_time = std::move(start_time), limit, iter, high_ts] (service::storage_proxy::coordinator_query_result qr) mutable {
+        auto& selection = plan->selection;
+        auto& key_names = plan->key_names;
+        auto& attr_names = plan->attr_names;
+        auto type = plan->type;
+        auto op_index = plan->op_index;
+        auto ts_index = plan->ts_index;
+        auto eor_index = plan->eor_index;
+
         cql3::selection::result_set_builder builder(*selection, gc_clock::now());
         query::result_view::consume(*qr.query_result, partition_slice, cql3::selection::result_set_builder::visitor(builder, *schema, *selection));
 
         auto result_set = builder.build();
         auto records = rjson::empty_array();
 
-        auto& metadata = result_set->get_metadata();
-
-        auto op_index = std::distance(metadata.get_names().begin(), 
-            std::find_if(metadata.get_names().begin(), metadata.get_names().end(), [](const lw_shared_ptr<cql3::column_specification>& cdef) {
-                return cdef->name->name() == op_column_name;
-            })
-        );
-        auto ts_index = std::distance(metadata.get_names().begin(), 
-            std::find_if(metadata.get_names().begin(), metadata.get_names().end(), [](const lw_shared_ptr<cql3::column_specification>& cdef) {
-                return cdef->name->name() == timestamp_column_name;
-            })
-        );
-        auto eor_index = std::distance(metadata.get_names().begin(), 
-            std::find_if(metadata.get_names().begin(), metadata.get_names().end(), [](const lw_shared_ptr<cql3::column_specification>& cdef) {
-                return cdef->name->name() == eor_column_name;
-            })
-        );
-
         std::optional<utils::UUID> timestamp;
         auto dynamodb = rjson::empty_object();
         auto record = rjson::empty_object();
@@ -1021,6 +1061,9 @@ future<executor::request_return_type> executor::get_records(client_state& client
             // will notice end end of shard and not return NextShardIterator.
             rjson::add(ret, "NextShardIterator", next_iter);
             _stats.api_operations.get_records_latency.add(std::chrono::steady_clock::now() - start_time);
+            if (is_big(ret)) {
+                return make_ready_future<executor::request_return_type>(make_streamed(std::move(ret)));
+            }
             return make_ready_future<executor::request_return_type>(make_jsonable(std::move(ret)));
         }
 
@@ -582,6 +582,7 @@ static future<> scan_table_ranges(
             co_await sleep_abortable(std::chrono::seconds(1), abort_source);
         }
         auto rows = rs->rows();
+        expiration_stats.items_scanned += rows.size();
         auto meta = rs->get_metadata().get_names();
         std::optional<unsigned> expiration_column;
         for (unsigned i = 0; i < meta.size(); i++) {
@@ -658,10 +659,10 @@ static future<> scan_table_ranges(
 // TTL feature may be enabled later so this function will need to be called
 // again when the feature is enabled.
 // Currently this function scans the entire table (or, rather the parts owned
-// by this shard) at full rate, once. In the future (FIXME) we should consider
-// how to pace this scan, how and when to repeat it, how to interleave or
-// parallelize scanning of multiple tables, and how to continue scans after a
-// reboot.
+// by this shard) at full rate, once. How often it is called for each table is
+// decided by expiration_service::scan_pace. In the future (FIXME) we should
+// consider how to pace the scan itself, how to interleave or parallelize
+// scanning of multiple tables, and how to continue scans after a reboot.
 static future<bool> scan_table(
     service::storage_proxy& proxy,
     data_dictionary::database db,
@@ -749,6 +750,22 @@ static future<bool> scan_table(
 }
 
 
+// If at most this fraction of the items scanned in a table were expired,
+// the scan was mostly wasted and the table is going to be scanned less often.
+static constexpr double min_expired_fraction = 0.01;
+
+void expiration_service::scan_pace::update(uint64_t scanned, uint64_t expired, unsigned max_skipped_periods) {
+    if (scanned && double(expired) / scanned > min_expired_fraction) {
+        skipped_periods = 0;
+    } else {
+        // Back off exponentially: skip 1, 2, 4... periods after each
+        // consecutive scan which found nothing worth the work.
+        skipped_periods = std::min(std::max(1u, skipped_periods * 2), max_skipped_periods);
+    }
+    periods_to_skip = skipped_periods;
+    tlogger.debug("scanned {} items, {} expired: skipping the next {} periods", scanned, expired, periods_to_skip);
+}
+
 future<> expiration_service::run() {
     // FIXME: don't just tight-loop, think about timing, pace, and
     // store position in durable storage, etc.
@@ -769,8 +786,19 @@ future<> expiration_service::run() {
             if (shutting_down()) {
                 co_return;
             }
+            auto& pace = _scan_pace[s->id()];
+            if (pace.periods_to_skip) {
+                --pace.periods_to_skip;
+                _expiration_stats.scans_skipped++;
+                continue;
+            }
+            auto scanned_before = _expiration_stats.items_scanned;
+            auto deleted_before = _expiration_stats.items_deleted;
             try {
-                co_await scan_table(_proxy, _db, _gossiper, s, _abort_source, _page_sem, _expiration_stats);
+                if (co_await scan_table(_proxy, _db, _gossiper, s, _abort_source, _page_sem, _expiration_stats)) {
+                    pace.update(_expiration_stats.items_scanned - scanned_before, _expiration_stats.items_deleted - deleted_before,
+                            _db.get_config().alternator_ttl_scan_max_skipped_periods());
+                }
             } catch (...) {
                 // The scan of a table may fail in the middle for many
                 // reasons, including network failure and even the table
@@ -790,6 +818,8 @@ future<> expiration_service::run() {
             }
         }
         _expiration_stats.scan_passes++;
+        // Forget the pace of tables which are gone
+        std::erase_if(_scan_pace, [this] (const auto& e) { return !_db.try_find_table(e.first); });
         // The TTL scanner runs above once over all tables, at full steam.
         // After completing such a scan, we sleep until it's time start
         // another scan. TODO: If the scan went too fast, we can slow it down
@@ -844,6 +874,10 @@ expiration_service::stats::stats() {
             seastar::metrics::description("number of items deleted after expiration")),
         seastar::metrics::make_total_operations("secondary_ranges_scanned", secondary_ranges_scanned,
             seastar::metrics::description("number of token ranges scanned by this node while their primary owner was down")),
+        seastar::metrics::make_total_operations("items_scanned", items_scanned,
+            seastar::metrics::description("number of items read by the expiration scans")),
+        seastar::metrics::make_total_operations("scans_skipped", scans_skipped,
+            seastar::metrics::description("number of table scans skipped because previous scans of the table found few expired items")),
     });
 }
 
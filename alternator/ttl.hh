@@ -13,6 +13,7 @@
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/semaphore.hh>
 #include "data_dictionary/data_dictionary.hh"
+#include <unordered_map>
 
 namespace gms {
 class gossiper;
@@ -43,6 +44,8 @@ class expiration_service final : public seastar::peering_sharded_service<expirat
         uint64_t scan_table = 0;
         uint64_t items_deleted = 0;
         uint64_t secondary_ranges_scanned = 0;
+        uint64_t items_scanned = 0;
+        uint64_t scans_skipped = 0;
     private:
         // The metric_groups object holds this stat object's metrics registered
         // as long as the stats object is alive.
@@ -61,6 +64,18 @@ class expiration_service final : public seastar::peering_sharded_service<expirat
     named_semaphore _page_sem{1, named_semaphore_exception_factory{"alternator_ttl"}};
     bool shutting_down() { return _abort_source.abort_requested(); }
     stats _expiration_stats;
+    // How often each table is scanned. A table whose scans find (almost)
+    // nothing to expire is scanned in fewer and fewer periods, up to
+    // alternator_ttl_scan_max_skipped_periods, and is back to being scanned
+    // in every period as soon as a scan finds a fair share of expired items.
+    struct scan_pace {
+        unsigned skipped_periods = 0;
+        unsigned periods_to_skip = 0;
+        // Called after a scan of the table went over scanned items, of
+        // which expired were expired.
+        void update(uint64_t scanned, uint64_t expired, unsigned max_skipped_periods);
+    };
+    std::unordered_map<table_id, scan_pace> _scan_pace;
 public:
     // sharded_service<expiration_service>::start() creates this object on
     // all shards, so calls this constructor on each shard. Later, the
@@ -12,6 +12,7 @@
 #include <seastar/http/exception.hh>
 #include "sstables/sstables.hh"
 #include "sstables/metadata_collector.hh"
+#include "sstables/hyperloglog.hh"
 #include "utils/estimated_histogram.hh"
 #include <algorithm>
 #include "db/system_keyspace.hh"
@@ -64,6 +65,12 @@ future<> foreach_column_family(http_context& ctx, const sstring& name, std::func
     });
 }
 
+// The partition keys of a table's sstables, see cf::estimate_keys
+struct key_estimate {
+    hll::HyperLogLog cardinality;
+    uint64_t unmerged_partitions = 0;
+};
+
 future<json::json_return_type>  get_cf_stats(http_context& ctx, const sstring& name,
         int64_t replica::column_family_stats::*f) {
     return map_reduce_cf(ctx, name, int64_t(0), [f](const replica::column_family& cf) {
@@ -181,28 +188,18 @@ static future<json::json_return_type> get_cf_unleveled_sstables(http_context& ct
 }
 
 static int64_t min_partition_size(replica::column_family& cf) {
-    int64_t res = INT64_MAX;
-    for (auto sstables = cf.get_sstables(); auto& i : *sstables) {
-        res = std::min(res, i->get_stats_metadata().estimated_partition_size.min());
-    }
+    auto res = cf.get_stats().live_sstables.min_partition_size;
     return (res == INT64_MAX) ? 0 : res;
 }
 
 static int64_t max_partition_size(replica::column_family& cf) {
-    int64_t res = 0;
-    for (auto sstables = cf.get_sstables(); auto& i : *sstables) {
-        res = std::max(i->get_stats_metadata().estimated_partition_size.max(), res);
-    }
-    return res;
+    return cf.get_stats().live_sstables.max_partition_size;
 }
 
 static integral_ratio_holder mean_partition_size(replica::column_family& cf) {
     integral_ratio_holder res;
-    for (auto sstables = cf.get_sstables(); auto& i : *sstables) {
-        auto c = i->get_stats_metadata().estimated_partition_size.count();
-        res.sub += i->get_stats_metadata().estimated_partition_size.mean() * c;
-        res.total += c;
-    }
+    res.sub = cf.get_stats().live_sstables.partition_size_sum;
+    res.total = cf.get_stats().live_sstables.partitions;
     return res;
 }
 
@@ -435,11 +432,7 @@ void set_column_family(http_context& ctx, routes& r, sharded<db::system_keyspace
     // FIXME: this refers to partitions, not rows.
     cf::get_estimated_row_size_histogram.set(r, [&ctx] (std::unique_ptr<http::request> req) {
         return map_reduce_cf(ctx, req->param["name"], utils::estimated_histogram(0), [](replica::column_family& cf) {
-            utils::estimated_histogram res(0);
-            for (auto sstables = cf.get_sstables(); auto& i : *sstables) {
-                res.merge(i->get_stats_metadata().estimated_partition_size);
-            }
-            return res;
+            return cf.get_stats().live_sstables.partition_size_histogram;
         },
         utils::estimated_histogram_merge, utils_json::estimated_histogram());
     });
@@ -447,13 +440,41 @@ void set_column_family(http_context& ctx, routes& r, sharded<db::system_keyspace
     // FIXME: this refers to partitions, not rows.
     cf::get_estimated_row_count.set(r, [&ctx] (std::unique_ptr<http::request> req) {
         return map_reduce_cf(ctx, req->param["name"], int64_t(0), [](replica::column_family& cf) {
-            uint64_t res = 0;
+            return cf.get_stats().live_sstables.partitions;
+        },
+        std::plus<int64_t>());
+    });
+
+    // Unlike get_estimated_row_count, a partition written to several sstables
+    // is counted once: the key cardinality estimators of the sstables are
+    // merged, across shards too. Only the sstables whose estimator can't be
+    // merged (e.g. written with another register width) are summed up.
+    cf::estimate_keys.set(r, [&ctx] (std::unique_ptr<http::request> req) {
+        return map_reduce_cf_raw(ctx, req->param["name"], key_estimate{}, [](replica::column_family& cf) {
+            key_estimate res;
             for (auto sstables = cf.get_sstables(); auto& i : *sstables) {
-                res += i->get_stats_metadata().estimated_partition_size.count();
+                try {
+                    auto& elements = i->get_compaction_metadata().cardinality.elements;
+                    temporary_buffer<uint8_t> bytes(elements.size());
+                    std::copy(elements.begin(), elements.end(), bytes.get_write());
+                    auto cardinality = hll::HyperLogLog::from_bytes(std::move(bytes));
+                    if (cardinality.registerSize() == res.cardinality.registerSize()) {
+                        res.cardinality.merge(cardinality);
+                        continue;
+                    }
+                } catch (const std::runtime_error&) {
+                    // No usable estimator, fall back to the partition count
+                }
+                res.unmerged_partitions += i->get_stats_metadata().estimated_partition_size.count();
             }
             return res;
-        },
-        std::plus<uint64_t>());
+        }, [] (key_estimate a, const key_estimate& b) {
+            a.cardinality.merge(b.cardinality);
+            a.unmerged_partitions += b.unmerged_partitions;
+            return a;
+        }).then([] (const key_estimate& res) {
+            return make_ready_future<json::json_return_type>(int64_t(res.cardinality.estimate()) + int64_t(res.unmerged_partitions));
+        });
     });
 
     cf::get_estimated_column_count_histogram.set(r, [&ctx] (std::unique_ptr<http::request> req) {
@@ -707,19 +728,13 @@ void set_column_family(http_context& ctx, routes& r, sharded<db::system_keyspace
 
     cf::get_index_summary_off_heap_memory_used.set(r, [&ctx] (std::unique_ptr<http::request> req) {
         return map_reduce_cf(ctx, req->param["name"], uint64_t(0), [] (replica::column_family& cf) {
-            auto sstables = cf.get_sstables();
-            return std::accumulate(sstables->begin(), sstables->end(), uint64_t(0), [](uint64_t s, auto& sst) {
-                return s + sst->get_summary().memory_footprint();
-            });
+            return cf.get_stats().live_sstables.index_summary_memory_used;
         }, std::plus<uint64_t>());
     });
 
     cf::get_all_index_summary_off_heap_memory_used.set(r, [&ctx] (std::unique_ptr<http::request> req) {
         return map_reduce_cf(ctx, uint64_t(0), [] (replica::column_family& cf) {
-            auto sstables = cf.get_sstables();
-            return std::accumulate(sstables->begin(), sstables->end(), uint64_t(0), [](uint64_t s, auto& sst) {
-                return s + sst->get_summary().memory_footprint();
-            });
+            return cf.get_stats().live_sstables.index_summary_memory_used;
         }, std::plus<uint64_t>());
     });
 
@@ -1088,6 +1103,7 @@ void unset_column_family(http_context& ctx, routes& r) {
     cf::get_all_memtable_switch_count.unset(r);
     cf::get_estimated_row_size_histogram.unset(r);
     cf::get_estimated_row_count.unset(r);
+    cf::estimate_keys.unset(r);
     cf::get_estimated_column_count_histogram.unset(r);
     cf::get_all_compression_ratio.unset(r);
     cf::get_pending_flushes.unset(r);
@@ -28,6 +28,7 @@
 #include <seastar/http/exception.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include "repair/row_level.hh"
 #include "locator/snitch_base.hh"
 #include "column_family.hh"
@@ -180,32 +181,36 @@ static auto wrap_ks_cf(http_context &ctx, ks_cf_func f) {
     };
 }
 
-seastar::future<json::json_return_type> run_toppartitions_query(db::toppartitions_query& q, http_context &ctx, bool legacy_request) {
+static httpd::column_family_json::toppartitions_query_results toppartitions_results_to_json(const db::toppartitions_query::results& topk_results, size_t list_size, bool legacy_request) {
     namespace cf = httpd::column_family_json;
+    cf::toppartitions_query_results results;
+
+    results.read_cardinality = topk_results.read.size();
+    results.write_cardinality = topk_results.write.size();
+
+    for (auto& d: topk_results.read.top(list_size)) {
+        cf::toppartitions_record r;
+        r.partition = (legacy_request ? "" : "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") ") + sstring(d.item);
+        r.count = d.count;
+        r.error = d.error;
+        results.read.push(r);
+    }
+    for (auto& d: topk_results.write.top(list_size)) {
+        cf::toppartitions_record r;
+        r.partition = (legacy_request ? "" : "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") ") + sstring(d.item);
+        r.count = d.count;
+        r.error = d.error;
+        results.write.push(r);
+    }
+    return results;
+}
+
+seastar::future<json::json_return_type> run_toppartitions_query(db::toppartitions_query& q, http_context &ctx, bool legacy_request) {
     return q.scatter().then([&q, legacy_request] {
         return sleep(q.duration()).then([&q, legacy_request] {
             return q.gather(q.capacity()).then([&q, legacy_request] (auto topk_results) {
                 apilog.debug("toppartitions query: processing results");
-                cf::toppartitions_query_results results;
-
-                results.read_cardinality = topk_results.read.size();
-                results.write_cardinality = topk_results.write.size();
-
-                for (auto& d: topk_results.read.top(q.list_size())) {
-                    cf::toppartitions_record r;
-                    r.partition = (legacy_request ? "" : "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") ") + sstring(d.item);
-                    r.count = d.count;
-                    r.error = d.error;
-                    results.read.push(r);
-                }
-                for (auto& d: topk_results.write.top(q.list_size())) {
-                    cf::toppartitions_record r;
-                    r.partition = (legacy_request ? "" : "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") ") + sstring(d.item);
-                    r.count = d.count;
-                    r.error = d.error;
-                    results.write.push(r);
-                }
-                return make_ready_future<json::json_return_type>(results);
+                return make_ready_future<json::json_return_type>(toppartitions_results_to_json(topk_results, q.list_size(), legacy_request));
             });
         });
     });
@@ -547,6 +552,12 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
         });
     });
 
+    ss::get_hot_partitions.set(r, [&ctx] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        api::req_param<unsigned> list_size(*req, "list_size", 10);
+        auto topk_results = co_await db::hot_partitions_tracker::gather(ctx.db, db::hot_partitions_tracker::capacity);
+        co_return toppartitions_results_to_json(topk_results, list_size.value, false);
+    });
+
     ss::get_leaving_nodes.set(r, [&ctx](const_req req) {
         return container_to_vec(ctx.get_token_metadata().get_leaving_endpoints());
     });
@@ -1035,11 +1046,15 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
 
     ss::set_trace_probability.set(r, [](std::unique_ptr<http::request> req) {
         auto probability = req->get_query_param("probability");
-        apilog.info("set_trace_probability: probability={}", probability);
-        return futurize_invoke([probability] {
+        auto in_memory = req->get_query_param("in_memory");
+        apilog.info("set_trace_probability: probability={} in_memory={}", probability, in_memory);
+        return futurize_invoke([probability, in_memory] {
             double real_prob = std::stod(probability.c_str());
-            return tracing::tracing::tracing_instance().invoke_on_all([real_prob] (auto& local_tracing) {
+            return tracing::tracing::tracing_instance().invoke_on_all([real_prob, in_memory] (auto& local_tracing) {
                 local_tracing.set_trace_probability(real_prob);
+                if (in_memory != "") {
+                    local_tracing.set_sampled_sessions_in_memory(strcasecmp(in_memory.c_str(), "true") == 0);
+                }
             }).then([] {
                 return make_ready_future<json::json_return_type>(json_void());
             });
@@ -1059,6 +1074,30 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
         return make_ready_future<json::json_return_type>(tracing::tracing::get_local_tracing_instance().get_trace_probability());
     });
 
+    ss::get_sampled_trace_sessions.set(r, [](std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        std::vector<ss::sampled_trace_session> res;
+        co_await tracing::tracing::tracing_instance().invoke_on_all([&res] (tracing::tracing& local_tracing) -> future<> {
+            auto shard = this_shard_id();
+            auto recs = local_tracing.get_sampled_sessions();
+            co_await smp::submit_to(0, [&res, &recs, shard] () -> future<> {
+                for (const auto& rec : recs) {
+                    ss::sampled_trace_session s;
+                    s.session_id = rec.session_id.to_sstring();
+                    s.started_at = std::chrono::duration_cast<std::chrono::microseconds>(rec.started_at.time_since_epoch()).count();
+                    s.duration = std::chrono::duration_cast<std::chrono::microseconds>(rec.elapsed).count();
+                    s.client = rec.primary ? fmt::to_string(rec.client) : "";
+                    s.command = tracing::type_to_string(rec.command);
+                    s.request = sstring(rec.request_view());
+                    s.events = rec.events;
+                    s.shard = shard;
+                    res.push_back(std::move(s));
+                    co_await coroutine::maybe_yield();
+                }
+            });
+        });
+        co_return res;
+    });
+
     ss::get_slow_query_info.set(r, [](const_req req) {
         ss::slow_query_info res;
         res.enable = tracing::tracing::get_local_tracing_instance().slow_query_tracing_enabled();
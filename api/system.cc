@@ -11,8 +11,10 @@
 
 #include <seastar/core/reactor.hh>
 #include <seastar/http/exception.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include "log.hh"
 #include "replica/database.hh"
+#include "utils/cpu_profile.hh"
 
 extern logging::logger apilog;
 
@@ -81,6 +83,57 @@ void set_system(http_context& ctx, routes& r) {
             return json::json_return_type(json::json_void());
         });
     });
+
+    hs::set_cpu_profiler.set(r, [](std::unique_ptr<request> req) -> future<json::json_return_type> {
+        bool enable = strcasecmp(req->get_query_param("enable").c_str(), "true") == 0;
+        auto period_param = req->get_query_param("period_us");
+        std::chrono::microseconds period{10000};
+        if (!period_param.empty()) {
+            try {
+                period = std::chrono::microseconds(std::stoul(period_param));
+            } catch (...) {
+                throw bad_param_exception(format("Bad format in a period_us value: \"{}\"", period_param));
+            }
+            if (period.count() == 0) {
+                throw bad_param_exception("period_us must be positive");
+            }
+        }
+        apilog.info("set_cpu_profiler: enable={} period={}us", enable, period.count());
+        co_await smp::invoke_on_all([enable, period] {
+            if (enable) {
+                utils::local_cpu_profile().start(period);
+            } else {
+                utils::local_cpu_profile().stop();
+            }
+        });
+        co_return json::json_void();
+    });
+
+    hs::get_cpu_profile.set(r, [](std::unique_ptr<request> req) -> future<json::json_return_type> {
+        using folded_stacks = std::unordered_map<sstring, uint64_t>;
+        folded_stacks folded;
+        uint64_t dropped = 0;
+        for (unsigned shard = 0; shard < smp::count; ++shard) {
+            auto shard_profile = co_await smp::submit_to(shard, [] {
+                folded_stacks f;
+                utils::local_cpu_profile().fold(f);
+                return make_foreign(std::make_unique<std::pair<folded_stacks, uint64_t>>(std::move(f), utils::local_cpu_profile().dropped()));
+            });
+            for (auto& [stack, count] : shard_profile->first) {
+                folded[stack] += count;
+            }
+            dropped += shard_profile->second;
+            co_await coroutine::maybe_yield();
+        }
+        if (dropped) {
+            apilog.warn("get_cpu_profile: {} samples were dropped, the profile has too many distinct stacks", dropped);
+        }
+        std::string out;
+        for (auto& [stack, count] : folded) {
+            fmt::format_to(std::back_inserter(out), "{} {}\n", stack, count);
+        }
+        co_return json::json_return_type(std::move(out));
+    });
 }
 
 }
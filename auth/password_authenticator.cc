@@ -17,6 +17,7 @@
 #include <optional>
 
 #include <boost/algorithm/cxx11/all_of.hpp>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/seastar.hh>
 
 #include "auth/authenticated_user.hh"
@@ -27,6 +28,7 @@
 #include "log.hh"
 #include "service/migration_manager.hh"
 #include "utils/class_registrator.hh"
+#include "utils/hashers.hh"
 #include "replica/database.hh"
 #include "cql3/query_processor.hh"
 #include "db/config.hh"
@@ -51,6 +53,10 @@ static const class_registrator<
 
 static thread_local auto rng_for_salt = std::default_random_engine(std::random_device{}());
 
+// How long a successful password check is remembered, and for how many passwords at most
+static constexpr auto verified_password_validity = std::chrono::seconds(60);
+static constexpr size_t max_verified_passwords = 10000;
+
 static std::string_view get_config_value(std::string_view value, std::string_view def) {
     return value.empty() ? def : value;
 }
@@ -136,7 +142,51 @@ future<> password_authenticator::create_default_if_missing() const {
     });
 }
 
+bool password_authenticator::check_password(const sstring& password, const sstring& salted_hash) const {
+    sha256_hasher h;
+    auto salted_hash_size = uint32_t(salted_hash.size());
+    h.update(reinterpret_cast<const char*>(&salted_hash_size), sizeof(salted_hash_size));
+    h.update(salted_hash.data(), salted_hash.size());
+    h.update(password.data(), password.size());
+    auto key = h.finalize();
+
+    auto now = lowres_clock::now();
+    if (auto it = _verified_passwords.find(key); it != _verified_passwords.end()) {
+        if (it->second > now) {
+            ++_stats.password_check_cache_hits;
+            return true;
+        }
+        _verified_passwords.erase(it);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = passwords::check(password, salted_hash);
+    ++_stats.password_checks;
+    _stats.password_check_time_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if (ok) {
+        if (_verified_passwords.size() >= max_verified_passwords) {
+            std::erase_if(_verified_passwords, [now] (const auto& e) { return e.second <= now; });
+            if (_verified_passwords.size() >= max_verified_passwords) {
+                _verified_passwords.clear();
+            }
+        }
+        _verified_passwords.emplace(std::move(key), now + verified_password_validity);
+    }
+    return ok;
+}
+
 future<> password_authenticator::start() {
+     namespace sm = seastar::metrics;
+     _metrics.add_group("password_authenticator", {
+         sm::make_counter("password_checks", _stats.password_checks,
+                 sm::description("Counts the passwords checked by hashing them.")),
+         sm::make_counter("password_check_cache_hits", _stats.password_check_cache_hits,
+                 sm::description("Counts the passwords accepted without hashing them, because they were recently checked.")),
+         sm::make_counter("password_check_time", _stats.password_check_time_us,
+                 sm::description("Total time spent hashing passwords, in microseconds.")),
+     });
+
      return once_among_shards([this] {
          auto f = create_metadata_table_if_missing(
                  meta::roles_table::name,
@@ -228,14 +278,14 @@ future<authenticated_user> password_authenticator::authenticate(
                 internal_distributed_query_state(),
                 {username},
                 cql3::query_processor::cache_internal::yes);
-    }).then_wrapped([=](future<::shared_ptr<cql3::untyped_result_set>> f) {
+    }).then_wrapped([=, this](future<::shared_ptr<cql3::untyped_result_set>> f) {
         try {
             auto res = f.get0();
             auto salted_hash = std::optional<sstring>();
             if (!res->empty()) {
                 salted_hash = res->one().get_opt<sstring>(SALTED_HASH);
             }
-            if (!salted_hash || !passwords::check(password, *salted_hash)) {
+            if (!salted_hash || !check_password(password, *salted_hash)) {
                 throw exceptions::authentication_exception("Username and/or password are incorrect");
             }
             return make_ready_future<authenticated_user>(username);
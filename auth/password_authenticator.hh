@@ -10,9 +10,14 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
 
 #include "auth/authenticator.hh"
+#include "bytes.hh"
 
 namespace db {
     class config;
@@ -39,6 +44,20 @@ class password_authenticator : public authenticator {
     seastar::abort_source _as;
     std::string _superuser;
 
+    // Passwords which were recently found to match their salted hashes, so that clients reconnecting
+    // in bulk don't have the shard run the (deliberately slow) hashing function for each of them.
+    // Keyed by a digest of the salted hash and the password, so that changing the password of a role
+    // invalidates its entries; the cleartext passwords are not kept.
+    mutable std::unordered_map<bytes, lowres_clock::time_point> _verified_passwords;
+
+    struct stats {
+        uint64_t password_checks = 0;
+        uint64_t password_check_cache_hits = 0;
+        uint64_t password_check_time_us = 0;
+    };
+    mutable stats _stats;
+    seastar::metrics::metric_groups _metrics;
+
 public:
     static db::consistency_level consistency_for_user(std::string_view role_name);
     static std::string default_superuser(const db::config&);
@@ -74,6 +93,8 @@ class password_authenticator : public authenticator {
     virtual ::shared_ptr<sasl_challenge> new_sasl_challenge() const override;
 
 private:
+    bool check_password(const sstring& password, const sstring& salted_hash) const;
+
     bool legacy_metadata_exists() const;
 
     future<> migrate_legacy_metadata() const;
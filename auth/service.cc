@@ -231,6 +231,11 @@ void service::reset_authorization_cache() {
     _qp.reset_cache();
 }
 
+future<> service::reset_authorization_cache_on_all_shards() const {
+    // The caches are not a part of the state of the service, which is stored externally.
+    return const_cast<service&>(*this).container().invoke_on_all(&service::reset_authorization_cache);
+}
+
 future<bool> service::has_existing_legacy_users() const {
     if (!_qp.db().has_schema(meta::AUTH_KS, meta::USERS_CF)) {
         return make_ready_future<bool>(false);
@@ -496,6 +501,9 @@ future<> alter_role(
                 ser.underlying_authenticator().supported_options()).then([&ser, name, &options] {
             return ser.underlying_authenticator().alter(name, options);
         });
+    }).then([&ser] {
+        // The role may have become, or stopped being, a superuser
+        return ser.reset_authorization_cache_on_all_shards();
     });
 }
 
@@ -514,6 +522,8 @@ future<> drop_role(const service& ser, std::string_view name) {
         return ser.underlying_authenticator().drop(name);
     }).then([&ser, name] {
         return ser.underlying_role_manager().drop(name);
+    }).then([&ser] {
+        return ser.reset_authorization_cache_on_all_shards();
     });
 }
 
@@ -539,6 +549,8 @@ future<> grant_permissions(
         const resource& r) {
     return validate_role_exists(ser, role_name).then([&ser, role_name, perms, &r] {
         return ser.underlying_authorizer().grant(role_name, perms, r);
+    }).then([&ser] {
+        return ser.reset_authorization_cache_on_all_shards();
     });
 }
 
@@ -560,6 +572,8 @@ future<> revoke_permissions(
         const resource& r) {
     return validate_role_exists(ser, role_name).then([&ser, role_name, perms, &r] {
         return ser.underlying_authorizer().revoke(role_name, perms, r);
+    }).then([&ser] {
+        return ser.reset_authorization_cache_on_all_shards();
     });
 }
 
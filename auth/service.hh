@@ -122,6 +122,12 @@ class service final : public seastar::peering_sharded_service<service> {
 
     void reset_authorization_cache();
 
+    ///
+    /// Resets the authorization caches on all shards of this node, so that changes to permissions and roles made
+    /// through it apply without waiting for the cached entries to be refreshed.
+    ///
+    future<> reset_authorization_cache_on_all_shards() const;
+
     ///
     /// \returns an exceptional future with \ref nonexistant_role if the named role does not exist.
     ///
@@ -11,6 +11,7 @@
 #include <seastar/core/timer.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/file.hh>
+#include <seastar/core/shared_ptr.hh>
 #include <chrono>
 #include <cmath>
 
@@ -35,12 +36,17 @@
 // region, and aggressively in the third region.
 //
 // The constants q1 and q2 are used to determine the proportional factor at each stage.
+//
+// Optionally, the output can be corrected in a closed loop to keep the scheduling latency of
+// another, latency-sensitive, scheduling group below a target, see update_latency_target().
 class backlog_controller {
 public:
     using scheduling_group = seastar::scheduling_group;
+    using latency_clock = std::chrono::steady_clock;
 
     future<> shutdown() {
         _update_timer.cancel();
+        _latency_probe = nullptr;
         return std::move(_inflight_update);
     }
 
@@ -49,6 +55,29 @@ class backlog_controller {
         return make_ready_future<>();
     }
 
+    // Every adjustment, a probe task is run in observed_group and the time it waited for
+    // the CPU is compared with the target. While the target is exceeded the output is scaled
+    // down multiplicatively, otherwise the scale recovers additively, so the controller backs
+    // off quickly during bursts and gives the shares back slowly. The output is never scaled
+    // below min_latency_scale, so the backlog is always consumed eventually.
+    // A zero target disables the correction.
+    future<> update_latency_target(scheduling_group observed_group, std::chrono::microseconds target) {
+        if (target.count() > 0) {
+            _latency_probe = make_lw_shared<latency_probe>(observed_group, target);
+        } else {
+            _latency_probe = nullptr;
+            _latency_scale = 1.0f;
+        }
+        return make_ready_future<>();
+    }
+
+    // Factor by which the output is currently scaled down, 1 if it isn't.
+    float latency_scale() const noexcept {
+        return _latency_scale;
+    }
+
+    static constexpr float min_latency_scale = 0.1f;
+
 protected:
     struct control_point {
         float input;
@@ -68,8 +97,23 @@ class backlog_controller {
     // When that option is deprecated we should remove this.
     float _static_shares;
 
+    // Shared with the probe task, which may outlive the controller.
+    struct latency_probe {
+        scheduling_group group;
+        std::chrono::microseconds target;
+        std::optional<latency_clock::time_point> started_at;
+        latency_clock::duration last_latency = latency_clock::duration::zero();
+
+        latency_probe(scheduling_group g, std::chrono::microseconds t) : group(g), target(t) {}
+    };
+    lw_shared_ptr<latency_probe> _latency_probe;
+    float _latency_scale = 1.0f;
+
     virtual void update_controller(float quota);
 
+    // Updates _latency_scale from the last probe, and starts a new one.
+    void adjust_latency_scale();
+
     bool controller_disabled() const noexcept {
         return _static_shares > 0;
     }
@@ -113,6 +113,10 @@ class cache_flat_mutation_reader final : public flat_mutation_reader_v2::impl {
     gc_clock::time_point _read_time;
     gc_clock::time_point _gc_before;
 
+    // For the read profile of traced reads, added to it on close
+    uint64_t _row_hits = 0;
+    uint64_t _row_misses = 0;
+
     future<> do_fill_buffer();
     future<> ensure_underlying();
     void copy_from_cache_to_buffer();
@@ -251,6 +255,10 @@ class cache_flat_mutation_reader final : public flat_mutation_reader_v2::impl {
         return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
     }
     virtual future<> close() noexcept override {
+        if (auto* profile = tracing::get_read_profile(_permit.trace_state())) {
+            profile->cache_row_hits += _row_hits;
+            profile->cache_row_misses += _row_misses;
+        }
         auto close_read_context = _read_context_holder ?  _read_context_holder->close() : make_ready_future<>();
         auto close_underlying = _underlying_holder ? _underlying_holder->close() : make_ready_future<>();
         return when_all_succeed(std::move(close_read_context), std::move(close_underlying)).discard_result();
@@ -261,6 +269,7 @@ inline
 future<> cache_flat_mutation_reader::process_static_row() {
     if (_snp->static_row_continuous()) {
         _read_context.cache().on_row_hit();
+        ++_row_hits;
         static_row sr = _lsa_manager.run_in_read_section([this] {
             return _snp->static_row(_read_context.digest_requested());
         });
@@ -270,6 +279,7 @@ future<> cache_flat_mutation_reader::process_static_row() {
         return make_ready_future<>();
     } else {
         _read_context.cache().on_row_miss();
+        ++_row_misses;
         return ensure_underlying().then([this] {
             return (*_underlying)().then([this] (mutation_fragment_v2_opt&& sr) {
                 if (sr) {
@@ -406,6 +416,7 @@ future<> cache_flat_mutation_reader::read_from_underlying() {
         [this] { return _state != state::reading_from_underlying || is_buffer_full(); },
         [this] (mutation_fragment_v2 mf) {
             _read_context.cache().on_row_miss();
+            ++_row_misses;
             offer_from_underlying(std::move(mf));
         },
         [this] {
@@ -966,6 +977,7 @@ void cache_flat_mutation_reader::add_to_buffer(const partition_snapshot_row_curs
     position_in_partition::less_compare less(*_schema);
     if (!row.dummy()) {
         _read_context.cache().on_row_hit();
+        ++_row_hits;
         if (_read_context.digest_requested()) {
             row.latest_row_prepare_hash();
         }
@@ -37,6 +37,7 @@
 #include "utils/UUID_gen.hh"
 #include "utils/managed_bytes.hh"
 #include "utils/fragment_range.hh"
+#include "utils/fb_utilities.hh"
 #include "types/types.hh"
 #include "concrete_types.hh"
 #include "types/listlike_partial_deserializing_iterator.hh"
@@ -1670,7 +1671,11 @@ class transformer final : public change_processor {
         const auto tombstone_limit = query::tombstone_limit(_ctx._proxy.get_tombstone_limit());
         auto command = ::make_lw_shared<query::read_command>(_schema->id(), _schema->version(), partition_slice, query::max_result_size(max_result_size), tombstone_limit, query::row_limit(row_limit));
 
-        const auto select_cl = adjust_cl(write_cl);
+        auto select_cl = adjust_cl(write_cl);
+        if (_ctx._proxy.get_db().local().get_config().cdc_preimage_local_reads() && is_local_replica(m.token())) {
+            // A read at CL=ONE prefers the coordinator itself when it's a replica
+            select_cl = db::consistency_level::ONE;
+        }
 
       try {
         return _ctx._proxy.query(_schema, std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state)).then(
@@ -1735,6 +1740,12 @@ class transformer final : public change_processor {
         }
     }
 
+    bool is_local_replica(const dht::token& t) const {
+        auto& erm = _ctx._proxy.get_db().local().find_column_family(_schema->id()).get_effective_replication_map();
+        auto replicas = erm->get_natural_endpoints(t);
+        return std::any_of(replicas.begin(), replicas.end(), &utils::fb_utilities::is_me);
+    }
+
     /** For preimage query use the same CL as for base write, except for CLs ANY and ALL. */
     static db::consistency_level adjust_cl(db::consistency_level write_cl) {
         if (write_cl == db::consistency_level::ANY) {
@@ -1788,9 +1799,9 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
 
             auto f = make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(nullptr);
             if (s->cdc_options().preimage() || s->cdc_options().postimage()) {
-                // Note: further improvement here would be to coalesce the pre-image selects into one
-                // iff a batch contains several modifications to the same table. Otoh, batch is rare(?)
-                // so this is premature.
+                // Note: batches already merge their modifications of the same partition into one
+                // mutation, so there is one pre-image select per partition, reading all the modified
+                // rows at once, and the selects for different partitions run in parallel.
                 tracing::trace(tr_state, "CDC: Selecting preimage for {}", m.decorated_key());
                 f = trans.pre_image_select(qs.get_client_state(), write_cl, m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
                     auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
@@ -45,6 +45,8 @@ struct client_data {
     std::optional<bool> ssl_enabled;
     std::optional<sstring> ssl_protocol;
     std::optional<sstring> username;
+    std::optional<int64_t> request_memory_used;  /// Memory taken by the connection's requests in flight.
+    std::optional<int64_t> requests_blocked_memory;  /// Requests which waited for the connection's memory budget.
 
     sstring stage_str() const { return to_string(connection_stage); }
     sstring client_type_str() const { return to_string(ct); }
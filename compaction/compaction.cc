@@ -51,6 +51,7 @@
 #include "utils/fmt-compat.hh"
 #include "utils/error_injection.hh"
 #include "readers/filtering.hh"
+#include "readers/multi_range.hh"
 #include "readers/compacting.hh"
 #include "tombstone_gc.hh"
 #include "keys.hh"
@@ -148,28 +149,93 @@ std::ostream& operator<<(std::ostream& os, compaction_type_options::scrub::quara
     return os << to_string(quarantine_mode);
 }
 
-static api::timestamp_type get_max_purgeable_timestamp(const table_state& table_s, sstable_set::incremental_selector& selector,
-        const std::unordered_set<shared_sstable>& compacting_set, const dht::decorated_key& dk, uint64_t& bloom_filter_checks) {
-    if (!table_s.tombstone_gc_enabled()) [[unlikely]] {
-        return api::min_timestamp;
+// Calculates the max purgeable timestamp of the partitions written by a
+// compaction, as we iterate through their decorated keys.
+//
+// The incremental selector only yields the sstables overlapping with the
+// token range of the partition. They are filtered and sorted by min timestamp
+// once per selected range, rather than once per partition, so a partition only
+// checks the bloom filters of the sstables which can still lower the max
+// purgeable timestamp: none at all when the memtables or the sstables checked
+// before it already hold older data than the remaining ones.
+class max_purgeable_calculator {
+    const table_state& _table_s;
+    sstable_set::incremental_selector& _selector;
+    const std::unordered_set<shared_sstable>& _compacting_set;
+    // The uncompacting sstables selected for the current range, by ascending min timestamp.
+    std::vector<std::pair<api::timestamp_type, shared_sstable>> _candidates;
+    // The range the candidates were selected for: [_candidates_start, _candidates_end),
+    // disengaged if the candidates are invalid.
+    std::optional<dht::decorated_key> _candidates_start;
+    std::optional<dht::ring_position_ext> _candidates_end;
+private:
+    void maybe_select(const dht::decorated_key& dk) {
+        const auto& s = *_table_s.schema();
+        if (_candidates_end && dk.tri_compare(s, *_candidates_start) >= 0
+                && dht::ring_position_tri_compare(s, dk, *_candidates_end) < 0) {
+            return;
+        }
+        auto selection = _selector.select(dk);
+        _candidates.clear();
+        for (auto& sst : selection.sstables) {
+            if (!_compacting_set.contains(sst)) {
+                _candidates.emplace_back(sst->get_stats_metadata().min_timestamp, sst);
+            }
+        }
+        std::ranges::sort(_candidates, std::less<>(), [] (const auto& c) { return c.first; });
+        _candidates_start.emplace(dk);
+        _candidates_end.emplace(selection.next_position);
     }
-
-    auto timestamp = table_s.min_memtable_timestamp();
-    std::optional<utils::hashed_key> hk;
-    for (auto&& sst : boost::range::join(selector.select(dk).sstables, table_s.compacted_undeleted_sstables())) {
-        if (compacting_set.contains(sst)) {
-            continue;
+public:
+    max_purgeable_calculator(const table_state& table_s, sstable_set::incremental_selector& selector,
+            const std::unordered_set<shared_sstable>& compacting_set)
+        : _table_s(table_s)
+        , _selector(selector)
+        , _compacting_set(compacting_set)
+    { }
+
+    // Must be called when the compacting set changes.
+    void invalidate() noexcept {
+        _candidates.clear();
+        _candidates_start.reset();
+        _candidates_end.reset();
+    }
+
+    // The keys must be passed in ascending order, see incremental_selector::select().
+    api::timestamp_type operator()(const dht::decorated_key& dk, uint64_t& bloom_filter_checks) {
+        if (!_table_s.tombstone_gc_enabled()) [[unlikely]] {
+            return api::min_timestamp;
         }
-        if (!hk) {
-            hk = sstables::sstable::make_hashed_key(*table_s.schema(), dk.key());
+
+        auto timestamp = _table_s.min_memtable_timestamp();
+        std::optional<utils::hashed_key> hk;
+        auto check = [&] (api::timestamp_type min_timestamp, const shared_sstable& sst) {
+            if (!hk) {
+                hk = sstables::sstable::make_hashed_key(*_table_s.schema(), dk.key());
+            }
+            if (sst->filter_has_key(*hk)) {
+                bloom_filter_checks++;
+                timestamp = std::min(timestamp, min_timestamp);
+            }
+        };
+
+        maybe_select(dk);
+        for (auto& [min_timestamp, sst] : _candidates) {
+            if (min_timestamp >= timestamp) {
+                break;
+            }
+            check(min_timestamp, sst);
         }
-        if (sst->filter_has_key(*hk)) {
-            bloom_filter_checks++;
-            timestamp = std::min(timestamp, sst->get_stats_metadata().min_timestamp);
+        // Changed by other compactions at any time, so not cached.
+        for (auto& sst : _table_s.compacted_undeleted_sstables()) {
+            auto min_timestamp = sst->get_stats_metadata().min_timestamp;
+            if (min_timestamp < timestamp && !_compacting_set.contains(sst)) {
+                check(min_timestamp, sst);
+            }
         }
+        return timestamp;
     }
-    return timestamp;
-}
+};
 
 static std::vector<shared_sstable> get_uncompacting_sstables(const table_state& table_s, std::vector<shared_sstable> sstables) {
     auto all_sstables = boost::copy_range<std::vector<shared_sstable>>(*table_s.main_sstable_set().all());
@@ -444,9 +510,13 @@ class compaction {
     uint32_t _sstable_level;
     uint64_t _start_size = 0;
     uint64_t _end_size = 0;
+    uint64_t _fully_expired_size = 0;
     uint64_t _estimated_partitions = 0;
     uint64_t _bloom_filter_checks = 0;
+    uint64_t _large_partition_splits = 0;
     db::replay_position _rp;
+    // The output is repaired only if all the input is, see sstable::is_repaired().
+    std::optional<uint64_t> _repaired_at;
     encoding_stats_collector _stats_collector;
     bool _can_split_large_partition = false;
     bool _contains_multi_fragment_runs = false;
@@ -458,11 +528,15 @@ class compaction {
     // used to incrementally calculate max purgeable timestamp, as we iterate through decorated keys.
     std::optional<sstable_set::incremental_selector> _selector;
     std::unordered_set<shared_sstable> _compacting_for_max_purgeable_func;
+    std::optional<max_purgeable_calculator> _max_purgeable;
     // optional owned_ranges vector for cleanup;
     owned_ranges_ptr _owned_ranges = {};
     // required for reshard compaction.
     const dht::sharder* _sharder = nullptr;
     std::optional<dht::incremental_owned_ranges_checker> _owned_ranges_checker;
+    // optional token range to which compaction of the input sstables is restricted.
+    std::optional<dht::token_range> _token_range;
+    std::optional<dht::partition_range> _partition_range;
     // Garbage collected sstables that are sealed but were not added to SSTable set yet.
     std::vector<shared_sstable> _unused_garbage_collected_sstables;
     // Garbage collected sstables that were added to SSTable set and should be eventually removed from it.
@@ -493,6 +567,8 @@ class compaction {
         , _owned_ranges(std::move(descriptor.owned_ranges))
         , _sharder(descriptor.sharder)
         , _owned_ranges_checker(_owned_ranges ? std::optional<dht::incremental_owned_ranges_checker>(*_owned_ranges) : std::nullopt)
+        , _token_range(std::move(descriptor.token_range))
+        , _partition_range(_token_range ? std::optional<dht::partition_range>(dht::to_partition_range(*_token_range)) : std::nullopt)
     {
         for (auto& sst : _sstables) {
             _stats_collector.update(sst->get_encoding_stats_for_compaction());
@@ -538,6 +614,7 @@ class compaction {
         cfg.run_identifier = _run_identifier;
         cfg.replay_position = _rp;
         cfg.sstable_level = _sstable_level;
+        cfg.repaired_at = _repaired_at;
         return cfg;
     }
 
@@ -608,7 +685,14 @@ class compaction {
     }
 
     bool enable_garbage_collected_sstable_writer() const noexcept {
-        return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max();
+        // A compaction restricted to a token range cannot release the input sstables
+        // early, as the rest of their ranges may not be compacted yet.
+        return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max() && !_token_range;
+    }
+
+    // Range of the input sstables to be compacted.
+    const dht::partition_range& input_partition_range() const noexcept {
+        return _partition_range ? *_partition_range : query::full_partition_range;
     }
 
     flat_mutation_reader_v2::filter make_partition_filter() const {
@@ -634,9 +718,8 @@ class compaction {
     virtual flat_mutation_reader_v2 make_sstable_reader() const = 0;
 
     // Make a filtering reader if needed
-    // FIXME: the sstable reader itself should be pass the owned ranges
-    // so it can skip over the disowned ranges efficiently using the index.
-    // Ref https://github.com/scylladb/scylladb/issues/12998
+    // Cleanup reads only the owned ranges, skipping over the disowned ones using the index,
+    // the filter is then only a safety net.
     flat_mutation_reader_v2 setup_sstable_reader() const {
         if (!_owned_ranges_checker) {
             return make_sstable_reader();
@@ -664,14 +747,23 @@ class compaction {
 
             // Compacted sstable keeps track of its ancestors.
             _input_sstable_generations.push_back(sst->generation());
-            _start_size += sst->bytes_on_disk();
-            _cdata.total_partitions += sst->get_estimated_key_count();
+            auto estimated_key_count = sst->get_estimated_key_count();
+            uint64_t size = sst->bytes_on_disk();
+            if (_token_range) {
+                // Only account for the part of the sstable which is compacted.
+                auto keys_in_range = sst->estimated_keys_for_range(*_token_range);
+                size = uint64_t(double(size) * keys_in_range / std::max<uint64_t>(estimated_key_count, 1));
+                estimated_key_count = keys_in_range;
+            }
+            _start_size += size;
+            _cdata.total_partitions += estimated_key_count;
             formatted_msg += sst;
 
             // Do not actually compact a sstable that is fully expired and can be safely
             // dropped without ressurrecting old data.
             if (tombstone_expiration_enabled() && fully_expired.contains(sst)) {
                 log_debug("Fully expired sstable {} will be dropped on compaction completion", sst->get_filename());
+                _fully_expired_size += size;
                 continue;
             }
 
@@ -680,7 +772,7 @@ class compaction {
             // FIXME: If the sstables have cardinality estimation bitmaps, use that
             // for a better estimate for the number of partitions in the merged
             // sstable than just adding up the lengths of individual sstables.
-            _estimated_partitions += sst->get_estimated_key_count();
+            _estimated_partitions += estimated_key_count;
             // TODO:
             // Note that this is not fully correct. Since we might be merging sstables that originated on
             // another shard (#cpu changed), we might be comparing RP:s with differing shard ids,
@@ -689,6 +781,7 @@ class compaction {
             // this is kind of ok, esp. since we will hopefully not be trying to recover based on
             // compacted sstables anyway (CL should be clean by then).
             _rp = std::max(_rp, sst_stats.position);
+            _repaired_at = std::min(_repaired_at.value_or(sst_stats.repaired_at), sst_stats.repaired_at);
         }
         log_info("{} {}", report_start_desc(), formatted_msg);
         if (ssts->size() < _sstables.size()) {
@@ -768,7 +861,9 @@ class compaction {
                 .ended_at = ended_at,
                 .start_size = _start_size,
                 .end_size = _end_size,
+                .fully_expired_size = _fully_expired_size,
                 .bloom_filter_checks = _bloom_filter_checks,
+                .large_partition_splits = _large_partition_splits,
             },
         };
 
@@ -790,6 +885,9 @@ class compaction {
                 _input_sstable_generations.size(), new_sstables_msg, utils::pretty_printed_data_size(_start_size), utils::pretty_printed_data_size(_end_size), int(ratio * 100),
                 std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(), utils::pretty_printed_throughput(_end_size, duration),
                 _cdata.total_partitions, _cdata.total_keys_written);
+        if (_large_partition_splits) {
+            log_info("Split large partitions {} times to respect SSTable size limit of {}", _large_partition_splits, utils::pretty_printed_data_size(_max_sstable_size));
+        }
 
         return ret;
     }
@@ -808,8 +906,11 @@ class compaction {
                 return api::min_timestamp;
             };
         }
+        if (!_max_purgeable) {
+            _max_purgeable.emplace(_table_s, *_selector, _compacting_for_max_purgeable_func);
+        }
         return [this] (const dht::decorated_key& dk) {
-            return get_max_purgeable_timestamp(_table_s, *_selector, _compacting_for_max_purgeable_func, dk, _bloom_filter_checks);
+            return (*_max_purgeable)(dk, _bloom_filter_checks);
         };
     }
 
@@ -926,6 +1027,7 @@ void compacted_fragments_writer::split_large_partition() {
         _compaction_writer->writer.consume(std::move(rtc));
     }
     _c.log_debug("Splitting large partition {} in order to respect SSTable size limit of {}", *_current_partition.dk, utils::pretty_printed_data_size(_c._max_sstable_size));
+    _c._large_partition_splits++;
     // Close partition in current writer, and open it again in a new writer.
     do_consume_end_of_partition();
     stop_current_writer();
@@ -1054,9 +1156,13 @@ class reshape_compaction : public compaction {
 };
 
 class regular_compaction : public compaction {
+protected:
     // keeps track of monitors for input sstable, which are responsible for adjusting backlog as compaction progresses.
     mutable compaction_read_monitor_generator _monitor_generator;
+private:
     seastar::semaphore _replacer_lock = {1};
+    // Number of _cdata.pending_replacements already applied to the sstable set.
+    size_t _applied_pending_replacements = 0;
 public:
     regular_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata)
         : compaction(table_s, std::move(descriptor), cdata)
@@ -1067,7 +1173,7 @@ class regular_compaction : public compaction {
     flat_mutation_reader_v2 make_sstable_reader() const override {
         return _compacting->make_local_shard_sstable_reader(_schema,
                 _permit,
-                query::full_partition_range,
+                input_partition_range(),
                 _schema->full_slice(),
                 tracing::trace_state_ptr(),
                 ::streamed_mutation::forwarding::no,
@@ -1126,6 +1232,9 @@ class regular_compaction : public compaction {
             // so we need to release reference to them.
             std::for_each(exhausted, _sstables.end(), [this] (shared_sstable& sst) {
                 _compacting_for_max_purgeable_func.erase(sst);
+                if (_max_purgeable) {
+                    _max_purgeable->invalidate();
+                }
                 // Fully expired sstable is not actually compacted, therefore it's not present in the compacting set.
                 _compacting->erase(sst);
             });
@@ -1161,12 +1270,13 @@ class regular_compaction : public compaction {
     }
 
     void update_pending_ranges() {
-        if (!_sstable_set || _sstable_set->all()->empty() || _cdata.pending_replacements.empty()) { // set can be empty for testing scenario.
+        auto& pending_replacements = _cdata.pending_replacements;
+        if (!_sstable_set || _sstable_set->all()->empty() || pending_replacements.size() == _applied_pending_replacements) { // set can be empty for testing scenario.
             return;
         }
         // Releases reference to sstables compacted by this compaction or another, both of which belongs
         // to the same column family
-        for (auto& pending_replacement : _cdata.pending_replacements) {
+        for (auto& pending_replacement : boost::make_iterator_range(pending_replacements.begin() + _applied_pending_replacements, pending_replacements.end())) {
             for (auto& sst : pending_replacement.removed) {
                 // Set may not contain sstable to be removed because this compaction may have started
                 // before the creation of that sstable.
@@ -1180,7 +1290,13 @@ class regular_compaction : public compaction {
             }
         }
         _selector.emplace(_sstable_set->make_incremental_selector());
-        _cdata.pending_replacements.clear();
+        // Compactions of token sub-ranges of a job share its compaction_data, so the
+        // replacements must be kept for the compactions of the other sub-ranges.
+        if (_token_range) {
+            _applied_pending_replacements = pending_replacements.size();
+        } else {
+            pending_replacements.clear();
+        }
     }
 };
 
@@ -1200,7 +1316,45 @@ class cleanup_compaction final : public regular_compaction {
 
         return dht::subtract_ranges(*_schema, non_owned_ranges, std::move(owned_ranges)).get();
     }
+
+    // The owned token ranges overlapping the input, as partition ranges, in ring order.
+    dht::partition_range_vector owned_input_ranges() const {
+        auto first = _sstables.front()->get_first_decorated_key().token();
+        auto last = _sstables.front()->get_last_decorated_key().token();
+        for (auto& sst : _sstables) {
+            first = std::min(first, sst->get_first_decorated_key().token());
+            last = std::max(last, sst->get_last_decorated_key().token());
+        }
+        auto input_range = _token_range.value_or(dht::token_range::make(first, last));
+        dht::partition_range_vector ranges;
+        for (auto& owned : *_owned_ranges) {
+            if (auto r = owned.intersection(input_range, dht::token_comparator())) {
+                ranges.push_back(dht::to_partition_range(std::move(*r)));
+            }
+        }
+        return ranges;
+    }
 protected:
+    // Reads the owned ranges only, so the sstable readers skip the disowned partitions
+    // with the index instead of reading and filtering them out, and the input sstables
+    // that are entirely disowned aren't read at all.
+    flat_mutation_reader_v2 make_sstable_reader() const override {
+        if (!_owned_ranges || _sstables.empty()) {
+            return regular_compaction::make_sstable_reader();
+        }
+        auto source = mutation_source([this] (schema_ptr s, reader_permit permit, const dht::partition_range& pr, const query::partition_slice& slice,
+                tracing::trace_state_ptr trace_state, streamed_mutation::forwarding fwd, mutation_reader::forwarding fwd_mr) {
+            return _compacting->make_local_shard_sstable_reader(std::move(s), std::move(permit), pr, slice, std::move(trace_state), fwd, fwd_mr, _monitor_generator);
+        });
+        return make_flat_multi_range_reader(_schema, _permit, std::move(source),
+                [ranges = make_lw_shared(owned_input_ranges()), i = size_t(0)] () mutable -> std::optional<dht::partition_range> {
+            if (i == ranges->size()) {
+                return std::nullopt;
+            }
+            return (*ranges)[i++];
+        }, _schema->full_slice());
+    }
+
     virtual compaction_completion_desc
     get_compaction_completion_desc(std::vector<shared_sstable> input_sstables, std::vector<shared_sstable> output_sstables) override {
         auto ranges_for_for_invalidation = get_ranges_for_invalidation(input_sstables);
@@ -1778,4 +1932,14 @@ uint64_t compaction_descriptor::sstables_size() const {
     return boost::accumulate(sstables | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::data_size)), uint64_t(0));
 }
 
+dht::token_range compaction_descriptor::token_range() const {
+    auto first = sstables.front()->get_first_decorated_key().token();
+    auto last = sstables.front()->get_last_decorated_key().token();
+    for (auto& sst : sstables) {
+        first = std::min(first, sst->get_first_decorated_key().token());
+        last = std::max(last, sst->get_last_decorated_key().token());
+    }
+    return dht::token_range::make(first, last);
+}
+
 }
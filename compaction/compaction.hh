@@ -76,16 +76,22 @@ struct compaction_stats {
     std::chrono::time_point<db_clock> ended_at;
     uint64_t start_size = 0;
     uint64_t end_size = 0;
+    // Size of the input sstables which were fully expired, and so dropped without being read
+    uint64_t fully_expired_size = 0;
     uint64_t validation_errors = 0;
     // Bloom filter checks during max purgeable calculation
     uint64_t bloom_filter_checks = 0;
+    // Number of times a partition was continued in a new sstable to respect the sstable size limit
+    uint64_t large_partition_splits = 0;
 
     compaction_stats& operator+=(const compaction_stats& r) {
         ended_at = std::max(ended_at, r.ended_at);
         start_size += r.start_size;
         end_size += r.end_size;
+        fully_expired_size += r.fully_expired_size;
         validation_errors += r.validation_errors;
         bloom_filter_checks += r.bloom_filter_checks;
+        large_partition_splits += r.large_partition_splits;
         return *this;
     }
     friend compaction_stats operator+(const compaction_stats& l, const compaction_stats& r) {
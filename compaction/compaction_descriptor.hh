@@ -153,6 +153,11 @@ struct compaction_descriptor {
     compaction::owned_ranges_ptr owned_ranges;
     // Required for reshard compaction.
     const dht::sharder* sharder;
+    // If engaged, only the partitions of the input sstables which fall in this range are compacted,
+    // and the input sstables are replaced only once, when the compaction is done, so the caller is
+    // responsible for compacting the rest of the ranges before the replacement takes effect.
+    // See compaction_task_executor::compact_sstables_in_subranges().
+    std::optional<dht::token_range> token_range;
 
     compaction_sstable_creator_fn creator;
     compaction_sstable_replacer_fn replacer;
@@ -195,6 +200,8 @@ struct compaction_descriptor {
     void enable_garbage_collection(sstables::sstable_set snapshot) { all_sstables_snapshot = std::move(snapshot); }
     // Returns total size of all sstables contained in this descriptor
     uint64_t sstables_size() const;
+    // Returns the token range spanned by the sstables of this descriptor, which must not be empty
+    dht::token_range token_range() const;
 };
 
 }
@@ -22,6 +22,7 @@
 #include "utils/fb_utilities.hh"
 #include "utils/UUID_gen.hh"
 #include "db/system_keyspace.hh"
+#include <bit>
 #include <cmath>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
@@ -172,7 +173,16 @@ unsigned compaction_manager::current_compaction_fan_in_threshold() const {
 bool compaction_manager::can_register_compaction(table_state& t, int weight, unsigned fan_in) const {
     // Only one weight is allowed if parallel compaction is disabled.
     if (!t.get_compaction_strategy().parallel_compaction() && has_table_ongoing_compaction(t)) {
-        return false;
+        if (!t.get_compaction_strategy().disjoint_parallel_compaction()) {
+            return false;
+        }
+        // The strategy only picks jobs disjoint from the ongoing ones of the table when
+        // there are any, and those don't compete for the same data, so neither the weight
+        // nor the fan-in of the job is checked against them.
+        auto ongoing = std::count_if(_tasks.begin(), _tasks.end(), [&t] (const shared_ptr<compaction_task_executor>& task) {
+            return task->compacting_table() == &t && task->compaction_running();
+        });
+        return size_t(ongoing) < leveled_parallelism();
     }
     // Weightless compaction doesn't have to be serialized, and won't dillute overall efficiency.
     if (!weight) {
@@ -201,7 +211,9 @@ void compaction_manager::register_weight(int weight) {
 }
 
 void compaction_manager::deregister_weight(int weight) {
-    _weight_tracker.erase(weight);
+    if (auto it = _weight_tracker.find(weight); it != _weight_tracker.end()) {
+        _weight_tracker.erase(it);
+    }
     reevaluate_postponed_compactions();
 }
 
@@ -333,7 +345,10 @@ future<sstables::compaction_result> compaction_task_executor::compact_sstables_a
     }
 
     bool should_update_history = this->should_update_history(descriptor.options.type());
-    sstables::compaction_result res = co_await compact_sstables(std::move(descriptor), cdata, std::move(release_exhausted), std::move(can_purge));
+    sstables::compaction_result res = subranges_for(descriptor) > 1
+            ? co_await compact_sstables_in_subranges(std::move(descriptor), cdata, std::move(release_exhausted), std::move(can_purge))
+            : co_await compact_sstables(std::move(descriptor), cdata, std::move(release_exhausted), std::move(can_purge));
+    _cm._stats.fully_expired_bytes_dropped += res.stats.fully_expired_size;
 
     if (should_update_history) {
         co_await update_history(*_compacting_table, res, cdata);
@@ -341,7 +356,7 @@ future<sstables::compaction_result> compaction_task_executor::compact_sstables_a
 
     co_return res;
 }
-future<sstables::compaction_result> compaction_task_executor::compact_sstables(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, release_exhausted_func_t release_exhausted, compaction_manager::can_purge_tombstones can_purge) {
+void compaction_task_executor::prepare_descriptor(sstables::compaction_descriptor& descriptor, release_exhausted_func_t release_exhausted, compaction_manager::can_purge_tombstones can_purge) {
     table_state& t = *_compacting_table;
     if (can_purge) {
         descriptor.enable_garbage_collection(t.main_sstable_set());
@@ -378,8 +393,73 @@ future<sstables::compaction_result> compaction_task_executor::compact_sstables(s
             descriptor.owned_ranges = cs.owned_ranges_ptr;
         }
     }
+}
+
+future<sstables::compaction_result> compaction_task_executor::compact_sstables(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, release_exhausted_func_t release_exhausted, compaction_manager::can_purge_tombstones can_purge) {
+    prepare_descriptor(descriptor, std::move(release_exhausted), can_purge);
+    auto res = co_await sstables::compact_sstables(std::move(descriptor), cdata, *_compacting_table);
+    _cm._stats.bytes_compacted += res.stats.start_size;
+    _cm._stats.bytes_written += res.stats.end_size;
+    co_return res;
+}
+
+unsigned compaction_task_executor::subranges_for(const sstables::compaction_descriptor& descriptor) const {
+    switch (descriptor.options.type()) {
+    case sstables::compaction_type::Compaction:
+    case sstables::compaction_type::Cleanup:
+    case sstables::compaction_type::Upgrade:
+        break;
+    default:
+        return 1;
+    }
+    uint64_t parallelism = std::min<uint64_t>(_cm.subrange_parallelism(), descriptor.sstables_size() / min_subrange_size);
+    // The ring is split into a power of two ranges, see dht::split_token_range_msb().
+    return parallelism > 1 ? std::bit_floor(parallelism) : 1;
+}
+
+// Compacts the sstables of the descriptor by splitting the token ring into subranges_for(descriptor)
+// ranges, which are compacted concurrently, each by a compaction of its own sharing cdata (so
+// stopping the task stops all of them). The output sstables of all ranges belong to the run of the
+// descriptor, since the ranges are disjoint. The input sstables are replaced by the output ones only
+// once all ranges are compacted, so the exhausted sstables cannot be released early, like reshape.
+future<sstables::compaction_result> compaction_task_executor::compact_sstables_in_subranges(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, release_exhausted_func_t release_exhausted, compaction_manager::can_purge_tombstones can_purge) {
+    table_state& t = *_compacting_table;
+    auto ranges = dht::split_token_range_msb(std::countr_zero(subranges_for(descriptor)));
+    prepare_descriptor(descriptor, std::move(release_exhausted), can_purge);
+    cmlog.info("Compacting {} in {} token ranges concurrently", *_compacting_table, ranges.size());
+
+    sstables::compaction_result res;
+    std::exception_ptr ex;
+    co_await coroutine::parallel_for_each(ranges, [&] (const dht::token_range& range) -> future<> {
+        auto range_descriptor = descriptor;
+        range_descriptor.token_range = range;
+        // The input sstables are replaced below, once the rest of the ranges are done too.
+        range_descriptor.replacer = [] (sstables::compaction_completion_desc) {};
+        try {
+            auto range_res = co_await sstables::compact_sstables(std::move(range_descriptor), cdata, t);
+            std::move(range_res.new_sstables.begin(), range_res.new_sstables.end(), std::back_inserter(res.new_sstables));
+            res.stats += range_res.stats;
+        } catch (...) {
+            // The other ranges are left to complete, as stopping cdata would prevent the task from retrying.
+            if (!ex) {
+                ex = std::current_exception();
+            }
+        }
+    });
+    if (ex) {
+        // The compactions of the failed ranges deleted their own output already.
+        for (auto& sst : res.new_sstables) {
+            sst->mark_for_deletion();
+        }
+        std::rethrow_exception(std::move(ex));
+    }
 
-    co_return co_await sstables::compact_sstables(std::move(descriptor), cdata, t);
+    co_await seastar::async([&] {
+        descriptor.replacer(sstables::compaction_completion_desc{std::move(descriptor.sstables), res.new_sstables});
+    });
+    _cm._stats.bytes_compacted += res.stats.start_size;
+    _cm._stats.bytes_written += res.stats.end_size;
+    co_return res;
 }
 future<> compaction_task_executor::update_history(table_state& t, const sstables::compaction_result& res, const sstables::compaction_data& cdata) {
     auto ended_at = std::chrono::duration_cast<std::chrono::milliseconds>(res.stats.ended_at.time_since_epoch());
@@ -543,6 +623,11 @@ future<> compaction_manager::update_static_shares(float static_shares) {
     return _compaction_controller.update_static_shares(static_shares);
 }
 
+future<> compaction_manager::update_latency_target(std::chrono::microseconds target) {
+    cmlog.info("Updating compaction controller latency target to {}us", target.count());
+    return _compaction_controller.update_latency_target(_cfg.latency_sensitive_sched_group, target);
+}
+
 compaction_manager::compaction_reenabler::compaction_reenabler(compaction_manager& cm, table_state& t)
     : _cm(cm)
     , _table(&t)
@@ -714,6 +799,7 @@ void compaction_task_executor::setup_new_compaction(sstables::run_id output_run_
 void compaction_task_executor::finish_compaction(state finish_state) noexcept {
     switch_state(finish_state);
     _output_run_identifier = sstables::run_id::create_null_id();
+    _compacting_token_range.reset();
     if (finish_state != state::failed) {
         _compaction_retry.reset();
     }
@@ -752,11 +838,16 @@ compaction_manager::compaction_manager(config cfg, abort_source& as, tasks::task
     , _throughput_updater(serialized_action([this] { return update_throughput(throughput_mbs()); }))
     , _update_compaction_static_shares_action([this] { return update_static_shares(static_shares()); })
     , _compaction_static_shares_observer(_cfg.static_shares.observe(_update_compaction_static_shares_action.make_observer()))
+    , _update_latency_target_action([this] { return update_latency_target(latency_target()); })
+    , _latency_target_observer(_cfg.latency_target_us.observe(_update_latency_target_action.make_observer()))
     , _strategy_control(std::make_unique<strategy_control>(*this))
     , _tombstone_gc_state(&_repair_history_maps)
 {
     tm.register_module(_task_manager_module->get_name(), _task_manager_module);
     register_metrics();
+    if (latency_target().count() > 0) {
+        (void)_update_latency_target_action.trigger_later();
+    }
     // Bandwidth throttling is node-wide, updater is needed on single shard
     if (this_shard_id() == 0) {
         _throughput_option_observer.emplace(_cfg.throughput_mb_per_sec.observe(_throughput_updater.make_observer()));
@@ -775,6 +866,8 @@ compaction_manager::compaction_manager(tasks::task_manager& tm)
     , _throughput_updater(serialized_action([this] { return update_throughput(throughput_mbs()); }))
     , _update_compaction_static_shares_action([] { return make_ready_future<>(); })
     , _compaction_static_shares_observer(_cfg.static_shares.observe(_update_compaction_static_shares_action.make_observer()))
+    , _update_latency_target_action([] { return make_ready_future<>(); })
+    , _latency_target_observer(_cfg.latency_target_us.observe(_update_latency_target_action.make_observer()))
     , _strategy_control(std::make_unique<strategy_control>(*this))
     , _tombstone_gc_state(&_repair_history_maps)
 {
@@ -822,6 +915,14 @@ void compaction_manager::register_metrics() {
                        sm::description("Holds the sum of normalized compaction backlog for all tables in the system. Backlog is normalized by dividing backlog by shard's available memory.")),
         sm::make_counter("validation_errors", [this] { return _validation_errors; },
                        sm::description("Holds the number of encountered validation errors.")),
+        sm::make_counter("fully_expired_bytes_dropped", [this] { return _stats.fully_expired_bytes_dropped; },
+                       sm::description("Holds the number of bytes of fully expired sstables which were dropped by compaction without being read.")),
+        sm::make_counter("compacted_bytes", [this] { return _stats.bytes_compacted; },
+                       sm::description("Holds the number of bytes of sstables compacted by compaction tasks.")),
+        sm::make_counter("compaction_written_bytes", [this] { return _stats.bytes_written; },
+                       sm::description("Holds the number of bytes of sstables written by compaction tasks.")),
+        sm::make_gauge("latency_scale", [this] { return _compaction_controller.latency_scale(); },
+                       sm::description("Holds the factor by which compaction shares are scaled down to meet the latency target, 1 if they aren't.")),
     });
 }
 
@@ -955,6 +1056,7 @@ future<> compaction_manager::really_do_stop() {
     co_await _compaction_controller.shutdown();
     co_await _throughput_updater.join();
     co_await _update_compaction_static_shares_action.join();
+    co_await _update_latency_target_action.join();
     cmlog.info("Stopped");
 }
 
@@ -1066,6 +1168,11 @@ class regular_compaction_task_executor : public compaction_task_executor {
                 fmt::ptr(this), descriptor.sstables.size(), weight, t);
 
             setup_new_compaction(descriptor.run_identifier);
+            _compacting_token_range = descriptor.token_range();
+            if (cs.disjoint_parallel_compaction() && !cs.parallel_compaction() && _cm.leveled_parallelism() > 1) {
+                // Start looking for another job of the table, disjoint from this one.
+                _cm.submit(t);
+            }
             std::exception_ptr ex;
 
             try {
@@ -1424,6 +1531,21 @@ future<compaction_manager::compaction_stats_opt> compaction_manager::rewrite_sst
     return perform_task_on_all_files<rewrite_sstables_compaction_task_executor>(t, std::move(options), std::move(owned_ranges_ptr), std::move(get_func), can_purge);
 }
 
+future<> compaction_manager::mark_sstables_as_repaired(table_state& t, std::function<bool(const sstables::sstable&)> filter, uint64_t repaired_at) {
+    if (_state != state::enabled) {
+        co_return;
+    }
+    auto sstables = get_candidates(t);
+    std::erase_if(sstables, [&] (const sstables::shared_sstable& sst) {
+        return !filter(*sst) || requires_cleanup(t, sst);
+    });
+    compacting_sstable_registration compacting(*this, get_compaction_state(&t), sstables);
+    for (auto& sst : sstables) {
+        co_await sst->mutate_repaired_at(repaired_at);
+    }
+    cmlog.debug("Marked {} sstables of {}.{} as repaired at {}", sstables.size(), t.schema()->ks_name(), t.schema()->cf_name(), repaired_at);
+}
+
 namespace compaction {
 
 class validate_sstables_compaction_task_executor : public sstables_task_executor {
@@ -1497,6 +1619,21 @@ future<compaction_manager::compaction_stats_opt> compaction_manager::perform_sst
     return perform_task(seastar::make_shared<validate_sstables_compaction_task_executor>(*this, &t, std::move(all_sstables)));
 }
 
+// Returns true iff none of the tokens spanned by the sstable is owned.
+static bool fully_disowned(const sstables::shared_sstable& sst, const dht::token_range_vector& sorted_owned_ranges) {
+    auto first_token = sst->get_first_decorated_key().token();
+    auto last_token = sst->get_last_decorated_key().token();
+    dht::token_range sst_token_range = dht::token_range::make(first_token, last_token);
+
+    // The first owned range not entirely before the sstable is the only one that can overlap it,
+    // as the owned ranges are sorted and disjoint.
+    auto r = std::lower_bound(sorted_owned_ranges.begin(), sorted_owned_ranges.end(), first_token,
+            [] (const range<dht::token>& a, const dht::token& b) {
+        return a.after(b, dht::token_comparator());
+    });
+    return r == sorted_owned_ranges.end() || !r->overlaps(sst_token_range, dht::token_comparator());
+}
+
 namespace compaction {
 
 class cleanup_sstables_compaction_task_executor : public compaction_task_executor {
@@ -1511,11 +1648,24 @@ class cleanup_sstables_compaction_task_executor : public compaction_task_executo
             , _cleanup_options(std::move(options))
             , _owned_ranges_ptr(std::move(owned_ranges_ptr))
             , _compacting(std::move(compacting))
-            , _pending_cleanup_jobs(t->get_compaction_strategy().get_cleanup_compaction_jobs(*t, std::move(candidates)))
     {
+        std::vector<sstables::shared_sstable> disowned;
+        if (_owned_ranges_ptr) {
+            auto it = std::partition(candidates.begin(), candidates.end(), [this] (const sstables::shared_sstable& sst) {
+                return !fully_disowned(sst, *_owned_ranges_ptr);
+            });
+            disowned.assign(std::make_move_iterator(it), std::make_move_iterator(candidates.end()));
+            candidates.erase(it, candidates.end());
+        }
+        _pending_cleanup_jobs = t->get_compaction_strategy().get_cleanup_compaction_jobs(*t, std::move(candidates));
         // Cleanup is made more resilient under disk space pressure, by cleaning up smaller jobs first, so larger jobs
         // will have more space available released by previous jobs.
         std::ranges::sort(_pending_cleanup_jobs, std::ranges::greater(), std::mem_fn(&sstables::compaction_descriptor::sstables_size));
+        // The sstables holding no owned token are dropped first, in a single job: cleanup
+        // doesn't read them, so it releases their disk space right away.
+        if (!disowned.empty()) {
+            _pending_cleanup_jobs.emplace_back(std::move(disowned));
+        }
         _cm._stats.pending_tasks += _pending_cleanup_jobs.size();
     }
 
@@ -1886,6 +2036,16 @@ class compaction_manager::strategy_control : public compaction::strategy_control
                 && task->compacting_table()->schema()->cf_name() == s->cf_name();
         });
     }
+
+    std::vector<dht::token_range> ongoing_compaction_ranges(table_state& table_s) const override {
+        std::vector<dht::token_range> ranges;
+        for (auto& task : _cm._tasks) {
+            if (task->compacting_table() == &table_s && task->compaction_running()) {
+                ranges.push_back(task->compacting_token_range().value_or(dht::token_range::make_open_ended_both_sides()));
+            }
+        }
+        return ranges;
+    }
 };
 
 strategy_control& compaction_manager::get_strategy_control() const noexcept {
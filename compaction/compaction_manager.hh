@@ -48,9 +48,23 @@ class compaction_history_entry;
 
 class compacting_sstable_registration;
 
+// The last repair time of the token ranges of a table.
+//
+// Adjacent ranges repaired at the same time are coalesced. As frequent small
+// repairs (e.g. of tablets) leave many ranges behind, the map is bounded to
+// max_ranges: past it, the adjacent ranges with the closest repair times are
+// merged, keeping the older one. This can only delay tombstone gc, never let
+// it happen before the data was repaired.
 class repair_history_map {
 public:
+    static constexpr size_t max_ranges = 16 * 1024;
+
     boost::icl::interval_map<dht::token, gc_clock::time_point, boost::icl::partial_absorber, std::less, boost::icl::inplace_max> map;
+
+    void update_repair_time(const dht::token_range& range, gc_clock::time_point repair_time);
+private:
+    // Merges adjacent ranges until at most `target` are left, see above.
+    void coalesce(size_t target);
 };
 
 namespace compaction {
@@ -76,6 +90,11 @@ class compaction_manager {
         int64_t completed_tasks = 0;
         uint64_t active_tasks = 0; // Number of compaction going on.
         int64_t errors = 0;
+        // Bytes of fully expired sstables dropped by compaction without being read.
+        uint64_t fully_expired_bytes_dropped = 0;
+        // Bytes of sstables read and written by compaction tasks, for evaluating write amplification.
+        uint64_t bytes_compacted = 0;
+        uint64_t bytes_written = 0;
     };
     using scheduling_group = backlog_controller::scheduling_group;
     struct config {
@@ -84,6 +103,14 @@ class compaction_manager {
         size_t available_memory = 0;
         utils::updateable_value<float> static_shares = utils::updateable_value<float>(0);
         utils::updateable_value<uint32_t> throughput_mb_per_sec = utils::updateable_value<uint32_t>(0);
+        // Maximum number of token ranges major, cleanup and upgrade compaction jobs are split into, to be compacted concurrently.
+        utils::updateable_value<uint32_t> subrange_parallelism = utils::updateable_value<uint32_t>(1);
+        // Maximum number of regular compactions of disjoint token ranges run concurrently for a leveled table.
+        utils::updateable_value<uint32_t> leveled_parallelism = utils::updateable_value<uint32_t>(1);
+        // If non-zero, compaction shares are scaled down while the scheduling latency of
+        // latency_sensitive_sched_group exceeds this many microseconds.
+        seastar::scheduling_group latency_sensitive_sched_group = seastar::default_scheduling_group();
+        utils::updateable_value<uint32_t> latency_target_us = utils::updateable_value<uint32_t>(0);
     };
 
 public:
@@ -126,7 +153,8 @@ class compaction_manager {
     std::unordered_set<compaction::table_state*> _postponed;
     // tracks taken weights of ongoing compactions, only one compaction per weight is allowed.
     // weight is value assigned to a compaction job that is log base N of total size of all input sstables.
-    std::unordered_set<int> _weight_tracker;
+    // A multiset, as jobs of disjoint token ranges of a leveled table can run with the same weight.
+    std::unordered_multiset<int> _weight_tracker;
 
     std::unordered_map<compaction::table_state*, compaction_state> _compaction_state;
 
@@ -155,6 +183,8 @@ class compaction_manager {
     std::optional<utils::observer<uint32_t>> _throughput_option_observer;
     serialized_action _update_compaction_static_shares_action;
     utils::observer<float> _compaction_static_shares_observer;
+    serialized_action _update_latency_target_action;
+    utils::observer<uint32_t> _latency_target_observer;
     uint64_t _validation_errors = 0;
 
     class strategy_control;
@@ -213,6 +243,7 @@ class compaction_manager {
 
     future<compaction_stats_opt> perform_sstable_scrub_validate_mode(compaction::table_state& t);
     future<> update_static_shares(float shares);
+    future<> update_latency_target(std::chrono::microseconds target);
 
     using get_candidates_func = std::function<future<std::vector<sstables::shared_sstable>>()>;
 
@@ -265,6 +296,18 @@ class compaction_manager {
         return _cfg.throughput_mb_per_sec.get();
     }
 
+    uint32_t subrange_parallelism() const noexcept {
+        return _cfg.subrange_parallelism.get();
+    }
+
+    uint32_t leveled_parallelism() const noexcept {
+        return _cfg.leveled_parallelism.get();
+    }
+
+    std::chrono::microseconds latency_target() const noexcept {
+        return std::chrono::microseconds(_cfg.latency_target_us.get());
+    }
+
     void register_metrics();
 
     // enable the compaction manager.
@@ -313,6 +356,13 @@ class compaction_manager {
     // Submit a table to be upgraded and wait for its termination.
     future<> perform_sstable_upgrade(owned_ranges_ptr sorted_owned_ranges, compaction::table_state& t, bool exclude_current_version);
 
+    // Marks the sstables of the table matching the filter as repaired at repaired_at,
+    // see sstable::mutate_repaired_at(). They are registered as compacting meanwhile,
+    // not to be compacted away while their Statistics is rewritten. The ones being
+    // compacted, and the ones requiring cleanup (with data not owned by this node,
+    // thus not repaired), are skipped.
+    future<> mark_sstables_as_repaired(compaction::table_state& t, std::function<bool(const sstables::sstable&)> filter, uint64_t repaired_at);
+
     // Submit a table to be scrubbed and wait for its termination.
     future<compaction_stats_opt> perform_sstable_scrub(compaction::table_state& t, sstables::compaction_type_options::scrub opts);
 
@@ -462,6 +512,8 @@ class compaction_task_executor {
     exponential_backoff_retry _compaction_retry = exponential_backoff_retry(std::chrono::seconds(5), std::chrono::seconds(300));
     sstables::compaction_type _type;
     sstables::run_id _output_run_identifier;
+    // Token range of the sstables being compacted, if known
+    std::optional<dht::token_range> _compacting_token_range;
     sstring _description;
 
 public:
@@ -499,6 +551,16 @@ class compaction_task_executor {
                                 compaction_manager::can_purge_tombstones can_purge = compaction_manager::can_purge_tombstones::yes);
     future<sstables::compaction_result> compact_sstables(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, release_exhausted_func_t release_exhausted,
                                 compaction_manager::can_purge_tombstones can_purge = compaction_manager::can_purge_tombstones::yes);
+private:
+    // Token sub-ranges compacted concurrently by compact_sstables_in_subranges() are at least this large, on average.
+    static constexpr uint64_t min_subrange_size = uint64_t(1) << 30;
+
+    void prepare_descriptor(sstables::compaction_descriptor& descriptor, release_exhausted_func_t release_exhausted, compaction_manager::can_purge_tombstones can_purge);
+    // Number of token sub-ranges the job of the descriptor is split into, 1 if it is not split.
+    unsigned subranges_for(const sstables::compaction_descriptor& descriptor) const;
+    future<sstables::compaction_result> compact_sstables_in_subranges(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, release_exhausted_func_t release_exhausted,
+                                compaction_manager::can_purge_tombstones can_purge);
+protected:
     future<> update_history(::compaction::table_state& t, const sstables::compaction_result& res, const sstables::compaction_data& cdata);
     bool should_update_history(sstables::compaction_type ct) {
         return ct == sstables::compaction_type::Compaction;
@@ -533,6 +595,10 @@ class compaction_task_executor {
         return _output_run_identifier;
     }
 
+    const std::optional<dht::token_range>& compacting_token_range() const noexcept {
+        return _compacting_token_range;
+    }
+
     const sstring& description() const noexcept {
         return _description;
     }
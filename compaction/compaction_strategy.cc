@@ -63,7 +63,69 @@ bool compaction_strategy_impl::worth_dropping_tombstones(const shared_sstable& s
         return false;
     }
     auto gc_before = sst->get_gc_before_for_drop_estimation(compaction_time, gc_state);
-    return sst->estimate_droppable_tombstone_ratio(gc_before) >= _tombstone_threshold;
+    return sst->estimate_droppable_tombstone_ratio(gc_before) >= _tombstone_threshold
+            || tombstones_slow_down_reads(sst, compaction_time, gc_state);
+}
+
+bool compaction_strategy_impl::tombstones_slow_down_reads(const shared_sstable& sst, gc_clock::time_point compaction_time, const tombstone_gc_state& gc_state) const {
+    if (_disable_tombstone_compaction || _tombstone_read_threshold <= 0) {
+        return false;
+    }
+    auto& stats = sst->get_stats();
+    auto fragments_read = stats.fragments_read();
+    if (fragments_read < MIN_FRAGMENTS_READ_FOR_TOMBSTONE_READ_RATIO
+            || double(stats.tombstones_read()) / fragments_read < _tombstone_read_threshold) {
+        return false;
+    }
+    auto gc_before = sst->get_gc_before_for_drop_estimation(compaction_time, gc_state);
+    return sst->estimate_droppable_tombstone_ratio(gc_before) > 0;
+}
+
+compaction_descriptor compaction_strategy_impl::get_fully_expired_sstables_job(table_state& table_s, const std::vector<shared_sstable>& candidates,
+        gc_clock::time_point compaction_time) const {
+    if (!table_s.tombstone_gc_enabled()) {
+        return compaction_descriptor();
+    }
+    const auto& gc_state = table_s.get_tombstone_gc_state();
+    auto may_be_fully_expired = std::any_of(candidates.begin(), candidates.end(), [&] (const shared_sstable& sst) {
+        return sst->get_max_local_deletion_time() < sst->get_gc_before_for_fully_expire(compaction_time, gc_state);
+    });
+    if (!may_be_fully_expired) {
+        return compaction_descriptor();
+    }
+    auto expired = table_s.fully_expired_sstables(candidates, compaction_time);
+    if (expired.empty()) {
+        return compaction_descriptor();
+    }
+    clogger.debug("Going to drop {} fully expired sstables of {}.{}", expired.size(), table_s.schema()->ks_name(), table_s.schema()->cf_name());
+    return compaction_descriptor(has_only_fully_expired::yes, std::vector<shared_sstable>(expired.begin(), expired.end()));
+}
+
+compaction_descriptor compaction_strategy_impl::make_tombstone_compaction_job(table_state& table_s, const shared_sstable& sst,
+        const std::vector<shared_sstable>& candidates, gc_clock::time_point compaction_time, size_t max_sstables) const {
+    if (!tombstones_slow_down_reads(sst, compaction_time, table_s.get_tombstone_gc_state())) {
+        return compaction_descriptor({ sst });
+    }
+    auto& s = *table_s.schema();
+    // Data shadowed by the tombstones of sst is older than them, and overlaps sst.
+    auto max_timestamp = sst->get_stats_metadata().max_timestamp;
+    std::vector<shared_sstable> sstables;
+    for (auto& candidate : candidates) {
+        if (candidate == sst || candidate->get_stats_metadata().min_timestamp > max_timestamp
+                || candidate->get_first_decorated_key().tri_compare(s, sst->get_last_decorated_key()) > 0
+                || candidate->get_last_decorated_key().tri_compare(s, sst->get_first_decorated_key()) < 0) {
+            continue;
+        }
+        sstables.push_back(candidate);
+    }
+    if (sstables.size() >= max_sstables) {
+        std::sort(sstables.begin(), sstables.end(), [] (const shared_sstable& a, const shared_sstable& b) {
+            return a->data_size() < b->data_size();
+        });
+        sstables.resize(std::max<size_t>(max_sstables, 1) - 1);
+    }
+    sstables.push_back(sst);
+    return compaction_descriptor(std::move(sstables));
 }
 
 uint64_t compaction_strategy_impl::adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate) const {
@@ -97,6 +159,9 @@ compaction_strategy_impl::compaction_strategy_impl(const std::map<sstring, sstri
     auto interval = property_definitions::to_long(TOMBSTONE_COMPACTION_INTERVAL_OPTION, tmp_value, DEFAULT_TOMBSTONE_COMPACTION_INTERVAL().count());
     _tombstone_compaction_interval = db_clock::duration(std::chrono::seconds(interval));
 
+    tmp_value = get_value(options, TOMBSTONE_READ_THRESHOLD_OPTION);
+    _tombstone_read_threshold = property_definitions::to_double(TOMBSTONE_READ_THRESHOLD_OPTION, tmp_value, DEFAULT_TOMBSTONE_READ_THRESHOLD);
+
     // FIXME: validate options.
 }
 
@@ -484,7 +549,8 @@ time_window_compaction_strategy::time_window_compaction_strategy(const std::map<
     , _options(options)
     , _stcs_options(options)
 {
-    if (!options.contains(TOMBSTONE_COMPACTION_INTERVAL_OPTION) && !options.contains(TOMBSTONE_THRESHOLD_OPTION)) {
+    if (!options.contains(TOMBSTONE_COMPACTION_INTERVAL_OPTION) && !options.contains(TOMBSTONE_THRESHOLD_OPTION)
+            && !options.contains(TOMBSTONE_READ_THRESHOLD_OPTION)) {
         _disable_tombstone_compaction = true;
         clogger.debug("Disabling tombstone compactions for TWCS");
     } else {
@@ -649,7 +715,8 @@ date_tiered_compaction_strategy::date_tiered_compaction_strategy(const std::map<
     // - with time series workloads, it's usually better to wait for whole sstable to be expired rather than
     // compacting a single sstable when it's more than 20% (default value) expired.
     // For more details, see CASSANDRA-9234
-    if (!options.contains(TOMBSTONE_COMPACTION_INTERVAL_OPTION) && !options.contains(TOMBSTONE_THRESHOLD_OPTION)) {
+    if (!options.contains(TOMBSTONE_COMPACTION_INTERVAL_OPTION) && !options.contains(TOMBSTONE_THRESHOLD_OPTION)
+            && !options.contains(TOMBSTONE_READ_THRESHOLD_OPTION)) {
         _disable_tombstone_compaction = true;
         date_tiered_manifest::logger.debug("Disabling tombstone compactions for DTCS");
     } else {
@@ -733,6 +800,10 @@ bool compaction_strategy::parallel_compaction() const {
     return _compaction_strategy_impl->parallel_compaction();
 }
 
+bool compaction_strategy::disjoint_parallel_compaction() const {
+    return _compaction_strategy_impl->disjoint_parallel_compaction();
+}
+
 int64_t compaction_strategy::estimated_pending_compactions(table_state& table_s) const {
     return _compaction_strategy_impl->estimated_pending_compactions(table_s);
 }
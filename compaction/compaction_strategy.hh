@@ -57,6 +57,9 @@ class compaction_strategy {
     // Return if parallel compaction is allowed by strategy.
     bool parallel_compaction() const;
 
+    // Return if jobs of disjoint token ranges can run in parallel when parallel compaction isn't allowed.
+    bool disjoint_parallel_compaction() const;
+
     // Return if optimization to rule out sstables based on clustering key filter should be applied.
     bool use_clustering_key_filter() const;
 
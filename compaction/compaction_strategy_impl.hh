@@ -24,13 +24,19 @@ class compaction_strategy_impl {
     static constexpr float DEFAULT_TOMBSTONE_THRESHOLD = 0.2f;
     // minimum interval needed to perform tombstone removal compaction in seconds, default 86400 or 1 day.
     static constexpr std::chrono::seconds DEFAULT_TOMBSTONE_COMPACTION_INTERVAL() { return std::chrono::seconds(86400); }
+    // 0 disables read-triggered tombstone compaction.
+    static constexpr float DEFAULT_TOMBSTONE_READ_THRESHOLD = 0.0f;
+    // minimum number of fragments scanned by reads of a sstable for its tombstone read ratio to be considered.
+    static constexpr uint64_t MIN_FRAGMENTS_READ_FOR_TOMBSTONE_READ_RATIO = 1000;
 protected:
     const sstring TOMBSTONE_THRESHOLD_OPTION = "tombstone_threshold";
     const sstring TOMBSTONE_COMPACTION_INTERVAL_OPTION = "tombstone_compaction_interval";
+    const sstring TOMBSTONE_READ_THRESHOLD_OPTION = "tombstone_read_threshold";
 
     bool _use_clustering_key_filter = false;
     bool _disable_tombstone_compaction = false;
     float _tombstone_threshold = DEFAULT_TOMBSTONE_THRESHOLD;
+    float _tombstone_read_threshold = DEFAULT_TOMBSTONE_READ_THRESHOLD;
     db_clock::duration _tombstone_compaction_interval = DEFAULT_TOMBSTONE_COMPACTION_INTERVAL();
 public:
     static std::optional<sstring> get_value(const std::map<sstring, sstring>& options, const sstring& name);
@@ -52,6 +58,11 @@ class compaction_strategy_impl {
     virtual bool parallel_compaction() const {
         return true;
     }
+    // Whether a strategy that doesn't allow parallel compaction can still run jobs
+    // in parallel, as long as their token ranges don't overlap.
+    virtual bool disjoint_parallel_compaction() const {
+        return false;
+    }
     virtual int64_t estimated_pending_compactions(table_state& table_s) const = 0;
     virtual std::unique_ptr<sstable_set_impl> make_sstable_set(schema_ptr schema) const;
 
@@ -60,9 +71,27 @@ class compaction_strategy_impl {
     }
 
     // Check if a given sstable is entitled for tombstone compaction based on its
-    // droppable tombstone histogram and gc_before.
+    // droppable tombstone histogram and gc_before, or on the ratio of tombstones
+    // scanned by reads of it, see tombstones_slow_down_reads().
     bool worth_dropping_tombstones(const shared_sstable& sst, gc_clock::time_point compaction_time, const tombstone_gc_state& gc_state);
 
+    // Check if tombstones make up at least tombstone_read_threshold of what reads
+    // scanned in a given sstable, and some of its tombstones can be purged.
+    bool tombstones_slow_down_reads(const shared_sstable& sst, gc_clock::time_point compaction_time, const tombstone_gc_state& gc_state) const;
+
+    // Makes a job which drops the fully expired candidates, see get_fully_expired_sstables(), without
+    // reading them, or an empty job if there are none. The expensive check against overlapping sstables
+    // is done only if the metadata of some candidate shows it doesn't contain any live data.
+    compaction_descriptor get_fully_expired_sstables_job(table_state& table_s, const std::vector<shared_sstable>& candidates,
+            gc_clock::time_point compaction_time) const;
+
+    // Makes a job for dropping the tombstones of a sstable which worth_dropping_tombstones().
+    // When its tombstones slow down reads, the job also includes up to max_sstables - 1 of the
+    // candidates, preferably small ones, which may contain data shadowed by them, since the
+    // tombstones cannot be purged while they do. Otherwise, the sstable is compacted alone.
+    compaction_descriptor make_tombstone_compaction_job(table_state& table_s, const shared_sstable& sst,
+            const std::vector<shared_sstable>& candidates, gc_clock::time_point compaction_time, size_t max_sstables) const;
+
     virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const = 0;
 
     virtual uint64_t adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate) const;
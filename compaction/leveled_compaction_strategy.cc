@@ -21,6 +21,9 @@ leveled_compaction_strategy_state& leveled_compaction_strategy::get_state(table_
 
 compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control, std::vector<sstables::shared_sstable> candidates) {
     auto& state = get_state(table_s);
+    if (auto expired = get_fully_expired_sstables_job(table_s, candidates, gc_clock::now()); !expired.sstables.empty()) {
+        return expired;
+    }
     // NOTE: leveled_manifest creation may be slightly expensive, so later on,
     // we may want to store it in the strategy itself. However, the sstable
     // lists managed by the manifest may become outdated. For example, one
@@ -30,7 +33,19 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(t
     if (!state.last_compacted_keys) {
         generate_last_compacted_keys(state, manifest);
     }
-    auto candidate = manifest.get_compaction_candidates(*state.last_compacted_keys, state.compaction_counter);
+    // The sstables of the ongoing compactions aren't candidates, so a job disjoint from all of
+    // them sees every sstable it overlaps with in its levels, and can run along with them.
+    auto ongoing_ranges = control.ongoing_compaction_ranges(table_s);
+    auto disjoint_from_ongoing = [&ongoing_ranges] (const dht::token_range& range) {
+        return std::none_of(ongoing_ranges.begin(), ongoing_ranges.end(), [&range] (const dht::token_range& r) {
+            return r.overlaps(range, dht::token_comparator());
+        });
+    };
+    auto can_run = [&] (const compaction_descriptor& descriptor) {
+        return disjoint_from_ongoing(descriptor.token_range());
+    };
+    auto candidate = manifest.get_compaction_candidates(*state.last_compacted_keys, state.compaction_counter,
+            ongoing_ranges.empty() ? std::function<bool(const compaction_descriptor&)>() : can_run);
 
     if (!candidate.sstables.empty()) {
         leveled_manifest::logger.debug("leveled: Compacting {} out of {} sstables", candidate.sstables.size(), table_s.main_sstable_set().all()->size());
@@ -49,8 +64,9 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(t
     for (auto level = int(manifest.get_level_count()); level >= 0; level--) {
         auto& sstables = manifest.get_level(level);
         // filter out sstables which droppable tombstone ratio isn't greater than the defined threshold.
-        auto e = boost::range::remove_if(sstables, [this, compaction_time, &table_s] (const sstables::shared_sstable& sst) -> bool {
-            return !worth_dropping_tombstones(sst, compaction_time, table_s.get_tombstone_gc_state());
+        auto e = boost::range::remove_if(sstables, [&, this] (const sstables::shared_sstable& sst) -> bool {
+            return !worth_dropping_tombstones(sst, compaction_time, table_s.get_tombstone_gc_state())
+                || !disjoint_from_ongoing(dht::token_range::make(sst->get_first_decorated_key().token(), sst->get_last_decorated_key().token()));
         });
         sstables.erase(e, sstables.end());
         if (sstables.empty()) {
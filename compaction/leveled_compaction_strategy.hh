@@ -66,6 +66,11 @@ class leveled_compaction_strategy : public compaction_strategy_impl {
         return false;
     }
 
+    // Jobs on disjoint token ranges write disjoint sstables, so they keep the levels non-overlapping.
+    virtual bool disjoint_parallel_compaction() const override {
+        return true;
+    }
+
     virtual compaction_strategy_type type() const override {
         return compaction_strategy_type::leveled;
     }
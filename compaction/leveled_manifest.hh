@@ -158,9 +158,24 @@ class leveled_manifest {
     /**
      * @return highest-priority sstables to compact, and level to compact them to
      * If no compactions are necessary, will return null
+     *
+     * can_run, if set, rejects the jobs that can't run along with the ongoing compactions of the table,
+     * and the search goes on with the next candidate. Size-tiered jobs of L0 aren't checked.
      */
     sstables::compaction_descriptor get_compaction_candidates(const std::vector<std::optional<dht::decorated_key>>& last_compacted_keys,
-        const std::vector<int>& compaction_counter) {
+        const std::vector<int>& compaction_counter,
+        const std::function<bool(const sstables::compaction_descriptor&)>& can_run = {}) {
+        bool rejected = false;
+        auto runnable = [&] (const sstables::compaction_descriptor& descriptor) {
+            if (descriptor.sstables.empty()) {
+                return false;
+            }
+            if (can_run && !can_run(descriptor)) {
+                rejected = true;
+                return false;
+            }
+            return true;
+        };
         // LevelDB gives each level a score of how much data it contains vs its ideal amount, and
         // compacts the level with the highest score. But this falls apart spectacularly once you
         // get behind.  Consider this set of levels:
@@ -216,7 +231,7 @@ class leveled_manifest {
                 }
             }
             auto descriptor = get_descriptor_for_level(i, last_compacted_keys, compaction_counter);
-            if (!descriptor.sstables.empty()) {
+            if (runnable(descriptor)) {
                 return descriptor;
             }
         }
@@ -226,7 +241,10 @@ class leveled_manifest {
             auto info = get_candidates_for(0, last_compacted_keys);
             if (!info.candidates.empty()) {
                 auto next_level = get_next_level(info.candidates, info.can_promote);
-                return sstables::compaction_descriptor(std::move(info.candidates), next_level, _max_sstable_size_in_bytes);
+                auto descriptor = sstables::compaction_descriptor(std::move(info.candidates), next_level, _max_sstable_size_in_bytes);
+                if (runnable(descriptor)) {
+                    return descriptor;
+                }
             }
         }
 
@@ -246,10 +264,21 @@ class leveled_manifest {
             }
 
             auto descriptor = get_descriptor_for_level(i-1, last_compacted_keys, compaction_counter);
-            if (!descriptor.sstables.empty()) {
+            if (runnable(descriptor)) {
                 return descriptor;
             }
         }
+
+        // The jobs due overlap the ongoing compactions. Size-tier L0 meanwhile, its output
+        // stays in L0, so that reads don't suffer from L0 piling up until they are done.
+        if (rejected) {
+            auto most_interesting = sstables::size_tiered_compaction_strategy::most_interesting_bucket(get_level(0),
+                _table_s.min_compaction_threshold(), _schema->max_compaction_threshold(), _stcs_options);
+            if (!most_interesting.empty()) {
+                logger.debug("Leveled jobs overlap ongoing compactions, performing size-tiering in L0");
+                return sstables::compaction_descriptor(std::move(most_interesting));
+            }
+        }
         return sstables::compaction_descriptor();
     }
 private:
@@ -8,6 +8,7 @@
 
 #include "sstables/sstables.hh"
 #include "size_tiered_compaction_strategy.hh"
+#include "exceptions/exceptions.hh"
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/adaptors.hpp>
@@ -29,6 +30,13 @@ size_tiered_compaction_strategy_options::size_tiered_compaction_strategy_options
 
     tmp_value = compaction_strategy_impl::get_value(options, COLD_READS_TO_OMIT_KEY);
     cold_reads_to_omit = property_definitions::to_double(COLD_READS_TO_OMIT_KEY, tmp_value, DEFAULT_COLD_READS_TO_OMIT);
+
+    tmp_value = compaction_strategy_impl::get_value(options, FRAGMENT_SIZE_IN_MB_KEY);
+    auto fragment_size = property_definitions::to_long(FRAGMENT_SIZE_IN_MB_KEY, tmp_value, DEFAULT_FRAGMENT_SIZE_IN_MB);
+    if (fragment_size < 0) {
+        throw exceptions::configuration_exception(fmt::format("{} must be non negative: {}", FRAGMENT_SIZE_IN_MB_KEY, fragment_size));
+    }
+    fragment_size_in_mb = fragment_size;
 }
 
 size_tiered_compaction_strategy_options::size_tiered_compaction_strategy_options() {
@@ -36,28 +44,54 @@ size_tiered_compaction_strategy_options::size_tiered_compaction_strategy_options
     bucket_low = DEFAULT_BUCKET_LOW;
     bucket_high = DEFAULT_BUCKET_HIGH;
     cold_reads_to_omit = DEFAULT_COLD_READS_TO_OMIT;
+    fragment_size_in_mb = DEFAULT_FRAGMENT_SIZE_IN_MB;
 }
 
-std::vector<std::pair<sstables::shared_sstable, uint64_t>>
-size_tiered_compaction_strategy::create_sstable_and_length_pairs(const std::vector<sstables::shared_sstable>& sstables) {
+std::vector<std::pair<std::vector<sstables::shared_sstable>, uint64_t>>
+size_tiered_compaction_strategy::create_run_and_length_pairs(const std::vector<sstables::shared_sstable>& sstables) {
 
-    std::vector<std::pair<sstables::shared_sstable, uint64_t>> sstable_length_pairs;
-    sstable_length_pairs.reserve(sstables.size());
+    std::vector<std::pair<std::vector<sstables::shared_sstable>, uint64_t>> run_length_pairs;
+    run_length_pairs.reserve(sstables.size());
+    std::unordered_map<run_id, size_t> run_index;
 
     for(auto& sstable : sstables) {
         auto sstable_size = sstable->data_size();
         assert(sstable_size != 0);
 
-        sstable_length_pairs.emplace_back(sstable, sstable_size);
+        // SSTables without a run identifier (e.g. synthetic ones built by tests)
+        // are runs of their own.
+        auto [it, inserted] = sstable->run_identifier()
+                ? run_index.emplace(sstable->run_identifier(), run_length_pairs.size())
+                : std::make_pair(run_index.end(), true);
+        if (inserted) {
+            run_length_pairs.emplace_back(std::vector<sstables::shared_sstable>{sstable}, sstable_size);
+        } else {
+            auto& run = run_length_pairs[it->second];
+            run.first.push_back(sstable);
+            run.second += sstable_size;
+        }
     }
 
-    return sstable_length_pairs;
+    return run_length_pairs;
+}
+
+static bool same_run(const sstables::shared_sstable& a, const sstables::shared_sstable& b) {
+    return a->run_identifier() && a->run_identifier() == b->run_identifier();
+}
+
+size_t size_tiered_compaction_strategy::run_count(const std::vector<sstables::shared_sstable>& bucket) {
+    // Fragments of a run are adjacent in buckets.
+    size_t n = 0;
+    for (auto it = bucket.begin(); it != bucket.end(); ++it) {
+        n += it == bucket.begin() || !same_run(*it, *std::prev(it));
+    }
+    return n;
 }
 
 std::vector<std::vector<sstables::shared_sstable>>
 size_tiered_compaction_strategy::get_buckets(const std::vector<sstables::shared_sstable>& sstables, size_tiered_compaction_strategy_options options) {
-    // sstables sorted by size of its data file.
-    auto sorted_sstables = create_sstable_and_length_pairs(sstables);
+    // runs sorted by size of their data files.
+    auto sorted_sstables = create_run_and_length_pairs(sstables);
 
     std::sort(sorted_sstables.begin(), sorted_sstables.end(), [] (auto& i, auto& j) {
         return i.second < j.second;
@@ -66,6 +100,9 @@ size_tiered_compaction_strategy::get_buckets(const std::vector<sstables::shared_
     using bucket_type = std::vector<sstables::shared_sstable>;
     std::vector<bucket_type> bucket_list;
     std::vector<double> bucket_average_size_list;
+    // Number of runs in each bucket, and the size of the smallest one.
+    std::vector<size_t> bucket_run_count_list;
+    std::vector<uint64_t> bucket_smallest_run_list;
 
     for (auto& pair : sorted_sstables) {
         size_t size = pair.second;
@@ -79,26 +116,29 @@ size_tiered_compaction_strategy::get_buckets(const std::vector<sstables::shared_
             if ((size > (bucket_average_size * options.bucket_low) && size < (bucket_average_size * options.bucket_high)) ||
                     (size < options.min_sstable_size && bucket_average_size < options.min_sstable_size)) {
                 auto& bucket = bucket_list.back();
-                auto total_size = bucket.size() * bucket_average_size;
-                auto new_average_size = (total_size + size) / (bucket.size() + 1);
-                auto smallest_sstable_in_bucket = bucket[0]->data_size();
+                auto& bucket_runs = bucket_run_count_list.back();
+                auto total_size = bucket_runs * bucket_average_size;
+                auto new_average_size = (total_size + size) / (bucket_runs + 1);
+                auto smallest_sstable_in_bucket = bucket_smallest_run_list.back();
 
                 // SSTables are added in increasing size order so the bucket's
                 // average might drift upwards.
                 // Don't let it drift too high, to a point where the smallest
                 // SSTable might fall out of range.
                 if (size < options.min_sstable_size || smallest_sstable_in_bucket > new_average_size * options.bucket_low) {
-                    bucket.push_back(pair.first);
+                    std::move(pair.first.begin(), pair.first.end(), std::back_inserter(bucket));
                     bucket_average_size = new_average_size;
+                    ++bucket_runs;
                     continue;
                 }
             }
         }
 
         // no similar bucket found; put it in a new one
-        bucket_type new_bucket = {pair.first};
-        bucket_list.push_back(std::move(new_bucket));
+        bucket_list.push_back(std::move(pair.first));
         bucket_average_size_list.push_back(size);
+        bucket_run_count_list.push_back(1);
+        bucket_smallest_run_list.push_back(size);
     }
 
     return bucket_list;
@@ -126,7 +166,17 @@ size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector
         if (!is_bucket_interesting(bucket, min_threshold)) {
             continue;
         }
-        bucket.resize(std::min(bucket.size(), size_t(max_threshold)));
+        // Trim to max_threshold runs, keeping whole runs.
+        size_t runs = 0;
+        auto end = bucket.begin();
+        for (; end != bucket.end(); ++end) {
+            if (end == bucket.begin() || !same_run(*end, *std::prev(end))) {
+                if (++runs > size_t(max_threshold)) {
+                    break;
+                }
+            }
+        }
+        bucket.erase(end, bucket.end());
         pruned_buckets.push_back(std::move(bucket));
     }
 
@@ -137,7 +187,7 @@ size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector
     // Pick the bucket with more elements, as efficiency of same-tier compactions increases with number of files.
     auto& max = *std::max_element(pruned_buckets.begin(), pruned_buckets.end(), [] (const bucket_t& i, const bucket_t& j) {
         // FIXME: ignoring hotness by the time being.
-        return i.size() < j.size();
+        return run_count(i) < run_count(j);
     });
     return std::move(max);
 }
@@ -151,17 +201,21 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(table_state& table_
 
     // TODO: Add support to filter cold sstables (for reference: SizeTieredCompactionStrategy::filterColdSSTables).
 
+    if (auto expired = get_fully_expired_sstables_job(table_s, candidates, compaction_time); !expired.sstables.empty()) {
+        return expired;
+    }
+
     auto buckets = get_buckets(candidates);
 
     if (is_any_bucket_interesting(buckets, min_threshold)) {
         std::vector<sstables::shared_sstable> most_interesting = most_interesting_bucket(std::move(buckets), min_threshold, max_threshold);
-        return sstables::compaction_descriptor(std::move(most_interesting));
+        return sstables::compaction_descriptor(std::move(most_interesting), compaction_descriptor::default_level, max_sstable_bytes());
     }
 
     // If we are not enforcing min_threshold explicitly, try any pair of SStables in the same tier.
     if (!table_s.compaction_enforce_min_threshold() && is_any_bucket_interesting(buckets, 2)) {
         std::vector<sstables::shared_sstable> most_interesting = most_interesting_bucket(std::move(buckets), 2, max_threshold);
-        return sstables::compaction_descriptor(std::move(most_interesting));
+        return sstables::compaction_descriptor(std::move(most_interesting), compaction_descriptor::default_level, max_sstable_bytes());
     }
 
     if (!table_s.tombstone_gc_enabled()) {
@@ -185,7 +239,7 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(table_state& table_
         auto it = std::min_element(sstables.begin(), sstables.end(), [] (auto& i, auto& j) {
             return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
         });
-        return sstables::compaction_descriptor({ *it });
+        return make_tombstone_compaction_job(table_s, *it, candidates, compaction_time, max_threshold);
     }
     return sstables::compaction_descriptor();
 }
@@ -194,8 +248,9 @@ int64_t size_tiered_compaction_strategy::estimated_pending_compactions(const std
         int min_threshold, int max_threshold, size_tiered_compaction_strategy_options options) {
     int64_t n = 0;
     for (auto& bucket : get_buckets(sstables, options)) {
-        if (bucket.size() >= size_t(min_threshold)) {
-            n += std::ceil(double(bucket.size()) / max_threshold);
+        auto runs = run_count(bucket);
+        if (runs >= size_t(min_threshold)) {
+            n += std::ceil(double(runs) / max_threshold);
         }
     }
     return n;
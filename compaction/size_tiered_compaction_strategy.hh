@@ -22,15 +22,23 @@ class size_tiered_compaction_strategy_options {
     static constexpr double DEFAULT_BUCKET_LOW = 0.5;
     static constexpr double DEFAULT_BUCKET_HIGH = 1.5;
     static constexpr double DEFAULT_COLD_READS_TO_OMIT = 0.05;
+    static constexpr uint64_t DEFAULT_FRAGMENT_SIZE_IN_MB = 0;
     const sstring MIN_SSTABLE_SIZE_KEY = "min_sstable_size";
     const sstring BUCKET_LOW_KEY = "bucket_low";
     const sstring BUCKET_HIGH_KEY = "bucket_high";
     const sstring COLD_READS_TO_OMIT_KEY = "cold_reads_to_omit";
+    const sstring FRAGMENT_SIZE_IN_MB_KEY = "fragment_size_in_mb";
 
     uint64_t min_sstable_size = DEFAULT_MIN_SSTABLE_SIZE;
     double bucket_low = DEFAULT_BUCKET_LOW;
     double bucket_high = DEFAULT_BUCKET_HIGH;
     double cold_reads_to_omit =  DEFAULT_COLD_READS_TO_OMIT;
+    // When non-zero, compactions write sstable runs made of fragments of
+    // about this size instead of a single sstable. Fragments of the input
+    // runs are then released as soon as the output moves past them, which
+    // bounds the temporary space needed by a compaction to a few fragments
+    // instead of the size of the whole tier.
+    uint64_t fragment_size_in_mb = DEFAULT_FRAGMENT_SIZE_IN_MB;
 public:
     size_tiered_compaction_strategy_options(const std::map<sstring, sstring>& options);
 
@@ -83,10 +91,17 @@ class size_tiered_compaction_strategy_options {
 class size_tiered_compaction_strategy : public compaction_strategy_impl {
     size_tiered_compaction_strategy_options _options;
 
-    // Return a list of pair of shared_sstable and its respective size.
-    static std::vector<std::pair<sstables::shared_sstable, uint64_t>> create_sstable_and_length_pairs(const std::vector<sstables::shared_sstable>& sstables);
+    // Return a list of pair of sstable run and its respective size.
+    // The fragments of a run are sized and bucketed as a whole, since a
+    // run is the unit of tiering: a run of N fragments of size S belongs
+    // to the same tier as an sstable of size N*S.
+    static std::vector<std::pair<std::vector<sstables::shared_sstable>, uint64_t>> create_run_and_length_pairs(const std::vector<sstables::shared_sstable>& sstables);
 
-    // Group files of similar size into buckets.
+    // Returns the number of distinct sstable runs in the bucket.
+    static size_t run_count(const std::vector<sstables::shared_sstable>& bucket);
+
+    // Group runs of similar size into buckets. The fragments of a run are
+    // adjacent in the bucket.
     static std::vector<std::vector<sstables::shared_sstable>> get_buckets(const std::vector<sstables::shared_sstable>& sstables, size_tiered_compaction_strategy_options options);
 
     std::vector<std::vector<sstables::shared_sstable>> get_buckets(const std::vector<sstables::shared_sstable>& sstables) const;
@@ -96,7 +111,7 @@ class size_tiered_compaction_strategy : public compaction_strategy_impl {
     most_interesting_bucket(std::vector<std::vector<sstables::shared_sstable>> buckets, unsigned min_threshold, unsigned max_threshold);
 
     static bool is_bucket_interesting(const std::vector<sstables::shared_sstable>& bucket, int min_threshold) {
-        return bucket.size() >= size_t(min_threshold);
+        return run_count(bucket) >= size_t(min_threshold);
     }
 
     bool is_any_bucket_interesting(const std::vector<std::vector<sstables::shared_sstable>>& buckets, int min_threshold) const {
@@ -104,6 +119,10 @@ class size_tiered_compaction_strategy : public compaction_strategy_impl {
             return this->is_bucket_interesting(bucket, min_threshold);
         });
     }
+
+    uint64_t max_sstable_bytes() const noexcept {
+        return _options.fragment_size_in_mb ? _options.fragment_size_in_mb * 1024 * 1024 : compaction_descriptor::default_max_sstable_bytes;
+    }
 public:
     size_tiered_compaction_strategy() = default;
 
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "compaction/compaction_fwd.hh"
+#include "dht/i_partitioner_fwd.hh"
 
 namespace compaction {
 
@@ -18,6 +19,9 @@ class strategy_control {
 public:
     virtual ~strategy_control() {}
     virtual bool has_ongoing_compaction(table_state& table_s) const noexcept = 0;
+    // Token ranges of the compactions ongoing for the table. A compaction whose range
+    // isn't known is reported as spanning the whole ring.
+    virtual std::vector<dht::token_range> ongoing_compaction_ranges(table_state& table_s) const = 0;
 };
 
 }
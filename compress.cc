@@ -60,6 +60,18 @@ std::map<sstring, sstring> compressor::options() const {
     return {};
 }
 
+bool compressor::supports_dictionary() const {
+    return false;
+}
+
+std::optional<sstring> compressor::train_dictionary(const std::vector<sstring>&) const {
+    return std::nullopt;
+}
+
+compressor::ptr_type compressor::with_dictionary(sstring) const {
+    return {};
+}
+
 compressor::ptr_type compressor::create(const sstring& name, const opt_getter& opts) {
     if (name.empty()) {
         return {};
@@ -9,7 +9,9 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <set>
+#include <vector>
 
 #include <seastar/core/future.hh>
 #include <seastar/core/shared_ptr.hh>
@@ -63,6 +65,29 @@ class compressor {
     using opt_getter = std::function<opt_string(const sstring&)>;
     using ptr_type = shared_ptr<compressor>;
 
+    /**
+     * Whether this compressor can use a dictionary trained with train_dictionary().
+     */
+    virtual bool supports_dictionary() const;
+    /**
+     * Trains a dictionary for this compressor from the given samples of
+     * uncompressed data, or returns std::nullopt if dictionaries are not
+     * supported or training failed.
+     *
+     * Training is slow, and doesn't touch any shard-local state, so it
+     * may be run outside of the reactor thread.
+     */
+    virtual std::optional<sstring> train_dictionary(const std::vector<sstring>& samples) const;
+    /**
+     * Returns a compressor with the same options as this one, using a
+     * dictionary returned by train_dictionary().
+     *
+     * The dictionary is part of options(), so data compressed with the
+     * returned compressor can be decompressed by a compressor created
+     * from these options.
+     */
+    virtual ptr_type with_dictionary(sstring dictionary) const;
+
     static ptr_type create(const sstring& name, const opt_getter&);
     static ptr_type create(const std::map<sstring, sstring>&);
 
@@ -100,6 +125,7 @@ class compression_parameters {
 
     compressor_ptr get_compressor() const { return _compressor; }
     int32_t chunk_length() const { return _chunk_length.value_or(int(DEFAULT_CHUNK_LENGTH)); }
+    bool has_chunk_length() const { return bool(_chunk_length); }
     double crc_check_chance() const { return _crc_check_chance.value_or(double(DEFAULT_CRC_CHECK_CHANCE)); }
 
     void validate();
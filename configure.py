@@ -408,6 +408,7 @@ scylla_tests = set([
     'test/boost/clustering_ranges_walker_test',
     'test/boost/column_mapping_test',
     'test/boost/commitlog_test',
+    'test/boost/comparable_bytes_test',
     'test/boost/compound_test',
     'test/boost/compress_test',
     'test/boost/config_test',
@@ -435,6 +436,7 @@ scylla_tests = set([
     'test/boost/flat_mutation_reader_test',
     'test/boost/flush_queue_test',
     'test/boost/fragmented_temporary_buffer_test',
+    'test/boost/frequency_sketch_test',
     'test/boost/frozen_mutation_test',
     'test/boost/gossiping_property_file_snitch_test',
     'test/boost/hash_test',
@@ -452,6 +454,7 @@ scylla_tests = set([
     'test/boost/linearizing_input_stream_test',
     'test/boost/loading_cache_test',
     'test/boost/log_heap_test',
+    'test/boost/lz4_stream_test',
     'test/boost/estimated_histogram_test',
     'test/boost/summary_test',
     'test/boost/logalloc_test',
@@ -483,6 +486,7 @@ scylla_tests = set([
     'test/boost/reusable_buffer_test',
     'test/boost/restrictions_test',
     'test/boost/repair_test',
+    'test/boost/replica_load_tracker_test',
     'test/boost/role_manager_test',
     'test/boost/row_cache_test',
     'test/boost/rust_test',
@@ -561,6 +565,8 @@ scylla_tests = set([
     'test/manual/sstable_scan_footprint_test',
     'test/perf/memory_footprint_test',
     'test/perf/perf_cache_eviction',
+    'test/perf/perf_multishard_scan',
+    'test/perf/perf_lwt',
     'test/perf/perf_commitlog',
     'test/perf/perf_cql_parser',
     'test/perf/perf_hash',
@@ -569,6 +575,9 @@ scylla_tests = set([
     'test/perf/perf_row_cache_reads',
     'test/perf/logalloc',
     'test/perf/perf_s3_client',
+    'test/perf/perf_sstable_set',
+    'test/perf/perf_compaction',
+    'test/perf/perf_read_matrix',
     'test/unit/lsa_async_eviction_test',
     'test/unit/lsa_sync_eviction_test',
     'test/unit/row_cache_alloc_stress_test',
@@ -584,11 +593,14 @@ scylla_tests = set([
 
 perf_tests = set([
     'test/perf/perf_mutation_readers',
+    'test/perf/perf_bloom_filter',
     'test/perf/perf_checksum',
     'test/perf/perf_mutation_fragment',
     'test/perf/perf_idl',
     'test/perf/perf_vint',
+    'test/perf/perf_utf8',
     'test/perf/perf_big_decimal',
+    'test/perf/perf_alternator_serialization',
 ])
 
 raft_tests = set([
@@ -762,6 +774,8 @@ scylla_core = (['message/messaging_service.cc',
                 'gms/generation-number.cc',
                 'utils/rjson.cc',
                 'utils/human_readable.cc',
+                'utils/cpu_profile.cc',
+                'utils/alien_worker.cc',
                 'utils/histogram_metrics_helper.cc',
                 'utils/pretty_printers.cc',
                 'converting_mutation_partition_applier.cc',
@@ -772,6 +786,7 @@ scylla_core = (['message/messaging_service.cc',
                 'mutation_query.cc',
                 'keys.cc',
                 'counters.cc',
+                'counter_cache.cc',
                 'compress.cc',
                 'zstd.cc',
                 'sstables/sstables.cc',
@@ -784,6 +799,7 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/kl/reader.cc',
                 'sstables/sstable_version.cc',
                 'sstables/compress.cc',
+                'sstables/chunk_cache.cc',
                 'sstables/sstable_mutation_reader.cc',
                 'compaction/compaction.cc',
                 'compaction/compaction_strategy.cc',
@@ -802,6 +818,7 @@ scylla_core = (['message/messaging_service.cc',
                 'transport/cql_protocol_extension.cc',
                 'transport/event.cc',
                 'transport/event_notifier.cc',
+                'transport/lz4_stream.cc',
                 'transport/server.cc',
                 'transport/controller.cc',
                 'transport/messages/result_message.cc',
@@ -821,6 +838,7 @@ scylla_core = (['message/messaging_service.cc',
                 'cql3/sets.cc',
                 'cql3/maps.cc',
                 'cql3/values.cc',
+                'cql3/expr/compiled_predicate.cc',
                 'cql3/expr/expression.cc',
                 'cql3/expr/restrictions.cc',
                 'cql3/expr/prepare_expr.cc',
@@ -899,10 +917,12 @@ scylla_core = (['message/messaging_service.cc',
                 'utils/uuid.cc',
                 'utils/big_decimal.cc',
                 'types/types.cc',
+                'types/comparable_bytes.cc',
                 'validation.cc',
                 'service/migration_manager.cc',
                 'service/tablet_allocator.cc',
                 'service/storage_proxy.cc',
+                'service/replica_load_tracker.cc',
                 'query_ranges_to_vnodes.cc',
                 'service/forward_service.cc',
                 'service/paxos/proposal.cc',
@@ -913,6 +933,7 @@ scylla_core = (['message/messaging_service.cc',
                 'cql3/column_specification.cc',
                 'cql3/constants.cc',
                 'cql3/query_processor.cc',
+                'cql3/query_results_cache.cc',
                 'cql3/query_options.cc',
                 'cql3/user_types.cc',
                 'cql3/untyped_result_set.cc',
@@ -934,6 +955,7 @@ scylla_core = (['message/messaging_service.cc',
                 'db/commitlog/commitlog_replayer.cc',
                 'db/commitlog/commitlog_entry.cc',
                 'db/data_listeners.cc',
+                'db/cache_warmer.cc',
                 'db/functions/function.cc',
                 'db/hints/manager.cc',
                 'db/hints/resource_manager.cc',
@@ -969,6 +991,7 @@ scylla_core = (['message/messaging_service.cc',
                 'utils/gz/crc_combine.cc',
                 'utils/gz/crc_combine_table.cc',
                 'utils/s3/client.cc',
+                'utils/s3/block_cache.cc',
                 'gms/version_generator.cc',
                 'gms/versioned_value.cc',
                 'gms/gossiper.cc',
@@ -1031,6 +1054,7 @@ scylla_core = (['message/messaging_service.cc',
                 'partition_slice_builder.cc',
                 'init.cc',
                 'utils/lister.cc',
+                'repair/hash_sketch.cc',
                 'repair/repair.cc',
                 'repair/row_level.cc',
                 'exceptions/exceptions.cc',
@@ -1284,6 +1308,7 @@ pure_boost_tests = set([
     'test/boost/keys_test',
     'test/boost/like_matcher_test',
     'test/boost/linearizing_input_stream_test',
+    'test/boost/lz4_stream_test',
     'test/boost/map_difference_test',
     'test/boost/nonwrapping_range_test',
     'test/boost/observable_test',
@@ -1292,6 +1317,7 @@ pure_boost_tests = set([
     'test/boost/serialization_test',
     'test/boost/small_vector_test',
     'test/boost/top_k_test',
+    'test/boost/frequency_sketch_test',
     'test/boost/vint_serialization_test',
     'test/boost/bptree_test',
     'test/boost/utf8_test',
@@ -1306,10 +1332,15 @@ tests_not_using_seastar_test_framework = set([
     'test/manual/message',
     'test/perf/memory_footprint_test',
     'test/perf/perf_cache_eviction',
+    'test/perf/perf_multishard_scan',
+    'test/perf/perf_lwt',
     'test/perf/perf_cql_parser',
     'test/perf/perf_hash',
     'test/perf/perf_mutation',
     'test/perf/perf_collection',
+    'test/perf/perf_sstable_set',
+    'test/perf/perf_compaction',
+    'test/perf/perf_read_matrix',
     'test/perf/logalloc',
     'test/unit/lsa_async_eviction_test',
     'test/unit/lsa_sync_eviction_test',
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <cassert>
+
+#include "counter_cache.hh"
+#include "mutation/frozen_mutation.hh"
+#include "mutation/mutation.hh"
+
+struct counter_cache_tracker::partition_entry
+        : public boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
+    struct cell {
+        // Disengaged for static cells.
+        std::optional<clustering_key> ck;
+        column_id id;
+        int64_t value;
+        int64_t logical_clock;
+    };
+    counter_cache& cache;
+    partition_key key;
+    utils::small_vector<cell, 4> cells;
+    size_t memory = 0;
+
+    partition_entry(counter_cache& c, partition_key k) : cache(c), key(std::move(k)) { }
+
+    cell* find(const clustering_key* ck, column_id id, const clustering_key::equality& eq) noexcept {
+        for (auto& c : cells) {
+            if (c.id == id && bool(c.ck) == bool(ck) && (!ck || eq(*c.ck, *ck))) {
+                return &c;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t memory_usage() const noexcept {
+        // Including the node of counter_cache::_partitions.
+        size_t ret = sizeof(partition_entry) + 4 * sizeof(void*) + key.external_memory_usage();
+        if (cells.size() > 4) {
+            ret += cells.capacity() * sizeof(cell);
+        }
+        for (auto& c : cells) {
+            if (c.ck) {
+                ret += c.ck->external_memory_usage();
+            }
+        }
+        return ret;
+    }
+};
+
+// The cells of a partition are looked up by a linear scan, which is fine for
+// the few cells counter updates usually touch, but not for wide partitions.
+static constexpr size_t max_cells_per_partition = 64;
+
+counter_cache_tracker::~counter_cache_tracker() {
+    assert(_lru.empty());
+}
+
+void counter_cache_tracker::insert(partition_entry& e) noexcept {
+    e.memory = e.memory_usage();
+    _memory_used += e.memory;
+    _lru.push_back(e);
+}
+
+void counter_cache_tracker::touch(partition_entry& e) noexcept {
+    auto memory = e.memory_usage();
+    _memory_used = _memory_used - e.memory + memory;
+    e.memory = memory;
+    e.unlink();
+    _lru.push_back(e);
+}
+
+void counter_cache_tracker::remove(partition_entry& e) noexcept {
+    _memory_used -= e.memory;
+    e.unlink();
+}
+
+void counter_cache_tracker::evict_to_fit() {
+    while (_memory_used > _max_memory && !_lru.empty()) {
+        auto& e = _lru.front();
+        ++_stats.evictions;
+        e.cache.erase(e);
+    }
+}
+
+template<typename Func>
+static void for_each_live_cell(const mutation& m, Func&& func) {
+    const schema& s = *m.schema();
+    m.partition().static_row().get().for_each_cell([&] (column_id id, const atomic_cell_or_collection& ac_o_c) {
+        auto& cdef = s.column_at(column_kind::static_column, id);
+        auto acv = ac_o_c.as_atomic_cell(cdef);
+        if (acv.is_live()) {
+            func(nullptr, cdef, acv);
+        }
+    });
+    for (auto& cr : m.partition().clustered_rows()) {
+        cr.row().cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection& ac_o_c) {
+            auto& cdef = s.column_at(column_kind::regular_column, id);
+            auto acv = ac_o_c.as_atomic_cell(cdef);
+            if (acv.is_live()) {
+                func(&cr.key(), cdef, acv);
+            }
+        });
+    }
+}
+
+// Whether applying m may change the local shards, i.e. whether it deletes
+// anything or carries local shards, coming from elsewhere.
+static bool may_change_local_shards(const mutation& m, counter_id local_id) {
+    const schema& s = *m.schema();
+    auto& mp = m.partition();
+    if (mp.partition_tombstone() || !mp.row_tombstones().empty()) {
+        return true;
+    }
+    bool ret = false;
+    auto check_row = [&] (column_kind kind, const row& cells) {
+        cells.for_each_cell([&] (column_id id, const atomic_cell_or_collection& ac_o_c) {
+            auto acv = ac_o_c.as_atomic_cell(s.column_at(kind, id));
+            ret = ret || !acv.is_live() || counter_cell_view(acv).get_shard(local_id);
+        });
+    };
+    check_row(column_kind::static_column, mp.static_row().get());
+    for (auto& cr : mp.clustered_rows()) {
+        if (cr.row().deleted_at()) {
+            return true;
+        }
+        check_row(column_kind::regular_column, cr.row().cells());
+    }
+    return ret;
+}
+
+counter_cache::counter_cache(schema_ptr s, counter_cache_tracker& tracker)
+    : _schema(std::move(s))
+    , _tracker(tracker)
+    , _partitions(0, partition_key::hashing(*_schema), partition_key::equality(*_schema))
+{ }
+
+counter_cache::~counter_cache() {
+    clear();
+}
+
+void counter_cache::erase(partition_entry& e) noexcept {
+    _tracker.remove(e);
+    _partitions.erase(_partitions.find(e.key));
+}
+
+std::optional<mutation> counter_cache::lookup(const mutation& m, counter_id local_id) {
+    if (!_tracker.enabled() || m.schema() != _schema) {
+        return std::nullopt;
+    }
+    auto it = _partitions.find(m.key());
+    if (it == _partitions.end() || m.partition().partition_tombstone() || !m.partition().row_tombstones().empty()) {
+        ++_tracker._stats.misses;
+        return std::nullopt;
+    }
+    auto& e = *it->second;
+    clustering_key::equality eq(*_schema);
+    mutation current(_schema, m.decorated_key());
+    bool all_cached = true;
+    for_each_live_cell(m, [&] (const clustering_key* ck, const column_definition& cdef, atomic_cell_view) {
+        auto c = all_cached ? e.find(ck, cdef.id, eq) : nullptr;
+        if (!c) {
+            all_cached = false;
+            return;
+        }
+        // transform_counter_updates_to_shards() only looks at the local shard of live cells.
+        auto cell = counter_cell_builder::from_single_shard(api::min_timestamp, counter_shard(local_id, c->value, c->logical_clock));
+        if (ck) {
+            current.set_clustered_cell(*ck, cdef, std::move(cell));
+        } else {
+            current.set_static_cell(cdef, std::move(cell));
+        }
+    });
+    if (!all_cached) {
+        ++_tracker._stats.misses;
+        return std::nullopt;
+    }
+    ++_tracker._stats.hits;
+    return current;
+}
+
+void counter_cache::update(const mutation& m, counter_id local_id, uint64_t generation) {
+    if (!_tracker.enabled() || generation != _generation || m.schema() != _schema) {
+        return;
+    }
+    auto [it, inserted] = _partitions.try_emplace(m.key(), nullptr);
+    if (inserted) {
+        it->second = std::make_unique<partition_entry>(*this, m.key());
+    }
+    auto& e = *it->second;
+    clustering_key::equality eq(*_schema);
+    for_each_live_cell(m, [&] (const clustering_key* ck, const column_definition& cdef, atomic_cell_view acv) {
+        auto shard = counter_cell_view(acv).get_shard(local_id);
+        if (!shard) {
+            return;
+        }
+        if (auto c = e.find(ck, cdef.id, eq)) {
+            c->value = shard->value();
+            c->logical_clock = shard->logical_clock();
+        } else if (e.cells.size() < max_cells_per_partition) {
+            e.cells.push_back({ck ? std::optional<clustering_key>(*ck) : std::nullopt, cdef.id, shard->value(), shard->logical_clock()});
+        }
+    });
+    if (inserted) {
+        _tracker.insert(e);
+    } else {
+        _tracker.touch(e);
+    }
+    _tracker.evict_to_fit();
+}
+
+void counter_cache::on_write(const frozen_mutation& fm, const schema_ptr& m_schema, counter_id local_id) {
+    if (_partitions.empty()) {
+        return;
+    }
+    auto it = _partitions.find(fm.key());
+    if (it == _partitions.end()) {
+        return;
+    }
+    if (may_change_local_shards(fm.unfreeze(m_schema), local_id)) {
+        ++_generation;
+        ++_tracker._stats.invalidations;
+        erase(*it->second);
+    }
+}
+
+void counter_cache::invalidate(const partition_key& key) noexcept {
+    ++_generation;
+    auto it = _partitions.find(key);
+    if (it != _partitions.end()) {
+        ++_tracker._stats.invalidations;
+        erase(*it->second);
+    }
+}
+
+void counter_cache::clear() noexcept {
+    ++_generation;
+    for (auto& [key, e] : _partitions) {
+        _tracker.remove(*e);
+    }
+    _partitions.clear();
+}
+
+void counter_cache::set_schema(schema_ptr s) noexcept {
+    clear();
+    _schema = std::move(s);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <boost/intrusive/list.hpp>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "counters.hh"
+#include "keys.hh"
+#include "schema/schema_fwd.hh"
+#include "utils/small_vector.hh"
+
+class mutation;
+class frozen_mutation;
+
+class counter_cache;
+
+/// Keeps the counter caches of all the tables of a shard within a memory
+/// budget, evicting their least recently updated partitions.
+class counter_cache_tracker {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t invalidations = 0;
+    };
+    struct partition_entry;
+private:
+    using lru_type = boost::intrusive::list<partition_entry,
+        boost::intrusive::base_hook<boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>>,
+        boost::intrusive::constant_time_size<false>>;
+    lru_type _lru;
+    size_t _max_memory;
+    size_t _memory_used = 0;
+    stats _stats;
+
+    friend class counter_cache;
+    void insert(partition_entry& e) noexcept;
+    void touch(partition_entry& e) noexcept;
+    void remove(partition_entry& e) noexcept;
+    void evict_to_fit();
+public:
+    explicit counter_cache_tracker(size_t max_memory) noexcept : _max_memory(max_memory) { }
+    ~counter_cache_tracker();
+    counter_cache_tracker(const counter_cache_tracker&) = delete;
+    counter_cache_tracker& operator=(const counter_cache_tracker&) = delete;
+
+    bool enabled() const noexcept { return _max_memory > 0; }
+    size_t memory_used() const noexcept { return _memory_used; }
+    const stats& get_stats() const noexcept { return _stats; }
+};
+
+/// Caches, for the partitions of a counter table recently updated with this
+/// node as the leader, the local shard (value and logical clock) of the
+/// updated cells, so that the next updates of those cells don't have to read
+/// them before writing, in the spirit of Cassandra's counter cache.
+///
+/// The cache is kept in sync with the local shards by updating it after each
+/// successfully applied counter update, and by invalidating the partitions
+/// which are written to by other means in a way that may change the local
+/// shards (deletions, writes carrying this node's shard).  Whole tables are
+/// invalidated on truncation, schema change and when sstables are added
+/// (e.g. by streaming or repair).
+///
+/// Updates still lock their cells (see cell_locking.hh), but a cache hit
+/// holds the locks only for the time the write takes, not a read as well,
+/// which is what makes hot counters contended.
+class counter_cache {
+public:
+    using partition_entry = counter_cache_tracker::partition_entry;
+private:
+    schema_ptr _schema;
+    counter_cache_tracker& _tracker;
+    std::unordered_map<partition_key, std::unique_ptr<partition_entry>, partition_key::hashing, partition_key::equality> _partitions;
+    // Incremented by invalidations, for update() not to store shards read
+    // or computed before the invalidation.
+    uint64_t _generation = 0;
+
+    friend class counter_cache_tracker;
+    void erase(partition_entry& e) noexcept;
+public:
+    counter_cache(schema_ptr s, counter_cache_tracker& tracker);
+    ~counter_cache();
+    counter_cache(const counter_cache&) = delete;
+    counter_cache& operator=(const counter_cache&) = delete;
+
+    uint64_t generation() const noexcept { return _generation; }
+
+    /// Returns the local shards of all the updated cells of the counter update
+    /// \p m, as a mutation usable as the current state by
+    /// transform_counter_updates_to_shards(), or std::nullopt if any of them
+    /// isn't cached.
+    std::optional<mutation> lookup(const mutation& m, counter_id local_id);
+
+    /// Stores the local shards of \p m, a counter update transformed to shards
+    /// and applied, unless invalidate() was called since \p generation.
+    void update(const mutation& m, counter_id local_id, uint64_t generation);
+
+    /// To be called for the writes not coming through counter updates
+    /// coordinated by this node, which may change the local shards.
+    void on_write(const frozen_mutation& fm, const schema_ptr& m_schema, counter_id local_id);
+
+    void invalidate(const partition_key& key) noexcept;
+    void clear() noexcept;
+    void set_schema(schema_ptr s) noexcept;
+};
@@ -0,0 +1,145 @@
+// Copyright (C) 2023-present ScyllaDB
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+#include "compiled_predicate.hh"
+
+#include "cql3/query_options.hh"
+#include "cql3/selection/selection.hh"
+
+namespace cql3::expr {
+
+namespace {
+
+bool is_supported_operator(oper_t op) {
+    switch (op) {
+    case oper_t::EQ:
+    case oper_t::NEQ:
+    case oper_t::LT:
+    case oper_t::LTE:
+    case oper_t::GT:
+    case oper_t::GTE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Whether the value can be evaluated before reading rows.
+bool is_row_independent(const expression& e) {
+    return is<constant>(e) || is<bind_variable>(e);
+}
+
+}
+
+std::optional<compiled_predicate> compiled_predicate::compile(const expression& restriction,
+        const selection::selection& selection, const query_options& options) {
+    std::vector<const expression*> children;
+    if (auto conj = as_if<conjunction>(&restriction)) {
+        for (auto& child : conj->children) {
+            children.push_back(&child);
+        }
+    } else {
+        children.push_back(&restriction);
+    }
+
+    compiled_predicate ret;
+    for (auto child : children) {
+        auto binop = as_if<binary_operator>(child);
+        if (!binop || !is_supported_operator(binop->op) || binop->order != comparison_order::cql
+                || binop->null_handling != null_handling_style::sql || !is_row_independent(binop->rhs)) {
+            return std::nullopt;
+        }
+        auto col = as_if<column_value>(&binop->lhs);
+        if (!col) {
+            return std::nullopt;
+        }
+        int32_t index = -1;
+        switch (col->col->kind) {
+        case column_kind::partition_key:
+        case column_kind::clustering_key:
+            break;
+        case column_kind::static_column:
+        case column_kind::regular_column:
+            index = selection.index_of(*col->col);
+            if (index == -1) {
+                // evaluate() reports the error.
+                return std::nullopt;
+            }
+            break;
+        default:
+            return std::nullopt;
+        }
+        managed_bytes_opt value;
+        try {
+            value = evaluate(binop->rhs, options).to_managed_bytes_opt();
+        } catch (...) {
+            // Let evaluate() fail on the first row instead, as it would have.
+            return std::nullopt;
+        }
+        if (!value) {
+            // A comparison with null is null, which doesn't satisfy the restriction.
+            ret._never = true;
+            continue;
+        }
+        ret._terms.push_back(term{
+            .col = col->col,
+            .index = index,
+            .type = col->col->type->without_reversed().shared_from_this(),
+            .op = binop->op,
+            .value = std::move(*value),
+        });
+    }
+    return ret;
+}
+
+bool compiled_predicate::is_satisfied_by(const evaluation_inputs& inputs) const {
+    if (_never) {
+        return false;
+    }
+    for (const term& t : _terms) {
+        managed_bytes_view value;
+        switch (t.col->kind) {
+        case column_kind::partition_key:
+            value = managed_bytes_view(bytes_view(inputs.partition_key[t.col->id]));
+            break;
+        case column_kind::clustering_key:
+            if (t.col->id >= inputs.clustering_key.size()) {
+                return false;
+            }
+            value = managed_bytes_view(bytes_view(inputs.clustering_key[t.col->id]));
+            break;
+        default: {
+            auto& v = inputs.static_and_regular_columns[t.index];
+            if (!v) {
+                return false;
+            }
+            value = managed_bytes_view(*v);
+            break;
+        }
+        }
+        bool satisfied;
+        switch (t.op) {
+        case oper_t::EQ:
+            satisfied = t.type->equal(value, managed_bytes_view(t.value));
+            break;
+        case oper_t::NEQ:
+            satisfied = !t.type->equal(value, managed_bytes_view(t.value));
+            break;
+        default: {
+            auto cmp = t.type->compare(value, managed_bytes_view(t.value));
+            switch (t.op) {
+            case oper_t::LT: satisfied = cmp < 0; break;
+            case oper_t::LTE: satisfied = cmp <= 0; break;
+            case oper_t::GT: satisfied = cmp > 0; break;
+            default: satisfied = cmp >= 0; break;
+            }
+        }
+        }
+        if (!satisfied) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
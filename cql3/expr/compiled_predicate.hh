@@ -0,0 +1,60 @@
+// Copyright (C) 2023-present ScyllaDB
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+#pragma once
+
+#include "expression.hh"
+#include "evaluate.hh"
+
+#include "types/types.hh"
+#include "utils/managed_bytes.hh"
+#include <optional>
+#include <vector>
+
+namespace cql3 {
+
+class query_options;
+
+namespace selection {
+class selection;
+}
+
+}
+
+namespace cql3::expr {
+
+// A restriction lowered, for a given selection and query options, to a flat
+// list of column comparisons checked without going through evaluate().
+//
+// Only conjunctions of comparisons (=, !=, <, <=, >, >=) between a column and
+// a value known before reading rows (a constant or a bind variable) with the
+// SQL null handling are supported.  The values are evaluated once, when
+// compiling, the columns are located in the evaluation inputs once too, and
+// a row is checked by comparing views of the column values, with no variant
+// dispatch and no allocation.
+//
+// is_satisfied_by() gives the same result as expr::is_satisfied_by() on the
+// restriction it was compiled from.
+class compiled_predicate {
+    struct term {
+        const column_definition* col;
+        // For static and regular columns, index in the selection.
+        int32_t index;
+        // The column's type, without reversal, for the slice operators.
+        data_type type;
+        oper_t op;
+        managed_bytes value;
+    };
+    std::vector<term> _terms;
+    // One of the values was null, so that no row can satisfy the predicate.
+    bool _never = false;
+public:
+    // Returns std::nullopt if the restriction's shape isn't supported, in
+    // which case it has to be evaluated with expr::is_satisfied_by().
+    static std::optional<compiled_predicate> compile(const expression& restriction,
+            const selection::selection& selection, const query_options& options);
+
+    bool is_satisfied_by(const evaluation_inputs& inputs) const;
+};
+
+}
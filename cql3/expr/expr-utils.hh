@@ -12,6 +12,10 @@
 #include "cql3/assignment_testable.hh"
 #include "cql3/statements/bound.hh"
 
+namespace db::functions {
+class aggregate_function;
+}
+
 namespace cql3 {
 
 struct prepare_context;
@@ -371,12 +375,15 @@ struct aggregation_split_result {
     std::vector<expression> inner_loop;
     std::vector<expression> outer_loop;
     std::vector<cql3::raw_value> initial_values_for_temporaries; // same size as inner_loop
+    std::vector<::shared_ptr<db::functions::aggregate_function>> aggregates; // same size as inner_loop
 };
 
 // Given a vector of aggergation expressions, split them into an inner loop that
 // calls the aggregating function on each input row, and an outer loop that calls
 // the final function on temporaries and generate the result.
 //
+// aggregates holds the aggregate each element of inner_loop was split from.
+//
 // inner_loop should be evaluated with for each input row in a group, and its
 // results stored in temporaries seeded from initial_values_for_temporaries
 //
@@ -2938,6 +2938,7 @@ split_aggregation(std::span<const expression> aggregation) {
     std::vector<expression> inner_vec;
     std::vector<expression> outer_vec;
     std::vector<raw_value> initial_values_vec;
+    std::vector<shared_ptr<cql3::functions::aggregate_function>> aggregates_vec;
     for (auto& e : aggregation) {
         auto outer = search_and_replace(e, [&] (const expression& e) -> std::optional<expression> {
             auto fc = as_if<function_call>(&e);
@@ -2984,6 +2985,7 @@ split_aggregation(std::span<const expression> aggregation) {
                     });
                     inner_vec.push_back(std::move(inner));
                     initial_values_vec.push_back(raw_value::make_value(agg.initial_state));
+                    aggregates_vec.push_back(std::move(agg_fn));
                     return outer;
                 }
             }, fc->func);
@@ -2995,6 +2997,7 @@ split_aggregation(std::span<const expression> aggregation) {
         .inner_loop = std::move(inner_vec),
         .outer_loop = std::move(outer_vec),
         .initial_values_for_temporaries = std::move(initial_values_vec),
+        .aggregates = std::move(aggregates_vec),
     };
 }
 
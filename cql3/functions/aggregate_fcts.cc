@@ -21,8 +21,13 @@
 #include "first_function.hh"
 #include "exceptions/exceptions.hh"
 #include "utils/multiprecision_int.hh"
+#include "utils/fragment_range.hh"
+#include <array>
+#include <bit>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <optional>
 #include <type_traits>
 
@@ -165,6 +170,281 @@ narrow(WideT acc) {
 template <typename T>
 using accumulator_for = std::conditional_t<std::is_integral_v<T>, utils::multiprecision_int, T>;
 
+template <typename T>
+T read_native(managed_bytes_view v) {
+    if constexpr (std::is_integral_v<T>) {
+        return read_simple_exactly<T>(v);
+    } else {
+        using int_type = std::conditional_t<sizeof(T) == sizeof(int32_t), int32_t, int64_t>;
+        return std::bit_cast<T>(read_simple_exactly<int_type>(v));
+    }
+}
+
+// Sums the non-null inputs of a fixed-size numeric type, and counts them.
+//
+// Inputs are decoded into a buffer and folded once it fills up. For integers
+// the buffer is summed into a wider integer, which can't overflow within a
+// buffer and which the compiler can vectorize, and only that partial sum is
+// added to the arbitrary precision accumulator. Floating point inputs are
+// summed in order, so that the result is the same as with the aggregation
+// function.
+template <typename Type>
+class summing_accumulator {
+    static constexpr size_t batch_size = 256;
+    std::array<Type, batch_size> _batch;
+    size_t _batched = 0;
+    accumulator_for<Type> _sum = accumulator_for<Type>(0);
+    int64_t _count = 0;
+public:
+    void add(std::optional<managed_bytes_view> input) {
+        if (!input) {
+            return;
+        }
+        _batch[_batched++] = read_native<Type>(*input);
+        if (_batched == batch_size) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if constexpr (std::is_integral_v<Type>) {
+            using partial_type = std::conditional_t<(sizeof(Type) < sizeof(int64_t)), int64_t, __int128>;
+            partial_type partial = 0;
+            for (size_t i = 0; i != _batched; ++i) {
+                partial += _batch[i];
+            }
+            if constexpr (std::is_same_v<partial_type, int64_t>) {
+                _sum += partial;
+            } else if (partial >= std::numeric_limits<int64_t>::min() && partial <= std::numeric_limits<int64_t>::max()) {
+                _sum += int64_t(partial);
+            } else {
+                auto wide = utils::multiprecision_int(int64_t(partial >> 64));
+                wide <<= 64;
+                wide += uint64_t(partial);
+                _sum += wide;
+            }
+        } else {
+            for (size_t i = 0; i != _batched; ++i) {
+                _sum += _batch[i];
+            }
+        }
+        _count += _batched;
+        _batched = 0;
+    }
+
+    const accumulator_for<Type>& sum() {
+        flush();
+        return _sum;
+    }
+
+    int64_t count() {
+        flush();
+        return _count;
+    }
+
+    void reset() {
+        _batched = 0;
+        _sum = accumulator_for<Type>(0);
+        _count = 0;
+    }
+};
+
+template <typename Type>
+class sum_accumulator final : public db::functions::batch_accumulator {
+    summing_accumulator<Type> _acc;
+public:
+    virtual void add(std::optional<managed_bytes_view> input) override {
+        _acc.add(input);
+    }
+    virtual bytes_opt state() override {
+        return data_type_for<accumulator_for<Type>>()->decompose(_acc.sum());
+    }
+    virtual void reset() override {
+        _acc.reset();
+    }
+};
+
+template <typename Type>
+class avg_accumulator final : public db::functions::batch_accumulator {
+    data_type _state_type;
+    summing_accumulator<Type> _acc;
+public:
+    explicit avg_accumulator(data_type state_type) : _state_type(std::move(state_type)) { }
+    virtual void add(std::optional<managed_bytes_view> input) override {
+        _acc.add(input);
+    }
+    virtual bytes_opt state() override {
+        return make_tuple_value(_state_type, std::vector({data_value(_acc.sum()), data_value(_acc.count())})).serialize();
+    }
+    virtual void reset() override {
+        _acc.reset();
+    }
+};
+
+template <typename Type>
+db::functions::batch_accumulator_factory
+make_sum_accumulator_factory() {
+    if constexpr (std::is_arithmetic_v<Type>) {
+        return [] { return std::make_unique<sum_accumulator<Type>>(); };
+    } else {
+        return nullptr;
+    }
+}
+
+template <typename Type>
+db::functions::batch_accumulator_factory
+make_avg_accumulator_factory(data_type state_type) {
+    if constexpr (std::is_arithmetic_v<Type>) {
+        return [state_type = std::move(state_type)] { return std::make_unique<avg_accumulator<Type>>(state_type); };
+    } else {
+        return nullptr;
+    }
+}
+
+class count_accumulator final : public db::functions::batch_accumulator {
+    int64_t _count = 0;
+public:
+    virtual void add(std::optional<managed_bytes_view> input) override {
+        _count += bool(input);
+    }
+    virtual bytes_opt state() override {
+        return data_value(_count).serialize();
+    }
+    virtual void reset() override {
+        _count = 0;
+    }
+};
+
+// Keeps the first of the greatest (or least) inputs, as max_step (min_step)
+// does, but copies an input only when it becomes the new extremum.
+template <bool Max>
+class extremum_accumulator final : public db::functions::batch_accumulator {
+    data_type _type;
+    managed_bytes_opt _extremum;
+public:
+    explicit extremum_accumulator(data_type type) : _type(std::move(type)) { }
+    virtual void add(std::optional<managed_bytes_view> input) override {
+        if (!input) {
+            return;
+        }
+        if (!_extremum) {
+            _extremum.emplace(*input);
+            return;
+        }
+        auto cmp = _type->compare(managed_bytes_view(*_extremum), *input);
+        if (Max ? cmp < 0 : cmp > 0) {
+            _extremum.emplace(*input);
+        }
+    }
+    virtual bytes_opt state() override {
+        return to_bytes_opt(_extremum);
+    }
+    virtual void reset() override {
+        _extremum = std::nullopt;
+    }
+};
+
+// Like extremum_accumulator, for the fixed-size types which compare as their
+// native values. Inputs are decoded into a buffer and the buffer is scanned
+// without calling abstract_type::compare() for every row.
+//
+// Empty values compare less than anything else, so they are only tracked with
+// a flag. Floating point values are compared by a key which orders them like
+// floating_type_impl does: NaN is the greatest and -0 is less than 0.
+template <bool Max, typename Type>
+class native_extremum_accumulator final : public db::functions::batch_accumulator {
+    static constexpr size_t batch_size = 256;
+    std::array<Type, batch_size> _batch;
+    size_t _batched = 0;
+    std::optional<Type> _extremum;
+    bool _has_empty = false;
+
+    static auto order_key(Type v) {
+        if constexpr (std::is_integral_v<Type>) {
+            return v;
+        } else {
+            using int_type = std::conditional_t<sizeof(Type) == sizeof(int32_t), int32_t, int64_t>;
+            if (std::isnan(v)) {
+                return std::numeric_limits<int_type>::max();
+            }
+            auto bits = std::bit_cast<int_type>(v);
+            return bits < 0 ? int_type(bits ^ std::numeric_limits<int_type>::max()) : bits;
+        }
+    }
+    static bool better(Type a, Type b) {
+        return Max ? order_key(a) > order_key(b) : order_key(a) < order_key(b);
+    }
+
+    void flush() {
+        if (!_batched) {
+            return;
+        }
+        Type best = _batch[0];
+        for (size_t i = 1; i != _batched; ++i) {
+            if (better(_batch[i], best)) {
+                best = _batch[i];
+            }
+        }
+        if (!_extremum || better(best, *_extremum)) {
+            _extremum = best;
+        }
+        _batched = 0;
+    }
+public:
+    virtual void add(std::optional<managed_bytes_view> input) override {
+        if (!input) {
+            return;
+        }
+        if (input->empty()) {
+            _has_empty = true;
+            return;
+        }
+        _batch[_batched++] = read_native<Type>(*input);
+        if (_batched == batch_size) {
+            flush();
+        }
+    }
+    virtual bytes_opt state() override {
+        flush();
+        if (_has_empty && (!Max || !_extremum)) {
+            return bytes();
+        }
+        if (!_extremum) {
+            return std::nullopt;
+        }
+        return data_value(*_extremum).serialize_nonnull();
+    }
+    virtual void reset() override {
+        _batched = 0;
+        _extremum = std::nullopt;
+        _has_empty = false;
+    }
+};
+
+template <bool Max>
+static
+db::functions::batch_accumulator_factory
+make_extremum_accumulator_factory(data_type type) {
+    auto native = [] <typename Type> () -> db::functions::batch_accumulator_factory {
+        return [] { return std::make_unique<native_extremum_accumulator<Max, Type>>(); };
+    };
+    if (type == byte_type) {
+        return native.template operator()<int8_t>();
+    } else if (type == short_type) {
+        return native.template operator()<int16_t>();
+    } else if (type == int32_type) {
+        return native.template operator()<int32_t>();
+    } else if (type == long_type || type == timestamp_type) {
+        // timestamps compare as signed milliseconds, and serialize as them
+        return native.template operator()<int64_t>();
+    } else if (type == float_type) {
+        return native.template operator()<float>();
+    } else if (type == double_type) {
+        return native.template operator()<double>();
+    }
+    return [type] { return std::make_unique<extremum_accumulator<Max>>(type); };
+}
+
 template <typename Type>
 static
 shared_ptr<aggregate_function>
@@ -180,6 +460,7 @@ make_sum_function() {
             .aggregation_function = make_internal_scalar_function("sum_step", return_accumulator_on_null, [] (Acc acc, Type addend) -> Acc { return acc + addend; }),
             .state_to_result_function = make_internal_scalar_function("sum_finalizer", return_any_nonnull, [] (Acc acc) -> Type { return narrow<Type>(acc); }),
             .state_reduction_function = make_internal_scalar_function("sum_reducer", return_any_nonnull, [] (Acc a1, Acc a2) -> Acc { return a1 + a2; }),
+            .make_batch_accumulator = make_sum_accumulator_factory<Type>(),
         }
     );
 }
@@ -263,6 +544,7 @@ make_avg_function() {
                         acc1[1] = data_value(count1 + count2);
                         return make_tuple_value(accumulator_tuple_type, acc1).serialize();
                     }),
+            .make_batch_accumulator = make_avg_accumulator_factory<Type>(accumulator_tuple_type),
         });
 }
 
@@ -322,6 +604,7 @@ aggregate_fcts::make_count_function(data_type input_type) {
                     }),
             .state_to_result_function = make_internal_scalar_function("count_finalizer", return_any_nonnull, [] (int64_t count) { return count; }),
             .state_reduction_function = make_internal_scalar_function("count_reducer", return_any_nonnull, [] (int64_t c1, int64_t c2) { return c1 + c2; }),
+            .make_batch_accumulator = [] { return std::make_unique<count_accumulator>(); },
         });
 }
 
@@ -404,6 +687,7 @@ aggregate_fcts::make_count_rows_function() {
             .state_reduction_function = make_internal_scalar_function("count_reducer", return_any_nonnull, [] (int64_t acc1, int64_t acc2) {
                 return acc1 + acc2;
             }),
+            .make_batch_accumulator = [] { return std::make_unique<count_accumulator>(); },
         }
     );
 }
@@ -432,6 +716,7 @@ aggregate_fcts::make_max_function(data_type io_type) {
                 return args[0];
             }),
             .state_reduction_function = max,
+            .make_batch_accumulator = make_extremum_accumulator_factory<true>(io_type),
         }
     );
 }
@@ -460,6 +745,7 @@ aggregate_fcts::make_min_function(data_type io_type) {
                 return args[0];
             }),
             .state_reduction_function = min,
+            .make_batch_accumulator = make_extremum_accumulator_factory<false>(io_type),
         }
     );
 }
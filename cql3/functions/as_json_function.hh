@@ -16,7 +16,7 @@
 #include "cql3/cql3_type.hh"
 #include "cql3/type_json.hh"
 
-#include "bytes_ostream.hh"
+#include <string>
 #include "types/types.hh"
 
 #include <boost/algorithm/cxx11/any_of.hpp>
@@ -47,27 +47,26 @@ class as_json_function : public scalar_function {
     virtual bool requires_thread() const override;
 
     virtual bytes_opt execute(std::span<const bytes_opt> parameters) override {
-        bytes_ostream encoded_row;
-        encoded_row.write("{", 1);
+        std::string encoded_row;
+        encoded_row.push_back('{');
         for (size_t i = 0; i < _selector_names.size(); ++i) {
             if (i > 0) {
-                encoded_row.write(", ", 2);
+                encoded_row.append(", ");
             }
             bool has_any_upper = boost::algorithm::any_of(_selector_names[i], [](unsigned char c) { return std::isupper(c); });
-            encoded_row.write("\"", 1);
+            encoded_row.push_back('"');
             if (has_any_upper) {
-                encoded_row.write("\\\"", 2);
+                encoded_row.append("\\\"");
             }
-            encoded_row.write(_selector_names[i].c_str(), _selector_names[i].size());
+            encoded_row.append(_selector_names[i]);
             if (has_any_upper) {
-                encoded_row.write("\\\"", 2);
+                encoded_row.append("\\\"");
             }
-            encoded_row.write("\": ", 3);
-            sstring row_sstring = to_json_string(*_selector_types[i], parameters[i]);
-            encoded_row.write(row_sstring.c_str(), row_sstring.size());
+            encoded_row.append("\": ");
+            write_json_string(encoded_row, *_selector_types[i], parameters[i]);
         }
-        encoded_row.write("}", 1);
-        return bytes(encoded_row.linearize());
+        encoded_row.push_back('}');
+        return bytes(reinterpret_cast<const int8_t*>(encoded_row.data()), encoded_row.size());
     }
 
     virtual const function_name& name() const override {
@@ -10,6 +10,7 @@
 #include "cql3/util.hh"
 #include "log.hh"
 #include "lang/wasm.hh"
+#include "lang/wasm_instance_cache.hh"
 
 #include <seastar/core/thread.hh>
 
@@ -48,14 +49,7 @@ bytes_opt user_function::execute(std::span<const bytes_opt> parameters) {
     }
     return seastar::visit(_ctx,
         [&] (lua_context& ctx) -> bytes_opt {
-            std::vector<data_value> values;
-            values.reserve(parameters.size());
-            for (int i = 0, n = types.size(); i != n; ++i) {
-                const data_type& type = types[i];
-                const bytes_opt& bytes = parameters[i];
-                values.push_back(bytes ? type->deserialize(*bytes) : data_value::make_null(type));
-            }
-            return lua::run_script(lua::bitcode_view{ctx.bitcode}, values, return_type(), ctx.cfg).get0();
+            return lua::run_script(lua::bitcode_view{ctx.bitcode}, types, parameters, return_type(), ctx.cfg).get0();
         },
         [&] (wasm::context& ctx) -> bytes_opt {
             try {
@@ -66,6 +60,16 @@ bytes_opt user_function::execute(std::span<const bytes_opt> parameters) {
         });
 }
 
+future<> user_function::prewarm() {
+    auto* ctx = std::get_if<wasm::context>(&_ctx);
+    if (!ctx) {
+        return make_ready_future<>();
+    }
+    return ctx->cache.prewarm(name(), arg_types(), *ctx).handle_exception([this] (std::exception_ptr ep) {
+        log.debug("Failed to prewarm function {}: {}", name(), ep);
+    });
+}
+
 std::ostream& user_function::describe(std::ostream& os) const {
     auto ks = cql3::util::maybe_quote(name().keyspace);
     auto na = cql3::util::maybe_quote(name().name);
@@ -60,6 +60,10 @@ class user_function final : public abstract_function, public scalar_function, pu
     virtual bool is_aggregate() const override;
     virtual bool requires_thread() const override;
     virtual bytes_opt execute(std::span<const bytes_opt> parameters) override;
+    // Prepares the function for being executed on this shard, by the
+    // current scheduling group. Failing to do so is not an error, execute()
+    // will try again.
+    future<> prewarm();
 
     virtual sstring keypace_name() const override { return name().keyspace; }
     virtual sstring element_name() const override { return name().name; }
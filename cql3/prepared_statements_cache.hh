@@ -20,9 +20,23 @@ namespace cql3 {
 using prepared_cache_entry = std::unique_ptr<statements::prepared_statement>;
 
 struct prepared_cache_entry_size {
+    // TODO: improve the size approximation
+    static constexpr size_t approximate_size = 10000;
+
     size_t operator()(const prepared_cache_entry& val) {
-        // TODO: improve the size approximation
-        return 10000;
+        return approximate_size;
+    }
+};
+
+/// \brief A statement prepared on another shard, which this shard prepares on first use.
+struct deferred_statement {
+    sstring query_string;
+    sstring keyspace;
+};
+
+struct deferred_statement_size {
+    size_t operator()(const deferred_statement& val) {
+        return val.query_string.size() + val.keyspace.size() + sizeof(deferred_statement);
     }
 };
 
@@ -67,6 +81,10 @@ class prepared_statements_cache {
         uint64_t prepared_cache_evictions = 0;
         uint64_t privileged_entries_evictions_on_size = 0;
         uint64_t unprivileged_entries_evictions_on_size = 0;
+        // Statements prepared on another shard and deferred on this one,
+        // and how many of them were prepared here later, on first use.
+        uint64_t deferred_prepares = 0;
+        uint64_t deferred_prepares_completed = 0;
     };
 
     static stats& shard_stats() {
@@ -100,6 +118,7 @@ class prepared_statements_cache {
     // 2 cache hits.
     using cache_type = utils::loading_cache<cache_key_type, prepared_cache_entry, 2, utils::loading_cache_reload_enabled::no, prepared_cache_entry_size, utils::tuple_hash, std::equal_to<cache_key_type>, prepared_cache_stats_updater, prepared_cache_stats_updater>;
     using cache_value_ptr = typename cache_type::value_ptr;
+    using deferred_cache_type = utils::loading_cache<cache_key_type, deferred_statement, 0, utils::loading_cache_reload_enabled::no, deferred_statement_size, utils::tuple_hash>;
     using checked_weak_ptr = typename statements::prepared_statement::checked_weak_ptr;
 
 public:
@@ -111,11 +130,15 @@ class prepared_statements_cache {
 
 private:
     cache_type _cache;
+    deferred_cache_type _deferred;
 
 public:
     prepared_statements_cache(logging::logger& logger, size_t size)
         : _cache(size, entry_expiry, logger)
-    {}
+        , _deferred(size, entry_expiry, logger)
+    {
+        _cache.enable_frequency_based_eviction(std::max<size_t>(size / prepared_cache_entry_size::approximate_size, 1));
+    }
 
     template <typename LoadFunc>
     future<value_type> get(const key_type& key, LoadFunc&& load) {
@@ -138,6 +161,41 @@ class prepared_statements_cache {
         return value_type();
     }
 
+    /// Records a statement prepared on another shard, so that it can be prepared on this one on first use
+    /// instead of eagerly, see take_deferred().
+    future<> defer(const key_type& key, deferred_statement stmt) {
+        if (_cache.find(key.key())) {
+            return make_ready_future<>();
+        }
+        ++shard_stats().deferred_prepares;
+        return _deferred.get_ptr(key.key(), [stmt = std::move(stmt)] (const cache_key_type&) mutable {
+            return make_ready_future<deferred_statement>(std::move(stmt));
+        }).discard_result().handle_exception_type([] (typename deferred_cache_type::entry_is_too_big&) {
+            // Will be prepared again by the client, if needed.
+        });
+    }
+
+    /// Removes and returns the deferred statement of the key, if any.
+    std::optional<deferred_statement> take_deferred(const key_type& key) {
+        auto vp = _deferred.find(key.key());
+        if (!vp) {
+            return std::nullopt;
+        }
+        auto stmt = std::move(*vp);
+        _deferred.remove(key.key());
+        return stmt;
+    }
+
+    /// Drops all deferred statements. Their text may no longer prepare to
+    /// what the client was told in response to the PREPARE.
+    void clear_deferred() {
+        _deferred.remove_if([] (const deferred_statement&) { return true; });
+    }
+
+    void clear() {
+        _cache.remove_if([] (const prepared_cache_entry&) { return true; });
+    }
+
     template <typename Pred>
     requires std::is_invocable_r_v<bool, Pred, ::shared_ptr<cql_statement>>
     void remove_if(Pred&& pred) {
@@ -155,7 +213,7 @@ class prepared_statements_cache {
     }
 
     future<> stop() {
-        return _cache.stop();
+        return _cache.stop().finally([this] { return _deferred.stop(); });
     }
 };
 }
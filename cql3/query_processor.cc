@@ -23,9 +23,11 @@
 #include "cql3/error_collector.hh"
 #include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
+#include "cql3/statements/select_statement.hh"
 #include "cql3/util.hh"
 #include "cql3/untyped_result_set.hh"
 #include "db/config.hh"
+#include "db/consistency_level_validations.hh"
 #include "data_dictionary/data_dictionary.hh"
 #include "utils/hashers.hh"
 #include "utils/error_injection.hh"
@@ -38,6 +40,7 @@ using namespace cql_transport::messages;
 logging::logger log("query_processor");
 logging::logger prep_cache_log("prepared_statements_cache");
 logging::logger authorized_prepared_statements_cache_log("authorized_prepared_statements_cache");
+logging::logger unprep_cache_log("unprepared_statements_cache");
 
 const sstring query_processor::CQL_VERSION = "3.3.1";
 
@@ -67,6 +70,8 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
         , _cql_config(cql_cfg)
         , _prepared_cache(prep_cache_log, _mcfg.prepared_statment_cache_size)
         , _authorized_prepared_cache(std::move(auth_prep_cache_cfg), authorized_prepared_statements_cache_log)
+        // loading_cache refuses a zero size, a zero size disables caching in get_unprepared_statement()
+        , _unprepared_cache(unprep_cache_log, std::max<size_t>(_mcfg.unprepared_statement_cache_size, 1))
         , _auth_prepared_cache_cfg_cb([this] (uint32_t) { (void) _authorized_prepared_cache_config_action.trigger_later(); })
         , _authorized_prepared_cache_config_action([this] { update_authorized_prepared_cache_config(); return make_ready_future<>(); })
         , _authorized_prepared_cache_update_interval_in_ms_observer(_db.get_config().permissions_update_interval_in_ms.observe(_auth_prepared_cache_cfg_cb))
@@ -330,6 +335,17 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
                             [] { return prepared_statements_cache::shard_stats().unprivileged_entries_evictions_on_size; },
                             sm::description("Counts a number of evictions of prepared statements from the prepared statements cache after they have been used only once. An increasing counter suggests the user may be preparing a different statement for each request instead of reusing the same prepared statement with parameters.")),
 
+                    sm::make_counter(
+                            "prepared_cache_deferred_prepares",
+                            [] { return prepared_statements_cache::shard_stats().deferred_prepares; },
+                            sm::description("Counts the statements prepared on another shard which this shard deferred preparing until their first use. "
+                                            "The difference with prepared_cache_deferred_prepares_completed is the number of preparations saved.")),
+
+                    sm::make_counter(
+                            "prepared_cache_deferred_prepares_completed",
+                            [] { return prepared_statements_cache::shard_stats().deferred_prepares_completed; },
+                            sm::description("Counts the statements with a deferred preparation which were used, and so prepared, on this shard.")),
+
                     sm::make_gauge(
                             "prepared_cache_size",
                             [this] { return _prepared_cache.size(); },
@@ -340,6 +356,53 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
                             [this] { return _prepared_cache.memory_footprint(); },
                             sm::description("Size (in bytes) of the prepared statements cache.")),
 
+                    sm::make_counter(
+                            "unprepared_cache_hits",
+                            _stats.unprepared_cache_hits,
+                            sm::description("Counts the unprepared queries whose statement was found prepared in the unprepared statements cache.")),
+
+                    sm::make_counter(
+                            "unprepared_cache_misses",
+                            _stats.unprepared_cache_misses,
+                            sm::description("Counts the unprepared queries whose statement had to be parsed and prepared, "
+                                            "while the unprepared statements cache was enabled.")),
+
+                    sm::make_gauge(
+                            "unprepared_cache_size",
+                            [this] { return _unprepared_cache.size(); },
+                            sm::description("A number of entries in the unprepared statements cache.")),
+
+                    sm::make_counter(
+                            "results_cache_hits",
+                            [this] { return _results_cache.get_stats().hits; },
+                            sm::description("Counts the prepared SELECT statements whose results were found in the query results cache.")),
+
+                    sm::make_counter(
+                            "results_cache_misses",
+                            [this] { return _results_cache.get_stats().misses; },
+                            sm::description("Counts the prepared SELECT statements of tables with a results TTL whose results "
+                                            "weren't in the query results cache, or were stale.")),
+
+                    sm::make_counter(
+                            "results_cache_evictions",
+                            [this] { return _results_cache.get_stats().evictions; },
+                            sm::description("Counts the results evicted from the query results cache to make room for new ones.")),
+
+                    sm::make_counter(
+                            "results_cache_invalidations",
+                            [this] { return _results_cache.get_stats().invalidations; },
+                            sm::description("Counts the writes which made the cached results of their table stale.")),
+
+                    sm::make_gauge(
+                            "results_cache_size",
+                            [this] { return _results_cache.size(); },
+                            sm::description("A number of entries in the query results cache.")),
+
+                    sm::make_gauge(
+                            "results_cache_memory_footprint",
+                            [this] { return _results_cache.memory(); },
+                            sm::description("Size (in bytes) of the query results cache.")),
+
                     sm::make_counter(
                             "secondary_index_creates",
                             _cql_stats.secondary_index_creates,
@@ -458,6 +521,7 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
             });
 
     _mnotifier.register_listener(_migration_subscriber.get());
+    _proxy.local_db().data_listeners().install(&_results_cache);
 }
 
 query_processor::~query_processor() {
@@ -481,8 +545,13 @@ future<> query_processor::stop_remote() {
 }
 
 future<> query_processor::stop() {
+    _proxy.local_db().data_listeners().uninstall(&_results_cache);
     return _mnotifier.unregister_listener(_migration_subscriber.get()).then([this] {
-        return _authorized_prepared_cache.stop().finally([this] { return _prepared_cache.stop(); });
+        return _authorized_prepared_cache.stop().finally([this] {
+            return _unprepared_cache.stop();
+        }).finally([this] {
+            return _prepared_cache.stop();
+        });
     }).then([this] {
         return _wasm_instance_cache ? _wasm_instance_cache->stop() : make_ready_future<>();
     });
@@ -492,7 +561,7 @@ future<::shared_ptr<result_message>>
 query_processor::execute_direct_without_checking_exception_message(const sstring_view& query_string, service::query_state& query_state, query_options& options) {
     log.trace("execute_direct: \"{}\"", query_string);
     tracing::trace(query_state.get_trace_state(), "Parsing a statement");
-    auto p = get_statement(query_string, query_state.get_client_state());
+    auto p = co_await get_unprepared_statement(query_string, query_state.get_client_state());
     auto cql_statement = p->statement;
     const auto warnings = std::move(p->warnings);
     if (cql_statement->get_bound_terms() != options.get_values_count()) {
@@ -527,6 +596,21 @@ query_processor::execute_prepared_without_checking_exception_message(
 
     ::shared_ptr<cql_statement> statement = prepared->statement;
 
+    // Only the results of complete, non-serial reads of the tables with a
+    // results TTL are cached, see query_results_cache.
+    std::optional<query_results_cache::key> results_key;
+    schema_ptr results_schema;
+    const size_t results_cache_max_memory = size_t(_db.get_config().query_results_cache_size_in_mb()) << 20;
+    if (results_cache_max_memory && !options.get_paging_state() && !db::is_serial_consistency(options.get_consistency())) {
+        if (auto select = dynamic_pointer_cast<statements::select_statement>(statement); select && !select->bypass_cache()) {
+            auto s = _db.find_schema(select->keyspace(), select->column_family());
+            if (s->caching_options().results_ttl().count()) {
+                results_key = query_results_cache::make_key(cache_key, options);
+                results_schema = std::move(s);
+            }
+        }
+    }
+
     if (needs_authorization) {
         co_await statement->check_access(*this, query_state.get_client_state());
         try {
@@ -536,7 +620,25 @@ query_processor::execute_prepared_without_checking_exception_message(
         }
     }
 
-    co_return co_await process_authorized_statement(std::move(statement), query_state, options);
+    if (!results_key) {
+        co_return co_await process_authorized_statement(std::move(statement), query_state, options);
+    }
+
+    if (auto rs = _results_cache.get(*results_key)) {
+        ++_stats.queries_by_cl[size_t(options.get_consistency())];
+        statement->validate(*this, query_state.get_client_state());
+        tracing::trace(query_state.get_trace_state(), "Returning the results found in the query results cache");
+        co_return ::make_shared<result_message::rows>(cql3::result(std::move(rs)));
+    }
+
+    // The generation has to be taken before reading, so that the writes
+    // racing with the read prevent its results from being cached.
+    const auto generation = _results_cache.generation(results_schema->id());
+    auto msg = co_await process_authorized_statement(std::move(statement), query_state, options);
+    if (auto rows = dynamic_pointer_cast<result_message::rows>(msg); rows && !rows->rs().get_metadata().paging_state()) {
+        _results_cache.put(std::move(*results_key), *results_schema, generation, rows->rs(), results_cache_max_memory);
+    }
+    co_return std::move(msg);
 }
 
 future<::shared_ptr<result_message>>
@@ -549,12 +651,28 @@ query_processor::process_authorized_statement(const ::shared_ptr<cql_statement>
 
     auto msg = co_await statement->execute_without_checking_exception_message(*this, query_state, options);
 
+    // The writes coordinated by this shard may be applied by other shards or
+    // nodes only, so they wouldn't invalidate the cached results otherwise.
+    if (auto modification = dynamic_pointer_cast<statements::modification_statement>(statement)) {
+        invalidate_cached_results(*modification->s);
+    } else if (auto batch = dynamic_pointer_cast<statements::batch_statement>(statement)) {
+        for (auto& single : batch->get_statements()) {
+            invalidate_cached_results(*single.statement->s);
+        }
+    }
+
     if (msg) {
        co_return std::move(msg);
     }
     co_return ::make_shared<result_message::void_message>();
 }
 
+void query_processor::invalidate_cached_results(const schema& s) {
+    if (s.caching_options().results_ttl().count()) {
+        _results_cache.invalidate(s.id());
+    }
+}
+
 future<::shared_ptr<cql_transport::messages::result_message::prepared>>
 query_processor::prepare(sstring query_string, service::query_state& query_state) {
     auto& client_state = query_state.get_client_state();
@@ -615,6 +733,73 @@ query_processor::get_statement(const sstring_view& query, const service::client_
     return p;
 }
 
+std::unique_ptr<prepared_statement>
+query_processor::get_statement(const std::string_view& query, std::string_view keyspace) {
+    std::unique_ptr<raw::parsed_statement> statement = parse_statement(query);
+
+    auto cf_stmt = dynamic_cast<raw::cf_statement*>(statement.get());
+    if (cf_stmt) {
+        cf_stmt->prepare_keyspace(keyspace);
+    }
+    ++_stats.prepare_invocations;
+    auto p = statement->prepare(_db, _cql_stats);
+    p->statement->raw_cql_statement = sstring(query);
+    return p;
+}
+
+future<std::unique_ptr<prepared_statement>>
+query_processor::get_unprepared_statement(const std::string_view& query, const service::client_state& client_state) {
+    if (!_db.get_config().cache_unprepared_statements() || !_mcfg.unprepared_statement_cache_size || client_state.is_thrift()) {
+        co_return get_statement(query, client_state);
+    }
+    auto copy = [] (const prepared_statement& p) {
+        return std::make_unique<prepared_statement>(p.statement, p.bound_names, p.partition_key_bind_indices, p.warnings);
+    };
+    auto key = compute_id(query, client_state.get_raw_keyspace());
+    if (auto cached = _unprepared_cache.find(key)) {
+        ++_stats.unprepared_cache_hits;
+        co_return copy(*cached);
+    }
+    ++_stats.unprepared_cache_misses;
+    auto p = get_statement(query, client_state);
+    auto* stmt = p->statement.get();
+    if (dynamic_cast<statements::select_statement*>(stmt) || dynamic_cast<statements::modification_statement*>(stmt)
+            || dynamic_cast<statements::batch_statement*>(stmt)) {
+        try {
+            co_await _unprepared_cache.get(key, [&] {
+                return make_ready_future<std::unique_ptr<prepared_statement>>(copy(*p));
+            });
+        } catch (prepared_statements_cache::statement_is_too_big&) {
+            // Used uncached
+        }
+    }
+    co_return p;
+}
+
+future<> query_processor::defer_prepare(prepared_cache_key_type key, sstring query_string, sstring keyspace) {
+    return do_with(std::move(key), [this, query_string = std::move(query_string), keyspace = std::move(keyspace)] (const prepared_cache_key_type& key) mutable {
+        return _prepared_cache.defer(key, deferred_statement{std::move(query_string), std::move(keyspace)});
+    });
+}
+
+future<bool> query_processor::prepare_deferred(const prepared_cache_key_type& key) {
+    auto stmt = _prepared_cache.take_deferred(key);
+    if (!stmt) {
+        co_return false;
+    }
+    try {
+        co_await _prepared_cache.get(key, [this, &stmt] {
+            return make_ready_future<std::unique_ptr<statements::prepared_statement>>(get_statement(stmt->query_string, stmt->keyspace));
+        });
+    } catch (...) {
+        // The client will be asked to prepare it again, and will get the error then.
+        log.debug("Failed to prepare deferred statement \"{}\": {}", stmt->query_string, std::current_exception());
+        co_return false;
+    }
+    ++prepared_statements_cache::shard_stats().deferred_prepares_completed;
+    co_return true;
+}
+
 std::unique_ptr<raw::parsed_statement>
 query_processor::parse_statement(const sstring_view& query) {
     try {
@@ -947,74 +1132,92 @@ query_processor::migration_subscriber::migration_subscriber(query_processor* qp)
 }
 
 void query_processor::migration_subscriber::on_create_keyspace(const sstring& ks_name) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_create_column_family(const sstring& ks_name, const sstring& cf_name) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_create_user_type(const sstring& ks_name, const sstring& type_name) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_create_function(const sstring& ks_name, const sstring& function_name) {
+    clear_schema_dependent_caches();
     log.warn("{} event ignored", __func__);
 }
 
 void query_processor::migration_subscriber::on_create_aggregate(const sstring& ks_name, const sstring& aggregate_name) {
+    clear_schema_dependent_caches();
     log.warn("{} event ignored", __func__);
 }
 
 void query_processor::migration_subscriber::on_create_view(const sstring& ks_name, const sstring& view_name) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_update_keyspace(const sstring& ks_name) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_update_column_family(
         const sstring& ks_name,
         const sstring& cf_name,
         bool columns_changed) {
+    clear_schema_dependent_caches();
     // #1255: Ignoring columns_changed deliberately.
     log.info("Column definitions for {}.{} changed, invalidating related prepared statements", ks_name, cf_name);
     remove_invalid_prepared_statements(ks_name, cf_name);
 }
 
 void query_processor::migration_subscriber::on_update_user_type(const sstring& ks_name, const sstring& type_name) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_update_function(const sstring& ks_name, const sstring& function_name) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_update_aggregate(const sstring& ks_name, const sstring& aggregate_name) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_update_view(
         const sstring& ks_name,
         const sstring& view_name, bool columns_changed) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_update_tablet_metadata() {
 }
 
 void query_processor::migration_subscriber::on_drop_keyspace(const sstring& ks_name) {
+    clear_schema_dependent_caches();
     remove_invalid_prepared_statements(ks_name, std::nullopt);
 }
 
 void query_processor::migration_subscriber::on_drop_column_family(const sstring& ks_name, const sstring& cf_name) {
+    clear_schema_dependent_caches();
     remove_invalid_prepared_statements(ks_name, cf_name);
 }
 
 void query_processor::migration_subscriber::on_drop_user_type(const sstring& ks_name, const sstring& type_name) {
+    clear_schema_dependent_caches();
 }
 
 void query_processor::migration_subscriber::on_drop_function(const sstring& ks_name, const sstring& function_name) {
+    clear_schema_dependent_caches();
     log.warn("{} event ignored", __func__);
 }
 
 void query_processor::migration_subscriber::on_drop_aggregate(const sstring& ks_name, const sstring& aggregate_name) {
+    clear_schema_dependent_caches();
     log.warn("{} event ignored", __func__);
 }
 
 void query_processor::migration_subscriber::on_drop_view(const sstring& ks_name, const sstring& view_name) {
+    clear_schema_dependent_caches();
     remove_invalid_prepared_statements(ks_name, view_name);
 }
 
@@ -1024,6 +1227,18 @@ void query_processor::migration_subscriber::remove_invalid_prepared_statements(
     _qp->_prepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
         return this->should_invalidate(ks_name, cf_name, stmt);
     });
+    // Which tables a deferred statement depends on isn't known before
+    // preparing it, so drop them all. Clients prepare them again on use.
+    _qp->_prepared_cache.clear_deferred();
+}
+
+void query_processor::migration_subscriber::clear_schema_dependent_caches() {
+    // Unlike prepared statements, unprepared queries are expected to see
+    // every schema change, e.g. new columns in `SELECT *` or new function
+    // overloads, so none of their statements is kept across one.
+    _qp->_unprepared_cache.clear();
+    // Neither are the cached results, whose metadata may be outdated.
+    _qp->_results_cache.clear();
 }
 
 bool query_processor::migration_subscriber::should_invalidate(
@@ -19,6 +19,7 @@
 
 #include "cql3/prepared_statements_cache.hh"
 #include "cql3/authorized_prepared_statements_cache.hh"
+#include "cql3/query_results_cache.hh"
 #include "cql3/statements/prepared_statement.hh"
 #include "exceptions/exceptions.hh"
 #include "lang/wasm_instance_cache.hh"
@@ -95,6 +96,7 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     struct memory_config {
         size_t prepared_statment_cache_size = 0;
         size_t authorized_prepared_cache_size = 0;
+        size_t unprepared_statement_cache_size = 0;
     };
 
 private:
@@ -110,6 +112,8 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
 
     struct stats {
         uint64_t prepare_invocations = 0;
+        uint64_t unprepared_cache_hits = 0;
+        uint64_t unprepared_cache_misses = 0;
         uint64_t queries_by_cl[size_t(db::consistency_level::MAX_VALUE) + 1] = {};
     } _stats;
 
@@ -119,6 +123,10 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
 
     prepared_statements_cache _prepared_cache;
     authorized_prepared_statements_cache _authorized_prepared_cache;
+    // The statements of unprepared queries, see get_unprepared_statement()
+    prepared_statements_cache _unprepared_cache;
+    // The results of prepared SELECT statements, see query_results_cache
+    query_results_cache _results_cache;
 
     std::function<void(uint32_t)> _auth_prepared_cache_cfg_cb;
     serialized_action _authorized_prepared_cache_config_action;
@@ -210,6 +218,15 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
         return _prepared_cache.find(key);
     }
 
+    // Records a statement prepared on another shard, with the given key and
+    // session keyspace. It is only prepared on this shard by prepare_deferred(),
+    // when first used here, so statements used on few shards are prepared on few.
+    future<> defer_prepare(prepared_cache_key_type key, sstring query_string, sstring keyspace);
+
+    // Prepares the statement recorded for the key by defer_prepare(), if any.
+    // Returns whether get_prepared() can now find it.
+    future<bool> prepare_deferred(const prepared_cache_key_type& key);
+
     inline
     future<::shared_ptr<cql_transport::messages::result_message>>
     execute_prepared(
@@ -415,6 +432,18 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
             const std::string_view& query,
             const service::client_state& client_state);
 
+    std::unique_ptr<statements::prepared_statement> get_statement(
+            const std::string_view& query,
+            std::string_view keyspace);
+
+    // Like get_statement(), but takes SELECT and data modification statements
+    // from _unprepared_cache if they were prepared for the same query string
+    // and keyspace before, and keeps them there otherwise. Other statements
+    // may depend on more than the schema, e.g. CREATE TABLE picks a table id.
+    future<std::unique_ptr<statements::prepared_statement>> get_unprepared_statement(
+            const std::string_view& query,
+            const service::client_state& client_state);
+
     friend class migration_subscriber;
 
     shared_ptr<cql_transport::messages::result_message> bounce_to_shard(unsigned shard, cql3::computed_function_values cached_fn_calls);
@@ -436,6 +465,9 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     future<::shared_ptr<cql_transport::messages::result_message>>
     process_authorized_statement(const ::shared_ptr<cql_statement> statement, service::query_state& query_state, const query_options& options);
 
+    // Makes the cached results of the table stale, see query_results_cache
+    void invalidate_cached_results(const schema& s);
+
     /*!
      * \brief created a state object for paging
      *
@@ -550,6 +582,7 @@ class query_processor::migration_subscriber : public service::migration_listener
 
 private:
     void remove_invalid_prepared_statements(sstring ks_name, std::optional<sstring> cf_name);
+    void clear_schema_dependent_caches();
 
     bool should_invalidate(
             sstring ks_name,
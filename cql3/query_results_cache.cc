@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "cql3/query_results_cache.hh"
+#include "cql3/query_options.hh"
+#include "bytes_ostream.hh"
+#include "schema/schema.hh"
+#include "utils/hash.hh"
+
+namespace cql3 {
+
+size_t query_results_cache::key_hash::operator()(const key& k) const {
+    return utils::tuple_hash()(k.statement, k.options);
+}
+
+query_results_cache::key query_results_cache::make_key(const prepared_cache_key_type& statement, const query_options& options) {
+    bytes_ostream out;
+    auto write_int = [&out] (int32_t v) {
+        out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+    };
+    write_int(int32_t(options.get_consistency()));
+    write_int(options.get_page_size());
+    write_int(options.skip_metadata());
+    for (size_t i = 0; i < options.get_values_count(); ++i) {
+        if (options.is_unset(i)) {
+            write_int(-2);
+            continue;
+        }
+        auto value = options.get_value_at(i);
+        if (value.is_null()) {
+            write_int(-1);
+            continue;
+        }
+        write_int(value.size_bytes());
+        value.with_linearized([&out] (bytes_view v) {
+            out.write(v);
+        });
+    }
+    return key{statement, bytes(out.linearize())};
+}
+
+static std::unique_ptr<result_set> copy_results(const result& results) {
+    auto builder = result_set::builder(make_shared<metadata>(results.get_metadata()));
+    results.visit(builder);
+    return std::make_unique<result_set>(std::move(builder).get_result_set());
+}
+
+static std::unique_ptr<result_set> copy_results(const result_set& results) {
+    auto builder = result_set::builder(make_shared<metadata>(results.get_metadata()));
+    results.visit(builder);
+    return std::make_unique<result_set>(std::move(builder).get_result_set());
+}
+
+static size_t memory_of(const query_results_cache::key& k, const result_set& results) {
+    size_t memory = k.options.size() + k.statement.key().first.size();
+    for (auto& row : results.rows()) {
+        memory += sizeof(row) + row.size() * sizeof(result_set::col_type);
+        for (auto& cell : row) {
+            memory += cell ? cell->size() : 0;
+        }
+    }
+    return memory;
+}
+
+void query_results_cache::erase(std::list<entry>::iterator it) {
+    _memory -= it->memory;
+    _index.erase(it->k);
+    _lru.erase(it);
+}
+
+std::unique_ptr<result_set> query_results_cache::get(const key& k) {
+    auto i = _index.find(k);
+    if (i == _index.end()) {
+        ++_stats.misses;
+        return nullptr;
+    }
+    auto it = i->second;
+    if (it->expiry <= lowres_clock::now() || it->generation != _generations[it->table]) {
+        ++_stats.misses;
+        erase(it);
+        return nullptr;
+    }
+    ++_stats.hits;
+    _lru.splice(_lru.begin(), _lru, it);
+    return copy_results(*it->results);
+}
+
+void query_results_cache::put(key k, const schema& s, uint64_t generation, const result& results, size_t max_memory) {
+    if (auto i = _index.find(k); i != _index.end()) {
+        erase(i->second);
+    }
+    if (generation != _generations[s.id()]) {
+        return;
+    }
+    auto copy = copy_results(results);
+    auto memory = sizeof(entry) + memory_of(k, *copy);
+    if (memory > max_memory) {
+        return;
+    }
+    while (_memory + memory > max_memory) {
+        ++_stats.evictions;
+        erase(std::prev(_lru.end()));
+    }
+    _lru.push_front(entry{
+        .k = k,
+        .table = s.id(),
+        .generation = generation,
+        .expiry = lowres_clock::now() + s.caching_options().results_ttl(),
+        .results = std::move(copy),
+        .memory = memory,
+    });
+    _index.emplace(std::move(k), _lru.begin());
+    _memory += memory;
+}
+
+void query_results_cache::invalidate(const table_id& id) {
+    ++_stats.invalidations;
+    ++_generations[id];
+}
+
+void query_results_cache::clear() {
+    _index.clear();
+    _lru.clear();
+    _generations.clear();
+    _memory = 0;
+}
+
+void query_results_cache::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    if (s->caching_options().results_ttl().count()) {
+        invalidate(s->id());
+    }
+}
+
+}
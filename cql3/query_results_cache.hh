@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+#include <seastar/core/lowres_clock.hh>
+
+#include "bytes.hh"
+#include "cql3/prepared_statements_cache.hh"
+#include "cql3/result_set.hh"
+#include "db/data_listeners.hh"
+#include "schema/schema_fwd.hh"
+
+namespace cql3 {
+
+class query_options;
+
+/// \brief A per-shard cache of the results of prepared SELECT statements
+///
+/// Only the tables with a non-zero results_ttl_in_ms caching option are
+/// cached, see caching_options::results_ttl(). A result is returned again for
+/// the same statement and bound values for up to that long.
+///
+/// The writes applied by this shard invalidate the results of their table (see
+/// on_write()), and so do the ones it coordinates (see invalidate()). The
+/// writes coordinated and applied elsewhere aren't seen: the results may be
+/// stale for up to the table's results TTL.
+class query_results_cache : public db::data_listener {
+public:
+    struct key {
+        prepared_cache_key_type statement;
+        // The bound values and the options which affect the results
+        bytes options;
+
+        bool operator==(const key&) const = default;
+    };
+
+    struct key_hash {
+        size_t operator()(const key& k) const;
+    };
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t invalidations = 0;
+        uint64_t evictions = 0;
+    };
+private:
+    struct entry {
+        key k;
+        table_id table;
+        // The generation of the table when the results were cached, see _generations
+        uint64_t generation;
+        lowres_clock::time_point expiry;
+        std::unique_ptr<result_set> results;
+        size_t memory;
+    };
+
+    // The most recently used entry first
+    std::list<entry> _lru;
+    std::unordered_map<key, std::list<entry>::iterator, key_hash> _index;
+    // Bumped by each write to a table, making the results cached before it stale.
+    // Stale entries are dropped when looked up, or evicted.
+    std::unordered_map<table_id, uint64_t> _generations;
+    size_t _memory = 0;
+    stats _stats;
+
+    void erase(std::list<entry>::iterator it);
+public:
+    /// \returns the key of the results of a prepared statement executed with the given options
+    static key make_key(const prepared_cache_key_type& statement, const query_options& options);
+
+    /// \returns a copy of the cached results, or nullptr if there are none or they are stale
+    std::unique_ptr<result_set> get(const key& k);
+
+    /// \returns the generation of the table, to be passed to put() by the
+    /// readers started now
+    uint64_t generation(const table_id& id) {
+        return _generations[id];
+    }
+
+    /// Caches a copy of the results of reading table \p s, evicting the least
+    /// recently used results to stay within \p max_memory. The results are
+    /// dropped if the table was written to since \p generation.
+    void put(key k, const schema& s, uint64_t generation, const result& results, size_t max_memory);
+
+    /// Makes the cached results of the table stale
+    void invalidate(const table_id& id);
+
+    void clear();
+
+    size_t size() const noexcept {
+        return _index.size();
+    }
+
+    size_t memory() const noexcept {
+        return _memory;
+    }
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override;
+};
+
+}
@@ -32,6 +32,7 @@
 #include "types/list.hh"
 #include "types/map.hh"
 #include "types/set.hh"
+#include "utils/like_matcher.hh"
 
 namespace {
 struct maybe_column_definition {
@@ -212,6 +213,43 @@ static std::vector<expr::expression> extract_partition_range(
 /// Extracts where_clause atoms with clustering-column LHS and copies them to a vector.  These elements define the
 /// boundaries of any clustering slice that can possibly meet where_clause.  This vector can be calculated before
 /// binding expression markers, since LHS and operator are always known.
+/// Returns a single-column restriction with its LIKE atoms replaced by the slice of texts starting with the
+/// literal prefix of their pattern, or nullopt if any of its atoms needs filtering and has no such slice (a
+/// pattern which is a bind marker or starts with a wildcard, CONTAINS, etc.).  The LIKE atoms still filter
+/// the rows read, since they remain in the WHERE clause.
+static std::optional<expr::expression> with_like_prefixes_as_slices(const expr::expression& restriction) {
+    using namespace expr;
+    std::vector<expression> atoms;
+    for (auto& atom : boolean_factors(restriction)) {
+        auto* binop = as_if<binary_operator>(&atom);
+        if (!binop || !needs_filtering(binop->op)) {
+            atoms.push_back(atom);
+            continue;
+        }
+        auto* pattern = binop->op == oper_t::LIKE ? as_if<constant>(&binop->rhs) : nullptr;
+        if (!pattern || pattern->is_null()) {
+            return std::nullopt;
+        }
+        auto prefix = like_matcher::literal_prefix(to_bytes(pattern->value.view()));
+        if (prefix.empty()) {
+            return std::nullopt;
+        }
+        atoms.push_back(binary_operator(binop->lhs, oper_t::GTE,
+                constant(raw_value::make_value(managed_bytes(prefix)), pattern->type)));
+        // Texts and ASCII compare bytewise, so the texts starting with the prefix are below it with its last byte
+        // incremented, after dropping the trailing bytes which can't be.
+        while (!prefix.empty() && uint8_t(prefix.back()) == 0xff) {
+            prefix.resize(prefix.size() - 1);
+        }
+        if (!prefix.empty()) {
+            prefix.back() = bytes::value_type(uint8_t(prefix.back()) + 1);
+            atoms.push_back(binary_operator(binop->lhs, oper_t::LT,
+                    constant(raw_value::make_value(managed_bytes(prefix)), pattern->type)));
+        }
+    }
+    return conjunction{std::move(atoms)};
+}
+
 static std::vector<expr::expression> extract_clustering_prefix_restrictions(
         const expr::expression& where_clause, schema_ptr schema) {
     using namespace expr;
@@ -342,13 +380,20 @@ static std::vector<expr::expression> extract_clustering_prefix_restrictions(
         if (found == v.single.end()) { // Any further restrictions are skipping the CK order.
             break;
         }
-        if (find_needs_filtering(found->second)) { // This column's restriction doesn't define a clear bound.
-            // TODO: if this is a conjunction of filtering and non-filtering atoms, we could split them and add the
-            // latter to the prefix.
-            break;
+        auto restriction = found->second;
+        if (find_needs_filtering(restriction)) {
+            // A LIKE pattern starting with a literal still bounds the column, e.g. `c LIKE 'abc%'` to
+            // `c >= 'abc' AND c < 'abd'`.
+            auto bounded = with_like_prefixes_as_slices(restriction);
+            if (!bounded) { // This column's restriction doesn't define a clear bound.
+                // TODO: if this is a conjunction of filtering and non-filtering atoms, we could split them and
+                // add the latter to the prefix.
+                break;
+            }
+            restriction = std::move(*bounded);
         }
-        prefix.push_back(found->second);
-        if (has_slice(found->second)) {
+        prefix.push_back(restriction);
+        if (has_slice(restriction)) {
             break;
         }
     }
@@ -27,7 +27,9 @@ class result_generator {
     class query_result_visitor {
         const schema& _schema;
         std::vector<bytes> _partition_key;
-        std::vector<bytes> _clustering_key;
+        // Views of the current row's key, only valid in accept_new_row().
+        // Rows are many more than partitions, so their keys aren't copied.
+        std::vector<managed_bytes_view> _clustering_key;
         uint64_t _partition_row_count = 0;
         uint64_t _total_row_count = 0;
         Visitor& _visitor;
@@ -56,8 +58,11 @@ class result_generator {
 
         void accept_new_row(const clustering_key& key, query::result_row_view static_row,
                             query::result_row_view row) {
-            _clustering_key = key.explode(_schema);
+            for (managed_bytes_view c : key.components(_schema)) {
+                _clustering_key.push_back(c);
+            }
             accept_new_row(static_row, row);
+            _clustering_key.clear();
         }
         void accept_new_row(query::result_row_view static_row, query::result_row_view row) {
             auto static_row_iterator = static_row.iterator();
@@ -70,7 +75,7 @@ class result_generator {
                     break;
                 case column_kind::clustering_key:
                     if (_clustering_key.size() > def->component_index()) {
-                        _visitor.accept_value(bytes_view(_clustering_key[def->component_index()]));
+                        _visitor.accept_value(_clustering_key[def->component_index()]);
                     } else {
                         _visitor.accept_value(std::nullopt);
                     }
@@ -196,6 +196,16 @@ class selection_with_processing : public selection {
     std::vector<expr::expression> _inner_loop;
     std::vector<expr::expression> _outer_loop;
     std::vector<raw_value> _initial_values_for_temporaries;
+    // An inner loop element computed by a batch_accumulator rather than by
+    // evaluating it.
+    struct batched_aggregate {
+        db::functions::batch_accumulator_factory make_accumulator;
+        // The aggregated column, or nullptr for aggregates with no arguments.
+        const column_definition* col;
+        // For static and regular columns, index in the selection.
+        int32_t index;
+    };
+    std::vector<std::optional<batched_aggregate>> _batched_aggregates; // same size as _inner_loop
 public:
     selection_with_processing(schema_ptr schema, std::vector<const column_definition*> columns,
             std::vector<lw_shared_ptr<column_specification>> metadata,
@@ -209,7 +219,35 @@ class selection_with_processing : public selection {
         _outer_loop = std::move(agg_split.outer_loop);
         _inner_loop = std::move(agg_split.inner_loop);
         _initial_values_for_temporaries = std::move(agg_split.initial_values_for_temporaries);
+        for (size_t i = 0; i != _inner_loop.size(); ++i) {
+            _batched_aggregates.push_back(get_batched_aggregate(*agg_split.aggregates[i], _inner_loop[i]));
+        }
+    }
+private:
+    std::optional<batched_aggregate> get_batched_aggregate(const functions::aggregate_function& agg_func, const expr::expression& inner) const {
+        auto& agg = agg_func.get_aggregate();
+        if (!agg.make_batch_accumulator) {
+            return std::nullopt;
+        }
+        // The arguments follow the temporary holding the state.
+        auto& args = expr::as<expr::function_call>(inner).args;
+        if (args.size() == 1) {
+            return batched_aggregate{agg.make_batch_accumulator, nullptr, -1};
+        }
+        auto col = args.size() == 2 ? expr::as_if<expr::column_value>(&args[1]) : nullptr;
+        if (!col) {
+            return std::nullopt;
+        }
+        int32_t index = -1;
+        if (col->col->kind == column_kind::static_column || col->col->kind == column_kind::regular_column) {
+            index = index_of(*col->col);
+            if (index == -1) {
+                return std::nullopt;
+            }
+        }
+        return batched_aggregate{agg.make_batch_accumulator, col->col, index};
     }
+public:
 
     virtual uint32_t add_column_for_post_processing(const column_definition& c) override {
         uint32_t index = selection::add_column_for_post_processing(c);
@@ -232,6 +270,7 @@ class selection_with_processing : public selection {
                     .args = {temp, expr::column_value(&c)},
                 });
             _initial_values_for_temporaries.push_back(raw_value::make_value(agg.initial_state));
+            _batched_aggregates.push_back(std::nullopt);
             _outer_loop.push_back(
                 expr::function_call{
                     .func = agg.state_to_result_function,
@@ -256,7 +295,11 @@ class selection_with_processing : public selection {
     virtual bool is_reducible() const override {
         return boost::algorithm::all_of(
                 _selectors,
-               [] (const expr::expression& e) {
+               [this] (const expr::expression& e) {
+                    if (expr::is<expr::column_value>(e)) {
+                        // Added for post-processing, reduced with $$first$$
+                        return is_aggregate();
+                    }
                     auto fc = expr::as_if<expr::function_call>(&e);
                     if (!fc) {
                         return false;
@@ -285,6 +328,14 @@ class selection_with_processing : public selection {
             throw std::runtime_error("Selection doesn't have a reduction");
         };
         for (const auto& e : _selectors) {
+            if (auto col = expr::as_if<expr::column_value>(&e); col && is_aggregate()) {
+                types.push_back(query::forward_request::reduction_type::aggregate);
+                infos.push_back(query::forward_request::aggregation_info{
+                    .name = functions::aggregate_fcts::first_function_name(),
+                    .column_names = {col->col->name_as_text()},
+                });
+                continue;
+            }
             auto fc = expr::as_if<expr::function_call>(&e);
             if (!fc) {
                 bad();
@@ -343,7 +394,31 @@ class selection_with_processing : public selection {
     private:
         const selection_with_processing& _sel;
         std::vector<raw_value> _temporaries;
+        // Same size as _temporaries, null where the inner loop is evaluated.
+        std::vector<std::unique_ptr<db::functions::batch_accumulator>> _accumulators;
         bool _requires_thread;
+
+        static std::optional<managed_bytes_view> get_input(const batched_aggregate& agg, const result_set_builder& rs) {
+            if (!agg.col) {
+                return managed_bytes_view();
+            }
+            switch (agg.col->kind) {
+            case column_kind::partition_key:
+                return managed_bytes_view(bytes_view(rs.current_partition_key[agg.col->id]));
+            case column_kind::clustering_key:
+                if (agg.col->id >= rs.current_clustering_key.size()) {
+                    return std::nullopt;
+                }
+                return managed_bytes_view(bytes_view(rs.current_clustering_key[agg.col->id]));
+            default: {
+                auto& v = rs.current[agg.index];
+                if (!v) {
+                    return std::nullopt;
+                }
+                return managed_bytes_view(*v);
+            }
+            }
+        }
     public:
         explicit selectors_with_processing(const selection_with_processing& sel)
             : _sel(sel)
@@ -353,7 +428,11 @@ class selection_with_processing : public selection {
                     return std::get<shared_ptr<functions::function>>(fc.func)->requires_thread();
                 });
              }))
-        { }
+        {
+            for (auto& agg : _sel._batched_aggregates) {
+                _accumulators.push_back(agg ? agg->make_accumulator() : nullptr);
+            }
+        }
 
         virtual bool requires_thread() const override {
             return _requires_thread;
@@ -361,6 +440,11 @@ class selection_with_processing : public selection {
 
         virtual void reset() override {
             _temporaries = _sel._initial_values_for_temporaries;
+            for (auto& acc : _accumulators) {
+                if (acc) {
+                    acc->reset();
+                }
+            }
         }
 
         virtual bool is_aggregate() const override {
@@ -388,6 +472,11 @@ class selection_with_processing : public selection {
         }
 
         virtual std::vector<managed_bytes_opt> get_output_row() override {
+            for (size_t i = 0; i != _accumulators.size(); ++i) {
+                if (_accumulators[i]) {
+                    _temporaries[i] = raw_value::make_value(_accumulators[i]->state());
+                }
+            }
             std::vector<managed_bytes_opt> output_row;
             output_row.reserve(_sel._outer_loop.size());
             auto inputs = expr::evaluation_inputs{
@@ -419,7 +508,11 @@ class selection_with_processing : public selection {
                     .temporaries = _temporaries,
             };
             for (size_t i = 0; i != _sel._inner_loop.size(); ++i) {
-                _temporaries[i] = expr::evaluate(_sel._inner_loop[i], inputs);
+                if (_accumulators[i]) {
+                    _accumulators[i]->add(get_input(*_sel._batched_aggregates[i], rs));
+                } else {
+                    _temporaries[i] = expr::evaluate(_sel._inner_loop[i], inputs);
+                }
             }
         }
 
@@ -649,8 +742,9 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
         }
     }
 
-    auto static_row_iterator = static_row.iterator();
     auto row_iterator = row ? std::optional<query::result_row_view::iterator_type>(row->iterator()) : std::nullopt;
+    // Materialized once per row, on first use.
+    std::optional<std::vector<managed_bytes_opt>> static_and_regular_columns;
     const expr::single_column_restrictions_map& non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
     for (auto&& cdef : selection.get_columns()) {
         switch (cdef->kind) {
@@ -665,14 +759,15 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
                 continue;
             }
             const expr::expression& single_col_restriction = restr_it->second;
-            // FIXME: push to upper layer so it happens once per row
-            auto static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
-            bool regular_restriction_matches = expr::is_satisfied_by(
+            if (!static_and_regular_columns) {
+                static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
+            }
+            bool regular_restriction_matches = is_satisfied_by(selection, *cdef,
                     single_col_restriction,
                     expr::evaluation_inputs{
                         .partition_key = partition_key,
                         .clustering_key = clustering_key,
-                        .static_and_regular_columns = static_and_regular_columns,
+                        .static_and_regular_columns = *static_and_regular_columns,
                         .selection = &selection,
                         .options = &_options,
                     });
@@ -686,13 +781,14 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (_skip_pk_restrictions) {
                 continue;
             }
-            auto partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
+            const expr::single_column_restrictions_map& partition_key_restrictions_map =
+                _restrictions->get_single_column_partition_key_restrictions();
             auto restr_it = partition_key_restrictions_map.find(cdef);
             if (restr_it == partition_key_restrictions_map.end()) {
                 continue;
             }
             const expr::expression& single_col_restriction = restr_it->second;
-            if (!expr::is_satisfied_by(
+            if (!is_satisfied_by(selection, *cdef,
                         single_col_restriction,
                         expr::evaluation_inputs{
                             .partition_key = partition_key,
@@ -720,7 +816,7 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
                 return false;
             }
             const expr::expression& single_col_restriction = restr_it->second;
-            if (!expr::is_satisfied_by(
+            if (!is_satisfied_by(selection, *cdef,
                         single_col_restriction,
                         expr::evaluation_inputs{
                             .partition_key = partition_key,
@@ -740,6 +836,27 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
     return true;
 }
 
+const expr::compiled_predicate* result_set_builder::restrictions_filter::get_compiled(const selection& selection,
+        const column_definition& cdef, const expr::expression& restriction) const {
+    if (_compiled_for != &selection) {
+        _compiled.clear();
+        _compiled_for = &selection;
+    }
+    auto it = _compiled.find(&cdef);
+    if (it == _compiled.end()) {
+        it = _compiled.emplace(&cdef, expr::compiled_predicate::compile(restriction, selection, _options)).first;
+    }
+    return it->second ? &*it->second : nullptr;
+}
+
+bool result_set_builder::restrictions_filter::is_satisfied_by(const selection& selection, const column_definition& cdef,
+        const expr::expression& restriction, const expr::evaluation_inputs& inputs) const {
+    if (auto compiled = get_compiled(selection, cdef, restriction)) {
+        return compiled->is_satisfied_by(inputs);
+    }
+    return expr::is_satisfied_by(restriction, inputs);
+}
+
 bool result_set_builder::restrictions_filter::operator()(const selection& selection,
                                                          const std::vector<bytes>& partition_key,
                                                          const std::vector<bytes>& clustering_key,
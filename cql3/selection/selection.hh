@@ -16,6 +16,7 @@
 #include "selector.hh"
 #include "cql3/column_specification.hh"
 #include "cql3/functions/function.hh"
+#include "cql3/expr/compiled_predicate.hh"
 #include "exceptions/exceptions.hh"
 #include "unimplemented.hh"
 #include <seastar/core/thread.hh>
@@ -217,6 +218,10 @@ class result_set_builder {
         mutable uint64_t _rows_fetched_for_last_partition;
         mutable std::optional<partition_key> _last_pkey;
         mutable bool _is_first_partition_on_page = true;
+        // Single column restrictions compiled on first use, for the selection
+        // of _compiled_for. Restrictions which can't be compiled map to nullopt.
+        mutable const selection* _compiled_for = nullptr;
+        mutable std::unordered_map<const column_definition*, std::optional<expr::compiled_predicate>> _compiled;
     public:
         explicit restrictions_filter(::shared_ptr<const restrictions::statement_restrictions> restrictions,
                 const query_options& options,
@@ -232,6 +237,8 @@ class result_set_builder {
         }
     private:
         bool do_filter(const selection& selection, const std::vector<bytes>& pk, const std::vector<bytes>& ck, const query::result_row_view& static_row, const query::result_row_view* row) const;
+        const expr::compiled_predicate* get_compiled(const selection& selection, const column_definition& cdef, const expr::expression& restriction) const;
+        bool is_satisfied_by(const selection& selection, const column_definition& cdef, const expr::expression& restriction, const expr::evaluation_inputs& inputs) const;
     };
 
     result_set_builder(const selection& s, gc_clock::time_point now,
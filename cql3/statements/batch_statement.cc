@@ -311,6 +311,11 @@ future<coordinator_result<>> batch_statement::execute_without_conditions(
         _stats.batches_pure_unlogged += 1;
         mutate_atomic = false;
     } else {
+        // get_mutations() merged the statements of each partition, so only
+        // a batch of a single partition of a single table can skip the
+        // batchlog. Mutations of other tables, even with the same token
+        // and so the same replicas, are separate writes to the replicas,
+        // and only the batchlog makes them all eventually applied together.
         if (mutations.size() > 1) {
             _stats.batches_pure_logged += 1;
         } else {
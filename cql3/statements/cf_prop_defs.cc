@@ -127,6 +127,12 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
     if (auto caching_options = get_caching_options(); caching_options && !caching_options->enabled() && !db.features().per_table_caching) {
         throw exceptions::configuration_exception(KW_CACHING + " can't contain \"'enabled':false\" unless whole cluster supports it");
     }
+    if (auto caching_options = get_caching_options(); caching_options && caching_options->admit_frequent_only() && !db.features().cache_admission_policy) {
+        throw exceptions::configuration_exception(KW_CACHING + " can't contain \"'admission':'FREQUENT'\" unless whole cluster supports it");
+    }
+    if (auto caching_options = get_caching_options(); caching_options && caching_options->results_ttl().count() && !db.features().query_results_cache) {
+        throw exceptions::configuration_exception(KW_CACHING + " can't contain 'results_ttl_in_ms' unless whole cluster supports it");
+    }
 
     auto cdc_options = get_cdc_options(schema_extensions);
     if (cdc_options && cdc_options->enabled() && !db.features().cdc) {
@@ -163,7 +169,10 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         }
     }
 
-    speculative_retry::from_sstring(get_string(KW_SPECULATIVE_RETRY, speculative_retry(speculative_retry::type::NONE, 0).to_sstring()));
+    auto sr = speculative_retry::from_sstring(get_string(KW_SPECULATIVE_RETRY, speculative_retry(speculative_retry::type::NONE, 0).to_sstring()));
+    if (sr.get_type() == speculative_retry::type::ADAPTIVE && !db.features().adaptive_speculative_retry) {
+        throw exceptions::configuration_exception(KW_SPECULATIVE_RETRY + " can't be ADAPTIVE unless whole cluster supports it");
+    }
 }
 
 std::map<sstring, sstring> cf_prop_defs::get_compaction_type_options() const {
@@ -275,11 +275,22 @@ modification_statement::do_execute(query_processor& qp, service::query_state& qs
         return execute_with_condition(qp, qs, options);
     }
 
-    return execute_without_condition(qp, qs, options).then([] (coordinator_result<> res) {
+    return execute_without_condition(qp, qs, options).then([this, &qs, &options] (coordinator_result<> res) {
         if (!res) {
             return make_ready_future<::shared_ptr<cql_transport::messages::result_message>>(
                     seastar::make_shared<cql_transport::messages::result_message::exception>(std::move(res).assume_error()));
         }
+        if (qs.get_client_state().is_protocol_extension_set(cql_transport::cql_protocol_extension::TABLETS_ROUTING_V1)) {
+            auto keys = _restrictions->get_partition_key_ranges(options);
+            if (keys.size() == 1 && query::is_single_partition(keys.front())) {
+                auto token = keys.front().start()->value().as_decorated_key().token();
+                if (auto info = util::get_tablet_info_if_misrouted(*s, qs.get_client_state(), token)) {
+                    auto msg = seastar::make_shared<cql_transport::messages::result_message::void_message>();
+                    msg->add_tablet_info(std::move(info->replicas), std::move(info->token_range));
+                    return make_ready_future<::shared_ptr<cql_transport::messages::result_message>>(std::move(msg));
+                }
+            }
+        }
         return make_ready_future<::shared_ptr<cql_transport::messages::result_message>>(
                 ::shared_ptr<cql_transport::messages::result_message>{});
     });
@@ -21,6 +21,7 @@
 #include "service/broadcast_tables/experimental/lang.hh"
 #include "transport/messages/result_message.hh"
 #include "cql3/functions/as_json_function.hh"
+#include "cql3/functions/aggregate_fcts.hh"
 #include "cql3/selection/selection.hh"
 #include "cql3/util.hh"
 #include "cql3/restrictions/statement_restrictions.hh"
@@ -410,13 +411,25 @@ select_statement::do_execute(query_processor& qp,
         }
     }
 
-    if (!aggregate && !_restrictions_need_filtering && (page_size <= 0
-            || !service::pager::query_pagers::may_need_paging(*_schema, page_size,
-                    *command, key_ranges))) {
-        return execute_without_checking_exception_message_non_aggregate_unpaged(qp, command, std::move(key_ranges), state, options, now);
-    } else {
-        return execute_without_checking_exception_message_aggregate_or_paged(qp, command, std::move(key_ranges), state, options, now, page_size, aggregate, nonpaged_filtering);
+    std::optional<dht::token> routing_token;
+    if (key_ranges.size() == 1 && query::is_single_partition(key_ranges.front())) {
+        routing_token = key_ranges[0].start()->value().as_decorated_key().token();
     }
+
+    auto f = !aggregate && !_restrictions_need_filtering && (page_size <= 0
+            || !service::pager::query_pagers::may_need_paging(*_schema, page_size,
+                    *command, key_ranges))
+            ? execute_without_checking_exception_message_non_aggregate_unpaged(qp, command, std::move(key_ranges), state, options, now)
+            : execute_without_checking_exception_message_aggregate_or_paged(qp, command, std::move(key_ranges), state, options, now, page_size, aggregate, nonpaged_filtering);
+    if (!routing_token) {
+        return f;
+    }
+    return f.then([this, &state, token = *routing_token] (shared_ptr<cql_transport::messages::result_message> msg) {
+        if (msg && !msg->is_exception() && !msg->move_to_shard()) {
+            util::add_tablet_info_if_misrouted(*msg, *_schema, state.get_client_state(), token);
+        }
+        return msg;
+    });
 }
 
 future<::shared_ptr<cql_transport::messages::result_message>>
@@ -707,18 +720,39 @@ indexed_table_select_statement::do_execute_base_query(
         auto key_it_end = key_it + next_iteration_size;
         auto command = ::make_lw_shared<query::read_command>(*cmd);
 
+        // The rows of one partition are read by a single query, as long as
+        // their clustering keys are full and increasing, so the rows are
+        // still returned in the order of the keys.
+        std::vector<std::span<const primary_key>> groups;
+        clustering_key_prefix::less_compare ck_less(*_schema);
+        auto groupable = [this] (const primary_key& key) {
+            return key.clustering && key.clustering.is_full(*_schema);
+        };
+        for (auto it = key_it; it != key_it_end;) {
+            auto group_end = std::next(it);
+            if (groupable(*it)) {
+                while (group_end != key_it_end && groupable(*group_end)
+                        && group_end->partition.equal(*_schema, it->partition)
+                        && ck_less(std::prev(group_end)->clustering, group_end->clustering)) {
+                    ++group_end;
+                }
+            }
+            groups.emplace_back(&*it, size_t(std::distance(it, group_end)));
+            it = group_end;
+        }
+
         query::result_merger oneshot_merger(cmd->get_row_limit(), query::max_partitions);
-        coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>> rresult = co_await utils::result_map_reduce(key_it, key_it_end, coroutine::lambda([&] (auto& key)
+        coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>> rresult = co_await utils::result_map_reduce(groups.begin(), groups.end(), coroutine::lambda([&] (std::span<const primary_key> group)
                 -> future<coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>>> {
             auto command = ::make_lw_shared<query::read_command>(*cmd);
-            // for each partition, read just one clustering row (TODO: can
-            // get all needed rows of one partition at once.)
             command->slice._row_ranges.clear();
-            if (key.clustering) {
-                command->slice._row_ranges.push_back(query::clustering_range::make_singular(key.clustering));
+            for (auto& key : group) {
+                if (key.clustering) {
+                    command->slice._row_ranges.push_back(query::clustering_range::make_singular(key.clustering));
+                }
             }
             coordinator_result<service::storage_proxy::coordinator_query_result> rqr
-                    = co_await qp.proxy().query_result(_schema, command, {dht::partition_range::make_singular(key.partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()});
+                    = co_await qp.proxy().query_result(_schema, command, {dht::partition_range::make_singular(group.front().partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()});
             if (!rqr.has_value()) {
                 co_return std::move(rqr).as_failure();
             }
@@ -1595,6 +1629,22 @@ parallelized_select_statement::do_execute(
     auto timeout_duration = get_timeout(state.get_client_state(), options);
     auto timeout = lowres_system_clock::now() + timeout_duration;
     auto reductions = _selection->get_reductions();
+    const auto result_columns = reductions.types.size();
+    std::optional<std::vector<sstring>> group_by_columns;
+    if (has_group_by()) {
+        // The coordinator orders the groups by their GROUP BY values, so
+        // they are reduced too.
+        group_by_columns.emplace();
+        for (auto index : *_group_by_cell_indices) {
+            auto name = _selection->get_columns()[index]->name_as_text();
+            reductions.types.push_back(query::forward_request::reduction_type::aggregate);
+            reductions.infos.push_back(query::forward_request::aggregation_info{
+                .name = functions::aggregate_fcts::first_function_name(),
+                .column_names = {name},
+            });
+            group_by_columns->push_back(std::move(name));
+        }
+    }
 
     query::forward_request req = {
         .reduction_types = reductions.types,
@@ -1603,13 +1653,24 @@ parallelized_select_statement::do_execute(
         .cl = options.get_consistency(),
         .timeout = timeout,
         .aggregation_infos = reductions.infos,
+        .group_by_columns = std::move(group_by_columns),
     };
 
     // dispatch execution of this statement to other nodes
-    return qp.forward(req, state.get_trace_state()).then([this] (query::forward_result res) {
+    return qp.forward(req, state.get_trace_state()).then([this, result_columns, limit = get_limit(options)] (query::forward_result res) {
         auto meta = _selection->get_result_metadata();
         auto rs = std::make_unique<result_set>(std::move(meta));
-        rs->add_row(res.query_results);
+        if (res.grouped_query_results) {
+            for (auto& group : *res.grouped_query_results) {
+                if (rs->size() == limit) {
+                    break;
+                }
+                group.resize(result_columns);
+                rs->add_row(std::move(group));
+            }
+        } else {
+            rs->add_row(res.query_results);
+        }
         update_stats_rows_read(rs->size());
         return shared_ptr<cql_transport::messages::result_message>(
             make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)))
@@ -1763,17 +1824,43 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
         );
     };
 
+    // A grouped aggregation can be forwarded if its groups can't span
+    // partitions, so that the groups computed by different shards are
+    // disjoint, and if the coordinator can put them back in query order:
+    // GROUP BY must name a prefix of the primary key covering the whole
+    // partition key, and the query must not be reversed nor limited per
+    // partition. Selected columns are then reduced with $$first$$, which
+    // is exact since a group is computed by a single shard.
+    auto group_by_can_be_forwarded = [&] {
+        if (group_by_cell_indices->empty()) {
+            return true;
+        }
+        if (!db.features().grouped_parallelized_aggregation
+                || is_reversed_ || !_parameters->orderings().empty() || _parameters->is_distinct() || _per_partition_limit) {
+            return false;
+        }
+        auto key_columns = schema->all_columns_in_select_order();
+        for (size_t i = 0; i < group_by_cell_indices->size(); ++i) {
+            if (selection->get_columns()[(*group_by_cell_indices)[i]] != &key_columns[i]) {
+                return false;
+            }
+        }
+        return group_by_cell_indices->size() >= schema->partition_key_size();
+    };
+
     // Used to determine if an execution of this statement can be parallelized
     // using `forward_service`.
     auto can_be_forwarded = [&] {
-        return all_aggregates(prepared_selectors)   // Note: before we levellized aggregation depth
+        return all_aggregates(group_by_cell_indices->empty()
+                    ? prepared_selectors   // Note: before we levellized aggregation depth
+                    : levellized_prepared_selectors)
             && ( // SUPPORTED PARALLELIZATION
                  // All potential intermediate coordinators must support forwarding
                 (db.features().parallelized_aggregation && selection->is_count())
                 || (db.features().uda_native_parallelized_aggregation && selection->is_reducible())
             )
             && !restrictions->need_filtering()  // No filtering
-            && group_by_cell_indices->empty()   // No GROUP BY
+            && group_by_can_be_forwarded()
             && db.get_config().enable_parallelized_aggregation();
     };
 
@@ -145,6 +145,8 @@ protected :
 
     bool has_group_by() const { return _group_by_cell_indices && !_group_by_cell_indices->empty(); }
 
+    bool bypass_cache() const { return _parameters->bypass_cache(); }
+
     db::timeout_clock::duration get_timeout(const service::client_state& state, const query_options& options) const;
 
 protected:
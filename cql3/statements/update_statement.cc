@@ -38,39 +38,35 @@ namespace json_helpers {
  * should be treated as case-sensitive, while regular strings should be
  * case-insensitive.
  */
-static std::unordered_map<sstring, rjson::value> handle_case_sensitivity(rjson::value&& value_map) {
-    std::unordered_map<sstring, rjson::value> case_sensitive_map;
-    for (auto it = value_map.MemberBegin(); it != value_map.MemberEnd(); ++it) {
-        sstring name(rjson::to_string_view(it->name));
-        if (name.size() > 1 && *name.begin() == '"' && name.back() == '"') {
-            case_sensitive_map.emplace(name.substr(1, name.size() - 2), std::move(it->value));
-        } else {
-            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-            case_sensitive_map.emplace(std::move(name), std::move(it->value));
-        }
+static std::string column_name_of(std::string_view name) {
+    if (name.size() > 1 && name.front() == '"' && name.back() == '"') {
+        return std::string(name.substr(1, name.size() - 2));
     }
-    return case_sensitive_map;
+    std::string lowered(name);
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(), ::tolower);
+    return lowered;
 }
 
 std::unordered_map<sstring, bytes_opt>
 parse(const sstring& json_string, const std::vector<column_definition>& expected_receivers) {
     std::unordered_map<sstring, bytes_opt> json_map;
-    auto prepared_map = handle_case_sensitivity(rjson::parse(json_string));
-    for (const auto& def : expected_receivers) {
-        sstring cql_name = def.name_as_text();
-        auto value_it = prepared_map.find(cql_name);
-        if (value_it == prepared_map.end()) {
+    // The values are converted straight from the parsed document, in the
+    // order of its members; there are few receivers, a linear search is cheaper
+    // than indexing them.
+    auto value_map = rjson::parse(json_string);
+    for (auto it = value_map.MemberBegin(); it != value_map.MemberEnd(); ++it) {
+        auto name = column_name_of(rjson::to_string_view(it->name));
+        auto def = std::ranges::find_if(expected_receivers, [&] (const column_definition& def) {
+            return std::string_view(def.name_as_text()) == name;
+        });
+        if (def == expected_receivers.end()) {
+            throw exceptions::invalid_request_exception(format("JSON values map contains unrecognized column: {}", name));
+        }
+        if (json_map.contains(def->name_as_text())) {
+            // The first value given for a column wins
             continue;
-        } else if (value_it->second.IsNull()) {
-            json_map.emplace(std::move(cql_name), bytes_opt{});
-            prepared_map.erase(value_it);
-        } else {
-            json_map.emplace(std::move(cql_name), from_json_object(*def.type, std::move(value_it->second)));
-            prepared_map.erase(value_it);
         }
-    }
-    if (!prepared_map.empty()) {
-        throw exceptions::invalid_request_exception(format("JSON values map contains unrecognized column: {}", prepared_map.begin()->first));
+        json_map.emplace(def->name_as_text(), it->value.IsNull() ? bytes_opt{} : bytes_opt(from_json_object(*def->type, it->value)));
     }
     return json_map;
 }
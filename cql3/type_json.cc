@@ -18,7 +18,9 @@
 #include "types/listlike_partial_deserializing_iterator.hh"
 #include "utils/managed_bytes.hh"
 #include "exceptions/exceptions.hh"
+#include <iterator>
 #include <limits>
+#include <string>
 #include <utility>
 #include <boost/algorithm/string/trim_all.hpp>
 #include <boost/algorithm/string.hpp>
@@ -27,55 +29,53 @@ static inline bool is_control_char(char c) {
     return c >= 0 && c <= 0x1F;
 }
 
-static inline bool needs_escaping(const sstring& s) {
+static inline bool needs_escaping(std::string_view s) {
     return std::any_of(s.begin(), s.end(), [](char c) {return is_control_char(c) || c == '"' || c == '\\';});
 }
 
-
-static sstring quote_json_string(const sstring& value) {
+/// Appends value to out as a quoted JSON string.
+static void write_quoted_json_string(std::string& out, std::string_view value) {
+    out.push_back('"');
     if (!needs_escaping(value)) {
-        return format("\"{}\"", value);
+        out.append(value);
+        out.push_back('"');
+        return;
     }
-    std::ostringstream oss;
-    oss << std::hex << std::uppercase << std::setfill('0');
-    oss.put('"');
     for (char c : value) {
         switch (c) {
         case '"':
-            oss.put('\\').put('"');
+            out.append("\\\"");
             break;
         case '\\':
-            oss.put('\\').put('\\');
+            out.append("\\\\");
             break;
         case '\b':
-            oss.put('\\').put('b');
+            out.append("\\b");
             break;
         case '\f':
-            oss.put('\\').put('f');
+            out.append("\\f");
             break;
         case '\n':
-            oss.put('\\').put('n');
+            out.append("\\n");
             break;
         case '\r':
-            oss.put('\\').put('r');
+            out.append("\\r");
             break;
         case '\t':
-            oss.put('\\').put('t');
+            out.append("\\t");
             break;
         default:
             if (is_control_char(c)) {
-                oss.put('\\').put('u') << std::setw(4) << static_cast<int>(c);
+                fmt::format_to(std::back_inserter(out), "\\u{:04X}", static_cast<int>(c));
             } else {
-                oss.put(c);
+                out.push_back(c);
             }
             break;
         }
     }
-    oss.put('"');
-    return oss.str();
+    out.push_back('"');
 }
 
-
 template <typename T> static T to_int(const rjson::value& value) {
     int64_t result;
 
@@ -342,195 +342,178 @@ template <typename T> static T compose_value(const integer_type_impl<T>& t, byte
     return read_be<T>(reinterpret_cast<const char*>(bv.data()));
 }
 
-static sstring to_json_string_aux(const map_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+// The JSON representations of values are all appended to a single buffer,
+// so a row or a nested collection isn't built from a string per element.
+
+static void write_json(std::string& out, const abstract_type& t, bytes_view bv);
+
+static void write_json(std::string& out, const abstract_type& t, const managed_bytes_view_opt& e) {
+    if (e) {
+        write_json(out, t, linearized(*e));
+    } else {
+        out.append("null");
+    }
+}
 
-    out << '{';
+static void write_json_aux(std::string& out, const map_type_impl& t, bytes_view bv) {
+    out.push_back('{');
     auto size = read_collection_size(bv);
     for (int i = 0; i < size; ++i) {
         auto kb = read_collection_key(bv);
         auto vb = read_collection_value_nonnull(bv);
 
         if (i > 0) {
-            out << ", ";
+            out.append(", ");
         }
 
         // Valid keys in JSON map must be quoted strings
-        sstring string_key = to_json_string(*t.get_keys_type(), kb);
-        bool is_unquoted = string_key.empty() || string_key[0] != '"';
-        if (is_unquoted) {
-            out << '"';
+        auto key_pos = out.size();
+        write_json(out, *t.get_keys_type(), kb);
+        if (out.size() == key_pos || out[key_pos] != '"') {
+            out.insert(key_pos, 1, '"');
+            out.push_back('"');
         }
-        out << string_key;
-        if (is_unquoted) {
-            out << '"';
-        }
-        out << ": ";
-        out << to_json_string(*t.get_values_type(), vb);
+        out.append(": ");
+        write_json(out, *t.get_values_type(), vb);
     }
-    out << '}';
-    return out.str();
+    out.push_back('}');
 }
 
-static sstring to_json_string_aux(const set_type_impl& t, bytes_view bv) {
+static void write_json_aux(std::string& out, const abstract_type& elements_type, bytes_view bv) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
-    out << '[';
+    out.push_back('[');
     managed_bytes_view mbv(bv);
-    std::for_each(llpdi::begin(mbv), llpdi::end(mbv), [&first, &out, &t] (const managed_bytes_view_opt& e) {
+    std::for_each(llpdi::begin(mbv), llpdi::end(mbv), [&] (const managed_bytes_view_opt& e) {
         if (first) {
             first = false;
         } else {
-            out << ", ";
-        }
-        if (e) {
-            out << to_json_string(*t.get_elements_type(), *e);
-        } else {
-            // Impossible in sets, but let's not insist here.
-            out << "null";
+            out.append(", ");
         }
+        // Null elements are impossible in sets, but let's not insist here.
+        write_json(out, elements_type, e);
     });
-    out << ']';
-    return out.str();
+    out.push_back(']');
 }
 
-static sstring to_json_string_aux(const list_type_impl& t, bytes_view bv) {
-    using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
-    bool first = true;
-    out << '[';
-    managed_bytes_view mbv(bv);
-    std::for_each(llpdi::begin(mbv), llpdi::end(mbv), [&first, &out, &t] (const managed_bytes_view_opt& e) {
-        if (first) {
-            first = false;
-        } else {
-            out << ", ";
-        }
-        if (e) {
-            out << to_json_string(*t.get_elements_type(), *e);
-        } else {
-            out << "null";
-        }
-    });
-    out << ']';
-    return out.str();
-}
-
-static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '[';
+static void write_json_aux(std::string& out, const tuple_type_impl& t, bytes_view bv) {
+    out.push_back('[');
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
-        }
-        if (*vi) {
-            // TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
-        } else {
-            out << "null";
+            out.append(", ");
         }
+        write_json(out, **ti, *vi);
         ++ti;
         ++vi;
     }
 
-    out << ']';
-    return out.str();
+    out.push_back(']');
 }
 
-static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '{';
+static void write_json_aux(std::string& out, const user_type_impl& t, bytes_view bv) {
+    out.push_back('{');
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     int i = 0;
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
-        }
-        out << quote_json_string(t.field_name_as_string(i)) << ": ";
-        if (*vi) {
-            //TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
-        } else {
-            out << "null";
+            out.append(", ");
         }
+        write_quoted_json_string(out, t.field_name_as_string(i));
+        out.append(": ");
+        write_json(out, **ti, *vi);
         ++ti;
         ++i;
         ++vi;
     }
 
-    out << '}';
-    return out.str();
+    out.push_back('}');
 }
 
 namespace {
-struct to_json_string_visitor {
+struct json_writer {
+    std::string& out;
     bytes_view bv;
-    sstring operator()(const reversed_type_impl& t) { return to_json_string(*t.underlying_type(), bv); }
-    template <typename T> sstring operator()(const integer_type_impl<T>& t) { return to_sstring(compose_value(t, bv)); }
-    template <typename T> sstring operator()(const floating_type_impl<T>& t) {
+    void quoted(const sstring& s) { write_quoted_json_string(out, s); }
+    void operator()(const reversed_type_impl& t) { write_json(out, *t.underlying_type(), bv); }
+    template <typename T> void operator()(const integer_type_impl<T>& t) { fmt::format_to(std::back_inserter(out), "{}", compose_value(t, bv)); }
+    template <typename T> void operator()(const floating_type_impl<T>& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
         T d = value_cast<T>(v);
         if (std::isnan(d) || std::isinf(d)) {
-            return "null";
-        }
-        return to_sstring(d);
-    }
-    sstring operator()(const uuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const inet_addr_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const string_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const bytes_type_impl& t) { return quote_json_string("0x" + t.to_string(bv)); }
-    sstring operator()(const boolean_type_impl& t) { return t.to_string(bv); }
-    sstring operator()(const timestamp_date_base_class& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const timeuuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const map_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const set_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const list_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const tuple_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const user_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const simple_date_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const time_type_impl& t) { return t.to_string(bv); }
-    sstring operator()(const empty_type_impl& t) { return "null"; }
-    sstring operator()(const duration_type_impl& t) {
+            out.append("null");
+            return;
+        }
+        out.append(to_sstring(d));
+    }
+    void operator()(const uuid_type_impl& t) { quoted(t.to_string(bv)); }
+    void operator()(const inet_addr_type_impl& t) { quoted(t.to_string(bv)); }
+    void operator()(const string_type_impl& t) { quoted(t.to_string(bv)); }
+    void operator()(const bytes_type_impl& t) { quoted("0x" + t.to_string(bv)); }
+    void operator()(const boolean_type_impl& t) { out.append(t.to_string(bv)); }
+    void operator()(const timestamp_date_base_class& t) { quoted(t.to_string(bv)); }
+    void operator()(const timeuuid_type_impl& t) { quoted(t.to_string(bv)); }
+    void operator()(const map_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const set_type_impl& t) { write_json_aux(out, *t.get_elements_type(), bv); }
+    void operator()(const list_type_impl& t) { write_json_aux(out, *t.get_elements_type(), bv); }
+    void operator()(const tuple_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const user_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const simple_date_type_impl& t) { quoted(t.to_string(bv)); }
+    void operator()(const time_type_impl& t) { out.append(t.to_string(bv)); }
+    void operator()(const empty_type_impl& t) { out.append("null"); }
+    void operator()(const duration_type_impl& t) {
         auto v = t.deserialize(bv);
         if (v.is_null()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
-        return quote_json_string(t.to_string(bv));
+        quoted(t.to_string(bv));
     }
-    sstring operator()(const counter_type_impl& t) {
+    void operator()(const counter_type_impl& t) {
         // It will be called only from cql3 layer while processing query results.
-        return to_json_string(*counter_cell_view::total_value_type(), bv);
+        write_json(out, *counter_cell_view::total_value_type(), bv);
     }
-    sstring operator()(const decimal_type_impl& t) {
+    void operator()(const decimal_type_impl& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
-        return value_cast<big_decimal>(v).to_string();
+        out.append(value_cast<big_decimal>(v).to_string());
     }
-    sstring operator()(const varint_type_impl& t) {
+    void operator()(const varint_type_impl& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
-        return value_cast<utils::multiprecision_int>(v).str();
+        out.append(value_cast<utils::multiprecision_int>(v).str());
     }
 };
 }
 
+static void write_json(std::string& out, const abstract_type& t, bytes_view bv) {
+    visit(t, json_writer{out, bv});
+}
+
+void write_json_string(std::string& out, const abstract_type& t, const bytes_opt& b) {
+    if (b) {
+        write_json(out, t, *b);
+    } else {
+        out.append("null");
+    }
+}
+
 sstring to_json_string(const abstract_type& t, bytes_view bv) {
-    return visit(t, to_json_string_visitor{bv});
+    std::string out;
+    write_json(out, t, bv);
+    return sstring(out);
 }
 
 sstring to_json_string(const abstract_type& t, const managed_bytes_view& mbv) {
-    return visit(t, to_json_string_visitor{linearized(mbv)});
+    return to_json_string(t, linearized(mbv));
 }
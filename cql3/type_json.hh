@@ -13,6 +13,9 @@
 
 bytes from_json_object(const abstract_type &t, const rjson::value& value);
 sstring to_json_string(const abstract_type &t, bytes_view bv);
+// Appends to out what to_json_string() would return, for writing many values
+// without a string for each.
+void write_json_string(std::string& out, const abstract_type& t, const bytes_opt& b);
 sstring to_json_string(const abstract_type &t, const managed_bytes_view& bv);
 
 inline sstring to_json_string(const abstract_type &t, const bytes& b) {
@@ -6,6 +6,9 @@
 
 #include "util.hh"
 #include "cql3/expr/expr-utils.hh"
+#include "replica/database.hh"
+#include "service/client_state.hh"
+#include "transport/messages/result_message.hh"
 
 #ifdef DEBUG
 
@@ -112,6 +115,34 @@ void do_with_parser_impl(const sstring_view& cql, noncopyable_function<void (cql
 
 #endif
 
+std::optional<cql_transport::messages::tablet_info> get_tablet_info_if_misrouted(const schema& s,
+        const service::client_state& client_state, const dht::token& token) {
+    if (!client_state.is_protocol_extension_set(cql_transport::cql_protocol_extension::TABLETS_ROUTING_V1)) {
+        return std::nullopt;
+    }
+    auto erm = s.table().get_effective_replication_map();
+    if (!erm->get_replication_strategy().uses_tablets()) {
+        return std::nullopt;
+    }
+    auto& tm = erm->get_token_metadata();
+    auto& tmap = tm.tablets().get_tablet_map(s.id());
+    auto tid = tmap.get_tablet_id(token);
+    auto& replicas = tmap.get_tablet_info(tid).replicas;
+    auto me = locator::tablet_replica{tm.get_my_id(), this_shard_id()};
+    if (std::find(replicas.begin(), replicas.end(), me) != replicas.end()) {
+        return std::nullopt;
+    }
+    auto range = tmap.get_token_range(tid);
+    return cql_transport::messages::tablet_info{replicas, {range.start()->value(), range.end()->value()}};
+}
+
+void add_tablet_info_if_misrouted(cql_transport::messages::result_message& msg, const schema& s,
+        const service::client_state& client_state, const dht::token& token) {
+    if (auto info = get_tablet_info_if_misrouted(s, client_state, token)) {
+        msg.add_tablet_info(std::move(info->replicas), std::move(info->token_range));
+    }
+}
+
 void validate_timestamp(const db::config& config, const query_options& options, const std::unique_ptr<attributes>& attrs) {
     if (attrs->is_timestamp_set() && config.restrict_future_timestamp()) {
         static constexpr int64_t MAX_DIFFERENCE = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::days(3)).count();
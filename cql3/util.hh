@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include <boost/algorithm/string/join.hpp>
@@ -22,6 +23,15 @@
 #include "cql3/error_collector.hh"
 #include "cql3/statements/raw/select_statement.hh"
 
+namespace cql_transport::messages {
+class result_message;
+struct tablet_info;
+}
+
+namespace service {
+class client_state;
+}
+
 namespace cql3 {
 
 namespace util {
@@ -92,6 +102,17 @@ sstring single_quote(const sstring& s);
 // indicates its incorrectness (for example using other units than microseconds).
 void validate_timestamp(const db::config& config, const query_options& options, const std::unique_ptr<attributes>& attrs);
 
+// If the client enabled the TABLETS_ROUTING_V1 protocol extension, the table
+// uses tablets and this shard isn't a replica of the tablet owning the token,
+// returns the replicas and the token range of that tablet, so the client can
+// send the next requests for the partition to its replicas.
+std::optional<cql_transport::messages::tablet_info> get_tablet_info_if_misrouted(const schema& s,
+        const service::client_state& client_state, const dht::token& token);
+
+// Adds the result of get_tablet_info_if_misrouted(), if any, to the message.
+void add_tablet_info_if_misrouted(cql_transport::messages::result_message& msg, const schema& s,
+        const service::client_state& client_state, const dht::token& token);
+
 } // namespace util
 
 } // namespace cql3
@@ -36,6 +36,8 @@
 #include "cql3/untyped_result_set.hh"
 #include "service_permit.hh"
 #include "cql3/query_processor.hh"
+#include "db/hints/resource_manager.hh"
+#include "replica/database.hh"
 
 static logging::logger blogger("batchlog_manager");
 
@@ -63,18 +65,13 @@ future<> db::batchlog_manager::do_batch_log_replay() {
         auto gate_holder = bm._gate.hold();
         auto sem_units = co_await get_units(bm._sem, 1);
 
-        auto dest = bm._cpu++ % smp::count;
-        blogger.debug("Batchlog replay on shard {}: starts", dest);
-        if (dest == 0) {
-            co_await bm.replay_all_failed_batches();
-        } else {
-            co_await bm.container().invoke_on(dest, [] (auto& bm) {
-                return with_gate(bm._gate, [&bm] {
-                    return bm.replay_all_failed_batches();
-                });
+        blogger.debug("Batchlog replay: starts");
+        co_await bm.container().invoke_on_all([] (auto& bm) {
+            return with_gate(bm._gate, [&bm] {
+                return bm.replay_all_failed_batches();
             });
-        }
-        blogger.debug("Batchlog replay on shard {}: done", dest);
+        });
+        blogger.debug("Batchlog replay: done");
     });
 }
 
@@ -102,12 +99,12 @@ future<> db::batchlog_manager::batchlog_replay_loop() {
 }
 
 future<> db::batchlog_manager::start() {
-    // Since replay is a "node global" operation, we should not attempt to do
-    // it in parallel on each shard. It will just overlap/interfere.  To
+    // Since replay is a "node global" operation, we should not attempt to
+    // start it on each shard. It will just overlap/interfere.  To
     // simplify syncing between batchlog_replay_loop and user initiated replay operations,
     // we use the _sem on shard zero only. Replaying batchlog can
-    // generate a lot of work, so we distrute the real work on all cpus with
-    // round-robin scheduling.
+    // generate a lot of work, so all the shards replay their share of the
+    // batchlog in parallel, see replay_token_range().
     if (this_shard_id() == 0) {
         _started = batchlog_replay_loop();
     }
@@ -147,12 +144,25 @@ db_clock::duration db::batchlog_manager::get_batch_log_timeout() const {
     return _write_request_timeout * 2;
 }
 
+// The token range of system.batchlog replayed by this shard, as the values
+// of the bounds, inclusive. System tables use the Murmur3 partitioner, whose
+// tokens are int64 values.
+static std::pair<int64_t, int64_t> replay_token_range() {
+    auto bound = [] (unsigned shard) {
+        auto offset = uint64_t((__uint128_t(1) << 64) * shard / smp::count);
+        return int64_t(uint64_t(std::numeric_limits<int64_t>::min()) + offset);
+    };
+    auto shard = this_shard_id();
+    return {bound(shard), shard + 1 == smp::count ? std::numeric_limits<int64_t>::max() : bound(shard + 1) - 1};
+}
+
 future<> db::batchlog_manager::replay_all_failed_batches() {
     typedef db_clock::rep clock_type;
 
     // rate limit is in bytes per second. Uses Double.MAX_VALUE if disabled (set to 0 in cassandra.yaml).
-    // max rate is scaled by the number of nodes in the cluster (same as for HHOM - see CASSANDRA-5272).
-    auto throttle = _replay_rate / _qp.proxy().get_token_metadata_ptr()->count_normal_token_owners();
+    // max rate is scaled by the number of nodes in the cluster (same as for HHOM - see CASSANDRA-5272),
+    // and divided between the shards, which replay in parallel.
+    auto throttle = _replay_rate / _qp.proxy().get_token_metadata_ptr()->count_normal_token_owners() / smp::count;
     auto limiter = make_lw_shared<utils::rate_limiter>(throttle);
 
     auto batch = [this, limiter](const cql3::untyped_result_set::row& row) {
@@ -228,11 +238,25 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
             if (ttl <= 0) {
                 return make_ready_future<>();
             }
+            // Pace the replay by the view update backlog of the replicas, like hints do,
+            // so that the view updates generated by the replay don't overload them.
+            auto backlog = db::view::update_backlog::no_backlog();
+            for (auto& m : mutations) {
+                auto erm = _qp.proxy().local_db().find_column_family(m.schema()).get_effective_replication_map();
+                for (auto& ep : erm->get_natural_endpoints(m.token())) {
+                    backlog = std::max(backlog, _qp.proxy().get_backlog_of(ep));
+                }
+            }
+            auto delay = db::hints::replay_rate_limiter::backlog_delay(backlog.relative_size());
+            auto paced = delay.count() ? sleep_abortable(delay, _stop) : make_ready_future<>();
+
             // Origin does the send manually, however I can't see a super great reason to do so.
             // Our normal write path does not add much redundancy to the dispatch, and rate is handled after send
             // in both cases.
             // FIXME: verify that the above is reasonably true.
-            return limiter->reserve(size).then([this, mutations = std::move(mutations)] {
+            return paced.then([limiter, size] {
+                return limiter->reserve(size);
+            }).then([this, mutations = std::move(mutations)] {
                 _stats.write_attempts += mutations.size();
                 // #1222 - change cl level to ALL, emulating origins behaviour of sending/hinting
                 // to all natural end points.
@@ -266,26 +290,28 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
     };
 
     return seastar::with_gate(_gate, [this, batch = std::move(batch)] {
-        blogger.debug("Started replayAllFailedBatches (cpu {})", this_shard_id());
+        const auto [first, last] = replay_token_range();
+        blogger.debug("Started replayAllFailedBatches (cpu {}, tokens [{}, {}])", this_shard_id(), first, last);
 
         typedef ::shared_ptr<cql3::untyped_result_set> page_ptr;
-        sstring query = format("SELECT id, data, written_at, version FROM {}.{} LIMIT {:d}", system_keyspace::NAME, system_keyspace::BATCHLOG, page_size);
-        return _qp.execute_internal(query, cql3::query_processor::cache_internal::yes).then([this, batch = std::move(batch)](page_ptr page) {
-            return do_with(std::move(page), [this, batch = std::move(batch)](page_ptr & page) mutable {
-                return repeat([this, &page, batch = std::move(batch)]() mutable {
+        sstring query = format("SELECT id, data, written_at, version FROM {}.{} WHERE token(id) >= ? AND token(id) <= ? LIMIT {:d}",
+                system_keyspace::NAME, system_keyspace::BATCHLOG, page_size);
+        return _qp.execute_internal(query, {first, last}, cql3::query_processor::cache_internal::yes).then([this, last = last, batch = std::move(batch)](page_ptr page) {
+            return do_with(std::move(page), [this, last, batch = std::move(batch)](page_ptr & page) mutable {
+                return repeat([this, &page, last, batch = std::move(batch)]() mutable {
                     if (page->empty()) {
                         return make_ready_future<stop_iteration>(stop_iteration::yes);
                     }
                     auto id = page->back().get_as<utils::UUID>("id");
-                    return parallel_for_each(*page, batch).then([this, &page, id]() {
+                    return parallel_for_each(*page, batch).then([this, &page, id, last]() {
                         if (page->size() < page_size) {
                             return make_ready_future<stop_iteration>(stop_iteration::yes); // we've exhausted the batchlog, next query would be empty.
                         }
-                        sstring query = format("SELECT id, data, written_at, version FROM {}.{} WHERE token(id) > token(?) LIMIT {:d}",
+                        sstring query = format("SELECT id, data, written_at, version FROM {}.{} WHERE token(id) > token(?) AND token(id) <= ? LIMIT {:d}",
                                 system_keyspace::NAME,
                                 system_keyspace::BATCHLOG,
                                 page_size);
-                        return _qp.execute_internal(query, {id}, cql3::query_processor::cache_internal::yes).then([&page](auto res) {
+                        return _qp.execute_internal(query, {id, last}, cql3::query_processor::cache_internal::yes).then([&page](auto res) {
                                     page = std::move(res);
                                     return make_ready_future<stop_iteration>(stop_iteration::no);
                                 });
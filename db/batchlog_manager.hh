@@ -65,7 +65,6 @@ class batchlog_manager : public peering_sharded_service<batchlog_manager> {
     std::chrono::milliseconds _delay;
     semaphore _sem{1};
     seastar::gate _gate;
-    unsigned _cpu = 0;
     seastar::abort_source _stop;
 
     future<> replay_all_failed_batches();
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "utils/lru.hh"
+#include "utils/frequency_sketch.hh"
 #include "utils/logalloc.hh"
 #include "mutation/partition_version.hh"
 #include "mutation/mutation_cleaner.hh"
@@ -70,6 +71,8 @@ class cache_tracker final {
         uint64_t row_tombstone_reads;
         uint64_t rows_compacted;
         uint64_t rows_compacted_away;
+        uint64_t partition_admissions;
+        uint64_t partition_admission_rejections;
 
         uint64_t active_reads() const {
             return reads - reads_done;
@@ -83,8 +86,12 @@ class cache_tracker final {
     mutation_cleaner _garbage;
     mutation_cleaner _memtable_cleaner;
     mutation_application_stats& _app_stats;
+    // Recent read frequency of partitions missing in cache, for admission.
+    utils::frequency_sketch _admission_sketch;
+    seastar::lowres_clock::time_point _last_eviction;
 private:
     void setup_metrics();
+    bool under_eviction_pressure() const noexcept;
 public:
     using register_metrics = bool_class<class register_metrics_tag>;
     cache_tracker(mutation_application_stats&, register_metrics);
@@ -112,6 +119,12 @@ class cache_tracker final {
     void on_row_miss() noexcept;
     void on_miss_already_populated() noexcept;
     void on_mispopulate() noexcept;
+    // TinyLFU-style admission for a partition missing in cache, identified by
+    // a hash of its key. Records the access and returns whether the partition
+    // should be populated. While nothing is being evicted everything is
+    // admitted, otherwise only partitions read repeatedly in the recent past
+    // are, so that one-off reads (e.g. full scans) don't push out the working set.
+    bool admit(uint64_t key_hash) noexcept;
     void on_row_processed_from_memtable() noexcept { ++_stats.rows_processed_from_memtable; }
     void on_row_dropped_from_memtable() noexcept { ++_stats.rows_dropped_from_memtable; }
     void on_row_merged_from_memtable() noexcept { ++_stats.rows_merged_from_memtable; }
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/with_scheduling_group.hh>
+
+#include "db/cache_warmer.hh"
+#include "db/config.hh"
+#include "db/data_listeners.hh"
+#include "db/system_keyspace.hh"
+#include "replica/database.hh"
+#include "log.hh"
+
+namespace db {
+
+static logging::logger cwlogger("cache_warmer");
+
+// The number of save periods a saved partition is kept for if it is not
+// hot anymore
+static constexpr int saved_periods = 3;
+
+// The number of rows read from a warmed up partition
+static constexpr uint64_t warmup_row_limit = 1000;
+
+cache_warmer::cache_warmer(replica::database& db, system_keyspace& sys_ks)
+        : _db(db)
+        , _sys_ks(sys_ks)
+        , _save_period_in_s(db.get_config().cache_warmup_save_period_in_s)
+        , _reads_per_second(db.get_config().cache_warmup_reads_per_second)
+        , _save_timer([this] {
+            (void)with_gate(_gate, [this] {
+                return save().handle_exception([] (std::exception_ptr ep) {
+                    cwlogger.warn("Failed to save the hot partitions: {}", ep);
+                }).finally([this] {
+                    arm_save_timer();
+                });
+            });
+        }) {
+}
+
+std::chrono::seconds cache_warmer::save_period() const {
+    return std::chrono::seconds(_save_period_in_s());
+}
+
+void cache_warmer::arm_save_timer() {
+    if (_as.abort_requested()) {
+        return;
+    }
+    // Check again in a minute if saving is disabled, it's live-updatable
+    _save_timer.arm(save_period().count() ? save_period() : std::chrono::seconds(60));
+}
+
+future<> cache_warmer::save() {
+    auto period = save_period();
+    auto* tracker = _db.hot_partitions();
+    if (!period.count() || !tracker) {
+        co_return;
+    }
+    std::unordered_map<table_id, std::vector<partition_key>> keys;
+    for (auto& r : tracker->last_window().read) {
+        keys[r.item.schema->id()].push_back(r.item.key.key());
+    }
+    for (auto& [id, table_keys] : keys) {
+        if (_db.column_family_exists(id)) {
+            co_await _sys_ks.save_cache_warmup_keys(id, table_keys, period * saved_periods);
+        }
+    }
+}
+
+future<> cache_warmer::warm_up() {
+    std::vector<std::pair<table_id, partition_key>> keys;
+    co_await _sys_ks.get_cache_warmup_keys([&] (table_id id, partition_key key) -> future<> {
+        keys.emplace_back(id, std::move(key));
+        return make_ready_future<>();
+    });
+    cwlogger.debug("Warming up the cache with {} saved partitions", keys.size());
+    for (auto& [id, key] : keys) {
+        if (_as.abort_requested()) {
+            break;
+        }
+        auto rate = _reads_per_second();
+        if (!rate) {
+            break;
+        }
+        if (!_db.column_family_exists(id)) {
+            continue;
+        }
+        auto& table = _db.find_column_family(id);
+        auto s = table.schema();
+        auto dk = dht::decorate_key(*s, key);
+        if (table.shard_of(dk.token()) != this_shard_id()) {
+            continue;
+        }
+        auto cmd = query::read_command(s->id(), s->version(), s->full_slice(),
+                _db.get_unlimited_query_max_result_size(), query::tombstone_limit::max, query::row_limit(warmup_row_limit));
+        auto ranges = dht::partition_range_vector{dht::partition_range::make_singular(std::move(dk))};
+        try {
+            co_await _db.query(s, cmd, query::result_options::only_result(), ranges, {}, db::no_timeout);
+            ++_warmed_partitions;
+        } catch (...) {
+            cwlogger.debug("Failed to warm up a partition of {}.{}: {}", s->ks_name(), s->cf_name(), std::current_exception());
+        }
+        try {
+            co_await sleep_abortable(std::chrono::microseconds(1'000'000 / rate), _as);
+        } catch (const sleep_aborted&) {
+            break;
+        }
+    }
+    cwlogger.info("Warmed up the cache with {} saved partitions", _warmed_partitions);
+}
+
+future<> cache_warmer::start() {
+    arm_save_timer();
+    (void)with_gate(_gate, [this] {
+        return with_scheduling_group(_db.get_streaming_scheduling_group(), [this] {
+            return warm_up();
+        }).handle_exception([] (std::exception_ptr ep) {
+            cwlogger.warn("Failed to warm up the cache: {}", ep);
+        });
+    });
+    return make_ready_future<>();
+}
+
+future<> cache_warmer::stop() {
+    _as.request_abort();
+    _save_timer.cancel();
+    co_await _gate.close();
+}
+
+} // namespace db
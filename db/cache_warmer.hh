@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+#include "utils/updateable_value.hh"
+
+using namespace seastar;
+
+namespace replica {
+class database;
+}
+
+namespace db {
+
+class system_keyspace;
+
+// Brings the row cache of a restarted node back to its hit rate quickly.
+//
+// Every save period, each shard saves the partitions found hottest for
+// reads by the hot_partitions_tracker into system.cache_warmup. Saved
+// partitions expire after a few periods unless they are still hot. On
+// startup, each shard reads the saved partitions it owns in the streaming
+// scheduling group, at most reads_per_second of them per second, which
+// populates the cache with them.
+class cache_warmer : public peering_sharded_service<cache_warmer> {
+    replica::database& _db;
+    system_keyspace& _sys_ks;
+    utils::updateable_value<uint32_t> _save_period_in_s;
+    utils::updateable_value<uint32_t> _reads_per_second;
+    timer<lowres_clock> _save_timer;
+    abort_source _as;
+    gate _gate;
+    uint64_t _warmed_partitions = 0;
+private:
+    std::chrono::seconds save_period() const;
+    void arm_save_timer();
+    future<> save();
+    future<> warm_up();
+public:
+    cache_warmer(replica::database& db, system_keyspace& sys_ks);
+
+    // Starts saving the hot partitions periodically, and warming up the
+    // cache with the saved ones in the background.
+    future<> start();
+    future<> stop();
+
+    uint64_t warmed_partitions() const { return _warmed_partitions; }
+};
+
+} // namespace db
@@ -33,6 +33,7 @@
 #include <seastar/core/chunked_fifo.hh>
 #include <seastar/core/queue.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/switch_to.hh>
@@ -47,12 +48,14 @@
 #include "db/extensions.hh"
 #include "utils/data_input.hh"
 #include "utils/crc.hh"
+#include "utils/fragment_range.hh"
 #include "utils/runtime.hh"
 #include "utils/flush_queue.hh"
 #include "log.hh"
 #include "commitlog_entry.hh"
 #include "commitlog_extensions.hh"
 #include "serializer.hh"
+#include "compress.hh"
 
 #include <boost/range/numeric.hpp>
 #include <boost/range/adaptor/transformed.hpp>
@@ -105,9 +108,11 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.commitlog_total_space_in_mb = cfg.commitlog_total_space_in_mb() >= 0 ? cfg.commitlog_total_space_in_mb() : (shard_available_memory * smp::count) >> 20;
     c.commitlog_segment_size_in_mb = cfg.commitlog_segment_size_in_mb();
     c.commitlog_sync_period_in_ms = cfg.commitlog_sync_period_in_ms();
+    c.batch_group_commit_window = std::chrono::microseconds(cfg.commitlog_batch_group_commit_window_in_us());
     c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
     c.extensions = &cfg.extensions();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.use_compression = cfg.commitlog_use_compression();
     c.allow_going_over_size_limit = !cfg.commitlog_use_hard_size_limit();
 
     if (cfg.commitlog_flush_threshold_in_mb() >= 0) {
@@ -214,9 +219,20 @@ struct db::commitlog::entry_writer {
      */
     virtual size_t size(segment&, size_t) = 0;
 
-    /* write nth entry */
+    /**
+     * write nth entry
+     * Must not change the segment: it may be called for an entry which
+     * eventually does not go into it (compressed segments serialize entries
+     * before knowing whether they fit), see added().
+     */
     virtual void write(segment&, output&, size_t) const = 0;
 
+    /**
+     * Called once the nth entry is committed to the segment buffer, to record
+     * in the segment what the entry carries (i.e. schema).
+     */
+    virtual void added(segment&, size_t) {}
+
     /** the resulting rp_handle for writing a given entry */
     virtual void result(size_t, rp_handle) = 0;
 };
@@ -378,6 +394,12 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         uint64_t requests_blocked_memory = 0;
         uint64_t blocked_on_new_segment = 0;
         uint64_t active_allocations = 0;
+        uint64_t group_commits = 0;
+        uint64_t group_commit_entries = 0;
+        uint64_t group_commit_wait_us = 0;
+        uint64_t compression_input_bytes = 0;
+        uint64_t compression_output_bytes = 0;
+        uint64_t compression_time_us = 0;
     };
 
     class scope_increment_counter {
@@ -403,6 +425,27 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         return _request_controller.waiters();
     }
 
+    // Moving average of the number of writes sharing a batch sync.
+    double group_commit_batch_size = 1;
+
+    // Group commit is adaptive: a batch sync is only delayed when there
+    // is someone to share it with, i.e. other allocations are in flight, or
+    // recent syncs were shared by several writes.
+    //
+    // In periodic mode, only the force_sync writes (e.g. those of the tables
+    // that are always synced, like system.paxos, which every LWT writes to a
+    // few times) sync, and they are grouped the same way.
+    bool should_open_group_commit_window() const {
+        return cfg.batch_group_commit_window.count() > 0
+            && (totals.active_allocations > 1 || group_commit_batch_size >= 1.5);
+    }
+    void account_group_commit(uint64_t entries, std::chrono::microseconds waited) {
+        ++totals.group_commits;
+        totals.group_commit_entries += entries;
+        totals.group_commit_wait_us += waited.count();
+        group_commit_batch_size = 0.8 * group_commit_batch_size + 0.2 * entries;
+    }
+
     future<> begin_flush() {
         ++totals.pending_flushes;
         if (totals.pending_flushes >= cfg.max_active_flushes) {
@@ -696,6 +739,14 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
     std::unordered_set<table_schema_version> _known_schema_versions;
 
+    // Batch mode group commit window. While open, batch syncs wait
+    // on it instead of issuing a write each.
+    using group_commit_clock = std::chrono::steady_clock;
+    std::optional<shared_promise<with_clock<db::timeout_clock>>> _group_commit;
+    timer<group_commit_clock> _group_commit_timer;
+    group_commit_clock::time_point _group_commit_start;
+    uint64_t _group_commit_entries = 0;
+
     friend std::ostream& operator<<(std::ostream&, const segment&);
     friend class segment_manager;
 
@@ -731,6 +782,12 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     static constexpr uint32_t segment_magic = ('S'<<24) |('C'<< 16) | ('L' << 8) | 'C';
     static constexpr uint32_t multi_entry_size_magic = 0xffffffff;
 
+    // Format byte of entries in compressed (version 3) segments.
+    enum class entry_format : uint8_t {
+        raw = 0,
+        lz4 = 1,
+    };
+
     // The commit log (chained) sync marker/header size in bytes (int: length + int: checksum [segmentId, position])
     static constexpr size_t sync_marker_size = 2 * sizeof(uint32_t);
 
@@ -741,6 +798,7 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             : _segment_manager(std::move(m)), _desc(std::move(d)), _file(std::move(f)),
         _alignment(alignment),
         _sync_time(clock_type::now()), _pending_ops(true) // want exception propagation
+        , _group_commit_timer([this] { close_group_commit_window(); })
     {
         ++_segment_manager->totals.segments_created;
         clogger.debug("Created new segment {}", *this);
@@ -1066,6 +1124,35 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         co_return me;
     }
 
+    void close_group_commit_window() {
+        if (!_group_commit) {
+            return;
+        }
+        _group_commit_timer.cancel();
+        auto waited = std::chrono::duration_cast<std::chrono::microseconds>(group_commit_clock::now() - _group_commit_start);
+        _segment_manager->account_group_commit(_group_commit_entries, waited);
+        _group_commit->set_value();
+        _group_commit = std::nullopt;
+    }
+
+    // Delays a batch sync until the group commit window ends, so that writes
+    // arriving meanwhile are written and flushed together with ours.
+    // The first write to arrive opens the window and does the sync once it
+    // closes, the others find the buffer already cycled.
+    future<> wait_for_group_commit(timeout_clock::time_point timeout) {
+        if (!_group_commit) {
+            if (!_segment_manager->should_open_group_commit_window() || buffer_position() >= default_size) {
+                return make_ready_future<>();
+            }
+            _group_commit.emplace();
+            _group_commit_start = group_commit_clock::now();
+            _group_commit_entries = 0;
+            _group_commit_timer.arm(_segment_manager->cfg.batch_group_commit_window);
+        }
+        ++_group_commit_entries;
+        return _group_commit->get_shared_future(timeout);
+    }
+
     future<sseg_ptr> batch_cycle(timeout_clock::time_point timeout) {
         /**
          * For batch mode we force a write "immediately".
@@ -1079,6 +1166,9 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         auto fp = _file_pos;
         try {
             co_await _pending_ops.wait_for_pending(timeout);
+            if (fp == _file_pos) {
+                co_await wait_for_group_commit(timeout);
+            }
             if (fp != _file_pos) {
                 // some other request already wrote this buffer.
                 // If so, wait for the operation at our intended file offset
@@ -1117,6 +1207,39 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         });
     }
 
+    bool compressed() const {
+        return _desc.ver >= descriptor::segment_version_3;
+    }
+
+    // Serializes an entry for a compressed segment: a format byte followed
+    // by either the raw entry, or the output of the LZ4 compressor (which
+    // starts with the uncompressed length) if that is smaller.
+    temporary_buffer<char> encode_entry(entry_writer& writer, size_t entry, size_t entry_size) {
+        auto raw = fragmented_temporary_buffer::allocate_to_fit(entry_size);
+        auto raw_out = raw.get_ostream();
+        auto entry_out = raw_out.write_substream(entry_size);
+        writer.write(*this, entry_out, entry);
+
+        auto start = std::chrono::steady_clock::now();
+        const auto& lz4 = *compressor::lz4;
+        temporary_buffer<char> res(1 + std::max(entry_size, lz4.compress_max_size(entry_size)));
+        auto len = with_linearized(fragmented_temporary_buffer::view(raw), [&] (bytes_view bv) {
+            auto in = reinterpret_cast<const char*>(bv.data());
+            auto clen = lz4.compress(in, bv.size(), res.get_write() + 1, res.size() - 1);
+            if (clen < bv.size()) {
+                res.get_write()[0] = char(entry_format::lz4);
+                return clen + 1;
+            }
+            res.get_write()[0] = char(entry_format::raw);
+            std::copy_n(in, bv.size(), res.get_write() + 1);
+            return bv.size() + 1;
+        });
+        res.trim(len);
+
+        _segment_manager->totals.compression_time_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        return res;
+    }
+
     enum class write_result {
         ok,
         must_sync,
@@ -1134,7 +1257,24 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             return write_result::must_sync;
         }
 
-        const auto size = writer.size(*this);
+        auto size = writer.size(*this);
+
+        // Compressed segments need the encoded entries up front, since
+        // their size is what goes into the headers. Encoding has no effect
+        // on the segment, so the entries can still be refused below, and
+        // retried, possibly in another segment.
+        std::vector<temporary_buffer<char>> encoded;
+        const auto raw_size = size;
+        if (compressed()) {
+            encoded.reserve(writer.num_entries);
+            size = 0;
+            for (size_t entry = 0; entry < writer.num_entries; ++entry) {
+                auto entry_size = writer.num_entries == 1 ? raw_size : writer.size(*this, entry);
+                encoded.emplace_back(encode_entry(writer, entry, entry_size));
+                size += encoded.back().size();
+            }
+        }
+
         const auto s = size + writer.num_entries * entry_overhead_size + (writer.num_entries > 1 ? multi_entry_overhead_size : 0u); // total size
 
         _segment_manager->sanity_check_size(s);
@@ -1150,6 +1290,9 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
                 return write_result::must_sync;
             }
             background_cycle();
+            // The new chunk starts without known schema versions, which the
+            // sizes above depend on.
+            return allocate(writer, permit, timeout);
         }
 
         size_t buf_memory = s;
@@ -1190,7 +1333,8 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         for (size_t entry = 0; entry < writer.num_entries; ++entry) {
             replay_position rp(_desc.id, position());
             auto id = writer.id(entry);
-            auto entry_size = writer.num_entries == 1 ? size : writer.size(*this, entry);
+            auto entry_size = compressed() ? encoded[entry].size()
+                : writer.num_entries == 1 ? size : writer.size(*this, entry);
             auto es = entry_size + entry_overhead_size;
 
             _cf_dirty[id]++; // increase use count for cf.
@@ -1204,12 +1348,18 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             write<uint32_t>(out, crc.checksum());
 
             // actual data
-            auto entry_out = out.write_substream(entry_size);
-            auto entry_data = entry_out.to_input_stream();
-            writer.write(*this, entry_out, entry);
-            entry_data.with_stream([&] (auto data_str) {
-                crc.process_fragmented(ser::buffer_view<typename std::vector<temporary_buffer<char>>::iterator>(data_str));
-            });
+            if (compressed()) {
+                auto& data = encoded[entry];
+                out.write(data.get(), data.size());
+                crc.process_bytes(data.get(), data.size());
+            } else {
+                auto entry_out = out.write_substream(entry_size);
+                auto entry_data = entry_out.to_input_stream();
+                writer.write(*this, entry_out, entry);
+                entry_data.with_stream([&] (auto data_str) {
+                    crc.process_fragmented(ser::buffer_view<typename std::vector<temporary_buffer<char>>::iterator>(data_str));
+                });
+            }
 
             auto checksum = crc.checksum();
             write<uint32_t>(out, checksum);
@@ -1217,6 +1367,7 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
                 mecrc->process(checksum);
             }
 
+            writer.added(*this, entry);
             writer.result(entry, std::move(h));
         }
 
@@ -1225,10 +1376,19 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             write<uint32_t>(out, mecrc->checksum());
         }
 
+        if (compressed()) {
+            _segment_manager->totals.compression_input_bytes += raw_size;
+            _segment_manager->totals.compression_output_bytes += size;
+        }
+
         ++_segment_manager->totals.allocation_count;
         ++_num_allocs;
 
         if (_segment_manager->cfg.mode == sync_mode::BATCH || writer.sync) {
+            // Enough data gathered, no point in delaying the sync any longer.
+            if (buffer_position() >= default_size) {
+                close_group_commit_window();
+            }
             return write_result::ok_need_batch_sync;
         } else {
             // If this buffer alone is too big, potentially bigger than the maximum allowed size,
@@ -1581,6 +1741,24 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
 
         sm::make_gauge("active_allocations", totals.active_allocations,
                        sm::description("Current number of active allocations.")),
+
+        sm::make_counter("group_commits", totals.group_commits,
+                       sm::description("Counts number of batch mode syncs delayed by a group commit window.")),
+
+        sm::make_counter("group_commit_entries", totals.group_commit_entries,
+                       sm::description("Counts number of writes which shared a group commit. Divided by group_commits gives the average batch size.")),
+
+        sm::make_counter("compression_input_bytes", totals.compression_input_bytes,
+                       sm::description("Counts number of entry bytes passed to compression in compressed segments.")),
+
+        sm::make_counter("compression_output_bytes", totals.compression_output_bytes,
+                       sm::description("Counts number of bytes written for entries in compressed segments. Divided by compression_input_bytes gives the compression ratio.")),
+
+        sm::make_counter("compression_time_us", totals.compression_time_us,
+                       sm::description("Total time in microseconds spent compressing commitlog entries.")),
+
+        sm::make_counter("group_commit_wait_us", totals.group_commit_wait_us,
+                       sm::description("Total time in microseconds syncs spent waiting in a group commit window.")),
     });
 }
 
@@ -1774,7 +1952,7 @@ future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager:
 
 future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::allocate_segment() {
     for (;;) {
-        descriptor d(next_id(), cfg.fname_prefix);
+        descriptor d(next_id(), cfg.fname_prefix, cfg.use_compression ? descriptor::segment_version_3 : descriptor::segment_version_2);
         auto dst = filename(d);
         auto flags = open_flags::wo;
         if (cfg.use_o_dsync) {
@@ -2376,11 +2554,13 @@ future<db::rp_handle> db::commitlog::add_entry(const cf_id_type& id, const commi
         size_t size() const override {
             return _writer.mutation_size();
         }
-        void write(segment& seg, output& out, size_t) const override {
+        void write(segment&, output& out, size_t) const override {
+            _writer.write(out);
+        }
+        void added(segment& seg, size_t) override {
             if (_writer.with_schema()) {
                 seg.add_schema_version(_writer.schema());
             }
-            _writer.write(out);
         }
         void result(size_t, rp_handle h) override {
             res = std::move(h);
@@ -2413,6 +2593,8 @@ db::commitlog::add_entries(std::vector<commitlog_entry_writer> entry_writers, db
         }
         size_t size(segment& seg) override {
             size_t res = 0;
+            // Only the versions of the entries of this segment count, it may be a retry.
+            _known.clear();
             for (auto i = _writers.begin(), e = _writers.end(); i != e; ++i) {
                 auto known = seg.is_schema_version_known(i->schema());
                 if (!known) {
@@ -2434,12 +2616,14 @@ db::commitlog::add_entries(std::vector<commitlog_entry_writer> entry_writers, db
                 return w.mutation_size() + acc;
             });
         }
-        void write(segment& seg, output& out, size_t i) const override {
+        void write(segment&, output& out, size_t i) const override {
+            _writers.at(i).write(out);
+        }
+        void added(segment& seg, size_t i) override {
             auto& w = _writers.at(i);
             if (w.with_schema()) {
                 seg.add_schema_version(w.schema());
             }
-            w.write(out);
         }
         void result(size_t i, rp_handle h) override {
             assert(i == res.size());
@@ -2825,9 +3009,49 @@ db::commitlog::read_log_file(sstring filename, sstring pfx, commit_load_reader_f
                 co_return;
             }
 
+            if (d.ver >= descriptor::segment_version_3) {
+                try {
+                    buf = decode_entry(std::move(buf));
+                } catch (...) {
+                    clogger.debug("Segment entry at {} could not be decoded: {}. Skipping {} bytes", rp, std::current_exception(), size);
+                    corrupt_size += size;
+                    co_return;
+                }
+            }
+
             co_await pf({std::move(buf), rp}, checksum);
         }
 
+        static fragmented_temporary_buffer decode_entry(fragmented_temporary_buffer buf) {
+            if (buf.empty()) {
+                throw std::runtime_error("missing entry format");
+            }
+            auto ef = segment::entry_format(uint8_t(fragmented_temporary_buffer::view(buf).current_fragment().front()));
+            switch (ef) {
+            case segment::entry_format::raw:
+                buf.remove_prefix(1);
+                return buf;
+            case segment::entry_format::lz4:
+                return with_linearized(fragmented_temporary_buffer::view(buf), [] (bytes_view bv) {
+                    bv.remove_prefix(1);
+                    if (bv.size() < 4) {
+                        throw std::runtime_error("truncated compressed entry");
+                    }
+                    auto in = reinterpret_cast<const char*>(bv.data());
+                    auto len = read_le<uint32_t>(in);
+                    temporary_buffer<char> out(len);
+                    auto n = compressor::lz4->uncompress(in, bv.size(), out.get_write(), out.size());
+                    if (n != len) {
+                        throw std::runtime_error(format("compressed entry size mismatch: {} != {}", n, len));
+                    }
+                    std::vector<temporary_buffer<char>> frags;
+                    frags.emplace_back(std::move(out));
+                    return fragmented_temporary_buffer(std::move(frags), len);
+                });
+            }
+            throw std::runtime_error(format("unknown entry format {}", int(ef)));
+        }
+
         future<> read_file() {
             std::exception_ptr p;
             try {
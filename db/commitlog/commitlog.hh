@@ -96,6 +96,10 @@ class commitlog {
         std::optional<uint64_t> commitlog_flush_threshold_in_mb = {};
         uint64_t commitlog_segment_size_in_mb = 32;
         uint64_t commitlog_sync_period_in_ms = 10 * 1000; //TODO: verify default!
+        // Max time a batch mode sync, or the sync of a force_sync write in
+        // periodic mode, may be delayed to let concurrent writes join it.
+        // Zero disables group commit.
+        std::chrono::microseconds batch_group_commit_window{0};
         // Max number of segments to keep in pre-alloc reserve.
         // Not (yet) configurable from scylla.conf.
         uint64_t max_reserve_segments = 12;
@@ -107,6 +111,8 @@ class commitlog {
         std::string fname_prefix = descriptor::FILENAME_PREFIX;
 
         bool use_o_dsync = false;
+        // Write new segments in the compressed (version 3) format.
+        bool use_compression = false;
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = true;
 
@@ -133,6 +139,8 @@ class commitlog {
 
         static inline constexpr uint32_t segment_version_1 = 1u;
         static inline constexpr uint32_t segment_version_2 = 2u;
+        // Entry data is prefixed with a format byte and may be LZ4 compressed.
+        static inline constexpr uint32_t segment_version_3 = 3u;
 
         descriptor(descriptor&&) noexcept = default;
         descriptor(const descriptor&) = default;
@@ -15,6 +15,9 @@
 
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/loop.hh>
 
 #include "commitlog.hh"
 #include "commitlog_replayer.hh"
@@ -26,6 +29,7 @@
 #include "schema/schema_registry.hh"
 #include "commitlog_entry.hh"
 #include "db/extensions.hh"
+#include "db/config.hh"
 #include "utils/fragmented_temporary_buffer.hh"
 #include "validation.hh"
 #include "mutation/mutation_partition_view.hh"
@@ -190,20 +194,42 @@ db::commitlog_replayer::impl::recover(sstring file, const sstring& fname_prefix)
         p = gp.pos;
     }
 
-    auto s = make_lw_shared<stats>();
+    // Entries are decoded and applied in the background, so that reading
+    // the segment is not held up by the latency of applying each mutation
+    // (which usually means a cross-shard hop). Replay order does not matter,
+    // mutations are commutative. The semaphore bounds the memory held by
+    // entries in flight.
+    struct replay_state {
+        stats s;
+        semaphore in_flight;
+        gate pending;
+
+        explicit replay_state(size_t concurrency) : in_flight(concurrency) {}
+    };
+    auto concurrency = std::max<size_t>(_db.local().get_config().commitlog_replay_mutation_concurrency(), 1);
+    auto st = make_lw_shared<replay_state>(concurrency);
     auto& exts = _db.local().extensions();
 
-    return db::commitlog::read_log_file(file, fname_prefix,
-            std::bind(&impl::process, this, s.get(), std::placeholders::_1),
-            p, &exts).then_wrapped([s](future<> f) {
-        try {
-            f.get();
-        } catch (commitlog::segment_data_corruption_error& e) {
-            s->corrupt_bytes += e.bytes();
-        } catch (...) {
-            throw;
-        }
-        return make_ready_future<stats>(*s);
+    auto func = [this, st] (commitlog::buffer_and_replay_position buf_rp) {
+        return get_units(st->in_flight, 1).then([this, st, buf_rp = std::move(buf_rp)] (auto units) mutable {
+            // process() handles its own errors, so the background future never fails.
+            (void)with_gate(st->pending, [this, st, buf_rp = std::move(buf_rp), units = std::move(units)] () mutable {
+                return process(&st->s, std::move(buf_rp)).finally([units = std::move(units)] {});
+            });
+        });
+    };
+
+    return db::commitlog::read_log_file(file, fname_prefix, std::move(func), p, &exts).then_wrapped([st](future<> f) {
+        return st->pending.close().then([st, f = std::move(f)] () mutable {
+            try {
+                f.get();
+            } catch (commitlog::segment_data_corruption_error& e) {
+                st->s.corrupt_bytes += e.bytes();
+            } catch (...) {
+                throw;
+            }
+            return make_ready_future<stats>(st->s);
+        });
     });
 }
 
@@ -339,14 +365,17 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
             return map_reduce(smp::all_cpus(), [this, map, &fname_prefix] (unsigned id) {
                 return smp::submit_to(id, [this, id, map, &fname_prefix] () {
                     auto total = ::make_lw_shared<impl::stats>();
-                    // TODO: or something. For now, we do this serialized per shard,
-                    // to reduce mutation congestion. We could probably (says avi)
-                    // do 2 segments in parallel or something, but lets use this first.
                     auto range = map->equal_range(id);
-                    return do_for_each(range.first, range.second, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
+                    auto segments = std::distance(range.first, range.second);
+                    auto replayed = ::make_lw_shared<size_t>(0);
+                    // Segments are replayed a few at a time per shard: enough to keep the
+                    // disk busy while mutations are being applied, without flooding the
+                    // memtables of all shards at once.
+                    auto concurrency = std::max<size_t>(_impl->_db.local().get_config().commitlog_replay_segment_concurrency(), 1);
+                    return max_concurrent_for_each(range.first, range.second, concurrency, [this, total, replayed, segments, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
                         auto&f = p.second;
                         rlogger.debug("Replaying {}", f);
-                        return _impl->recover(f, fname_prefix).then([f, total](impl::stats stats) {
+                        return _impl->recover(f, fname_prefix).then([f, total, replayed, segments](impl::stats stats) {
                             if (stats.corrupt_bytes != 0) {
                                 rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
                             }
@@ -357,6 +386,8 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
                                             , stats.skipped_mutations
                             );
                             *total += stats;
+                            ++*replayed;
+                            rlogger.info("Replayed {} of {} segments on this shard, {} mutations so far", *replayed, segments, total->applied_mutations);
                         });
                     }).then([total] {
                         return make_ready_future<impl::stats>(*total);
@@ -328,6 +328,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "true: auto-adjust memtable shares for flush processes")
     , memtable_flush_static_shares(this, "memtable_flush_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the memtable shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity")
+    , memtable_flush_parallelism(this, "memtable_flush_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+        "Maximum number of sstables a single large memtable is flushed into concurrently, each covering a contiguous slice of the memtable's token range. The writers are interleaved on the owning shard, so this overlaps their I/O rather than adding CPU. A memtable is split only into pieces of at least 64MB. Set to 1 to flush each memtable through a single writer.")
     , compaction_static_shares(this, "compaction_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity")
     , compaction_enforce_min_threshold(this, "compaction_enforce_min_threshold", liveness::LiveUpdate, value_status::Used, false,
@@ -425,6 +427,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , compaction_throughput_mb_per_sec(this, "compaction_throughput_mb_per_sec", liveness::LiveUpdate, value_status::Used, 0,
         "Throttles compaction to the specified total throughput across the entire system. The faster you insert data, the faster you need to compact in order to keep the SSTable count down. The recommended Value is 16 to 32 times the rate of write throughput (in MBs/second). Setting the value to 0 disables compaction throttling.\n"
         "Related information: Configuring compaction")
+    , compaction_subrange_parallelism(this, "compaction_subrange_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+        "Split major, cleanup and upgrade compactions into up to this many token ranges (rounded down to a power of two), compacted concurrently on the shard, so a single large compaction can use idle CPU and disk bandwidth. Ranges are not made smaller than 1 GB of input on average. The compactions still run in the scheduling group of the job. Setting the value to 1 disables splitting.")
+    , compaction_leveled_parallelism(this, "compaction_leveled_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+        "Maximum number of regular compactions run concurrently on a shard for a table using LeveledCompactionStrategy. Concurrent compactions are picked so that their token ranges don't overlap, which keeps the levels non-overlapping. Size-tiered compactions of L0 are not limited by the token ranges of the other compactions. Setting the value to 1 runs one compaction at a time for the table.")
+    , compaction_latency_target_us(this, "compaction_latency_target_us", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, scale down the compaction shares chosen by the backlog controller while the scheduling latency of the statement scheduling group exceeds this many microseconds, and let them recover while it doesn't. The shares are never scaled below 10% of the controller's output. Has no effect if compaction_static_shares is set.")
     , compaction_large_partition_warning_threshold_mb(this, "compaction_large_partition_warning_threshold_mb", liveness::LiveUpdate, value_status::Used, 1000,
         "Log a warning when writing partitions larger than this value")
     , compaction_large_row_warning_threshold_mb(this, "compaction_large_row_warning_threshold_mb", liveness::LiveUpdate, value_status::Used, 10,
@@ -457,6 +465,13 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Adjusts the sensitivity of the failure detector on an exponential scale. Generally this setting never needs adjusting.\n"
         "Related information: Failure detection and recovery")
     , failure_detector_timeout_in_ms(this, "failure_detector_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 20 * 1000, "Maximum time between two successful echo message before gossip mark a node down in milliseconds.\n")
+    , direct_failure_detector_read_replica_selection(this, "direct_failure_detector_read_replica_selection", liveness::LiveUpdate, value_status::Used, false,
+        "If set to true, reads avoid the replicas which the direct failure detector suspects to be dead, before gossip marks them down. "
+        "The suspected replicas are still used if the consistency level needs them. Writes aren't affected. Requires consistent_cluster_management.")
+    , direct_failure_detector_min_threshold_in_ms(this, "direct_failure_detector_min_threshold_in_ms", value_status::Used, 500,
+        "Shortest time without a response to the direct failure detector's pings after which a node is suspected to be dead, "
+        "see direct_failure_detector_read_replica_selection. The threshold adapts to the variance of the response times of each node, up to 1 second. "
+        "Should be longer than the reactor stalls of the nodes.")
     /* Performance tuning properties */
     /* Tuning performance and system reso   urce utilization, including commit log, compaction, memory, disk I/O, CPU, reads, and writes. */
     /* Commit log settings */
@@ -475,6 +490,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Note: does not exist on the listing page other than in above comment, wtf? */
     , commitlog_sync_batch_window_in_ms(this, "commitlog_sync_batch_window_in_ms", value_status::Used, 10000,
         "Controls how long the system waits for other writes before performing a sync in \"batch\" mode.")
+    , commitlog_batch_group_commit_window_in_us(this, "commitlog_batch_group_commit_window_in_us", value_status::Used, 0,
+        "Upper bound, in microseconds, on how long a sync in \"batch\" mode, or the sync of a write to a table that is always synced (like system.paxos, written to by every lightweight transaction) in \"periodic\" mode, may be delayed so that concurrent writes can share it (group commit). "
+        "The window is only opened when other writes are in flight or recent syncs were shared, so an idle node is not slowed down. 0 disables grouping.")
     , commitlog_total_space_in_mb(this, "commitlog_total_space_in_mb", value_status::Used, -1,
         "Total space used for commitlogs. If the used space goes above this value, Scylla rounds up to the next nearest segment multiple and flushes memtables to disk for the oldest commitlog segments, removing those log segments. This reduces the amount of data to replay on startup, and prevents infrequently-updated tables from indefinitely keeping commitlog segments. A small total commitlog space tends to cause more flush activity on less-active tables.\n"
         "Related information: Configuring memtable throughput")
@@ -485,8 +503,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Threshold for commitlog disk usage. When used disk space goes above this value, Scylla initiates flushes of memtables to disk for the oldest commitlog segments, removing those log segments. Adjusting this affects disk usage vs. write latency. Default is (approximately) commitlog_total_space_in_mb - <num shards>*commitlog_segment_size_in_mb.")
     , commitlog_use_o_dsync(this, "commitlog_use_o_dsync", value_status::Used, true,
         "Whether or not to use O_DSYNC mode for commitlog segments IO. Can improve commitlog latency on some file systems.\n")
+    , commitlog_use_compression(this, "commitlog_use_compression", value_status::Used, false,
+        "Whether or not to LZ4 compress commitlog entries. Reduces commitlog disk bandwidth for compressible data at the cost of CPU. Segments written with compression cannot be replayed by versions which do not support it.\n")
     , commitlog_use_hard_size_limit(this, "commitlog_use_hard_size_limit", value_status::Used, false,
         "Whether or not to use a hard size limit for commitlog disk usage. Default is false. Enabling this can cause latency spikes, whereas the default can lead to occasional disk usage peaks.\n")
+    , commitlog_replay_segment_concurrency(this, "commitlog_replay_segment_concurrency", value_status::Used, 4,
+        "Number of commitlog segments each shard replays concurrently on startup.")
+    , commitlog_replay_mutation_concurrency(this, "commitlog_replay_mutation_concurrency", value_status::Used, 128,
+        "Maximum number of mutations from a single commitlog segment being applied concurrently during replay.")
     /* Compaction settings */
     /* Related information: Configuring compaction */
     , compaction_preheat_key_cache(this, "compaction_preheat_key_cache", value_status::Unused, true,
@@ -539,6 +563,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Throttles all streaming file transfer between the data centers. This setting allows throttles streaming throughput betweens data centers in addition to throttling all network stream traffic as configured with stream_throughput_outbound_megabits_per_sec.")
     , stream_io_throughput_mb_per_sec(this, "stream_io_throughput_mb_per_sec", liveness::LiveUpdate, value_status::Used, 0,
         "Throttles streaming I/O to the specified total throughput (in MiBs/s) across the entire system. Streaming I/O includes the one performed by repair and both RBNO and legacy topology operations such as adding or removing a node. Setting the value to 0 disables stream throttling")
+    , enable_sstable_file_streaming(this, "enable_sstable_file_streaming", liveness::LiveUpdate, value_status::Used, false,
+        "Stream sstables whose data falls entirely in the streamed ranges by shipping their files as they are, rather than by reading and re-writing their contents. Other sstables and memtables are streamed as usual. Only used if all nodes support it.")
     , trickle_fsync(this, "trickle_fsync", value_status::Unused, false,
         "When doing sequential writing, enabling this option tells fsync to force the operating system to flush the dirty buffers at a set interval trickle_fsync_interval_in_kb. Enable this parameter to avoid sudden dirty buffer flushing from impacting read latencies. Recommended to use on SSDs, but not on HDDs.")
     , trickle_fsync_interval_in_kb(this, "trickle_fsync_interval_in_kb", value_status::Unused, 10240,
@@ -601,8 +627,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Counter caches properties */
     /* Counter cache helps to reduce counter locks' contention for hot counter cells. In case of RF = 1 a counter cache hit will cause Cassandra to skip the read before write entirely. With RF > 1 a counter cache hit will still help to reduce the duration of the lock hold, helping with hot counter cell updates, but will not allow skipping the read entirely. Only the local (clock, count) tuple of a counter cell is kept in memory, not the whole counter, so it's relatively cheap. */
     /* Note: Reducing the size counter cache may result in not getting the hottest keys loaded on start-up. */
-    , counter_cache_size_in_mb(this, "counter_cache_size_in_mb", value_status::Unused, 0,
-        "When no value is specified a minimum of 2.5% of Heap or 50MB. If you perform counter deletes and rely on low gc_grace_seconds, you should disable the counter cache. To disable, set to 0")
+    , counter_cache_size_in_mb(this, "counter_cache_size_in_mb", value_status::Used, 0,
+        "The memory, in megabytes and shared by all shards, of the cache of the local shards of the recently updated counters, which saves counter updates the read before write. "
+        "Disabled (0) by default. If you perform counter deletes and rely on low gc_grace_seconds, you should keep the counter cache disabled.")
     , counter_cache_save_period(this, "counter_cache_save_period", value_status::Unused, 7200,
         "Duration after which Cassandra should save the counter cache (keys only). Caches are saved to saved_caches_directory.")
     , counter_cache_keys_to_save(this, "counter_cache_keys_to_save", value_status::Unused, 0,
@@ -625,11 +652,19 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The time that the coordinator waits for counter writes to complete.")
     , cas_contention_timeout_in_ms(this, "cas_contention_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 1000,
         "The time that the coordinator continues to retry a CAS (compare and set) operation that contends with other proposals for the same row.")
+    , cas_background_learn(this, "cas_background_learn", liveness::LiveUpdate, value_status::Used, true,
+        "Reply to a CAS (compare and set) operation as soon as a quorum of replicas accepted its proposal, and commit the proposal in the background, "
+        "when its commit consistency is ANY or it changes nothing (a failed condition or a SERIAL read). "
+        "Saves a round trip to the replicas; SERIAL reads see the accepted proposal either way.")
     , truncate_request_timeout_in_ms(this, "truncate_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 60000,
         "The time that the coordinator waits for truncates (remove all data from a table) to complete. The long default value allows for a snapshot to be taken before removing the data. If auto_snapshot is disabled (not recommended), you can reduce this time.")
     , write_request_timeout_in_ms(this, "write_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 2000,
         "The time in milliseconds that the coordinator waits for write operations to complete.\n"
         "Related information: About hinted handoff writes")
+    , write_batching_window_in_us(this, "write_batching_window_in_us", liveness::LiveUpdate, value_status::Used, 0,
+        "The time in microseconds that the coordinator waits for more mutations to send to the same replica, "
+        "so that they are sent in a single message. Reduces the messaging overhead of many small writes, "
+        "at the cost of adding up to this delay to their latency. 0 disables batching.")
     , request_timeout_in_ms(this, "request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 10000,
         "The default timeout for other, miscellaneous operations.\n"
         "Related information: About hinted handoff writes")
@@ -654,8 +689,15 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\tall: All traffic is compressed.\n"
         "\tdc : Traffic between data centers is compressed.\n"
         "\tnone : No compression.")
+    , internode_compression_gossip(this, "internode_compression_gossip", value_status::Used, true,
+        "Whether internode_compression also applies to the connections for gossip and other cluster management messages. "
+        "These messages are small and rare, so compressing them saves little traffic for the CPU it costs. "
+        "The connections for data, streaming and repair messages are compressed as set by internode_compression.")
     , inter_dc_tcp_nodelay(this, "inter_dc_tcp_nodelay", value_status::Used, false,
         "Enable or disable tcp_nodelay for inter-data center communication. When disabled larger, but fewer, network packets are sent. This reduces overhead from the TCP protocol itself. However, if cross data-center responses are blocked, it will increase latency.")
+    , internode_shard_aware_connections(this, "internode_shard_aware_connections", value_status::Used, false,
+        "Open a connection to each shard of the other nodes, so that the requests for a partition are received by the shard "
+        "which owns it, without a cross-shard hop. Multiplies the number of internode connections by the number of shards.")
     , streaming_socket_timeout_in_ms(this, "streaming_socket_timeout_in_ms", value_status::Unused, 0,
         "Enable or disable socket timeout for streaming operations. When a timeout occurs during streaming, streaming is retried from the start of the current file. Avoid setting this value too low, as it can result in a significant amount of data re-streaming.")
     /* Native transport (CQL Binary Protocol) */
@@ -707,6 +749,19 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\tYour own RPC server: You must provide a fully-qualified class name of an o.a.c.t.TServerFactory that can create a server instance.")
     , cache_hit_rate_read_balancing(this, "cache_hit_rate_read_balancing", value_status::Used, true,
         "This boolean controls whether the replicas for read query will be choosen based on cache hit ratio")
+    , latency_aware_read_balancing(this, "latency_aware_read_balancing", liveness::LiveUpdate, value_status::Used, false,
+        "This boolean controls whether the replicas for single partition read queries will be choosen, among those of the local datacenter, "
+        "based on their recent read latency and the number of reads this coordinator has in flight to them. "
+        "When enabled, it takes precedence over cache_hit_rate_read_balancing for these queries.")
+    , speculative_retry_budget_percent(this, "speculative_retry_budget_percent", liveness::LiveUpdate, value_status::Used, 10,
+        "The maximum number of speculative reads sent by the tables with the ADAPTIVE speculative_retry, as a percentage of their reads. "
+        "It keeps speculative reads from amplifying the load of a cluster which is slow because it is overloaded.")
+    , read_repair_defer_unreturned_partitions(this, "read_repair_defer_unreturned_partitions", liveness::LiveUpdate, value_status::Used, false,
+        "When a read finds replicas inconsistent, make it wait only for the repair of the partitions it returns. The repair of "
+        "the partitions reconciled beyond its limits is written in the background, so the next read of them may still see them unrepaired.")
+    , read_repair_deferred_concurrency(this, "read_repair_deferred_concurrency", value_status::Used, 16,
+        "The maximum number of deferred read repair writes each shard has in flight. Deferred repairs beyond it are dropped, "
+        "to be repaired by later reads or by repair.")
     /* Advanced fault detection settings */
     /* Settings to handle poorly performing or failing nodes. */
     , dynamic_snitch_badness_threshold(this, "dynamic_snitch_badness_threshold", value_status::Unused, 0,
@@ -720,6 +775,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Related information: About hinted handoff writes")
     , max_hinted_handoff_concurrency(this, "max_hinted_handoff_concurrency", liveness::LiveUpdate, value_status::Used, 0,
         "Maximum concurrency allowed for sending hints. The concurrency is divided across shards and rounded up if not divisible by the number of shards. By default (or when set to 0), concurrency of 8*shard_count will be used.")
+    , max_hinted_handoff_concurrency_per_node(this, "max_hinted_handoff_concurrency_per_node", liveness::LiveUpdate, value_status::Used, 0,
+        "Maximum number of batches of hints being sent concurrently by each shard to a single node, see hinted_handoff_replay_batch_size. 0 means that only max_hinted_handoff_concurrency applies.")
+    , hinted_handoff_replay_batch_size(this, "hinted_handoff_replay_batch_size", liveness::LiveUpdate, value_status::Used, 32,
+        "Maximum number of hints read from a hints file before they are sent, together. The hints of a batch which belong to the same partition are sent as a single mutation. 1 sends the hints one by one.")
+    , hinted_handoff_throughput_mb_per_sec(this, "hinted_handoff_throughput_mb_per_sec", liveness::LiveUpdate, value_status::Used, 0,
+        "Throttles the replay of hints to a single node to the specified total throughput, divided evenly between the shards. Regardless of this setting, the replay slows down when the view update backlog of the node grows. 0 disables throttling.")
+    , hinted_handoff_coalescing_window_in_ms(this, "hinted_handoff_coalescing_window_in_ms", liveness::LiveUpdate, value_status::Used, 10,
+        "The hints to the same partition stored within this window are merged and written as a single hint, reducing the size of the hints files and the replay time of overwrite-heavy workloads. 0 writes each hint as soon as it is stored.")
     , hinted_handoff_throttle_in_kb(this, "hinted_handoff_throttle_in_kb", value_status::Unused, 1024,
         "Maximum throttle per delivery thread in kilobytes per second. This rate reduces proportionally to the number of nodes in the cluster. For example, if there are two nodes in the cluster, each delivery thread will use the maximum rate. If there are three, each node will throttle to half of the maximum, since the two nodes are expected to deliver hints simultaneously.")
     , max_hint_window_in_ms(this, "max_hint_window_in_ms", value_status::Used, 10800000,
@@ -858,12 +921,15 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , experimental(this, "experimental", value_status::Used, false, "[Deprecated] Set to true to unlock all experimental features (except 'raft' feature, which should be enabled explicitly via 'experimental-features' option). Please use 'experimental-features', instead.")
     , experimental_features(this, "experimental_features", value_status::Used, {}, experimental_features_help_string())
     , lsa_reclamation_step(this, "lsa_reclamation_step", value_status::Used, 1, "Minimum number of segments to reclaim in a single step")
+    , lsa_transparent_hugepages(this, "lsa_transparent_hugepages", value_status::Used, false, "Back the memory of the LSA segments, which hold the memtables and the cache, with transparent huge pages, reducing TLB misses in the lookups of large caches. Requires transparent huge pages to be enabled in the kernel, in 'madvise' or 'always' mode.")
     , prometheus_port(this, "prometheus_port", value_status::Used, 9180, "Prometheus port, set to zero to disable")
     , prometheus_address(this, "prometheus_address", value_status::Used, {/* listen_address */}, "Prometheus listening address, defaulting to listen_address if not explicitly set")
     , prometheus_prefix(this, "prometheus_prefix", value_status::Used, "scylla", "Set the prefix of the exported Prometheus metrics. Changing this will break Scylla's dashboard compatibility, do not change unless you know what you are doing.")
     , abort_on_lsa_bad_alloc(this, "abort_on_lsa_bad_alloc", value_status::Used, false, "Abort when allocation in LSA region fails")
     , murmur3_partitioner_ignore_msb_bits(this, "murmur3_partitioner_ignore_msb_bits", value_status::Used, default_murmur3_partitioner_ignore_msb_bits, "Number of most siginificant token bits to ignore in murmur3 partitioner; increase for very large clusters")
     , unspooled_dirty_soft_limit(this, "unspooled_dirty_soft_limit", value_status::Used, 0.6, "Soft limit of unspooled dirty memory expressed as a portion of the hard limit")
+    , unspooled_dirty_predictive_flush(this, "unspooled_dirty_predictive_flush", liveness::LiveUpdate, value_status::Used, true,
+        "Start flushing memtables before unspooled dirty memory reaches the soft limit, when the measured write and flush rates predict it would be reached before a flush of the largest memtable completes. This reduces write latency spikes when ingestion ramps up")
     , sstable_summary_ratio(this, "sstable_summary_ratio", value_status::Used, 0.0005, "Enforces that 1 byte of summary is written for every N (2000 by default) "
         "bytes written to data file. Value must be between 0 and 1.")
     , large_memory_allocation_warning_threshold(this, "large_memory_allocation_warning_threshold", value_status::Used, size_t(1) << 20, "Warn about memory allocations above this size; set to zero to disable")
@@ -875,12 +941,41 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Used, true, "Enable cpu scheduling")
     , view_building(this, "view_building", value_status::Used, true, "Enable view building; should only be set to false when the node is experience issues due to view building")
+    , view_update_read_coalescing_window_in_us(this, "view_update_read_coalescing_window_in_us", liveness::LiveUpdate, value_status::Used, 0,
+        "The time in microseconds that a write to a table with materialized views waits for other writes to the same partition, "
+        "so that they read the existing base rows they need to generate view updates in a single read. "
+        "Reduces the read load of bulk ingestion into such tables, at the cost of adding up to this delay to the write latency. 0 disables coalescing.")
+    , view_building_concurrency(this, "view_building_concurrency", liveness::LiveUpdate, value_status::Used, 1,
+        "The number of batches of base rows, of consecutive token ranges, each shard turns into view updates concurrently while building materialized views.")
+    , view_building_throughput_mb_per_sec(this, "view_building_throughput_mb_per_sec", liveness::LiveUpdate, value_status::Used, 0,
+        "Throttles the reads of base tables by view building to the specified total throughput across the node, in megabytes per second. 0 disables throttling.")
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , enable_sstables_md_format(this, "enable_sstables_md_format", value_status::Unused, true, "Enable SSTables 'md' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , sstable_format(this, "sstable_format", value_status::Used, "me", "Default sstable file format", {"md", "me"})
     , uuid_sstable_identifiers_enabled(this,
             "uuid_sstable_identifiers_enabled", liveness::LiveUpdate, value_status::Used, true, "If set to true, each newly created sstable will have a UUID "
             "based generation identifier, and such files are not readable by previous Scylla versions.")
+    , split_block_bloom_filter_enabled(this, "split_block_bloom_filter_enabled", value_status::Used, false,
+            "If set to true, once all nodes in the cluster enable it, newly written sstables will use a split-block bloom filter, "
+            "which needs a single cache line access per lookup. Such files are not readable by previous Scylla versions.")
+    , enable_sstable_compression_dictionary_training(this, "enable_sstable_compression_dictionary_training", liveness::LiveUpdate, value_status::Used, false,
+            "For tables compressed with ZstdCompressor, once all nodes in the cluster enable it, train a compression dictionary from samples "
+            "of compaction output and use it for subsequent compactions. Improves the compression ratio of small chunks. The dictionary is "
+            "stored in CompressionInfo.db, and such files are not readable by previous Scylla versions.")
+    , enable_sstable_compression_chunk_length_tuning(this, "enable_sstable_compression_chunk_length_tuning", liveness::LiveUpdate, value_status::Used, false,
+            "For compressed tables which don't set chunk_length_in_kb, write new sstables with the chunk length closest to the median "
+            "size of the reads of the table's sstables, within sstable_compression_chunk_length_min_in_kb and sstable_compression_chunk_length_max_in_kb. "
+            "Smaller chunks waste less decompression on small reads, larger ones compress better.")
+    , sstable_compression_chunk_length_min_in_kb(this, "sstable_compression_chunk_length_min_in_kb", liveness::LiveUpdate, value_status::Used, 4,
+            "Smallest compression chunk length picked by enable_sstable_compression_chunk_length_tuning.")
+    , sstable_compression_chunk_length_max_in_kb(this, "sstable_compression_chunk_length_max_in_kb", liveness::LiveUpdate, value_status::Used, 64,
+            "Largest compression chunk length picked by enable_sstable_compression_chunk_length_tuning.")
+    , sstable_scan_buffer_size_in_kb(this, "sstable_scan_buffer_size_in_kb", liveness::LiveUpdate, value_status::Used, 512,
+            "Size of the reads issued by sequential scans of sstable data files, such as range scans and compaction. "
+            "Scans adapt the size of their reads down from this when they skip over data. "
+            "Set to 0 to read scans like other reads, with 128KB buffers.")
+    , sstable_scan_read_ahead(this, "sstable_scan_read_ahead", liveness::LiveUpdate, value_status::Used, 4,
+            "Number of reads kept in flight ahead of the reader by sequential scans of sstable data files.")
     , enable_dangerous_direct_import_of_cassandra_counters(this, "enable_dangerous_direct_import_of_cassandra_counters", value_status::Used, false, "Only turn this option on if you want to import tables from Cassandra containing counters, and you are SURE that no counters in that table were created in a version earlier than Cassandra 2.1."
         " It is not enough to have ever since upgraded to newer versions of Cassandra. If you EVER used a version earlier than 2.1 in the cluster where these SSTables come from, DO NOT TURN ON THIS OPTION! You will corrupt your data. You have been warned.")
     , enable_shard_aware_drivers(this, "enable_shard_aware_drivers", value_status::Used, true, "Enable native transport drivers to use connection-per-shard for better performance")
@@ -892,6 +987,24 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , max_clustering_key_restrictions_per_query(this, "max_clustering_key_restrictions_per_query", liveness::LiveUpdate, value_status::Used, 100,
             "Maximum number of distinct clustering key restrictions per query. This limit places a bound on the size of IN tuples, "
             "especially when multiple clustering key columns have IN restrictions. Increasing this value can result in server instability.")
+    , hot_partitions_sampling_ratio(this, "hot_partitions_sampling_ratio", liveness::LiveUpdate, value_status::Used, 100,
+            "One in how many writes and single-partition reads are sampled to track the hottest partitions of each shard, "
+            "see /storage_service/hot_partitions/ in the REST API. 0 disables the tracking.")
+    , cache_warmup_save_period_in_s(this, "cache_warmup_save_period_in_s", liveness::LiveUpdate, value_status::Used, 300,
+            "How often each shard saves its hottest partitions for reads to system.cache_warmup, to read them into the cache "
+            "when the node restarts. Saved partitions expire after three periods unless saved again. 0 disables saving.")
+    , cache_warmup_reads_per_second(this, "cache_warmup_reads_per_second", liveness::LiveUpdate, value_status::Used, 100,
+            "How many of the saved hot partitions each shard reads per second, in the streaming scheduling group, "
+            "to warm up the cache after a restart. 0 disables the warm-up.")
+    , cache_unprepared_statements(this, "cache_unprepared_statements", liveness::LiveUpdate, value_status::Used, true,
+            "Whether the SELECT and data modification statements of unprepared queries are kept prepared, by query string and "
+            "session keyspace, so repeating a query doesn't parse and prepare it again. The cache is emptied on every schema change.")
+    , query_results_cache_size_in_mb(this, "query_results_cache_size_in_mb", liveness::LiveUpdate, value_status::Used, 16,
+            "The memory, per shard, of the cache of the results of prepared SELECT statements, for the tables with a non-zero "
+            "'results_ttl_in_ms' caching option. 0 disables the cache.")
+    , per_partition_rate_limit_tracked_partitions(this, "per_partition_rate_limit_tracked_partitions", value_status::Used, 1 << 16,
+            "How many partitions each shard can count operations of at the same time, for per-partition rate limits. "
+            "Rounded up to a power of two, at least 2048. Each one takes 16 bytes of memory.")
     , max_memory_for_unlimited_query_soft_limit(this, "max_memory_for_unlimited_query_soft_limit", liveness::LiveUpdate, value_status::Used, uint64_t(1) << 20,
             "Maximum amount of memory a query, whose memory consumption is not naturally limited, is allowed to consume, e.g. non-paged and reverse queries. "
             "This is the soft limit, there will be a warning logged for queries violating this limit.")
@@ -906,6 +1019,16 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "The maximum number of compaction windows allowed when making use of TimeWindowCompactionStrategy. A setting of 0 effectively disables the restriction.")
     , initial_sstable_loading_concurrency(this, "initial_sstable_loading_concurrency", value_status::Used, 4u,
             "Maximum amount of sstables to load in parallel during initialization. A higher number can lead to more memory consumption. You should not need to touch this")
+    , defer_bloom_filter_loading(this, "defer_bloom_filter_loading", value_status::Used, false,
+            "Open the sstables found at startup without their bloom filters, and load the filters in the background once the tables are populated, "
+            "at most initial_sstable_loading_concurrency at a time on each shard. Shortens startup with many sstables, at the cost of single-partition "
+            "reads touching every sstable until the filters are loaded.")
+    , bloom_filter_memory_threshold(this, "bloom_filter_memory_threshold", liveness::LiveUpdate, value_status::Used, 0.2,
+            "Fraction of the shard's memory the bloom filters of its sstables may use. Above it, the largest filters are dropped and single-partition "
+            "reads open their sstables, until sstables are compacted away or deleted and the dropped filters fit again.")
+    , compressed_chunk_cache_size_in_mb(this, "compressed_chunk_cache_size_in_mb", value_status::Used, 0,
+            "The memory for caching decompressed chunks of the data files of compressed tables, divided evenly between the shards. Point reads "
+            "hitting recently read chunks then skip reading and decompressing them again. Zero disables the cache.")
     , enable_3_1_0_compatibility_mode(this, "enable_3_1_0_compatibility_mode", value_status::Used, false,
         "Set to true if the cluster was initially installed from 3.1.0. If it was upgraded from an earlier version,"
         " or installed from a later version, leave this set to false. This adjusts the communication protocol to"
@@ -918,8 +1041,13 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Time period in seconds after which unused schema versions will be evicted from the local schema registry cache. Default is 1 second.")
     , max_concurrent_requests_per_shard(this, "max_concurrent_requests_per_shard", liveness::LiveUpdate, value_status::Used, std::numeric_limits<uint32_t>::max(),
         "Maximum number of concurrent requests a single shard can handle before it starts shedding extra load. By default, no requests will be shed.")
+    , cql_connection_memory_fraction(this, "cql_connection_memory_fraction", value_status::Used, 0.25,
+        "The fraction of the memory a shard reserves for CQL requests that the requests of a single connection can use. Once they use it all, reading from the connection pauses until some of them complete. Set to 1 to only limit the memory of all requests together.")
     , cdc_dont_rewrite_streams(this, "cdc_dont_rewrite_streams", value_status::Used, false,
             "Disable rewriting streams from cdc_streams_descriptions to cdc_streams_descriptions_v2. Should not be necessary, but the procedure is expensive and prone to failures; this config option is left as a backdoor in case some user requires manual intervention.")
+    , cdc_preimage_local_reads(this, "cdc_preimage_local_reads", liveness::LiveUpdate, value_status::Used, false,
+            "When the coordinator of a write to a table with CDC preimage or postimage enabled is a replica of the written partition, read the preimage from the coordinator alone, at consistency level ONE, instead of at the consistency level of the write. "
+            "This saves the round trips to other replicas, but the preimage may miss writes which did not reach the coordinator yet.")
     , strict_allow_filtering(this, "strict_allow_filtering", liveness::LiveUpdate, value_status::Used, strict_allow_filtering_default(), "Match Cassandra in requiring ALLOW FILTERING on slow queries. Can be true, false, or warn. When false, Scylla accepts some slow queries even without ALLOW FILTERING that Cassandra rejects. Warn is same as false, but with warning.")
     , strict_is_not_null_in_views(this, "strict_is_not_null_in_views", liveness::LiveUpdate, value_status::Used,db::tri_mode_restriction_t::mode::WARN, 
         "In materialized views, restrictions are allowed only on the view's primary key columns.\n"
@@ -943,6 +1071,16 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "Make the system.config table UPDATEable")
     , enable_parallelized_aggregation(this, "enable_parallelized_aggregation", liveness::LiveUpdate, value_status::Used, true,
             "Use on a new, parallel algorithm for performing aggregate queries.")
+    , enable_adaptive_paging(this, "enable_adaptive_paging", liveness::LiveUpdate, value_status::Used, false,
+            "Size the pages of paged queries by the measured size and fetch latency of the rows of the previous pages, "
+            "instead of by the page size requested by the client alone.")
+    , adaptive_paging_target_page_size_in_kb(this, "adaptive_paging_target_page_size_in_kb", liveness::LiveUpdate, value_status::Used, 512,
+            "With enable_adaptive_paging, the amount of data a page aims to contain.")
+    , adaptive_paging_target_page_latency_in_ms(this, "adaptive_paging_target_page_latency_in_ms", liveness::LiveUpdate, value_status::Used, 100,
+            "With enable_adaptive_paging, the time fetching a page aims to take.")
+    , adaptive_paging_max_page_size_factor(this, "adaptive_paging_max_page_size_factor", liveness::LiveUpdate, value_status::Used, 1,
+            "With enable_adaptive_paging, how many times the page size requested by the client a page may contain, when rows are small and fast to fetch. "
+            "The default, 1, only ever makes pages smaller than requested.")
     , alternator_port(this, "alternator_port", value_status::Used, 0, "Alternator API port")
     , alternator_https_port(this, "alternator_https_port", value_status::Used, 0, "Alternator API HTTPS port")
     , alternator_address(this, "alternator_address", value_status::Used, "0.0.0.0", "Alternator API listening address")
@@ -954,6 +1092,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , alternator_ttl_period_in_seconds(this, "alternator_ttl_period_in_seconds", value_status::Used,
         60*60*24,
         "The default period for Alternator's expiration scan. Alternator attempts to scan every table within that period.")
+    , alternator_ttl_scan_max_skipped_periods(this, "alternator_ttl_scan_max_skipped_periods", liveness::LiveUpdate, value_status::Used, 3,
+        "The maximum number of consecutive expiration scan periods in which a table is not scanned because its previous scans found almost no expired items. "
+        "Set to 0 to scan every table in every period.")
     , abort_on_ebadf(this, "abort_on_ebadf", value_status::Used, true, "Abort the server on incorrect file descriptor access. Throws exception when disabled.")
     , redis_port(this, "redis_port", value_status::Used, 0, "Port on which the REDIS transport listens for clients.")
     , redis_ssl_port(this, "redis_ssl_port", value_status::Used, 0, "Port on which the REDIS TLS native transport listens for clients.")
@@ -996,6 +1137,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , wasm_udf_memory_limit(this, "wasm_udf_memory_limit", value_status::Used, 2*1024*1024, "How much memory each WASM UDF can allocate at most")
     , relabel_config_file(this, "relabel_config_file", value_status::Used, "", "Optionally, read relabel config from file")
     , object_storage_config_file(this, "object_storage_config_file", value_status::Used, "", "Optionally, read object-storage endpoints config from file")
+    , object_storage_cache_directory(this, "object_storage_cache_directory", value_status::Used, "",
+        "Optionally, cache the blocks read from the data and index files of sstables on object storage in files in this local directory, one per shard. Persists across restarts.")
+    , object_storage_cache_size_in_mb(this, "object_storage_cache_size_in_mb", value_status::Used, 0,
+        "The total size of the object-storage cache files, divided evenly between the shards. Zero disables the cache.")
     , minimum_keyspace_rf(this, "minimum_keyspace_rf", liveness::LiveUpdate, value_status::Used, 0, "The minimum allowed replication factor when creating or altering a keyspace.")
     , auth_superuser_name(this, "auth_superuser_name", value_status::Used, "", 
         "Initial authentication super username. Ignored if authentication tables already contain a super user")
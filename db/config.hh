@@ -164,6 +164,7 @@ class config : public utils::config_file {
     named_value<double> background_writer_scheduling_quota;
     named_value<bool> auto_adjust_flush_quota;
     named_value<float> memtable_flush_static_shares;
+    named_value<uint32_t> memtable_flush_parallelism;
     named_value<float> compaction_static_shares;
     named_value<bool> compaction_enforce_min_threshold;
     named_value<sstring> cluster_name;
@@ -185,6 +186,9 @@ class config : public utils::config_file {
     named_value<bool> rpc_interface_prefer_ipv6;
     named_value<seed_provider_type> seed_provider;
     named_value<uint32_t> compaction_throughput_mb_per_sec;
+    named_value<uint32_t> compaction_subrange_parallelism;
+    named_value<uint32_t> compaction_leveled_parallelism;
+    named_value<uint32_t> compaction_latency_target_us;
     named_value<uint32_t> compaction_large_partition_warning_threshold_mb;
     named_value<uint32_t> compaction_large_row_warning_threshold_mb;
     named_value<uint32_t> compaction_large_cell_warning_threshold_mb;
@@ -198,15 +202,21 @@ class config : public utils::config_file {
     named_value<bool> snapshot_before_compaction;
     named_value<uint32_t> phi_convict_threshold;
     named_value<uint32_t> failure_detector_timeout_in_ms;
+    named_value<bool> direct_failure_detector_read_replica_selection;
+    named_value<uint32_t> direct_failure_detector_min_threshold_in_ms;
     named_value<sstring> commitlog_sync;
     named_value<uint32_t> commitlog_segment_size_in_mb;
     named_value<uint32_t> commitlog_sync_period_in_ms;
     named_value<uint32_t> commitlog_sync_batch_window_in_ms;
+    named_value<uint32_t> commitlog_batch_group_commit_window_in_us;
     named_value<int64_t> commitlog_total_space_in_mb;
     named_value<bool> commitlog_reuse_segments; // unused. retained for upgrade compat
     named_value<int64_t> commitlog_flush_threshold_in_mb;
     named_value<bool> commitlog_use_o_dsync;
+    named_value<bool> commitlog_use_compression;
     named_value<bool> commitlog_use_hard_size_limit;
+    named_value<uint32_t> commitlog_replay_segment_concurrency;
+    named_value<uint32_t> commitlog_replay_mutation_concurrency;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
     named_value<uint32_t> in_memory_compaction_limit_in_mb;
@@ -229,6 +239,7 @@ class config : public utils::config_file {
     named_value<uint32_t> stream_throughput_outbound_megabits_per_sec;
     named_value<uint32_t> inter_dc_stream_throughput_outbound_megabits_per_sec;
     named_value<uint32_t> stream_io_throughput_mb_per_sec;
+    named_value<bool> enable_sstable_file_streaming;
     named_value<bool> trickle_fsync;
     named_value<uint32_t> trickle_fsync_interval_in_kb;
     named_value<bool> auto_bootstrap;
@@ -258,14 +269,18 @@ class config : public utils::config_file {
     named_value<uint32_t> read_request_timeout_in_ms;
     named_value<uint32_t> counter_write_request_timeout_in_ms;
     named_value<uint32_t> cas_contention_timeout_in_ms;
+    named_value<bool> cas_background_learn;
     named_value<uint32_t> truncate_request_timeout_in_ms;
     named_value<uint32_t> write_request_timeout_in_ms;
+    named_value<uint32_t> write_batching_window_in_us;
     named_value<uint32_t> request_timeout_in_ms;
     named_value<bool> cross_node_timeout;
     named_value<uint32_t> internode_send_buff_size_in_bytes;
     named_value<uint32_t> internode_recv_buff_size_in_bytes;
     named_value<sstring> internode_compression;
+    named_value<bool> internode_compression_gossip;
     named_value<bool> inter_dc_tcp_nodelay;
+    named_value<bool> internode_shard_aware_connections;
     named_value<uint32_t> streaming_socket_timeout_in_ms;
     named_value<bool> start_native_transport;
     named_value<uint16_t> native_transport_port;
@@ -284,11 +299,19 @@ class config : public utils::config_file {
     named_value<uint32_t> rpc_send_buff_size_in_bytes;
     named_value<sstring> rpc_server_type;
     named_value<bool> cache_hit_rate_read_balancing;
+    named_value<bool> latency_aware_read_balancing;
+    named_value<uint32_t> speculative_retry_budget_percent;
+    named_value<bool> read_repair_defer_unreturned_partitions;
+    named_value<uint32_t> read_repair_deferred_concurrency;
     named_value<double> dynamic_snitch_badness_threshold;
     named_value<uint32_t> dynamic_snitch_reset_interval_in_ms;
     named_value<uint32_t> dynamic_snitch_update_interval_in_ms;
     named_value<hinted_handoff_enabled_type> hinted_handoff_enabled;
     named_value<uint32_t> max_hinted_handoff_concurrency;
+    named_value<uint32_t> max_hinted_handoff_concurrency_per_node;
+    named_value<uint32_t> hinted_handoff_replay_batch_size;
+    named_value<uint32_t> hinted_handoff_throughput_mb_per_sec;
+    named_value<uint32_t> hinted_handoff_coalescing_window_in_ms;
     named_value<uint32_t> hinted_handoff_throttle_in_kb;
     named_value<uint32_t> max_hint_window_in_ms;
     named_value<uint32_t> max_hints_delivery_threads;
@@ -339,12 +362,14 @@ class config : public utils::config_file {
     named_value<bool> experimental;
     named_value<std::vector<enum_option<experimental_features_t>>> experimental_features;
     named_value<size_t> lsa_reclamation_step;
+    named_value<bool> lsa_transparent_hugepages;
     named_value<uint16_t> prometheus_port;
     named_value<sstring> prometheus_address;
     named_value<sstring> prometheus_prefix;
     named_value<bool> abort_on_lsa_bad_alloc;
     named_value<unsigned> murmur3_partitioner_ignore_msb_bits;
     named_value<double> unspooled_dirty_soft_limit;
+    named_value<bool> unspooled_dirty_predictive_flush;
     named_value<double> sstable_summary_ratio;
     named_value<size_t> large_memory_allocation_warning_threshold;
     named_value<bool> enable_deprecated_partitioners;
@@ -353,22 +378,41 @@ class config : public utils::config_file {
     named_value<bool> enable_sstable_key_validation;
     named_value<bool> cpu_scheduler;
     named_value<bool> view_building;
+    named_value<uint32_t> view_update_read_coalescing_window_in_us;
+    named_value<uint32_t> view_building_concurrency;
+    named_value<uint32_t> view_building_throughput_mb_per_sec;
     named_value<bool> enable_sstables_mc_format;
     named_value<bool> enable_sstables_md_format;
     named_value<sstring> sstable_format;
     named_value<bool> uuid_sstable_identifiers_enabled;
+    named_value<bool> split_block_bloom_filter_enabled;
+    named_value<bool> enable_sstable_compression_dictionary_training;
+    named_value<bool> enable_sstable_compression_chunk_length_tuning;
+    named_value<uint32_t> sstable_compression_chunk_length_min_in_kb;
+    named_value<uint32_t> sstable_compression_chunk_length_max_in_kb;
+    named_value<uint32_t> sstable_scan_buffer_size_in_kb;
+    named_value<uint32_t> sstable_scan_read_ahead;
     named_value<bool> enable_dangerous_direct_import_of_cassandra_counters;
     named_value<bool> enable_shard_aware_drivers;
     named_value<bool> enable_ipv6_dns_lookup;
     named_value<bool> abort_on_internal_error;
     named_value<uint32_t> max_partition_key_restrictions_per_query;
     named_value<uint32_t> max_clustering_key_restrictions_per_query;
+    named_value<uint32_t> hot_partitions_sampling_ratio;
+    named_value<uint32_t> cache_warmup_save_period_in_s;
+    named_value<uint32_t> cache_warmup_reads_per_second;
+    named_value<bool> cache_unprepared_statements;
+    named_value<uint32_t> query_results_cache_size_in_mb;
+    named_value<uint32_t> per_partition_rate_limit_tracked_partitions;
     named_value<uint64_t> max_memory_for_unlimited_query_soft_limit;
     named_value<uint64_t> max_memory_for_unlimited_query_hard_limit;
     named_value<uint32_t> reader_concurrency_semaphore_serialize_limit_multiplier;
     named_value<uint32_t> reader_concurrency_semaphore_kill_limit_multiplier;
     named_value<uint32_t> twcs_max_window_count;
     named_value<unsigned> initial_sstable_loading_concurrency;
+    named_value<bool> defer_bloom_filter_loading;
+    named_value<double> bloom_filter_memory_threshold;
+    named_value<uint64_t> compressed_chunk_cache_size_in_mb;
     named_value<bool> enable_3_1_0_compatibility_mode;
     named_value<bool> enable_user_defined_functions;
     named_value<unsigned> user_defined_function_time_limit_ms;
@@ -376,13 +420,19 @@ class config : public utils::config_file {
     named_value<unsigned> user_defined_function_contiguous_allocation_limit_bytes;
     named_value<uint32_t> schema_registry_grace_period;
     named_value<uint32_t> max_concurrent_requests_per_shard;
+    named_value<double> cql_connection_memory_fraction;
     named_value<bool> cdc_dont_rewrite_streams;
+    named_value<bool> cdc_preimage_local_reads;
     named_value<tri_mode_restriction> strict_allow_filtering;
     named_value<tri_mode_restriction> strict_is_not_null_in_views;
     named_value<bool> reversed_reads_auto_bypass_cache;
     named_value<bool> enable_optimized_reversed_reads;
     named_value<bool> enable_cql_config_updates;
     named_value<bool> enable_parallelized_aggregation;
+    named_value<bool> enable_adaptive_paging;
+    named_value<uint32_t> adaptive_paging_target_page_size_in_kb;
+    named_value<uint32_t> adaptive_paging_target_page_latency_in_ms;
+    named_value<uint32_t> adaptive_paging_max_page_size_factor;
 
     named_value<uint16_t> alternator_port;
     named_value<uint16_t> alternator_https_port;
@@ -392,6 +442,7 @@ class config : public utils::config_file {
     named_value<uint32_t> alternator_streams_time_window_s;
     named_value<uint32_t> alternator_timeout_in_ms;
     named_value<double> alternator_ttl_period_in_seconds;
+    named_value<uint32_t> alternator_ttl_scan_max_skipped_periods;
 
     named_value<bool> abort_on_ebadf;
 
@@ -434,6 +485,8 @@ class config : public utils::config_file {
     named_value<size_t> wasm_udf_memory_limit;
     named_value<sstring> relabel_config_file;
     named_value<sstring> object_storage_config_file;
+    named_value<sstring> object_storage_cache_directory;
+    named_value<uint64_t> object_storage_cache_size_in_mb;
     // wasm_udf_reserved_memory is static because the options in db::config
     // are parsed using seastar::app_template, while this option is used for
     // configuring the Seastar memory subsystem.
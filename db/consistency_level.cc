@@ -11,8 +11,11 @@
 #include "db/consistency_level.hh"
 #include "db/consistency_level_validations.hh"
 
+#include <functional>
+
 #include <boost/range/algorithm/stable_partition.hpp>
 #include <boost/range/algorithm/find.hpp>
+#include <boost/range/algorithm/remove_if.hpp>
 #include <boost/range/algorithm/transform.hpp>
 #include "exceptions/exceptions.hh"
 #include <seastar/core/sstring.hh>
@@ -238,9 +241,20 @@ filter_for_query(consistency_level cl,
                  read_repair_decision read_repair,
                  const gms::gossiper& g,
                  std::optional<gms::inet_address>* extra,
-                 replica::column_family* cf) {
+                 replica::column_family* cf,
+                 const dht::token* token,
+                 const seastar::noncopyable_function<bool (const gms::inet_address&)>& is_suspected_dead) {
     size_t local_count;
 
+    auto suspected = [&is_suspected_dead] (const gms::inet_address& ep) {
+        return is_suspected_dead && is_suspected_dead(ep);
+    };
+    if (is_suspected_dead) {
+        // The partitions below are stable, so these stay last within the
+        // local and the remote endpoints.
+        boost::range::stable_partition(live_endpoints, std::not_fn(suspected));
+    }
+
     if (read_repair == read_repair_decision::GLOBAL) { // take RRD.GLOBAL out of the way
         return live_endpoints;
     }
@@ -270,8 +284,9 @@ filter_for_query(consistency_level cl,
     // selected this way aren't enough to satisfy CL requirements select the
     // remaining ones according to the load-balancing strategy as before.
     if (!preferred_endpoints.empty()) {
-        const auto it = boost::stable_partition(live_endpoints, [&preferred_endpoints] (const gms::inet_address& a) {
-            return std::find(preferred_endpoints.cbegin(), preferred_endpoints.cend(), a) == preferred_endpoints.end();
+        const auto it = boost::stable_partition(live_endpoints, [&preferred_endpoints, &suspected] (const gms::inet_address& a) {
+            return std::find(preferred_endpoints.cbegin(), preferred_endpoints.cend(), a) == preferred_endpoints.end()
+                    || suspected(a);
         });
         const size_t selected = std::distance(it, live_endpoints.end());
         if (selected >= bf) {
@@ -288,8 +303,18 @@ filter_for_query(consistency_level cl,
 
     const auto remaining_bf = bf - selected_endpoints.size();
 
-    if (cf) {
-        auto get_hit_rate = [&g, cf] (gms::inet_address ep) -> float {
+    // The endpoints suspected to be dead don't take part in the hit-rate
+    // based selection, unless they are needed, in which case they are already
+    // last in `live_endpoints`.
+    inet_address_vector_replica_set healthy_endpoints;
+    if (cf && is_suspected_dead) {
+        healthy_endpoints = live_endpoints;
+        healthy_endpoints.erase(boost::range::remove_if(healthy_endpoints, suspected), healthy_endpoints.end());
+    }
+    const auto& candidates = cf && is_suspected_dead ? healthy_endpoints : live_endpoints;
+
+    if (cf && candidates.size() >= remaining_bf + bool(extra)) {
+        auto get_hit_rate = [&g, cf, token] (gms::inet_address ep) -> float {
             // We limit each nodes' cache-hit ratio to max_hit_rate = 0.95
             // for two reasons:
             // 1. If two nodes have hit rate 0.99 and 0.98, the miss rates
@@ -303,13 +328,20 @@ filter_for_query(consistency_level cl,
             //    its miss rate is 0.05, 1/20th of the worst miss rate 1.0,
             //    so the cold node will get 1/20th the work of the hot.
             constexpr float max_hit_rate = 0.95;
-            auto ht = cf->get_hit_rate(g, ep);
+            // Prefer the hit rate of the range read, which differs between
+            // replicas more than the table's if some of them cache it and
+            // some don't
+            auto ht = token ? cf->get_hit_rate(g, ep, *token) : cf->get_hit_rate(g, ep);
             if (float(ht.rate) < 0) {
                 return float(ht.rate);
             } else if (lowres_clock::now() - ht.last_updated > std::chrono::milliseconds(1000)) {
                 // if a cache entry is not updates for a while try to send traffic there
                 // to get more up to date data, mark it updated to not send to much traffic there
-                cf->set_hit_rate(ep, ht.rate);
+                if (token) {
+                    cf->set_hit_rate(ep, *token, ht.rate);
+                } else {
+                    cf->set_hit_rate(ep, ht.rate);
+                }
                 return max_hit_rate;
             } else {
                 return std::min(float(ht.rate), max_hit_rate); // calculation below cannot work with hit rate 1
@@ -320,7 +352,7 @@ filter_for_query(consistency_level cl,
         float ht_min = 1;
         bool old_node = false;
 
-        auto epi = boost::copy_range<std::vector<std::pair<gms::inet_address, float>>>(live_endpoints | boost::adaptors::transformed([&] (gms::inet_address ep) {
+        auto epi = boost::copy_range<std::vector<std::pair<gms::inet_address, float>>>(candidates | boost::adaptors::transformed([&] (gms::inet_address ep) {
             auto ht = get_hit_rate(ep);
             old_node = old_node || ht < 0;
             ht_max = std::max(ht_max, ht);
@@ -22,6 +22,8 @@
 #include <vector>
 #include <unordered_set>
 
+#include <seastar/util/noncopyable_function.hh>
+
 namespace gms {
 class gossiper;
 };
@@ -30,6 +32,10 @@ namespace locator {
 class effective_replication_map;
 }
 
+namespace dht {
+class token;
+}
+
 namespace db {
 
 extern logging::logger cl_logger;
@@ -46,6 +52,9 @@ size_t block_for(const locator::effective_replication_map& erm, consistency_leve
 
 bool is_datacenter_local(consistency_level l);
 
+// If `is_suspected_dead` is set, the endpoints for which it returns true are
+// picked last, both by the client preference and by the cache hit-rate based
+// selection, so they are only selected if the consistency level needs them.
 inet_address_vector_replica_set
 filter_for_query(consistency_level cl,
                  const locator::effective_replication_map& erm,
@@ -54,7 +63,9 @@ filter_for_query(consistency_level cl,
                  read_repair_decision read_repair,
                  const gms::gossiper& g,
                  std::optional<gms::inet_address>* extra,
-                 replica::column_family* cf);
+                 replica::column_family* cf,
+                 const dht::token* token = nullptr,
+                 const seastar::noncopyable_function<bool (const gms::inet_address&)>& is_suspected_dead = {});
 
 struct dc_node_count {
     size_t live = 0;
@@ -10,6 +10,9 @@
 #include "replica/database.hh"
 #include "readers/filtering.hh"
 #include "db_clock.hh"
+#include "db/system_keyspace.hh"
+
+#include <seastar/core/metrics.hh>
 
 #include <tuple>
 
@@ -152,4 +155,84 @@ future<toppartitions_query::results> toppartitions_query::gather(unsigned res_si
         });
 }
 
+hot_partitions_tracker::hot_partitions_tracker(replica::database& db, utils::updateable_value<uint32_t> sampling_ratio)
+        : _db(db)
+        , _sampling_ratio(std::move(sampling_ratio))
+        , _window_timer([this] { on_window_end(); }) {
+    namespace sm = seastar::metrics;
+    _metrics.add_group("database", {
+        sm::make_gauge("hottest_read_partition_share", [this] { return top_share(_last.read, _last.read_samples); },
+                       sm::description("Share of the sampled single-partition reads of the last window which read the hottest partition of the shard.")),
+        sm::make_gauge("hottest_write_partition_share", [this] { return top_share(_last.write, _last.write_samples); },
+                       sm::description("Share of the sampled writes of the last window which wrote the hottest partition of the shard.")),
+    });
+    _db.data_listeners().install(this);
+    _window_timer.arm_periodic(window);
+}
+
+hot_partitions_tracker::~hot_partitions_tracker() {
+    _db.data_listeners().uninstall(this);
+}
+
+bool hot_partitions_tracker::sample(uint32_t& ops) {
+    auto ratio = _sampling_ratio();
+    if (!ratio || ++ops < ratio) {
+        return false;
+    }
+    ops = 0;
+    return true;
+}
+
+void hot_partitions_tracker::on_window_end() {
+    _last.read = _read.top(capacity);
+    _last.write = _write.top(capacity);
+    _last.read_samples = std::exchange(_read_samples, 0);
+    _last.write_samples = std::exchange(_write_samples, 0);
+    _read = top_k(capacity);
+    _write = top_k(capacity);
+}
+
+double hot_partitions_tracker::top_share(const top_k::results& res, uint64_t samples) {
+    return res.empty() || !samples ? 0 : double(res.front().count) / samples;
+}
+
+flat_mutation_reader_v2 hot_partitions_tracker::on_read(const schema_ptr& s, const dht::partition_range& range,
+        const query::partition_slice& slice, flat_mutation_reader_v2&& rd) {
+    // Only single-partition reads have their key at hand, range scans would
+    // need wrapping the reader.
+    if (range.is_singular() && range.start()->value().has_key() && sample(_reads) && !is_system_keyspace(s->ks_name())) {
+        auto& pos = range.start()->value();
+        _read.append(toppartitions_item_key{s, dht::decorated_key(pos.token(), *pos.key())});
+        ++_read_samples;
+    }
+    return std::move(rd);
+}
+
+void hot_partitions_tracker::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    if (sample(_writes) && !is_system_keyspace(s->ks_name())) {
+        _write.append(toppartitions_item_key{s, m.decorated_key(*s)});
+        ++_write_samples;
+    }
+}
+
+future<toppartitions_query::results> hot_partitions_tracker::gather(distributed<replica::database>& db, unsigned res_size) {
+    auto map = [res_size] (replica::database& db) {
+        top_t rd, wr;
+        if (auto* tracker = db.hot_partitions()) {
+            auto& last = tracker->last_window();
+            auto n = std::min<size_t>(res_size, last.read.size());
+            rd = toppartitions_data_listener::globalize(top_k::results(last.read.begin(), last.read.begin() + n));
+            n = std::min<size_t>(res_size, last.write.size());
+            wr = toppartitions_data_listener::globalize(top_k::results(last.write.begin(), last.write.begin() + n));
+        }
+        return make_foreign(std::make_unique<std::tuple<top_t, top_t>>(std::move(rd), std::move(wr)));
+    };
+    auto reduce = [] (toppartitions_query::results res, foreign_ptr<std::unique_ptr<std::tuple<top_t, top_t>>> rd_wr) {
+        res.read.append(toppartitions_data_listener::localize(std::get<0>(*rd_wr)));
+        res.write.append(toppartitions_data_listener::localize(std::get<1>(*rd_wr)));
+        return res;
+    };
+    return db.map_reduce0(map, toppartitions_query::results{res_size}, reduce);
+}
+
 } // namespace db
@@ -12,12 +12,16 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
 
 #include "utils/hash.hh"
 #include "schema/schema_fwd.hh"
 #include "readers/flat_mutation_reader_v2.hh"
 #include "utils/top_k.hh"
 #include "schema/schema_registry.hh"
+#include "utils/updateable_value.hh"
 
 #include <vector>
 #include <set>
@@ -167,4 +171,54 @@ class toppartitions_query {
     future<results> gather(unsigned results_size = 256);
 };
 
+// Always-on tracker of the hottest partitions of each shard.
+//
+// Unlike toppartitions_data_listener, which counts every operation for the
+// duration of an explicit query, it counts one in sampling_ratio writes and
+// single-partition reads, which keeps its overhead low enough to keep it
+// running. Counts start over every window, the results of the last full
+// window are kept for the metrics and the REST API.
+class hot_partitions_tracker : public data_listener {
+public:
+    using top_k = toppartitions_data_listener::top_k;
+    static constexpr size_t capacity = 256;
+    static constexpr std::chrono::seconds window = std::chrono::seconds(60);
+
+    struct window_results {
+        top_k::results read;
+        top_k::results write;
+        uint64_t read_samples = 0;
+        uint64_t write_samples = 0;
+    };
+private:
+    replica::database& _db;
+    utils::updateable_value<uint32_t> _sampling_ratio;
+    uint32_t _reads = 0;
+    uint32_t _writes = 0;
+    top_k _read{capacity};
+    top_k _write{capacity};
+    uint64_t _read_samples = 0;
+    uint64_t _write_samples = 0;
+    window_results _last;
+    timer<lowres_clock> _window_timer;
+    seastar::metrics::metric_groups _metrics;
+
+    bool sample(uint32_t& ops);
+    void on_window_end();
+    static double top_share(const top_k::results& res, uint64_t samples);
+public:
+    hot_partitions_tracker(replica::database& db, utils::updateable_value<uint32_t> sampling_ratio);
+    ~hot_partitions_tracker();
+
+    virtual flat_mutation_reader_v2 on_read(const schema_ptr& s, const dht::partition_range& range,
+            const query::partition_slice& slice, flat_mutation_reader_v2&& rd) override;
+
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override;
+
+    const window_results& last_window() const { return _last; }
+
+    // Merges the last window results of all shards
+    static future<toppartitions_query::results> gather(distributed<replica::database>& db, unsigned results_size);
+};
+
 } // namespace db
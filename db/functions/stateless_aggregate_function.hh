@@ -5,10 +5,33 @@
 
 #include "scalar_function.hh"
 #include "function_name.hh"
+#include "utils/managed_bytes.hh"
+#include <functional>
+#include <memory>
 #include <optional>
 
 namespace db::functions {
 
+// A native implementation of an aggregate's aggregation function.
+//
+// Rather than calling the aggregation function on the serialized state and
+// input of every row, the inputs are fed to a typed accumulator, which can
+// buffer them and fold them in tight loops. The state is only serialized
+// when it is needed.
+class batch_accumulator {
+public:
+    virtual ~batch_accumulator() = default;
+    // Adds the input of a row; std::nullopt stands for null. Aggregates
+    // with no arguments are passed an empty value.
+    virtual void add(std::optional<managed_bytes_view> input) = 0;
+    // Returns the state, as the aggregation function would have computed it
+    // from the initial state and the inputs added since the last reset().
+    virtual bytes_opt state() = 0;
+    virtual void reset() = 0;
+};
+
+using batch_accumulator_factory = std::function<std::unique_ptr<batch_accumulator>()>;
+
 struct stateless_aggregate_function final {
     function_name name;
     std::optional<sstring> column_name_override; // if unset, column name is synthesized from name and argument names
@@ -30,6 +53,9 @@ struct stateless_aggregate_function final {
     // optional: reduces states computed in parallel
     // signature: (state_type, state_type) -> state_type
     shared_ptr<scalar_function> state_reduction_function;
+
+    // optional: computes the same states as aggregation_function, faster
+    batch_accumulator_factory make_batch_accumulator;
 };
 
 }
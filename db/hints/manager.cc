@@ -71,6 +71,9 @@ void manager::register_metrics(const sstring& group_name) {
         sm::make_counter("written", _stats.written,
                         sm::description("Number of successfully written hints.")),
 
+        sm::make_counter("coalesced", _stats.coalesced,
+                        sm::description("Number of hints merged with an earlier hint to the same partition before being written, see hinted_handoff_coalescing_window_in_ms.")),
+
         sm::make_counter("errors", _stats.errors,
                         sm::description("Number of errors during hints writes.")),
 
@@ -160,7 +163,12 @@ void manager::forbid_hints_for_eps_with_pending_hints() {
     });
 }
 
-sync_point::shard_rps manager::calculate_current_sync_point(const std::vector<gms::inet_address>& target_hosts) const {
+future<sync_point::shard_rps> manager::calculate_current_sync_point(const std::vector<gms::inet_address>& target_hosts) {
+    co_await coroutine::parallel_for_each(target_hosts, [this] (gms::inet_address addr) {
+        auto it = _ep_managers.find(addr);
+        return it != _ep_managers.end() ? it->second.flush_pending_hints() : make_ready_future<>();
+    });
+
     sync_point::shard_rps rps;
     for (auto addr : target_hosts) {
         auto it = _ep_managers.find(addr);
@@ -169,7 +177,7 @@ sync_point::shard_rps manager::calculate_current_sync_point(const std::vector<gm
             rps[ep_man.end_point_key()] = ep_man.last_written_replay_position();
         }
     }
-    return rps;
+    co_return rps;
 }
 
 future<> manager::wait_for_sync_point(abort_source& as, const sync_point::shard_rps& rps) {
@@ -220,37 +228,43 @@ future<> manager::wait_for_sync_point(abort_source& as, const sync_point::shard_
 
 bool manager::end_point_hints_manager::store_hint(schema_ptr s, lw_shared_ptr<const frozen_mutation> fm, tracing::trace_state_ptr tr_state) noexcept {
     try {
-        // Future is waited on indirectly in `stop()` (via `_store_gate`).
-        (void)with_gate(_store_gate, [this, s = std::move(s), fm = std::move(fm), tr_state] () mutable {
-            ++_hints_in_progress;
-            size_t mut_size = fm->representation().size();
-            shard_stats().size_of_hints_in_progress += mut_size;
-
-            return with_shared(file_update_mutex(), [this, fm, s, tr_state] () mutable -> future<> {
-                return get_or_load().then([this, fm = std::move(fm), s = std::move(s), tr_state] (hints_store_ptr log_ptr) mutable {
-                    commitlog_entry_writer cew(s, *fm, db::commitlog::force_sync::no);
-                    return log_ptr->add_entry(s->id(), cew, db::timeout_clock::now() + _shard_manager.hint_file_write_timeout);
-                }).then([this, tr_state] (db::rp_handle rh) {
-                    auto rp = rh.release();
-                    if (_last_written_rp < rp) {
-                        _last_written_rp = rp;
-                        manager_logger.debug("[{}] Updated last written replay position to {}", end_point_key(), rp);
-                    }
-                    ++shard_stats().written;
-
-                    manager_logger.trace("Hint to {} was stored", end_point_key());
-                    tracing::trace(tr_state, "Hint to {} was stored", end_point_key());
-                }).handle_exception([this, tr_state] (std::exception_ptr eptr) {
-                    ++shard_stats().errors;
+        size_t mut_size = fm->representation().size();
+        auto window = std::chrono::milliseconds(_shard_manager.local_db().get_config().hinted_handoff_coalescing_window_in_ms());
+        if (window.count() == 0) {
+            // Future is waited on indirectly in `stop()` (via `_store_gate`).
+            (void)with_gate(_store_gate, [this, s = std::move(s), fm = std::move(fm), tr_state, mut_size] () mutable {
+                ++_hints_in_progress;
+                shard_stats().size_of_hints_in_progress += mut_size;
+                return write_hint(std::move(s), std::move(fm), std::move(tr_state), 1, mut_size);
+            });
+            return true;
+        }
 
-                    manager_logger.debug("store_hint(): got the exception when storing a hint to {}: {}", end_point_key(), eptr);
-                    tracing::trace(tr_state, "Failed to store a hint to {}: {}", end_point_key(), eptr);
-                });
-            }).finally([this, mut_size, fm, s] {
-                --_hints_in_progress;
-                shard_stats().size_of_hints_in_progress -= mut_size;
-            });;
+        auto holder = _store_gate.hold();
+        auto m = fm->unfreeze(s);
+        auto [begin, end] = _pending_hints.equal_range(m.token());
+        auto it = std::find_if(begin, end, [&] (const auto& p) {
+            return p.second.s->version() == s->version() && p.second.m.key().equal(*s, m.key());
         });
+        if (it != end) {
+            it->second.m.apply(std::move(m));
+            ++it->second.hints;
+            it->second.size += mut_size;
+            ++shard_stats().coalesced;
+            tracing::trace(tr_state, "Hint to {} was coalesced with a pending one", end_point_key());
+        } else {
+            if (_pending_hints.empty()) {
+                // The hints stored until the window passes are written together.
+                // Future is waited on indirectly in `stop()` (via `_store_gate`).
+                (void)seastar::sleep(window).then([this] {
+                    return write_pending_hints();
+                }).finally([holder = std::move(holder)] {});
+            }
+            auto token = m.token();
+            _pending_hints.emplace(std::move(token), pending_hint{s, std::move(m), 1, mut_size, tr_state});
+        }
+        ++_hints_in_progress;
+        shard_stats().size_of_hints_in_progress += mut_size;
     } catch (...) {
         manager_logger.trace("Failed to store a hint to {}: {}", end_point_key(), std::current_exception());
         tracing::trace(tr_state, "Failed to store a hint to {}: {}", end_point_key(), std::current_exception());
@@ -261,6 +275,67 @@ bool manager::end_point_hints_manager::store_hint(schema_ptr s, lw_shared_ptr<co
     return true;
 }
 
+future<> manager::end_point_hints_manager::flush_pending_hints() {
+    if (!_pending_hints.empty() && !_store_gate.is_closed()) {
+        // Future is waited on indirectly in `stop()` (via `_store_gate`).
+        (void)with_gate(_store_gate, [this] {
+            return write_pending_hints();
+        });
+    }
+    // The hints being written hold the file update mutex shared, and they
+    // asked for it before, so taking it exclusively waits for them.
+    return with_file_update_mutex(*this, [] {
+        return make_ready_future<>();
+    });
+}
+
+future<> manager::end_point_hints_manager::write_pending_hints() noexcept {
+    auto pending = std::exchange(_pending_hints, {});
+    return parallel_for_each(pending, [this] (auto& p) {
+        auto& h = p.second;
+        lw_shared_ptr<const frozen_mutation> fm;
+        try {
+            fm = make_lw_shared<const frozen_mutation>(freeze(h.m));
+        } catch (...) {
+            manager_logger.trace("Failed to store a hint to {}: {}", end_point_key(), std::current_exception());
+            tracing::trace(h.tr_state, "Failed to store a hint to {}: {}", end_point_key(), std::current_exception());
+            shard_stats().dropped += h.hints;
+            _hints_in_progress -= h.hints;
+            shard_stats().size_of_hints_in_progress -= h.size;
+            return make_ready_future<>();
+        }
+        return write_hint(std::move(h.s), std::move(fm), std::move(h.tr_state), h.hints, h.size);
+    });
+}
+
+future<> manager::end_point_hints_manager::write_hint(schema_ptr s, lw_shared_ptr<const frozen_mutation> fm, tracing::trace_state_ptr tr_state,
+        size_t hints, size_t size) noexcept {
+    return with_shared(file_update_mutex(), [this, fm, s, tr_state] () mutable -> future<> {
+        return get_or_load().then([this, fm = std::move(fm), s = std::move(s), tr_state] (hints_store_ptr log_ptr) mutable {
+            commitlog_entry_writer cew(s, *fm, db::commitlog::force_sync::no);
+            return log_ptr->add_entry(s->id(), cew, db::timeout_clock::now() + _shard_manager.hint_file_write_timeout);
+        }).then([this, tr_state] (db::rp_handle rh) {
+            auto rp = rh.release();
+            if (_last_written_rp < rp) {
+                _last_written_rp = rp;
+                manager_logger.debug("[{}] Updated last written replay position to {}", end_point_key(), rp);
+            }
+            ++shard_stats().written;
+
+            manager_logger.trace("Hint to {} was stored", end_point_key());
+            tracing::trace(tr_state, "Hint to {} was stored", end_point_key());
+        }).handle_exception([this, tr_state] (std::exception_ptr eptr) {
+            ++shard_stats().errors;
+
+            manager_logger.debug("store_hint(): got the exception when storing a hint to {}: {}", end_point_key(), eptr);
+            tracing::trace(tr_state, "Failed to store a hint to {}: {}", end_point_key(), eptr);
+        });
+    }).finally([this, hints, size, fm, s] {
+        _hints_in_progress -= hints;
+        shard_stats().size_of_hints_in_progress -= size;
+    });
+}
+
 future<> manager::end_point_hints_manager::populate_segments_to_replay() {
     return with_lock(file_update_mutex(), [this] {
         return get_or_load().discard_result();
@@ -325,6 +400,7 @@ manager::end_point_hints_manager::end_point_hints_manager(end_point_hints_manage
     , _file_update_mutex(*_file_update_mutex_ptr)
     , _state(other._state)
     , _hints_dir(std::move(other._hints_dir))
+    , _pending_hints(std::move(other._pending_hints))
     , _last_written_rp(other._last_written_rp)
     , _sender(other._sender, *this)
 {}
@@ -859,69 +935,140 @@ future<> manager::end_point_hints_manager::sender::send_one_mutation(frozen_muta
 }
 
 future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
-    return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto units) mutable {
-        ctx_ptr->mark_hint_as_in_progress(rp);
+    ctx_ptr->mark_hint_as_in_progress(rp);
+    bool discarded = false;
+    try {
+        auto m = this->get_mutation(ctx_ptr, buf);
+        gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
+
+        // The hint is too old - drop it.
+        //
+        // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
+        // (last_modification - manager::hints_timer_period) old.
+        if (gc_clock::now().time_since_epoch() - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
+            ctx_ptr->on_hint_send_success(rp);
+            update_sent_upper_bound(*ctx_ptr);
+            co_return;
+        }
 
-        // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
-        (void)with_gate(ctx_ptr->file_send_gate, [this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
-            try {
-                auto m = this->get_mutation(ctx_ptr, buf);
-                gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
-
-                // The hint is too old - drop it.
-                //
-                // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
-                // (last_modification - manager::hints_timer_period) old.
-                if (gc_clock::now().time_since_epoch() - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
-                    return make_ready_future<>();
-                }
+        auto size = m.fm.representation().size();
+        auto it = std::find_if(ctx_ptr->batch.begin(), ctx_ptr->batch.end(), [&] (const send_one_file_ctx::batched_hint& h) {
+            return h.m.s->id() == m.s->id() && h.m.fm.key().equal(*m.s, m.fm.key());
+        });
+        if (it != ctx_ptr->batch.end()) {
+            auto merged = it->m.fm.unfreeze(it->m.s);
+            merged.apply(m.fm.unfreeze(m.s));
+            ctx_ptr->batch_size -= it->m.fm.representation().size();
+            it->m.fm = freeze(merged);
+            it->rps.push_back(rp);
+            size = it->m.fm.representation().size();
+        } else {
+            ctx_ptr->batch.push_back({std::move(m), {rp}});
+        }
+        ctx_ptr->batch_size += size;
+        ++ctx_ptr->batched_hints;
+
+    // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
+    } catch (replica::no_such_column_family& e) {
+        manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
+        discarded = true;
+    } catch (replica::no_such_keyspace& e) {
+        manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
+        discarded = true;
+    } catch (no_column_mapping& e) {
+        manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
+        discarded = true;
+    } catch (...) {
+        manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, std::current_exception());
+        ctx_ptr->on_hint_send_failure(rp);
+        co_return;
+    }
+    if (discarded) {
+        ++this->shard_stats().discarded;
+        ctx_ptr->on_hint_send_success(rp);
+        update_sent_upper_bound(*ctx_ptr);
+        co_return;
+    }
 
-                return this->send_one_mutation(std::move(m)).then([this, ctx_ptr] {
-                    ++this->shard_stats().sent;
-                }).handle_exception([this, ctx_ptr] (auto eptr) {
-                    manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
-                    return make_exception_future<>(std::move(eptr));
-                });
+    const size_t max_batched_hints = std::max(_db.get_config().hinted_handoff_replay_batch_size(), 1u);
+    if (ctx_ptr->batched_hints >= max_batched_hints || ctx_ptr->batch_size >= max_batch_size) {
+        co_await send_batch(std::move(ctx_ptr));
+    }
+}
 
-            // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
-            } catch (replica::no_such_column_family& e) {
-                manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (replica::no_such_keyspace& e) {
-                manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (no_column_mapping& e) {
-                manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
-                ++this->shard_stats().discarded;
-            } catch (...) {
-                auto eptr = std::current_exception();
-                manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, eptr);
-                return make_exception_future<>(std::move(eptr));
-            }
-            return make_ready_future<>();
-        }).then_wrapped([this, units = std::move(units), rp, ctx_ptr] (future<>&& f) {
-            // Information about the error was already printed somewhere higher.
-            // We just need to account in the ctx that sending of this hint has failed.
-            if (!f.failed()) {
-                ctx_ptr->on_hint_send_success(rp);
-                auto new_bound = ctx_ptr->get_replayed_bound();
-                // Segments from other shards are replayed first and are considered to be "before" replay position 0.
-                // Update the sent upper bound only if it is a local segment.
-                if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
-                    _sent_upper_bound_rp = new_bound;
-                    notify_replay_waiters();
-                }
-            } else {
-                ctx_ptr->on_hint_send_failure(rp);
-            }
-            f.ignore_ready_future();
+future<> manager::end_point_hints_manager::sender::send_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr) {
+    if (ctx_ptr->batch.empty()) {
+        co_return;
+    }
+    auto batch = std::exchange(ctx_ptr->batch, {});
+    auto size = std::exchange(ctx_ptr->batch_size, 0);
+    ctx_ptr->batched_hints = 0;
+    auto on_failure = [ctx_ptr] (const send_one_file_ctx::batched_hint& h) {
+        for (auto rp : h.rps) {
+            ctx_ptr->on_hint_send_failure(rp);
+        }
+    };
+
+    std::optional<semaphore_units<named_semaphore::exception_factory>> units;
+    try {
+        auto& cfg = _db.get_config();
+        const uint64_t rate = uint64_t(cfg.hinted_handoff_throughput_mb_per_sec()) * 1024 * 1024 / smp::count;
+        auto delay = _rate_limiter.delay_for(size, rate, _proxy.get_backlog_of(end_point_key()).relative_size());
+        // Draining sends the hints out regardless.
+        if (delay.count() && !draining()) {
+            co_await sleep_abortable(delay, _stop_as);
+        }
+        co_await _batch_sent.wait([this, &cfg] {
+            auto limit = cfg.max_hinted_handoff_concurrency_per_node();
+            return limit == 0 || _batches_in_flight < limit;
         });
-    }).handle_exception([ctx_ptr, rp] (auto eptr) {
-        manager_logger.trace("send_one_file(): Hmmm. Something bad had happend: {}", eptr);
-        ctx_ptr->on_hint_send_failure(rp);
+        units = co_await _resource_manager.get_send_units_for(size);
+    } catch (...) {
+        manager_logger.trace("send_batch(): {} hints to {} not sent: {}", batch.size(), end_point_key(), std::current_exception());
+        for (auto& h : batch) {
+            on_failure(h);
+        }
+        co_return;
+    }
+
+    ++_batches_in_flight;
+    // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
+    (void)with_gate(ctx_ptr->file_send_gate, [this, ctx_ptr, batch = std::move(batch), on_failure] () mutable {
+        return do_with(std::move(batch), [this, ctx_ptr, on_failure] (std::vector<send_one_file_ctx::batched_hint>& batch) {
+            return parallel_for_each(batch, [this, ctx_ptr, on_failure] (send_one_file_ctx::batched_hint& h) {
+                return this->send_one_mutation(std::move(h.m)).then_wrapped([this, ctx_ptr, on_failure, &h] (future<>&& f) {
+                    // Information about the error was already printed somewhere higher.
+                    // We just need to account in the ctx that sending of these hints has failed.
+                    if (f.failed()) {
+                        manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), f.get_exception());
+                        on_failure(h);
+                        return;
+                    }
+                    this->shard_stats().sent += h.rps.size();
+                    for (auto rp : h.rps) {
+                        ctx_ptr->on_hint_send_success(rp);
+                    }
+                });
+            });
+        });
+    }).then_wrapped([this, ctx_ptr, units = std::move(units)] (future<>&& f) {
+        f.ignore_ready_future();
+        update_sent_upper_bound(*ctx_ptr);
+        --_batches_in_flight;
+        _batch_sent.signal();
     });
 }
 
+void manager::end_point_hints_manager::sender::update_sent_upper_bound(const send_one_file_ctx& ctx) noexcept {
+    auto new_bound = ctx.get_replayed_bound();
+    // Segments from other shards are replayed first and are considered to be "before" replay position 0.
+    // Update the sent upper bound only if it is a local segment.
+    if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
+        _sent_upper_bound_rp = new_bound;
+        notify_replay_waiters();
+    }
+}
+
 void manager::end_point_hints_manager::sender::notify_replay_waiters() noexcept {
     if (!_foreign_segments_to_replay.empty()) {
         manager_logger.trace("[{}] notify_replay_waiters(): not notifying because there are still {} foreign segments to replay", end_point_key(), _foreign_segments_to_replay.size());
@@ -1080,6 +1227,17 @@ bool manager::end_point_hints_manager::sender::send_one_file(const sstring& fnam
         ctx_ptr->segment_replay_failed = true;
     }
 
+    // Send the last batch, unless the hints are going to be sent again anyway.
+    if (ctx_ptr->segment_replay_failed && !draining()) {
+        for (auto& h : std::exchange(ctx_ptr->batch, {})) {
+            for (auto rp : h.rps) {
+                ctx_ptr->on_hint_send_failure(rp);
+            }
+        }
+    } else {
+        send_batch(ctx_ptr).get();
+    }
+
     // wait till all background hints sending is complete
     ctx_ptr->file_send_gate.close().get();
 
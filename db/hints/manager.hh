@@ -21,8 +21,11 @@
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/shared_mutex.hh>
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/condition-variable.hh>
 #include "inet_address_vectors.hh"
 #include "db/commitlog/commitlog.hh"
+#include "mutation/frozen_mutation.hh"
+#include "mutation/mutation.hh"
 #include "utils/loading_shared_values.hh"
 #include "db/hints/resource_manager.hh"
 #include "db/hints/host_filter.hh"
@@ -70,6 +73,7 @@ class manager {
     struct stats {
         uint64_t size_of_hints_in_progress = 0;
         uint64_t written = 0;
+        uint64_t coalesced = 0;
         uint64_t errors = 0;
         uint64_t dropped = 0;
         uint64_t sent = 0;
@@ -119,6 +123,16 @@ class manager {
                 std::set<db::replay_position> in_progress_rps;
                 bool segment_replay_failed = false;
 
+                struct batched_hint {
+                    frozen_mutation_and_schema m;
+                    // The hints merged into m, more than one if they belong to the same partition.
+                    utils::small_vector<db::replay_position, 1> rps;
+                };
+                // Hints read from the file and not sent yet, see send_batch().
+                std::vector<batched_hint> batch;
+                size_t batched_hints = 0;
+                size_t batch_size = 0;
+
                 void mark_hint_as_in_progress(db::replay_position rp);
                 void on_hint_send_success(db::replay_position rp) noexcept;
                 void on_hint_send_failure(db::replay_position rp) noexcept;
@@ -151,6 +165,15 @@ class manager {
 
             std::multimap<db::replay_position, lw_shared_ptr<std::optional<promise<>>>> _replay_waiters;
 
+            replay_rate_limiter _rate_limiter;
+            // Batches being sent, limited by max_hinted_handoff_concurrency_per_node.
+            uint32_t _batches_in_flight = 0;
+            seastar::condition_variable _batch_sent;
+
+            // Hints are batched until either hinted_handoff_replay_batch_size
+            // of them or that many bytes are read.
+            static constexpr size_t max_batch_size = 256 * 1024;
+
         public:
             sender(end_point_hints_manager& parent, service::storage_proxy& local_storage_proxy, replica::database& local_db, gms::gossiper& local_gossiper) noexcept;
             ~sender();
@@ -231,8 +254,9 @@ class manager {
             }
 
             /// \brief Try to send one hint read from the file.
-            ///  - Limit the maximum memory size of hints "in the air" and the maximum total number of hints "in the air".
             ///  - Discard the hints that are older than the grace seconds value of the corresponding table.
+            ///  - Add the others to the batch of hints of the file, merging the hints of the same partition,
+            ///    and send the batch once it's full (see send_batch()).
             ///
             /// If sending fails we are going to set the state::segment_replay_failed in the _state and _first_failed_rp will be updated to min(_first_failed_rp, \ref rp).
             ///
@@ -244,6 +268,18 @@ class manager {
             /// \return future that resolves when next hint may be sent
             future<> send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
 
+            /// \brief Send the batch of hints of the file in the background.
+            ///  - Pace the replay according to hinted_handoff_throughput_mb_per_sec and the view update backlog of the destination.
+            ///  - Limit the number of batches "in the air" to the destination (max_hinted_handoff_concurrency_per_node).
+            ///  - Limit the maximum memory size of hints "in the air" and the maximum total number of hints "in the air".
+            ///
+            /// \param ctx_ptr shared pointer to the file sending context
+            /// \return future that resolves when the next batch may be sent
+            future<> send_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr);
+
+            /// \brief Moves _sent_upper_bound_rp forward, if hints of a local segment were replayed up to a higher position.
+            void update_sent_upper_bound(const send_one_file_ctx& ctx) noexcept;
+
             /// \brief Send all hint from a single file and delete it after it has been successfully sent.
             /// Send all hints from the given file. If we failed to send the current segment we will pick up in the next
             /// iteration from where we left in this one.
@@ -332,9 +368,21 @@ class manager {
             state::stopping,
             state::stopped>>;
 
+        // Hints to the same partition stored within hinted_handoff_coalescing_window_in_ms
+        // of each other, merged before they are written.
+        struct pending_hint {
+            schema_ptr s;
+            mutation m;
+            // The number and the total size of the hints merged into m.
+            size_t hints;
+            size_t size;
+            tracing::trace_state_ptr tr_state;
+        };
+
         state_set _state;
         const fs::path _hints_dir;
         uint64_t _hints_in_progress = 0;
+        std::unordered_multimap<dht::token, pending_hint> _pending_hints;
         db::replay_position _last_written_rp;
         sender _sender;
 
@@ -353,12 +401,21 @@ class manager {
         future<hints_store_ptr> get_or_load();
 
         /// \brief Store a single mutation hint.
+        ///
+        /// The hint is merged with the other hints to the same partition stored
+        /// within hinted_handoff_coalescing_window_in_ms, and written with them.
         /// \param s column family descriptor
         /// \param fm frozen mutation object
         /// \param tr_state trace_state handle
         /// \return FALSE if hint is definitely not going to be stored
         bool store_hint(schema_ptr s, lw_shared_ptr<const frozen_mutation> fm, tracing::trace_state_ptr tr_state) noexcept;
 
+        /// \brief Writes the hints coalesced so far without waiting for the coalescing window to pass.
+        ///
+        /// \return Ready future when all the hints stored so far are written, and
+        ///         thus accounted in \ref last_written_replay_position().
+        future<> flush_pending_hints();
+
         /// \brief Populates the _segments_to_replay list.
         ///  Populates the _segments_to_replay list with the names of the files in the <manager hints files directory> directory
         ///  in the order they should be sent out.
@@ -467,6 +524,12 @@ class manager {
         /// \return A new hints store object.
         future<commitlog> add_store() noexcept;
 
+        /// \brief Writes a hint, made of \ref hints hints of \ref size bytes in total, to the hints store.
+        future<> write_hint(schema_ptr s, lw_shared_ptr<const frozen_mutation> fm, tracing::trace_state_ptr tr_state, size_t hints, size_t size) noexcept;
+
+        /// \brief Writes the hints coalesced so far, see \ref pending_hint.
+        future<> write_pending_hints() noexcept;
+
         /// \brief Flushes all hints written so far to the disk.
         ///  - Repopulates the _segments_to_replay list if needed.
         ///
@@ -633,7 +696,9 @@ class manager {
     }
 
     /// \brief Returns a set of replay positions for hint queues towards endpoints from the `target_hosts`.
-    sync_point::shard_rps calculate_current_sync_point(const std::vector<gms::inet_address>& target_hosts) const;
+    ///
+    /// The hints stored so far to these endpoints are written first, so they are covered by the replay positions.
+    future<sync_point::shard_rps> calculate_current_sync_point(const std::vector<gms::inet_address>& target_hosts);
 
     /// \brief Waits until hint replay reach replay positions described in `rps`.
     future<> wait_for_sync_point(abort_source& as, const sync_point::shard_rps& rps);
@@ -9,6 +9,7 @@
 #include "resource_manager.hh"
 #include "manager.hh"
 #include "log.hh"
+#include <algorithm>
 #include <boost/range/algorithm/for_each.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include "utils/disk-error-handler.hh"
@@ -59,6 +60,22 @@ size_t resource_manager::sending_queue_length() const {
     return _send_limiter.waiters();
 }
 
+replay_rate_limiter::clock::duration replay_rate_limiter::backlog_delay(float backlog) noexcept {
+    backlog = std::clamp(backlog, 0.0f, 1.0f);
+    return std::chrono::duration_cast<clock::duration>(max_backlog_delay * double(backlog * backlog * backlog));
+}
+
+replay_rate_limiter::clock::duration replay_rate_limiter::delay_for(size_t bytes, uint64_t rate, float backlog, clock::time_point now) noexcept {
+    auto delay = backlog_delay(backlog);
+    if (rate == 0) {
+        return delay;
+    }
+    // Unused time isn't saved up, for the rate to hold after idle periods too.
+    auto start = std::max(now, _next_send);
+    _next_send = start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(double(bytes) / rate));
+    return start - now + delay;
+}
+
 const std::chrono::seconds space_watchdog::_watchdog_period = std::chrono::seconds(1);
 
 space_watchdog::space_watchdog(shard_managers_set& managers, per_device_limits_map& per_device_limits_map)
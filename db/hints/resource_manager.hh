@@ -15,6 +15,7 @@
 #include <seastar/core/gate.hh>
 #include <seastar/core/memory.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
 #include "seastarx.hh"
 #include <unordered_set>
 #include "utils/small_vector.hh"
@@ -115,6 +116,33 @@ class space_watchdog {
     future<> scan_one_ep_dir(fs::path path, manager& shard_manager, ep_key_type ep_key);
 };
 
+/// Paces the replay of hints to a single node: at most a given number of
+/// bytes per second, and with an extra delay that grows with the view update
+/// backlog of the node, so that a node coming back after a long outage isn't
+/// swamped by the hints, and by the view updates they generate.
+class replay_rate_limiter {
+public:
+    using clock = seastar::lowres_clock;
+
+    /// The delay added at a full backlog. The delay grows with the cube of
+    /// the backlog, like the delay of view updates in storage_proxy.
+    static constexpr std::chrono::microseconds max_backlog_delay{1000000};
+
+private:
+    clock::time_point _next_send = clock::time_point::min();
+
+public:
+    /// The delay added at the relative view update backlog \p backlog.
+    static clock::duration backlog_delay(float backlog) noexcept;
+
+    /// Returns how long to wait before sending \p bytes worth of hints, and
+    /// accounts for them.
+    ///
+    /// \param rate the limit, in bytes per second, 0 for none
+    /// \param backlog the relative view update backlog of the node, in [0, 1]
+    clock::duration delay_for(size_t bytes, uint64_t rate, float backlog, clock::time_point now = clock::now()) noexcept;
+};
+
 class resource_manager {
     const size_t _max_send_in_flight_memory;
     utils::updateable_value<uint32_t> _max_hints_send_queue_length;
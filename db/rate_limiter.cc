@@ -8,7 +8,9 @@
 
 #include <cmath>
 #include <numbers>
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <random>
 #include <variant>
 #include <chrono>
@@ -42,8 +44,6 @@
 
 namespace db {
 
-static constexpr size_t hash_bits = 16;
-static constexpr size_t entry_count = 1 << hash_bits;
 static constexpr size_t bucket_size = 10000;
 
 
@@ -76,11 +76,11 @@ void rate_limiter_base::on_timer() noexcept {
     // older than 2048 seconds from the current generation.
 
     constexpr size_t period = 1 << (time_window_bits - 1);
-    constexpr size_t entries_per_step = entry_count / period;
+    const size_t entries_per_step = _entry_count / period;
 
     const size_t begin = _current_time_window * entries_per_step;
     for (size_t i = 0; i < entries_per_step; i++) {
-        entry_refresh(_entries[(begin + i) % entry_count]);
+        entry_refresh(_entries[(begin + i) % _entry_count]);
     }
 }
 
@@ -116,7 +116,7 @@ rate_limiter_base::entry* rate_limiter_base::get_entry(uint32_t label, uint64_t
     static constexpr size_t max_probes = 32;
     for (size_t i = 0; i < max_probes; i++) {
         // Quadratic probing - every iteration jumps further than the previous one
-        hash = (hash + i) % entry_count;
+        hash = (hash + i) % _entry_count;
         entry& b = _entries[hash];
         ++_metrics.probe_count;
 
@@ -216,15 +216,16 @@ void rate_limiter_base::register_metrics() {
                     for (const auto& twe : _time_window_history) {
                         occupied_entry_count += twe.entries_active;
                     }
-                    return double(occupied_entry_count) / double(entry_count);
+                    return double(occupied_entry_count) / double(_entry_count);
                 },
                 sm::description("Current load factor of the hash table (upper bound, may be overestimated).")),
     });
 }
 
-rate_limiter_base::rate_limiter_base()
+rate_limiter_base::rate_limiter_base(size_t entry_count)
         : _salt(std::random_device{}())
-        , _entries(entry_count)
+        , _entry_count(std::bit_ceil(std::max(entry_count, size_t(1) << (time_window_bits - 1))))
+        , _entries(_entry_count)
         , _time_window_history(op_count_bits - 1) {
     
     register_metrics();
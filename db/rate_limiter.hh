@@ -37,6 +37,9 @@ class rate_limiter_base {
     static constexpr size_t op_count_bits = 20;
     static constexpr size_t time_window_bits = 12;
 
+    // The number of partitions the limiter can track at the same time, by default
+    static constexpr size_t default_entry_count = 1 << 16;
+
 private:
     struct metrics {
         uint64_t allocations_on_empty = 0;
@@ -102,6 +105,7 @@ class rate_limiter_base {
     uint32_t _current_time_window = 0;
 
     const uint32_t _salt;
+    const size_t _entry_count;
 
     utils::chunked_vector<entry> _entries;
     std::vector<time_window_entry> _time_window_history;
@@ -122,7 +126,9 @@ class rate_limiter_base {
     void on_timer() noexcept;
 
 public:
-    rate_limiter_base();
+    // The entry count is rounded up to a power of two, and to at least
+    // the number of time windows after which entries are refreshed.
+    explicit rate_limiter_base(size_t entry_count = default_entry_count);
 
     rate_limiter_base(const rate_limiter_base&) = delete;
     rate_limiter_base(rate_limiter_base&&) = delete;
@@ -155,8 +161,8 @@ class generic_rate_limiter : public rate_limiter_base {
     seastar::timer<ClockType> _timer;
 
 public:
-    generic_rate_limiter()
-            : rate_limiter_base() {
+    explicit generic_rate_limiter(size_t entry_count = default_entry_count)
+            : rate_limiter_base(entry_count) {
 
         // Rate limiting is more accurate when the rate limiter timers
         // on all nodes are synchronized. Assume that the nodes' clocks
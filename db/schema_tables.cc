@@ -775,9 +775,10 @@ future<table_schema_version> calculate_schema_digest(distributed<service::storag
         }
         co_return mutations;
     };
-    auto reduce = [features] (auto& hash, auto&& mutations) {
-        for (const mutation& m : mutations) {
-            feed_hash_for_schema_digest(hash, m, features);
+    auto reduce = [features] (auto& hash, std::vector<mutation> mutations) {
+        // The mutations were read only for the digest, so they can be compacted in place
+        for (mutation& m : mutations) {
+            feed_hash_for_schema_digest(hash, std::move(m), features);
         }
     };
     auto hash = md5_hasher();
@@ -792,7 +793,7 @@ future<table_schema_version> calculate_schema_digest(distributed<service::storag
                     diff_logger.trace("Digest {} for {}, compacted={}", h.finalize(), m, compact_for_schema_digest(m));
                 }
             }
-            reduce(hash, mutations);
+            reduce(hash, std::move(mutations));
         }
         co_return utils::UUID_gen::get_name_UUID(hash.finalize());
     }
@@ -818,6 +819,8 @@ future<std::vector<canonical_mutation>> convert_schema_to_mutations(distributed<
             }
             mut = redact_columns_for_missing_features(std::move(mut), features);
             results.emplace_back(mut);
+            // There is a partition per keyspace, which can have many tables
+            co_await coroutine::maybe_yield();
         }
         co_return results;
     };
@@ -1080,17 +1083,24 @@ read_tables_for_keyspaces(distributed<service::storage_proxy>& proxy, const std:
 }
 
 mutation compact_for_schema_digest(const mutation& m) {
+    return compact_for_schema_digest(mutation(m));
+}
+
+mutation compact_for_schema_digest(mutation&& m) {
     // Cassandra is skipping tombstones from digest calculation
     // to avoid disagreements due to tombstone GC.
     // See https://issues.apache.org/jira/browse/CASSANDRA-6862.
     // We achieve similar effect with compact_for_compaction().
-    mutation m_compacted(m);
-    m_compacted.partition().compact_for_compaction_drop_tombstones_unconditionally(*m.schema(), m.decorated_key());
-    return m_compacted;
+    m.partition().compact_for_compaction_drop_tombstones_unconditionally(*m.schema(), m.decorated_key());
+    return std::move(m);
 }
 
 void feed_hash_for_schema_digest(hasher& h, const mutation& m, schema_features features) {
-    auto compacted = compact_for_schema_digest(m);
+    feed_hash_for_schema_digest(h, mutation(m), features);
+}
+
+void feed_hash_for_schema_digest(hasher& h, mutation&& m, schema_features features) {
+    auto compacted = compact_for_schema_digest(std::move(m));
     if (!features.contains<schema_feature::DIGEST_INSENSITIVE_TO_EXPIRY>() || !compacted.partition().empty()) {
         feed_hash(h, compacted);
     }
@@ -1963,8 +1973,14 @@ static future<> merge_functions(distributed<service::storage_proxy>& proxy, sche
     auto diff = diff_rows(before, after);
 
     co_await proxy.local().get_db().invoke_on_all(coroutine::lambda([&] (replica::database& db) -> future<> {
+        // UDFs are instantiated ahead of their first use by statements
+        auto prewarm = [&db] (const shared_ptr<cql3::functions::user_function>& func) {
+            return with_scheduling_group(db.get_statement_scheduling_group(), [func] { return func->prewarm(); });
+        };
         for (const auto& val : diff.created) {
-            cql3::functions::functions::add_function(co_await create_func(db, *val));
+            auto func = co_await create_func(db, *val);
+            cql3::functions::functions::add_function(func);
+            co_await prewarm(func);
         }
         for (const auto& val : diff.dropped) {
             cql3::functions::function_name name{
@@ -1976,7 +1992,9 @@ static future<> merge_functions(distributed<service::storage_proxy>& proxy, sche
         }
         for (const auto& val : diff.altered) {
             drop_cached_func(db, *val);
-            cql3::functions::functions::replace_function(co_await create_func(db, *val));
+            auto func = co_await create_func(db, *val);
+            cql3::functions::functions::replace_function(func);
+            co_await prewarm(func);
         }
     }));
 }
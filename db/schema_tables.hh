@@ -271,8 +271,11 @@ sstring serialize_index_kind(index_metadata_kind kind);
 index_metadata_kind deserialize_index_kind(sstring kind);
 
 mutation compact_for_schema_digest(const mutation& m);
+mutation compact_for_schema_digest(mutation&& m);
 
 void feed_hash_for_schema_digest(hasher&, const mutation&, schema_features);
+// Like the above, but compacts the mutation in place instead of a copy of it
+void feed_hash_for_schema_digest(hasher&, mutation&&, schema_features);
 
 template<typename K, typename V>
 std::optional<std::map<K, V>> get_map(const query::result_set_row& row, const sstring& name) {
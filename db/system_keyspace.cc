@@ -228,11 +228,12 @@ schema_ptr system_keyspace::batchlog() {
         utf8_type,
         // comment
         "in-progress paxos proposals"
-        // FIXME: the original Java code also had:
-        // operations on resulting CFMetaData:
-        //    .compactionStrategyClass(LeveledCompactionStrategy.class);
        );
        builder.set_gc_grace_seconds(0);
+       // Every LWT reads the row of its key (in prepare) and overwrites it
+       // (in prepare, accept and learn) until it's deleted (in prune), so
+       // keep each row in few sstables, like the original Java code does.
+       builder.set_compaction_strategy(sstables::compaction_strategy_type::leveled);
        builder.with_version(generate_schema_version(builder.uuid()));
        return builder.build(schema_builder::compact_storage::no);
     }();
@@ -389,6 +390,21 @@ schema_ptr system_keyspace::repair_history() {
     return schema;
 }
 
+schema_ptr system_keyspace::cache_warmup() {
+    static thread_local auto schema = [] {
+        auto id = generate_legacy_id(NAME, CACHE_WARMUP);
+        return schema_builder(NAME, CACHE_WARMUP, std::optional(id))
+            .with_column("table_uuid", uuid_type, column_kind::partition_key)
+            // The serialized partition key
+            .with_column("key", bytes_type, column_kind::clustering_key)
+            .set_comment("Hot partitions to read into the cache on startup")
+            .set_gc_grace_seconds(0)
+            .with_version(generate_schema_version(id))
+            .build();
+    }();
+    return schema;
+}
+
 schema_ptr system_keyspace::built_indexes() {
     static thread_local auto built_indexes = [] {
         schema_builder builder(generate_legacy_id(NAME, BUILT_INDEXES), NAME, BUILT_INDEXES,
@@ -2623,7 +2639,9 @@ class clients_table : public streaming_virtual_table {
             .with_column("ssl_enabled", boolean_type)
             .with_column("ssl_protocol", utf8_type)
             .with_column("username", utf8_type)
-            .with_version(system_keyspace::generate_schema_version(id))
+            .with_column("request_memory_used", long_type)
+            .with_column("requests_blocked_memory", long_type)
+            .with_version(system_keyspace::generate_schema_version(id, 1))
             .build();
     }
 
@@ -2729,6 +2747,12 @@ class clients_table : public streaming_virtual_table {
                     set_cell(cr.cells(), "ssl_protocol", *cd.ssl_protocol);
                 }
                 set_cell(cr.cells(), "username", cd.username ? *cd.username : sstring("anonymous"));
+                if (cd.request_memory_used) {
+                    set_cell(cr.cells(), "request_memory_used", *cd.request_memory_used);
+                }
+                if (cd.requests_blocked_memory) {
+                    set_cell(cr.cells(), "requests_blocked_memory", *cd.requests_blocked_memory);
+                }
                 co_await result.emit_row(std::move(cr));
             }
             co_await result.emit_partition_end();
@@ -2891,7 +2915,7 @@ std::vector<schema_ptr> system_keyspace::all_tables(const db::config& cfg) {
                     compactions_in_progress(), compaction_history(),
                     sstable_activity(), size_estimates(), large_partitions(), large_rows(), large_cells(),
                     scylla_local(), db::schema_tables::scylla_table_schema_history(),
-                    repair_history(),
+                    repair_history(), cache_warmup(),
                     v3::views_builds_in_progress(), v3::built_views(),
                     v3::scylla_views_builds_in_progress(),
                     v3::truncated(),
@@ -3112,6 +3136,23 @@ future<> system_keyspace::get_repair_history(::table_id table_id, repair_history
     });
 }
 
+future<> system_keyspace::save_cache_warmup_keys(::table_id table_id, const std::vector<partition_key>& keys, gc_clock::duration ttl) {
+    sstring req = format("INSERT INTO system.{} (table_uuid, key) VALUES (?, ?) USING TTL {}", CACHE_WARMUP,
+            std::chrono::duration_cast<std::chrono::seconds>(ttl).count());
+    for (auto& key : keys) {
+        co_await execute_cql(req, table_id.uuid(), to_bytes(key.representation())).discard_result();
+    }
+}
+
+future<> system_keyspace::get_cache_warmup_keys(cache_warmup_consumer f) {
+    sstring req = format("SELECT table_uuid, key FROM system.{}", CACHE_WARMUP);
+    co_await _qp.query_internal(req, [&f] (const cql3::untyped_result_set::row& row) mutable -> future<stop_iteration> {
+        auto key = row.get_blob("key");
+        co_await f(::table_id(row.get_as<utils::UUID>("table_uuid")), partition_key::from_bytes(bytes_view(key)));
+        co_return stop_iteration::no;
+    });
+}
+
 future<int> system_keyspace::increment_and_get_generation() {
     auto req = format("SELECT gossip_generation FROM system.{} WHERE key='{}'", LOCAL, LOCAL);
     auto rs = co_await _qp.execute_internal(req, cql3::query_processor::cache_internal::yes);
@@ -150,6 +150,7 @@ class system_keyspace : public seastar::peering_sharded_service<system_keyspace>
     static constexpr auto RAFT_SNAPSHOTS = "raft_snapshots";
     static constexpr auto RAFT_SNAPSHOT_CONFIG = "raft_snapshot_config";
     static constexpr auto REPAIR_HISTORY = "repair_history";
+    static constexpr auto CACHE_WARMUP = "cache_warmup";
     static constexpr auto GROUP0_HISTORY = "group0_history";
     static constexpr auto DISCOVERY = "discovery";
     static constexpr auto BROADCAST_KV_STORE = "broadcast_kv_store";
@@ -234,6 +235,7 @@ class system_keyspace : public seastar::peering_sharded_service<system_keyspace>
     static schema_ptr raft();
     static schema_ptr raft_snapshots();
     static schema_ptr repair_history();
+    static schema_ptr cache_warmup();
     static schema_ptr group0_history();
     static schema_ptr discovery();
     static schema_ptr broadcast_kv_store();
@@ -346,6 +348,12 @@ class system_keyspace : public seastar::peering_sharded_service<system_keyspace>
     using repair_history_consumer = noncopyable_function<future<>(const repair_history_entry&)>;
     future<> get_repair_history(table_id, repair_history_consumer f);
 
+    // The hot partitions to read into the cache on startup. Saved entries
+    // expire after ttl, unless saved again.
+    future<> save_cache_warmup_keys(table_id, const std::vector<partition_key>& keys, gc_clock::duration ttl);
+    using cache_warmup_consumer = noncopyable_function<future<>(table_id, partition_key)>;
+    future<> get_cache_warmup_keys(cache_warmup_consumer f);
+
     typedef std::vector<db::replay_position> replay_positions;
 
     static future<> save_truncation_record(table_id, db_clock::time_point truncated_at, db::replay_position);
@@ -26,6 +26,7 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/coroutine/as_future.hh>
 
 #include "replica/database.hh"
 #include "clustering_bounds_comparator.hh"
@@ -34,6 +35,7 @@
 #include "cql3/restrictions/statement_restrictions.hh"
 #include "cql3/expr/expr-utils.hh"
 #include "cql3/expr/evaluate.hh"
+#include "db/config.hh"
 #include "db/view/view.hh"
 #include "db/view/view_builder.hh"
 #include "db/view/view_updating_consumer.hh"
@@ -1631,17 +1633,19 @@ future<> view_update_generator::mutate_MV(
         replica::cf_stats& cf_stats,
         tracing::trace_state_ptr tr_state,
         db::timeout_semaphore_units pending_view_updates,
+        db::timeout_semaphore_units base_pending_view_updates,
         service::allow_hints allow_hints,
         wait_for_all_updates wait_for_all)
 {
     static constexpr size_t max_concurrent_updates = 128;
     co_await max_concurrent_for_each(view_updates, max_concurrent_updates,
-            [this, base_token, &stats, &cf_stats, tr_state, &pending_view_updates, allow_hints, wait_for_all] (frozen_mutation_and_schema mut) mutable -> future<> {
+            [this, base_token, &stats, &cf_stats, tr_state, &pending_view_updates, &base_pending_view_updates, allow_hints, wait_for_all] (frozen_mutation_and_schema mut) mutable -> future<> {
         auto view_token = dht::get_token(*mut.s, mut.fm.key());
         auto& keyspace_name = mut.s->ks_name();
         auto target_endpoint = get_view_natural_endpoint(_proxy.local().local_db(), keyspace_name, base_token, view_token);
         auto remote_endpoints = _proxy.local().local_db().find_keyspace(keyspace_name).get_effective_replication_map()->get_pending_endpoints(view_token);
         auto sem_units = pending_view_updates.split(mut.fm.representation().size());
+        auto base_sem_units = base_pending_view_updates.split(mut.fm.representation().size());
 
         const bool update_synchronously = should_update_synchronously(*mut.s);
         if (update_synchronously) {
@@ -1689,7 +1693,7 @@ future<> view_update_generator::mutate_MV(
                     mut.s->ks_name(), mut.s->cf_name(), base_token, view_token);
             local_view_update = _proxy.local().mutate_locally(mut.s, *mut_ptr, tr_state, db::commitlog::force_sync::no).then_wrapped(
                     [s = mut.s, &stats, &cf_stats, tr_state, base_token, view_token, my_address, mut_ptr = std::move(mut_ptr),
-                            units = sem_units.split(sem_units.count())] (future<>&& f) {
+                            units = sem_units.split(sem_units.count()), base_units = base_sem_units.split(base_sem_units.count())] (future<>&& f) {
                 --stats.writes;
                 if (f.failed()) {
                     ++stats.view_updates_failed_local;
@@ -1726,7 +1730,8 @@ future<> view_update_generator::mutate_MV(
             schema_ptr s = mut.s;
             future<> view_update = apply_to_remote_endpoints(_proxy.local(), *target_endpoint, std::move(remote_endpoints), std::move(mut), base_token, view_token, allow_hints, tr_state).then_wrapped(
                     [s = std::move(s), &stats, &cf_stats, tr_state, base_token, view_token, target_endpoint, updates_pushed_remote,
-                            units = sem_units.split(sem_units.count()), apply_update_synchronously] (future<>&& f) mutable {
+                            units = sem_units.split(sem_units.count()), base_units = base_sem_units.split(base_sem_units.count()),
+                            apply_update_synchronously] (future<>&& f) mutable {
                 if (f.failed()) {
                     stats.view_updates_failed_remote += updates_pushed_remote;
                     cf_stats.total_view_updates_failed_remote += updates_pushed_remote;
@@ -1785,7 +1790,11 @@ void view_builder::setup_metrics() {
 
         sm::make_gauge("builds_in_progress",
                 sm::description("Number of currently active view builds."),
-                [this] { return _base_to_build_step.size(); })
+                [this] { return _base_to_build_step.size(); }),
+
+        sm::make_gauge("batches_in_flight",
+                sm::description("Number of batches of base rows being turned into view updates in the background."),
+                _stats.batches_in_flight)
     });
 }
 
@@ -2213,12 +2222,27 @@ void view_builder::on_drop_view(const sstring& ks_name, const sstring& view_name
     });
 }
 
+void view_builder::update_throughput_limiter() {
+    uint64_t mb_per_sec = _db.get_config().view_building_throughput_mb_per_sec();
+    uint64_t throughput = mb_per_sec ? std::max(mb_per_sec * 1024 * 1024 / smp::count, uint64_t(1)) : 0;
+    if (throughput != _throughput) {
+        _throughput = throughput;
+        _throughput_limiter = make_lw_shared<utils::rate_limiter>(throughput);
+    }
+}
+
+size_t view_builder::max_batches_in_flight() const {
+    return std::max(_db.get_config().view_building_concurrency(), uint32_t(1));
+}
+
 future<> view_builder::do_build_step() {
+  return with_scheduling_group(_db.get_view_building_scheduling_group(), [this] {
     return seastar::async([this] {
         exponential_backoff_retry r(1s, 1min);
         while (!_base_to_build_step.empty() && !_as.abort_requested()) {
             auto units = get_units(_sem, 1).get0();
             ++_stats.steps_performed;
+            update_throughput_limiter();
             try {
                 execute(_current_step->second, exponential_backoff_retry(1s, 1min));
                 r.reset();
@@ -2247,6 +2271,40 @@ future<> view_builder::do_build_step() {
     }).handle_exception([] (std::exception_ptr ex) {
         vlogger.warn("Unexcepted error executing build step: {}. Ignored.", std::current_exception());
     });
+  });
+}
+
+void view_builder::wait_for_batches(build_step& step, size_t max_in_flight) {
+    while (step.batches.size() > max_in_flight) {
+        auto b = std::move(step.batches.front());
+        step.batches.pop_front();
+        b.done.wait();
+        if (!b.done.failed()) {
+            continue;
+        }
+        auto ex = b.done.get_exception();
+        // The batches read after the failed one are retried with it, along
+        // with the rest of the step.
+        for (auto& other : step.batches) {
+            other.done.wait();
+            other.done.ignore_ready_future();
+        }
+        step.batches.clear();
+        step.current_key = std::move(b.key);
+        for (auto& vs : step.build_status) {
+            if (vs.next_token && *vs.next_token > step.current_token()) {
+                vs.next_token = step.current_token();
+            }
+        }
+        std::rethrow_exception(std::move(ex));
+    }
+}
+
+static future<> populate_views_of_batch(lw_shared_ptr<replica::column_family> base, shared_ptr<view_update_generator> gen,
+        std::vector<view_and_base> views, dht::token base_token, flat_mutation_reader_v2 reader, gc_clock::time_point now) {
+    auto f = co_await coroutine::as_future(base->populate_views(std::move(gen), std::move(views), base_token, std::move(reader), now));
+    co_await reader.close();
+    co_await std::move(f);
 }
 
 // Called in the context of a seastar::thread.
@@ -2332,6 +2390,8 @@ class view_builder::consumer {
             // In the system tables, we set first_token = next_token to signal the completion of the build
             // process in case of a restart.
             if (it->next_token && *it->next_token <= it->first_token && _step.current_token() >= it->first_token) {
+                // The view isn't built until all of its batches are.
+                _builder.wait_for_batches(_step);
                 _built_views.views.push_back(std::move(*it));
                 it = _step.build_status.erase(it);
             } else {
@@ -2378,7 +2438,10 @@ class view_builder::consumer {
     }
 
     void add_fragment(auto&& fragment) {
-        _fragments_memory_usage += fragment.memory_usage(*_step.reader.schema());
+        auto memory_usage = fragment.memory_usage(*_step.reader.schema());
+        auto limiter = _builder._throughput_limiter;
+        limiter->reserve(memory_usage).get();
+        _fragments_memory_usage += memory_usage;
         _fragments.emplace_back(*_step.reader.schema(), _builder._permit, std::move(fragment));
         if (_fragments_memory_usage > batch_memory_max) {
             // Although we have not yet completed the batch of base rows that
@@ -2402,17 +2465,16 @@ class view_builder::consumer {
             auto base_schema = _step.base->schema();
             auto views = with_base_info_snapshot(_views_to_build);
             auto reader = make_flat_mutation_reader_from_fragments(_step.reader.schema(), _builder._permit, std::move(_fragments));
-            auto close_reader = defer([&reader] { reader.close().get(); });
             reader.upgrade_schema(base_schema);
-            _step.base->populate_views(
-                    _gen,
-                    std::move(views),
-                    _step.current_token(),
-                    std::move(reader),
-                    _now).get();
-            close_reader.cancel();
+            ++_builder._stats.batches_in_flight;
+            auto done = populate_views_of_batch(_step.base, _gen, std::move(views), _step.current_token(), std::move(reader), _now).finally([&stats = _builder._stats] {
+                --stats.batches_in_flight;
+            });
+            _step.batches.push_back(batch{_step.current_key, std::move(done)});
             _fragments.clear();
             _fragments_memory_usage = 0;
+            // Up to view_building_concurrency batches, counting the one being read.
+            _builder.wait_for_batches(_step, _builder.max_batches_in_flight() - 1);
         }
     }
 
@@ -2425,6 +2487,7 @@ class view_builder::consumer {
     // Must be called in a seastar thread.
     built_views consume_end_of_stream() {
         inject_failure("view_builder_consume_end_of_stream");
+        _builder.wait_for_batches(_step);
         if (vlogger.is_enabled(log_level::debug)) {
             auto view_names = boost::copy_range<std::vector<sstring>>(
                     _views_to_build | boost::adaptors::transformed([](auto v) {
@@ -2452,10 +2515,20 @@ void view_builder::execute(build_step& step, exponential_backoff_retry r) {
             *step.reader.schema(),
             now,
             step.pslice,
-            batch_size,
+            batch_size * max_batches_in_flight(),
             query::max_partitions);
     auto consumer = compact_for_query_v2<view_builder::consumer>(compaction_state, view_builder::consumer{*this, _vug.shared_from_this(), step, now});
-    auto built = step.reader.consume_in_thread(std::move(consumer));
+    auto built = [&] {
+        try {
+            return step.reader.consume_in_thread(std::move(consumer));
+        } catch (...) {
+            // Retry from the first failed batch, if any, which precedes
+            // the partition we failed at.
+            auto ex = std::current_exception();
+            wait_for_batches(step);
+            std::rethrow_exception(std::move(ex));
+        }
+    }();
     if (auto ds = std::move(*compaction_state).detach_state()) {
         if (ds->current_tombstone) {
             step.reader.unpop_mutation_fragment(mutation_fragment_v2(*step.reader.schema(), step.reader.permit(), std::move(*ds->current_tombstone)));
@@ -11,6 +11,7 @@
 #include "dht/i_partitioner.hh"
 #include "query-request.hh"
 #include "service/migration_listener.hh"
+#include "utils/rate_limiter.hh"
 #include "utils/serialized_action.hh"
 #include "utils/UUID.hh"
 #include "replica/database.hh"
@@ -23,6 +24,7 @@
 #include <seastar/core/shared_future.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <deque>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -63,11 +65,18 @@ class view_update_generator;
  * We employ a flat_mutation_reader for each base table for which we're building views.
  *
  * We aim to be resource-conscious. On a given shard, at any given moment, we consume at most
- * from one reader. We also strive for fairness, in that each build step inserts entries for
- * the views of a different base. Each build step reads and generates updates for batch_size rows.
+ * from one reader, and all the views of a base are built in the same pass over it. We also strive
+ * for fairness, in that each build step inserts entries for the views of a different base. Each
+ * build step reads batch_size rows per unit of view_building_concurrency.
  *
- * We lack a controller, which could potentially allow us to go faster (to execute multiple steps at
- * the same time, or consume more rows per batch), and also which would apply backpressure, so we
+ * The rows read are turned into view updates in batches, which are processed in the background,
+ * up to view_building_concurrency of them at a time, so that a step covers several consecutive
+ * token sub-ranges of the base concurrently. The progress of a step is only recorded once all of
+ * its batches are done, and if one of them fails, the step is retried from the first failed one.
+ * Reading is throttled to view_building_throughput_mb_per_sec, and the whole process runs in the
+ * view building scheduling group.
+ *
+ * We lack a controller, which could potentially adjust the concurrency to the load, so we
  * could, for example, delay executing a build step.
  *
  * View building is necessarily a sharded process. That means that on restart, if the number of shards
@@ -118,6 +127,16 @@ class view_builder final : public service::migration_listener::only_view_notific
     struct stats {
         uint64_t steps_performed = 0;
         uint64_t steps_failed = 0;
+        uint64_t batches_in_flight = 0;
+    };
+
+    /**
+     * A batch of base rows being turned into view updates in the background.
+     */
+    struct batch final {
+        // The partition of the first row of the batch, to retry from.
+        dht::decorated_key key;
+        future<> done;
     };
 
     /**
@@ -141,6 +160,8 @@ class view_builder final : public service::migration_listener::only_view_notific
         flat_mutation_reader_v2 reader{nullptr};
         dht::decorated_key current_key{dht::minimum_token(), partition_key::make_empty()};
         std::vector<view_build_status> build_status;
+        // In the order they were read in.
+        std::deque<batch> batches;
 
         const dht::token& current_token() const {
             return current_key.token();
@@ -174,6 +195,9 @@ class view_builder final : public service::migration_listener::only_view_notific
     std::unordered_map<std::pair<sstring, sstring>, seastar::shared_promise<>, utils::tuple_hash> _build_notifiers;
     stats _stats;
     metrics::metric_groups _metrics;
+    // Throttles the reads of the base tables, in bytes per second.
+    uint64_t _throughput = 0;
+    lw_shared_ptr<utils::rate_limiter> _throughput_limiter = make_lw_shared<utils::rate_limiter>(0);
 
     struct view_builder_init_state {
         std::vector<future<>> bookkeeping_ops;
@@ -230,7 +254,13 @@ class view_builder final : public service::migration_listener::only_view_notific
     future<> calculate_shard_build_step(view_builder_init_state& vbi);
     future<> add_new_view(view_ptr, build_step&);
     future<> do_build_step();
+    void update_throughput_limiter();
+    size_t max_batches_in_flight() const;
     void execute(build_step&, exponential_backoff_retry);
+    // Waits for the batches of the step in the background. If one failed, the
+    // step is moved back to the first failed one and its exception is rethrown.
+    // Must be called in a seastar thread.
+    void wait_for_batches(build_step&, size_t max_in_flight = 0);
     future<> maybe_mark_view_as_built(view_ptr, dht::token);
     void setup_metrics();
 
@@ -36,6 +36,13 @@ struct update_backlog {
         return relative_size() == rhs.relative_size();
     }
 
+    /// The part of the backlog above \p fraction (in [0, 1)) of its maximum,
+    /// relative to the rest of the maximum.
+    update_backlog above(float fraction) const {
+        size_t threshold = max * fraction;
+        return update_backlog{current > threshold ? current - threshold : 0, max - threshold};
+    }
+
     static update_backlog no_backlog() {
         return update_backlog{0, std::numeric_limits<size_t>::max()};
     }
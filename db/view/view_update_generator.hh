@@ -81,6 +81,7 @@ class view_update_generator : public async_sharded_service<view_update_generator
             replica::cf_stats& cf_stats,
             tracing::trace_state_ptr tr_state,
             db::timeout_semaphore_units pending_view_updates,
+            db::timeout_semaphore_units base_pending_view_updates,
             service::allow_hints allow_hints,
             wait_for_all_updates wait_for_all);
 
@@ -8,6 +8,7 @@
  * SPDX-License-Identifier: (AGPL-3.0-or-later and Apache-2.0)
  */
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/sleep.hh>
 #include "dht/range_streamer.hh"
 #include "utils/fb_utilities.hh"
@@ -19,6 +20,7 @@
 #include "db/config.hh"
 #include <seastar/core/semaphore.hh>
 #include <boost/range/adaptors.hpp>
+#include <boost/range/irange.hpp>
 #include "utils/stall_free.hh"
 
 namespace dht {
@@ -264,44 +266,61 @@ future<> range_streamer::stream_async() {
                 unsigned sp_index = 0;
                 unsigned nr_ranges_streamed = 0;
                 size_t nr_ranges_total = range_vec.size();
-                size_t nr_ranges_per_stream_plan = nr_ranges_total / 10;
-                auto do_streaming = [&] (dht::token_range_vector&& ranges_to_stream) {
+                size_t nr_ranges_per_stream_plan = std::max(nr_ranges_total / 10, size_t(1));
+                auto do_streaming = [&] (dht::token_range_vector ranges_to_stream, unsigned first_range) -> future<> {
                     auto sp = stream_plan(_stream_manager.local(), format("{}-{}-index-{:d}", description, keyspace, sp_index++), _reason);
                     auto abort_listener = _abort_source.subscribe([&] () noexcept { sp.abort(); });
                     _abort_source.check();
                     logger.info("{} with {} for keyspace={}, streaming [{}, {}) out of {} ranges",
                             description, source, keyspace,
-                            nr_ranges_streamed, nr_ranges_streamed + ranges_to_stream.size(), nr_ranges_total);
+                            first_range, first_range + ranges_to_stream.size(), nr_ranges_total);
                     auto ranges_streamed = ranges_to_stream.size();
                     if (_nr_rx_added) {
                         sp.request_ranges(source, keyspace, std::move(ranges_to_stream));
                     } else if (_nr_tx_added) {
                         sp.transfer_ranges(source, keyspace, std::move(ranges_to_stream));
                     }
-                    sp.execute().discard_result().get();
+                    co_await sp.execute().discard_result();
                     // Update finished percentage
-                    nr_ranges_streamed += ranges_streamed;
                     _nr_ranges_remaining -= ranges_streamed;
                     float percentage = _nr_total_ranges == 0 ? 1 : (_nr_total_ranges - _nr_ranges_remaining) / (float)_nr_total_ranges;
                     _stream_manager.local().update_finished_percentage(_reason, percentage);
                     logger.info("Finished {} out of {} ranges for {}, finished percentage={}",
                             _nr_total_ranges - _nr_ranges_remaining, _nr_total_ranges, _reason, percentage);
                 };
-                dht::token_range_vector ranges_to_stream;
+                // Stream plans run in waves of up to `concurrency` plans. The
+                // concurrency is raised after a wave which streamed ranges
+                // faster than the one before it and lowered after one which
+                // streamed them slower, so a node which can serve more streams
+                // gets them, and an overloaded node sheds them.
+                unsigned concurrency = 1;
+                float last_rate = 0;
                 try {
-                    for (auto it = range_vec.begin(); it < range_vec.end();) {
-                        ranges_to_stream.push_back(*it);
-                        ++it;
-                        if (ranges_to_stream.size() < nr_ranges_per_stream_plan) {
-                            continue;
-                        } else {
-                            do_streaming(std::exchange(ranges_to_stream, {}));
-                            it = range_vec.erase(range_vec.begin(), it);
+                    while (!range_vec.empty()) {
+                        std::vector<dht::token_range_vector> plans;
+                        auto it = range_vec.begin();
+                        while (it != range_vec.end() && plans.size() < concurrency) {
+                            auto end = it + std::min(nr_ranges_per_stream_plan, size_t(range_vec.end() - it));
+                            plans.emplace_back(it, end);
+                            it = end;
                         }
-                    }
-                    if (ranges_to_stream.size() > 0) {
-                        do_streaming(std::exchange(ranges_to_stream, {}));
-                        range_vec.clear();
+                        auto nr_ranges_in_wave = size_t(it - range_vec.begin());
+                        auto wave_start = lowres_clock::now();
+                        parallel_for_each(boost::irange(size_t(0), plans.size()), [&] (size_t i) {
+                            return do_streaming(std::move(plans[i]), nr_ranges_streamed + i * nr_ranges_per_stream_plan);
+                        }).get();
+                        range_vec.erase(range_vec.begin(), it);
+                        nr_ranges_streamed += nr_ranges_in_wave;
+                        auto elapsed = std::chrono::duration_cast<std::chrono::duration<float>>(lowres_clock::now() - wave_start).count();
+                        auto rate = nr_ranges_in_wave / std::max(elapsed, 0.001f);
+                        if (rate > last_rate * 1.1f && concurrency < max_stream_plans_per_node) {
+                            concurrency++;
+                        } else if (rate < last_rate * 0.9f && concurrency > 1) {
+                            concurrency--;
+                        }
+                        logger.debug("{} with {} for keyspace={}, streamed {} ranges at {} ranges/s, streaming with {} plans in parallel",
+                                description, source, keyspace, nr_ranges_in_wave, rate, concurrency);
+                        last_rate = rate;
                     }
                 } catch (...) {
                     auto t = std::chrono::duration_cast<std::chrono::duration<float>>(lowres_clock::now() - start_time).count();
@@ -162,6 +162,10 @@ class range_streamer {
     unsigned _nr_rx_added = 0;
     // Limit the number of nodes to stream in parallel to reduce memory pressure with large cluster.
     seastar::semaphore _limiter{16};
+    // Limit the number of stream plans to run in parallel with a single node.
+    // The number in flight starts at one, and is raised while it raises the
+    // rate at which the ranges of the node are streamed.
+    static constexpr unsigned max_stream_plans_per_node = 4;
     size_t _nr_total_ranges = 0;
     size_t _nr_ranges_remaining = 0;
 };
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <cmath>
 #include <unordered_set>
 
 #include <seastar/core/abort_source.hh>
@@ -35,6 +36,40 @@ struct listener_info {
     seastar::shard_id shard;
 };
 
+// The threshold shared by a group of listeners, see `failure_detector::register_listener`.
+struct listener_threshold {
+    clock::interval_t threshold;
+    std::optional<adaptive_threshold> adaptive;
+
+    bool operator==(const listener_threshold&) const = default;
+};
+
+struct listener_threshold_hash {
+    size_t operator()(const listener_threshold& t) const noexcept {
+        auto h = std::hash<clock::interval_t>()(t.threshold);
+        if (t.adaptive) {
+            h = h * 31 + std::hash<double>()(t.adaptive->phi);
+            h = h * 31 + std::hash<clock::interval_t>()(t.adaptive->min_threshold);
+        }
+        return h;
+    }
+};
+
+// The number of standard deviations above the mean interval at which the suspicion level reaches `phi`.
+// Uses the logistic approximation of the normal distribution of the phi accrual failure detector:
+// phi(y) = -log10(1 / (1 + e^(y * (1.5976 + 0.070566 * y^2)))).
+static double phi_to_deviations(double phi) {
+    auto phi_at = [] (double y) {
+        return std::log10(1 + std::exp(y * (1.5976 + 0.070566 * y * y)));
+    };
+    double lo = 0, hi = 40;
+    for (int i = 0; i < 64; ++i) {
+        auto mid = (lo + hi) / 2;
+        (phi_at(mid) < phi ? lo : hi) = mid;
+    }
+    return hi;
+}
+
 // Tracks the liveness of a given endpoint for a given listener threshold.
 // See `endpoint_worker::ping_fiber()` and `endpoint_worker::notify_fiber()`.
 struct endpoint_liveness {
@@ -47,6 +82,10 @@ struct listeners_liveness {
     // Vector of all listeners with the same threshold.
     std::vector<listener_info> listeners;
 
+    // If the threshold is adaptive, the number of standard deviations of the response intervals
+    // above their mean which makes the threshold, see `phi_to_deviations`.
+    double deviations = 0;
+
     // For each endpoint managed by this shard, the liveness state of this endpoint shared by all listeners in `listeners`.
     std::unordered_map<pinger::endpoint_id, direct_failure_detector::endpoint_liveness> endpoint_liveness;
 };
@@ -76,6 +115,31 @@ struct endpoint_worker {
     future<> ping_fiber() noexcept;
     future<> _ping_fiber = make_ready_future<>();
 
+    // EWMA of the mean and variance of the intervals between consecutive successful pings.
+    // Used to compute adaptive thresholds.
+    struct response_intervals {
+        // Weight of each new interval once enough were observed.
+        static constexpr double alpha = 1.0 / 16;
+        // Intervals observed before adaptive thresholds are used.
+        static constexpr size_t min_count = 10;
+
+        double mean = 0;
+        double variance = 0;
+        size_t count = 0;
+
+        void add(clock::interval_t interval) noexcept {
+            ++count;
+            auto a = std::max(alpha, 1.0 / count);
+            auto diff = interval - mean;
+            mean += a * diff;
+            variance = (1 - a) * (variance + a * diff * diff);
+        }
+    };
+    response_intervals _intervals;
+
+    // The threshold of the given listeners for this endpoint.
+    clock::interval_t threshold(const listener_threshold&, const listeners_liveness&) const noexcept;
+
     // Waits for `endpoint_liveness::alive` to change and notifies listeners.
     // Updates `endpoint_liveness:marked_alive` to remember that a notification was sent.
     // The returned future is never exceptional.
@@ -129,7 +193,7 @@ struct failure_detector::impl {
     //
     // Each `endpoint_worker` running on this shard is managing, for each threshold, the `endpoint_liveness` state
     // at `listeners_liveness::endpoint_liveness[ep]`, where `ep` is the endpoint of that worker.
-    std::unordered_map<clock::interval_t, listeners_liveness> _listeners_liveness;
+    std::unordered_map<listener_threshold, listeners_liveness, listener_threshold_hash> _listeners_liveness;
 
     // The listeners registered on this shard.
     std::unordered_set<listener*> _registered;
@@ -166,7 +230,7 @@ struct failure_detector::impl {
 
     // Add information about a listener registered on shard `s` with threshold `t`
     // on the current shard so workers running on this shard can notify it.
-    void add_listener(listener_id, clock::interval_t t, seastar::shard_id s);
+    void add_listener(listener_id, listener_threshold t, seastar::shard_id s);
     // Remove information about a registered listener from the current shard.
     void remove_listener(listener_id);
 
@@ -375,7 +439,7 @@ endpoint_worker::~endpoint_worker() {
     assert(_notify_fiber.available());
 }
 
-future<subscription> failure_detector::register_listener(listener& l, clock::interval_t threshold) {
+future<subscription> failure_detector::register_listener(listener& l, clock::interval_t threshold, std::optional<adaptive_threshold> adaptive) {
     // The pointer acts as a listener ID.
     if (!_impl->_registered.insert(&l).second) {
         throw std::runtime_error{format("direct_failure_detector: trying to register the same listener ({}) twice", fmt::ptr(&l))};
@@ -383,8 +447,8 @@ future<subscription> failure_detector::register_listener(listener& l, clock::int
 
     subscription s{*this, l};
 
-    co_await container().invoke_on_all([l = &l, threshold, shard = this_shard_id()] (failure_detector& fd) {
-        fd._impl->add_listener(l, threshold, shard);
+    co_await container().invoke_on_all([l = &l, t = listener_threshold{threshold, adaptive}, shard = this_shard_id()] (failure_detector& fd) {
+        fd._impl->add_listener(l, t, shard);
     });
 
     co_return s;
@@ -427,12 +491,15 @@ subscription::~subscription() {
     });
 }
 
-void failure_detector::impl::add_listener(listener_id id, clock::interval_t threshold, seastar::shard_id shard) {
+void failure_detector::impl::add_listener(listener_id id, listener_threshold threshold, seastar::shard_id shard) {
     if (!_shard_workers.empty()) {
         throw std::runtime_error{"direct_failure_detector: trying to register a listener after endpoints were added"};
     }
 
-    auto [it, _] = _listeners_liveness.try_emplace(threshold);
+    auto [it, inserted] = _listeners_liveness.try_emplace(threshold);
+    if (inserted && threshold.adaptive) {
+        it->second.deviations = phi_to_deviations(threshold.adaptive->phi);
+    }
     it->second.listeners.push_back(listener_info{id, shard});
 }
 
@@ -522,6 +589,18 @@ static future<bool> ping_with_timeout(pinger::endpoint_id id, clock::timepoint_t
     co_return result;
 }
 
+clock::interval_t endpoint_worker::threshold(const listener_threshold& t, const listeners_liveness& l) const noexcept {
+    if (!t.adaptive || _intervals.count < response_intervals::min_count) {
+        return t.threshold;
+    }
+
+    // Responses with little jitter would make the threshold too close to the mean interval,
+    // so that a single late response would be taken for a failure.
+    auto deviation = std::max(std::sqrt(_intervals.variance), double(_fd._ping_period) / 10);
+    auto adaptive = clock::interval_t(std::ceil(_intervals.mean + l.deviations * deviation));
+    return std::clamp(adaptive, std::min(t.adaptive->min_threshold, t.threshold), t.threshold);
+}
+
 future<> endpoint_worker::ping_fiber() noexcept {
     auto& pinger = _fd._pinger;
     auto& clock = _fd._clock;
@@ -530,6 +609,9 @@ future<> endpoint_worker::ping_fiber() noexcept {
     // That's fine since we don't use it until then (every use is protected with checking that at least one listener is `alive`,
     // which can only be true if there was a successful ping response).
     clock::timepoint_t last_response;
+    // Whether the previous ping succeeded, so that `_intervals` only measures the intervals between consecutive
+    // responses, reflecting the pings' latency rather than the endpoint's downtime.
+    bool responded = false;
 
     while (!_as.abort_requested()) {
         bool success = false;
@@ -541,9 +623,10 @@ future<> endpoint_worker::ping_fiber() noexcept {
         // However, if there's a listener that's going to timeout soon (before the ping returns), we abort the ping in order to handle
         // the listener (mark it as dead).
         auto timeout = start + 3 * _fd._ping_period;
-        for (auto& [threshold, l]: _fd._listeners_liveness) {
-            if (l.endpoint_liveness[_id].alive && last_response + threshold < timeout) {
-                timeout = last_response + threshold;
+        for (auto& [t, l]: _fd._listeners_liveness) {
+            auto th = threshold(t, l);
+            if (l.endpoint_liveness[_id].alive && last_response + th < timeout) {
+                timeout = last_response + th;
             }
         }
 
@@ -570,7 +653,11 @@ future<> endpoint_worker::ping_fiber() noexcept {
 
         bool alive_changed = false;
         if (success) {
-            last_response = clock.now();
+            auto now = clock.now();
+            if (responded) {
+                _intervals.add(now - last_response);
+            }
+            last_response = now;
 
             for (auto& [_, l]: _fd._listeners_liveness) {
                 bool& alive = l.endpoint_liveness[_id].alive;
@@ -583,15 +670,17 @@ future<> endpoint_worker::ping_fiber() noexcept {
             // Handle listeners which time-out before the next ping starts.
             // We could sleep until their threshold is actually crossed, but since we already know they will time-out
             // and there's no way to save them, it's simpler to just send the notifications immediately.
-            for (auto& [threshold, l]: _fd._listeners_liveness) {
+            for (auto& [t, l]: _fd._listeners_liveness) {
                 bool& alive = l.endpoint_liveness[_id].alive;
-                if (alive && last_response + threshold <= next_ping_start) {
+                if (alive && last_response + threshold(t, l) <= next_ping_start) {
                     alive = false;
                     alive_changed = true;
                 }
             }
         }
 
+        responded = success;
+
         if (alive_changed) {
             _alive_changed.signal();
         }
@@ -636,7 +725,7 @@ future<> endpoint_worker::notify_fiber() noexcept {
                 // Unexpected exception. If `mark` failed for some reason, there's not much we can do.
                 // Log and continue.
                 logger.error("unexpected exception when marking endpoint {} as {} for threshold {}: {}",
-                        _id, alive ? "alive" : "dead", it->first, std::current_exception());
+                        _id, alive ? "alive" : "dead", it->first.threshold, std::current_exception());
             }
         }
 
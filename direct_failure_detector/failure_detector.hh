@@ -7,6 +7,8 @@
  */
 #pragma once
 
+#include <optional>
+
 #include "utils/UUID.hh"
 
 #include <seastar/core/sharded.hh>
@@ -87,6 +89,22 @@ class listener {
     ~listener() = default;
 };
 
+// Makes the threshold of a listener adapt to the intervals between consecutive responses of each endpoint,
+// in the style of the phi accrual failure detector: the endpoint is considered dead once the time since its last
+// response reaches a length whose probability, given the intervals observed so far (assumed to be normally
+// distributed), is 10^-`phi`.
+//
+// On stable networks the intervals are close to the ping period, so this detects failures much faster than a fixed
+// threshold chosen for the worst networks, while endpoints with jittery responses get proportionally longer thresholds.
+// The adaptive threshold is kept between `min_threshold` and the listener's threshold. The latter is used until enough
+// responses were observed.
+struct adaptive_threshold {
+    double phi;
+    clock::interval_t min_threshold;
+
+    bool operator==(const adaptive_threshold&) const = default;
+};
+
 class failure_detector;
 
 // A RAII object returned when registering a `listener`.
@@ -156,9 +174,12 @@ class failure_detector : public seastar::peering_sharded_service<failure_detecto
     //
     // Listeners can be registered on any shard. If your use case requires to have a listener on multiple shards,
     // you need to register a separate listener on each shard.
+    //
+    // If `adaptive` is set, `threshold` is the upper bound of a threshold adapted to each endpoint, see `adaptive_threshold`.
     future<subscription> register_listener(
             listener&,
-            clock::interval_t threshold);
+            clock::interval_t threshold,
+            std::optional<adaptive_threshold> adaptive = std::nullopt);
 
     // Add this endpoint to the detected set.
     // Has no effect if the endpoint is already there.
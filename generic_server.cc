@@ -10,9 +10,12 @@
 
 #include "utils/to_string.hh"
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/when_all.hh>
 #include <seastar/core/loop.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/reactor.hh>
+#include <seastar/core/sleep.hh>
 
 namespace generic_server {
 
@@ -67,7 +70,10 @@ future<> connection::process()
         return do_until([this] {
             return _read_buf.eof();
         }, [this] {
-            return process_request();
+            return process_request().then([this] {
+                // The last call only finds the end of the stream.
+                _server._total_requests += !_read_buf.eof();
+            });
         }).then_wrapped([this] (future<> f) {
             handle_error(std::move(f));
         });
@@ -105,6 +111,26 @@ server::server(const sstring& server_name, logging::logger& logger)
     : _server_name{server_name}
     , _logger{logger}
 {
+    namespace sm = seastar::metrics;
+    auto server_label = sm::label("server")(_server_name);
+    _server_metrics.add_group("generic_server", {
+        sm::make_counter("accepted_connections", _total_connections,
+                sm::description("Counts the connections accepted by this shard."), {server_label}),
+        sm::make_gauge("connections", _current_connections,
+                sm::description("Holds the current number of connections of this shard."), {server_label}),
+        sm::make_counter("requests", _total_requests,
+                sm::description("Counts the requests read from the connections of this shard."), {server_label}),
+    });
+    if (this_shard_id() == 0) {
+        _server_metrics.add_group("generic_server", {
+            sm::make_gauge("connections_imbalance", [this] { return _load_imbalance.connections; },
+                    sm::description("The maximum number of connections of a shard divided by the mean over all shards, 1 when they are evenly spread. "
+                            "Only exported on shard 0, by the servers running on all shards."), {server_label}),
+            sm::make_gauge("requests_imbalance", [this] { return _load_imbalance.requests; },
+                    sm::description("The maximum number of requests read by a shard during the last 10 seconds divided by the mean over all shards, "
+                            "1 when they are evenly spread. Only exported on shard 0, by the servers running on all shards."), {server_label}),
+        });
+    }
 }
 
 server::~server()
@@ -113,6 +139,14 @@ server::~server()
 
 future<> server::stop() {
     _stopping = true;
+    if (_load_sampler) {
+        _load_sampler_as.request_abort();
+        co_await std::exchange(_load_sampler, std::nullopt).value();
+    }
+    co_await do_stop();
+}
+
+future<> server::do_stop() {
     size_t nr = 0;
     size_t nr_total = _listeners.size();
     _logger.debug("abort accept nr_total={}", nr_total);
@@ -160,9 +194,54 @@ server::listen(socket_address addr, std::shared_ptr<seastar::tls::credentials_bu
         }
         _listeners.emplace_back(std::move(ss));
         _stopped = when_all(std::move(_stopped), do_accepts(_listeners.size() - 1, keepalive, addr)).discard_result();
+        if (this_shard_id() == 0 && !_load_sampler) {
+            _load_sampler = sample_shard_loads();
+        }
     });
 }
 
+static constexpr auto load_sampling_period = std::chrono::seconds(10);
+
+// The maximum of the values divided by their mean, 1 if they are all zero.
+template <typename Func>
+static double imbalance(const std::vector<server::shard_load>& loads, Func value) {
+    double max = 0, sum = 0;
+    for (size_t i = 0; i < loads.size(); ++i) {
+        auto v = double(value(i));
+        max = std::max(max, v);
+        sum += v;
+    }
+    return sum ? max * loads.size() / sum : 1;
+}
+
+future<> server::sample_shard_loads() {
+    while (!_load_sampler_as.abort_requested()) {
+        try {
+            co_await sleep_abortable(load_sampling_period, _load_sampler_as);
+            auto loads = co_await get_shard_loads();
+            if (loads.empty()) {
+                co_return;
+            }
+            _load_imbalance.connections = imbalance(loads, [&] (size_t shard) {
+                return loads[shard].connections;
+            });
+            if (_last_shard_loads.size() == loads.size()) {
+                _load_imbalance.requests = imbalance(loads, [&] (size_t shard) {
+                    return loads[shard].requests - _last_shard_loads[shard].requests;
+                });
+            }
+            _last_shard_loads = std::move(loads);
+        } catch (const sleep_aborted&) {
+        } catch (...) {
+            _logger.warn("failed to sample the load of the shards: {}", std::current_exception());
+        }
+    }
+}
+
+future<std::vector<server::shard_load>> server::get_shard_loads() {
+    return make_ready_future<std::vector<shard_load>>();
+}
+
 future<> server::do_accepts(int which, bool keepalive, socket_address server_addr) {
     return repeat([this, which, keepalive, server_addr] {
         ++_connections_being_accepted;
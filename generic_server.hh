@@ -14,8 +14,10 @@
 
 #include <list>
 
+#include <seastar/core/abort_source.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/net/api.hh>
 #include <seastar/net/tls.hh>
 
@@ -70,8 +72,20 @@ class connection : public boost::intrusive::list_base_hook<> {
 // Protocol specific classes that inherit `server` are expected to also inherit
 // a connection class from `connection` and override the `make_connection` member
 // function to create a protocol specific connection upon `accept`.
+//
+// Accepted connections are placed on shards by seastar: the listeners which
+// aren't shard-aware pick the shard with the fewest connections (using
+// per-shard SO_REUSEPORT sockets where the kernel supports them). Servers
+// running on every shard can override `get_shard_loads` to have shard 0
+// export how unevenly the connections and requests are spread.
 class server {
     friend class connection;
+public:
+    // The load of a server instance on one shard.
+    struct shard_load {
+        uint64_t connections = 0;
+        uint64_t requests = 0;
+    };
 
 protected:
     sstring _server_name;
@@ -81,6 +95,7 @@ class server {
     uint64_t _current_connections = 0;
     uint64_t _connections_being_accepted = 0;
     uint64_t _total_connections = 0;
+    uint64_t _total_requests = 0;
     future<> _stopped = _all_connections_stopped.get_future();
     using connections_list_t = boost::intrusive::list<connection>;
     connections_list_t _connections_list;
@@ -93,6 +108,22 @@ class server {
     std::list<gentle_iterator> _gentle_iterators;
     std::vector<server_socket> _listeners;
 
+    // The spread of the load across shards, see `sample_shard_loads`. Updated on shard 0 only.
+    struct load_imbalance {
+        // The maximum over shards divided by the mean, 1 when balanced.
+        double connections = 1;
+        // Likewise for the requests read over the last sampling period.
+        double requests = 1;
+    };
+    load_imbalance _load_imbalance;
+    std::vector<shard_load> _last_shard_loads;
+    abort_source _load_sampler_as;
+    std::optional<future<>> _load_sampler;
+    seastar::metrics::metric_groups _server_metrics;
+
+    future<> sample_shard_loads();
+    future<> do_stop();
+
 public:
     server(const sstring& server_name, logging::logger& logger);
 
@@ -113,6 +144,14 @@ class server {
 
     future<> for_each_gently(noncopyable_function<void(const connection&)>);
 
+    shard_load get_shard_load() const noexcept {
+        return shard_load{_current_connections, _total_requests};
+    }
+
+    // The loads of the instances of this server on all shards, indexed by shard,
+    // or an empty vector if the server doesn't run on all shards.
+    virtual future<std::vector<shard_load>> get_shard_loads();
+
     void maybe_stop();
 };
 
@@ -75,6 +75,12 @@ feature_config feature_config_from_db_config(const db::config& cfg, std::set<sst
     if (!cfg.uuid_sstable_identifiers_enabled()) {
         fcfg._disabled_features.insert("UUID_SSTABLE_IDENTIFIERS"s);
     }
+    if (!cfg.split_block_bloom_filter_enabled()) {
+        fcfg._disabled_features.insert("SPLIT_BLOCK_BLOOM_FILTER"s);
+    }
+    if (!cfg.enable_sstable_compression_dictionary_training()) {
+        fcfg._disabled_features.insert("SSTABLE_COMPRESSION_DICTIONARY"s);
+    }
 
     if (!utils::get_local_injector().enter("features_enable_test_feature")) {
         fcfg._disabled_features.insert("TEST_ONLY_FEATURE"s);
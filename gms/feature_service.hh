@@ -112,12 +112,24 @@ class feature_service final : public peering_sharded_service<feature_service> {
     gms::feature typed_errors_in_read_rpc { *this, "TYPED_ERRORS_IN_READ_RPC"sv };
     gms::feature schema_commitlog { *this, "SCHEMA_COMMITLOG"sv };
     gms::feature uda_native_parallelized_aggregation { *this, "UDA_NATIVE_PARALLELIZED_AGGREGATION"sv };
+    gms::feature grouped_parallelized_aggregation { *this, "GROUPED_PARALLELIZED_AGGREGATION"sv };
     gms::feature aggregate_storage_options { *this, "AGGREGATE_STORAGE_OPTIONS"sv };
     gms::feature collection_indexing { *this, "COLLECTION_INDEXING"sv };
     gms::feature large_collection_detection { *this, "LARGE_COLLECTION_DETECTION"sv };
     gms::feature secondary_indexes_on_static_columns { *this, "SECONDARY_INDEXES_ON_STATIC_COLUMNS"sv };
     gms::feature tablets { *this, "TABLETS"sv };
     gms::feature uuid_sstable_identifiers { *this, "UUID_SSTABLE_IDENTIFIERS"sv };
+    gms::feature split_block_bloom_filter { *this, "SPLIT_BLOCK_BLOOM_FILTER"sv };
+    gms::feature sstable_compression_dictionary { *this, "SSTABLE_COMPRESSION_DICTIONARY"sv };
+    gms::feature cache_admission_policy { *this, "CACHE_ADMISSION_POLICY"sv };
+    gms::feature query_results_cache { *this, "QUERY_RESULTS_CACHE"sv };
+    gms::feature read_abort { *this, "READ_ABORT"sv };
+    gms::feature sstable_file_streaming { *this, "SSTABLE_FILE_STREAMING"sv };
+    gms::feature adaptive_speculative_retry { *this, "ADAPTIVE_SPECULATIVE_RETRY"sv };
+    gms::feature mutation_batch { *this, "MUTATION_BATCH"sv };
+    gms::feature xxhash3_digest { *this, "XXHASH3_DIGEST"sv };
+    gms::feature incremental_repair { *this, "INCREMENTAL_REPAIR"sv };
+    gms::feature repair_row_hash_sketch { *this, "REPAIR_ROW_HASH_SKETCH"sv };
 
     // A feature just for use in tests. It must not be advertised unless
     // the "features_enable_test_feature" injection is enabled.
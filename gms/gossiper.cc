@@ -338,11 +338,11 @@ future<> gossiper::do_send_ack2_msg(msg_addr from, utils::chunked_vector<gossip_
     return futurize_invoke([this, from, ack_msg_digest = std::move(ack_msg_digest)] () mutable {
         /* Get the state required to send to this gossipee - construct GossipDigestAck2Message */
         std::map<inet_address, endpoint_state> delta_ep_state_map;
-        for (auto g_digest : ack_msg_digest) {
+        for (const auto& g_digest : ack_msg_digest) {
             inet_address addr = g_digest.get_endpoint();
             auto local_ep_state_ptr = this->get_state_for_version_bigger_than(addr, version_type(g_digest.get_max_version()));
             if (local_ep_state_ptr) {
-                delta_ep_state_map.emplace(addr, *local_ep_state_ptr);
+                delta_ep_state_map.emplace(addr, std::move(*local_ep_state_ptr));
             }
         }
         gms::gossip_digest_ack2 ack2_msg(std::move(delta_ep_state_map));
@@ -1731,7 +1731,7 @@ void gossiper::send_all(gossip_digest& g_digest,
     logger.trace("send_all(): ep={}, version > {}", ep, max_remote_version);
     auto local_ep_state_ptr = get_state_for_version_bigger_than(ep, max_remote_version);
     if (local_ep_state_ptr) {
-        delta_ep_state_map[ep] = *local_ep_state_ptr;
+        delta_ep_state_map[ep] = std::move(*local_ep_state_ptr);
     }
 }
 
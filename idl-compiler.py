@@ -308,7 +308,12 @@ class ClassDef(ASTBase):
 template <typename Output>
 void serializer<{full_name}>::write(Output& buf, const {full_name}& obj) {{""")
         if not self.final:
-            fprintln(cout, f"""  {SETSIZE}(buf, obj);""")
+            size = fixed_serialized_size(self)
+            if size is not None:
+                # No need to serialize the object twice to learn its size
+                fprintln(cout, f"""  {SERIALIZER}(buf, {SIZETYPE}({size}));""")
+            else:
+                fprintln(cout, f"""  {SETSIZE}(buf, obj);""")
         for member in self.members:
             if isinstance(member, ClassDef) or isinstance(member, EnumDef):
                 continue
@@ -869,6 +874,48 @@ def resolve_basic_type_ref(type: BasicType):
     return local_types[type.name]
 
 
+# Serialized sizes of the basic types which have the same size for all values
+fixed_size_types = {
+    'bool': 1,
+    'int8_t': 1,
+    'uint8_t': 1,
+    'int16_t': 2,
+    'uint16_t': 2,
+    'int32_t': 4,
+    'uint32_t': 4,
+    'int64_t': 8,
+    'uint64_t': 8,
+    'api::timestamp_type': 8,
+}
+
+
+def fixed_serialized_size(t):
+    '''Returns the serialized size of the type, or of the class, if it's the
+    same for all of its values, and None otherwise.
+
+    Classes qualify when all of their members do, and the types of the members
+    are either listed in `fixed_size_types` or classes defined in the current
+    IDL file. Non-final classes are prefixed by their size.'''
+    if isinstance(t, ClassDef):
+        if t.stub or t.template_params is not None:
+            return None
+        size = 0 if t.final else 4
+        for m in get_members(t):
+            member_size = fixed_serialized_size(m.type)
+            if member_size is None:
+                return None
+            size += member_size
+        return size
+    if not isinstance(t, BasicType):
+        return None
+    if t.name in fixed_size_types:
+        return fixed_size_types[t.name]
+    cls = local_types.get(t.name)
+    if isinstance(cls, ClassDef):
+        return fixed_serialized_size(cls)
+    return None
+
+
 def list_types(t):
     if isinstance(t, BasicType):
         return [t.name]
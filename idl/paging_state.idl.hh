@@ -49,6 +49,8 @@ class paging_state {
     uint32_t get_rows_fetched_for_last_partition_high_bits() [[version 4.3]] = 0;
     bound_weight get_clustering_key_weight() [[version 5.1]] = bound_weight::equal;
     partition_region get_partition_region() [[version 5.1]] = partition_region::clustered;
+    uint32_t get_average_row_size() [[version 5.4]] = 0;
+    uint32_t get_average_row_latency_ns() [[version 5.4]] = 0;
 };
 }
 }
@@ -14,11 +14,22 @@
 #include "idl/frozen_mutation.idl.hh"
 #include "idl/token.idl.hh"
 #include "repair/id.hh"
+#include "repair/hash_sketch.hh"
 
 class repair_hash {
     uint64_t hash;
 };
 
+struct repair_hash_sketch_cell {
+    int32_t count;
+    uint64_t hash_sum;
+    uint64_t check_sum;
+};
+
+class repair_hash_sketch {
+    std::vector<repair_hash_sketch_cell> cells();
+};
+
 struct partition_key_and_mutation_fragments {
     partition_key get_key();
     std::list<frozen_mutation_fragment> get_mutation_fragments();
@@ -40,6 +51,7 @@ struct get_sync_boundary_response {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    send_full_set_rpc_stream_xxh3,
 };
 
 enum class repair_stream_cmd : uint8_t {
@@ -16,6 +16,7 @@
 #include "utils/ascii.hh"
 #include "utils/date.h"
 #include <seastar/core/align.hh>
+#include <bit>
 #include <lua.hpp>
 #include "db/config.hh"
 
@@ -1057,17 +1058,78 @@ lua::runtime_config lua::make_runtime_config(const db::config& config) {
     return lua::runtime_config{std::move(timeout_in_ms), std::move(max_bytes), std::move(max_contiguous)};
 }
 
-// run the script for at most max_instructions
-future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<data_value>& values, data_type return_type, const lua::runtime_config& cfg) {
-    lua_slice_state l = load_script(cfg, bitcode);
-    unsigned nargs = values.size();
-    if (!lua_checkstack(l, nargs)) {
-        throw std::runtime_error("could push args to the stack");
+// Pushes a serialized argument, reading the common fixed size and string
+// types straight from their serialized form instead of going through a
+// data_value.
+static void push_serialized_argument(lua_State* l, const abstract_type& type, const bytes_opt& param) {
+    if (!param) {
+        lua_pushnil(l);
+        return;
     }
-    for (const data_value& arg : values) {
-        push_argument(l, arg);
+    bytes_view v = *param;
+    auto push_integer = [&] <typename T> () {
+        if (v.size() != sizeof(T)) {
+            return false;
+        }
+        lua_pushinteger(l, read_simple_exactly<T>(v));
+        return true;
+    };
+    bool pushed = false;
+    switch (type.get_kind()) {
+    case abstract_type::kind::boolean:
+        if (v.size() == 1) {
+            lua_pushboolean(l, v[0] != 0);
+            pushed = true;
+        }
+        break;
+    case abstract_type::kind::byte:
+        pushed = push_integer.operator()<int8_t>();
+        break;
+    case abstract_type::kind::short_kind:
+        pushed = push_integer.operator()<int16_t>();
+        break;
+    case abstract_type::kind::int32:
+        pushed = push_integer.operator()<int32_t>();
+        break;
+    case abstract_type::kind::long_kind:
+    case abstract_type::kind::counter:
+    case abstract_type::kind::time:
+    case abstract_type::kind::timestamp:
+    case abstract_type::kind::date:
+        pushed = push_integer.operator()<int64_t>();
+        break;
+    case abstract_type::kind::simple_date:
+        pushed = push_integer.operator()<uint32_t>();
+        break;
+    case abstract_type::kind::float_kind:
+        if (v.size() == sizeof(float)) {
+            lua_pushnumber(l, std::bit_cast<float>(read_simple_exactly<int32_t>(v)));
+            pushed = true;
+        }
+        break;
+    case abstract_type::kind::double_kind:
+        if (v.size() == sizeof(double)) {
+            lua_pushnumber(l, std::bit_cast<double>(read_simple_exactly<int64_t>(v)));
+            pushed = true;
+        }
+        break;
+    case abstract_type::kind::ascii:
+    case abstract_type::kind::utf8:
+    case abstract_type::kind::bytes:
+        lua_pushlstring(l, reinterpret_cast<const char*>(v.data()), v.size());
+        pushed = true;
+        break;
+    default:
+        break;
+    }
+    if (!pushed) {
+        push_argument(l, type.deserialize(v));
     }
+}
 
+// Resumes the function, whose nargs arguments are already on the stack of l,
+// until it returns
+static future<bytes_opt> resume_script(lua_slice_state l, unsigned nargs, data_type return_type, const lua::runtime_config& cfg) {
     // We don't update the timeout once we start executing the function
     using millisecond = std::chrono::duration<double, std::milli>;
     using duration = std::chrono::system_clock::duration;
@@ -1099,6 +1161,32 @@ future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<d
     });
 }
 
+// run the script for at most max_instructions
+future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<data_value>& values, data_type return_type, const lua::runtime_config& cfg) {
+    lua_slice_state l = load_script(cfg, bitcode);
+    unsigned nargs = values.size();
+    if (!lua_checkstack(l, nargs)) {
+        throw std::runtime_error("could push args to the stack");
+    }
+    for (const data_value& arg : values) {
+        push_argument(l, arg);
+    }
+    return resume_script(std::move(l), nargs, std::move(return_type), cfg);
+}
+
+future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<data_type>& arg_types, std::span<const bytes_opt> params,
+        data_type return_type, const lua::runtime_config& cfg) {
+    lua_slice_state l = load_script(cfg, bitcode);
+    unsigned nargs = params.size();
+    if (!lua_checkstack(l, nargs)) {
+        throw std::runtime_error("could push args to the stack");
+    }
+    for (unsigned i = 0; i != nargs; ++i) {
+        push_serialized_argument(l, *arg_types[i], params[i]);
+    }
+    return resume_script(std::move(l), nargs, std::move(return_type), cfg);
+}
+
 namespace lua {
 
 void register_metatables(lua_State* l) {
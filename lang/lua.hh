@@ -11,6 +11,7 @@
 #include "types/types.hh"
 #include "utils/updateable_value.hh"
 #include <seastar/core/future.hh>
+#include <span>
 
 namespace db {
 class config;
@@ -33,4 +34,7 @@ runtime_config make_runtime_config(const db::config& config);
 sstring compile(const runtime_config& cfg, const std::vector<sstring>& arg_names, sstring script);
 seastar::future<bytes_opt> run_script(bitcode_view bitcode, const std::vector<data_value>& values,
                                       data_type return_type, const runtime_config& cfg);
+// Same as above, with the arguments in their serialized form
+seastar::future<bytes_opt> run_script(bitcode_view bitcode, const std::vector<data_type>& arg_types,
+                                      std::span<const bytes_opt> params, data_type return_type, const runtime_config& cfg);
 }
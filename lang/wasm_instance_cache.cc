@@ -169,6 +169,12 @@ seastar::future<instance_cache::value_type> instance_cache::get(const db::functi
     });
 }
 
+seastar::future<> instance_cache::prewarm(const db::functions::function_name& name, const std::vector<data_type>& arg_types, wasm::context& ctx) {
+    return get(name, arg_types, ctx).then([this] (value_type entry) {
+        recycle(std::move(entry));
+    });
+}
+
 void instance_cache::recycle(instance_cache::value_type val) noexcept {
     // While the instance is in cache, it is not used and no stack is allocated for it.
     free_wasm_stack();
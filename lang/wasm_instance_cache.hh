@@ -37,6 +37,14 @@ struct wasm_instance {
     rust::Box<wasmtime::Func> func;
     rust::Box<wasmtime::Memory> memory;
     module_handle mh;
+    // The ABI for passing values through the linear memory, looked up on
+    // the first call that needs it and reused by the following calls
+    struct abi_info {
+        uint32_t version;
+        std::optional<rust::Box<wasmtime::Func>> malloc_func;
+        std::optional<rust::Box<wasmtime::Func>> free_func;
+    };
+    std::optional<abi_info> abi = std::nullopt;
 };
 
 // For each UDF full name and a scheduling group, we store a wasmtime instance
@@ -128,6 +136,11 @@ class instance_cache {
 
     void recycle(value_type inst) noexcept;
 
+    // Loads an instance of the function for the current scheduling group ahead
+    // of its first call, so that the first queries using a new function don't
+    // pay for instantiating it. The instance is subject to the usual eviction.
+    seastar::future<> prewarm(const db::functions::function_name& name, const std::vector<data_type>& arg_types, wasm::context& ctx);
+
     void remove(const db::functions::function_name& name, const std::vector<data_type>& arg_types) noexcept;
 
 private:
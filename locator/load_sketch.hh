@@ -16,6 +16,7 @@
 #include <seastar/core/smp.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 
+#include <functional>
 #include <optional>
 #include <vector>
 
@@ -23,11 +24,22 @@ namespace locator {
 
 /// A data structure which keeps track of load associated with data ownership
 /// on shards of the whole cluster.
+///
+/// By default every tablet replica counts as a load of 1, so the load of a
+/// shard is its number of tablets. populate() can be given the load of each
+/// tablet instead, e.g. its size on disk or request rate, in which case
+/// next_shard() should be given the expected load of the new tablet, in the
+/// same unit.
 class load_sketch {
     using shard_id = seastar::shard_id;
+public:
+    using load_type = uint64_t;
+    // The load of a replica of the given tablet.
+    using tablet_load_func = std::function<load_type(table_id, tablet_id)>;
+private:
     struct shard_load {
         shard_id id;
-        size_t load; // In tablets.
+        load_type load;
     };
     // Used in a max-heap to yield lower load first.
     struct shard_load_cmp {
@@ -53,12 +65,14 @@ class load_sketch {
         : _tm(std::move(tm)) {
     }
 
-    future<> populate(std::optional<host_id> host = std::nullopt) {
+    future<> populate(std::optional<host_id> host = std::nullopt, tablet_load_func tablet_load = {}) {
         const topology& topo = _tm->get_topology();
         co_await utils::clear_gently(_nodes);
         for (auto&& [table, tmap] : _tm->tablets().all_tables()) {
-            for (const tablet_info& ti : tmap.tablets()) {
+            for (tablet_id tid : tmap.tablet_ids()) {
                 co_await coroutine::maybe_yield();
+                const tablet_info& ti = tmap.get_tablet_info(tid);
+                auto load = tablet_load ? tablet_load(table, tid) : 1;
                 for (auto&& replica : ti.replicas) {
                     if (host && *host != replica.host) {
                         continue;
@@ -68,7 +82,7 @@ class load_sketch {
                     }
                     node_load& n = _nodes.at(replica.host);
                     if (replica.shard < n._shards.size()) {
-                        n._shards[replica.shard].load += 1;
+                        n._shards[replica.shard].load += load;
                     }
                 }
             }
@@ -78,7 +92,9 @@ class load_sketch {
         }
     }
 
-    shard_id next_shard(host_id node) {
+    /// Picks the least loaded shard of \p node for a new tablet replica
+    /// and adds \p load to it.
+    shard_id next_shard(host_id node, load_type load = 1) {
         const topology& topo = _tm->get_topology();
         if (!_nodes.contains(node)) {
             auto shard_count = topo.find_node(node)->get_shard_count();
@@ -91,10 +107,23 @@ class load_sketch {
         std::pop_heap(n._shards.begin(), n._shards.end(), shard_load_cmp());
         shard_load& s = n._shards.back();
         auto shard = s.id;
-        s.load += 1;
+        s.load += load;
         std::push_heap(n._shards.begin(), n._shards.end(), shard_load_cmp());
         return shard;
     }
+
+    /// The total load of the shards of \p node.
+    load_type get_load(host_id node) const {
+        auto it = _nodes.find(node);
+        if (it == _nodes.end()) {
+            return 0;
+        }
+        load_type ret = 0;
+        for (auto&& s : it->second._shards) {
+            ret += s.load;
+        }
+        return ret;
+    }
 };
 
 } // namespace locator
@@ -135,6 +135,72 @@ const tablet_transition_info* tablet_map::get_tablet_transition_info(tablet_id i
     return &i->second;
 }
 
+tablet_map tablet_map::split() const {
+    if (!_transitions.empty()) {
+        throw std::logic_error(format("Cannot split tablets in transition: {}", *this));
+    }
+    tablet_map ret(tablet_count() * 2);
+    for (tablet_id id : tablet_ids()) {
+        auto& info = get_tablet_info(id);
+        ret.set_tablet(tablet_id(size_t(id) * 2), info);
+        ret.set_tablet(tablet_id(size_t(id) * 2 + 1), info);
+    }
+    return ret;
+}
+
+bool tablet_map::can_merge() const {
+    if (tablet_count() < 2 || !_transitions.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < tablet_count(); i += 2) {
+        auto r1 = _tablets[i].replicas;
+        auto r2 = _tablets[i + 1].replicas;
+        auto cmp = [] (const tablet_replica& a, const tablet_replica& b) {
+            return std::tie(a.host, a.shard) < std::tie(b.host, b.shard);
+        };
+        std::sort(r1.begin(), r1.end(), cmp);
+        std::sort(r2.begin(), r2.end(), cmp);
+        if (r1 != r2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+tablet_map tablet_map::merge() const {
+    if (!can_merge()) {
+        throw std::logic_error(format("Cannot merge tablets: {}", *this));
+    }
+    tablet_map ret(tablet_count() / 2);
+    for (tablet_id id : ret.tablet_ids()) {
+        ret.set_tablet(id, get_tablet_info(tablet_id(size_t(id) * 2)));
+    }
+    return ret;
+}
+
+tablet_resize decide_tablet_resize(const tablet_map& tmap, uint64_t table_size, uint64_t target_tablet_size) {
+    auto avg_tablet_size = table_size / tmap.tablet_count();
+    if (avg_tablet_size > target_tablet_size * 2) {
+        return tablet_resize::split;
+    }
+    if (avg_tablet_size < target_tablet_size / 2 && tmap.can_merge()) {
+        return tablet_resize::merge;
+    }
+    return tablet_resize::none;
+}
+
+std::ostream& operator<<(std::ostream& out, tablet_resize r) {
+    switch (r) {
+    case tablet_resize::none:
+        return out << "none";
+    case tablet_resize::split:
+        return out << "split";
+    case tablet_resize::merge:
+        return out << "merge";
+    }
+    return out << "unknown";
+}
+
 std::ostream& operator<<(std::ostream& out, tablet_id id) {
     return out << size_t(id);
 }
@@ -201,8 +267,26 @@ size_t tablet_metadata::external_memory_usage() const {
 }
 
 class tablet_effective_replication_map : public effective_replication_map {
+    struct replica_set_hash {
+        size_t operator()(const inet_address_vector_replica_set& rs) const {
+            size_t h = 0;
+            for (auto&& ep : rs) {
+                h = utils::hash_combine(h, std::hash<gms::inet_address>()(ep));
+            }
+            return h;
+        }
+    };
     table_id _table;
     tablet_sharder _sharder;
+    // The replicas of the tablets, translated to endpoints once per tablet
+    // and interned: the tablets of a table share a few distinct replica sets.
+    // Tablet i has replica set _replica_sets[_tablet_replica_set[i] - 1],
+    // or wasn't looked up yet if _tablet_replica_set[i] is 0.
+    // Filled lazily, since this map is immutable but rebuilt on every
+    // topology change, for every table.
+    mutable utils::chunked_vector<uint32_t> _tablet_replica_set;
+    mutable std::vector<inet_address_vector_replica_set> _replica_sets;
+    mutable std::unordered_map<inet_address_vector_replica_set, uint32_t, replica_set_hash> _replica_set_index;
 private:
     gms::inet_address get_endpoint_for_host_id(host_id host) const {
         auto endpoint_opt = _tmptr->get_endpoint_for_host_id(host);
@@ -234,12 +318,27 @@ class tablet_effective_replication_map : public effective_replication_map {
 
     virtual ~tablet_effective_replication_map() = default;
 
+    const inet_address_vector_replica_set& get_replica_set(const tablet_map& tablets, tablet_id tablet) const {
+        if (_tablet_replica_set.empty()) {
+            _tablet_replica_set.resize(tablets.tablet_count());
+        }
+        auto& idx = _tablet_replica_set[size_t(tablet)];
+        if (!idx) {
+            auto [it, inserted] = _replica_set_index.try_emplace(to_replica_set(tablets.get_tablet_info(tablet).replicas), _replica_sets.size() + 1);
+            if (inserted) {
+                _replica_sets.push_back(it->first);
+            }
+            idx = it->second;
+        }
+        return _replica_sets[idx - 1];
+    }
+
     virtual inet_address_vector_replica_set get_natural_endpoints(const token& search_token) const override {
         auto&& tablets = get_tablet_map();
         auto tablet = tablets.get_tablet_id(search_token);
-        auto&& replicas = tablets.get_tablet_info(tablet).replicas;
-        tablet_logger.trace("get_natural_endpoints({}): table={}, tablet={}, replicas={}", search_token, _table, tablet, replicas);
-        return to_replica_set(replicas);
+        tablet_logger.trace("get_natural_endpoints({}): table={}, tablet={}, replicas={}", search_token, _table, tablet,
+                tablets.get_tablet_info(tablet).replicas);
+        return get_replica_set(tablets, tablet);
     }
 
     virtual inet_address_vector_replica_set get_natural_endpoints_without_node_being_replaced(const token& search_token) const override {
@@ -171,6 +171,23 @@ class tablet_map {
 
     size_t external_memory_usage() const;
 
+    /// Returns a map with twice as many tablets, in which tablet i of this
+    /// map is split into tablets 2i and 2i+1, owning the lower and upper
+    /// half of its tokens, with the replicas of tablet i.
+    ///
+    /// Since the replicas don't change, the data doesn't move.
+    /// \throws std::logic_error If any tablet is in transition.
+    tablet_map split() const;
+
+    /// Returns whether merge() can be called: there are at least two tablets,
+    /// none in transition, and the siblings 2i and 2i+1 have the same replicas.
+    bool can_merge() const;
+
+    /// The inverse of split(): returns a map with half as many tablets, in
+    /// which tablets 2i and 2i+1 of this map are merged into tablet i.
+    /// \throws std::logic_error If !can_merge().
+    tablet_map merge() const;
+
     bool operator==(const tablet_map&) const = default;
 public:
     void set_tablet(tablet_id, tablet_info);
@@ -184,6 +201,20 @@ class tablet_map {
     void check_tablet_id(tablet_id) const;
 };
 
+enum class tablet_resize {
+    none,
+    split,
+    merge,
+};
+
+/// Decides whether the tablets of a table of \p table_size bytes, with tablets \p tmap,
+/// should be split or merged to bring the average tablet size closer to
+/// \p target_tablet_size. The average is let to drift to twice or half the
+/// target before resizing, so that a resize is not immediately undone.
+tablet_resize decide_tablet_resize(const tablet_map& tmap, uint64_t table_size, uint64_t target_tablet_size);
+
+std::ostream& operator<<(std::ostream&, tablet_resize);
+
 /// Holds information about all tablets in the cluster.
 ///
 /// When this instance is obtained via token_metadata_ptr, it is immutable
@@ -58,6 +58,7 @@
 #include "message/messaging_service.hh"
 #include "db/sstables-format-selector.hh"
 #include "db/snapshot-ctl.hh"
+#include "db/cache_warmer.hh"
 #include "cql3/query_processor.hh"
 #include <seastar/net/dns.hh>
 #include <seastar/core/io_queue.hh>
@@ -169,6 +170,12 @@ struct convert<::object_storage_endpoint_param> {
             ep.config.aws->key = node["aws_key"].as<std::string>();
             ep.config.aws->secret = node["aws_secret"].as<std::string>();
         }
+        if (node["upload_part_size"]) {
+            ep.config.upload_part_size = node["upload_part_size"].as<size_t>();
+        }
+        if (node["upload_part_concurrency"]) {
+            ep.config.upload_part_concurrency = node["upload_part_concurrency"].as<unsigned>();
+        }
         return true;
     }
 };
@@ -700,6 +707,9 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             });
 
             logalloc::prime_segment_pool(memory::stats().total_memory(), memory::min_free_memory()).get();
+            if (cfg->lsa_transparent_hugepages()) {
+                logalloc::use_transparent_hugepages().get();
+            }
             logging::apply_settings(cfg->logging_settings(app.options().log_opts));
 
             startlog.info(startup_msg, scylla_version(), get_build_id());
@@ -936,6 +946,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             dbcfg.memtable_to_cache_scheduling_group = make_sched_group("memtable_to_cache", 200);
             dbcfg.gossip_scheduling_group = make_sched_group("gossip", 1000);
             dbcfg.commitlog_scheduling_group = make_sched_group("commitlog", 1000);
+            dbcfg.view_building_scheduling_group = make_sched_group("view_building", 200);
             dbcfg.available_memory = memory::stats().total_memory();
 
             supervisor::notify("starting compaction_manager");
@@ -948,6 +959,10 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     .available_memory = dbcfg.available_memory,
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
+                    .subrange_parallelism = cfg->compaction_subrange_parallelism,
+                    .leveled_parallelism = cfg->compaction_leveled_parallelism,
+                    .latency_sensitive_sched_group = dbcfg.statement_scheduling_group,
+                    .latency_target_us = cfg->compaction_latency_target_us,
                 };
             });
             cm.start(std::move(get_cm_cfg), std::ref(stop_signal.as_sharded_abort_source()), std::ref(task_manager)).get();
@@ -959,6 +974,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             auto stop_sstm = defer_verbose_shutdown("sstables storage manager", [&sstm] {
                 sstm.stop().get();
             });
+            sstm.invoke_on_all(&sstables::storage_manager::start).get();
 
             supervisor::notify("starting database");
             debug::the_database = &db;
@@ -1018,7 +1034,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             cql_config.start(std::ref(*cfg)).get();
 
             supervisor::notify("starting query processor");
-            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560};
+            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560, memory::stats().total_memory() / 2560};
             debug::the_query_processor = &qp;
             auto local_data_dict = seastar::sharded_parameter([] (const replica::database& db) { return db.as_data_dictionary(); }, std::ref(db));
 
@@ -1124,6 +1140,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             } else if (compress_what == "dc") {
                 mscfg.compress = netw::messaging_service::compress_what::dc;
             }
+            mscfg.compress_gossip = cfg->internode_compression_gossip();
 
             if (encrypt == "all") {
                 mscfg.encrypt = netw::messaging_service::encrypt_what::all;
@@ -1136,6 +1153,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             if (!cfg->inter_dc_tcp_nodelay()) {
                 mscfg.tcp_nodelay = netw::messaging_service::tcp_nodelay_what::local;
             }
+            mscfg.shard_aware_connections = cfg->internode_shard_aware_connections();
 
             netw::messaging_service::scheduling_config scfg;
             scfg.statement_tenants = { {dbcfg.statement_scheduling_group, "$user"}, {default_scheduling_group(), "$system"} };
@@ -1207,7 +1225,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             });
 
             raft_gr.start(cfg->consistent_cluster_management(),
-                std::ref(raft_address_map), std::ref(messaging), std::ref(gossiper), std::ref(fd)).get();
+                std::ref(raft_address_map), std::ref(messaging), std::ref(gossiper), std::ref(fd),
+                std::chrono::milliseconds(cfg->direct_failure_detector_min_threshold_in_ms())).get();
 
             // group0 client exists only on shard 0.
             // The client has to be created before `stop_raft` since during
@@ -1439,6 +1458,14 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     cf.trigger_compaction();
                 }
             }).get();
+
+            supervisor::notify("starting cache warmer");
+            static sharded<db::cache_warmer> cache_warmer;
+            cache_warmer.start(std::ref(db), std::ref(sys_ks)).get();
+            auto stop_cache_warmer = defer_verbose_shutdown("cache warmer", [] {
+                cache_warmer.stop().get();
+            });
+            cache_warmer.invoke_on_all(&db::cache_warmer::start).get();
             api::set_server_gossip(ctx, gossiper).get();
             api::set_server_snitch(ctx, snitch).get();
             auto stop_snitch_api = defer_verbose_shutdown("snitch API", [&ctx] {
@@ -1459,8 +1486,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 mm.init_messaging_service();
             }).get();
             supervisor::notify("initializing storage proxy RPC verbs");
-            proxy.invoke_on_all([&messaging, &gossiper, &mm] (service::storage_proxy& proxy) {
-                proxy.start_remote(messaging.local(), gossiper.local(), mm.local());
+            proxy.invoke_on_all([&messaging, &gossiper, &mm, &raft_gr] (service::storage_proxy& proxy) {
+                proxy.start_remote(messaging.local(), gossiper.local(), mm.local(), raft_gr.local());
             }).get();
             auto stop_proxy_handlers = defer_verbose_shutdown("storage proxy RPC verbs", [&proxy] {
                 proxy.invoke_on_all(&service::storage_proxy::stop_remote).get();
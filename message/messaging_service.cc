@@ -29,6 +29,7 @@
 #include "range.hh"
 #include "frozen_schema.hh"
 #include "repair/repair.hh"
+#include "repair/hash_sketch.hh"
 #include "utils/digest_algorithm.hh"
 #include "service/paxos/proposal.hh"
 #include "service/paxos/prepare_response.hh"
@@ -108,6 +109,10 @@
 #include <seastar/rpc/multi_algo_compressor_factory.hh>
 #include "partition_range_compat.hh"
 #include <boost/range/adaptor/filtered.hpp>
+#include <random>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "utils/hash.hh"
 #include <boost/range/adaptor/indirected.hpp>
 #include "mutation/frozen_mutation.hh"
 #include "streaming/stream_manager.hh"
@@ -180,6 +185,10 @@ size_t msg_addr::hash::operator()(const msg_addr& id) const noexcept {
     return std::hash<bytes_view>()(id.addr.bytes());
 }
 
+size_t msg_addr::shard_hash::operator()(const msg_addr& id) const noexcept {
+    return utils::hash_combine(std::hash<bytes_view>()(id.addr.bytes()), id.cpu_id);
+}
+
 messaging_service::shard_info::shard_info(shared_ptr<rpc_protocol_client_wrapper>&& client, bool topo_ignored)
     : rpc_client(std::move(client))
     , topology_ignored(topo_ignored)
@@ -519,7 +528,8 @@ rpc::no_wait_type messaging_service::no_wait() {
 // regardless of whether the peer is in the same DC/Rack or not:
 // - tcp_nodelay
 // - encryption (unless completely disabled in config)
-// - compression (unless completely disabled in config)
+// - compression (unless completely disabled in config, or for these verbs
+//   with internode_compression_gossip)
 //
 // The reason for having topology-independent setting for encryption is to ensure
 // that gossiper verbs can reach the peer, even though the peer may not know our topology yet.
@@ -568,9 +578,11 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::UNUSED__REPLICATION_FINISHED:
     case messaging_verb::UNUSED__REPAIR_CHECKSUM_RANGE:
     case messaging_verb::STREAM_MUTATION_FRAGMENTS:
+    case messaging_verb::STREAM_SSTABLE_FILES:
     case messaging_verb::REPAIR_ROW_LEVEL_START:
     case messaging_verb::REPAIR_ROW_LEVEL_STOP:
     case messaging_verb::REPAIR_GET_FULL_ROW_HASHES:
+    case messaging_verb::REPAIR_GET_ROW_HASH_SKETCH:
     case messaging_verb::REPAIR_GET_COMBINED_ROW_HASH:
     case messaging_verb::REPAIR_GET_SYNC_BOUNDARY:
     case messaging_verb::REPAIR_GET_ROW_DIFF:
@@ -588,9 +600,11 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
         return 1;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
+    case messaging_verb::MUTATION_BATCH:
     case messaging_verb::READ_DATA:
     case messaging_verb::READ_MUTATION_DATA:
     case messaging_verb::READ_DIGEST:
+    case messaging_verb::READ_ABORT:
     case messaging_verb::DEFINITIONS_UPDATE:
     case messaging_verb::TRUNCATE:
     case messaging_verb::MIGRATION_REQUEST:
@@ -767,9 +781,63 @@ gms::inet_address messaging_service::get_public_endpoint_for(const gms::inet_add
     return i != _preferred_to_endpoint.end() ? i->second : ip;
 }
 
+netw::msg_addr messaging_service::client_key(unsigned idx, msg_addr id) const noexcept {
+    // Gossip isn't sharded, and needs as few connections as possible.
+    if (!_cfg.shard_aware_connections || idx == TOPOLOGY_INDEPENDENT_IDX) {
+        return msg_addr(id.addr);
+    }
+    return id;
+}
+
+// Whether a socket can be bound to the address. The connection binds it later,
+// so this can race with other sockets, but it avoids the ports already in use,
+// which would fail the connection with EADDRINUSE.
+static bool local_port_available(const socket_address& addr) {
+    int fd = ::socket(addr.family(), SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    bool bound = ::bind(fd, &addr.as_posix_sockaddr(), addr.length()) == 0;
+    ::close(fd);
+    return bound;
+}
+
+// The server spreads the connections over its shards by their source port,
+// see server_socket::load_balancing_algorithm::port, so binding a port
+// congruent to the destination shard modulo the node's shard count makes the
+// connection land on that shard.
+//
+// Returns 0, for an ephemeral port, if the destination shard is unknown, or
+// if no port tried is free.
+uint16_t messaging_service::shard_aware_local_port(msg_addr id, inet_address local_ip) const {
+    if (!_cfg.shard_aware_connections || !id.cpu_id || !topology_known_for(id.addr)) {
+        return 0;
+    }
+    auto node = _token_metadata->get()->get_topology().find_node(id.addr);
+    unsigned shard_count = node ? node->get_shard_count() : 0;
+    if (id.cpu_id >= shard_count) {
+        return 0;
+    }
+    // Within the default Linux ephemeral port range.
+    static constexpr unsigned low = 32768;
+    static constexpr unsigned high = 60999;
+    static constexpr int max_attempts = 8;
+    static thread_local std::default_random_engine rng{std::random_device{}()};
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+        unsigned port = std::uniform_int_distribution<unsigned>(low, high - shard_count)(rng);
+        port += (id.cpu_id + shard_count - port % shard_count) % shard_count;
+        if (local_port_available(socket_address(local_ip, port))) {
+            return port;
+        }
+    }
+    mlogger.debug("No free local port found for a connection to shard {} of {}, using an ephemeral one", id.cpu_id, id.addr);
+    return 0;
+}
+
 shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::get_rpc_client(messaging_verb verb, msg_addr id) {
     assert(!_shutting_down);
     auto idx = get_rpc_client_idx(verb);
+    id = client_key(idx, id);
     auto it = _clients[idx].find(id);
 
     if (it != _clients[idx].end()) {
@@ -786,7 +854,8 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
     auto my_host_id = _cfg.id;
     auto broadcast_address = utils::fb_utilities::get_broadcast_address();
     bool listen_to_bc = _cfg.listen_on_broadcast_address && _cfg.ip != broadcast_address;
-    auto laddr = socket_address(listen_to_bc ? broadcast_address : _cfg.ip, 0);
+    auto local_ip = listen_to_bc ? broadcast_address : _cfg.ip;
+    auto laddr = socket_address(local_ip, shard_aware_local_port(id, local_ip));
 
     std::optional<bool> topology_status;
     auto has_topology = [&] {
@@ -837,7 +906,11 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
         }
 
         // See comment above `TOPOLOGY_INDEPENDENT_IDX`.
-        if (_cfg.compress == compress_what::all || idx == TOPOLOGY_INDEPENDENT_IDX) {
+        if (idx == TOPOLOGY_INDEPENDENT_IDX) {
+            return _cfg.compress_gossip;
+        }
+
+        if (_cfg.compress == compress_what::all) {
             return true;
         }
 
@@ -921,19 +994,35 @@ void messaging_service::find_and_remove_client(clients_map& clients, msg_addr id
     }
 }
 
+template <typename Fn>
+requires std::is_invocable_r_v<bool, Fn, const messaging_service::shard_info&>
+void messaging_service::find_and_remove_clients(clients_map& clients, inet_address addr, Fn&& filter) {
+    // The connections to all the shards of the node.
+    std::vector<msg_addr> ids;
+    for (auto& [id, _] : clients) {
+        if (id.addr == addr) {
+            ids.push_back(id);
+        }
+    }
+    for (auto& id : ids) {
+        find_and_remove_client(clients, id, filter);
+    }
+}
+
 void messaging_service::remove_error_rpc_client(messaging_verb verb, msg_addr id) {
-    find_and_remove_client(_clients[get_rpc_client_idx(verb)], id, [] (const auto& s) { return s.rpc_client->error(); });
+    auto idx = get_rpc_client_idx(verb);
+    find_and_remove_client(_clients[idx], client_key(idx, id), [] (const auto& s) { return s.rpc_client->error(); });
 }
 
 void messaging_service::remove_rpc_client(msg_addr id) {
     for (auto& c : _clients) {
-        find_and_remove_client(c, id, [] (const auto&) { return true; });
+        find_and_remove_clients(c, id.addr, [] (const auto&) { return true; });
     }
 }
 
 void messaging_service::remove_rpc_client_with_ignored_topology(msg_addr id) {
     for (auto& c : _clients) {
-        find_and_remove_client(c, id, [id] (const auto& s) {
+        find_and_remove_clients(c, id.addr, [id] (const auto& s) {
             if (s.topology_ignored) {
                 mlogger.info("Dropping connection to {} because it was created without topology information", id.addr);
             }
@@ -975,6 +1064,35 @@ future<> messaging_service::unregister_stream_mutation_fragments() {
     return unregister_handler(messaging_verb::STREAM_MUTATION_FRAGMENTS);
 }
 
+rpc::sink<int32_t> messaging_service::make_sink_for_stream_sstable_files(rpc::source<streaming::stream_sstable_files_cmd, sstring, bytes>& source) {
+    return source.make_sink<netw::serializer, int32_t>();
+}
+
+future<std::tuple<rpc::sink<streaming::stream_sstable_files_cmd, sstring, bytes>, rpc::source<int32_t>>>
+messaging_service::make_sink_and_source_for_stream_sstable_files(table_schema_version schema_id, streaming::plan_id plan_id, table_id cf_id, streaming::stream_reason reason, msg_addr id) {
+    using value_type = std::tuple<rpc::sink<streaming::stream_sstable_files_cmd, sstring, bytes>, rpc::source<int32_t>>;
+    if (is_shutting_down()) {
+        return make_exception_future<value_type>(rpc::closed_error());
+    }
+    auto rpc_client = get_rpc_client(messaging_verb::STREAM_SSTABLE_FILES, id);
+    return rpc_client->make_stream_sink<netw::serializer, streaming::stream_sstable_files_cmd, sstring, bytes>().then([this, plan_id, schema_id, cf_id, reason, rpc_client] (rpc::sink<streaming::stream_sstable_files_cmd, sstring, bytes> sink) mutable {
+        auto rpc_handler = rpc()->make_client<rpc::source<int32_t> (streaming::plan_id, table_schema_version, table_id, streaming::stream_reason, rpc::sink<streaming::stream_sstable_files_cmd, sstring, bytes>)>(messaging_verb::STREAM_SSTABLE_FILES);
+        return rpc_handler(*rpc_client, plan_id, schema_id, cf_id, reason, sink).then_wrapped([sink, rpc_client] (future<rpc::source<int32_t>> source) mutable {
+            return (source.failed() ? sink.close() : make_ready_future<>()).then([sink = std::move(sink), source = std::move(source)] () mutable {
+                return make_ready_future<value_type>(value_type(std::move(sink), source.get0()));
+            });
+        });
+    });
+}
+
+void messaging_service::register_stream_sstable_files(std::function<future<rpc::sink<int32_t>> (const rpc::client_info& cinfo, streaming::plan_id plan_id, table_schema_version schema_id, table_id cf_id, streaming::stream_reason reason, rpc::source<streaming::stream_sstable_files_cmd, sstring, bytes> source)>&& func) {
+    register_handler(this, messaging_verb::STREAM_SSTABLE_FILES, std::move(func));
+}
+
+future<> messaging_service::unregister_stream_sstable_files() {
+    return unregister_handler(messaging_verb::STREAM_SSTABLE_FILES);
+}
+
 template<class SinkType, class SourceType>
 future<std::tuple<rpc::sink<SinkType>, rpc::source<SourceType>>>
 do_make_sink_source(messaging_verb verb, uint32_t repair_meta_id, shared_ptr<messaging_service::rpc_protocol_client_wrapper> rpc_client, std::unique_ptr<messaging_service::rpc_protocol_wrapper>& rpc) {
@@ -1245,6 +1363,17 @@ future<repair_hash_set> messaging_service::send_repair_get_full_row_hashes(msg_a
     return send_message<future<repair_hash_set>>(this, messaging_verb::REPAIR_GET_FULL_ROW_HASHES, std::move(id), repair_meta_id);
 }
 
+// Wrapper for REPAIR_GET_ROW_HASH_SKETCH
+void messaging_service::register_repair_get_row_hash_sketch(std::function<future<repair_hash_sketch> (const rpc::client_info& cinfo, uint32_t repair_meta_id, uint32_t nr_cells)>&& func) {
+    register_handler(this, messaging_verb::REPAIR_GET_ROW_HASH_SKETCH, std::move(func));
+}
+future<> messaging_service::unregister_repair_get_row_hash_sketch() {
+    return unregister_handler(messaging_verb::REPAIR_GET_ROW_HASH_SKETCH);
+}
+future<repair_hash_sketch> messaging_service::send_repair_get_row_hash_sketch(msg_addr id, uint32_t repair_meta_id, uint32_t nr_cells) {
+    return send_message<future<repair_hash_sketch>>(this, messaging_verb::REPAIR_GET_ROW_HASH_SKETCH, std::move(id), repair_meta_id, nr_cells);
+}
+
 // Wrapper for REPAIR_GET_COMBINED_ROW_HASH
 void messaging_service::register_repair_get_combined_row_hash(std::function<future<get_combined_row_hash_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, std::optional<repair_sync_boundary> common_sync_boundary)>&& func) {
     register_handler(this, messaging_verb::REPAIR_GET_COMBINED_ROW_HASH, std::move(func));
@@ -1289,14 +1418,14 @@ future<> messaging_service::send_repair_put_row_diff(msg_addr id, uint32_t repai
 }
 
 // Wrapper for REPAIR_ROW_LEVEL_START
-void messaging_service::register_repair_row_level_start(std::function<future<repair_row_level_start_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason)>&& func) {
+void messaging_service::register_repair_row_level_start(std::function<future<repair_row_level_start_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason, rpc::optional<tasks::task_id> incremental_repair_id)>&& func) {
     register_handler(this, messaging_verb::REPAIR_ROW_LEVEL_START, std::move(func));
 }
 future<> messaging_service::unregister_repair_row_level_start() {
     return unregister_handler(messaging_verb::REPAIR_ROW_LEVEL_START);
 }
-future<rpc::optional<repair_row_level_start_response>> messaging_service::send_repair_row_level_start(msg_addr id, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, streaming::stream_reason reason) {
-    return send_message<rpc::optional<repair_row_level_start_response>>(this, messaging_verb::REPAIR_ROW_LEVEL_START, std::move(id), repair_meta_id, std::move(keyspace_name), std::move(cf_name), std::move(range), algo, max_row_buf_size, seed, remote_shard, remote_shard_count, remote_ignore_msb, std::move(remote_partitioner_name), std::move(schema_version), reason);
+future<rpc::optional<repair_row_level_start_response>> messaging_service::send_repair_row_level_start(msg_addr id, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, streaming::stream_reason reason, tasks::task_id incremental_repair_id) {
+    return send_message<rpc::optional<repair_row_level_start_response>>(this, messaging_verb::REPAIR_ROW_LEVEL_START, std::move(id), repair_meta_id, std::move(keyspace_name), std::move(cf_name), std::move(range), algo, max_row_buf_size, seed, remote_shard, remote_shard_count, remote_ignore_msb, std::move(remote_partitioner_name), std::move(schema_version), reason, incremental_repair_id);
 }
 
 // Wrapper for REPAIR_ROW_LEVEL_STOP
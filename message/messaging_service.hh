@@ -20,6 +20,7 @@
 #include "schema/schema_fwd.hh"
 #include "streaming/stream_fwd.hh"
 #include "locator/host_id.hh"
+#include "tasks/types.hh"
 
 #include <list>
 #include <vector>
@@ -32,6 +33,7 @@
 namespace streaming {
     class prepare_message;
     enum class stream_mutation_fragments_cmd : uint8_t;
+    enum class stream_sstable_files_cmd : uint8_t;
 }
 
 namespace gms {
@@ -87,6 +89,7 @@ class frozen_mutation_fragment;
 class repair_hash;
 using get_combined_row_hash_response = repair_hash;
 using repair_hash_set = absl::btree_set<repair_hash>;
+class repair_hash_sketch;
 class repair_sync_boundary;
 class get_sync_boundary_response;
 class partition_key_and_mutation_fragments;
@@ -182,7 +185,11 @@ enum class messaging_verb : int32_t {
     DIRECT_FD_PING = 63,
     RAFT_TOPOLOGY_CMD = 64,
     RAFT_PULL_TOPOLOGY_SNAPSHOT = 65,
-    LAST = 66,
+    READ_ABORT = 66,
+    STREAM_SSTABLE_FILES = 67,
+    MUTATION_BATCH = 68,
+    REPAIR_GET_ROW_HASH_SKETCH = 69,
+    LAST = 70,
 };
 
 } // namespace netw
@@ -219,7 +226,8 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
 
     using msg_addr = netw::msg_addr;
     using inet_address = gms::inet_address;
-    using clients_map = std::unordered_map<msg_addr, shard_info, msg_addr::hash>;
+    // Keyed by shard too when the connections are shard-aware, see client_key().
+    using clients_map = std::unordered_map<msg_addr, shard_info, msg_addr::shard_hash, msg_addr::shard_equal>;
 
     // This should change only if serialization format changes
     static constexpr int32_t current_version = 0;
@@ -268,9 +276,15 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
         uint16_t ssl_port = 0;
         encrypt_what encrypt = encrypt_what::none;
         compress_what compress = compress_what::none;
+        // Whether to compress the topology-independent connection of the
+        // gossip verbs, if compression is enabled at all.
+        bool compress_gossip = true;
         tcp_nodelay_what tcp_nodelay = tcp_nodelay_what::all;
         bool listen_on_broadcast_address = false;
         size_t rpc_memory_limit = 1'000'000;
+        // Open a connection to each shard of a node messages are addressed
+        // to, so that they are received by the shard they are for.
+        bool shard_aware_connections = false;
     };
 
     struct scheduling_config {
@@ -365,6 +379,14 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     rpc::sink<int32_t> make_sink_for_stream_mutation_fragments(rpc::source<frozen_mutation_fragment, rpc::optional<streaming::stream_mutation_fragments_cmd>>& source);
     future<std::tuple<rpc::sink<frozen_mutation_fragment, streaming::stream_mutation_fragments_cmd>, rpc::source<int32_t>>> make_sink_and_source_for_stream_mutation_fragments(table_schema_version schema_id, streaming::plan_id plan_id, table_id cf_id, uint64_t estimated_partitions, streaming::stream_reason reason, msg_addr id);
 
+    // Wrapper for STREAM_SSTABLE_FILES
+    // Like STREAM_MUTATION_FRAGMENTS, but ships whole sstables as they are stored on disk, see streaming::stream_sstable_files_cmd.
+    // The receiver sends a status code when done, 0 means successful, -1 means error.
+    void register_stream_sstable_files(std::function<future<rpc::sink<int32_t>> (const rpc::client_info& cinfo, streaming::plan_id plan_id, table_schema_version schema_id, table_id cf_id, streaming::stream_reason reason, rpc::source<streaming::stream_sstable_files_cmd, sstring, bytes> source)>&& func);
+    future<> unregister_stream_sstable_files();
+    rpc::sink<int32_t> make_sink_for_stream_sstable_files(rpc::source<streaming::stream_sstable_files_cmd, sstring, bytes>& source);
+    future<std::tuple<rpc::sink<streaming::stream_sstable_files_cmd, sstring, bytes>, rpc::source<int32_t>>> make_sink_and_source_for_stream_sstable_files(table_schema_version schema_id, streaming::plan_id plan_id, table_id cf_id, streaming::stream_reason reason, msg_addr id);
+
     // Wrapper for REPAIR_GET_ROW_DIFF_WITH_RPC_STREAM
     future<std::tuple<rpc::sink<repair_hash_with_cmd>, rpc::source<repair_row_on_wire_with_cmd>>> make_sink_and_source_for_repair_get_row_diff_with_rpc_stream(uint32_t repair_meta_id, msg_addr id);
     rpc::sink<repair_row_on_wire_with_cmd> make_sink_for_repair_get_row_diff_with_rpc_stream(rpc::source<repair_hash_with_cmd>& source);
@@ -396,6 +418,11 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     future<> unregister_repair_get_full_row_hashes();
     future<repair_hash_set> send_repair_get_full_row_hashes(msg_addr id, uint32_t repair_meta_id);
 
+    // Wrapper for REPAIR_GET_ROW_HASH_SKETCH
+    void register_repair_get_row_hash_sketch(std::function<future<repair_hash_sketch> (const rpc::client_info& cinfo, uint32_t repair_meta_id, uint32_t nr_cells)>&& func);
+    future<> unregister_repair_get_row_hash_sketch();
+    future<repair_hash_sketch> send_repair_get_row_hash_sketch(msg_addr id, uint32_t repair_meta_id, uint32_t nr_cells);
+
     // Wrapper for REPAIR_GET_COMBINED_ROW_HASH
     void register_repair_get_combined_row_hash(std::function<future<get_combined_row_hash_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, std::optional<repair_sync_boundary> common_sync_boundary)>&& func);
     future<> unregister_repair_get_combined_row_hash();
@@ -417,9 +444,9 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     future<> send_repair_put_row_diff(msg_addr id, uint32_t repair_meta_id, repair_rows_on_wire row_diff);
 
     // Wrapper for REPAIR_ROW_LEVEL_START
-    void register_repair_row_level_start(std::function<future<repair_row_level_start_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason)>&& func);
+    void register_repair_row_level_start(std::function<future<repair_row_level_start_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason, rpc::optional<tasks::task_id> incremental_repair_id)>&& func);
     future<> unregister_repair_row_level_start();
-    future<rpc::optional<repair_row_level_start_response>> send_repair_row_level_start(msg_addr id, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, streaming::stream_reason reason);
+    future<rpc::optional<repair_row_level_start_response>> send_repair_row_level_start(msg_addr id, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed, unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, streaming::stream_reason reason, tasks::task_id incremental_repair_id);
 
     // Wrapper for REPAIR_ROW_LEVEL_STOP
     void register_repair_row_level_stop(std::function<future<> (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range)>&& func);
@@ -512,6 +539,11 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     template <typename Fn>
     requires std::is_invocable_r_v<bool, Fn, const shard_info&>
     void find_and_remove_client(clients_map& clients, msg_addr id, Fn&& filter);
+    template <typename Fn>
+    requires std::is_invocable_r_v<bool, Fn, const shard_info&>
+    void find_and_remove_clients(clients_map& clients, inet_address addr, Fn&& filter);
+    msg_addr client_key(unsigned idx, msg_addr id) const noexcept;
+    uint16_t shard_aware_local_port(msg_addr id, inet_address local_ip) const;
     void do_start_listen();
 
     bool topology_known_for(inet_address) const;
@@ -22,6 +22,16 @@ struct msg_addr {
     struct hash {
         size_t operator()(const msg_addr& id) const noexcept;
     };
+    // Unlike operator== and hash, which only consider the address, tell
+    // apart the shards of a node, for shard-aware connections.
+    struct shard_hash {
+        size_t operator()(const msg_addr& id) const noexcept;
+    };
+    struct shard_equal {
+        bool operator()(const msg_addr& x, const msg_addr& y) const noexcept {
+            return x.addr == y.addr && x.cpu_id == y.cpu_id;
+        }
+    };
     explicit msg_addr(gms::inet_address ip) noexcept : addr(ip), cpu_id(0) { }
     msg_addr(gms::inet_address ip, uint32_t cpu) noexcept : addr(ip), cpu_id(cpu) { }
 };
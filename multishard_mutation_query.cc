@@ -500,7 +500,7 @@ read_context::dismantle_buffer_stats read_context::dismantle_compaction_state(de
 
 future<> read_context::save_reader(shard_id shard, full_position_view last_pos) {
   return do_with(std::exchange(_readers[shard], {}), [this, shard, last_pos] (reader_meta& rm) mutable {
-    return _db.invoke_on(shard, [query_uuid = _cmd.query_uuid, query_ranges = _ranges, &rm,
+    return _db.invoke_on(shard, [query_uuid = _cmd.query_uuid, active_scan = !_cmd.is_first_page, query_ranges = _ranges, &rm,
             last_pos, gts = tracing::global_trace_state_ptr(_trace_state)] (replica::database& db) mutable {
         try {
             auto rparts = rm.rparts.release(); // avoid another round-trip when destroying rparts
@@ -543,7 +543,7 @@ future<> read_context::save_reader(shard_id shard, full_position_view last_pos)
                     std::move(rparts->permit),
                     last_pos);
 
-            db.get_querier_cache().insert_shard_querier(query_uuid, std::move(querier), gts.get());
+            db.get_querier_cache().insert_shard_querier(query_uuid, std::move(querier), gts.get(), bool(active_scan));
 
             db.get_stats().multishard_query_unpopped_fragments += fragments;
             db.get_stats().multishard_query_unpopped_bytes += (size_after - size_before);
@@ -751,6 +751,9 @@ future<page_consume_result<ResultBuilder>> read_page(
                 cstats.clustering_rows.live,
                 cstats.clustering_rows.dead,
                 cstats.range_tombstones);
+        if (auto* profile = tracing::get_read_profile(trace_state)) {
+            profile->tombstones += cstats.static_rows.dead + cstats.clustering_rows.dead + cstats.range_tombstones;
+        }
         auto buffer = reader.detach_buffer();
         co_await reader.close();
         // page_consume_result cannot fail so there's no risk of double-closing reader.
@@ -773,6 +776,8 @@ future<typename ResultBuilder::result_type> do_query(
     auto& table = db.local().find_column_family(s);
     auto erm = table.get_effective_replication_map();
     auto ctx = seastar::make_shared<read_context>(db, s, erm, cmd, ranges, trace_state, timeout);
+    replica::database::abortable_read abortable(db.local(), cmd.query_uuid);
+    abortable.set_permit(ctx->permit());
 
     // Use coroutine::as_future to prevent exception on timesout.
     auto f = co_await coroutine::as_future(ctx->lookup_readers(timeout).then([&, result_builder_factory = std::move(result_builder_factory)] () mutable {
@@ -134,40 +134,47 @@ void mutation_fragment::destroy_data() noexcept
 }
 
 mutation_fragment_v2::mutation_fragment_v2(const schema& s, reader_permit permit, static_row&& r)
-    : _kind(kind::static_row), _data(std::make_unique<data>(std::move(permit)))
+    : _kind(kind::static_row), _data(make_data(std::move(permit)))
 {
     new (&_data->_static_row) static_row(std::move(r));
     reset_memory(s);
 }
 
 mutation_fragment_v2::mutation_fragment_v2(const schema& s, reader_permit permit, clustering_row&& r)
-    : _kind(kind::clustering_row), _data(std::make_unique<data>(std::move(permit)))
+    : _kind(kind::clustering_row), _data(make_data(std::move(permit)))
 {
     new (&_data->_clustering_row) clustering_row(std::move(r));
     reset_memory(s);
 }
 
 mutation_fragment_v2::mutation_fragment_v2(const schema& s, reader_permit permit, range_tombstone_change&& r)
-    : _kind(kind::range_tombstone_change), _data(std::make_unique<data>(std::move(permit)))
+    : _kind(kind::range_tombstone_change), _data(make_data(std::move(permit)))
 {
     new (&_data->_range_tombstone_chg) range_tombstone_change(std::move(r));
     reset_memory(s);
 }
 
 mutation_fragment_v2::mutation_fragment_v2(const schema& s, reader_permit permit, partition_start&& r)
-        : _kind(kind::partition_start), _data(std::make_unique<data>(std::move(permit)))
+        : _kind(kind::partition_start), _data(make_data(std::move(permit)))
 {
     new (&_data->_partition_start) partition_start(std::move(r));
     reset_memory(s);
 }
 
 mutation_fragment_v2::mutation_fragment_v2(const schema& s, reader_permit permit, partition_end&& r)
-        : _kind(kind::partition_end), _data(std::make_unique<data>(std::move(permit)))
+        : _kind(kind::partition_end), _data(make_data(std::move(permit)))
 {
     new (&_data->_partition_end) partition_end(std::move(r));
     reset_memory(s);
 }
 
+void mutation_fragment_v2::data_deleter::operator()(data* d) const noexcept {
+    // Keep the permit, which owns the memory, alive until it is given back
+    auto permit = d->_memory.permit();
+    d->~data();
+    permit.deallocate_transient(d, sizeof(data));
+}
+
 void mutation_fragment_v2::destroy_data() noexcept
 {
     switch (_kind) {
@@ -498,3 +505,4 @@ void appending_hash<mutation_fragment>::operator()(Hasher& h, const mutation_fra
 
 // Instantiation for repair/row_level.cc
 template void appending_hash<mutation_fragment>::operator()<xx_hasher>(xx_hasher& h, const mutation_fragment& cells, const schema& s) const;
+template void appending_hash<mutation_fragment>::operator()<xxh3_hasher>(xxh3_hasher& h, const mutation_fragment& cells, const schema& s) const;
@@ -834,7 +834,7 @@ void appending_hash<row>::operator()(Hasher& h, const row& cells, const schema&
                 if (cell_and_hash->hash) {
                     feed_hash(h, *cell_and_hash->hash);
                 } else {
-                    Hasher cellh;
+                    query::default_hasher cellh;
                     feed_hash(cellh, cell_and_hash->cell.as_atomic_cell(def), def);
                     feed_hash(h, cellh.finalize_uint64());
                 }
@@ -848,7 +848,7 @@ void appending_hash<row>::operator()(Hasher& h, const row& cells, const schema&
                 if (cell_and_hash->hash) {
                     feed_hash(h, *cell_and_hash->hash);
                 } else {
-                    Hasher cellh;
+                    query::default_hasher cellh;
                     feed_hash(cellh, cm, def);
                     feed_hash(h, cellh.finalize_uint64());
                 }
@@ -860,6 +860,7 @@ void appending_hash<row>::operator()(Hasher& h, const row& cells, const schema&
 }
 // Instantiation for mutation_test.cc
 template void appending_hash<row>::operator()<xx_hasher>(xx_hasher& h, const row& cells, const schema& s, column_kind kind, const query::column_id_vector& columns, max_timestamp& max_ts) const;
+template void appending_hash<row>::operator()<xxh3_hasher>(xxh3_hasher& h, const row& cells, const schema& s, column_kind kind, const query::column_id_vector& columns, max_timestamp& max_ts) const;
 
 template<>
 void appending_hash<row>::operator()<legacy_xx_hasher_without_null_digest>(legacy_xx_hasher_without_null_digest& h, const row& cells, const schema& s, column_kind kind, const query::column_id_vector& columns, max_timestamp& max_ts) const {
@@ -1575,7 +1576,12 @@ void rows_entry::compact(const schema& s, tombstone t) {
                              gc_clock::time_point::min(),  // no TTL expiration
                              never_gc,                     // no GC
                              gc_clock::time_point::min()); // no GC
-    // FIXME: Purge redundant _range_tombstone
+    // The interval is covered by t anyway. Without the range tombstone, readers
+    // and flushes don't emit it, and mutation_partition_v2::maybe_drop() can
+    // remove the entry where continuity allows.
+    if (_range_tombstone <= t) {
+        _range_tombstone = {};
+    }
 }
 
 void rows_entry::replace_with(rows_entry&& o) noexcept {
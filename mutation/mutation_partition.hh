@@ -945,7 +945,9 @@ class rows_entry final : public evictable {
         // Marks a dummy entry which is after_all_clustered_rows() position.
         // Needed so that eviction, which can't use comparators, can check if it's dealing with it.
         bool _last_dummy : 1;
-        flags() : _before_ck(0), _after_ck(0), _continuous(true), _dummy(false), _last_dummy(false) { }
+        // In the protected segment of the cache lru.
+        bool _lru_protected : 1;
+        flags() : _before_ck(0), _after_ck(0), _continuous(true), _dummy(false), _last_dummy(false), _lru_protected(false) { }
     } _flags{};
 public:
     struct last_dummy_tag {};
@@ -1070,6 +1072,12 @@ class rows_entry final : public evictable {
     void on_evicted(cache_tracker&) noexcept;
     void on_evicted() noexcept override;
 
+    bool lru_protected() const noexcept override { return _flags._lru_protected; }
+    bool set_lru_protected(bool v) noexcept override {
+        _flags._lru_protected = v;
+        return true;
+    }
+
     void compact(const schema&, tombstone);
 
     class printer {
@@ -1092,12 +1100,15 @@ struct mutation_application_stats {
     uint64_t row_writes = 0;
     uint64_t rows_compacted_with_tombstones = 0;
     uint64_t rows_dropped_by_tombstones = 0;
+    // Rows inserted after all the rows of the partition, without a search
+    uint64_t rows_appended = 0;
 
     mutation_application_stats& operator+=(const mutation_application_stats& other) {
         row_hits += other.row_hits;
         row_writes += other.row_writes;
         rows_compacted_with_tombstones += other.rows_compacted_with_tombstones;
         rows_dropped_by_tombstones += other.rows_dropped_by_tombstones;
+        rows_appended += other.rows_appended;
         return *this;
     }
 };
@@ -172,7 +172,6 @@ stop_iteration mutation_partition_v2::apply_monotonically(const schema& s, const
         if (prev_i != _rows.end()) {
             maybe_drop(s, tracker, prev_i, app_stats);
         }
-        // TODO: Drop redundant range tombstones
         p._tombstone = {};
     }
 
@@ -261,9 +260,19 @@ stop_iteration mutation_partition_v2::apply_monotonically(const schema& s, const
         if (i != _rows.end()) {
             auto x = cmp(*i, src_e);
             if (x < 0) {
-                bool match;
-                i = _rows.lower_bound(src_e, match, cmp);
-                miss = !match;
+                // Rows of time-series partitions are written in clustering order,
+                // after all the rows already in the memtable, so check the last
+                // row before searching the tree. It's one extra comparison for
+                // rows written out of order.
+                auto last = std::prev(_rows.end());
+                if (last == i || cmp(*last, src_e) < 0) {
+                    i = _rows.end();
+                    ++app_stats.rows_appended;
+                } else {
+                    bool match;
+                    i = _rows.lower_bound(src_e, match, cmp);
+                    miss = !match;
+                }
             } else {
                 miss = x > 0;
             }
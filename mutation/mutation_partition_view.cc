@@ -87,7 +87,8 @@ atomic_cell read_atomic_cell(const abstract_type& type, atomic_cell_variant cv,
     return boost::apply_visitor(atomic_cell_visitor(type, cm), cv);
 }
 
-collection_mutation read_collection_cell(const abstract_type& type, ser::collection_cell_view cv)
+// The collection is serialized in the `out` allocator; the rest in the current one.
+collection_mutation read_collection_cell(const abstract_type& type, ser::collection_cell_view cv, allocation_strategy& out)
 {
     collection_mutation_description mut;
     mut.tomb = cv.tomb();
@@ -115,7 +116,9 @@ collection_mutation read_collection_cell(const abstract_type& type, ser::collect
         }
     ));
 
-    return mut.serialize(type);
+    return with_allocator(out, [&] {
+        return mut.serialize(type);
+    });
 }
 
 template<typename Visitor>
@@ -143,14 +146,14 @@ void read_and_visit_row(ser::row_view rv, const column_mapping& cm, column_kind
                 if (_col.is_atomic()) {
                     throw std::runtime_error("An atomic cell expected, got a collection");
                 }
-                // FIXME: Pass view to cell to avoid copy
+                // The cells are gathered in the standard allocator, but the
+                // serialized collection is built in the caller's one, so that
+                // visitors which keep it can take it without another copy.
                 auto&& outer = current_allocator();
-                with_allocator(standard_allocator(), [&] {
-                    auto cell = read_collection_cell(*_col.type(), ccv);
-                    with_allocator(outer, [&] {
-                        _visitor.accept_collection(_id, cell);
-                    });
+                auto cell = with_allocator(standard_allocator(), [&] {
+                    return read_collection_cell(*_col.type(), ccv, outer);
                 });
+                _visitor.accept_collection(_id, std::move(cell));
             }
             void operator()(ser::unknown_variant_type&) const {
                 throw std::runtime_error("Trying to deserialize unknown cell type");
@@ -199,8 +202,8 @@ void mutation_partition_view::do_accept(const column_mapping& cm, Visitor& visit
         void accept_atomic_cell(column_id id, atomic_cell ac) const {
            _visitor.accept_static_cell(id, std::move(ac));
         }
-        void accept_collection(column_id id, const collection_mutation& cm) const {
-           _visitor.accept_static_cell(id, cm);
+        void accept_collection(column_id id, collection_mutation&& cm) const {
+           _visitor.accept_static_cell(id, std::move(cm));
         }
     };
     read_and_visit_row(mpv.static_row(), cm, column_kind::static_column, static_row_cell_visitor{visitor});
@@ -219,8 +222,8 @@ void mutation_partition_view::do_accept(const column_mapping& cm, Visitor& visit
             void accept_atomic_cell(column_id id, atomic_cell ac) const {
                _visitor.accept_row_cell(id, std::move(ac));
             }
-            void accept_collection(column_id id, const collection_mutation& cm) const {
-               _visitor.accept_row_cell(id, cm);
+            void accept_collection(column_id id, collection_mutation&& cm) const {
+               _visitor.accept_row_cell(id, std::move(cm));
             }
         };
         read_and_visit_row(cr.cells(), cm, column_kind::regular_column, cell_visitor{visitor});
@@ -42,6 +42,11 @@ class shard_writer {
 // ready when all the mutation_fragments are consumed.
 class multishard_writer {
 private:
+    // Fragments cross to the shard of their partition one buffer of the
+    // queue reader at a time, so each cross-shard round trip moves this
+    // much data rather than the default reader buffer size.
+    static constexpr size_t shard_buffer_size = 128 * 1024;
+
     schema_ptr _s;
     std::vector<foreign_ptr<std::unique_ptr<shard_writer>>> _shard_writers;
     std::vector<future<>> _pending_consumers;
@@ -107,6 +112,7 @@ multishard_writer::multishard_writer(
 
 future<> multishard_writer::make_shard_writer(unsigned shard) {
     auto [reader, handle] = make_queue_reader_v2(_s, _producer.permit());
+    reader.set_max_buffer_size(shard_buffer_size);
     _queue_reader_handles[shard] = std::move(handle);
     return smp::submit_to(shard, [gs = global_schema_ptr(_s),
             consumer = _consumer,
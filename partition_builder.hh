@@ -49,6 +49,11 @@ class partition_builder final : public mutation_partition_visitor {
         r.append_cell(id, collection_mutation(*_schema.static_column_at(id).type, std::move(collection)));
     }
 
+    void accept_static_cell(column_id id, collection_mutation&& collection) {
+        row& r = _partition.static_row().maybe_create();
+        r.append_cell(id, std::move(collection));
+    }
+
     virtual void accept_row_tombstone(const range_tombstone& rt) override {
         _partition.apply_row_tombstone(_schema, rt);
     }
@@ -74,4 +79,9 @@ class partition_builder final : public mutation_partition_visitor {
         row& r = _current_row->cells();
         r.append_cell(id, collection_mutation(*_schema.regular_column_at(id).type, std::move(collection)));
     }
+
+    void accept_row_cell(column_id id, collection_mutation&& collection) {
+        row& r = _current_row->cells();
+        r.append_cell(id, std::move(collection));
+    }
 };
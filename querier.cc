@@ -174,6 +174,8 @@ static can_use can_be_used_for_page(const Querier& q, const schema& s, const dht
 
 // The time-to-live of a cache-entry.
 const std::chrono::seconds querier_cache::default_entry_ttl{10};
+// The time-to-live of a shard querier of a multishard scan past its first page.
+const std::chrono::seconds querier_cache::default_active_scan_entry_ttl{60};
 
 static std::unique_ptr<querier_base> find_querier(querier_cache::index& index, query_id key,
         dht::partition_ranges_view ranges, tracing::trace_state_ptr trace_state) {
@@ -198,8 +200,25 @@ static std::unique_ptr<querier_base> find_querier(querier_cache::index& index, q
     return ptr;
 }
 
-querier_cache::querier_cache(std::chrono::seconds entry_ttl)
-    : _entry_ttl(entry_ttl) {
+querier_cache::querier_cache(std::chrono::seconds entry_ttl, std::chrono::seconds active_scan_entry_ttl)
+    : _entry_ttl(entry_ttl)
+    , _active_scan_entry_ttl(active_scan_entry_ttl) {
+}
+
+void querier_cache::note_eviction(query_id key) {
+    if (_recently_evicted.size() == max_recently_evicted) {
+        _recently_evicted.pop_front();
+    }
+    _recently_evicted.push_back(key);
+}
+
+bool querier_cache::was_evicted(query_id key) {
+    auto it = std::find(_recently_evicted.begin(), _recently_evicted.end(), key);
+    if (it == _recently_evicted.end()) {
+        return false;
+    }
+    _recently_evicted.erase(it);
+    return true;
 }
 
 struct querier_utils {
@@ -260,14 +279,16 @@ void querier_cache::insert_querier(
         --stats.population;
     });
 
-    auto notify_handler = [&stats, &index, it] (reader_concurrency_semaphore::evict_reason reason) {
+    auto notify_handler = [this, &stats, &index, it, key] (reader_concurrency_semaphore::evict_reason reason) {
         index.erase(it);
         switch (reason) {
             case reader_concurrency_semaphore::evict_reason::permit:
                 ++stats.resource_based_evictions;
+                note_eviction(key);
                 break;
             case reader_concurrency_semaphore::evict_reason::time:
                 ++stats.time_based_evictions;
+                note_eviction(key);
                 break;
             case reader_concurrency_semaphore::evict_reason::manual:
                 break;
@@ -296,8 +317,9 @@ void querier_cache::insert_mutation_querier(query_id key, querier&& q, tracing::
     insert_querier(key, _mutation_querier_index, _stats, std::move(q), _entry_ttl, std::move(trace_state));
 }
 
-void querier_cache::insert_shard_querier(query_id key, shard_mutation_querier&& q, tracing::trace_state_ptr trace_state) {
-    insert_querier(key, _shard_mutation_querier_index, _stats, std::move(q), _entry_ttl, std::move(trace_state));
+void querier_cache::insert_shard_querier(query_id key, shard_mutation_querier&& q, tracing::trace_state_ptr trace_state, bool active_scan) {
+    insert_querier(key, _shard_mutation_querier_index, _stats, std::move(q), active_scan ? _active_scan_entry_ttl : _entry_ttl,
+            std::move(trace_state));
 }
 
 template <typename Querier>
@@ -314,6 +336,10 @@ std::optional<Querier> querier_cache::lookup_querier(
     ++stats.lookups;
     if (!base_ptr) {
         ++stats.misses;
+        if (was_evicted(key)) {
+            tracing::trace(trace_state, "Querier was evicted");
+            ++stats.misses_after_eviction;
+        }
         return std::nullopt;
     }
 
@@ -338,6 +364,11 @@ std::optional<Querier> querier_cache::lookup_querier(
 
     tracing::trace(trace_state, "Dropping querier because {}", cannot_use_reason(can_be_used));
     ++stats.drops;
+    if (can_be_used == can_use::no_schema_version_mismatch) {
+        ++stats.drops_schema_mismatch;
+    } else {
+        ++stats.drops_position_mismatch;
+    }
 
     // Close and drop the querier in the background.
     // It is safe to do so, since _closing_gate is closed and
@@ -393,25 +424,41 @@ future<> querier_base::close() noexcept {
 
 void querier_cache::set_entry_ttl(std::chrono::seconds entry_ttl) {
     _entry_ttl = entry_ttl;
+    _active_scan_entry_ttl = entry_ttl;
+}
+
+void querier_cache::set_active_scan_entry_ttl(std::chrono::seconds entry_ttl) {
+    _active_scan_entry_ttl = entry_ttl;
 }
 
 future<bool> querier_cache::evict_one() noexcept {
+    // Evicting the querier holding the most memory frees up the most
+    // resources for the reads that need them.
+    index* victim_index = nullptr;
+    index::iterator victim;
+    ssize_t victim_memory = -1;
     for (auto ip : {&_data_querier_index, &_mutation_querier_index, &_shard_mutation_querier_index}) {
-        auto& idx = *ip;
-        if (idx.empty()) {
-            continue;
+        for (auto it = ip->begin(); it != ip->end(); ++it) {
+            const auto memory = it->second->permit().consumed_resources().memory;
+            if (memory > victim_memory) {
+                victim_index = ip;
+                victim = it;
+                victim_memory = memory;
+            }
         }
-        auto it = idx.begin();
-        auto reader_opt = it->second->permit().semaphore().unregister_inactive_read(querier_utils::get_inactive_read_handle(*it->second));
-        idx.erase(it);
-        ++_stats.resource_based_evictions;
-        --_stats.population;
-        if (reader_opt) {
-            co_await reader_opt->close();
-        }
-        co_return true;
     }
-    co_return false;
+    if (!victim_index) {
+        co_return false;
+    }
+    auto reader_opt = victim->second->permit().semaphore().unregister_inactive_read(querier_utils::get_inactive_read_handle(*victim->second));
+    note_eviction(victim->first);
+    victim_index->erase(victim);
+    ++_stats.resource_based_evictions;
+    --_stats.population;
+    if (reader_opt) {
+        co_await reader_opt->close();
+    }
+    co_return true;
 }
 
 future<> querier_cache::stop() noexcept {
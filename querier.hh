@@ -183,6 +183,9 @@ class querier : public querier_base {
                     cstats.clustering_rows.dead,
                     cstats.range_tombstones);
             auto dead = cstats.static_rows.dead + cstats.clustering_rows.dead + cstats.range_tombstones;
+            if (auto* profile = tracing::get_read_profile(trace_ptr)) {
+                profile->tombstones += dead;
+            }
             if (_qr_config.tombstone_warn_threshold > 0 && dead >= _qr_config.tombstone_warn_threshold) {
                 auto live = cstats.static_rows.live + cstats.clustering_rows.live;
                 if (_range->is_singular()) {
@@ -281,7 +284,11 @@ class shard_mutation_querier : public querier_base {
 ///
 /// Inserted queriers will have a TTL. When this expires the querier is
 /// evicted. This is to avoid excess and unnecessary resource usage due to
-/// abandoned queriers.
+/// abandoned queriers. Shard queriers of multishard scans past their first
+/// page get a longer TTL: such a scan is known to be active and each of its
+/// pages may leave the readers of most shards idle, so losing any of them
+/// to the TTL would force recreating it on the next page that reaches that
+/// shard.
 /// Registers cached readers with the reader concurrency semaphore, as inactive
 /// readers, so the latter can evict them if needed.
 /// Keeps the total memory consumption of cached queriers
@@ -290,6 +297,7 @@ class shard_mutation_querier : public querier_base {
 class querier_cache {
 public:
     static const std::chrono::seconds default_entry_ttl;
+    static const std::chrono::seconds default_active_scan_entry_ttl;
 
     struct stats {
         // The number of inserts into the cache.
@@ -298,9 +306,17 @@ class querier_cache {
         uint64_t lookups = 0;
         // The subset of lookups that missed.
         uint64_t misses = 0;
+        // The subset of misses for queries whose querier was evicted,
+        // by its TTL expiring or to free up resources.
+        uint64_t misses_after_eviction = 0;
         // The subset of lookups that hit but the looked up querier had to be
         // dropped due to position mismatch.
         uint64_t drops = 0;
+        // The subset of drops due to the schema having changed.
+        uint64_t drops_schema_mismatch = 0;
+        // The subset of drops due to the page starting from another position
+        // than the one the querier stopped at.
+        uint64_t drops_position_mismatch = 0;
         // The number of queriers evicted due to their TTL expiring.
         uint64_t time_based_evictions = 0;
         // The number of queriers evicted to free up resources to be able to
@@ -317,9 +333,15 @@ class querier_cache {
     index _mutation_querier_index;
     index _shard_mutation_querier_index;
     std::chrono::seconds _entry_ttl;
+    std::chrono::seconds _active_scan_entry_ttl;
+    // Keys of the most recently evicted queriers, to tell misses caused by
+    // evictions apart.
+    std::deque<query_id> _recently_evicted;
     stats _stats;
     gate _closing_gate;
 
+    static constexpr size_t max_recently_evicted = 256;
+
 private:
     template <typename Querier>
     void insert_querier(
@@ -330,6 +352,9 @@ class querier_cache {
             std::chrono::seconds ttl,
             tracing::trace_state_ptr trace_state);
 
+    void note_eviction(query_id key);
+    bool was_evicted(query_id key);
+
     template <typename Querier>
     std::optional<Querier> lookup_querier(
         querier_cache::index& index,
@@ -341,7 +366,8 @@ class querier_cache {
         db::timeout_clock::time_point timeout);
 
 public:
-    explicit querier_cache(std::chrono::seconds entry_ttl = default_entry_ttl);
+    explicit querier_cache(std::chrono::seconds entry_ttl = default_entry_ttl,
+            std::chrono::seconds active_scan_entry_ttl = default_active_scan_entry_ttl);
 
     querier_cache(const querier_cache&) = delete;
     querier_cache& operator=(const querier_cache&) = delete;
@@ -354,7 +380,11 @@ class querier_cache {
 
     void insert_mutation_querier(query_id key, querier&& q, tracing::trace_state_ptr trace_state);
 
-    void insert_shard_querier(query_id key, shard_mutation_querier&& q, tracing::trace_state_ptr trace_state);
+    /// Insert a shard querier of a multishard read.
+    ///
+    /// When \p active_scan is true, that is when the read is past its first
+    /// page, the querier gets the longer, active scan TTL.
+    void insert_shard_querier(query_id key, shard_mutation_querier&& q, tracing::trace_state_ptr trace_state, bool active_scan);
 
     /// Lookup a data querier in the cache.
     ///
@@ -396,12 +426,17 @@ class querier_cache {
             tracing::trace_state_ptr trace_state,
             db::timeout_clock::time_point timeout);
 
-    /// Change the ttl of cache entries
+    /// Change the ttl of cache entries, including that of active scans.
     ///
     /// Applies only to entries inserted after the change.
     void set_entry_ttl(std::chrono::seconds entry_ttl);
 
-    /// Evict a querier.
+    /// Change the ttl of the shard queriers of active scans.
+    ///
+    /// Applies only to entries inserted after the change.
+    void set_active_scan_entry_ttl(std::chrono::seconds entry_ttl);
+
+    /// Evict a querier, the one consuming the most memory.
     ///
     /// Return true if a querier was evicted and false otherwise (if the cache
     /// is empty).
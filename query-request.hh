@@ -493,6 +493,10 @@ struct forward_request {
     db::consistency_level cl;
     lowres_system_clock::time_point timeout;
     std::optional<std::vector<aggregation_info>> aggregation_infos;
+    // Set for grouped aggregations: the reductions are computed for each
+    // group of rows with the same values of these columns, which are a
+    // prefix of the primary key covering the whole partition key.
+    std::optional<std::vector<sstring>> group_by_columns;
 };
 
 std::ostream& operator<<(std::ostream& out, const forward_request& r);
@@ -502,6 +506,10 @@ std::ostream& operator<<(std::ostream& out, const forward_request::aggregation_i
 struct forward_result {
     // vector storing query result for each selected column
     std::vector<bytes_opt> query_results;
+    // For grouped aggregations, the query results of each group, in place of
+    // query_results. Groups of the same partition are in query order, but
+    // partitions are in no particular order until the result is finalized.
+    std::optional<std::vector<std::vector<bytes_opt>>> grouped_query_results;
 
     struct printer {
         const std::vector<::shared_ptr<db::functions::aggregate_function>> functions;
@@ -87,6 +87,10 @@ std::ostream& operator<<(std::ostream& out, const forward_request& r) {
         fmt::print(out, ", aggregation_infos=[{}]",
                    fmt::join(r.aggregation_infos.value(), ","));
     }
+    if (r.group_by_columns) {
+        fmt::print(out, ", group_by_columns=[{}]",
+                   fmt::join(r.group_by_columns.value(), ","));
+    }
     fmt::print(out, "cmd={}, pr={}, cl={}, timeout(ms)={}}}",
                r.cmd, r.pr, r.cl, ms);
     return out;
@@ -406,6 +410,9 @@ foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
 }
 
 std::ostream& operator<<(std::ostream& out, const query::forward_result::printer& p) {
+    if (p.res.grouped_query_results) {
+        return out << "[" << p.res.grouped_query_results->size() << " groups]";
+    }
     if (p.functions.size() != p.res.query_results.size()) {
         return out << "[malformed forward_result (" << p.res.query_results.size()
             << " results, " << p.functions.size() << " aggregates)]";
@@ -62,6 +62,9 @@ struct fsm_config {
     size_t max_log_size;
     // If set to true will enable prevoting stage during election
     bool enable_prevoting;
+    // Max number of un-acked AppendEntries requests to a follower
+    // in pipeline mode
+    size_t max_in_flight_append_requests = 10;
 };
 
 class fsm;
@@ -154,6 +154,7 @@ class server_impl : public rpc_server, public server {
         uint64_t sm_load_snapshot = 0;
         uint64_t truncate_persisted_log = 0;
         uint64_t persisted_log_entries = 0;
+        uint64_t persisted_log_batches = 0;
         uint64_t queue_entries_for_apply = 0;
         uint64_t applied_entries = 0;
         uint64_t snapshots_taken = 0;
@@ -340,7 +341,8 @@ future<> server_impl::start() {
                                  fsm_config {
                                      .append_request_threshold = _config.append_request_threshold,
                                      .max_log_size = _config.max_log_size,
-                                     .enable_prevoting = _config.enable_prevoting
+                                     .enable_prevoting = _config.enable_prevoting,
+                                     .max_in_flight_append_requests = _config.max_in_flight_append_requests
                                  });
 
     _applied_idx = index_t{0};
@@ -1020,6 +1022,7 @@ future<> server_impl::io_fiber(index_t last_stable) {
 
                 last_stable = (*entries.crbegin())->idx;
                 _stats.persisted_log_entries += entries.size();
+                _stats.persisted_log_batches++;
             }
 
             // Update RPC server address mappings. Add servers which are joining
@@ -1598,6 +1601,8 @@ void server_impl::register_metrics() {
              sm::description("how many times log was truncated on storage"), {server_id_label(_id)}),
         sm::make_total_operations("persisted_log_entries", _stats.persisted_log_entries,
              sm::description("how many log entries were persisted"), {server_id_label(_id)}),
+        sm::make_total_operations("persisted_log_batches", _stats.persisted_log_batches,
+             sm::description("how many times log entries were persisted, each time in one batch"), {server_id_label(_id)}),
         sm::make_total_operations("queue_entries_for_apply", _stats.queue_entries_for_apply,
              sm::description("how many log entries were queued to be applied"), {server_id_label(_id)}),
         sm::make_total_operations("applied_entries", _stats.applied_entries,
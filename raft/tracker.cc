@@ -72,14 +72,14 @@ void follower_progress::become_snapshot(index_t snp_idx) {
     next_idx = snp_idx + index_t{1};
 }
 
-bool follower_progress::can_send_to() {
+bool follower_progress::can_send_to(size_t max_in_flight) {
     switch (state) {
     case state::PROBE:
         return !probe_sent;
     case state::PIPELINE:
         // allow `max_in_flight` outstanding indexes
         // FIXME: make it smarter
-        return in_flight < follower_progress::max_in_flight;
+        return in_flight < max_in_flight;
     case state::SNAPSHOT:
         // In this state we are waiting
         // for a snapshot to be transferred
@@ -179,6 +179,9 @@ class read_context final : public enable_lw_shared_from_this<read_context> {
         } else {
             _cache._stats.reads_with_no_misses.mark();
         }
+        if (_key) {
+            _cache.on_single_partition_read(_key->token(), !_underlying_created);
+        }
     }
     read_context(const read_context&) = delete;
     row_cache& cache() { return _cache; }
@@ -131,6 +131,70 @@ void reader_permit::resource_units::reset_to_zero() noexcept {
     }
 }
 
+// Free lists of the memory of transient objects allocated by a permit, by
+// size class, so mutation fragments flowing through a read reuse the memory
+// of the ones already consumed instead of going to the allocator each time.
+class transient_object_pool {
+    static constexpr size_t granularity = 16;
+    static constexpr size_t max_object_size = 512;
+    // Per size class, bounds the memory a permit holds on to
+    static constexpr size_t max_free_objects = 128;
+
+    struct free_object {
+        free_object* next;
+    };
+    struct size_class {
+        free_object* head = nullptr;
+        size_t count = 0;
+    };
+    std::array<size_class, max_object_size / granularity> _classes;
+
+    static size_t class_of(size_t size) noexcept {
+        return (std::max(size, size_t(1)) - 1) / granularity;
+    }
+    static size_t class_size(size_t cls) noexcept {
+        return (cls + 1) * granularity;
+    }
+public:
+    transient_object_pool() = default;
+    transient_object_pool(const transient_object_pool&) = delete;
+    ~transient_object_pool() {
+        for (size_t cls = 0; cls < _classes.size(); ++cls) {
+            while (auto o = _classes[cls].head) {
+                _classes[cls].head = o->next;
+                ::operator delete(o, class_size(cls));
+            }
+        }
+    }
+    void* allocate(size_t size) {
+        if (size > max_object_size) {
+            return ::operator new(size);
+        }
+        auto cls = class_of(size);
+        auto& c = _classes[cls];
+        if (auto o = c.head) {
+            c.head = o->next;
+            --c.count;
+            return o;
+        }
+        return ::operator new(class_size(cls));
+    }
+    void deallocate(void* p, size_t size) noexcept {
+        if (size > max_object_size) {
+            ::operator delete(p, size);
+            return;
+        }
+        auto cls = class_of(size);
+        auto& c = _classes[cls];
+        if (c.count == max_free_objects) {
+            ::operator delete(p, class_size(cls));
+            return;
+        }
+        c.head = new (p) free_object{c.head};
+        ++c.count;
+    }
+};
+
 class reader_permit::impl
         : public boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>
         , public enable_shared_from_this<reader_permit::impl> {
@@ -143,6 +207,9 @@ class reader_permit::impl
         // Must be cleared on all code-paths, otherwise it will keep the permit alive in perpetuity.
         reader_permit_opt permit_keepalive;
         std::optional<reader_concurrency_semaphore::inactive_read> ir;
+        // The class the permit is queued in while waiting for admission.
+        reader_concurrency_semaphore::wait_class* wclass = nullptr;
+        std::chrono::steady_clock::time_point enqueued_at;
     };
 
 private:
@@ -165,27 +232,48 @@ class reader_permit::impl
     size_t _requested_memory = 0;
     uint64_t _oom_kills = 0;
     tracing::trace_state_ptr _trace_ptr;
+    // When the permit last started needing CPU without awaiting, if traced
+    std::chrono::steady_clock::time_point _cpu_started_at;
+    transient_object_pool _transient_objects;
 
     // Not strictly related to the permit.
     // Used by the semaphore to to manage the permit.
     auxiliary_data _aux_data;
 
 private:
+    void start_cpu_time() noexcept {
+        if (_trace_ptr) {
+            _cpu_started_at = std::chrono::steady_clock::now();
+        }
+    }
+    void stop_cpu_time() noexcept {
+        if (_trace_ptr && _cpu_started_at != std::chrono::steady_clock::time_point{}) {
+            auto now = std::chrono::steady_clock::now();
+            _trace_ptr->get_read_profile().cpu_time += std::chrono::duration_cast<std::chrono::microseconds>(now - _cpu_started_at);
+        }
+        _cpu_started_at = {};
+    }
     void on_permit_need_cpu() {
         _semaphore.on_permit_need_cpu();
         _marked_as_need_cpu = true;
+        start_cpu_time();
     }
     void on_permit_not_need_cpu() {
         _semaphore.on_permit_not_need_cpu();
         _marked_as_need_cpu = false;
+        stop_cpu_time();
     }
     void on_permit_awaits() {
         _semaphore.on_permit_awaits();
         _marked_as_awaits = true;
+        stop_cpu_time();
     }
     void on_permit_not_awaits() {
         _semaphore.on_permit_not_awaits();
         _marked_as_awaits = false;
+        if (_marked_as_need_cpu) {
+            start_cpu_time();
+        }
     }
     void on_permit_active() {
         if (_need_cpu_branches) {
@@ -295,6 +383,10 @@ class reader_permit::impl
         _semaphore.on_permit_destroyed(*this);
     }
 
+    transient_object_pool& transient_objects() noexcept {
+        return _transient_objects;
+    }
+
     reader_concurrency_semaphore& semaphore() {
         return _semaphore;
     }
@@ -476,7 +568,11 @@ class reader_permit::impl
             // Create a continuation trace point
             tracing::trace(trace_ptr, "Continuing paged query, previous page's trace session is {}", _trace_ptr->session_id());
         }
+        stop_cpu_time();
         _trace_ptr = std::move(trace_ptr);
+        if (_marked_as_need_cpu && !_marked_as_awaits) {
+            start_cpu_time();
+        }
     }
 
     void check_abort() {
@@ -485,6 +581,22 @@ class reader_permit::impl
         }
     }
 
+    void abort(std::exception_ptr ex) noexcept {
+        if (_ex) {
+            return;
+        }
+        auto keepalive = std::exchange(_aux_data.permit_keepalive, std::nullopt);
+
+        _ex = ex;
+
+        if (_state == state::waiting_for_admission || _state == state::waiting_for_memory || _state == state::waiting_for_execution) {
+            _aux_data.pr.set_exception(std::move(ex));
+            _semaphore.dequeue_permit(*this);
+        } else if (_state == state::inactive) {
+            _semaphore.evict(*this, reader_concurrency_semaphore::evict_reason::manual);
+        }
+    }
+
     query::max_result_size max_result_size() const {
         return _max_result_size;
     }
@@ -499,6 +611,9 @@ class reader_permit::impl
         }
         ++_sstables_read;
         ++_semaphore._stats.sstables_read;
+        if (_trace_ptr) {
+            ++_trace_ptr->get_read_profile().sstables_read;
+        }
     }
 
     void on_finish_sstable_read() noexcept {
@@ -632,6 +747,10 @@ void reader_permit::check_abort() {
     return _impl->check_abort();
 }
 
+void reader_permit::abort(std::exception_ptr ex) noexcept {
+    _impl->abort(std::move(ex));
+}
+
 query::max_result_size reader_permit::max_result_size() const {
     return _impl->max_result_size();
 }
@@ -640,6 +759,14 @@ void reader_permit::set_max_result_size(query::max_result_size s) {
     _impl->set_max_result_size(std::move(s));
 }
 
+void* reader_permit::allocate_transient(size_t size) {
+    return _impl->transient_objects().allocate(size);
+}
+
+void reader_permit::deallocate_transient(void* p, size_t size) noexcept {
+    _impl->transient_objects().deallocate(p, size);
+}
+
 void reader_permit::on_start_sstable_read() noexcept {
     _impl->on_start_sstable_read();
 }
@@ -873,8 +1000,41 @@ reader_concurrency_semaphore::inactive_read_handle::operator=(inactive_read_hand
 }
 
 void reader_concurrency_semaphore::wait_queue::push_to_admission_queue(reader_permit::impl& p) {
+    auto& wc = _classes[p.get_schema() ? p.get_schema()->id() : table_id()][current_scheduling_group()];
+    if (wc.queue.empty()) {
+        wc.vtime = std::max(wc.vtime, _vtime);
+        _active_classes.push_back(wc);
+    }
     p.unlink();
-    _admission_queue.push_back(p);
+    wc.queue.push_back(p);
+    auto& ad = p.aux_data();
+    ad.wclass = &wc;
+    ad.enqueued_at = std::chrono::steady_clock::now();
+    ++wc.stats.queued_reads;
+    ++wc.stats.reads_enqueued_for_admission;
+    ++_admission_queue_length;
+}
+
+void reader_concurrency_semaphore::wait_queue::on_admission(reader_permit::impl& p) noexcept {
+    auto& ad = p.aux_data();
+    auto& wc = *ad.wclass;
+    auto wait_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - ad.enqueued_at);
+    wc.stats.admission_wait_time += wait_time;
+    if (auto* profile = tracing::get_read_profile(p.trace_state())) {
+        profile->admission_wait += wait_time;
+    }
+    _vtime = wc.vtime;
+    wc.vtime += std::max<ssize_t>(p.base_resources().memory, 1);
+}
+
+void reader_concurrency_semaphore::wait_queue::on_dequeue_from_admission_queue(reader_permit::impl& p) noexcept {
+    auto& wc = *std::exchange(p.aux_data().wclass, nullptr);
+    p.unlink();
+    --wc.stats.queued_reads;
+    --_admission_queue_length;
+    if (wc.queue.empty()) {
+        wc.active_hook.unlink();
+    }
 }
 
 void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permit::impl& p) {
@@ -883,17 +1043,50 @@ void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permi
 }
 
 reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() {
-    if (_memory_queue.empty()) {
-        return _admission_queue.front();
-    } else {
+    if (!_memory_queue.empty()) {
         return _memory_queue.front();
     }
+    // Ties are broken in favour of the class which started waiting first.
+    auto it = std::min_element(_active_classes.begin(), _active_classes.end(), [] (const wait_class& a, const wait_class& b) {
+        return a.vtime < b.vtime;
+    });
+    return it->queue.front();
 }
 
 const reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() const {
     return const_cast<wait_queue&>(*this).front();
 }
 
+reader_concurrency_semaphore::class_stats reader_concurrency_semaphore::wait_queue::get_class_stats(table_id id) const {
+    class_stats res;
+    if (auto it = _classes.find(id); it != _classes.end()) {
+        for (const auto& [_, wc] : it->second) {
+            res += wc.stats;
+        }
+    }
+    return res;
+}
+
+void reader_concurrency_semaphore::wait_queue::remove_classes(table_id id) noexcept {
+    auto it = _classes.find(id);
+    if (it == _classes.end()) {
+        return;
+    }
+    for (const auto& [_, wc] : it->second) {
+        if (!wc.queue.empty()) {
+            return;
+        }
+    }
+    _classes.erase(it);
+}
+
+void reader_concurrency_semaphore::wait_queue::foreach_permit(noncopyable_function<void(const reader_permit::impl&)>& func) const {
+    for (const auto& wc : _active_classes) {
+        boost::for_each(wc.queue, std::ref(func));
+    }
+    boost::for_each(_memory_queue, std::ref(func));
+}
+
 namespace {
 
 struct stop_execution_loop {
@@ -1088,6 +1281,7 @@ void reader_concurrency_semaphore::clear_inactive_reads() {
 }
 
 future<> reader_concurrency_semaphore::evict_inactive_reads_for_table(table_id id) noexcept {
+    _wait_list.remove_classes(id);
     permit_list_type evicted_readers;
     auto it = _inactive_reads.begin();
     while (it != _inactive_reads.end()) {
@@ -1231,7 +1425,7 @@ void reader_concurrency_semaphore::evict_readers_in_background() {
                 _evicting = false;
                 return make_ready_future<stop_iteration>(stop_iteration::yes);
             }
-            return detach_inactive_reader(_inactive_reads.front(), evict_reason::permit).close().then([] {
+            return detach_inactive_reader(pick_inactive_read_to_evict(), evict_reason::permit).close().then([] {
                 return stop_iteration::no;
             });
         });
@@ -1283,6 +1477,25 @@ reader_concurrency_semaphore::can_admit_read(const reader_permit::impl& permit)
     return {can_admit::yes, reason::all_ok};
 }
 
+reader_permit::impl& reader_concurrency_semaphore::pick_inactive_read_to_evict() noexcept {
+    // Only look at a few of the oldest reads, so that eviction stays cheap
+    // and mostly follows the LRU order.
+    static constexpr unsigned candidates = 8;
+    const bool memory_bound = _resources.memory < 0
+            || (!_wait_list.empty() && can_admit_read(_wait_list.front()).why == reason::memory_resources);
+    auto victim = _inactive_reads.begin();
+    if (!memory_bound) {
+        return *victim;
+    }
+    auto it = std::next(victim);
+    for (unsigned i = 1; i < candidates && it != _inactive_reads.end(); ++i, ++it) {
+        if (it->resources().memory > victim->resources().memory) {
+            victim = it;
+        }
+    }
+    return *victim;
+}
+
 bool reader_concurrency_semaphore::should_evict_inactive_read() const noexcept {
     if (_resources.memory < 0 || _resources.count < 0) {
         return true;
@@ -1347,6 +1560,9 @@ void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
     auto admit = can_admit::no;
     while (!_wait_list.empty() && (admit = can_admit_read(_wait_list.front()).decision) == can_admit::yes) {
         auto& permit = _wait_list.front();
+        if (permit.get_state() == reader_permit::state::waiting_for_admission) {
+            _wait_list.on_admission(permit);
+        }
         dequeue_permit(permit);
         try {
             if (permit.get_state() == reader_permit::state::waiting_for_memory) {
@@ -1401,6 +1617,9 @@ future<> reader_concurrency_semaphore::request_memory(reader_permit::impl& permi
 void reader_concurrency_semaphore::dequeue_permit(reader_permit::impl& permit) {
     switch (permit.get_state()) {
         case reader_permit::state::waiting_for_admission:
+            _wait_list.on_dequeue_from_admission_queue(permit);
+            --_stats.waiters;
+            break;
         case reader_permit::state::waiting_for_memory:
         case reader_permit::state::waiting_for_execution:
             --_stats.waiters;
@@ -1537,8 +1756,7 @@ std::string reader_concurrency_semaphore::dump_diagnostics(unsigned max_lines) c
 
 void reader_concurrency_semaphore::foreach_permit(noncopyable_function<void(const reader_permit::impl&)> func) const {
     boost::for_each(_permit_list, std::ref(func));
-    boost::for_each(_wait_list._admission_queue, std::ref(func));
-    boost::for_each(_wait_list._memory_queue, std::ref(func));
+    _wait_list.foreach_permit(func);
     boost::for_each(_ready_list, std::ref(func));
 }
 
@@ -1622,7 +1840,10 @@ class tracking_file_impl : public file_impl {
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent* intent) override {
         return _permit.request_memory(range_size).then([this, offset, range_size, intent] (reader_permit::resource_units units) {
-            return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, intent).then([units = std::move(units)] (temporary_buffer<uint8_t> buf) mutable {
+            return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, intent).then([this, units = std::move(units)] (temporary_buffer<uint8_t> buf) mutable {
+                if (auto* profile = tracing::get_read_profile(_permit.trace_state())) {
+                    profile->bytes_read += buf.size();
+                }
                 return make_ready_future<temporary_buffer<uint8_t>>(make_tracked_temporary_buffer(std::move(buf), std::move(units)));
             });
         });
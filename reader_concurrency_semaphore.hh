@@ -8,10 +8,12 @@
 
 #pragma once
 
+#include <unordered_map>
 #include <boost/intrusive/list.hpp>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/condition-variable.hh>
+#include <seastar/core/scheduling.hh>
 #include "reader_permit.hh"
 #include "utils/updateable_value.hh"
 
@@ -30,8 +32,12 @@ using flat_mutation_reader_v2_opt = optimized_optional<flat_mutation_reader_v2>;
 /// Reader concurrency is dual limited by count and memory.
 /// The semaphore can be configured with the desired limits on
 /// construction. New readers will only be admitted when there is both
-/// enough count and memory units available. Readers are admitted in
-/// FIFO order.
+/// enough count and memory units available. Readers waiting for admission
+/// are queued per class: per table and scheduling group (service level) of
+/// the read. Classes are served in a fair manner, weighted by the estimated
+/// memory of their reads (see `wait_queue`), so a table with many large
+/// scans cannot starve the reads of other tables. Readers of the same class
+/// are admitted in FIFO order.
 /// Semaphore's `name` must be provided in ctor and its only purpose is
 /// to increase readability of exceptions: both timeout exceptions and
 /// queue overflow exceptions (read below) include this `name` in messages.
@@ -124,6 +130,23 @@ class reader_concurrency_semaphore {
         uint64_t waiters = 0;
     };
 
+    // Statistics of the admission queue of a class of reads, see `wait_queue`.
+    struct class_stats {
+        // Current number of reads waiting for admission.
+        uint64_t queued_reads = 0;
+        // Total number of reads enqueued to wait for admission.
+        uint64_t reads_enqueued_for_admission = 0;
+        // Total time spent waiting for admission by the admitted reads.
+        std::chrono::microseconds admission_wait_time{0};
+
+        class_stats& operator+=(const class_stats& o) noexcept {
+            queued_reads += o.queued_reads;
+            reads_enqueued_for_admission += o.reads_enqueued_for_admission;
+            admission_wait_time += o.admission_wait_time;
+            return *this;
+        }
+    };
+
     using permit_list_type = bi::list<
             reader_permit::impl,
             bi::base_hook<bi::list_base_hook<bi::link_mode<bi::auto_unlink>>>,
@@ -160,19 +183,52 @@ class reader_concurrency_semaphore {
     resources _initial_resources;
     resources _resources;
 
+    struct wait_class {
+        // Stores entries for permits of the class waiting to be admitted.
+        permit_list_type queue;
+        // The sum of the estimated memory of the reads admitted from the class.
+        uint64_t vtime = 0;
+        class_stats stats;
+        // Links the class into wait_queue::_active_classes while its queue is not empty.
+        bi::list_member_hook<bi::link_mode<bi::auto_unlink>> active_hook;
+    };
+
+    using wait_class_list_type = bi::list<
+            wait_class,
+            bi::member_hook<wait_class, bi::list_member_hook<bi::link_mode<bi::auto_unlink>>, &wait_class::active_hook>,
+            bi::constant_time_size<false>>;
+
+    // Permits waiting for admission are queued by their class: the table and
+    // the scheduling group of the read. The next permit to be admitted is the
+    // oldest one of the class with the lowest virtual time, the estimated
+    // memory of all the reads admitted from the class so far. A class whose
+    // queue becomes non-empty starts from the virtual time of the last served
+    // class, so it cannot accumulate credit while it has no waiters.
+    // Serialized permits waiting for memory take precedence over all classes.
     struct wait_queue {
-        // Stores entries for permits waiting to be admitted.
-        permit_list_type _admission_queue;
+        std::unordered_map<table_id, std::unordered_map<scheduling_group, wait_class>> _classes;
+        // Classes with permits waiting to be admitted.
+        wait_class_list_type _active_classes;
+        uint64_t _vtime = 0;
+        uint64_t _admission_queue_length = 0;
         // Stores entries for serialized permits waiting to obtain memory.
         permit_list_type _memory_queue;
     public:
         bool empty() const {
-            return _admission_queue.empty() && _memory_queue.empty();
+            return !_admission_queue_length && _memory_queue.empty();
         }
         void push_to_admission_queue(reader_permit::impl& p);
         void push_to_memory_queue(reader_permit::impl& p);
+        // Charges the class of the permit, which is about to be admitted.
+        void on_admission(reader_permit::impl& p) noexcept;
+        // Called when a permit waiting for admission leaves the queue, admitted or not.
+        void on_dequeue_from_admission_queue(reader_permit::impl& p) noexcept;
         reader_permit::impl& front();
         const reader_permit::impl& front() const;
+        class_stats get_class_stats(table_id id) const;
+        // Forgets the classes of the table, if none of them have waiters.
+        void remove_classes(table_id id) noexcept;
+        void foreach_permit(noncopyable_function<void(const reader_permit::impl&)>& func) const;
     };
 
     wait_queue _wait_list;
@@ -224,6 +280,11 @@ class reader_concurrency_semaphore {
 
     bool should_evict_inactive_read() const noexcept;
 
+    // The inactive read to evict to make room for waiting reads: the oldest
+    // one, unless memory is short, in which case the one holding the most
+    // memory among the oldest few.
+    reader_permit::impl& pick_inactive_read_to_evict() noexcept;
+
     void maybe_admit_waiters() noexcept;
 
     // Request more memory for the permit.
@@ -352,7 +413,15 @@ class reader_concurrency_semaphore {
     void clear_inactive_reads();
 
     /// Evict all inactive reads the belong to the table designated by the id.
+    ///
+    /// Also drops the admission statistics of the table.
     future<> evict_inactive_reads_for_table(table_id id) noexcept;
+
+    /// Statistics of the admission queue of the reads of the table, summed
+    /// over all the scheduling groups the table is read from.
+    class_stats get_class_stats(table_id id) const {
+        return _wait_list.get_class_stats(id);
+    }
 private:
     // The following two functions are extension points for
     // future inheriting classes that needs to run some stop
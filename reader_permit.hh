@@ -178,12 +178,25 @@ class reader_permit {
     // Otherwise no-op.
     void check_abort();
 
+    // Abort the read with the given exception.
+    // A permit waiting on the semaphore fails with it immediately, an
+    // inactive one is evicted. Active reads notice the abort the next
+    // time they call check_abort().
+    void abort(std::exception_ptr ex) noexcept;
+
     query::max_result_size max_result_size() const;
     void set_max_result_size(query::max_result_size);
 
     void on_start_sstable_read() noexcept;
     void on_finish_sstable_read() noexcept;
 
+    // Allocates memory for a transient object of the read, that doesn't
+    // outlive the permit, like a mutation fragment. Deallocated memory is
+    // kept by the permit for reuse by objects of the same size class, until
+    // the permit is destroyed.
+    void* allocate_transient(size_t size);
+    void deallocate_transient(void* p, size_t size) noexcept;
+
     uintptr_t id() { return reinterpret_cast<uintptr_t>(_impl.get()); }
 };
 
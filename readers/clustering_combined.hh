@@ -55,6 +55,9 @@ struct reader_and_upper_bound {
 //        The first position returned by r2 must be after_key(10) or higher.
 //
 // With each reader also comes an upper bound on the set of positions of fragments that the reader will return.
+//
+// Only the readers of the first batch may return partition tombstones: the later ones are opened
+// in the middle of the partition, after its partition start was returned.
 class position_reader_queue {
 public:
     virtual ~position_reader_queue() = 0;
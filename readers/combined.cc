@@ -13,6 +13,7 @@
 #include "readers/clustering_combined.hh"
 #include "readers/range_tombstone_change_merger.hh"
 #include "readers/combined.hh"
+#include "types/comparable_bytes.hh"
 
 extern logging::logger mrlog;
 
@@ -146,6 +147,50 @@ class mutation_fragment_merger {
     }
 };
 
+// Maps positions to integer keys which are monotonic with respect to
+// position_in_partition::less_compare: if a < b then key(a) <= key(b), so
+// key(a) < key(b) implies a < b and only equal keys need a full comparison.
+//
+// The key holds the partition region in the two most significant bits,
+// followed by the leading bytes of the byte-comparable encoding of the
+// clustering position, see comparable_bytes::clustering_prefix_head().
+//
+// When many sources have data in the same partition, the heap comparisons
+// dominate the merging cost and most of them are decided by the first
+// bytes of the key, so this replaces a compound type walk with one integer
+// comparison.
+class position_prefix_encoder {
+public:
+    using key_type = unsigned __int128;
+private:
+    static constexpr unsigned key_bytes = sizeof(key_type);
+    static constexpr unsigned region_bits = 2;
+    static constexpr key_type payload_mask = ~key_type(0) >> region_bits;
+
+    const schema& _schema;
+public:
+    explicit position_prefix_encoder(const schema& s) : _schema(s) { }
+
+    key_type operator()(position_in_partition_view pos) const {
+        auto key = key_type(uint8_t(pos.region())) << (key_bytes * 8 - region_bits);
+        if (pos.region() != partition_region::clustered || _schema.clustering_key_size() == 0) {
+            return key;
+        }
+        // Encodings of keyed positions start with one of the framing
+        // bytes, which are neither 0x00 nor 0xff.
+        if (!pos.has_key()) {
+            return pos.get_bound_weight() == bound_weight::after_all_prefixed ? key | payload_mask : key;
+        }
+        std::array<uint8_t, key_bytes> head;
+        comparable_bytes::clustering_prefix_head(_schema, pos.key(), pos.get_bound_weight(), head);
+        key_type payload = 0;
+        for (auto b : head) {
+            payload = (payload << 8) | b;
+        }
+        return key | (payload >> region_bits);
+    }
+};
+
 // Merges the output of the sub-readers into a single non-decreasing
 // stream of mutation-fragments.
 class mutation_reader_merger {
@@ -155,10 +200,14 @@ class mutation_reader_merger {
     struct reader_and_fragment {
         reader_iterator reader{};
         mutation_fragment_v2 fragment;
+        // See position_prefix_encoder. Only maintained for fragments in
+        // _fragment_heap. Zero is the correct value for partition_start.
+        position_prefix_encoder::key_type prefix = 0;
 
-        reader_and_fragment(reader_iterator r, mutation_fragment_v2 f)
+        reader_and_fragment(reader_iterator r, mutation_fragment_v2 f, position_prefix_encoder::key_type p = 0)
             : reader(r)
-            , fragment(std::move(f)) {
+            , fragment(std::move(f))
+            , prefix(p) {
         }
     };
 
@@ -224,6 +273,7 @@ class mutation_reader_merger {
     // that the gallop mode was stopped (galloping reader lost to some other reader).
     int _gallop_mode_hits = 0;
     const schema_ptr _schema;
+    const position_prefix_encoder _prefix_encoder;
     streamed_mutation::forwarding _fwd_sm;
     mutation_reader::forwarding _fwd_mr;
 private:
@@ -342,6 +392,9 @@ struct mutation_reader_merger::fragment_heap_compare {
 
     bool operator()(const mutation_reader_merger::reader_and_fragment& a, const mutation_reader_merger::reader_and_fragment& b) {
         // Invert comparison as this is a max-heap.
+        if (a.prefix != b.prefix) {
+            return b.prefix < a.prefix;
+        }
         return cmp(b.fragment.position(), a.fragment.position());
     }
 };
@@ -387,10 +440,18 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                 _reader_heap.emplace_back(rk.reader, std::move(*mfo));
                 boost::push_heap(_reader_heap, reader_heap_compare(*_schema));
             } else {
+                const auto prefix = _prefix_encoder(mfo->position());
                 if (reader_galloping) {
                     // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
                     // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
-                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
+                    auto wins = [&] {
+                        auto& front = _fragment_heap.front();
+                        if (prefix != front.prefix) {
+                            return prefix < front.prefix;
+                        }
+                        return position_in_partition::less_compare(*_schema)(mfo->position(), front.fragment.position());
+                    };
+                    if (_fragment_heap.empty() || wins()) {
                         _current.clear();
                         _current.emplace_back(std::move(*mfo), &*_galloping_reader.reader);
                         _galloping_reader.last_kind = _current.back().fragment.mutation_fragment_kind();
@@ -400,7 +461,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                     _gallop_mode_hits = 0;
                 }
 
-                _fragment_heap.emplace_back(rk.reader, std::move(*mfo));
+                _fragment_heap.emplace_back(rk.reader, std::move(*mfo), prefix);
                 boost::range::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
             }
         } else if (_fwd_sm == streamed_mutation::forwarding::yes && rk.last_kind != mutation_fragment_v2::kind::partition_end) {
@@ -465,6 +526,7 @@ mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
         mutation_reader::forwarding fwd_mr)
     : _selector(std::move(selector))
     , _schema(std::move(schema))
+    , _prefix_encoder(*_schema)
     , _fwd_sm(fwd_sm)
     , _fwd_mr(fwd_mr) {
     maybe_add_readers(std::nullopt);
@@ -542,15 +604,18 @@ future<mutation_fragment_batch_opt> mutation_reader_merger::maybe_produce_batch(
     }
 
     const auto equal = position_in_partition::equal_compare(*_schema);
+    position_prefix_encoder::key_type prefix;
     do {
         boost::range::pop_heap(_fragment_heap, fragment_heap_compare(*_schema));
         auto& n = _fragment_heap.back();
         const auto kind = n.fragment.mutation_fragment_kind();
+        prefix = n.prefix;
         _current.emplace_back(std::move(n.fragment), &*n.reader);
         _next.emplace_back(n.reader, kind);
         _fragment_heap.pop_back();
     }
-    while (!_fragment_heap.empty() && equal(_current.back().fragment.position(), _fragment_heap.front().fragment.position()));
+    while (!_fragment_heap.empty() && _fragment_heap.front().prefix == prefix
+            && equal(_current.back().fragment.position(), _fragment_heap.front().fragment.position()));
 
     if (_next.size() == 1 && _next.front().reader == _galloping_reader.reader) {
         ++_gallop_mode_hits;
@@ -732,7 +797,8 @@ position_reader_queue::~position_reader_queue() {}
 //
 // Assumes that:
 // - there are no static rows,
-// - the returned fragments do not contain partition tombstones,
+// - only the readers returned by the first pop() from the queue contain partition tombstones,
+//   the ones popped later, once the partition start may have been returned, do not,
 // - the merged readers return fragments from the same partition (but some or even all of them may be empty).
 class clustering_order_reader_merger {
     const schema_ptr _schema;
@@ -809,6 +875,11 @@ class clustering_order_reader_merger {
     // or not we've already fetched the first `partition_start`.
     bool _partition_start_fetched = false;
 
+    // The partition tombstones of the readers peeked before the partition start was returned, applied
+    // to the returned `partition_start`.
+    tombstone _partition_tombstone;
+    bool _partition_start_returned = false;
+
     // In non-forwarding mode, remember if we've returned the last fragment, which is always partition-end.
     // We construct the fragment ourselves instead of merging partition-ends returned from the merged readers,
     // because we may close readers in the middle of the partition query.
@@ -871,13 +942,17 @@ class clustering_order_reader_merger {
             }
 
             if (mf->is_partition_start()) {
-                // We assume there are no partition tombstones.
+                // We assume there are no partition tombstones once the partition start was returned.
                 // This should have been checked before opening the reader.
-                if (mf->as_partition_start().partition_tombstone()) {
-                    on_internal_error(mrlog, format(
-                            "clustering_order_reader_merger: partition tombstone encountered for partition {}."
-                            " This reader merger cannot be used for readers that return partition tombstones"
-                            " or it would give incorrect results.", mf->as_partition_start().key()));
+                if (auto t = mf->as_partition_start().partition_tombstone()) {
+                    if (_partition_start_returned) {
+                        on_internal_error(mrlog, format(
+                                "clustering_order_reader_merger: partition tombstone encountered for partition {}"
+                                " after its partition start was returned. The readers which return partition tombstones"
+                                " must be opened before the read starts or it would give incorrect results.",
+                                mf->as_partition_start().key()));
+                    }
+                    _partition_tombstone.apply(t);
                 }
                 if (!_partition_start_fetched) {
                     _peeked_readers.emplace_back(it);
@@ -1060,6 +1135,12 @@ class clustering_order_reader_merger {
             boost::range::pop_heap(_peeked_readers, _peeked_cmp);
             auto r = _peeked_readers.back();
             auto mf = r->reader.pop_mutation_fragment();
+            if (mf.is_partition_start()) {
+                mf.mutate_as_partition_start(*_schema, [this] (partition_start& ps) {
+                    ps.partition_tombstone().apply(_partition_tombstone);
+                });
+                _partition_start_returned = true;
+            }
             _peeked_readers.pop_back();
             _unpeeked_readers.push_back(std::move(r));
             _current_batch.emplace_back(std::move(mf), &_unpeeked_readers.back()->reader);
@@ -24,6 +24,12 @@
 
 extern logger mrlog;
 
+static thread_local multishard_reader_stats multishard_stats;
+
+const multishard_reader_stats& get_multishard_reader_stats() noexcept {
+    return multishard_stats;
+}
+
 namespace {
 
 struct remote_fill_buffer_result_v2 {
@@ -279,6 +285,9 @@ class evictable_reader_v2 : public flat_mutation_reader_v2::impl {
     reader_permit permit() {
         return _permit;
     }
+    void set_max_buffer_size(size_t size) {
+        max_buffer_size_in_bytes = size;
+    }
 };
 
 void evictable_reader_v2::do_pause(flat_mutation_reader_v2 reader) {
@@ -709,8 +718,17 @@ class shard_reader_v2 : public flat_mutation_reader_v2::impl {
     std::optional<future<>> _read_ahead;
     foreign_ptr<std::unique_ptr<evictable_reader_v2>> _reader;
 
+    // The amount of data each remote fill brings, adjusted by
+    // on_read_ahead_consumed() to how fast the buffer is consumed compared
+    // to how long filling it takes.
+    size_t _remote_buffer_size = default_max_buffer_size_in_bytes();
+    const size_t _max_remote_buffer_size;
+    std::chrono::steady_clock::duration _fill_latency{};
+    std::chrono::steady_clock::time_point _filled_at;
+
 private:
     future<> do_fill_buffer();
+    void on_read_ahead_consumed(bool waited);
 
 public:
     shard_reader_v2(
@@ -721,14 +739,16 @@ class shard_reader_v2 : public flat_mutation_reader_v2::impl {
             const dht::partition_range& pr,
             const query::partition_slice& ps,
             tracing::trace_state_ptr trace_state,
-            mutation_reader::forwarding fwd_mr)
+            mutation_reader::forwarding fwd_mr,
+            size_t max_remote_buffer_size)
         : impl(std::move(schema), std::move(permit))
         , _lifecycle_policy(std::move(lifecycle_policy))
         , _shard(shard)
         , _pr(make_foreign(make_lw_shared<const dht::partition_range>(pr)))
         , _ps(ps)
         , _trace_state(std::move(trace_state))
-        , _fwd_mr(fwd_mr) {
+        , _fwd_mr(fwd_mr)
+        , _max_remote_buffer_size(max_remote_buffer_size) {
     }
 
     shard_reader_v2(shard_reader_v2&&) = delete;
@@ -800,7 +820,8 @@ future<> shard_reader_v2::do_fill_buffer() {
         remote_fill_buffer_result_v2 result;
     };
 
-    auto res = co_await std::invoke([&] () -> future<remote_fill_buffer_result_v2> {
+    const auto fill_started = std::chrono::steady_clock::now();
+    auto res = co_await std::invoke([&, buffer_size = _remote_buffer_size] () -> future<remote_fill_buffer_result_v2> {
         if (!_reader) {
             reader_and_buffer_fill_result res = co_await smp::submit_to(_shard, coroutine::lambda([this, gs = global_schema_ptr(_schema)] () -> future<reader_and_buffer_fill_result> {
                 auto ms = mutation_source([lifecycle_policy = _lifecycle_policy.get()] (
@@ -846,6 +867,7 @@ future<> shard_reader_v2::do_fill_buffer() {
                 try {
                     tracing::trace(_trace_state, "Creating shard reader on shard: {}", this_shard_id());
                     reader_permit::need_cpu_guard ncpu_guard{rreader->permit()};
+                    rreader->set_max_buffer_size(buffer_size);
                     co_await rreader->fill_buffer();
                     auto res = remote_fill_buffer_result_v2(rreader->detach_buffer(), rreader->is_end_of_stream());
                     co_return reader_and_buffer_fill_result{std::move(rreader), std::move(res)};
@@ -858,8 +880,9 @@ future<> shard_reader_v2::do_fill_buffer() {
             _reader = std::move(res.reader);
             co_return std::move(res.result);
         } else {
-            co_return co_await smp::submit_to(_shard, coroutine::lambda([this] () -> future<remote_fill_buffer_result_v2>  {
+            co_return co_await smp::submit_to(_shard, coroutine::lambda([this, buffer_size] () -> future<remote_fill_buffer_result_v2>  {
                 reader_permit::need_cpu_guard ncpu_guard{_reader->permit()};
+                _reader->set_max_buffer_size(buffer_size);
                 co_await _reader->fill_buffer();
                 co_return remote_fill_buffer_result_v2(_reader->detach_buffer(), _reader->is_end_of_stream());
             }));
@@ -872,13 +895,38 @@ future<> shard_reader_v2::do_fill_buffer() {
         co_await coroutine::maybe_yield();
     }
     _end_of_stream = res.end_of_stream;
+    _filled_at = std::chrono::steady_clock::now();
+    _fill_latency = _filled_at - fill_started;
+}
+
+// A read-ahead which wasn't done by the time its buffer was needed means the
+// consumer outpaces this shard: bring more data with each fill, so fewer
+// fills, each a cross-shard round-trip, are waited for. A buffer which waited
+// to be consumed longer than it took to fill means the consumer is slower
+// than this shard: bring less, so less memory sits in the buffer.
+void shard_reader_v2::on_read_ahead_consumed(bool waited) {
+    if (waited) {
+        ++multishard_stats.read_ahead_waits;
+        if (_remote_buffer_size < _max_remote_buffer_size) {
+            _remote_buffer_size = std::min(_remote_buffer_size * 2, _max_remote_buffer_size);
+            ++multishard_stats.read_ahead_grows;
+        }
+    } else {
+        ++multishard_stats.read_ahead_hits;
+        if (std::chrono::steady_clock::now() - _filled_at > _fill_latency && _remote_buffer_size > default_max_buffer_size_in_bytes()) {
+            _remote_buffer_size = std::max(_remote_buffer_size / 2, default_max_buffer_size_in_bytes());
+            ++multishard_stats.read_ahead_shrinks;
+        }
+    }
 }
 
 future<> shard_reader_v2::fill_buffer() {
     // FIXME: want to move this to the inner scopes but it makes clang miscompile the code.
     reader_permit::awaits_guard guard(_permit);
     if (_read_ahead) {
+        const bool waited = !_read_ahead->available();
         co_await *std::exchange(_read_ahead, std::nullopt);
+        on_read_ahead_consumed(waited);
         co_return;
     }
     if (!is_buffer_empty()) {
@@ -968,6 +1016,9 @@ class multishard_combining_reader_v2 : public flat_mutation_reader_v2::impl {
     bool _crossed_shards;
     unsigned _concurrency = 1;
 
+    // How many times the default buffer size a shard reader may read ahead
+    static constexpr size_t max_read_ahead_buffer_factor = 16;
+
     void on_partition_range_change(const dht::partition_range& pr);
     bool maybe_move_to_next_shard(const dht::token* const t = nullptr);
     future<> handle_empty_reader_buffer();
@@ -1086,9 +1137,16 @@ multishard_combining_reader_v2::multishard_combining_reader_v2(
 
     on_partition_range_change(pr);
 
+    // The buffers of all shard readers stay within the result size the
+    // permit is allowed to produce.
+    const auto default_buffer_size = flat_mutation_reader_v2::default_max_buffer_size_in_bytes();
+    const auto max_remote_buffer_size = std::clamp<uint64_t>(_permit.max_result_size().soft_limit / _sharder.shard_count(),
+            default_buffer_size, max_read_ahead_buffer_factor * default_buffer_size);
+
     _shard_readers.reserve(_sharder.shard_count());
     for (unsigned i = 0; i < _sharder.shard_count(); ++i) {
-        _shard_readers.emplace_back(std::make_unique<shard_reader_v2>(_schema, _permit, lifecycle_policy, i, pr, ps, trace_state, fwd_mr));
+        _shard_readers.emplace_back(std::make_unique<shard_reader_v2>(_schema, _permit, lifecycle_policy, i, pr, ps, trace_state, fwd_mr,
+                max_remote_buffer_size));
     }
 }
 
@@ -1098,6 +1156,7 @@ future<> multishard_combining_reader_v2::fill_buffer() {
         auto& reader = *_shard_readers[_current_shard];
 
         if (reader.is_buffer_empty()) {
+            check_abort();
             return handle_empty_reader_buffer();
         }
 
@@ -103,6 +103,19 @@ class reader_lifecycle_policy_v2 {
             tracing::trace_state_ptr trace_ptr) = 0;
 };
 
+struct multishard_reader_stats {
+    // Read-aheads of shard readers which weren't done when their data was needed.
+    uint64_t read_ahead_waits = 0;
+    // Read-aheads of shard readers which were done when their data was needed.
+    uint64_t read_ahead_hits = 0;
+    // Adjustments of the amount of data shard readers read ahead.
+    uint64_t read_ahead_grows = 0;
+    uint64_t read_ahead_shrinks = 0;
+};
+
+/// The statistics of the multishard readers coordinated by this shard.
+const multishard_reader_stats& get_multishard_reader_stats() noexcept;
+
 /// Make a multishard_combining_reader.
 ///
 /// multishard_combining_reader takes care of reading a range from all shards
@@ -120,6 +133,11 @@ class reader_lifecycle_policy_v2 {
 /// For dense tables (where we rarely cross shards) we rely on the
 /// foreign_reader to issue sufficient read-aheads on its own to avoid blocking.
 ///
+/// Each shard reader adapts how much data it brings with each read-ahead to
+/// the consumption of its buffer: more when the consumer had to wait for it,
+/// less when the buffer waited to be consumed longer than it took to fill.
+/// The read-aheads of all shards stay within the permit's result size.
+///
 /// The readers' life-cycles are managed through the supplied lifecycle policy.
 flat_mutation_reader_v2 make_multishard_combining_reader_v2(
         shared_ptr<reader_lifecycle_policy_v2> lifecycle_policy,
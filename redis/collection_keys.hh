@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <seastar/net/byteorder.hh>
+#include "bytes.hh"
+#include "timestamp.hh"
+#include "utils/UUID.hh"
+
+// Encoding of the clustering keys of the LISTs and ZSETs tables. Both have a
+// single bytes clustering column, which compares byte-wise (unsigned), so the
+// encodings below are chosen for the clustering order to be the order Redis
+// needs, and for range reads to be clustering slices.
+
+namespace redis {
+
+namespace detail {
+
+inline void append_be64(bytes& b, size_t pos, uint64_t v) {
+    v = seastar::cpu_to_be(v);
+    std::memcpy(b.begin() + pos, &v, sizeof(v));
+}
+
+inline uint64_t read_be64(bytes_view b) {
+    uint64_t v;
+    std::memcpy(&v, b.begin(), sizeof(v));
+    return seastar::be_to_cpu(v);
+}
+
+}
+
+// A list element is clustered by its position: 8 bytes of position, 4 bytes
+// of index among the values pushed by the same command and a time UUID
+// making the key unique among coordinators pushing at the same time.
+// RPUSH positions grow with the time of the push, LPUSH positions go down
+// with it, so pushes never need to read the list. Concurrent pushes to the
+// same list from several coordinators are therefore ordered by their
+// timestamps, not by their arrival.
+inline bytes make_list_element_key(api::timestamp_type ts, bool left, uint32_t index, const utils::UUID& id) {
+    bytes b(bytes::initialized_later(), 8 + 4 + 16);
+    uint64_t base = uint64_t(1) << 63;
+    detail::append_be64(b, 0, left ? base - uint64_t(ts) : base + uint64_t(ts));
+    auto idx = seastar::cpu_to_be(left ? std::numeric_limits<uint32_t>::max() - index : index);
+    std::memcpy(b.begin() + 8, &idx, sizeof(idx));
+    detail::append_be64(b, 12, id.get_most_significant_bits());
+    detail::append_be64(b, 20, id.get_least_significant_bits());
+    return b;
+}
+
+// A sorted set has two rows per member in its partition: one keyed by 'M'
+// and the member, with the score as its value, for finding the score of a
+// member, and one keyed by 'S', the score and the member, for reading ranges
+// of scores. The score of a member is the single cell of its 'M' row:
+// concurrent changes of its score may leave stale 'S' rows, so the 'S' rows
+// not matching the 'M' row of their member are ignored.
+constexpr int8_t zset_score_prefix = 'S';
+constexpr int8_t zset_member_prefix = 'M';
+
+// Maps doubles to unsigned integers of the same order
+inline uint64_t encode_zset_score(double score) {
+    auto bits = std::bit_cast<uint64_t>(score);
+    return bits & (uint64_t(1) << 63) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+inline double decode_zset_score(uint64_t v) {
+    return std::bit_cast<double>(v & (uint64_t(1) << 63) ? v & ~(uint64_t(1) << 63) : ~v);
+}
+
+// The key of the score row, or with an empty member, the smallest key of
+// all members with this encoded score
+inline bytes make_zset_score_key(uint64_t encoded_score, bytes_view member = {}) {
+    bytes b(bytes::initialized_later(), 1 + 8 + member.size());
+    b[0] = zset_score_prefix;
+    detail::append_be64(b, 1, encoded_score);
+    std::copy(member.begin(), member.end(), b.begin() + 9);
+    return b;
+}
+
+inline bytes make_zset_score_key(double score, bytes_view member) {
+    return make_zset_score_key(encode_zset_score(score), member);
+}
+
+inline std::pair<double, bytes_view> parse_zset_score_key(bytes_view key) {
+    return {decode_zset_score(detail::read_be64(key.substr(1, 8))), key.substr(9)};
+}
+
+inline bytes make_zset_member_key(bytes_view member) {
+    bytes b(bytes::initialized_later(), 1 + member.size());
+    b[0] = zset_member_prefix;
+    std::copy(member.begin(), member.end(), b.begin() + 1);
+    return b;
+}
+
+}
@@ -26,6 +26,8 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "ttl", commands::ttl },
         { "strlen", commands::strlen },
         { "set", commands::set },
+        { "mget", commands::mget },
+        { "mset", commands::mset },
         { "setex", commands::setex },
         { "del", commands::del },
         { "echo", commands::echo },
@@ -35,6 +37,14 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "hgetall", commands::hgetall },
         { "hdel", commands::hdel },
         { "hexists", commands::hexists },
+        { "hmget", commands::hmget },
+        { "lpush", commands::lpush },
+        { "rpush", commands::rpush },
+        { "lrange", commands::lrange },
+        { "zadd", commands::zadd },
+        { "zrem", commands::zrem },
+        { "zscore", commands::zscore },
+        { "zrangebyscore", commands::zrangebyscore },
     };
     auto&& command = _commands.find(req._command);
     if (command != _commands.end()) {
@@ -18,6 +18,10 @@
 #include "redis/mutation_utils.hh"
 #include "redis/lolwut.hh"
 #include "redis/keyspace_utils.hh"
+#include "redis/collection_keys.hh"
+#include "partition_slice_builder.hh"
+#include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/iterator_range.hpp>
 
 namespace redis {
 
@@ -172,6 +176,207 @@ future<redis_message> setex(service::storage_proxy& proxy, request& req, redis::
     });
 }
 
+future<redis_message> mget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 1) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    return redis::read_strings(proxy, options, req._args, permit).then([] (std::vector<strings_result> results) {
+        auto values = boost::copy_range<std::vector<std::optional<bytes>>>(results | boost::adaptors::transformed([] (strings_result& r) -> std::optional<bytes> {
+            if (!r.has_result()) {
+                return std::nullopt;
+            }
+            return std::move(r.result());
+        }));
+        return redis_message::make_strings_list_result(values);
+    });
+}
+
+future<redis_message> mset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2 || req.arguments_size() % 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    std::vector<std::pair<bytes, bytes>> keys_and_data;
+    keys_and_data.reserve(req.arguments_size() / 2);
+    for (size_t i = 0; i < req.arguments_size(); i += 2) {
+        keys_and_data.emplace_back(std::move(req._args[i]), std::move(req._args[i + 1]));
+    }
+    return redis::write_strings(proxy, options, std::move(keys_and_data), permit).then([] {
+        return redis_message::ok();
+    });
+}
+
+future<redis_message> hmget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto fields = std::vector<bytes>(req._args.begin() + 1, req._args.end());
+    return redis::read_hashes(proxy, options, req._args[0], fields, permit).then([fields = std::move(fields)] (auto result) {
+        auto values = boost::copy_range<std::vector<std::optional<bytes>>>(fields | boost::adaptors::transformed([&result] (const bytes& field) -> std::optional<bytes> {
+            auto it = result->find(field);
+            if (it == result->end()) {
+                return std::nullopt;
+            }
+            return it->second;
+        }));
+        return redis_message::make_strings_list_result(values);
+    });
+}
+
+static future<redis_message> push(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit, bool left) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto values = std::vector<bytes>(std::make_move_iterator(req._args.begin() + 1), std::make_move_iterator(req._args.end()));
+    // Pushing doesn't read the list, so it is read after the push to reply
+    // with its length.
+    return redis::write_list(proxy, options, bytes(req._args[0]), std::move(values), left, permit).then([&proxy, &req, &options, permit] {
+        auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+        return redis::query_collection(proxy, options, req._args[0], permit, schema, partition_slice_builder(*schema).build(), query::max_rows);
+    }).then([] (collection_rows rows) {
+        return redis_message::number(rows.size());
+    });
+}
+
+future<redis_message> lpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    return push(proxy, req, options, permit, true);
+}
+
+future<redis_message> rpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    return push(proxy, req, options, permit, false);
+}
+
+static long parse_long(const request& req, const bytes& arg) {
+    try {
+        return std::stol(std::string(reinterpret_cast<const char*>(arg.data()), arg.size()));
+    } catch (...) {
+        throw invalid_arguments_exception(req._command);
+    }
+}
+
+future<redis_message> lrange(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 3) {
+        throw wrong_arguments_exception(3, req.arguments_size(), req._command);
+    }
+    auto start = parse_long(req, req._args[1]);
+    auto stop = parse_long(req, req._args[2]);
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    // Indexes from the end of the list need the whole list, indexes from
+    // its start need only its beginning.
+    uint64_t row_limit = start >= 0 && stop >= 0 ? uint64_t(stop) + 1 : query::max_rows;
+    return redis::query_collection(proxy, options, req._args[0], permit, schema, partition_slice_builder(*schema).build(), row_limit).then([start, stop] (collection_rows rows) mutable {
+        long size = rows.size();
+        start = start < 0 ? std::max(start + size, 0L) : start;
+        stop = std::min(stop < 0 ? stop + size : stop, size - 1);
+        std::vector<std::optional<bytes>> values;
+        for (long i = start; i <= stop; ++i) {
+            values.emplace_back(std::move(rows[i].second));
+        }
+        return redis_message::make_strings_list_result(values);
+    });
+}
+
+// Parses a score, or with exclusive, a score which may be prefixed with '('
+// to exclude it from a range.
+static double parse_score(const request& req, const bytes& arg, bool* exclusive = nullptr) {
+    std::string s(reinterpret_cast<const char*>(arg.data()), arg.size());
+    if (exclusive) {
+        *exclusive = !s.empty() && s[0] == '(';
+        if (*exclusive) {
+            s.erase(0, 1);
+        }
+    }
+    double score;
+    try {
+        size_t pos;
+        score = std::stod(s, &pos);
+        if (pos != s.size()) {
+            throw std::invalid_argument(s);
+        }
+    } catch (...) {
+        throw redis_exception(exclusive ? "min or max is not a float" : "value is not a valid float");
+    }
+    if (std::isnan(score)) {
+        throw redis_exception("value is not a valid float");
+    }
+    return score;
+}
+
+future<redis_message> zadd(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 3 || req.arguments_size() % 2 == 0) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    std::vector<std::pair<double, bytes>> members;
+    members.reserve(req.arguments_size() / 2);
+    for (size_t i = 1; i < req.arguments_size(); i += 2) {
+        members.emplace_back(parse_score(req, req._args[i]), std::move(req._args[i + 1]));
+    }
+    return redis::write_zset(proxy, options, std::move(req._args[0]), std::move(members), permit).then([] (size_t added) {
+        return redis_message::number(added);
+    });
+}
+
+future<redis_message> zrem(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto members = std::vector<bytes>(std::make_move_iterator(req._args.begin() + 1), std::make_move_iterator(req._args.end()));
+    return redis::delete_zset_members(proxy, options, std::move(req._args[0]), std::move(members), permit).then([] (size_t removed) {
+        return redis_message::number(removed);
+    });
+}
+
+future<redis_message> zscore(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 2) {
+        throw wrong_arguments_exception(2, req.arguments_size(), req._command);
+    }
+    auto schema = get_zsets_schema(proxy, options);
+    auto ckey = clustering_key::from_single_value(*schema, make_zset_member_key(req._args[1]));
+    auto ps = partition_slice_builder(*schema)
+        .with_range(query::clustering_range::make_singular(std::move(ckey)))
+        .build();
+    return redis::query_collection(proxy, options, req._args[0], permit, schema, std::move(ps), 1).then([] (collection_rows rows) {
+        if (rows.empty()) {
+            return redis_message::nil();
+        }
+        return redis_message::make_strings_result(std::move(rows.front().second));
+    });
+}
+
+future<redis_message> zrangebyscore(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 3 && req.arguments_size() != 4) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    bool with_scores = false;
+    if (req.arguments_size() == 4) {
+        bytes opt(bytes::initialized_later(), req._args[3].size());
+        std::transform(req._args[3].begin(), req._args[3].end(), opt.begin(), ::tolower);
+        if (opt != "withscores") {
+            throw invalid_arguments_exception(req._command);
+        }
+        with_scores = true;
+    }
+    bool min_exclusive, max_exclusive;
+    auto min = encode_zset_score(parse_score(req, req._args[1], &min_exclusive)) + min_exclusive;
+    // The end of the range is exclusive, past all the members with the max score
+    auto max = encode_zset_score(parse_score(req, req._args[2], &max_exclusive)) + !max_exclusive;
+    if (min >= max) {
+        std::vector<std::optional<bytes>> values;
+        return redis_message::make_strings_list_result(values);
+    }
+    auto schema = get_zsets_schema(proxy, options);
+    return redis::query_zset_range(proxy, options, req._args[0], min, max, permit, schema).then([with_scores] (std::vector<std::pair<double, bytes>> members) {
+        std::vector<std::optional<bytes>> values;
+        values.reserve(members.size() * (1 + with_scores));
+        for (auto& [score, member] : members) {
+            values.emplace_back(std::move(member));
+            if (with_scores) {
+                values.emplace_back(to_bytes(fmt::format("{}", score)));
+            }
+        }
+        return redis_message::make_strings_list_result(values);
+    });
+}
+
 future<redis_message> del(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() == 0) {
         throw wrong_number_of_arguments_exception(req._command);
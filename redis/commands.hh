@@ -27,6 +27,16 @@ future<redis_message> hdel(service::storage_proxy& proxy, request& req, redis::r
 future<redis_message> hexists(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> set(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> setex(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> mget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> mset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> hmget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> lpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> rpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> lrange(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> zadd(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> zrem(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> zscore(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> zrangebyscore(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> del(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> unknown(service::storage_proxy&, request&, redis_options&, service_permit);
 future<redis_message> select(service::storage_proxy&, request& req, redis::redis_options& options, service_permit);
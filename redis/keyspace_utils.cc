@@ -124,7 +124,8 @@ schema_ptr zsets_schema(sstring ks_name) {
      // partition key
      {{"pkey", utf8_type}},
      // clustering key
-     {{"ckey", double_type}},
+     // see redis/collection_keys.hh
+     {{"ckey", bytes_type}},
      // regular columns
      {{"data", utf8_type}},
      // static columns
@@ -136,7 +137,8 @@ schema_ptr zsets_schema(sstring ks_name) {
     );
     builder.set_gc_grace_seconds(0);
     builder.with(schema_builder::compact_storage::yes);
-    builder.with_version(db::system_keyspace::generate_schema_version(builder.uuid()));
+    // The clustering key used to be the score, don't reuse the version of that layout
+    builder.with_version(db::system_keyspace::generate_schema_version(builder.uuid(), 1));
     return builder.build(schema_builder::compact_storage::yes);
 }
 
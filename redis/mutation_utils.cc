@@ -15,6 +15,12 @@
 #include "redis/options.hh"
 #include "mutation/mutation.hh"
 #include "service_permit.hh"
+#include "redis/collection_keys.hh"
+#include "redis/query_utils.hh"
+#include "utils/UUID_gen.hh"
+#include <seastar/core/coroutine.hh>
+#include <unordered_set>
+#include <boost/range/adaptor/map.hpp>
 
 using namespace seastar;
 
@@ -71,6 +77,96 @@ future<> write_strings(service::storage_proxy& proxy, redis::redis_options& opti
     return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
 }
 
+future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, std::vector<std::pair<bytes, bytes>>&& keys_and_data, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    std::vector<mutation> mutations;
+    mutations.reserve(keys_and_data.size());
+    for (auto& [key, data] : keys_and_data) {
+        mutations.push_back(make_mutation(proxy, options, std::move(key), std::move(data), 0));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::move(mutations), write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+future<> write_list(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& values, bool left, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    const column_definition& column = *schema->get_column_definition(redis::DATA_COLUMN_NAME);
+    auto m = mutation(schema, partition_key::from_single_value(*schema, key));
+    auto ts = api::new_timestamp();
+    auto id = utils::UUID_gen::get_time_UUID();
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        auto ckey = clustering_key::from_single_value(*schema, make_list_element_key(ts, left, i, id));
+        m.set_clustered_cell(ckey, column, make_cell(schema, *column.type, values[i]));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+
+future<size_t> write_zset(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<std::pair<double, bytes>>&& members, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    auto schema = get_zsets_schema(proxy, options);
+    // A member may be given several times, the last score wins
+    std::unordered_set<bytes> seen;
+    std::reverse(members.begin(), members.end());
+    std::erase_if(members, [&seen] (const std::pair<double, bytes>& m) { return !seen.insert(m.second).second; });
+    auto names = boost::copy_range<std::vector<bytes>>(members | boost::adaptors::map_values);
+    // The member rows are the source of truth, but changing the score of a
+    // member should delete its previous score row, so the current scores of
+    // the members are read first. A concurrent change may still leave a
+    // stale score row, which readers ignore, see query_zset_range().
+    auto current = co_await query_zset_members(proxy, options, key, names, permit, schema);
+    std::unordered_map<bytes, bytes> scores;
+    for (auto& [ckey, score] : current) {
+        scores.emplace(ckey.substr(1), std::move(score));
+    }
+
+    const column_definition& column = *schema->get_column_definition(redis::DATA_COLUMN_NAME);
+    auto m = mutation(schema, partition_key::from_single_value(*schema, key));
+    auto ts = api::new_timestamp();
+    auto clk = gc_clock::now();
+    size_t added = 0;
+    for (auto& [score, member] : members) {
+        auto it = scores.find(member);
+        if (it == scores.end()) {
+            ++added;
+        } else {
+            auto old_score = std::stod(std::string(reinterpret_cast<const char*>(it->second.data()), it->second.size()));
+            if (old_score == score) {
+                continue;
+            }
+            auto old_ckey = clustering_key::from_single_value(*schema, make_zset_score_key(old_score, member));
+            m.partition().apply_delete(*schema, old_ckey, tombstone { ts, clk });
+        }
+        auto score_text = to_bytes(fmt::format("{}", score));
+        auto score_ckey = clustering_key::from_single_value(*schema, make_zset_score_key(score, member));
+        m.set_clustered_cell(score_ckey, column, atomic_cell::make_live(*column.type, ts, bytes_view(), atomic_cell::collection_member::no));
+        auto member_ckey = clustering_key::from_single_value(*schema, make_zset_member_key(member));
+        m.set_clustered_cell(member_ckey, column, atomic_cell::make_live(*column.type, ts, score_text, atomic_cell::collection_member::no));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    co_await proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+    co_return added;
+}
+
+future<size_t> delete_zset_members(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& members, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    auto schema = get_zsets_schema(proxy, options);
+    auto current = co_await query_zset_members(proxy, options, key, members, permit, schema);
+    if (current.empty()) {
+        co_return 0;
+    }
+    auto m = mutation(schema, partition_key::from_single_value(*schema, key));
+    tombstone t { api::new_timestamp(), gc_clock::now() };
+    for (auto& [ckey, score] : current) {
+        auto member = bytes_view(ckey).substr(1);
+        auto old_score = std::stod(std::string(reinterpret_cast<const char*>(score.data()), score.size()));
+        m.partition().apply_delete(*schema, clustering_key::from_single_value(*schema, make_zset_score_key(old_score, member)), t);
+        m.partition().apply_delete(*schema, clustering_key::from_single_value(*schema, ckey), t);
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    co_await proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+    co_return current.size();
+}
 
 mutation make_tombstone(service::storage_proxy& proxy, const redis_options& options, const sstring& cf_name, const bytes& key) {
     auto schema = get_schema(proxy, options.get_keyspace_name(), cf_name);
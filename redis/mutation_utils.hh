@@ -22,6 +22,12 @@ class redis_options;
 
 future<> write_hashes(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& field, bytes&& data, long ttl, service_permit permit);
 future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& data, long ttl, service_permit permit);
+future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, std::vector<std::pair<bytes, bytes>>&& keys_and_data, service_permit permit);
+future<> write_list(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& values, bool left, service_permit permit);
+// Adds members to a sorted set, or changes their score. Returns the number of members added.
+future<size_t> write_zset(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<std::pair<double, bytes>>&& members, service_permit permit);
+// Returns the number of members removed
+future<size_t> delete_zset_members(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& members, service_permit permit);
 future<> delete_objects(service::storage_proxy& proxy, redis::redis_options& options, std::vector<bytes>&& keys, service_permit permit);
 future<> delete_fields(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& fields, service_permit permit);
 
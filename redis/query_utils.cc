@@ -19,6 +19,14 @@
 #include "gc_clock.hh"
 #include "service_permit.hh"
 #include "redis/keyspace_utils.hh"
+#include "redis/exceptions.hh"
+#include "types/types.hh"
+#include "redis/collection_keys.hh"
+#include <seastar/core/coroutine.hh>
+#include <unordered_map>
+#include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/iterator_range.hpp>
 
 namespace redis {
 
@@ -87,6 +95,82 @@ future<lw_shared_ptr<strings_result>> query_strings(service::storage_proxy& prox
     });
 }
 
+// Collects the results of a query of several partitions of the strings
+// table, by key. The slice must have the send_partition_key option set.
+class multi_strings_result_builder {
+    std::unordered_map<bytes, strings_result>& _data;
+    const query::partition_slice& _partition_slice;
+    const schema_ptr _schema;
+    strings_result* _current = nullptr;
+public:
+    multi_strings_result_builder(std::unordered_map<bytes, strings_result>& data, const schema_ptr schema, const query::partition_slice& ps)
+        : _data(data)
+        , _partition_slice(ps)
+        , _schema(schema)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {
+        _current = &_data[key.explode(*_schema).front()];
+    }
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        auto row_iterator = row.iterator();
+        for (auto&& id : _partition_slice.regular_columns) {
+            auto cell = row_iterator.next_atomic_cell();
+            if (cell && _current) {
+                auto& col = _schema->regular_column_at(id);
+                cell->value().with_linearized([this, &col, &cell] (bytes_view cell_view) {
+                    _current->_result = col.type->deserialize_value(cell_view).serialize_nonnull();
+                    if (cell->expiry().has_value()) {
+                        _current->_ttl = cell->expiry().value() - gc_clock::now();
+                    }
+                    _current->_has_result = true;
+                });
+            }
+        }
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {
+        _current = nullptr;
+    }
+};
+
+future<std::vector<strings_result>> read_strings(service::storage_proxy& proxy, const redis_options& options, const std::vector<bytes>& keys, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::STRINGs);
+    auto ps = partition_slice_builder(*schema)
+        .with_option<query::partition_slice::option::send_partition_key>()
+        .build();
+    // The storage proxy wants the ranges sorted and without duplicates
+    std::vector<dht::decorated_key> dks;
+    dks.reserve(keys.size());
+    for (auto& key : keys) {
+        dks.push_back(dht::decorate_key(*schema, partition_key::from_single_value(*schema, key)));
+    }
+    std::sort(dks.begin(), dks.end(), dht::ring_position_less_comparator(*schema));
+    dks.erase(std::unique(dks.begin(), dks.end(), [&schema] (const dht::decorated_key& a, const dht::decorated_key& b) {
+        return a.equal(*schema, b);
+    }), dks.end());
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.reserve(dks.size());
+    for (auto& dk : dks) {
+        partition_ranges.emplace_back(dht::partition_range::make_singular(std::move(dk)));
+    }
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    const auto max_tombstones = proxy.get_tombstone_limit();
+    auto nr_partitions = partition_ranges.size();
+    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, query::row_limit(nr_partitions), query::partition_limit(nr_partitions), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema, &keys] (auto qr) {
+        std::unordered_map<bytes, strings_result> by_key;
+        query::result_view::consume(*qr.query_result, ps, multi_strings_result_builder(by_key, schema, ps));
+        return boost::copy_range<std::vector<strings_result>>(keys | boost::adaptors::transformed([&by_key] (const bytes& key) {
+            auto it = by_key.find(key);
+            return it != by_key.end() ? it->second : strings_result{};
+        }));
+    });
+}
 
 class hashes_result_builder {
     lw_shared_ptr<std::map<bytes, bytes>> _data;
@@ -145,6 +229,131 @@ future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy
     return query_hashes(proxy, options, key, permit, schema, ps);
 }
 
+future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, const std::vector<bytes>& fields, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::HASHes);
+    std::vector<clustering_key> ckeys;
+    ckeys.reserve(fields.size());
+    for (auto& field : fields) {
+        ckeys.push_back(clustering_key::from_single_value(*schema, field));
+    }
+    // The clustering ranges of a slice must be sorted and must not overlap
+    clustering_key::less_compare less(*schema);
+    std::sort(ckeys.begin(), ckeys.end(), less);
+    ckeys.erase(std::unique(ckeys.begin(), ckeys.end(), clustering_key::equality(*schema)), ckeys.end());
+    auto ranges = boost::copy_range<std::vector<query::clustering_range>>(ckeys | boost::adaptors::transformed([] (clustering_key& ckey) {
+        return query::clustering_range::make_singular(std::move(ckey));
+    }));
+
+    auto ps = partition_slice_builder(*schema)
+        .with_ranges(std::move(ranges))
+        .build();
+    return query_hashes(proxy, options, key, permit, schema, ps);
+}
+
+class collection_result_builder {
+    collection_rows& _data;
+    const query::partition_slice& _partition_slice;
+    const schema_ptr _schema;
+public:
+    collection_result_builder(collection_rows& data, const schema_ptr schema, const query::partition_slice& ps)
+        : _data(data)
+        , _partition_slice(ps)
+        , _schema(schema)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {}
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        auto row_iterator = row.iterator();
+        for (auto&& id : _partition_slice.regular_columns) {
+            auto cell = row_iterator.next_atomic_cell();
+            if (cell) {
+                cell->value().with_linearized([this, &key] (bytes_view cell_view) {
+                    _data.emplace_back(key.explode(*_schema).front(), bytes(cell_view));
+                });
+            }
+        }
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {}
+};
+
+future<collection_rows> query_collection(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps, uint64_t row_limit) {
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    const auto max_tombstones = proxy.get_tombstone_limit();
+    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, query::row_limit(row_limit), query::partition_limit(1), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto partition_range = dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey)));
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.emplace_back(std::move(partition_range));
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema] (auto qr) {
+        collection_rows rows;
+        query::result_view::consume(*qr.query_result, ps, collection_result_builder(rows, schema, ps));
+        return rows;
+    });
+}
+
+schema_ptr get_zsets_schema(service::storage_proxy& proxy, const redis_options& options) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::ZSETs);
+    if (schema->clustering_key_size() != 1 || schema->clustering_key_columns().front().type != bytes_type) {
+        throw redis_exception(fmt::format("table {}.{} has an unsupported layout, drop it and restart the node to recreate it", schema->ks_name(), schema->cf_name()));
+    }
+    return schema;
+}
+
+future<collection_rows> query_zset_members(service::storage_proxy& proxy, const redis_options& options, const bytes& key, const std::vector<bytes>& members, service_permit permit, schema_ptr schema) {
+    std::vector<clustering_key> ckeys;
+    ckeys.reserve(members.size());
+    for (auto& member : members) {
+        ckeys.push_back(clustering_key::from_single_value(*schema, make_zset_member_key(member)));
+    }
+    // The clustering ranges of a slice must be sorted and must not overlap
+    std::sort(ckeys.begin(), ckeys.end(), clustering_key::less_compare(*schema));
+    ckeys.erase(std::unique(ckeys.begin(), ckeys.end(), clustering_key::equality(*schema)), ckeys.end());
+    auto ranges = boost::copy_range<std::vector<query::clustering_range>>(ckeys | boost::adaptors::transformed([] (clustering_key& ckey) {
+        return query::clustering_range::make_singular(std::move(ckey));
+    }));
+    auto nr_ranges = ranges.size();
+    auto ps = partition_slice_builder(*schema).with_ranges(std::move(ranges)).build();
+    return query_collection(proxy, options, key, permit, schema, std::move(ps), nr_ranges);
+}
+
+future<std::vector<std::pair<double, bytes>>> query_zset_range(service::storage_proxy& proxy, const redis_options& options, const bytes& key, uint64_t min, uint64_t max, service_permit permit, schema_ptr schema) {
+    using bound = query::clustering_range::bound;
+    auto range = query::clustering_range::make(
+            bound(clustering_key::from_single_value(*schema, make_zset_score_key(min)), true),
+            bound(clustering_key::from_single_value(*schema, make_zset_score_key(max)), false));
+    auto ps = partition_slice_builder(*schema)
+        .with_range(std::move(range))
+        .build();
+    auto score_rows = co_await query_collection(proxy, options, key, permit, schema, std::move(ps), query::max_rows);
+    std::vector<std::pair<double, bytes>> members;
+    members.reserve(score_rows.size());
+    for (auto& [ckey, data] : score_rows) {
+        auto [score, member] = parse_zset_score_key(ckey);
+        members.emplace_back(score, bytes(member));
+    }
+    if (members.empty()) {
+        co_return members;
+    }
+    // A score row may be stale, when concurrent writes changed the score of
+    // its member, so only the ones matching the member rows, whose score is
+    // a single cell, are current.
+    auto member_rows = co_await query_zset_members(proxy, options, key, boost::copy_range<std::vector<bytes>>(members | boost::adaptors::map_values), permit, schema);
+    std::unordered_map<bytes, uint64_t> scores;
+    for (auto& [ckey, score] : member_rows) {
+        scores.emplace(ckey.substr(1), encode_zset_score(std::stod(std::string(reinterpret_cast<const char*>(score.data()), score.size()))));
+    }
+    std::erase_if(members, [&scores] (const std::pair<double, bytes>& m) {
+        auto it = scores.find(m.second);
+        return it == scores.end() || it->second != encode_zset_score(m.first);
+    });
+    co_return members;
+}
+
 future<lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps) {
     const auto max_result_size = proxy.get_max_result_size(ps);
     const auto max_tombstones = proxy.get_tombstone_limit();
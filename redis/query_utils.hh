@@ -37,9 +37,25 @@ struct strings_result {
 
 seastar::future<seastar::lw_shared_ptr<strings_result>> read_strings(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
 seastar::future<seastar::lw_shared_ptr<strings_result>> query_strings(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
+// Reads several keys with a single query, the results are in the order of the keys.
+seastar::future<std::vector<strings_result>> read_strings(service::storage_proxy&, const redis_options&, const std::vector<bytes>&, service_permit);
 
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const bytes&, service_permit);
+seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const std::vector<bytes>&, service_permit);
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
 
+// The (clustering key, data) pairs of a partition of the LISTs or ZSETs
+// tables, see redis/collection_keys.hh, in clustering order.
+using collection_rows = std::vector<std::pair<bytes, bytes>>;
+seastar::future<collection_rows> query_collection(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice, uint64_t row_limit);
+// Throws if the ZSETs table was created with a layout older than the one in
+// redis/collection_keys.hh.
+schema_ptr get_zsets_schema(service::storage_proxy&, const redis_options&);
+// Reads the member rows of the given members of a sorted set, to find their scores.
+seastar::future<collection_rows> query_zset_members(service::storage_proxy&, const redis_options&, const bytes&, const std::vector<bytes>& members, service_permit, schema_ptr);
+// The members of a sorted set with an encoded score in [min, max), with their
+// scores, in score order.
+seastar::future<std::vector<std::pair<double, bytes>>> query_zset_range(service::storage_proxy&, const redis_options&, const bytes&, uint64_t min, uint64_t max, service_permit, schema_ptr);
+
 }
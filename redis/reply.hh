@@ -68,6 +68,19 @@ class redis_message final {
         }
         return make_ready_future<redis_message>(m);
     }
+    // An array of bulk strings, with nil for the missing ones
+    static seastar::future<redis_message> make_strings_list_result(std::vector<std::optional<bytes>>& list_result) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", list_result.size()));
+        for (auto& r : list_result) {
+            if (r) {
+                write_bytes(m, *r);
+            } else {
+                m->append_static("$-1\r\n");
+            }
+        }
+        return make_ready_future<redis_message>(m);
+    }
     static seastar::future<redis_message> make_strings_result(bytes result) {
         auto m = make_lw_shared<scattered_message<char>> ();
         write_bytes(m, result);
@@ -78,8 +78,8 @@ redis_server::connection::~connection() {
 
 thread_local redis_server::connection::execution_stage_type redis_server::connection::_process_request_stage {"redis_transport", &connection::process_request_one};
 
-future<redis_server::result> redis_server::connection::process_request_internal() {
-    return _process_request_stage(this, _parser.get_request(), seastar::ref(_options), empty_service_permit());
+future<redis_server::result> redis_server::connection::process_request_internal(redis::request&& request) {
+    return _process_request_stage(this, std::move(request), seastar::ref(_options), empty_service_permit());
 }
 
 void redis_server::connection::write_reply(const redis_exception& e)
@@ -104,37 +104,73 @@ void redis_server::connection::write_reply(redis_server::result result)
     });
 }
 
+void redis_server::connection::write_reply(future<redis_server::result> result)
+{
+    _ready_to_respond = _ready_to_respond.then([this, result = std::move(result)] () mutable {
+        return std::move(result).then([this] (redis_server::result result) {
+            auto m = result.make_message();
+            return _write_buf.write(std::move(*m)).then([this] {
+                return _write_buf.flush();
+            });
+        });
+    });
+}
+
 future<> redis_server::connection::process_request() {
     _parser.init();
     return _read_buf.consume(_parser).then([this] {
         if (_parser.eof()) {
             return make_ready_future<>();
         }
-        ++_server._stats._requests_serving;
-        _pending_requests_gate.enter();
-        utils::latency_counter lc;
-        lc.start();
-        auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
-        return process_request_internal().then([this, leave = std::move(leave), lc = std::move(lc)] (auto&& result) mutable {
-            --_server._stats._requests_serving;
-            try {
-                if (_parser.failed()) {
-                    logging.error("request parse failed");
-                    const auto e = redis_exception("unknown command ''");
-                    write_reply(std::move(e));
-                }else{
-                    write_reply(std::move(result));
-                }
+        // Clients pipelining requests don't wait for a reply before sending
+        // the next request, so we don't wait for a request to be executed
+        // before reading the next one either. Up to max_pipelined_requests
+        // execute concurrently, and the replies are written in the order of
+        // the requests.
+        // SELECT changes the keyspace of the following requests, so it waits
+        // for all the requests before it, and they for it.
+        bool exclusive = _parser.get_request()._command == "select";
+        return get_units(_pipelined_requests, exclusive ? max_pipelined_requests : 1).then([this, exclusive] (semaphore_units<> units) {
+            if (_parser.failed()) {
+                logging.error("request parse failed");
+                write_reply(make_ready_future<redis_server::result>(make_error_reply(redis_exception("unknown command ''"))));
+                return make_ready_future<>();
+            }
+            ++_server._stats._requests_serving;
+            _pending_requests_gate.enter();
+            utils::latency_counter lc;
+            lc.start();
+            auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
+            auto f = process_request_internal(std::move(_parser.get_request())).then_wrapped([this, leave = std::move(leave), lc = std::move(lc), units = std::move(units)] (future<redis_server::result> f) mutable {
+                --_server._stats._requests_serving;
                 ++_server._stats._requests_served;
                 _server._stats._requests.mark(lc.stop().latency());
                 _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
-            } catch (...) {
-                logging.error("request processing failed: {}", std::current_exception());
+                try {
+                    return f.get();
+                } catch (redis_exception& e) {
+                    return make_error_reply(e);
+                } catch (std::exception& e) {
+                    return make_error_reply(redis_exception { e.what() });
+                } catch (...) {
+                    return make_error_reply(redis_exception { "Unknown exception" });
+                }
+            });
+            if (exclusive) {
+                return f.then([this] (redis_server::result result) {
+                    write_reply(make_ready_future<redis_server::result>(std::move(result)));
+                });
             }
+            write_reply(std::move(f));
+            return make_ready_future<>();
         });
     });
 }
 
+redis_server::result redis_server::connection::make_error_reply(const redis_exception& e) {
+    return redis_message::exception(e.what_message()).get();
+}
+
 void redis_server::connection::handle_error(future<>&& f) {
     try {
         f.get();
@@ -80,6 +80,9 @@ class redis_server : public generic_server::server {
         socket_address _server_addr;
         redis_protocol_parser _parser;
         redis::redis_options _options;
+        // How many requests read from the connection may execute concurrently
+        static constexpr size_t max_pipelined_requests = 128;
+        semaphore _pipelined_requests{max_pipelined_requests};
 
         using execution_stage_type = inheriting_concrete_execution_stage<
                 future<redis_server::result>,
@@ -96,9 +99,12 @@ class redis_server : public generic_server::server {
         void handle_error(future<>&& f) override;
         void write_reply(const redis_exception&);
         void write_reply(redis_server::result result);
+        // Writes the reply once it's ready, after the ones of the requests before it
+        void write_reply(future<redis_server::result> result);
     private:
         future<result> process_request_one(redis::request&& request, redis::redis_options&, service_permit permit);
-        future<result> process_request_internal();
+        future<result> process_request_internal(redis::request&& request);
+        static result make_error_reply(const redis_exception& e);
     };
 
     virtual shared_ptr<generic_server::connection> make_connection(socket_address server_addr, connected_socket&& fd, socket_address addr) override;
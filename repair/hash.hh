@@ -5,6 +5,7 @@
 #include "schema/schema.hh"
 
 class decorated_key_with_hash;
+enum class row_level_diff_detect_algorithm : uint8_t;
 class mutation_fragment;
 
 // Hash of a repair row
@@ -31,10 +32,12 @@ using repair_hash_set = absl::btree_set<repair_hash>;
 class repair_hasher {
     uint64_t _seed;
     schema_ptr _schema;
+    row_level_diff_detect_algorithm _algo;
 public:
-    repair_hasher(uint64_t seed, schema_ptr s)
+    repair_hasher(uint64_t seed, schema_ptr s, row_level_diff_detect_algorithm algo)
         : _seed(seed)
         , _schema(std::move(s))
+        , _algo(algo)
     {}
 
     repair_hash do_hash_for_mf(const decorated_key_with_hash& dk_with_hash, const mutation_fragment& mf);
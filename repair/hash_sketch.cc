@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#include "repair/hash_sketch.hh"
+
+// Every hash is added to one cell of each of the nr_tables equal parts of
+// the sketch, so that its cells are distinct.
+static constexpr size_t nr_tables = 3;
+static constexpr size_t min_cells = 16 * nr_tables;
+
+static uint64_t mix(uint64_t x) noexcept {
+    // splitmix64 finalizer
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+static uint64_t check_sum_of(uint64_t hash) noexcept {
+    return mix(hash ^ 0x5bd1e9955bd1e995);
+}
+
+template <typename Func>
+static void for_each_cell_of(uint64_t hash, size_t nr_cells, Func&& func) {
+    size_t table_size = nr_cells / nr_tables;
+    for (size_t i = 0; i < nr_tables; ++i) {
+        func(i * table_size + mix(hash + i) % table_size);
+    }
+}
+
+static void add(std::vector<repair_hash_sketch_cell>& cells, uint64_t hash, int32_t count) {
+    auto check_sum = check_sum_of(hash);
+    for_each_cell_of(hash, cells.size(), [&] (size_t idx) {
+        auto& c = cells[idx];
+        c.count += count;
+        c.hash_sum ^= hash;
+        c.check_sum ^= check_sum;
+    });
+}
+
+repair_hash_sketch::repair_hash_sketch(size_t nr_cells)
+    : _cells(std::max(nr_cells, min_cells) / nr_tables * nr_tables)
+{ }
+
+void repair_hash_sketch::insert(const repair_hash& h) {
+    add(_cells, h.hash, 1);
+}
+
+std::optional<repair_hash_sketch::difference> repair_hash_sketch::decode_difference(const repair_hash_sketch& remote) const {
+    if (remote._cells.size() != _cells.size() || _cells.size() % nr_tables) {
+        throw std::runtime_error(fmt::format("repair_hash_sketch: cannot subtract a sketch of {} cells from one of {} cells",
+                remote._cells.size(), _cells.size()));
+    }
+    auto cells = _cells;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        cells[i].count -= remote._cells[i].count;
+        cells[i].hash_sum ^= remote._cells[i].hash_sum;
+        cells[i].check_sum ^= remote._cells[i].check_sum;
+    }
+    auto is_pure = [] (const repair_hash_sketch_cell& c) {
+        return (c.count == 1 || c.count == -1) && check_sum_of(c.hash_sum) == c.check_sum;
+    };
+    difference diff;
+    std::vector<size_t> pure;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (is_pure(cells[i])) {
+            pure.push_back(i);
+        }
+    }
+    // Peeling a pure cell removes its hash from the other cells it is in,
+    // which may make them pure in turn.
+    while (!pure.empty()) {
+        auto& c = cells[pure.back()];
+        pure.pop_back();
+        if (!is_pure(c)) {
+            continue;
+        }
+        auto hash = c.hash_sum;
+        auto count = c.count;
+        auto& set = count > 0 ? diff.local_only : diff.remote_only;
+        if (!set.emplace(hash).second) {
+            // A checksum collision made a cell look pure.
+            return std::nullopt;
+        }
+        add(cells, hash, -count);
+        for_each_cell_of(hash, cells.size(), [&] (size_t idx) {
+            if (is_pure(cells[idx])) {
+                pure.push_back(idx);
+            }
+        });
+    }
+    auto empty = [] (const repair_hash_sketch_cell& c) {
+        return c.count == 0 && c.hash_sum == 0 && c.check_sum == 0;
+    };
+    if (!std::all_of(cells.begin(), cells.end(), empty)) {
+        return std::nullopt;
+    }
+    return diff;
+}
+
+size_t repair_hash_sketch::nr_cells_for(size_t nr_hashes) {
+    // A cell is 20 bytes on the wire and a hash 8 bytes, so this is about a
+    // third of the size of the set, and decodes up to about nr_hashes / 12
+    // differences.
+    return std::max(nr_hashes / 8, min_cells);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "repair/hash.hh"
+
+struct repair_hash_sketch_cell {
+    int32_t count = 0;
+    uint64_t hash_sum = 0;
+    uint64_t check_sum = 0;
+};
+
+// An invertible Bloom lookup table of row hashes.
+//
+// Two nodes build sketches with the same number of cells of their sets of
+// row hashes. Subtracting one sketch from the other cancels out the hashes
+// both sets have, and the hashes which are in only one of the sets can then
+// be listed, as long as there are not many more of them than about two
+// thirds of the number of cells. So the size of the sketch, unlike that of
+// the full set of hashes, only depends on the number of differences.
+class repair_hash_sketch {
+    std::vector<repair_hash_sketch_cell> _cells;
+public:
+    // The hashes only in the sketch subtracted from, and only in the other.
+    struct difference {
+        repair_hash_set local_only;
+        repair_hash_set remote_only;
+    };
+
+    // Below this number of hashes, the full set is about as small.
+    static constexpr size_t min_hashes = 512;
+
+    repair_hash_sketch() = default;
+    explicit repair_hash_sketch(size_t nr_cells);
+    explicit repair_hash_sketch(std::vector<repair_hash_sketch_cell> cells) : _cells(std::move(cells)) {}
+
+    const std::vector<repair_hash_sketch_cell>& cells() const {
+        return _cells;
+    }
+
+    // Must not be called twice with the same hash.
+    void insert(const repair_hash& h);
+
+    // Lists the hashes in only one of this sketch and \p remote, or returns
+    // std::nullopt if there are too many of them. \p remote must have the
+    // same number of cells.
+    std::optional<difference> decode_difference(const repair_hash_sketch& remote) const;
+
+    // The number of cells to use for a sketch of a set of nr_hashes hashes,
+    // small enough for the sketch to be several times smaller than the set.
+    static size_t nr_cells_for(size_t nr_hashes);
+};
@@ -122,6 +122,8 @@ std::ostream& operator<<(std::ostream& out, row_level_diff_detect_algorithm algo
         return out << "send_full_set";
     case row_level_diff_detect_algorithm::send_full_set_rpc_stream:
         return out << "send_full_set_rpc_stream";
+    case row_level_diff_detect_algorithm::send_full_set_rpc_stream_xxh3:
+        return out << "send_full_set_rpc_stream_xxh3";
     };
     return out << "unknown";
 }
@@ -563,7 +565,8 @@ repair::shard_repair_task_impl::shard_repair_task_impl(tasks::task_manager::modu
         const std::vector<sstring>& hosts_,
         const std::unordered_set<gms::inet_address>& ignore_nodes_,
         streaming::stream_reason reason_,
-        bool hints_batchlog_flushed)
+        bool hints_batchlog_flushed,
+        bool incremental_)
     : repair_task_impl(module, id, 0, keyspace, "", "", parent_id_.uuid(), reason_)
     , rs(repair)
     , db(repair.get_db())
@@ -584,6 +587,7 @@ repair::shard_repair_task_impl::shard_repair_task_impl(tasks::task_manager::modu
     , total_rf(erm->get_replication_factor())
     , nr_ranges_total(ranges.size())
     , _hints_batchlog_flushed(std::move(hints_batchlog_flushed))
+    , incremental(incremental_)
 { }
 
 void repair::shard_repair_task_impl::check_failed_ranges() {
@@ -789,6 +793,10 @@ struct repair_options {
     // The node starting the repair must be in the data center; Issuing a
     // repair to a data center other than the named one returns an error.
     std::vector<sstring> data_centers;
+    // If incremental is true, only the data not repaired yet is compared,
+    // and the sstables are marked as repaired once all the ranges of a node
+    // are, see sstables::sstable::is_repaired().
+    bool incremental = false;
 
     repair_options(std::unordered_map<sstring, sstring> options) {
         bool_opt(primary_range, options, PRIMARY_RANGE_KEY);
@@ -797,14 +805,7 @@ struct repair_options {
         list_opt(hosts, options, HOSTS_KEY);
         list_opt(ignore_nodes, options, IGNORE_NODES_KEY);
         list_opt(data_centers, options, DATACENTERS_KEY);
-        // We currently do not support incremental repair. We could probably
-        // ignore this option as it is just an optimization, but for now,
-        // let's make it an error.
-        bool incremental = false;
         bool_opt(incremental, options, INCREMENTAL_KEY);
-        if (incremental) {
-            throw std::runtime_error("unsupported incremental repair");
-        }
         // We do not currently support the distinction between "parallel" and
         // "sequential" repair, and operate the same for both.
         // We don't currently support "dc parallel" parallelism.
@@ -1125,7 +1126,11 @@ future<int> repair_service::do_repair_start(sstring keyspace, std::unordered_map
         co_return id.id;
     }
 
-    auto task = co_await _repair_module->make_and_start_task<repair::user_requested_repair_task_impl>({}, id, std::move(keyspace), "", germs, std::move(cfs), std::move(ranges), std::move(options.hosts), std::move(options.data_centers), std::move(ignore_nodes));
+    if (options.incremental && !db.features().incremental_repair) {
+        throw std::runtime_error("Incremental repair is not supported by all the nodes of the cluster yet");
+    }
+
+    auto task = co_await _repair_module->make_and_start_task<repair::user_requested_repair_task_impl>({}, id, std::move(keyspace), "", germs, std::move(cfs), std::move(ranges), std::move(options.hosts), std::move(options.data_centers), std::move(ignore_nodes), options.incremental);
     co_return id.id;
 }
 
@@ -1137,10 +1142,13 @@ future<> repair::user_requested_repair_task_impl::run() {
     auto id = get_repair_uniq_id();
 
     return module->run(id, [this, &rs, &db, id, keyspace = _status.keyspace, germs = std::move(_germs),
-            cfs = std::move(_cfs), ranges = std::move(_ranges), hosts = std::move(_hosts), data_centers = std::move(_data_centers), ignore_nodes = std::move(_ignore_nodes)] () mutable {
+            cfs = std::move(_cfs), ranges = std::move(_ranges), hosts = std::move(_hosts), data_centers = std::move(_data_centers), ignore_nodes = std::move(_ignore_nodes),
+            incremental = _incremental] () mutable {
         auto uuid = node_ops_id{id.uuid().uuid()};
 
-        bool needs_flush_before_repair = false;
+        // Incremental repair marks sstables as repaired when the history of
+        // the ranges is updated, which requires hints and batchlog to be flushed.
+        bool needs_flush_before_repair = incremental;
         if (db.features().tombstone_gc_options) {
             for (auto& table: cfs) {
                 if (const auto* cf = find_column_family_if_exists(db, keyspace, table)) {
@@ -1233,12 +1241,12 @@ future<> repair::user_requested_repair_task_impl::run() {
         }
 
         for (auto shard : boost::irange(unsigned(0), smp::count)) {
-            auto f = rs.container().invoke_on(shard, [keyspace, table_ids, id, ranges, hints_batchlog_flushed,
+            auto f = rs.container().invoke_on(shard, [keyspace, table_ids, id, ranges, hints_batchlog_flushed, incremental,
                     data_centers, hosts, ignore_nodes, parent_data = get_repair_uniq_id().task_info, germs] (repair_service& local_repair) mutable -> future<> {
                 local_repair.get_metrics().repair_total_ranges_sum += ranges.size();
                 auto task = co_await local_repair._repair_module->make_and_start_task<repair::shard_repair_task_impl>(parent_data, tasks::task_id::create_random_id(), keyspace,
                         local_repair, germs->get().shared_from_this(), std::move(ranges), std::move(table_ids),
-                        id, std::move(data_centers), std::move(hosts), std::move(ignore_nodes), streaming::stream_reason::repair, hints_batchlog_flushed);
+                        id, std::move(data_centers), std::move(hosts), std::move(ignore_nodes), streaming::stream_reason::repair, hints_batchlog_flushed, incremental);
                 co_await task->done();
             });
             repair_results.push_back(std::move(f));
@@ -1344,7 +1352,7 @@ future<> repair::data_sync_repair_task_impl::run() {
                 bool hints_batchlog_flushed = false;
                 auto task_impl_ptr = seastar::make_shared<repair::shard_repair_task_impl>(local_repair._repair_module, tasks::task_id::create_random_id(), keyspace,
                         local_repair, germs->get().shared_from_this(), std::move(ranges), std::move(table_ids),
-                        id, std::move(data_centers), std::move(hosts), std::move(ignore_nodes), reason, hints_batchlog_flushed);
+                        id, std::move(data_centers), std::move(hosts), std::move(ignore_nodes), reason, hints_batchlog_flushed, false);
                 task_impl_ptr->neighbors = std::move(neighbors);
                 auto task = co_await local_repair._repair_module->make_task(std::move(task_impl_ptr), parent_data);
                 task->start();
@@ -245,6 +245,9 @@ struct repair_row_on_wire_with_cmd {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    // Same as send_full_set_rpc_stream, but the row hashes are computed
+    // with XXH3 instead of XXH64.
+    send_full_set_rpc_stream_xxh3,
 };
 
 std::ostream& operator<<(std::ostream& out, row_level_diff_detect_algorithm algo);
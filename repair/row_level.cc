@@ -53,6 +53,7 @@
 #include "readers/queue.hh"
 #include "readers/mutation_fragment_v1_stream.hh"
 #include "repair/hash.hh"
+#include "repair/hash_sketch.hh"
 #include "repair/decorated_key_with_hash.hh"
 #include "repair/row.hh"
 #include "repair/writer.hh"
@@ -83,6 +84,8 @@ enum class repair_state : uint16_t {
     get_full_row_hashes_with_rpc_stream_finished,
     get_full_row_hashes_started,
     get_full_row_hashes_finished,
+    get_row_hash_sketch_started,
+    get_row_hash_sketch_finished,
     get_row_diff_started,
     get_row_diff_finished,
     put_row_diff_with_rpc_stream_started,
@@ -207,6 +210,7 @@ static const std::vector<row_level_diff_detect_algorithm>& suportted_diff_detect
     static std::vector<row_level_diff_detect_algorithm> _algorithms = {
         row_level_diff_detect_algorithm::send_full_set,
         row_level_diff_detect_algorithm::send_full_set_rpc_stream,
+        row_level_diff_detect_algorithm::send_full_set_rpc_stream_xxh3,
     };
     return _algorithms;
 };
@@ -250,13 +254,22 @@ static uint64_t get_random_seed() {
     return random_dist(random_engine);
 }
 
-repair_hash repair_hasher::do_hash_for_mf(const decorated_key_with_hash& dk_with_hash, const mutation_fragment& mf) {
-    xx_hasher h(_seed);
-    feed_hash(h, mf, *_schema);
+template <typename Hasher>
+static repair_hash hash_for_mf(Hasher h, const decorated_key_with_hash& dk_with_hash, const mutation_fragment& mf, const schema& s) {
+    feed_hash(h, mf, s);
     feed_hash(h, dk_with_hash.hash.hash);
     return repair_hash(h.finalize_uint64());
 }
 
+repair_hash repair_hasher::do_hash_for_mf(const decorated_key_with_hash& dk_with_hash, const mutation_fragment& mf) {
+    // All the nodes of a repair use the algorithm chosen by the master, so
+    // they all hash the rows the same way.
+    if (_algo == row_level_diff_detect_algorithm::send_full_set_rpc_stream_xxh3) {
+        return hash_for_mf(xxh3_hasher(_seed), dk_with_hash, mf, *_schema);
+    }
+    return hash_for_mf(xx_hasher(_seed), dk_with_hash, mf, *_schema);
+}
+
 
 class repair_reader {
 public:
@@ -285,9 +298,10 @@ using is_local_reader = bool_class<class is_local_reader_tag>;
     flat_mutation_reader_v2 make_reader(
             seastar::sharded<replica::database>& db,
             replica::column_family& cf,
-            is_local_reader local_reader) {
+            is_local_reader local_reader,
+            replica::unrepaired_only only_unrepaired) {
         if (local_reader) {
-            auto ms = mutation_source([&cf] (
+            auto ms = mutation_source([&cf, only_unrepaired] (
                         schema_ptr s,
                         reader_permit permit,
                         const dht::partition_range& pr,
@@ -295,7 +309,7 @@ using is_local_reader = bool_class<class is_local_reader_tag>;
                         tracing::trace_state_ptr,
                         streamed_mutation::forwarding,
                         mutation_reader::forwarding fwd_mr) {
-                return cf.make_streaming_reader(std::move(s), std::move(permit), pr, ps, fwd_mr);
+                return cf.make_streaming_reader(std::move(s), std::move(permit), pr, ps, fwd_mr, only_unrepaired);
             });
             flat_mutation_reader_v2 rd(nullptr);
             std::tie(rd, _reader_handle) = make_manually_paused_evictable_reader_v2(
@@ -318,7 +332,7 @@ using is_local_reader = bool_class<class is_local_reader_tag>;
                     return std::optional<dht::partition_range>(dht::to_partition_range(*shard_range));
                 }
                 return std::optional<dht::partition_range>();
-            });
+            }, only_unrepaired);
         }
     }
 
@@ -332,14 +346,15 @@ using is_local_reader = bool_class<class is_local_reader_tag>;
             const dht::sharder& remote_sharder,
             unsigned remote_shard,
             uint64_t seed,
-            is_local_reader local_reader)
+            is_local_reader local_reader,
+            replica::unrepaired_only only_unrepaired)
             : _schema(s)
             , _permit(std::move(permit))
             , _range(dht::to_partition_range(range))
             , _sharder(remote_sharder, range, remote_shard)
             , _seed(seed)
             , _local_read_op(local_reader ? std::optional(cf.read_in_progress()) : std::nullopt)
-            , _reader(make_reader(db, cf, local_reader))
+            , _reader(make_reader(db, cf, local_reader, only_unrepaired))
     { }
 
     future<mutation_fragment_opt>
@@ -704,6 +719,9 @@ class repair_meta {
     gms::inet_address _myip;
     uint32_t _repair_meta_id;
     streaming::stream_reason _reason;
+    // The repair this is a part of, if it is incremental, null otherwise.
+    // Incremental repairs read only the unrepaired data.
+    tasks::task_id _incremental_repair_id;
     // Repair master's sharding configuration
     shard_config _master_node_shard_config;
     // sharding info of repair master
@@ -789,6 +807,7 @@ class repair_meta {
             repair_master master,
             uint32_t repair_meta_id,
             streaming::stream_reason reason,
+            tasks::task_id incremental_repair_id,
             shard_config master_node_shard_config,
             inet_address_vector_replica_set all_live_peer_nodes,
             size_t nr_peer_nodes = 1,
@@ -810,6 +829,7 @@ class repair_meta {
             , _myip(utils::fb_utilities::get_broadcast_address())
             , _repair_meta_id(repair_meta_id)
             , _reason(reason)
+            , _incremental_repair_id(incremental_repair_id)
             , _master_node_shard_config(std::move(master_node_shard_config))
             , _remote_sharder(make_remote_sharder())
             , _same_sharding_config(is_same_sharding_config())
@@ -823,7 +843,8 @@ class repair_meta {
                     _remote_sharder,
                     _master_node_shard_config.shard,
                     _seed,
-                    repair_reader::is_local_reader(_repair_master || _same_sharding_config)
+                    repair_reader::is_local_reader(_repair_master || _same_sharding_config),
+                    replica::unrepaired_only(bool(_incremental_repair_id))
               )
             , _repair_writer(make_repair_writer(_schema, _permit, _reason, _db, _sys_dist_ks, _view_update_generator))
             , _sink_source_for_get_full_row_hashes(_repair_meta_id, _nr_peer_nodes,
@@ -839,7 +860,7 @@ class repair_meta {
                         return rs.get_messaging().make_sink_and_source_for_repair_put_row_diff_with_rpc_stream(repair_meta_id, addr);
                 })
             , _row_level_repair_ptr(row_level_repair_ptr)
-            , _repair_hasher(_seed, _schema)
+            , _repair_hasher(_seed, _schema, _algo)
             {
             if (master) {
                 add_to_repair_meta_for_masters(*this);
@@ -1406,6 +1427,65 @@ class repair_meta {
         });
     }
 
+    // RPC API
+    // Return the hashes of the rows in _working_row_buf of the peer, worked
+    // out from the local ones and a sketch of the difference sent by the
+    // peer, or std::nullopt if they differ too much to decode it.
+    future<std::optional<repair_hash_set>>
+    get_full_row_hashes_with_sketch(gms::inet_address remote_node) {
+        auto hashes = co_await working_row_hashes();
+        auto nr_cells = repair_hash_sketch::nr_cells_for(hashes.size());
+        auto remote_sketch = co_await _messaging.send_repair_get_row_hash_sketch(msg_addr(remote_node), _repair_meta_id, nr_cells);
+        stats().rpc_call_nr++;
+        auto local_sketch = co_await make_row_hash_sketch(hashes, nr_cells);
+        auto diff = local_sketch.decode_difference(remote_sketch);
+        // The peer has the local rows, but those only the local node has,
+        // and those only it has.
+        auto consistent = diff && std::all_of(diff->local_only.begin(), diff->local_only.end(), [&] (const repair_hash& h) {
+            return hashes.contains(h);
+        }) && std::none_of(diff->remote_only.begin(), diff->remote_only.end(), [&] (const repair_hash& h) {
+            return hashes.contains(h);
+        });
+        if (!consistent) {
+            rlogger.debug("Could not decode the row hash sketch from peer={}, nr_cells={}, nr_local_hashes={}",
+                    remote_node, remote_sketch.cells().size(), hashes.size());
+            co_return std::nullopt;
+        }
+        for (auto& h : diff->local_only) {
+            hashes.erase(h);
+        }
+        hashes.insert(diff->remote_only.begin(), diff->remote_only.end());
+        rlogger.debug("Got row hash sketch from peer={}, nr_cells={}, local_only={}, remote_only={}",
+                remote_node, remote_sketch.cells().size(), diff->local_only.size(), diff->remote_only.size());
+        _metrics.rx_hashes_nr += diff->remote_only.size();
+        stats().rx_hashes_nr += diff->remote_only.size();
+        co_return hashes;
+    }
+
+    future<repair_hash_sketch>
+    get_row_hash_sketch_handler(size_t nr_cells) {
+        auto holder = _gate.hold();
+        auto hashes = co_await working_row_hashes();
+        co_return co_await make_row_hash_sketch(hashes, nr_cells);
+    }
+
+    // Whether to get the hashes of the peers with get_full_row_hashes_with_sketch()
+    bool use_row_hash_sketch() const {
+        return _db.local().features().repair_row_hash_sketch && _working_row_buf.size() >= repair_hash_sketch::min_hashes;
+    }
+
+private:
+    static future<repair_hash_sketch> make_row_hash_sketch(const repair_hash_set& hashes, size_t nr_cells) {
+        repair_hash_sketch sketch(nr_cells);
+        for (auto& h : hashes) {
+            sketch.insert(h);
+            co_await coroutine::maybe_yield();
+        }
+        co_return sketch;
+    }
+
+public:
+
     // RPC API
     // Return the combined hashes of the current working row buf
     future<get_combined_row_hash_response>
@@ -1450,7 +1530,7 @@ class repair_meta {
         return _messaging.send_repair_row_level_start(msg_addr(remote_node),
                 _repair_meta_id, ks_name, cf_name, std::move(range), _algo, _max_row_buf_size, _seed,
                 _master_node_shard_config.shard, _master_node_shard_config.shard_count, _master_node_shard_config.ignore_msb,
-                remote_partitioner_name, std::move(schema_version), reason).then([ks_name, cf_name] (rpc::optional<repair_row_level_start_response> resp) {
+                remote_partitioner_name, std::move(schema_version), reason, _incremental_repair_id).then([ks_name, cf_name] (rpc::optional<repair_row_level_start_response> resp) {
             if (resp && resp->status == repair_row_level_start_status::no_such_column_family) {
                 return make_exception_future<>(replica::no_such_column_family(ks_name, cf_name));
             } else {
@@ -1463,10 +1543,11 @@ class repair_meta {
     static future<repair_row_level_start_response>
     repair_row_level_start_handler(repair_service& repair, gms::inet_address from, uint32_t src_cpu_id, uint32_t repair_meta_id, sstring ks_name, sstring cf_name,
             dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size,
-            uint64_t seed, shard_config master_node_shard_config, table_schema_version schema_version, streaming::stream_reason reason, abort_source& as) {
+            uint64_t seed, shard_config master_node_shard_config, table_schema_version schema_version, streaming::stream_reason reason,
+            tasks::task_id incremental_repair_id, abort_source& as) {
         rlogger.debug(">>> Started Row Level Repair (Follower): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, schema_version={}, range={}, seed={}, max_row_buf_siz={}",
             utils::fb_utilities::get_broadcast_address(), from, repair_meta_id, ks_name, cf_name, schema_version, range, seed, max_row_buf_size);
-        return repair.insert_repair_meta(from, src_cpu_id, repair_meta_id, std::move(range), algo, max_row_buf_size, seed, std::move(master_node_shard_config), std::move(schema_version), reason, as).then([] {
+        return repair.insert_repair_meta(from, src_cpu_id, repair_meta_id, std::move(range), algo, max_row_buf_size, seed, std::move(master_node_shard_config), std::move(schema_version), reason, incremental_repair_id, as).then([] {
             return repair_row_level_start_response{repair_row_level_start_status::ok};
         }).handle_exception_type([] (replica::no_such_column_family&) {
             return repair_row_level_start_response{repair_row_level_start_status::no_such_column_family};
@@ -2102,6 +2183,9 @@ future<repair_update_system_table_response> repair_service::repair_update_system
     auto range_end = req.range.end() ? req.range.end()->value() : dht::maximum_token();
     ent.range_end = dht::token::to_int64(range_end);
     co_await _sys_ks.local().update_repair_history(std::move(ent));
+    co_await container().invoke_on(0, [&req] (repair_service& rs) {
+        return rs.update_incremental_repair_progress(req);
+    });
     co_return repair_update_system_table_response();
 }
 
@@ -2183,6 +2267,18 @@ future<> repair_service::init_ms_handlers() {
             });
         }) ;
     });
+    ms.register_repair_get_row_hash_sketch([this] (const rpc::client_info& cinfo, uint32_t repair_meta_id, uint32_t nr_cells) {
+        auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+        auto from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
+        return container().invoke_on(src_cpu_id % smp::count, [from, repair_meta_id, nr_cells] (repair_service& local_repair) {
+            auto rm = local_repair.get_repair_meta(from, repair_meta_id);
+            rm->set_repair_state_for_local_node(repair_state::get_row_hash_sketch_started);
+            return rm->get_row_hash_sketch_handler(nr_cells).then([rm] (repair_hash_sketch sketch) {
+                rm->set_repair_state_for_local_node(repair_state::get_row_hash_sketch_finished);
+                return sketch;
+            });
+        });
+    });
     ms.register_repair_get_combined_row_hash([this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
             std::optional<repair_sync_boundary> common_sync_boundary) {
         auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
@@ -2255,11 +2351,13 @@ future<> repair_service::init_ms_handlers() {
     });
     ms.register_repair_row_level_start([this] (const rpc::client_info& cinfo, uint32_t repair_meta_id, sstring ks_name,
             sstring cf_name, dht::token_range range, row_level_diff_detect_algorithm algo, uint64_t max_row_buf_size, uint64_t seed,
-            unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason) {
+            unsigned remote_shard, unsigned remote_shard_count, unsigned remote_ignore_msb, sstring remote_partitioner_name, table_schema_version schema_version, rpc::optional<streaming::stream_reason> reason,
+            rpc::optional<tasks::task_id> incremental_repair_id) {
         auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
         auto from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
         return container().invoke_on(src_cpu_id % smp::count, [from, src_cpu_id, repair_meta_id, ks_name, cf_name,
-                range, algo, max_row_buf_size, seed, remote_shard, remote_shard_count, remote_ignore_msb, schema_version, reason, this] (repair_service& local_repair) mutable {
+                range, algo, max_row_buf_size, seed, remote_shard, remote_shard_count, remote_ignore_msb, schema_version, reason,
+                incremental_repair_id = incremental_repair_id.value_or(tasks::task_id::create_null_id()), this] (repair_service& local_repair) mutable {
             if (!local_repair._sys_dist_ks.local_is_initialized() || !local_repair._view_update_generator.local_is_initialized()) {
                 return make_exception_future<repair_row_level_start_response>(std::runtime_error(format("Node {} is not fully initialized for repair, try again later",
                         utils::fb_utilities::get_broadcast_address())));
@@ -2268,7 +2366,7 @@ future<> repair_service::init_ms_handlers() {
             return repair_meta::repair_row_level_start_handler(local_repair, from, src_cpu_id, repair_meta_id, std::move(ks_name),
                     std::move(cf_name), std::move(range), algo, max_row_buf_size, seed,
                     shard_config{remote_shard, remote_shard_count, remote_ignore_msb},
-                    schema_version, r, _repair_module->abort_source());
+                    schema_version, r, incremental_repair_id, _repair_module->abort_source());
         });
     });
     ms.register_repair_row_level_stop([this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
@@ -2318,6 +2416,7 @@ future<> repair_service::uninit_ms_handlers() {
         ms.unregister_repair_put_row_diff_with_rpc_stream(),
         ms.unregister_repair_get_full_row_hashes_with_rpc_stream(),
         ms.unregister_repair_get_full_row_hashes(),
+        ms.unregister_repair_get_row_hash_sketch(),
         ms.unregister_repair_get_combined_row_hash(),
         ms.unregister_repair_get_sync_boundary(),
         ms.unregister_repair_get_row_diff(),
@@ -2596,8 +2695,18 @@ class row_level_repair {
 
             rlogger.debug("Before master.get_full_row_hashes for node {}, hash_sets={}",
                 node, master.peer_row_hash_sets(node_idx).size());
+            // If the working row bufs mostly agree, a sketch of their
+            // difference is much smaller than the full list of hashes.
+            std::optional<repair_hash_set> peer_hashes;
+            if (master.use_row_hash_sketch()) {
+                ns.state = repair_state::get_row_hash_sketch_started;
+                peer_hashes = master.get_full_row_hashes_with_sketch(node).get0();
+                ns.state = repair_state::get_row_hash_sketch_finished;
+            }
             // Ask the peer to send the full list hashes in the working row buf.
-            if (master.use_rpc_stream()) {
+            if (peer_hashes) {
+                master.peer_row_hash_sets(node_idx) = std::move(*peer_hashes);
+            } else if (master.use_rpc_stream()) {
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_started;
                 master.peer_row_hash_sets(node_idx) = master.get_full_row_hashes_with_rpc_stream(node, node_idx).get0();
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_finished;
@@ -2755,6 +2864,9 @@ class row_level_repair {
 
             auto permit = _shard_task.db.local().obtain_reader_permit(_cf, "repair-meta", db::no_timeout, {}).get0();
 
+            auto incremental_repair_id = _shard_task.incremental ? _shard_task.global_repair_id.uuid() : tasks::task_id::create_null_id();
+            _shard_task.rs.on_incremental_repair_started(incremental_repair_id).get();
+
             repair_meta master(_shard_task.rs,
                     _cf,
                     s,
@@ -2766,6 +2878,7 @@ class row_level_repair {
                     repair_master::yes,
                     repair_meta_id,
                     _shard_task.reason(),
+                    incremental_repair_id,
                     std::move(master_node_shard_config),
                     _all_live_peer_nodes,
                     _all_live_peer_nodes.size(),
@@ -3002,6 +3115,73 @@ future<> repair_service::cleanup_history(tasks::task_id repair_id) {
     });
 }
 
+future<> repair_service::on_incremental_repair_started(tasks::task_id repair_id) {
+    if (!repair_id) {
+        return make_ready_future<>();
+    }
+    return container().invoke_on(0, [repair_id, now = db_clock::now()] (repair_service& rs) {
+        auto [it, inserted] = rs._incremental_repair_starts.try_emplace(repair_id, now);
+        if (!inserted) {
+            it->second = std::min(it->second, now);
+        }
+    });
+}
+
+future<> repair_service::update_incremental_repair_progress(const repair_update_system_table_request& req) {
+    auto start = _incremental_repair_starts.find(req.repair_uuid);
+    if (start == _incremental_repair_starts.end()) {
+        // Not an incremental repair, or this node restarted since it started.
+        co_return;
+    }
+    auto& db = get_db().local();
+    if (!db.column_family_exists(req.table_uuid)) {
+        _incremental_repair_progress.erase(req.table_uuid);
+        co_return;
+    }
+    auto [it, inserted] = _incremental_repair_progress.try_emplace(req.table_uuid);
+    auto& progress = it->second;
+    if (inserted) {
+        auto erm = db.find_keyspace(req.keyspace_name).get_effective_replication_map();
+        if (!erm) {
+            _incremental_repair_progress.erase(it);
+            co_return;
+        }
+        progress.unrepaired = erm->get_ranges(utils::fb_utilities::get_broadcast_address());
+        progress.started_at = start->second;
+    } else {
+        progress.started_at = std::min(progress.started_at, start->second);
+    }
+    dht::token_range_vector unrepaired;
+    for (auto& r : progress.unrepaired) {
+        if (r.overlaps(req.range, dht::token_comparator())) {
+            auto rest = r.subtract(req.range, dht::token_comparator());
+            std::move(rest.begin(), rest.end(), std::back_inserter(unrepaired));
+        } else {
+            unrepaired.push_back(std::move(r));
+        }
+    }
+    progress.unrepaired = std::move(unrepaired);
+    if (!progress.unrepaired.empty()) {
+        co_return;
+    }
+
+    auto written_before = progress.started_at;
+    auto repaired_at = std::max<uint64_t>(1, std::chrono::duration_cast<std::chrono::milliseconds>(req.repair_time.time_since_epoch()).count());
+    _incremental_repair_progress.erase(it);
+    // The repairs which started before and haven't been accounted for yet
+    // failed, or their sstables won't be marked anyway.
+    std::erase_if(_incremental_repair_starts, [written_before] (const auto& e) {
+        return e.second < written_before;
+    });
+    rlogger.info("repair[{}]: All the ranges of {}.{} were repaired, marking the sstables written before {} as repaired",
+            req.repair_uuid, req.keyspace_name, req.table_name, written_before);
+    co_await get_db().invoke_on_all([&req, written_before, repaired_at] (replica::database& db) -> future<> {
+        if (db.column_family_exists(req.table_uuid)) {
+            co_await db.find_column_family(req.table_uuid).mark_sstables_as_repaired(written_before, repaired_at);
+        }
+    });
+}
+
 future<> repair_service::load_history() {
     auto tables = get_db().local().get_column_families();
     for (const auto& x : tables) {
@@ -3056,8 +3236,13 @@ repair_service::insert_repair_meta(
         shard_config master_node_shard_config,
         table_schema_version schema_version,
         streaming::stream_reason reason,
+        tasks::task_id incremental_repair_id,
         abort_source& as) {
-    return get_migration_manager().get_schema_for_write(schema_version, {from, src_cpu_id}, get_messaging(), &as).then([this,
+    return get_migration_manager().get_schema_for_write(schema_version, {from, src_cpu_id}, get_messaging(), &as).then([this, incremental_repair_id] (schema_ptr s) {
+        return on_incremental_repair_started(incremental_repair_id).then([s = std::move(s)] () mutable {
+            return s;
+        });
+    }).then([this,
             from,
             repair_meta_id,
             range,
@@ -3065,7 +3250,8 @@ repair_service::insert_repair_meta(
             max_row_buf_size,
             seed,
             master_node_shard_config,
-            reason] (schema_ptr s) {
+            reason,
+            incremental_repair_id] (schema_ptr s) {
         auto& db = get_db();
         auto& cf = db.local().find_column_family(s->id());
         return db.local().obtain_reader_permit(cf, "repair-meta", db::no_timeout, {}).then([s = std::move(s),
@@ -3078,7 +3264,8 @@ repair_service::insert_repair_meta(
                 max_row_buf_size,
                 seed,
                 master_node_shard_config,
-                reason] (reader_permit permit) mutable {
+                reason,
+                incremental_repair_id] (reader_permit permit) mutable {
         node_repair_meta_id id{from, repair_meta_id};
         auto rm = make_shared<repair_meta>(*this,
                 cf,
@@ -3091,6 +3278,7 @@ repair_service::insert_repair_meta(
                 repair_master::no,
                 repair_meta_id,
                 reason,
+                incremental_repair_id,
                 std::move(master_node_shard_config),
                 inet_address_vector_replica_set{from});
         rm->set_repair_state_for_local_node(repair_state::row_level_start_started);
@@ -99,6 +99,18 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
 
     std::unordered_map<tasks::task_id, repair_history> _finished_ranges_history;
 
+    // Incremental repair, used only on shard 0.
+    //
+    // When the local reads of each incremental repair started, on any shard.
+    std::unordered_map<tasks::task_id, db_clock::time_point> _incremental_repair_starts;
+    struct incremental_repair_progress {
+        // The ranges of this node not repaired yet.
+        dht::token_range_vector unrepaired;
+        // When the reads of the earliest repair of the repaired ranges started.
+        db_clock::time_point started_at;
+    };
+    std::unordered_map<table_id, incremental_repair_progress> _incremental_repair_progress;
+
     shared_ptr<row_level_repair_gossip_helper> _gossip_helper;
     bool _stopped = false;
 
@@ -134,6 +146,10 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
     future<> cleanup_history(tasks::task_id repair_id);
     future<> load_history();
 
+    // To be called before the local reads of the incremental repair
+    // repair_id start, no-op for a null repair_id.
+    future<> on_incremental_repair_started(tasks::task_id repair_id);
+
     future<int> do_repair_start(sstring keyspace, std::unordered_map<sstring, sstring> options_map);
 
     // The tokens are the tokens assigned to the bootstrap node.
@@ -159,6 +175,10 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
             gms::inet_address from,
             repair_update_system_table_request req);
 
+    // Must be called on shard 0. Once all the ranges of this node are repaired
+    // incrementally, marks the sstables written before as repaired.
+    future<> update_incremental_repair_progress(const repair_update_system_table_request& req);
+
     future<repair_flush_hints_batchlog_response> repair_flush_hints_batchlog_handler(
             gms::inet_address from,
             repair_flush_hints_batchlog_request req);
@@ -214,6 +234,7 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
             shard_config master_node_shard_config,
             table_schema_version schema_version,
             streaming::stream_reason reason,
+            tasks::task_id incremental_repair_id,
             abort_source& as);
 
     future<>
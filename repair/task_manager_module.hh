@@ -45,8 +45,9 @@ class user_requested_repair_task_impl : public repair_task_impl {
     std::vector<sstring> _hosts;
     std::vector<sstring> _data_centers;
     std::unordered_set<gms::inet_address> _ignore_nodes;
+    bool _incremental;
 public:
-    user_requested_repair_task_impl(tasks::task_manager::module_ptr module, repair_uniq_id id, std::string keyspace, std::string entity, lw_shared_ptr<locator::global_vnode_effective_replication_map> germs, std::vector<sstring> cfs, dht::token_range_vector ranges, std::vector<sstring> hosts, std::vector<sstring> data_centers, std::unordered_set<gms::inet_address> ignore_nodes) noexcept
+    user_requested_repair_task_impl(tasks::task_manager::module_ptr module, repair_uniq_id id, std::string keyspace, std::string entity, lw_shared_ptr<locator::global_vnode_effective_replication_map> germs, std::vector<sstring> cfs, dht::token_range_vector ranges, std::vector<sstring> hosts, std::vector<sstring> data_centers, std::unordered_set<gms::inet_address> ignore_nodes, bool incremental) noexcept
         : repair_task_impl(module, id.uuid(), id.id, std::move(keyspace), "", std::move(entity), tasks::task_id::create_null_id(), streaming::stream_reason::repair)
         , _germs(germs)
         , _cfs(std::move(cfs))
@@ -54,6 +55,7 @@ class user_requested_repair_task_impl : public repair_task_impl {
         , _hosts(std::move(hosts))
         , _data_centers(std::move(data_centers))
         , _ignore_nodes(std::move(ignore_nodes))
+        , _incremental(incremental)
     {}
 
     virtual tasks::is_abortable is_abortable() const noexcept override {
@@ -119,6 +121,8 @@ class shard_repair_task_impl : public repair_task_impl {
     repair_stats _stats;
     std::unordered_set<sstring> dropped_tables;
     bool _hints_batchlog_flushed = false;
+    // Compare only the unrepaired data, see repair_options::incremental.
+    bool incremental = false;
     std::unordered_set<gms::inet_address> nodes_down;
 private:
     bool _aborted = false;
@@ -136,7 +140,8 @@ class shard_repair_task_impl : public repair_task_impl {
             const std::vector<sstring>& hosts_,
             const std::unordered_set<gms::inet_address>& ignore_nodes_,
             streaming::stream_reason reason_,
-            bool hints_batchlog_flushed);
+            bool hints_batchlog_flushed,
+            bool incremental_);
     virtual tasks::is_internal is_internal() const noexcept override {
         return tasks::is_internal::yes;
     }
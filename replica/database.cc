@@ -29,6 +29,7 @@
 #include <boost/algorithm/string/erase.hpp>
 #include "sstables/sstables.hh"
 #include "sstables/sstables_manager.hh"
+#include "sstables/chunk_cache.hh"
 #include "compaction/compaction.hh"
 #include <boost/range/adaptor/map.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
@@ -317,7 +318,8 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _cfg(cfg)
     // Allow system tables a pool of 10 MB memory to write, but never block on other regions.
     , _system_dirty_memory_manager(*this, 10 << 20, cfg.unspooled_dirty_soft_limit(), default_scheduling_group())
-    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.50, cfg.unspooled_dirty_soft_limit(), dbcfg.statement_scheduling_group)
+    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.50, cfg.unspooled_dirty_soft_limit(), dbcfg.statement_scheduling_group,
+            cfg.unspooled_dirty_predictive_flush)
     , _dbcfg(dbcfg)
     , _flush_sg(dbcfg.memtable_scheduling_group)
     , _memtable_controller(make_flush_controller(_cfg, _flush_sg, [this, limit = float(_dirty_memory_manager.throttle_threshold())] {
@@ -353,6 +355,7 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
             utils::updateable_value(std::numeric_limits<uint32_t>::max()),
             utils::updateable_value(std::numeric_limits<uint32_t>::max()))
     , _row_cache_tracker(cache_tracker::register_metrics::yes)
+    , _counter_cache_tracker((size_t(cfg.counter_cache_size_in_mb()) << 20) / smp::count)
     , _apply_stage("db_apply", &database::do_apply)
     , _version(empty_version)
     , _compaction_manager(cm)
@@ -368,11 +371,13 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _system_sstables_manager(std::make_unique<sstables::sstables_manager>(*_nop_large_data_handler, _cfg, feat, _row_cache_tracker, dbcfg.available_memory, sst_dir_sem.local()))
     , _result_memory_limiter(dbcfg.available_memory / 10)
     , _data_listeners(std::make_unique<db::data_listeners>())
+    , _hot_partitions(std::make_unique<db::hot_partitions_tracker>(*this, cfg.hot_partitions_sampling_ratio))
     , _mnotifier(mn)
     , _feat(feat)
     , _shared_token_metadata(stm)
     , _sst_dir_semaphore(sst_dir_sem)
     , _stop_barrier(std::move(barrier))
+    , _rate_limiter(cfg.per_partition_rate_limit_tracked_partitions())
     , _update_memtable_flush_static_shares_action([this, &cfg] { return _memtable_controller.update_static_shares(cfg.memtable_flush_static_shares()); })
     , _memtable_flush_static_shares_observer(cfg.memtable_flush_static_shares.observe(_update_memtable_flush_static_shares_action.make_observer()))
 {
@@ -382,6 +387,7 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     setup_metrics();
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    sstables::chunk_cache::local().set_capacity((cfg.compressed_chunk_cache_size_in_mb() << 20) / smp::count);
 
     setup_scylla_memory_diagnostics_producer();
     if (_dbcfg.sstables_format) {
@@ -417,10 +423,11 @@ void backlog_controller::adjust() {
         return;
     }
 
+    adjust_latency_scale();
     auto backlog = _current_backlog();
 
     if (backlog >= _control_points.back().input) {
-        update_controller(_control_points.back().output);
+        update_controller(_control_points.back().output * _latency_scale);
         return;
     }
 
@@ -434,7 +441,30 @@ void backlog_controller::adjust() {
     control_point& cp = _control_points[idx];
     control_point& last = _control_points[idx - 1];
     float result = last.output + (backlog - last.input) * (cp.output - last.output)/(cp.input - last.input);
-    update_controller(result);
+    update_controller(result * _latency_scale);
+}
+
+void backlog_controller::adjust_latency_scale() {
+    if (!_latency_probe) {
+        return;
+    }
+    auto now = latency_clock::now();
+    auto& probe = *_latency_probe;
+    // A probe which didn't run yet has been waiting for at least a whole period.
+    auto latency = probe.started_at ? now - *probe.started_at : probe.last_latency;
+    if (latency > probe.target) {
+        _latency_scale = std::max(min_latency_scale, _latency_scale * 0.75f);
+    } else {
+        _latency_scale = std::min(1.0f, _latency_scale + 0.05f);
+    }
+    if (probe.started_at) {
+        return;
+    }
+    probe.started_at = now;
+    (void)with_scheduling_group(probe.group, [probe = _latency_probe] {
+        probe->last_latency = latency_clock::now() - *probe->started_at;
+        probe->started_at.reset();
+    });
 }
 
 float backlog_controller::backlog_of_shares(float shares) const {
@@ -523,9 +553,23 @@ database::setup_metrics() {
                        sm::description("Counts sstables that survived the clustering key filtering. "
                                        "High value indicates that bloom filter is not very efficient and still have to access a lot of sstables to get data.")),
 
+        sm::make_counter("range_scan_clustering_filter_count", _cf_stats.range_scan_clustering_filter_count,
+                       sm::description("Counts range scans which skipped sstables not overlapping the queried clustering ranges.")),
+
+        sm::make_counter("range_scan_clustering_filter_sstables_checked", _cf_stats.range_scan_sstables_checked_by_clustering_filter,
+                       sm::description("Counts sstables checked against the queried clustering ranges by range scans.")),
+
+        sm::make_counter("range_scan_clustering_filter_surviving_sstables", _cf_stats.range_scan_surviving_sstables_after_clustering_filter,
+                       sm::description("Counts sstables that survived the clustering key filtering of range scans. "
+                                       "The difference to range_scan_clustering_filter_sstables_checked is the number of sstables skipped.")),
+
         sm::make_counter("dropped_view_updates", _cf_stats.dropped_view_updates,
                        sm::description("Counts the number of view updates that have been dropped due to cluster overload. ")),
 
+        sm::make_counter("coalesced_view_update_reads", _cf_stats.coalesced_view_update_reads,
+                       sm::description("Counts the writes to tables with views which read the existing base rows together with another write to the same partition, "
+                                       "see view_update_read_coalescing_window_in_us.")),
+
        sm::make_counter("view_building_paused", _cf_stats.view_building_paused,
                       sm::description("Counts the number of times view building process was paused (e.g. due to node unavailability). ")),
 
@@ -563,6 +607,15 @@ database::setup_metrics() {
         sm::make_counter("total_reads_rate_limited", _stats->total_reads_rate_limited,
                        sm::description("Counts read operations which were rejected on the replica side because the per-partition limit was reached.")),
 
+        sm::make_counter("startup_tables_populated", _stats->startup_tables_populated,
+                       sm::description("Counts the tables whose sstables were loaded on this shard during startup.")),
+
+        sm::make_counter("startup_sstables_loaded", _stats->startup_sstables_loaded,
+                       sm::description("Counts the sstables loaded on this shard during startup.")),
+
+        sm::make_gauge("startup_deferred_bloom_filters", _stats->startup_deferred_bloom_filters,
+                       sm::description("Holds the number of sstables loaded at startup whose bloom filter is yet to be loaded, see defer_bloom_filter_loading.")),
+
         sm::make_current_bytes("view_update_backlog", [this] { return get_view_update_backlog().current; },
                        sm::description("Holds the current size in bytes of the pending view updates for all tables")),
 
@@ -572,9 +625,18 @@ database::setup_metrics() {
         sm::make_counter("querier_cache_misses", _querier_cache.get_stats().misses,
                        sm::description("Counts querier cache lookups that failed to find a cached querier")),
 
+        sm::make_counter("querier_cache_misses_after_eviction", _querier_cache.get_stats().misses_after_eviction,
+                       sm::description("Counts querier cache lookups that failed to find a cached querier because it was evicted")),
+
         sm::make_counter("querier_cache_drops", _querier_cache.get_stats().drops,
                        sm::description("Counts querier cache lookups that found a cached querier but had to drop it due to position mismatch")),
 
+        sm::make_counter("querier_cache_drops_schema_mismatch", _querier_cache.get_stats().drops_schema_mismatch,
+                       sm::description("Counts querier cache lookups that found a cached querier but had to drop it because the schema changed")),
+
+        sm::make_counter("querier_cache_drops_position_mismatch", _querier_cache.get_stats().drops_position_mismatch,
+                       sm::description("Counts querier cache lookups that found a cached querier but had to drop it because the page started from another position")),
+
         sm::make_counter("querier_cache_time_based_evictions", _querier_cache.get_stats().time_based_evictions,
                        sm::description("Counts querier cache entries that timed out and were evicted.")),
 
@@ -724,6 +786,21 @@ database::setup_metrics() {
         sm::make_queue_length("counter_cell_lock_pending", _cl_stats->operations_waiting_for_lock,
                              sm::description("The number of counter updates waiting for a lock.")),
 
+        sm::make_total_operations("counter_cache_hits", [this] { return _counter_cache_tracker.get_stats().hits; },
+                                 sm::description("The number of counter updates which found the local shards of their cells in the counter cache, skipping the read before write.")),
+
+        sm::make_total_operations("counter_cache_misses", [this] { return _counter_cache_tracker.get_stats().misses; },
+                                 sm::description("The number of counter updates which had to read the local shards of their cells.")),
+
+        sm::make_total_operations("counter_cache_evictions", [this] { return _counter_cache_tracker.get_stats().evictions; },
+                                 sm::description("The number of partitions evicted from the counter cache to fit its memory.")),
+
+        sm::make_total_operations("counter_cache_invalidations", [this] { return _counter_cache_tracker.get_stats().invalidations; },
+                                 sm::description("The number of partitions removed from the counter cache because of writes which may change their local shards.")),
+
+        sm::make_gauge("counter_cache_bytes", [this] { return _counter_cache_tracker.memory_used(); },
+                       sm::description("The memory used by the counter cache.")),
+
         sm::make_counter("large_partition_exceeding_threshold", [this] { return _large_data_handler->stats().partitions_bigger_than_threshold; },
             sm::description("Number of large partitions exceeding compaction_large_partition_warning_threshold_mb. "
                 "Large partitions have performance impact and should be avoided, check the documentation for details.")),
@@ -1336,7 +1413,9 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.dirty_memory_manager = _config.dirty_memory_manager;
     cfg.streaming_read_concurrency_semaphore = _config.streaming_read_concurrency_semaphore;
     cfg.compaction_concurrency_semaphore = _config.compaction_concurrency_semaphore;
+    cfg.read_concurrency_semaphore = _config.read_concurrency_semaphore;
     cfg.cf_stats = _config.cf_stats;
+    cfg.counter_cache_tracker = _config.counter_cache_tracker;
     cfg.enable_incremental_backups = _config.enable_incremental_backups;
     cfg.compaction_scheduling_group = _config.compaction_scheduling_group;
     cfg.memory_compaction_scheduling_group = _config.memory_compaction_scheduling_group;
@@ -1347,6 +1426,7 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.enable_metrics_reporting = db_config.enable_keyspace_column_family_metrics();
     cfg.reversed_reads_auto_bypass_cache = db_config.reversed_reads_auto_bypass_cache;
     cfg.enable_optimized_reversed_reads = db_config.enable_optimized_reversed_reads;
+    cfg.memtable_flush_parallelism = db_config.memtable_flush_parallelism;
     cfg.tombstone_warn_threshold = db_config.tombstone_warn_threshold();
     cfg.view_update_concurrency_semaphore = _config.view_update_concurrency_semaphore;
     cfg.view_update_concurrency_semaphore_limit = _config.view_update_concurrency_semaphore_limit;
@@ -1568,6 +1648,46 @@ static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
     return ret;
 }
 
+database::abortable_read::abortable_read(database& db, query_id id)
+    : _db(db)
+{
+    if (id) {
+        _it = _db._abortable_reads.emplace(id, this);
+    }
+}
+
+database::abortable_read::~abortable_read() {
+    if (_it) {
+        _db._abortable_reads.erase(*_it);
+    }
+}
+
+void database::abortable_read::set_permit(reader_permit permit) {
+    if (_ex) {
+        std::rethrow_exception(_ex);
+    }
+    _permit = std::move(permit);
+}
+
+void database::abortable_read::abort(std::exception_ptr ex) noexcept {
+    _ex = ex;
+    if (_permit) {
+        _permit->abort(std::move(ex));
+    }
+}
+
+void database::abort_reads(query_id id) noexcept {
+    auto [begin, end] = _abortable_reads.equal_range(id);
+    if (begin == end) {
+        return;
+    }
+    dblog.debug("Aborting reads of query {}", id);
+    auto ex = std::make_exception_ptr(abort_requested_exception());
+    for (auto it = begin; it != end; ++it) {
+        it->second->abort(ex);
+    }
+}
+
 future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
 database::query(schema_ptr s, const query::read_command& cmd, query::result_options opts, const dht::partition_range_vector& ranges,
                 tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout, db::per_partition_rate_limit::info rate_limit_info) {
@@ -1594,7 +1714,10 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
         querier_opt = _querier_cache.lookup_data_querier(cmd.query_uuid, *s, ranges.front(), cmd.slice, trace_state, timeout);
     }
 
+    abortable_read abortable(*this, cmd.query_uuid);
+
     auto read_func = [&, this] (reader_permit permit) {
+        abortable.set_permit(permit);
         reader_permit::need_cpu_guard ncpu_guard{permit};
         permit.set_max_result_size(max_result_size);
         return cf.query(std::move(s), std::move(permit), cmd, opts, ranges, trace_state, get_result_memory_limiter(),
@@ -1633,7 +1756,7 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
         co_return coroutine::exception(std::move(ex));
     }
 
-    auto hit_rate = cf.get_global_cache_hit_rate();
+    auto hit_rate = ranges.size() == 1 ? cf.get_cache_hit_rate_for(ranges.front()) : cf.get_global_cache_hit_rate();
     ++semaphore.get_stats().total_successful_reads;
     _stats->short_data_queries += bool(result->is_short_read());
     co_return std::tuple(std::move(result), hit_rate);
@@ -1661,7 +1784,10 @@ database::query_mutations(schema_ptr s, const query::read_command& cmd, const dh
         querier_opt = _querier_cache.lookup_mutation_querier(cmd.query_uuid, *s, range, cmd.slice, trace_state, timeout);
     }
 
+    abortable_read abortable(*this, cmd.query_uuid);
+
     auto read_func = [&] (reader_permit permit) {
+        abortable.set_permit(permit);
         reader_permit::need_cpu_guard ncpu_guard{permit};
         permit.set_max_result_size(max_result_size);
         return cf.mutation_query(std::move(s), std::move(permit), cmd, range,
@@ -1701,7 +1827,7 @@ database::query_mutations(schema_ptr s, const query::read_command& cmd, const dh
         co_return coroutine::exception(std::move(ex));
     }
 
-    auto hit_rate = cf.get_global_cache_hit_rate();
+    auto hit_rate = cf.get_cache_hit_rate_for(range);
     ++semaphore.get_stats().total_successful_reads;
     _stats->short_mutation_queries += bool(result.is_short_read());
     co_return std::tuple(std::move(result), hit_rate);
@@ -1789,20 +1915,39 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
 
             // Before counter update is applied it needs to be transformed from
             // deltas to counter shards. To do that, we need to read the current
-            // counter state for each modified cell...
-
-            tracing::trace(trace_state, "Reading counter values from the CF");
-            auto permit = get_reader_concurrency_semaphore().make_tracking_only_permit(m_schema.get(), "counter-read-before-write", timeout, trace_state);
-            return counter_write_query(m_schema, cf.as_mutation_source(), std::move(permit), m.decorated_key(), slice, trace_state)
-                    .then([this, &cf, &m, m_schema, timeout, trace_state] (auto mopt) {
+            // counter state for each modified cell, unless the counter cache
+            // has the local shards of all of them...
+            auto local_id = counter_id(_cfg.host_id.uuid());
+            auto cc = cf.get_counter_cache();
+            auto cc_generation = cc ? cc->generation() : 0;
+            future<mutation_opt> current = make_ready_future<mutation_opt>();
+            if (auto cached = cc ? cc->lookup(m, local_id) : std::nullopt) {
+                tracing::trace(trace_state, "Using cached counter values");
+                current = make_ready_future<mutation_opt>(std::move(*cached));
+            } else {
+                tracing::trace(trace_state, "Reading counter values from the CF");
+                auto permit = get_reader_concurrency_semaphore().make_tracking_only_permit(m_schema.get(), "counter-read-before-write", timeout, trace_state);
+                current = counter_write_query(m_schema, cf.as_mutation_source(), std::move(permit), m.decorated_key(), slice, trace_state);
+            }
+            return std::move(current).then([this, &cf, &m, m_schema, timeout, trace_state] (auto mopt) {
                 // ...now, that we got existing state of all affected counter
                 // cells we can look for our shard in each of them, increment
                 // its clock and apply the delta.
                 transform_counter_updates_to_shards(m, mopt ? &*mopt : nullptr, cf.failed_counter_applies_to_memtable(), _cfg.host_id);
                 tracing::trace(trace_state, "Applying counter update");
                 return this->apply_with_commitlog(cf, m, timeout);
-            }).then([&m] {
-                return std::move(m);
+            }).then_wrapped([&m, cc, cc_generation, local_id] (future<> f) {
+                if (cc) {
+                    if (f.failed()) {
+                        // The update may have been applied partially.
+                        cc->invalidate(m.key());
+                    } else {
+                        cc->update(m, local_id, cc_generation);
+                    }
+                }
+                return std::move(f).then([&m] {
+                    return std::move(m);
+                });
             });
         });
     });
@@ -1845,6 +1990,10 @@ future<> database::apply_in_memory(const frozen_mutation& m, schema_ptr m_schema
 
     data_listeners().on_write(m_schema, m);
 
+    if (auto cc = cf.get_counter_cache()) {
+        cc->on_write(m, m_schema, counter_id(_cfg.host_id.uuid()));
+    }
+
     return with_gate(cf.async_gate(), [&m, m_schema = std::move(m_schema), h = std::move(h), &cf, timeout] () mutable -> future<> {
         return cf.apply(m, std::move(m_schema), std::move(h), timeout);
     });
@@ -2160,7 +2309,9 @@ database::make_keyspace_config(const keyspace_metadata& ksm) {
     cfg.dirty_memory_manager = &_dirty_memory_manager;
     cfg.streaming_read_concurrency_semaphore = &_streaming_concurrency_sem;
     cfg.compaction_concurrency_semaphore = &_compaction_concurrency_sem;
+    cfg.read_concurrency_semaphore = &_read_concurrency_sem;
     cfg.cf_stats = &_cf_stats;
+    cfg.counter_cache_tracker = &_counter_cache_tracker;
     cfg.enable_incremental_backups = _enable_incremental_backups;
 
     cfg.compaction_scheduling_group = _dbcfg.compaction_scheduling_group;
@@ -2835,7 +2986,7 @@ template <typename T>
 using foreign_unique_ptr = foreign_ptr<std::unique_ptr<T>>;
 
 flat_mutation_reader_v2 make_multishard_streaming_reader(distributed<replica::database>& db, schema_ptr schema, reader_permit permit,
-        std::function<std::optional<dht::partition_range>()> range_generator) {
+        std::function<std::optional<dht::partition_range>()> range_generator, replica::unrepaired_only only_unrepaired) {
     class streaming_reader_lifecycle_policy
             : public reader_lifecycle_policy_v2
             , public enable_shared_from_this<streaming_reader_lifecycle_policy> {
@@ -2846,9 +2997,11 @@ flat_mutation_reader_v2 make_multishard_streaming_reader(distributed<replica::da
         };
         distributed<replica::database>& _db;
         table_id _table_id;
+        replica::unrepaired_only _only_unrepaired;
         std::vector<reader_context> _contexts;
     public:
-        streaming_reader_lifecycle_policy(distributed<replica::database>& db, table_id table_id) : _db(db), _table_id(table_id), _contexts(smp::count) {
+        streaming_reader_lifecycle_policy(distributed<replica::database>& db, table_id table_id, replica::unrepaired_only only_unrepaired)
+                : _db(db), _table_id(table_id), _only_unrepaired(only_unrepaired), _contexts(smp::count) {
         }
         virtual flat_mutation_reader_v2 create_reader(
                 schema_ptr schema,
@@ -2864,7 +3017,7 @@ flat_mutation_reader_v2 make_multishard_streaming_reader(distributed<replica::da
             _contexts[shard].read_operation = make_foreign(std::make_unique<utils::phased_barrier::operation>(cf.read_in_progress()));
             _contexts[shard].semaphore = &cf.streaming_read_concurrency_semaphore();
 
-            return cf.make_streaming_reader(std::move(schema), std::move(permit), *_contexts[shard].range, slice, fwd_mr);
+            return cf.make_streaming_reader(std::move(schema), std::move(permit), *_contexts[shard].range, slice, fwd_mr, _only_unrepaired);
         }
         virtual const dht::partition_range* get_read_range() const override {
             const auto shard = this_shard_id();
@@ -2897,7 +3050,7 @@ flat_mutation_reader_v2 make_multishard_streaming_reader(distributed<replica::da
     };
     auto& table = db.local().find_column_family(schema);
     auto erm = table.get_effective_replication_map();
-    auto ms = mutation_source([&db, erm] (schema_ptr s,
+    auto ms = mutation_source([&db, erm, only_unrepaired] (schema_ptr s,
             reader_permit permit,
             const dht::partition_range& pr,
             const query::partition_slice& ps,
@@ -2905,7 +3058,7 @@ flat_mutation_reader_v2 make_multishard_streaming_reader(distributed<replica::da
             streamed_mutation::forwarding,
             mutation_reader::forwarding fwd_mr) {
         auto table_id = s->id();
-        return make_multishard_combining_reader_v2(make_shared<streaming_reader_lifecycle_policy>(db, table_id),
+        return make_multishard_combining_reader_v2(make_shared<streaming_reader_lifecycle_policy>(db, table_id, only_unrepaired),
                 std::move(s), erm, std::move(permit), pr, ps, std::move(trace_state), fwd_mr);
     });
     auto&& full_slice = schema->full_slice();
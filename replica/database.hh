@@ -30,6 +30,7 @@
 #include "types/types.hh"
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
 #include "db/commitlog/replay_position.hh"
 #include "db/commitlog/commitlog_types.hh"
 #include <limits>
@@ -38,6 +39,7 @@
 #include "db/snapshot-ctl.hh"
 #include "memtable.hh"
 #include "row_cache.hh"
+#include "counter_cache.hh"
 #include "compaction/compaction_strategy.hh"
 #include "utils/estimated_histogram.hh"
 #include <seastar/core/metrics_registration.hh>
@@ -97,6 +99,9 @@ class sstables_manager;
 class compaction_data;
 class sstable_set;
 class directory_semaphore;
+class compression_chunk_sampler;
+class read_size_histogram;
+struct sstable_writer_config;
 
 }
 
@@ -115,6 +120,7 @@ class config;
 class extensions;
 class rp_handle;
 class data_listeners;
+class hot_partitions_tracker;
 class large_data_handler;
 class system_keyspace;
 class table_selector;
@@ -299,9 +305,17 @@ struct cf_stats {
     // how many sstables survived the clustering key checks
     int64_t surviving_sstables_after_clustering_filter = 0;
 
+    // same as the above, for range scans bypassing the cache
+    int64_t range_scan_clustering_filter_count = 0;
+    int64_t range_scan_sstables_checked_by_clustering_filter = 0;
+    int64_t range_scan_surviving_sstables_after_clustering_filter = 0;
+
     // How many view updates were dropped due to overload.
     int64_t dropped_view_updates = 0;
 
+    // How many writes generating view updates shared the read of the existing base rows with another one.
+    uint64_t coalesced_view_update_reads = 0;
+
     // How many times view building was paused (e.g. due to node unavailability)
     int64_t view_building_paused = 0;
 
@@ -321,9 +335,26 @@ class database_sstable_write_monitor;
 class compaction_group;
 
 using enable_backlog_tracker = bool_class<class enable_backlog_tracker_tag>;
+// Whether a streaming reader skips the repaired sstables, for incremental repair.
+using unrepaired_only = bool_class<class unrepaired_only_tag>;
 
 extern const ssize_t new_reader_base_cost;
 
+// Aggregates of the metadata of the live sstables of a table, maintained as
+// its sstable set changes so they are reported without walking the sstables.
+struct live_sstables_stats {
+    // Of the smallest partition of all sstables, INT64_MAX if there are none.
+    int64_t min_partition_size = INT64_MAX;
+    int64_t max_partition_size = 0;
+    // Of the estimated sizes of all partitions, for their mean.
+    int64_t partition_size_sum = 0;
+    int64_t partitions = 0;
+    utils::estimated_histogram partition_size_histogram{0};
+    uint64_t index_summary_memory_used = 0;
+
+    void add(const sstables::sstable& sst);
+};
+
 struct table_stats {
     /** Number of times flush has resulted in the memtable being switched out. */
     int64_t memtable_switch_count = 0;
@@ -332,6 +363,7 @@ struct table_stats {
     int64_t live_disk_space_used = 0;
     int64_t total_disk_space_used = 0;
     int64_t live_sstable_count = 0;
+    live_sstables_stats live_sstables;
     /** Estimated number of compactions pending for this column family */
     int64_t pending_compactions = 0;
     int64_t memtable_partition_insertions = 0;
@@ -341,6 +373,9 @@ struct table_stats {
     mutation_application_stats memtable_app_stats;
     utils::timed_rate_moving_average_summary_and_histogram reads{256};
     utils::timed_rate_moving_average_summary_and_histogram writes{256};
+    // Same samples as reads and writes, cumulative and with finer buckets
+    utils::precise_time_estimated_histogram precise_reads;
+    utils::precise_time_estimated_histogram precise_writes;
     utils::timed_rate_moving_average_summary_and_histogram cas_prepare{256};
     utils::timed_rate_moving_average_summary_and_histogram cas_accept{256};
     utils::timed_rate_moving_average_summary_and_histogram cas_learn{256};
@@ -368,7 +403,10 @@ class table : public enable_lw_shared_from_this<table>
         replica::dirty_memory_manager* dirty_memory_manager = &default_dirty_memory_manager;
         reader_concurrency_semaphore* streaming_read_concurrency_semaphore;
         reader_concurrency_semaphore* compaction_concurrency_semaphore;
+        // The semaphore user reads are admitted by, only used for metrics.
+        reader_concurrency_semaphore* read_concurrency_semaphore = nullptr;
         replica::cf_stats* cf_stats = nullptr;
+        ::counter_cache_tracker* counter_cache_tracker = nullptr;
         seastar::scheduling_group memtable_scheduling_group;
         seastar::scheduling_group memtable_to_cache_scheduling_group;
         seastar::scheduling_group compaction_scheduling_group;
@@ -383,6 +421,7 @@ class table : public enable_lw_shared_from_this<table>
         // for easy access from `table` member functions:
         utils::updateable_value<bool> reversed_reads_auto_bypass_cache{false};
         utils::updateable_value<bool> enable_optimized_reversed_reads{true};
+        utils::updateable_value<uint32_t> memtable_flush_parallelism{1};
         uint32_t tombstone_warn_threshold{0};
         unsigned x_log2_compaction_groups{0};
     };
@@ -403,6 +442,9 @@ class table : public enable_lw_shared_from_this<table>
     lw_shared_ptr<const storage_options> _storage_opts;
     mutable table_stats _stats;
     mutable db::view::stats _view_stats;
+    // Goes negative by the memory consumed by the view updates of this base
+    // table in flight, which also consume it from view_update_concurrency_semaphore.
+    mutable db::timeout_semaphore _view_update_backlog_sem{0};
     mutable row_locker::stats _row_locker_stats;
 
     uint64_t _failed_counter_applies_to_memtable = 0;
@@ -449,6 +491,7 @@ class table : public enable_lw_shared_from_this<table>
     std::vector<view_ptr> _views;
 
     std::unique_ptr<cell_locker> _counter_cell_locks; // Memory-intensive; allocate only when needed.
+    std::unique_ptr<counter_cache> _counter_cache; // Only for counter tables, when enabled.
 
     // Labels used to identify writes and reads for this table in the rate_limiter structure.
     db::rate_limiter::label _rate_limiter_label_for_writes;
@@ -465,6 +508,9 @@ class table : public enable_lw_shared_from_this<table>
     // may not have information for some node, since it fills
     // in dynamically
     std::unordered_map<gms::inet_address, cache_hit_rate> _cluster_cache_hit_rates;
+    // the same for single-partition reads of each of the row_cache token
+    // ranges, for nodes which sent any
+    std::unordered_map<gms::inet_address, std::array<cache_hit_rate, row_cache::token_range_buckets>> _cluster_token_range_hit_rates;
 
     // Operations like truncate, flush, query, etc, may depend on a column family being alive to
     // complete.  Some of them have their own gate already (like flush), used in specialized wait
@@ -496,6 +542,20 @@ class table : public enable_lw_shared_from_this<table>
     bool _is_bootstrap_or_replace = false;
     sstables::shared_sstable make_sstable(sstring dir);
 
+    // Compression dictionary training, see configure_compression_dictionary().
+    // _dictionary_compressor is trained for _dictionary_base, the schema's
+    // compressor at the time of training; it's ignored if the schema changed.
+    lw_shared_ptr<sstables::compression_chunk_sampler> _compression_sampler;
+    compressor_ptr _dictionary_base;
+    compressor_ptr _dictionary_compressor;
+    bool _training_compression_dictionary = false;
+    future<> train_compression_dictionary(compressor_ptr base, std::vector<sstring> samples);
+    // The sizes of the reads of the sstables, see configure_compression_chunk_length().
+    lw_shared_ptr<sstables::read_size_histogram> _read_sizes;
+    // The chunk length last picked for the table, 0 if none.
+    uint64_t _tuned_chunk_length = 0;
+    void track_read_sizes(sstables::sstable& sst);
+
 public:
     void deregister_metrics();
 
@@ -506,6 +566,15 @@ class table : public enable_lw_shared_from_this<table>
     future<> add_sstables_and_update_cache(const std::vector<sstables::shared_sstable>& ssts);
     future<> move_sstables_from_staging(std::vector<sstables::shared_sstable>);
     sstables::shared_sstable make_sstable();
+    // Makes compaction output use the compression dictionary trained for this
+    // table, if any, and sample its chunks to train the next one.
+    void configure_compression_dictionary(sstables::sstable_writer_config& cfg);
+    // Makes the output use the compression chunk length closest to the
+    // median size of the reads of the table, unless the schema sets one.
+    void configure_compression_chunk_length(sstables::sstable_writer_config& cfg);
+    // Trains a new compression dictionary in the background once enough
+    // chunks were sampled, outside of the reactor, and installs it when done.
+    void maybe_train_compression_dictionary();
     void cache_truncation_record(db_clock::time_point truncated_at) {
         _truncated_at = truncated_at;
     }
@@ -686,13 +755,17 @@ class table : public enable_lw_shared_from_this<table>
     //    reader and a _bounded_ amount of writes which arrive later.
     //  - Does not populate the cache
     // Requires ranges to be sorted and disjoint.
+    // Only sstables matching the predicate are read; it must be live as long
+    // as the reader is used.
     flat_mutation_reader_v2 make_streaming_reader(schema_ptr schema, reader_permit permit,
-            const dht::partition_range_vector& ranges) const;
+            const dht::partition_range_vector& ranges,
+            const sstables::sstable_predicate& = sstables::default_sstable_predicate()) const;
 
     // Single range overload.
     flat_mutation_reader_v2 make_streaming_reader(schema_ptr schema, reader_permit permit, const dht::partition_range& range,
             const query::partition_slice& slice,
-            mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::no) const;
+            mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::no,
+            unrepaired_only only_unrepaired = unrepaired_only::no) const;
 
     flat_mutation_reader_v2 make_streaming_reader(schema_ptr schema, reader_permit permit, const dht::partition_range& range) {
         return make_streaming_reader(schema, std::move(permit), range, schema->full_slice());
@@ -705,6 +778,13 @@ class table : public enable_lw_shared_from_this<table>
     sstables::shared_sstable make_streaming_sstable_for_write(std::optional<sstring> subdir = {});
     sstables::shared_sstable make_streaming_staging_sstable();
 
+    // Marks the sstables written before written_before as repaired at
+    // repaired_at, once repair synchronized all the ranges of this node,
+    // see sstables::sstable::is_repaired().
+    future<> mark_sstables_as_repaired(db_clock::time_point written_before, uint64_t repaired_at);
+    // For sstables received by file-level streaming, which keep the sender's version.
+    sstables::shared_sstable make_streaming_sstable_for_file_stream(sstables::sstable_version_types v);
+
     mutation_source as_mutation_source() const;
     mutation_source as_mutation_source_excluding_staging() const;
 
@@ -753,6 +833,9 @@ class table : public enable_lw_shared_from_this<table>
     }
 
     future<std::vector<locked_cell>> lock_counter_cells(const mutation& m, db::timeout_clock::time_point timeout);
+    counter_cache* get_counter_cache() noexcept {
+        return _counter_cache.get();
+    }
 
     logalloc::occupancy_stats occupancy() const;
 private:
@@ -945,6 +1028,13 @@ class table : public enable_lw_shared_from_this<table>
         return _view_stats;
     }
 
+    // The share of this base table in the view update backlog of the shard,
+    // for writes to it to be throttled by the backlog of their own views
+    // rather than by that of all the views of the node.
+    db::view::update_backlog get_view_update_backlog() const {
+        return {size_t(-_view_update_backlog_sem.available_units()), _config.view_update_concurrency_semaphore_limit};
+    }
+
     replica::cf_stats* cf_stats() {
         return _config.cf_stats;
     }
@@ -969,9 +1059,17 @@ class table : public enable_lw_shared_from_this<table>
         _global_cache_hit_rate = rate;
     }
 
+    // The hit rate reported to coordinators reading the range: the hit rate
+    // of the token range for single-partition reads, the global one for scans
+    cache_temperature get_cache_hit_rate_for(const dht::partition_range& pr) const;
+
     void set_hit_rate(gms::inet_address addr, cache_temperature rate);
+    void set_hit_rate(gms::inet_address addr, const dht::token& t, cache_temperature rate);
     cache_hit_rate get_my_hit_rate() const;
     cache_hit_rate get_hit_rate(const gms::gossiper& g, gms::inet_address addr);
+    // The hit rate of addr for reads of the token range of t, or the table's
+    // hit rate if addr didn't report one for it yet
+    cache_hit_rate get_hit_rate(const gms::gossiper& g, gms::inet_address addr, const dht::token& t);
     void drop_hit_rate(gms::inet_address addr);
 
     void enable_auto_compaction();
@@ -1082,7 +1180,7 @@ class table : public enable_lw_shared_from_this<table>
 
 private:
     future<row_locker::lock_holder> do_push_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, schema_ptr s, mutation m, db::timeout_clock::time_point timeout, mutation_source source,
-            tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, query::partition_slice::option_set custom_opts) const;
+            tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, query::partition_slice::option_set custom_opts, bool coalesce_reads) const;
     std::vector<view_ptr> affected_views(shared_ptr<db::view::view_update_generator> gen, const schema_ptr& base, const mutation& update) const;
     future<> generate_and_propagate_view_updates(shared_ptr<db::view::view_update_generator> gen, const schema_ptr& base,
             reader_permit permit,
@@ -1099,6 +1197,24 @@ class table : public enable_lw_shared_from_this<table>
             const query::clustering_row_ranges& rows,
             db::timeout_clock::time_point timeout) const;
 
+    // A read of the existing base rows of a partition, shared by the writes
+    // to it that generate view updates within view_update_read_coalescing_window_in_us.
+    struct coalesced_view_update_read {
+        schema_ptr base;
+        dht::decorated_key key;
+        query::clustering_row_ranges ranges;
+        bool need_regular;
+        bool need_static;
+        shared_promise<mutation_opt> result;
+    };
+    mutable std::unordered_multimap<dht::token, lw_shared_ptr<coalesced_view_update_read>> _coalesced_view_update_reads;
+    // Reads the existing base rows of \p slice for a write holding their
+    // lock, sharing the read with the other writes to the partition that
+    // start within \p window.
+    future<flat_mutation_reader_v2> make_coalesced_view_update_reader(const schema_ptr& base, const dht::decorated_key& dk,
+            const query::partition_slice& slice, bool need_regular, bool need_static, reader_permit permit,
+            tracing::trace_state_ptr tr_state, std::chrono::microseconds window) const;
+
     // One does not need to wait on this future if all we are interested in, is
     // initiating the write.  The writes initiated here will eventually
     // complete, and the seastar::gate below will make sure they are all
@@ -1172,7 +1288,10 @@ class keyspace {
         replica::dirty_memory_manager* dirty_memory_manager = &default_dirty_memory_manager;
         reader_concurrency_semaphore* streaming_read_concurrency_semaphore;
         reader_concurrency_semaphore* compaction_concurrency_semaphore;
+        // The semaphore user reads are admitted by, only used for metrics.
+        reader_concurrency_semaphore* read_concurrency_semaphore = nullptr;
         replica::cf_stats* cf_stats = nullptr;
+        ::counter_cache_tracker* counter_cache_tracker = nullptr;
         seastar::scheduling_group memtable_scheduling_group;
         seastar::scheduling_group memtable_to_cache_scheduling_group;
         seastar::scheduling_group compaction_scheduling_group;
@@ -1251,6 +1370,7 @@ struct database_config {
     seastar::scheduling_group streaming_scheduling_group;
     seastar::scheduling_group gossip_scheduling_group;
     seastar::scheduling_group commitlog_scheduling_group;
+    seastar::scheduling_group view_building_scheduling_group;
     size_t available_memory;
     std::optional<sstables::sstable_version_types> sstables_format;
 };
@@ -1316,6 +1436,11 @@ class database : public peering_sharded_service<database> {
         uint64_t multishard_query_unpopped_bytes = 0;
         uint64_t multishard_query_failed_reader_stops = 0;
         uint64_t multishard_query_failed_reader_saves = 0;
+
+        // Startup progress, see distributed_loader
+        uint64_t startup_tables_populated = 0;
+        uint64_t startup_sstables_loaded = 0;
+        uint64_t startup_deferred_bloom_filters = 0;
     };
 
     lw_shared_ptr<db_stats> _stats;
@@ -1340,6 +1465,7 @@ class database : public peering_sharded_service<database> {
     db::timeout_semaphore _view_update_concurrency_sem{max_memory_pending_view_updates()};
 
     cache_tracker _row_cache_tracker;
+    counter_cache_tracker _counter_cache_tracker;
     seastar::shared_ptr<db::view::view_update_generator> _view_update_generator;
 
     inheriting_concrete_execution_stage<
@@ -1370,6 +1496,11 @@ class database : public peering_sharded_service<database> {
     bool _uses_schema_commitlog = false;
     query::querier_cache _querier_cache;
 
+public:
+    class abortable_read;
+private:
+    std::unordered_multimap<query_id, abortable_read*> _abortable_reads;
+
     std::unique_ptr<db::large_data_handler> _large_data_handler;
     std::unique_ptr<db::large_data_handler> _nop_large_data_handler;
 
@@ -1380,6 +1511,7 @@ class database : public peering_sharded_service<database> {
 
     friend db::data_listeners;
     std::unique_ptr<db::data_listeners> _data_listeners;
+    std::unique_ptr<db::hot_partitions_tracker> _hot_partitions;
 
     service::migration_notifier& _mnotifier;
     gms::feature_service& _feat;
@@ -1497,6 +1629,7 @@ class database : public peering_sharded_service<database> {
 
     seastar::scheduling_group get_statement_scheduling_group() const { return _dbcfg.statement_scheduling_group; }
     seastar::scheduling_group get_streaming_scheduling_group() const { return _dbcfg.streaming_scheduling_group; }
+    seastar::scheduling_group get_view_building_scheduling_group() const { return _dbcfg.view_building_scheduling_group; }
 
     compaction_manager& get_compaction_manager() {
         return _compaction_manager;
@@ -1585,6 +1718,27 @@ class database : public peering_sharded_service<database> {
             db::per_partition_rate_limit::account_and_enforce account_and_enforce_info,
             db::operation_type op_type);
 
+    // Registers a read under its query id, so that abort_reads() can find it.
+    // Reads without a query id (unpaged reads) are not registered.
+    class abortable_read {
+        database& _db;
+        std::optional<std::unordered_multimap<query_id, abortable_read*>::iterator> _it;
+        reader_permit_opt _permit;
+        std::exception_ptr _ex;
+    public:
+        abortable_read(database& db, query_id id);
+        abortable_read(abortable_read&&) = delete;
+        ~abortable_read();
+        // Attach the permit of the read, once it is known.
+        // Throws if the read was already aborted.
+        void set_permit(reader_permit permit);
+        void abort(std::exception_ptr ex) noexcept;
+    };
+
+    // Aborts all reads running on this shard under the given query id,
+    // see abortable_read. Used when the coordinator gave up on the read.
+    void abort_reads(query_id id) noexcept;
+
     future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>> query(schema_ptr, const query::read_command& cmd, query::result_options opts,
                                                                   const dht::partition_range_vector& ranges, tracing::trace_state_ptr trace_state,
                                                                   db::timeout_clock::time_point timeout, db::per_partition_rate_limit::info rate_limit_info = std::monostate{});
@@ -1733,6 +1887,10 @@ class database : public peering_sharded_service<database> {
         return *_data_listeners;
     }
 
+    db::hot_partitions_tracker* hot_partitions() const {
+        return _hot_partitions.get();
+    }
+
     // Get the maximum result size for an unlimited query, appropriate for the
     // query class, which is deduced from the current scheduling group.
     query::max_result_size get_unlimited_query_max_result_size() const;
@@ -1765,6 +1923,7 @@ future<> start_large_data_handler(sharded<replica::database>& db);
 // Shard readers are created via `table::make_streaming_reader()`.
 // Range generator must generate disjoint, monotonically increasing ranges.
 flat_mutation_reader_v2 make_multishard_streaming_reader(distributed<replica::database>& db, schema_ptr schema, reader_permit permit,
-        std::function<std::optional<dht::partition_range>()> range_generator);
+        std::function<std::optional<dht::partition_range>()> range_generator,
+        replica::unrepaired_only only_unrepaired = replica::unrepaired_only::no);
 
 bool is_internal_keyspace(std::string_view name);
@@ -169,6 +169,9 @@ void region_group::update_unspooled(ssize_t delta) {
     bool relief = false;
 
     _unspooled_total_memory += delta;
+    if (delta > 0) {
+        _unspooled_bytes_added += delta;
+    }
 
     if (_unspooled_total_memory > unspooled_soft_limit_threshold()) {
         notify_unspooled_soft_pressure();
@@ -207,7 +210,29 @@ future<flush_permit> flush_permit::reacquire_sstable_write_permit() && {
     return _manager->get_flush_permit(std::move(_background_permit));
 }
 
-dirty_memory_manager::dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg)
+void flush_predictor::update(uint64_t written, uint64_t spooled, std::chrono::duration<double> elapsed) noexcept {
+    auto written_delta = written - std::exchange(_written, written);
+    auto spooled_delta = spooled - std::exchange(_spooled, spooled);
+    if (elapsed.count() <= 0) {
+        return;
+    }
+    _write_rate += smoothing * (written_delta / elapsed.count() - _write_rate);
+    // Flushes don't run all the time, only average the periods they made progress in
+    if (spooled_delta) {
+        _flush_rate += smoothing * (spooled_delta / elapsed.count() - _flush_rate);
+    }
+}
+
+bool flush_predictor::predicts_pressure(size_t unspooled, size_t limit, size_t flush_size) const noexcept {
+    if (unspooled < limit / 2 || _flush_rate <= 0) {
+        return false;
+    }
+    auto flush_time = std::min(flush_size / _flush_rate, double(max_lookahead.count()));
+    return unspooled + _write_rate * flush_time >= limit;
+}
+
+dirty_memory_manager::dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg,
+        utils::updateable_value<bool> predictive_flush)
     : _db(&db)
     , _region_group("memtable (unspooled)", dirty_memory_manager_logalloc::reclaim_config{
             .unspooled_hard_limit = threshold / 2,
@@ -216,7 +241,29 @@ dirty_memory_manager::dirty_memory_manager(replica::database& db, size_t thresho
             .start_reclaiming = std::bind_front(&dirty_memory_manager::start_reclaiming, this)
       }, deferred_work_sg)
     , _flush_serializer(1)
-    , _waiting_flush(flush_when_needed()) {}
+    , _predictive_flush(std::move(predictive_flush))
+    , _predictor_timer([this] { sample_flush_rates(); })
+    , _last_sample(lowres_clock::now())
+    , _waiting_flush(flush_when_needed())
+{
+    _predictor_timer.arm_periodic(predictor_sample_period);
+}
+
+void dirty_memory_manager::sample_flush_rates() noexcept {
+    auto now = lowres_clock::now();
+    _predictor.update(_region_group.unspooled_bytes_added(), _bytes_spooled, now - _last_sample);
+    _last_sample = now;
+
+    auto was_predicted = std::exchange(_predicted_pressure, false);
+    if (_predictive_flush() && !_region_group.over_unspooled_soft_limit()) {
+        auto* candidate = _region_group.get_largest_region();
+        _predicted_pressure = candidate && _predictor.predicts_pressure(unspooled_dirty_memory(),
+                _region_group.unspooled_soft_limit_threshold(), candidate->evictable_occupancy().total_space());
+    }
+    if (_predicted_pressure && !was_predicted) {
+        _should_flush.signal();
+    }
+}
 
 void
 dirty_memory_manager::setup_collectd(sstring namestr) {
@@ -230,11 +277,21 @@ dirty_memory_manager::setup_collectd(sstring namestr) {
 
         sm::make_gauge(namestr +"_unspooled_dirty_bytes", [this] { return unspooled_dirty_memory(); },
                        sm::description("Holds the size of used memory in bytes. Compare it to \"dirty_bytes\" to see how many memory is wasted (neither used nor available).")),
+
+        sm::make_gauge(namestr + "_dirty_write_rate", [this] { return _predictor.write_rate(); },
+                       sm::description("Holds the estimated rate, in bytes per second, at which writes grow the unspooled dirty memory.")),
+
+        sm::make_gauge(namestr + "_dirty_flush_rate", [this] { return _predictor.flush_rate(); },
+                       sm::description("Holds the estimated rate, in bytes per second, at which memtable flushes spool the dirty memory.")),
+
+        sm::make_counter(namestr + "_predictive_flushes", [this] { return _predictive_flushes; },
+                       sm::description("Counts memtable flushes started below the soft limit of unspooled dirty memory, because it was predicted to be crossed before the flush would complete.")),
     });
 }
 
 future<> dirty_memory_manager::shutdown() {
     _db_shutdown_requested = true;
+    _predictor_timer.cancel();
     _should_flush.signal();
     return std::move(_waiting_flush).then([this] {
         return _region_group.shutdown();
@@ -285,6 +342,10 @@ future<> dirty_memory_manager::flush_when_needed() {
                     return sleep(1ms);
                 }
 
+                if (!_region_group.over_unspooled_soft_limit()) {
+                    ++_predictive_flushes;
+                }
+
                 // Do not wait. The semaphore will protect us against a concurrent flush. But we
                 // want to start a new one as soon as the permits are destroyed and the semaphore is
                 // made ready again, not when we are done with the current one.
@@ -14,8 +14,11 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
 #include "replica/database_fwd.hh"
 #include "utils/logalloc.hh"
+#include "utils/updateable_value.hh"
 
 class test_region_group;
 
@@ -169,6 +172,8 @@ class region_group : public logalloc::region_listener {
     uint64_t _blocked_requests_counter = 0;
 
     size_t _unspooled_total_memory = 0;
+    // Total unspooled memory ever added, i.e. the growth of the memtables from writes
+    uint64_t _unspooled_bytes_added = 0;
 
     region_heap _regions;
 
@@ -227,10 +232,11 @@ class region_group : public logalloc::region_listener {
     size_t unspooled_throttle_threshold() const noexcept {
         return _cfg.unspooled_hard_limit;
     }
-private:
+
     size_t unspooled_soft_limit_threshold() const noexcept {
         return _cfg.unspooled_soft_limit;
     }
+private:
 
     bool reclaimer_can_block() const;
     future<> start_releaser(scheduling_group deferered_work_sg);
@@ -265,6 +271,9 @@ class region_group : public logalloc::region_listener {
     size_t unspooled_memory_used() const noexcept {
         return _unspooled_total_memory;
     }
+    uint64_t unspooled_bytes_added() const noexcept {
+        return _unspooled_bytes_added;
+    }
     void update_unspooled(ssize_t delta);
 
     // It would be easier to call update, but it is unfortunately broken in boost versions up to at
@@ -386,6 +395,36 @@ class flush_permit {
     future<flush_permit> reacquire_sstable_write_permit() &&;
 };
 
+// Estimates how fast writes grow unspooled dirty memory and how fast flushes spool it,
+// so that a flush can be started before the soft limit is crossed when it is
+// foreseeable that it will be crossed before a flush started then completes.
+class flush_predictor {
+    double _write_rate = 0;
+    double _flush_rate = 0;
+    uint64_t _written = 0;
+    uint64_t _spooled = 0;
+public:
+    // Weight of the latest sample in the moving averages of the rates
+    static constexpr double smoothing = 0.25;
+    // Never look further ahead than that, even if flushes are very slow
+    static constexpr std::chrono::seconds max_lookahead{10};
+
+    // Feeds the total amounts of memory written to and spooled from memtables so far,
+    // sampled `elapsed` after the previous call.
+    void update(uint64_t written, uint64_t spooled, std::chrono::duration<double> elapsed) noexcept;
+
+    // In bytes per second
+    double write_rate() const noexcept { return _write_rate; }
+    // In bytes per second, measured while flushes were making progress
+    double flush_rate() const noexcept { return _flush_rate; }
+
+    // Returns true if, at the current rates, writes would take the unspooled memory
+    // past the limit by the time a flush of flush_size bytes started now completes.
+    // Nothing is predicted before memory gets within half of the limit, so that
+    // tiny memtables are not flushed, nor before any flush was observed.
+    bool predicts_pressure(size_t unspooled, size_t limit, size_t flush_size) const noexcept;
+};
+
 class dirty_memory_manager {
     // We need a separate boolean, because from the LSA point of view, pressure may still be
     // mounting, in which case the pressure flag could be set back on if we force it off.
@@ -413,13 +452,25 @@ class dirty_memory_manager {
     condition_variable _should_flush;
     int64_t _dirty_bytes_released_pre_accounted = 0;
 
+    // Starting flushes ahead of the soft limit, see flush_predictor
+    static constexpr std::chrono::milliseconds predictor_sample_period{100};
+    utils::updateable_value<bool> _predictive_flush;
+    flush_predictor _predictor;
+    timer<lowres_clock> _predictor_timer;
+    lowres_clock::time_point _last_sample;
+    uint64_t _bytes_spooled = 0;
+    bool _predicted_pressure = false;
+    uint64_t _predictive_flushes = 0;
+
+    void sample_flush_rates() noexcept;
+
     future<> flush_when_needed();
 
     future<> _waiting_flush;
     void start_reclaiming() noexcept;
 
     bool has_pressure() const noexcept {
-        return _region_group.over_unspooled_soft_limit();
+        return _region_group.over_unspooled_soft_limit() || _predicted_pressure;
     }
 
     unsigned _extraneous_flushes = 0;
@@ -462,7 +513,12 @@ class dirty_memory_manager {
     //
     // We then set the soft limit to 80 % of the unspooled dirty hard limit, which is equal to 40 % of
     // the user-supplied threshold.
-    dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg);
+    //
+    // With predictive_flush, flushes are also started below the soft limit when the
+    // write and flush rates measured so far tell it will be crossed before a flush
+    // of the largest memtable completes.
+    dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg,
+            utils::updateable_value<bool> predictive_flush = utils::updateable_value<bool>(false));
     dirty_memory_manager()
         : _db(nullptr)
         , _region_group("memtable (unspooled)",
@@ -494,6 +550,7 @@ class dirty_memory_manager {
         _region_group.update_real(delta);
         _region_group.update_unspooled(-delta);
         _dirty_bytes_released_pre_accounted += delta;
+        _bytes_spooled += delta;
     }
 
     void pin_real_dirty_memory(int64_t delta) {
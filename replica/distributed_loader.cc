@@ -8,6 +8,7 @@
 
 #include <iterator>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
@@ -342,6 +343,10 @@ class table_populator {
         co_await populate_subdir(sstables::staging_dir, allow_offstrategy_compaction::no);
         co_await populate_subdir(sstables::quarantine_dir, allow_offstrategy_compaction::no, must_exist::no);
         co_await populate_subdir("", allow_offstrategy_compaction::yes);
+
+        co_await smp::invoke_on_all([this] {
+            _db.local().get_stats().startup_tables_populated++;
+        });
     }
 
     future<> stop() {
@@ -392,6 +397,7 @@ future<> table_populator::start_subdir(sstring subdir) {
         .enable_dangerous_direct_import_of_cassandra_counters = db.local().get_config().enable_dangerous_direct_import_of_cassandra_counters(),
         .allow_loading_materialized_view = true,
         .garbage_collect = true,
+        .sstable_open_config = { .load_bloom_filter = !db.local().get_config().defer_bloom_filter_loading() },
     };
     co_await distributed_loader::process_sstable_dir(directory, flags);
 
@@ -408,6 +414,19 @@ future<> table_populator::start_subdir(sstring subdir) {
     _highest_generation = std::max(generation, _highest_generation);
 }
 
+// Runs in the background, under the table's async gate, once the sstables are in the table
+static future<> load_deferred_bloom_filters(replica::database& db, std::vector<sstables::shared_sstable> ssts) {
+    auto& stats = db.get_stats();
+    co_await max_concurrent_for_each(ssts, db.get_config().initial_sstable_loading_concurrency(), [&stats] (const sstables::shared_sstable& sst) -> future<> {
+        try {
+            co_await sst->load_deferred_filter();
+        } catch (...) {
+            dblog.warn("Failed to load the bloom filter of {}, reads will keep opening it: {}", sst->get_filename(), std::current_exception());
+        }
+        stats.startup_deferred_bloom_filters--;
+    });
+}
+
 sstables::shared_sstable make_sstable(replica::table& table, fs::path dir, sstables::generation_type generation, sstables::sstable_version_types v) {
     return table.get_sstables_manager().make_sstable(table.schema(), table.get_storage_options(), dir.native(), generation, v, sstables::sstable_format_types::big);
 }
@@ -451,13 +470,26 @@ future<> table_populator::populate_subdir(sstring subdir, allow_offstrategy_comp
     }, eligible_for_reshape_on_boot);
 
     co_await directory.invoke_on_all([this, &eligible_for_reshape_on_boot, do_allow_offstrategy_compaction] (sstables::sstable_directory& dir) -> future<> {
-        co_await dir.do_for_each_sstable([this, &eligible_for_reshape_on_boot, do_allow_offstrategy_compaction] (sstables::shared_sstable sst) {
+        auto& db = _db.local();
+        std::vector<sstables::shared_sstable> deferred_filters;
+        co_await dir.do_for_each_sstable([this, &db, &deferred_filters, &eligible_for_reshape_on_boot, do_allow_offstrategy_compaction] (sstables::shared_sstable sst) {
             auto requires_offstrategy = sstables::offstrategy(do_allow_offstrategy_compaction && !eligible_for_reshape_on_boot(sst));
+            db.get_stats().startup_sstables_loaded++;
+            if (sst->has_deferred_filter()) {
+                deferred_filters.push_back(sst);
+            }
             return _global_table->add_sstable_and_update_cache(sst, requires_offstrategy);
         });
         if (do_allow_offstrategy_compaction) {
             _global_table->trigger_offstrategy_compaction();
         }
+        if (!deferred_filters.empty()) {
+            db.get_stats().startup_deferred_bloom_filters += deferred_filters.size();
+            // Reads are correct meanwhile, the always-present filter only costs them opening these sstables
+            (void)with_gate(_global_table->async_gate(), [&db, ssts = std::move(deferred_filters)] () mutable {
+                return load_deferred_bloom_filters(db, std::move(ssts));
+            });
+        }
     });
 }
 
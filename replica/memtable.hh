@@ -261,7 +261,8 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
         return make_flat_reader(s, std::move(permit), range, full_slice);
     }
 
-    flat_mutation_reader_v2 make_flush_reader(schema_ptr, reader_permit permit);
+    // The range, when given, must be kept alive by the caller until the reader is closed.
+    flat_mutation_reader_v2 make_flush_reader(schema_ptr, reader_permit permit, const dht::partition_range& range = query::full_partition_range);
 
     mutation_source as_data_source();
 
@@ -8,6 +8,7 @@
 
 #include <seastar/core/seastar.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/coroutine/exception.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
@@ -54,6 +55,7 @@
 #include "utils/error_injection.hh"
 #include "readers/reversing_v2.hh"
 #include "readers/from_mutations_v2.hh"
+#include "clustering_interval_set.hh"
 #include "readers/empty_v2.hh"
 #include "readers/multi_range.hh"
 #include "readers/combined.hh"
@@ -212,6 +214,20 @@ table::add_memtables_to_reader_list(std::vector<flat_mutation_reader_v2>& reader
     }
 }
 
+// Range scans which don't populate the cache can skip the sstables holding none
+// of the queried rows, under the conditions filter_sstable_for_reader_by_ck()
+// applies to single partition reads. Reversed slices are left alone, as their
+// ranges are in the order of the reversed schema.
+static bool use_clustering_filter_for_scan(const table& t, const schema& s, const dht::partition_range& range,
+        const query::partition_slice& slice, bool reversed) {
+    if (range.is_singular() || reversed || !s.clustering_key_size() || slice.static_columns.size() || slice.get_specific_ranges()
+            || !t.get_compaction_strategy().use_clustering_key_filter()) {
+        return false;
+    }
+    auto& ranges = slice.default_row_ranges();
+    return !(ranges.size() == 1 && ranges[0].is_full());
+}
+
 flat_mutation_reader_v2
 table::make_reader_v2(schema_ptr s,
                            reader_permit permit,
@@ -265,6 +281,9 @@ table::make_reader_v2(schema_ptr s,
         if (auto reader_opt = _cache.make_reader_opt(s, permit, range, slice, &_compaction_manager.get_tombstone_gc_state(), std::move(trace_state), fwd, fwd_mr)) {
             readers.emplace_back(std::move(*reader_opt));
         }
+    } else if (use_clustering_filter_for_scan(*this, *s, range, slice, reversed)) {
+        readers.emplace_back(_sstables->make_local_shard_sstable_reader(s, permit, range, slice, std::move(trace_state), fwd, fwd_mr,
+                default_read_monitor_generator(), sstables::default_sstable_predicate(), _config.cf_stats));
     } else {
         readers.emplace_back(make_sstable_reader(s, permit, _sstables, range, slice, std::move(trace_state), fwd, fwd_mr));
     }
@@ -296,18 +315,33 @@ sstables::shared_sstable table::make_streaming_staging_sstable() {
     return make_streaming_sstable_for_write(sstables::staging_dir);
 }
 
+sstables::shared_sstable table::make_streaming_sstable_for_file_stream(sstables::sstable_version_types v) {
+    auto& sstm = get_sstables_manager();
+    return sstm.make_sstable(_schema, *_storage_opts, _config.datadir, calculate_generation_for_new_table(), v, sstables::sstable::format_types::big);
+}
+
+future<> table::mark_sstables_as_repaired(db_clock::time_point written_before, uint64_t repaired_at) {
+    for (const compaction_group_ptr& cg : compaction_groups()) {
+        co_await _compaction_manager.mark_sstables_as_repaired(cg->as_table_state(), [written_before] (const sstables::sstable& sst) {
+            // The write time has a resolution of a second.
+            return !sst.is_repaired() && sst.data_file_write_time() + std::chrono::seconds(1) <= written_before;
+        }, repaired_at);
+    }
+}
+
 flat_mutation_reader_v2
 table::make_streaming_reader(schema_ptr s, reader_permit permit,
-                           const dht::partition_range_vector& ranges) const {
+                           const dht::partition_range_vector& ranges,
+                           const sstables::sstable_predicate& predicate) const {
     auto& slice = s->full_slice();
 
-    auto source = mutation_source([this] (schema_ptr s, reader_permit permit, const dht::partition_range& range, const query::partition_slice& slice,
+    auto source = mutation_source([this, &predicate] (schema_ptr s, reader_permit permit, const dht::partition_range& range, const query::partition_slice& slice,
                                       tracing::trace_state_ptr trace_state, streamed_mutation::forwarding fwd, mutation_reader::forwarding fwd_mr) {
         std::vector<flat_mutation_reader_v2> readers;
         add_memtables_to_reader_list(readers, s, permit, range, slice, trace_state, fwd, fwd_mr, [&] (size_t memtable_count) {
             readers.reserve(memtable_count + 1);
         });
-        readers.emplace_back(make_sstable_reader(s, permit, _sstables, range, slice, std::move(trace_state), fwd, fwd_mr));
+        readers.emplace_back(make_sstable_reader(s, permit, _sstables, range, slice, std::move(trace_state), fwd, fwd_mr, predicate));
         return make_combined_reader(s, std::move(permit), std::move(readers), fwd, fwd_mr);
     });
 
@@ -315,15 +349,20 @@ table::make_streaming_reader(schema_ptr s, reader_permit permit,
 }
 
 flat_mutation_reader_v2 table::make_streaming_reader(schema_ptr schema, reader_permit permit, const dht::partition_range& range,
-        const query::partition_slice& slice, mutation_reader::forwarding fwd_mr) const {
+        const query::partition_slice& slice, mutation_reader::forwarding fwd_mr, unrepaired_only only_unrepaired) const {
     auto trace_state = tracing::trace_state_ptr();
     const auto fwd = streamed_mutation::forwarding::no;
+    // Memtables are never repaired, they are always read.
+    static const sstables::sstable_predicate is_unrepaired = [] (const sstables::sstable& sst) {
+        return !sst.is_repaired();
+    };
 
     std::vector<flat_mutation_reader_v2> readers;
     add_memtables_to_reader_list(readers, schema, permit, range, slice, trace_state, fwd, fwd_mr, [&] (size_t memtable_count) {
         readers.reserve(memtable_count + 1);
     });
-    readers.emplace_back(make_sstable_reader(schema, permit, _sstables, range, slice, std::move(trace_state), fwd, fwd_mr));
+    readers.emplace_back(make_sstable_reader(schema, permit, _sstables, range, slice, std::move(trace_state), fwd, fwd_mr,
+            only_unrepaired ? is_unrepaired : sstables::default_sstable_predicate()));
     return make_combined_reader(std::move(schema), std::move(permit), std::move(readers), fwd, fwd_mr);
 }
 
@@ -409,13 +448,111 @@ static bool belongs_to_other_shard(const std::vector<shard_id>& shards) {
 
 sstables::shared_sstable table::make_sstable(sstring dir) {
     auto& sstm = get_sstables_manager();
-    return sstm.make_sstable(_schema, *_storage_opts, dir, calculate_generation_for_new_table(), sstm.get_highest_supported_format(), sstables::sstable::format_types::big);
+    auto sst = sstm.make_sstable(_schema, *_storage_opts, dir, calculate_generation_for_new_table(), sstm.get_highest_supported_format(), sstables::sstable::format_types::big);
+    track_read_sizes(*sst);
+    return sst;
 }
 
 sstables::shared_sstable table::make_sstable() {
     return make_sstable(_config.datadir);
 }
 
+// Samples collected before training a compression dictionary. Training
+// takes time proportional to the sample size, and runs on an alien thread.
+static constexpr size_t compression_dictionary_sample_bytes = 1024 * 1024;
+static constexpr unsigned compression_dictionary_sample_period = 16;
+
+void table::configure_compression_dictionary(sstables::sstable_writer_config& cfg) {
+    auto base = _schema->get_compressor_params().get_compressor();
+    if (!cfg.compression_dictionary || !_sstables_manager.config().enable_sstable_compression_dictionary_training()
+            || !base || !base->supports_dictionary()) {
+        return;
+    }
+    if (_dictionary_compressor && _dictionary_base == base) {
+        cfg.compressor = _dictionary_compressor;
+    }
+    if (!_compression_sampler) {
+        _compression_sampler = make_lw_shared<sstables::compression_chunk_sampler>(
+                compression_dictionary_sample_bytes, compression_dictionary_sample_period);
+    }
+    cfg.compression_sampler = _compression_sampler;
+}
+
+void table::track_read_sizes(sstables::sstable& sst) {
+    if (!_read_sizes) {
+        _read_sizes = make_lw_shared<sstables::read_size_histogram>();
+    }
+    sst.set_read_size_histogram(_read_sizes);
+}
+
+// Reads observed before the chunk length is tuned for them.
+static constexpr uint64_t compression_chunk_length_min_reads = 100;
+
+void table::configure_compression_chunk_length(sstables::sstable_writer_config& cfg) {
+    auto& db_cfg = _sstables_manager.config();
+    const auto& params = _schema->get_compressor_params();
+    if (!db_cfg.enable_sstable_compression_chunk_length_tuning() || !params.get_compressor() || params.has_chunk_length()) {
+        _tuned_chunk_length = 0;
+        return;
+    }
+    if (!_read_sizes || _read_sizes->reads() < compression_chunk_length_min_reads) {
+        return;
+    }
+    uint64_t min = std::max(db_cfg.sstable_compression_chunk_length_min_in_kb(), 1u) * 1024;
+    uint64_t max = std::max(db_cfg.sstable_compression_chunk_length_max_in_kb() * uint64_t(1024), min);
+    // The bounds are rounded down to powers of two, as chunk lengths must be.
+    min = uint64_t(1) << log2floor(min);
+    max = uint64_t(1) << log2floor(max);
+    auto chunk_length = std::clamp(_read_sizes->median(), min, max);
+    if (chunk_length != _tuned_chunk_length) {
+        tlogger.debug("{}.{}: tuned compression chunk length to {} bytes for {} reads", _schema->ks_name(), _schema->cf_name(),
+                chunk_length, _read_sizes->reads());
+        _tuned_chunk_length = chunk_length;
+    }
+    cfg.compression_chunk_length = chunk_length;
+}
+
+void table::maybe_train_compression_dictionary() {
+    if (!_compression_sampler || !_compression_sampler->full() || _training_compression_dictionary || _async_gate.is_closed()) {
+        return;
+    }
+    auto base = _schema->get_compressor_params().get_compressor();
+    if (!base || !base->supports_dictionary()) {
+        _compression_sampler->reset();
+        return;
+    }
+    // The sampler starts over while the dictionary is trained, so new
+    // chunks are sampled for the next one.
+    auto samples = _compression_sampler->release_samples();
+    _training_compression_dictionary = true;
+    // Run in background, so compaction doesn't wait for the training.
+    (void)with_gate(_async_gate, [this, base = std::move(base), samples = std::move(samples)] () mutable {
+        return train_compression_dictionary(std::move(base), std::move(samples));
+    });
+}
+
+future<> table::train_compression_dictionary(compressor_ptr base, std::vector<sstring> samples) {
+    auto done = defer([this] () noexcept { _training_compression_dictionary = false; });
+    std::optional<sstring> dictionary;
+    try {
+        dictionary = co_await _sstables_manager.train_compression_dictionary(*base, samples);
+    } catch (...) {
+        tlogger.warn("{}.{}: failed to train a compression dictionary: {}", _schema->ks_name(), _schema->cf_name(), std::current_exception());
+        co_return;
+    }
+    if (!dictionary) {
+        co_return;
+    }
+    // The schema's compressor may have changed while training.
+    if (base != _schema->get_compressor_params().get_compressor()) {
+        tlogger.debug("{}.{}: dropped compression dictionary trained for a former compressor", _schema->ks_name(), _schema->cf_name());
+        co_return;
+    }
+    tlogger.debug("{}.{}: trained compression dictionary from {} samples", _schema->ks_name(), _schema->cf_name(), samples.size());
+    _dictionary_compressor = base->with_dictionary(std::move(*dictionary));
+    _dictionary_base = std::move(base);
+}
+
 void table::notify_bootstrap_or_replace_start() {
     _is_bootstrap_or_replace = true;
 }
@@ -484,11 +621,13 @@ void compaction_group::set_maintenance_sstables(lw_shared_ptr<sstables::sstable_
 }
 
 void table::add_sstable(compaction_group& cg, sstables::shared_sstable sstable) {
+    track_read_sizes(*sstable);
     cg.add_sstable(std::move(sstable));
     refresh_compound_sstable_set();
 }
 
 void table::add_maintenance_sstable(compaction_group& cg, sstables::shared_sstable sst) {
+    track_read_sizes(*sst);
     cg.add_maintenance_sstable(std::move(sst));
     refresh_compound_sstable_set();
 }
@@ -567,10 +706,25 @@ future<> table::parallel_foreach_compaction_group(std::function<future<>(compact
     });
 }
 
+void live_sstables_stats::add(const sstables::sstable& sst) {
+    auto& partition_size = sst.get_stats_metadata().estimated_partition_size;
+    min_partition_size = std::min(min_partition_size, partition_size.min());
+    max_partition_size = std::max(max_partition_size, partition_size.max());
+    partition_size_sum += partition_size.mean() * partition_size.count();
+    partitions += partition_size.count();
+    partition_size_histogram.merge(partition_size);
+    index_summary_memory_used += sst.get_summary().memory_footprint();
+}
+
 void table::update_stats_for_new_sstable(const sstables::shared_sstable& sst) noexcept {
     _stats.live_disk_space_used += sst->bytes_on_disk();
     _stats.total_disk_space_used += sst->bytes_on_disk();
     _stats.live_sstable_count++;
+    try {
+        _stats.live_sstables.add(*sst);
+    } catch (...) {
+        tlogger.warn("Failed to update the live sstables statistics of {}.{}: {}", _schema->ks_name(), _schema->cf_name(), std::current_exception());
+    }
 }
 
 future<>
@@ -586,6 +740,10 @@ table::do_add_sstable_and_update_cache(sstables::shared_sstable sst, sstables::o
             add_maintenance_sstable(cg, sst);
         }
         update_stats_for_new_sstable(sst);
+        // The sstable may come from streaming or repair, with any local shards.
+        if (_counter_cache) {
+            _counter_cache->clear();
+        }
     }), dht::partition_range::make({sst->get_first_decorated_key(), true}, {sst->get_last_decorated_key(), true}));
 }
 
@@ -846,6 +1004,31 @@ table::seal_active_memtable(compaction_group& cg, flush_permit&& flush_permit) n
     // FIXME: provide back-pressure to upper layers
 }
 
+// A memtable is split for a parallel flush only into pieces of at least this size,
+// smaller sstables would cost more in compaction than the flush gains.
+static constexpr size_t min_parallel_flush_size = 64 * 1024 * 1024;
+
+// Splits a token range into n contiguous sub-ranges of about the same width.
+static dht::partition_range_vector split_for_parallel_flush(const dht::token_range& range, unsigned n) {
+    auto raw_bound = [] (const std::optional<dht::token_range::bound>& b, int64_t unbounded) {
+        return b && b->value()._kind == dht::token::kind::key ? b->value().raw() : unbounded;
+    };
+    auto lo = raw_bound(range.start(), std::numeric_limits<int64_t>::min());
+    auto hi = raw_bound(range.end(), std::numeric_limits<int64_t>::max());
+    auto step = (uint64_t(hi) - uint64_t(lo)) / n;
+
+    dht::partition_range_vector ret;
+    ret.reserve(n);
+    auto start = range.start();
+    for (unsigned i = 1; i < n; ++i) {
+        auto boundary = dht::token::from_int64(int64_t(uint64_t(lo) + step * i));
+        ret.push_back(dht::to_partition_range(dht::token_range(start, dht::token_range::bound(boundary, true))));
+        start = dht::token_range::bound(boundary, false);
+    }
+    ret.push_back(dht::to_partition_range(dht::token_range(start, range.end())));
+    return ret;
+}
+
 future<>
 table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtable> old, sstable_write_permit&& permit) {
     auto try_flush = [this, old = std::move(old), permit = make_lw_shared(std::move(permit)), &cg] () mutable -> future<> {
@@ -865,7 +1048,12 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
         auto metadata = mutation_source_metadata{};
         metadata.min_timestamp = old->get_min_timestamp();
         metadata.max_timestamp = old->get_max_timestamp();
-        auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count());
+        // Large memtables are flushed into several sstables at once, each covering a slice of
+        // the compaction group's token range, so the writers' I/O overlaps and memory is
+        // released sooner under write bursts.
+        auto parallelism = std::max(std::min(size_t(_config.memtable_flush_parallelism()), old->occupancy().used_space() / min_parallel_flush_size), size_t(1));
+        auto ranges = parallelism > 1 ? split_for_parallel_flush(cg.token_range(), parallelism) : dht::partition_range_vector{query::full_partition_range};
+        auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count() / ranges.size());
 
         if (!_async_gate.is_closed()) {
             co_await _compaction_manager.maybe_wait_for_sstable_count_reduction(cg.as_table_state());
@@ -877,6 +1065,7 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
             sstables::sstable_writer_config cfg = get_sstables_manager().configure_writer("memtable");
             cfg.backup = incremental_backups_enabled();
             cfg.erm = _erm;
+            configure_compression_chunk_length(cfg);
 
             auto newtab = make_sstable();
             newtabs.push_back(newtab);
@@ -893,9 +1082,26 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
           co_await coroutine::return_exception_ptr(std::move(ex));
         });
 
-        auto f = consumer(old->make_flush_reader(
-            old->schema(),
-            compaction_concurrency_semaphore().make_tracking_only_permit(old->schema().get(), "try_flush_memtable_to_sstable()", db::no_timeout, {})));
+        auto flush_range = [this, old, &consumer] (const dht::partition_range& pr) -> future<> {
+            auto reader = old->make_flush_reader(
+                old->schema(),
+                compaction_concurrency_semaphore().make_tracking_only_permit(old->schema().get(), "try_flush_memtable_to_sstable()", db::no_timeout, {}),
+                pr);
+            if (pr.is_full()) {
+                co_return co_await consumer(std::move(reader));
+            }
+            // Don't write empty sstables for slices the memtable has no data in
+            auto has_data = co_await coroutine::as_future(reader.peek());
+            if (has_data.failed() || !has_data.get0()) {
+                co_await reader.close();
+                if (has_data.failed()) {
+                    co_await coroutine::return_exception_ptr(has_data.get_exception());
+                }
+                co_return;
+            }
+            co_await consumer(std::move(reader));
+        };
+        auto f = seastar::parallel_for_each(ranges, std::ref(flush_range));
 
         // Switch back to default scheduling group for post-flush actions, to avoid them being staved by the memtable flush
         // controller. Cache update does not affect the input of the memtable cpu controller, so it can be subject to
@@ -943,6 +1149,9 @@ table::stop() {
     }
     co_await _async_gate.close();
     co_await await_pending_ops();
+    // The view updates of this table sent in the background hold units of
+    // _view_update_backlog_sem.
+    co_await _view_update_backlog_sem.wait(0);
     co_await parallel_foreach_compaction_group(std::mem_fn(&compaction_group::stop));
     co_await _sstable_deletion_gate.close();
     co_await get_row_cache().invalidate(row_cache::external_updater([this] {
@@ -965,6 +1174,7 @@ void table::set_metrics() {
                 ms::make_counter("memtable_partition_hits", _stats.memtable_partition_hits, ms::description("Number of times a write operation was issued on an existing partition in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_writes", _stats.memtable_app_stats.row_writes, ms::description("Number of row writes performed in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks).set_skip_when_empty().set_skip_when_empty(),
+                ms::make_counter("memtable_rows_appended", _stats.memtable_app_stats.rows_appended, ms::description("Number of rows written after all the rows of their partition in memtables, as time-series rows are"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_rows_dropped_by_tombstones", _stats.memtable_app_stats.rows_dropped_by_tombstones, ms::description("Number of rows dropped in memtables by a tombstone write"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_rows_compacted_with_tombstones", _stats.memtable_app_stats.rows_compacted_with_tombstones, ms::description("Number of rows scanned during write of a tombstone for the purpose of compaction in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_range_tombstone_reads", _stats.memtable_range_tombstone_reads, ms::description("Number of range tombstones read from memtables"))(cf)(ks).set_skip_when_empty(),
@@ -973,6 +1183,7 @@ void table::set_metrics() {
                 ms::make_gauge("live_disk_space", ms::description("Live disk space used"), _stats.live_disk_space_used)(cf)(ks),
                 ms::make_gauge("total_disk_space", ms::description("Total disk space used"), _stats.total_disk_space_used)(cf)(ks),
                 ms::make_gauge("live_sstable", ms::description("Live sstable count"), _stats.live_sstable_count)(cf)(ks),
+                ms::make_gauge("compression_chunk_length", ms::description("Compression chunk length tuned for the reads of this column family, 0 if not tuned"), _tuned_chunk_length)(cf)(ks).set_skip_when_empty(),
                 ms::make_gauge("pending_compaction", ms::description("Estimated number of compactions pending for this column family"), _stats.pending_compactions)(cf)(ks),
                 ms::make_gauge("pending_sstable_deletions",
                         ms::description("Number of tasks waiting to delete sstables from a table"),
@@ -996,6 +1207,10 @@ void table::set_metrics() {
         // View metrics are created only for base tables, so there's no point in adding them to views (which cannot act as base tables for other views)
         if (!_schema->is_view()) {
             _view_stats.register_stats();
+            _metrics.add_group("column_family", {
+                    ms::make_current_bytes("view_update_backlog", ms::description("Memory consumed by the view updates of this table in flight, throttling the writes to it"),
+                            [this] { return get_view_update_backlog().current; })(cf)(ks),
+            });
         }
 
         if (!is_internal_keyspace(_schema->ks_name())) {
@@ -1008,11 +1223,32 @@ void table::set_metrics() {
 
                     ms::make_histogram("read_latency", ms::description("Read latency histogram"), [this] {return to_metrics_histogram(_stats.reads.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                     ms::make_histogram("write_latency", ms::description("Write latency histogram"), [this] {return to_metrics_histogram(_stats.writes.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+                    ms::make_histogram("precise_read_latency", ms::description("Read latency histogram with 64us to 33s buckets, at most 12.5% wide, for tail percentiles"), [this] {return to_metrics_histogram(_stats.precise_reads);})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
+                    ms::make_histogram("precise_write_latency", ms::description("Write latency histogram with 64us to 33s buckets, at most 12.5% wide, for tail percentiles"), [this] {return to_metrics_histogram(_stats.precise_writes);})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                     ms::make_histogram("cas_prepare_latency", ms::description("CAS prepare round latency histogram"), [this] {return to_metrics_histogram(_stats.cas_prepare.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                     ms::make_histogram("cas_propose_latency", ms::description("CAS accept round latency histogram"), [this] {return to_metrics_histogram(_stats.cas_accept.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                     ms::make_histogram("cas_commit_latency", ms::description("CAS learn round latency histogram"), [this] {return to_metrics_histogram(_stats.cas_learn.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
-                    ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks)
+                    ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks),
+                    ms::make_gauge("sstable_scan_average_read_size", ms::description("Average size in bytes of the disk reads sequential scans issued to the live sstables of the table"), [this] {
+                        uint64_t reads = 0;
+                        uint64_t bytes = 0;
+                        _sstables->for_each_sstable([&] (const sstables::shared_sstable& sst) {
+                            reads += sst->get_stats().sequential_scan_reads();
+                            bytes += sst->get_stats().sequential_scan_read_bytes();
+                        });
+                        return reads ? double(bytes) / reads : 0.0;
+                    })(cf)(ks)
             });
+            if (auto* sem = _config.read_concurrency_semaphore) {
+                _metrics.add_group("column_family", {
+                        ms::make_gauge("queued_reads", ms::description("Number of reads waiting for admission"),
+                                [this, sem] { return sem->get_class_stats(_schema->id()).queued_reads; })(cf)(ks).set_skip_when_empty(),
+                        ms::make_counter("reads_enqueued_for_admission", ms::description("Number of reads which had to wait for admission"),
+                                [this, sem] { return sem->get_class_stats(_schema->id()).reads_enqueued_for_admission; })(cf)(ks).set_skip_when_empty(),
+                        ms::make_counter("read_admission_wait_time", ms::description("Total time in microseconds the admitted reads waited for admission"),
+                                [this, sem] { return sem->get_class_stats(_schema->id()).admission_wait_time.count(); })(cf)(ks).set_skip_when_empty(),
+                });
+            }
         }
     }
 }
@@ -1053,6 +1289,16 @@ void table::rebuild_statistics() {
         _stats.total_disk_space_used += cg->total_disk_space_used();
         _stats.live_sstable_count += cg->live_sstable_count();
     }
+
+    try {
+        live_sstables_stats live_sstables;
+        _sstables->for_each_sstable([&] (const sstables::shared_sstable& sst) {
+            live_sstables.add(*sst);
+        });
+        _stats.live_sstables = std::move(live_sstables);
+    } catch (...) {
+        tlogger.warn("Failed to rebuild the live sstables statistics of {}.{}: {}", _schema->ks_name(), _schema->cf_name(), std::current_exception());
+    }
 }
 
 future<lw_shared_ptr<sstables::sstable_set>>
@@ -1539,6 +1785,8 @@ table::table(schema_ptr schema, config config, lw_shared_ptr<const storage_optio
     , _sstables_manager(sst_manager)
     , _index_manager(this->as_data_dictionary())
     , _counter_cell_locks(_schema->is_counter() ? std::make_unique<cell_locker>(_schema, cl_stats) : nullptr)
+    , _counter_cache(_schema->is_counter() && _config.counter_cache_tracker && _config.counter_cache_tracker->enabled()
+            ? std::make_unique<counter_cache>(_schema, *_config.counter_cache_tracker) : nullptr)
     , _row_locker(_schema)
     , _off_strategy_trigger([this] { trigger_offstrategy_compaction(); })
 {
@@ -1612,21 +1860,6 @@ logalloc::occupancy_stats table::occupancy() const {
 
 future<>
 table::seal_snapshot(sstring jsondir, std::vector<snapshot_file_set> file_sets) {
-    std::ostringstream ss;
-    int n = 0;
-    ss << "{" << std::endl << "\t\"files\" : [ ";
-    for (const auto& fsp : file_sets) {
-      for (const auto& rf : *fsp) {
-        if (n++ > 0) {
-            ss << ", ";
-        }
-        ss << "\"" << rf << "\"";
-        co_await coroutine::maybe_yield();
-      }
-    }
-    ss << " ]" << std::endl << "}" << std::endl;
-
-    auto json = ss.str();
     auto jsonfile = jsondir + "/manifest.json";
 
     tlogger.debug("Storing manifest {}", jsonfile);
@@ -1636,7 +1869,17 @@ table::seal_snapshot(sstring jsondir, std::vector<snapshot_file_set> file_sets)
     auto out = co_await make_file_output_stream(std::move(f));
     std::exception_ptr ex;
     try {
-        co_await out.write(json.c_str(), json.size());
+        // The manifest lists every sstable of the table, so it is streamed
+        // to the file rather than built in memory first.
+        co_await out.write("{\n\t\"files\" : [ ");
+        int n = 0;
+        for (const auto& fsp : file_sets) {
+          for (const auto& rf : *fsp) {
+            co_await out.write(format("{}\"{}\"", n++ > 0 ? ", " : "", rf));
+            co_await coroutine::maybe_yield();
+          }
+        }
+        co_await out.write(" ]\n}\n");
         co_await out.flush();
     } catch (...) {
         ex = std::current_exception();
@@ -1903,14 +2146,24 @@ future<db::replay_position> table::discard_sstables(db_clock::time_point truncat
         }
         refresh_compound_sstable_set();
         tlogger.debug("cleaning out row cache");
+        if (_counter_cache) {
+            _counter_cache->clear();
+        }
     }));
     rebuild_statistics();
-    co_await coroutine::parallel_for_each(p->remove, [this, p] (pruner::removed_sstable& r) -> future<> {
+    // Delete the sstables of each storage location in one batch, rather than one by one,
+    // so that a truncate writes a single pending deletion log per location, instead of
+    // one per sstable, and unlinks all the sstables in parallel.
+    std::unordered_map<sstring, std::vector<sstables::shared_sstable>> to_delete;
+    for (auto& r : p->remove) {
         if (r.enable_backlog_tracker) {
             remove_sstable_from_backlog_tracker(r.cg.get_backlog_tracker(), r.sst);
         }
-        co_await get_sstables_manager().delete_atomically({r.sst});
         erase_sstable_cleanup_state(r.sst);
+        to_delete[r.sst->get_storage().prefix()].push_back(r.sst);
+    }
+    co_await coroutine::parallel_for_each(to_delete, [this] (auto& entry) -> future<> {
+        co_await get_sstables_manager().delete_atomically(std::move(entry.second));
     });
     co_return p->rp;
 }
@@ -1930,6 +2183,9 @@ void table::set_schema(schema_ptr s) {
     if (_counter_cell_locks) {
         _counter_cell_locks->set_schema(s);
     }
+    if (_counter_cache) {
+        _counter_cache->set_schema(s);
+    }
     _schema = std::move(s);
 
     for (auto&& v : _views) {
@@ -2032,10 +2288,12 @@ future<> table::generate_and_propagate_view_updates(shared_ptr<db::view::view_up
             break;
         }
         tracing::trace(tr_state, "Generated {} view update mutations", updates->size());
-        auto units = seastar::consume_units(*_config.view_update_concurrency_semaphore, memory_usage_of(*updates));
+        size_t update_size = memory_usage_of(*updates);
+        auto units = seastar::consume_units(*_config.view_update_concurrency_semaphore, update_size);
+        auto base_units = seastar::consume_units(_view_update_backlog_sem, update_size);
         try {
             co_await gen->mutate_MV(base_token, std::move(*updates), _view_stats, *_config.cf_stats, tr_state,
-                std::move(units), service::allow_hints::yes, db::view::wait_for_all_updates::no);
+                std::move(units), std::move(base_units), service::allow_hints::yes, db::view::wait_for_all_updates::no);
         } catch (...) {
             // Ignore exceptions: any individual failure to propagate a view update will be reported
             // by a separate mechanism in mutate_MV() function. Moreover, we should continue trying
@@ -2168,8 +2426,9 @@ future<> table::populate_views(
             size_t units_to_wait_for = std::min(_config.view_update_concurrency_semaphore_limit, update_size);
             auto units = co_await seastar::get_units(*_config.view_update_concurrency_semaphore, units_to_wait_for);
             units.adopt(seastar::consume_units(*_config.view_update_concurrency_semaphore, update_size - units_to_wait_for));
+            auto base_units = seastar::consume_units(_view_update_backlog_sem, update_size);
             co_await gen->mutate_MV(base_token, std::move(*updates), _view_stats, *_config.cf_stats,
-                    tracing::trace_state_ptr(), std::move(units), service::allow_hints::no, db::view::wait_for_all_updates::yes);
+                    tracing::trace_state_ptr(), std::move(units), std::move(base_units), service::allow_hints::no, db::view::wait_for_all_updates::yes);
         } catch (...) {
             if (!err) {
                 err = std::current_exception();
@@ -2194,6 +2453,21 @@ void table::set_hit_rate(gms::inet_address addr, cache_temperature rate) {
     e.last_updated = lowres_clock::now();
 }
 
+void table::set_hit_rate(gms::inet_address addr, const dht::token& t, cache_temperature rate) {
+    auto& e = _cluster_token_range_hit_rates[addr][row_cache::token_range_bucket(t)];
+    e.rate = rate;
+    e.last_updated = lowres_clock::now();
+}
+
+cache_temperature table::get_cache_hit_rate_for(const dht::partition_range& pr) const {
+    if (pr.is_singular()) {
+        if (auto rate = _cache.token_range_hit_rate(pr.start()->value().token())) {
+            return *rate;
+        }
+    }
+    return _global_cache_hit_rate;
+}
+
 table::cache_hit_rate table::get_my_hit_rate() const {
     return cache_hit_rate { _global_cache_hit_rate, lowres_clock::now()};
 }
@@ -2227,8 +2501,24 @@ table::cache_hit_rate table::get_hit_rate(const gms::gossiper& gossiper, gms::in
     }
 }
 
+table::cache_hit_rate table::get_hit_rate(const gms::gossiper& gossiper, gms::inet_address addr, const dht::token& t) {
+    if (utils::fb_utilities::get_broadcast_address() == addr) {
+        auto rate = _cache.token_range_hit_rate(t);
+        return rate ? cache_hit_rate{*rate, lowres_clock::now()} : get_my_hit_rate();
+    }
+    auto it = _cluster_token_range_hit_rates.find(addr);
+    if (it != _cluster_token_range_hit_rates.end()) {
+        auto& e = it->second[row_cache::token_range_bucket(t)];
+        if (e.last_updated != lowres_clock::time_point()) {
+            return e;
+        }
+    }
+    return get_hit_rate(gossiper, addr);
+}
+
 void table::drop_hit_rate(gms::inet_address addr) {
     _cluster_cache_hit_rates.erase(addr);
+    _cluster_token_range_hit_rates.erase(addr);
 }
 
 void
@@ -2261,6 +2551,9 @@ void table::do_apply(compaction_group& cg, db::rp_handle&& h, Args&&... args) {
         throw;
     }
     _stats.writes.mark(lc);
+    if (lc.is_start()) {
+        _stats.precise_writes.add(lc.latency());
+    }
 }
 
 future<> table::apply(const mutation& m, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
@@ -2370,6 +2663,9 @@ table::query(schema_ptr s,
 
     auto finally = defer([&] () noexcept {
         _stats.reads.mark(lc);
+        if (lc.is_start()) {
+            _stats.precise_reads.add(lc.latency());
+        }
         _async_gate.leave();
     });
 
@@ -2625,8 +2921,104 @@ future<row_locker::lock_holder> table::push_view_replica_updates(shared_ptr<db::
     return push_view_replica_updates(std::move(gen), s, std::move(m), timeout, std::move(tr_state), sem);
 }
 
+// The slice of the existing base rows needed to generate the view updates
+// of a write to the rows in \p cr_ranges and/or to the static row.
+static query::partition_slice make_view_update_read_slice(const schema& base, query::clustering_row_ranges cr_ranges,
+        bool need_regular, bool need_static, query::partition_slice::option_set custom_opts) {
+    // We read whole sets of regular and/or static columns in case the update now causes a base row to pass
+    // a view's filters, and a view happens to include columns that have no value in this update.
+    // Also, one of those columns can determine the lifetime of the base row, if it has a TTL.
+    query::column_id_vector static_columns;
+    query::column_id_vector regular_columns;
+    if (need_regular) {
+        boost::copy(base.regular_columns() | boost::adaptors::transformed(std::mem_fn(&column_definition::id)), std::back_inserter(regular_columns));
+    }
+    if (need_static) {
+        boost::copy(base.static_columns() | boost::adaptors::transformed(std::mem_fn(&column_definition::id)), std::back_inserter(static_columns));
+    }
+    query::partition_slice::option_set opts;
+    opts.set(query::partition_slice::option::send_partition_key);
+    opts.set_if<query::partition_slice::option::send_clustering_key>(need_regular);
+    opts.set_if<query::partition_slice::option::distinct>(need_static && !need_regular);
+    opts.set_if<query::partition_slice::option::always_return_static_content>(need_static);
+    opts.set(query::partition_slice::option::send_timestamp);
+    opts.set(query::partition_slice::option::send_ttl);
+    opts.add(custom_opts);
+    return query::partition_slice(
+            std::move(cr_ranges), std::move(static_columns), std::move(regular_columns), std::move(opts), { }, query::max_rows);
+}
+
+future<flat_mutation_reader_v2> table::make_coalesced_view_update_reader(const schema_ptr& base, const dht::decorated_key& dk,
+        const query::partition_slice& slice, bool need_regular, bool need_static, reader_permit permit,
+        tracing::trace_state_ptr tr_state, std::chrono::microseconds window) const {
+    // The writes sharing a read hold the locks of the rows they read, so the
+    // rows each of them gets from the shared read can't change until it's
+    // done writing them, like with a read of its own.
+    lw_shared_ptr<coalesced_view_update_read> read;
+    auto [begin, end] = _coalesced_view_update_reads.equal_range(dk.token());
+    for (auto it = begin; it != end; ++it) {
+        if (it->second->base == base && it->second->key.equal(*base, dk)) {
+            read = it->second;
+            break;
+        }
+    }
+    if (read) {
+        auto& ranges = slice.default_row_ranges();
+        read->ranges.insert(read->ranges.end(), ranges.begin(), ranges.end());
+        read->need_regular |= need_regular;
+        read->need_static |= need_static;
+        auto f = co_await coroutine::as_future(read->result.get_shared_future());
+        if (!f.failed()) {
+            ++_config.cf_stats->coalesced_view_update_reads;
+            tracing::trace(tr_state, "Existing base rows were read together with other writes to the partition");
+            if (auto m = f.get0()) {
+                co_return make_flat_mutation_reader_from_mutations_v2(base, std::move(permit), std::move(*m), slice);
+            }
+            co_return make_empty_flat_reader_v2(base, std::move(permit));
+        }
+        // Read on our own, the shared read failed for the write which started it.
+        f.ignore_ready_future();
+        co_return as_mutation_source().make_reader_v2(base, std::move(permit), dht::partition_range::make_singular(dk), slice, tr_state,
+                streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+    }
+
+    read = make_lw_shared<coalesced_view_update_read>(coalesced_view_update_read{base, dk, slice.default_row_ranges(), need_regular, need_static, {}});
+    _coalesced_view_update_reads.emplace(dk.token(), read);
+    co_await sleep(window);
+    for (auto it = _coalesced_view_update_reads.find(dk.token()); it != _coalesced_view_update_reads.end(); ++it) {
+        if (it->second == read) {
+            _coalesced_view_update_reads.erase(it);
+            break;
+        }
+    }
+
+    std::exception_ptr ex;
+    mutation_opt m;
+    try {
+        auto ranges = clustering_interval_set(*base, read->ranges).to_clustering_row_ranges();
+        auto shared_slice = make_view_update_read_slice(*base, std::move(ranges), read->need_regular, read->need_static, {});
+        auto pr = dht::partition_range::make_singular(dk);
+        auto reader = as_mutation_source().make_reader_v2(base, permit, pr, shared_slice, tr_state,
+                streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+        m = co_await with_closeable(std::move(reader), [] (flat_mutation_reader_v2& reader) {
+            return read_mutation_from_flat_mutation_reader(reader);
+        });
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        read->result.set_exception(ex);
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    read->result.set_value(m);
+    if (m) {
+        co_return make_flat_mutation_reader_from_mutations_v2(base, std::move(permit), std::move(*m), slice);
+    }
+    co_return make_empty_flat_reader_v2(base, std::move(permit));
+}
+
 future<row_locker::lock_holder> table::do_push_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, schema_ptr s, mutation m, db::timeout_clock::time_point timeout, mutation_source source,
-        tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, query::partition_slice::option_set custom_opts) const {
+        tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, query::partition_slice::option_set custom_opts, bool coalesce_reads) const {
     if (!_config.view_update_concurrency_semaphore->current()) {
         // We don't have resources to generate view updates for this write. If we reached this point, we failed to
         // throttle the client. The memory queue is already full, waiting on the semaphore would cause this node to
@@ -2656,27 +3048,7 @@ future<row_locker::lock_holder> table::do_push_view_replica_updates(shared_ptr<d
         // write, so no lock is needed.
         co_return row_locker::lock_holder();
     }
-    // We read whole sets of regular and/or static columns in case the update now causes a base row to pass
-    // a view's filters, and a view happens to include columns that have no value in this update.
-    // Also, one of those columns can determine the lifetime of the base row, if it has a TTL.
-    query::column_id_vector static_columns;
-    query::column_id_vector regular_columns;
-    if (need_regular) {
-        boost::copy(base->regular_columns() | boost::adaptors::transformed(std::mem_fn(&column_definition::id)), std::back_inserter(regular_columns));
-    }
-    if (need_static) {
-        boost::copy(base->static_columns() | boost::adaptors::transformed(std::mem_fn(&column_definition::id)), std::back_inserter(static_columns));
-    }
-    query::partition_slice::option_set opts;
-    opts.set(query::partition_slice::option::send_partition_key);
-    opts.set_if<query::partition_slice::option::send_clustering_key>(need_regular);
-    opts.set_if<query::partition_slice::option::distinct>(need_static && !need_regular);
-    opts.set_if<query::partition_slice::option::always_return_static_content>(need_static);
-    opts.set(query::partition_slice::option::send_timestamp);
-    opts.set(query::partition_slice::option::send_ttl);
-    opts.add(custom_opts);
-    auto slice = query::partition_slice(
-            std::move(cr_ranges), std::move(static_columns), std::move(regular_columns), std::move(opts), { }, query::max_rows);
+    auto slice = make_view_update_read_slice(*base, std::move(cr_ranges), need_regular, need_static, custom_opts);
     // Take the shard-local lock on the base-table row or partition as needed.
     // We'll return this lock to the caller, which will release it after
     // writing the base-table update.
@@ -2685,7 +3057,10 @@ future<row_locker::lock_holder> table::do_push_view_replica_updates(shared_ptr<d
     auto lock = co_await std::move(lockf);
     auto pk = dht::partition_range::make_singular(m.decorated_key());
     auto permit = sem.make_tracking_only_permit(base.get(), "push-view-updates-2", timeout, tr_state);
-    auto reader = source.make_reader_v2(base, permit, pk, slice, tr_state, streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+    const auto coalescing_window = std::chrono::microseconds(coalesce_reads ? gen->get_db().get_config().view_update_read_coalescing_window_in_us() : 0);
+    auto reader = coalescing_window.count()
+            ? co_await make_coalesced_view_update_reader(base, m.decorated_key(), slice, need_regular, need_static, permit, tr_state, coalescing_window)
+            : source.make_reader_v2(base, permit, pk, slice, tr_state, streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
     co_await this->generate_and_propagate_view_updates(gen, base, std::move(permit), std::move(views), std::move(m), std::move(reader), tr_state, now);
     tracing::trace(tr_state, "View updates for {}.{} were generated and propagated", base->ks_name(), base->cf_name());
     // return the local partition/row lock we have taken so it
@@ -2698,7 +3073,7 @@ future<row_locker::lock_holder> table::do_push_view_replica_updates(shared_ptr<d
 future<row_locker::lock_holder> table::push_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, const schema_ptr& s, mutation&& m, db::timeout_clock::time_point timeout,
         tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem) const {
     return do_push_view_replica_updates(std::move(gen), s, std::move(m), timeout, as_mutation_source(),
-            std::move(tr_state), sem, {});
+            std::move(tr_state), sem, {}, true);
 }
 
 future<row_locker::lock_holder>
@@ -2712,7 +3087,8 @@ table::stream_view_replica_updates(shared_ptr<db::view::view_update_generator> g
             as_mutation_source_excluding_staging(),
             tracing::trace_state_ptr(),
             *_config.streaming_read_concurrency_semaphore,
-            query::partition_slice::option_set::of<query::partition_slice::option::bypass_cache>());
+            query::partition_slice::option_set::of<query::partition_slice::option::bypass_cache>(),
+            false);
 }
 
 mutation_source
@@ -2782,6 +3158,8 @@ class compaction_group::table_state : public compaction::table_state {
     sstables::sstable_writer_config configure_writer(sstring origin) const override {
         auto cfg = _t.get_sstables_manager().configure_writer(std::move(origin));
         cfg.erm = _t.get_effective_replication_map();
+        _t.configure_compression_dictionary(cfg);
+        _t.configure_compression_chunk_length(cfg);
         return cfg;
     }
     api::timestamp_type min_memtable_timestamp() const override {
@@ -2794,6 +3172,7 @@ class compaction_group::table_state : public compaction::table_state {
             co_return;
         }
         co_await _cg.update_main_sstable_list_on_compaction_completion(std::move(desc));
+        _t.maybe_train_compression_dictionary();
     }
     bool is_auto_compaction_disabled_by_user() const noexcept override {
         return _t.is_auto_compaction_disabled_by_user();
@@ -7,6 +7,7 @@
  */
 
 #include "row_cache.hh"
+#include <bit>
 #include <seastar/core/memory.hh>
 #include <seastar/core/do_with.hh>
 #include <seastar/core/future-util.hh>
@@ -57,10 +58,19 @@ cache_tracker::cache_tracker(register_metrics with_metrics)
 
 static thread_local cache_tracker* current_tracker;
 
+// Number of distinct partitions the admission sketch can tell apart (8 bytes each).
+static constexpr size_t admission_sketch_keys = 64 * 1024;
+// Admitted partitions must have been missed at least this many times recently
+// (including the current miss).
+static constexpr unsigned admission_min_frequency = 2;
+// For how long after an eviction the cache is considered to be full.
+static constexpr auto eviction_pressure_period = std::chrono::seconds(1);
+
 cache_tracker::cache_tracker(mutation_application_stats& app_stats, register_metrics with_metrics)
     : _garbage(_region, this, app_stats)
     , _memtable_cleaner(_region, nullptr, app_stats)
     , _app_stats(app_stats)
+    , _admission_sketch(admission_sketch_keys)
 {
     if (with_metrics) {
         setup_metrics();
@@ -144,6 +154,22 @@ cache_tracker::setup_metrics() {
             sm::description("total amount of attempts to compact expired rows during read")),
         sm::make_counter("rows_compacted_away", _stats.rows_compacted_away,
             sm::description("total amount of compacted and removed rows during read")),
+        sm::make_gauge("lru_probation_entries", sm::description("number of cache entries (rows and index pages) in the probationary segment of the LRU"),
+            [this] { return _lru.get_stats().probation_size; }),
+        sm::make_gauge("lru_protected_entries", sm::description("number of cache entries (rows and index pages) in the protected segment of the LRU"),
+            [this] { return _lru.get_stats().protected_size; }),
+        sm::make_counter("lru_promotions", sm::description("total number of cache entries promoted to the protected segment of the LRU on reuse"),
+            [this] { return _lru.get_stats().promotions; }),
+        sm::make_counter("lru_demotions", sm::description("total number of cache entries moved back from the protected to the probationary segment of the LRU"),
+            [this] { return _lru.get_stats().demotions; }),
+        sm::make_counter("lru_probation_evictions", sm::description("total number of cache entries evicted from the probationary segment of the LRU"),
+            [this] { return _lru.get_stats().probation_evictions; }),
+        sm::make_counter("lru_protected_evictions", sm::description("total number of cache entries evicted from the protected segment of the LRU"),
+            [this] { return _lru.get_stats().protected_evictions; }),
+        sm::make_counter("partition_admissions", _stats.partition_admissions,
+            sm::description("total number of partitions missed by reads which were admitted to cache by the admission policy")),
+        sm::make_counter("partition_admission_rejections", _stats.partition_admission_rejections,
+            sm::description("total number of partitions missed by reads which were not populated because they were not read frequently enough")),
     });
 }
 
@@ -169,9 +195,10 @@ void cache_tracker::clear() {
 void cache_tracker::touch(rows_entry& e) {
     // last dummy may not be linked if evicted
     if (e.is_linked()) {
-        _lru.remove(e);
+        _lru.touch(e);
+    } else {
+        _lru.add(e);
     }
-    _lru.add(e);
 }
 
 void cache_tracker::insert(cache_entry& entry) {
@@ -203,11 +230,27 @@ void cache_tracker::on_partition_miss() noexcept {
 void cache_tracker::on_partition_eviction() noexcept {
     --_stats.partitions;
     ++_stats.partition_evictions;
+    _last_eviction = seastar::lowres_clock::now();
 }
 
 void cache_tracker::on_row_eviction() noexcept {
     --_stats.rows;
     ++_stats.row_evictions;
+    _last_eviction = seastar::lowres_clock::now();
+}
+
+bool cache_tracker::under_eviction_pressure() const noexcept {
+    return _stats.row_evictions != 0 && seastar::lowres_clock::now() - _last_eviction < eviction_pressure_period;
+}
+
+bool cache_tracker::admit(uint64_t key_hash) noexcept {
+    _admission_sketch.increment(key_hash);
+    if (under_eviction_pressure() && _admission_sketch.estimate(key_hash) < admission_min_frequency) {
+        ++_stats.partition_admission_rejections;
+        return false;
+    }
+    ++_stats.partition_admissions;
+    return true;
 }
 
 void cache_tracker::on_row_hit() noexcept {
@@ -386,14 +429,16 @@ class single_partition_populating_reader final : public flat_mutation_reader_v2:
                     _cache._tracker.on_mispopulate();
                 }
                 _end_of_stream = true;
-            } else if (phase == _cache.phase_of(_read_context->range().start()->value())) {
+            } else if (phase != _cache.phase_of(_read_context->range().start()->value())) {
+                _cache._tracker.on_mispopulate();
+                _reader = read_directly_from_underlying(*_read_context, std::move(*mfopt));
+            } else if (!_cache.should_admit(_read_context->key())) {
+                _reader = read_directly_from_underlying(*_read_context, std::move(*mfopt));
+            } else {
                 _reader = _cache._read_section(_cache._tracker.region(), [&] {
                     cache_entry& e = _cache.find_or_create_incomplete(mfopt->as_partition_start(), phase);
                     return e.read(_cache, *_read_context, phase);
                 });
-            } else {
-                _cache._tracker.on_mispopulate();
-                _reader = read_directly_from_underlying(*_read_context, std::move(*mfopt));
             }
           });
         });
@@ -449,6 +494,27 @@ void cache_tracker::clear_continuity(cache_entry& ce) noexcept {
     ce.set_continuous(false);
 }
 
+unsigned row_cache::token_range_bucket(const dht::token& t) noexcept {
+    auto biased = uint64_t(dht::token::to_int64(t)) + (uint64_t(1) << 63);
+    return biased >> (64 - std::countr_zero(token_range_buckets));
+}
+
+void row_cache::on_single_partition_read(const dht::token& t, bool hit) noexcept {
+    // Weighs the last 64 or so reads of the range
+    constexpr float alpha = 1.0f / 64;
+    auto b = token_range_bucket(t);
+    _token_range_hit_rates[b] += alpha * ((hit ? 1.0f : 0.0f) - _token_range_hit_rates[b]);
+    _token_range_read.set(b);
+}
+
+std::optional<cache_temperature> row_cache::token_range_hit_rate(const dht::token& t) const noexcept {
+    auto b = token_range_bucket(t);
+    if (!_token_range_read.test(b)) {
+        return std::nullopt;
+    }
+    return cache_temperature(_token_range_hit_rates[b]);
+}
+
 void row_cache::on_partition_hit() {
     _tracker.on_partition_hit();
 }
@@ -457,6 +523,14 @@ void row_cache::on_partition_miss() {
     _tracker.on_partition_miss();
 }
 
+bool row_cache::should_admit(const dht::decorated_key& dk) {
+    if (!_schema->caching_options().admit_frequent_only()) {
+        return true;
+    }
+    auto key_hash = uint64_t(dk.token().raw()) ^ _schema->id().uuid().get_least_significant_bits();
+    return _tracker.admit(key_hash);
+}
+
 void row_cache::on_row_hit() {
     _stats.hits.mark();
     _tracker.on_row_hit();
@@ -530,7 +604,7 @@ class range_populating_reader {
                 _cache.on_partition_miss();
                 const partition_start& ps = mfopt->as_partition_start();
                 const dht::decorated_key& key = ps.key();
-                if (_reader.creation_phase() == _cache.phase_of(key)) {
+                if (_reader.creation_phase() == _cache.phase_of(key) && _cache.should_admit(key)) {
                     return _cache._read_section(_cache._tracker.region(), [&] {
                         cache_entry& e = _cache.find_or_create_incomplete(ps, _reader.creation_phase(),
                                                                this->can_set_continuity() ? &*_last_key : nullptr);
@@ -538,7 +612,9 @@ class range_populating_reader {
                         return make_ready_future<flat_mutation_reader_v2_opt>(e.read(_cache, _read_context, _reader.creation_phase()));
                     });
                 } else {
-                    _cache._tracker.on_mispopulate();
+                    if (_reader.creation_phase() != _cache.phase_of(key)) {
+                        _cache._tracker.on_mispopulate();
+                    }
                     _last_key = row_cache::previous_entry_pointer(key);
                     return make_ready_future<flat_mutation_reader_v2_opt>(read_directly_from_underlying(_read_context, std::move(*mfopt)));
                 }
@@ -11,6 +11,8 @@
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/intrusive/parent_from_member.hpp>
+#include <array>
+#include <bitset>
 
 #include <seastar/core/memory.hh>
 #include <seastar/util/noncopyable_function.hh>
@@ -25,6 +27,7 @@
 #include "db/cache_tracker.hh"
 #include "readers/empty_v2.hh"
 #include "readers/mutation_source.hh"
+#include "cache_temperature.hh"
 
 namespace bi = boost::intrusive;
 
@@ -207,9 +210,19 @@ class row_cache final {
         utils::timed_rate_moving_average reads_with_misses;
         utils::timed_rate_moving_average reads_with_no_misses;
     };
+
+    // The token ring is divided into this many equal ranges, for which the
+    // hit rates of single-partition reads are tracked separately, so
+    // coordinators can prefer the replica which caches the range they read.
+    static constexpr unsigned token_range_buckets = 16;
+    static unsigned token_range_bucket(const dht::token& t) noexcept;
 private:
     cache_tracker& _tracker;
     stats _stats{};
+    // Moving averages of whether single-partition reads of a token range
+    // were served from the cache, and whether there was any such read.
+    std::array<float, token_range_buckets> _token_range_hit_rates{};
+    std::bitset<token_range_buckets> _token_range_read{};
     schema_ptr _schema;
     partitions_type _partitions; // Cached partitions are complete.
 
@@ -258,10 +271,14 @@ class row_cache final {
     flat_mutation_reader_v2 make_scanning_reader(const dht::partition_range&, std::unique_ptr<cache::read_context>);
     void on_partition_hit();
     void on_partition_miss();
+    void on_single_partition_read(const dht::token&, bool hit) noexcept;
     void on_row_hit();
     void on_row_miss();
     void on_static_row_insert();
     void on_mispopulate();
+    // Whether a partition missed by a read should be populated, according
+    // to the table's caching admission policy.
+    bool should_admit(const dht::decorated_key&);
     void upgrade_entry(cache_entry&);
     void invalidate_locked(const dht::decorated_key&);
     void clear_now() noexcept;
@@ -393,6 +410,10 @@ class row_cache final {
     }
 
     const stats& stats() const { return _stats; }
+
+    // The hit rate of the single-partition reads of the token range of t,
+    // or std::nullopt if there was none so far.
+    std::optional<cache_temperature> token_range_hit_rate(const dht::token& t) const noexcept;
 public:
     // Populate cache from given mutation, which must be fully continuous.
     // Intended to be used only in tests.
@@ -12,8 +12,8 @@
 #include "exceptions/exceptions.hh"
 #include "utils/rjson.hh"
 
-caching_options::caching_options(sstring k, sstring r, bool enabled)
-        : _key_cache(k), _row_cache(r), _enabled(enabled) {
+caching_options::caching_options(sstring k, sstring r, bool enabled, bool frequent_only, std::chrono::milliseconds results_ttl)
+        : _key_cache(k), _row_cache(r), _enabled(enabled), _frequent_only(frequent_only), _results_ttl(results_ttl) {
     if ((k != "ALL") && (k != "NONE")) {
         throw exceptions::configuration_exception("Invalid key value: " + k); 
     }
@@ -40,6 +40,12 @@ caching_options::to_map() const {
     if (!_enabled) {
         res.insert({"enabled", "false"});
     }
+    if (_frequent_only) {
+        res.insert({"admission", "FREQUENT"});
+    }
+    if (_results_ttl.count()) {
+        res.insert({"results_ttl_in_ms", std::to_string(_results_ttl.count())});
+    }
     return res;
 }
 
@@ -58,6 +64,8 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
     sstring k = default_key;
     sstring r = default_row;
     bool e = true;
+    bool f = false;
+    std::chrono::milliseconds t{0};
 
     for (auto& p : map) {
         if (p.first == "keys") {
@@ -66,11 +74,22 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
             r = p.second;
         } else if (p.first == "enabled") {
             e = p.second == "true";
+        } else if (p.first == "admission") {
+            if (p.second != "ALL" && p.second != "FREQUENT") {
+                throw exceptions::configuration_exception("Invalid admission value: " + p.second);
+            }
+            f = p.second == "FREQUENT";
+        } else if (p.first == "results_ttl_in_ms") {
+            try {
+                t = std::chrono::milliseconds(boost::lexical_cast<uint32_t>(p.second));
+            } catch (boost::bad_lexical_cast& e) {
+                throw exceptions::configuration_exception("Invalid results_ttl_in_ms value: " + p.second);
+            }
         } else {
             throw exceptions::configuration_exception(format("Invalid caching option: {}", p.first));
         }
     }
-    return caching_options(k, r, e);
+    return caching_options(k, r, e, f, t);
 }
 
 caching_options
@@ -9,6 +9,7 @@
 #pragma once
 #include <seastar/core/sstring.hh>
 #include <map>
+#include <chrono>
 #include "seastarx.hh"
 
 class schema;
@@ -25,7 +26,13 @@ class caching_options {
     sstring _key_cache;
     sstring _row_cache;
     bool _enabled = true;
-    caching_options(sstring k, sstring r, bool enabled);
+    // When set, partitions missing in cache are only populated on reads
+    // if they were read frequently enough recently (see cache_tracker::admit()).
+    bool _frequent_only = false;
+    // When non-zero, the results of prepared SELECT statements are cached by
+    // the coordinator for that long (see cql3::query_results_cache).
+    std::chrono::milliseconds _results_ttl{0};
+    caching_options(sstring k, sstring r, bool enabled, bool frequent_only = false, std::chrono::milliseconds results_ttl = {});
 
     friend class schema;
     caching_options();
@@ -34,6 +41,14 @@ class caching_options {
         return _enabled;
     }
 
+    bool admit_frequent_only() const {
+        return _frequent_only;
+    }
+
+    std::chrono::milliseconds results_ttl() const {
+        return _results_ttl;
+    }
+
     std::map<sstring, sstring> to_map() const;
 
     sstring to_sstring() const;
@@ -156,8 +156,11 @@ inline cf_type sstring_to_cf_type(sstring name) {
 }
 
 struct speculative_retry {
+    // ADAPTIVE is like PERCENTILE, but with the percentile taken from the
+    // latencies of each of the replicas read from, instead of those of the
+    // table, and with the speculative reads limited by a retry budget.
     enum class type {
-        NONE, CUSTOM, PERCENTILE, ALWAYS
+        NONE, CUSTOM, PERCENTILE, ALWAYS, ADAPTIVE
     };
 private:
     type _t;
@@ -174,6 +177,8 @@ struct speculative_retry {
             return format("{:.2f}ms", _v);
         } else if (_t == type::PERCENTILE) {
             return format("{:.1f}PERCENTILE", 100 * _v);
+        } else if (_t == type::ADAPTIVE) {
+            return format("{:.1f}ADAPTIVE", 100 * _v);
         } else {
             throw std::invalid_argument(format("unknown type: {:d}\n", uint8_t(_t)));
         }
@@ -183,6 +188,7 @@ struct speculative_retry {
 
         sstring ms("MS");
         sstring percentile("PERCENTILE");
+        sstring adaptive("ADAPTIVE");
 
         auto convert = [&str] (sstring& t) {
             try {
@@ -204,6 +210,9 @@ struct speculative_retry {
         } else if (str.compare(str.size() - percentile.size(), percentile.size(), percentile) == 0) {
             t = type::PERCENTILE;
             v = convert(percentile) / 100;
+        } else if (str.compare(str.size() - adaptive.size(), adaptive.size(), adaptive) == 0) {
+            t = type::ADAPTIVE;
+            v = convert(adaptive) / 100;
         } else {
             throw std::invalid_argument(format("cannot convert {} to speculative_retry\n", str));
         }
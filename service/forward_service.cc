@@ -8,6 +8,7 @@
 
 #include "service/forward_service.hh"
 
+#include <boost/range/adaptor/sliced.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future-util.hh>
@@ -35,10 +36,12 @@
 #include "tracing/trace_state.hh"
 #include "tracing/tracing.hh"
 #include "types/types.hh"
+#include "types/tuple.hh"
 #include "utils/fb_utilities.hh"
 #include "service/storage_proxy.hh"
 
 #include "cql3/functions/aggregate_function.hh"
+#include "cql3/functions/aggregate_fcts.hh"
 #include "cql3/column_identifier.hh"
 #include "cql3/cql_config.hh"
 #include "cql3/query_options.hh"
@@ -61,6 +64,13 @@ class forward_aggregates {
 private:
     std::vector<::shared_ptr<db::functions::aggregate_function>> _funcs;
     std::vector<db::functions::stateless_aggregate_function> _aggrs;
+    schema_ptr _schema;
+    // Number of GROUP BY columns, whose values are reduced (by $$first$$) by
+    // the last aggregates.
+    size_t _group_by_columns = 0;
+private:
+    void finalize_grouped(query::forward_result& result);
+    bytes_opt finalize_state(size_t i, bytes_opt state);
 public:
     forward_aggregates(const query::forward_request& request);
     void merge(query::forward_result& result, query::forward_result&& other);
@@ -90,9 +100,24 @@ forward_aggregates::forward_aggregates(const query::forward_request& request) {
         aggrs.push_back(func->get_aggregate());
     }
     _aggrs = std::move(aggrs);
+    if (request.group_by_columns) {
+        _schema = local_schema_registry().get(request.cmd.schema_version);
+        _group_by_columns = request.group_by_columns->size();
+    }
 }
 
 void forward_aggregates::merge(query::forward_result &result, query::forward_result&& other) {
+    if (_schema) {
+        // Groups don't span partitions, and each partition is queried by
+        // exactly one shard, so the groups of the results are disjoint.
+        if (!result.grouped_query_results) {
+            result.grouped_query_results = std::move(other.grouped_query_results);
+        } else if (other.grouped_query_results) {
+            std::move(other.grouped_query_results->begin(), other.grouped_query_results->end(),
+                    std::back_inserter(*result.grouped_query_results));
+        }
+        return;
+    }
     if (result.query_results.empty()) {
         result.query_results = std::move(other.query_results);
         return;
@@ -116,7 +141,59 @@ void forward_aggregates::merge(query::forward_result &result, query::forward_res
     }
 }
 
+bytes_opt forward_aggregates::finalize_state(size_t i, bytes_opt state) {
+    return _aggrs[i].state_to_result_function
+        ? _aggrs[i].state_to_result_function->execute(std::vector({std::move(state)}))
+        : std::move(state);
+}
+
+// Puts the groups back in the order of a regular query, that is in ring
+// order, and finalizes their states.
+void forward_aggregates::finalize_grouped(query::forward_result& result) {
+    auto& groups = result.grouped_query_results;
+    if (!groups) {
+        groups.emplace();
+    }
+    const size_t pk_size = _schema->partition_key_size();
+    std::vector<std::pair<dht::decorated_key, std::vector<bytes_opt>>> keyed;
+    keyed.reserve(groups->size());
+    for (auto& group : *groups) {
+        if (group.size() != _aggrs.size()) {
+            on_internal_error(flogger, format("forward_aggregates::finalize(): group has {} results, expected {}",
+                    group.size(), _aggrs.size()));
+        }
+        // The partition key columns come first among the GROUP BY columns.
+        std::vector<bytes> pk;
+        pk.reserve(pk_size);
+        for (size_t i = 0; i < pk_size; ++i) {
+            auto& state = group[_aggrs.size() - _group_by_columns + i];
+            auto value = state ? get_nth_tuple_element(managed_bytes_view(*state), 0) : std::nullopt;
+            if (!value) {
+                on_internal_error(flogger, "forward_aggregates::finalize(): group with a null partition key");
+            }
+            pk.push_back(to_bytes(*value));
+        }
+        auto dk = dht::decorate_key(*_schema, partition_key::from_exploded(*_schema, pk));
+        keyed.emplace_back(std::move(dk), std::move(group));
+    }
+    // Stable, so that the groups of a partition stay in clustering order.
+    std::stable_sort(keyed.begin(), keyed.end(), [this] (const auto& a, const auto& b) {
+        return a.first.tri_compare(*_schema, b.first) < 0;
+    });
+    groups->clear();
+    for (auto& [dk, group] : keyed) {
+        for (size_t i = 0; i < _aggrs.size(); i++) {
+            group[i] = finalize_state(i, std::move(group[i]));
+        }
+        groups->push_back(std::move(group));
+    }
+}
+
 void forward_aggregates::finalize(query::forward_result &result) {
+    if (_schema) {
+        finalize_grouped(result);
+        return;
+    }
     if (result.query_results.empty()) {
         // An empty result means that we didn't send the aggregation request
         // to any node. I.e., it was a query that matched no partition, such
@@ -177,7 +254,13 @@ static std::vector<::shared_ptr<db::functions::aggregate_function>> get_function
         } else {
             auto& info = request.aggregation_infos.value()[i];
             auto types = boost::copy_range<std::vector<data_type>>(info.column_names | boost::adaptors::transformed(name_as_type));
-            
+
+            if (info.name == cql3::functions::aggregate_fcts::first_function_name() && types.size() == 1) {
+                // Internal, used for the columns of grouped aggregations, so not found by mock_get().
+                aggrs.emplace_back(cql3::functions::aggregate_fcts::make_first_function(types[0]));
+                continue;
+            }
+
             auto func = cql3::functions::functions::mock_get(info.name, types);
             if (!func) {
                 throw std::runtime_error(format("Cannot mock aggregate function {}", info.name));    
@@ -449,10 +532,25 @@ future<query::forward_result> forward_service::execute_on_this_shard(
         cql3::query_options::specific_options::DEFAULT
     );
 
+    std::vector<size_t> group_by_cell_indices;
+    if (req.group_by_columns) {
+        for (auto& name : *req.group_by_columns) {
+            auto def = schema->get_column_definition(to_bytes(name));
+            if (!def) {
+                throw std::runtime_error(format("Unknown GROUP BY column {}", name));
+            }
+            auto index = selection->index_of(*def);
+            if (index == -1) {
+                selection->add_column_for_post_processing(*def);
+                index = selection->index_of(*def);
+            }
+            group_by_cell_indices.push_back(index);
+        }
+    }
     auto rs_builder = cql3::selection::result_set_builder(
         *selection,
         now,
-        std::vector<size_t>() // Represents empty GROUP BY indices.
+        std::move(group_by_cell_indices)
     );
 
     // We serve up to 256 ranges at a time to avoid allocating a huge vector for ranges
@@ -506,6 +604,20 @@ future<query::forward_result> forward_service::execute_on_this_shard(
     co_return co_await rs_builder.with_thread_if_needed([&req, &rs_builder, reductions = req.reduction_types, tr_state = std::move(tr_state)] {
         auto rs = rs_builder.build();
         auto& rows = rs->rows();
+        if (req.group_by_columns) {
+            query::forward_result res;
+            res.grouped_query_results.emplace();
+            res.grouped_query_results->reserve(rows.size());
+            for (auto& row : rows) {
+                // Drop the GROUP BY columns added for post-processing, if any.
+                res.grouped_query_results->push_back(boost::copy_range<std::vector<bytes_opt>>(row
+                        | boost::adaptors::sliced(0, reductions.size())
+                        | boost::adaptors::transformed([] (const managed_bytes_opt& x) { return to_bytes_opt(x); })));
+            }
+            tracing::trace(tr_state, "On shard execution result has {} groups", rows.size());
+            flogger.debug("on shard execution result has {} groups", rows.size());
+            return res;
+        }
         if (rows.size() != 1) {
             flogger.error("aggregation result row count != 1");
             throw std::runtime_error("aggregation result row count != 1");
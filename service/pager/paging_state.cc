@@ -27,7 +27,9 @@ service::pager::paging_state::paging_state(partition_key pk,
         uint32_t rem_high_bits,
         uint32_t rows_fetched_for_last_partition_high_bits,
         bound_weight ck_weight,
-        partition_region region)
+        partition_region region,
+        uint32_t average_row_size,
+        uint32_t average_row_latency_ns)
     : _partition_key(std::move(pk))
     , _clustering_key(std::move(ck))
     , _remaining_low_bits(rem_low_bits)
@@ -39,6 +41,8 @@ service::pager::paging_state::paging_state(partition_key pk,
     , _rows_fetched_for_last_partition_high_bits(rows_fetched_for_last_partition_high_bits)
     , _ck_weight(ck_weight)
     , _region(region)
+    , _average_row_size(average_row_size)
+    , _average_row_latency_ns(average_row_latency_ns)
 { }
 
 service::pager::paging_state::paging_state(partition_key pk,
@@ -52,7 +56,9 @@ service::pager::paging_state::paging_state(partition_key pk,
             static_cast<uint32_t>(rows_fetched_for_last_partition), static_cast<uint32_t>(rem >> 32),
             static_cast<uint32_t>(rows_fetched_for_last_partition >> 32),
             pos.get_bound_weight(),
-            pos.region())
+            pos.region(),
+            0,
+            0)
 { }
 
 lw_shared_ptr<service::pager::paging_state> service::pager::paging_state::deserialize(
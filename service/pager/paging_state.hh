@@ -40,6 +40,10 @@ class paging_state final {
     uint32_t _rows_fetched_for_last_partition_high_bits;
     bound_weight _ck_weight = bound_weight::equal;
     partition_region _region = partition_region::partition_start;
+    // Feedback for adaptive paging: the smoothed size and fetch latency of
+    // the rows of the previous pages, 0 if unknown.
+    uint32_t _average_row_size = 0;
+    uint32_t _average_row_latency_ns = 0;
 
 public:
     // IDL ctor
@@ -53,7 +57,9 @@ class paging_state final {
             uint32_t remaining_ext,
             uint32_t rows_fetched_for_last_partition_high_bits,
             bound_weight ck_weight,
-            partition_region region);
+            partition_region region,
+            uint32_t average_row_size,
+            uint32_t average_row_latency_ns);
 
     paging_state(partition_key pk,
             position_in_partition_view pos,
@@ -79,6 +85,11 @@ class paging_state final {
         _remaining_high_bits = static_cast<uint32_t>(remaining >> 32);
     }
 
+    void set_adaptive_paging_feedback(uint32_t average_row_size, uint32_t average_row_latency_ns) {
+        _average_row_size = average_row_size;
+        _average_row_latency_ns = average_row_latency_ns;
+    }
+
     /**
      * Last processed key, i.e. where to start from in next paging round
      */
@@ -180,6 +191,22 @@ class paging_state final {
         return _query_read_repair_decision;
     }
 
+    /**
+     * Average size, in bytes, of the rows fetched so far, as measured by
+     * the adaptive paging, or 0. Older coordinators ignore it.
+     */
+    uint32_t get_average_row_size() const {
+        return _average_row_size;
+    }
+
+    /**
+     * Average time, in nanoseconds, it took to fetch a row so far, as
+     * measured by the adaptive paging, or 0.
+     */
+    uint32_t get_average_row_latency_ns() const {
+        return _average_row_latency_ns;
+    }
+
     static lw_shared_ptr<paging_state> deserialize(bytes_opt bytes);
     bytes_opt serialize() const;
 };
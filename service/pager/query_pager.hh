@@ -75,7 +75,17 @@ class query_pager {
     paging_state::replicas_per_token_range _last_replicas;
     std::optional<db::read_repair_decision> _query_read_repair_decision;
     uint64_t _rows_fetched_for_last_partition = 0;
+    // The number of rows requested for the current page, which differs from
+    // the client's page size with adaptive paging.
+    uint32_t _page_size = 0;
+    // Adaptive paging feedback, see paging_state.
+    uint32_t _average_row_size = 0;
+    uint32_t _average_row_latency_ns = 0;
+    std::chrono::steady_clock::time_point _fetch_start;
     stats _stats;
+
+    // Adaptive paging doesn't shrink pages below this many rows.
+    static constexpr uint64_t min_adaptive_page_size = 100;
 public:
     query_pager(service::storage_proxy& p, schema_ptr s, shared_ptr<const cql3::selection::selection> selection,
                 service::query_state& state,
@@ -146,7 +156,13 @@ class query_pager {
     requires query::ResultVisitor<Visitor>
     void handle_result(Visitor&& visitor,
                       const foreign_ptr<lw_shared_ptr<query::result>>& results,
-                      uint32_t page_size, gc_clock::time_point now);
+                      gc_clock::time_point now);
+
+    // The number of rows to request for the next page: the client's page
+    // size, or with adaptive paging, the number of rows expected to fit in
+    // the configured page size and latency targets.
+    uint32_t adapt_page_size(uint32_t page_size) const;
+    void update_row_statistics(const query::result& results, uint64_t row_count);
 
     virtual uint64_t max_rows_to_fetch(uint32_t page_size) {
         return std::min(_max, static_cast<uint64_t>(page_size));
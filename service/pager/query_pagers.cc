@@ -15,6 +15,7 @@
 #include "cql3/restrictions/statement_restrictions.hh"
 #include "log.hh"
 #include "service/storage_proxy.hh"
+#include "db/config.hh"
 #include "utils/to_string.hh"
 #include "utils/result_combinators.hh"
 #include "view_info.hh"
@@ -77,6 +78,8 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
         _last_replicas = state->get_last_replicas();
         _query_read_repair_decision = state->get_query_read_repair_decision();
         _rows_fetched_for_last_partition = state->get_rows_fetched_for_last_partition();
+        _average_row_size = state->get_average_row_size();
+        _average_row_latency_ns = state->get_average_row_latency_ns();
     }
 
     _cmd->is_first_page = query::is_first_page(!_query_uuid);
@@ -161,7 +164,8 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
         }
     }
 
-    auto max_rows = max_rows_to_fetch(page_size);
+    _page_size = adapt_page_size(page_size);
+    auto max_rows = max_rows_to_fetch(_page_size);
 
     // We always need PK so we can determine where to start next.
     _cmd->slice.options.set<query::partition_slice::option::send_partition_key>();
@@ -171,12 +175,14 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
                 query::partition_slice::option::send_clustering_key>();
     }
     _cmd->set_row_limit(max_rows);
-    maybe_adjust_per_partition_limit(page_size);
+    maybe_adjust_per_partition_limit(_page_size);
 
-    qlogger.debug("Fetching {}, page size={}, max_rows={}",
-            _cmd->cf_id, page_size, max_rows
+    qlogger.debug("Fetching {}, page size={}, effective page size={}, max_rows={}",
+            _cmd->cf_id, page_size, _page_size, max_rows
             );
 
+    _fetch_start = std::chrono::steady_clock::now();
+
     auto ranges = _ranges;
     auto command = ::make_lw_shared<query::read_command>(*_cmd);
     return _proxy->query_result(_schema,
@@ -186,18 +192,50 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
             {timeout, _state.get_permit(), _state.get_client_state(), _state.get_trace_state(), std::move(_last_replicas), _query_read_repair_decision});
 }
 
+uint32_t query_pager::adapt_page_size(uint32_t page_size) const {
+    const auto& cfg = _proxy->local_db().get_config();
+    if (!cfg.enable_adaptive_paging() || !_average_row_size || !_average_row_latency_ns) {
+        return page_size;
+    }
+    // As many rows as fit in both the size and the latency targets, as
+    // estimated from the rows of the previous pages.
+    uint64_t rows = (uint64_t(cfg.adaptive_paging_target_page_size_in_kb()) << 10) / _average_row_size;
+    rows = std::min(rows, uint64_t(cfg.adaptive_paging_target_page_latency_in_ms()) * 1000000 / _average_row_latency_ns);
+    // Don't make pages so small that the per-page overhead dominates.
+    const uint64_t min_rows = std::min(uint64_t(page_size), min_adaptive_page_size);
+    const uint64_t max_rows = uint64_t(page_size) * std::max(cfg.adaptive_paging_max_page_size_factor(), uint32_t(1));
+    return std::clamp(rows, min_rows, std::min(max_rows, uint64_t(std::numeric_limits<uint32_t>::max())));
+}
+
+void query_pager::update_row_statistics(const query::result& results, uint64_t row_count) {
+    if (!row_count) {
+        return;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _fetch_start).count();
+    auto to_sample = [] (uint64_t v) {
+        return uint32_t(std::clamp(v, uint64_t(1), uint64_t(std::numeric_limits<uint32_t>::max())));
+    };
+    // Exponentially weighted, so the estimates follow changes in the data
+    // without a single outlier page swinging them.
+    auto smooth = [] (uint32_t average, uint32_t sample) {
+        return average ? uint32_t((uint64_t(average) * 3 + sample) / 4) : sample;
+    };
+    _average_row_size = smooth(_average_row_size, to_sample(results.buf().size() / row_count));
+    _average_row_latency_ns = smooth(_average_row_latency_ns, to_sample(uint64_t(elapsed) / row_count));
+}
+
 future<> query_pager::fetch_page(cql3::selection::result_set_builder& builder, uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) {
     return fetch_page_result(builder, page_size, now, timeout)
             .then(utils::result_into_future<result<>>);
 }
 
 future<result<>> query_pager::fetch_page_result(cql3::selection::result_set_builder& builder, uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) {
-    return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, &builder, page_size, now] (service::storage_proxy::coordinator_query_result qr) {
+    return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, &builder, now] (service::storage_proxy::coordinator_query_result qr) {
         _last_replicas = std::move(qr.last_replicas);
         _query_read_repair_decision = qr.read_repair_decision;
-        return builder.with_thread_if_needed([this, &builder, page_size, now, qr = std::move(qr)] () mutable -> result<> {
+        return builder.with_thread_if_needed([this, &builder, now, qr = std::move(qr)] () mutable -> result<> {
             handle_result(cql3::selection::result_set_builder::visitor(builder, *_schema, *_selection),
-                          std::move(qr.query_result), page_size, now);
+                          std::move(qr.query_result), now);
             return bo::success();
         });
     }));
@@ -228,10 +266,10 @@ future<cql3::result_generator> query_pager::fetch_page_generator(uint32_t page_s
 }
 
 future<result<cql3::result_generator>> query_pager::fetch_page_generator_result(uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout, cql3::cql_stats& stats) {
-    return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, page_size, now, &stats] (service::storage_proxy::coordinator_query_result qr) -> future<result<cql3::result_generator>> {
+    return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, now, &stats] (service::storage_proxy::coordinator_query_result qr) -> future<result<cql3::result_generator>> {
         _last_replicas = std::move(qr.last_replicas);
         _query_read_repair_decision = qr.read_repair_decision;
-        handle_result(noop_visitor(), qr.query_result, page_size, now);
+        handle_result(noop_visitor(), qr.query_result, now);
         return make_ready_future<result<cql3::result_generator>>(cql3::result_generator(_schema, std::move(qr.query_result), _cmd, _selection, stats));
     }));
 }
@@ -251,15 +289,15 @@ class filtering_query_pager : public query_pager {
     virtual ~filtering_query_pager() {}
 
     virtual future<result<>> fetch_page_result(cql3::selection::result_set_builder& builder, uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) override {
-        return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, &builder, page_size, now] (service::storage_proxy::coordinator_query_result qr) {
+        return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, &builder, now] (service::storage_proxy::coordinator_query_result qr) {
             _last_replicas = std::move(qr.last_replicas);
             _query_read_repair_decision = qr.read_repair_decision;
             qr.query_result->ensure_counts();
             _stats.rows_read_total += *qr.query_result->row_count();
-            return builder.with_thread_if_needed([&builder, this, query_result = std::move(qr.query_result), page_size, now] () mutable -> result<> {
+            return builder.with_thread_if_needed([&builder, this, query_result = std::move(qr.query_result), now] () mutable -> result<> {
                 handle_result(cql3::selection::result_set_builder::visitor(builder, *_schema, *_selection,
                             cql3::selection::result_set_builder::restrictions_filter(_filtering_restrictions, _options, _max, _schema, _per_partition_limit, _last_pkey, _rows_fetched_for_last_partition)),
-                            std::move(query_result), page_size, now);
+                            std::move(query_result), now);
                 return bo::success();
             });
         }));
@@ -300,13 +338,13 @@ class ghost_row_deleting_query_pager : public service::pager::query_pager {
     virtual ~ghost_row_deleting_query_pager() {}
 
     virtual future<result<>> fetch_page_result(cql3::selection::result_set_builder& builder, uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) override {
-        return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, page_size, now] (service::storage_proxy::coordinator_query_result qr) {
+        return do_fetch_page(page_size, now, timeout).then(utils::result_wrap([this, now] (service::storage_proxy::coordinator_query_result qr) {
             _last_replicas = std::move(qr.last_replicas);
             _query_read_repair_decision = qr.read_repair_decision;
             qr.query_result->ensure_counts();
-            return seastar::async([this, query_result = std::move(qr.query_result), page_size, now] () mutable -> result<> {
+            return seastar::async([this, query_result = std::move(qr.query_result), now] () mutable -> result<> {
                 handle_result(db::view::delete_ghost_rows_visitor{_proxy, _state, view_ptr(_schema), _timeout_duration},
-                        std::move(query_result), page_size, now);
+                        std::move(query_result), now);
                 return bo::success();
             });
         }));
@@ -358,7 +396,7 @@ requires query::ResultVisitor<Visitor>
 void query_pager::handle_result(
         Visitor&& visitor,
         const foreign_ptr<lw_shared_ptr<query::result>>& results,
-        uint32_t page_size, gc_clock::time_point now) {
+        gc_clock::time_point now) {
 
     auto update_slice = [&] (const partition_key& last_pkey) {
         // refs #752, when doing aggregate queries we will re-use same
@@ -383,7 +421,7 @@ void query_pager::handle_result(
 
         row_count = v.total_rows - v.dropped_rows;
         _max = _max - row_count;
-        _exhausted = (v.total_rows < page_size && !results->is_short_read() && v.dropped_rows == 0) || _max == 0;
+        _exhausted = (v.total_rows < _page_size && !results->is_short_read() && v.dropped_rows == 0) || _max == 0;
         // If per partition limit is defined, we need to accumulate rows fetched for last partition key if the key matches
         if (_cmd->slice.partition_row_limit() < query::max_rows_if_set) {
             if (_last_pkey && v.last_pkey && _last_pkey->equal(*_schema, *v.last_pkey)) {
@@ -405,7 +443,7 @@ void query_pager::handle_result(
     } else {
         row_count = results->row_count() ? *results->row_count() : std::get<1>(view.count_partitions_and_rows());
         _max = _max - row_count;
-        _exhausted = (row_count < page_size && !results->is_short_read()) || _max == 0;
+        _exhausted = (row_count < _page_size && !results->is_short_read()) || _max == 0;
 
         if (!_exhausted) {
             if (_last_pkey) {
@@ -417,6 +455,8 @@ void query_pager::handle_result(
         }
     }
 
+    update_row_statistics(*results, row_count);
+
     qlogger.debug("Fetched {} rows, max_remain={} {}", row_count, _max, _exhausted ? "(exh)" : "");
 
     if (_last_pkey) {
@@ -428,7 +468,9 @@ void query_pager::handle_result(
 }
 
 lw_shared_ptr<const paging_state> query_pager::state() const {
-    return make_lw_shared<paging_state>(_last_pkey.value_or(partition_key::make_empty()), _last_pos, _exhausted ? 0 : _max, _cmd->query_uuid, _last_replicas, _query_read_repair_decision, _rows_fetched_for_last_partition);
+    auto state = make_lw_shared<paging_state>(_last_pkey.value_or(partition_key::make_empty()), _last_pos, _exhausted ? 0 : _max, _cmd->query_uuid, _last_replicas, _query_read_repair_decision, _rows_fetched_for_last_partition);
+    state->set_adaptive_paging_feedback(_average_row_size, _average_row_latency_ns);
+    return state;
 }
 
 }
@@ -37,6 +37,7 @@
 #include "timestamp.hh"
 #include "utils/overloaded_functor.hh"
 #include <boost/range/algorithm/transform.hpp>
+#include <seastar/coroutine/all.hh>
 #include <optional>
 #include "db/config.hh"
 
@@ -273,15 +274,21 @@ future<> group0_state_machine::transfer_snapshot(gms::inet_address from, raft::s
     slogger.trace("transfer snapshot from {} index {} snp id {}", from, snp.idx, snp.id);
     netw::messaging_service::msg_addr addr{from, 0};
     // (Ab)use MIGRATION_REQUEST to also transfer group0 history table mutation besides schema tables mutations.
-    auto [_, cm] = co_await _mm._messaging.send_migration_request(addr, netw::schema_pull_options { .group0_snapshot_transfer = true });
+    // The schema and the topology are independent, pull them concurrently.
+    auto [schema, topology_snp] = co_await coroutine::all(
+        [&] {
+            return _mm._messaging.send_migration_request(addr, netw::schema_pull_options { .group0_snapshot_transfer = true });
+        },
+        [&] {
+            return ser::storage_service_rpc_verbs::send_raft_pull_topology_snapshot(&_mm._messaging, addr, service::raft_topology_pull_params{});
+        });
+    auto& [_, cm] = schema;
     if (!cm) {
         // If we're running this code then remote supports Raft group 0, so it should also support canonical mutations
         // (which were introduced a long time ago).
         on_internal_error(slogger, "Expected MIGRATION_REQUEST to return canonical mutations");
     }
 
-    auto topology_snp = co_await ser::storage_service_rpc_verbs::send_raft_pull_topology_snapshot(&_mm._messaging, addr, service::raft_topology_pull_params{});
-
     auto history_mut = extract_history_mutation(*cm, _sp.data_dictionary());
 
     // TODO ensure atomicity of snapshot application in presence of crashes (see TODO in `apply`)
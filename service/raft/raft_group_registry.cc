@@ -68,6 +68,58 @@ class direct_fd_proxy : public raft::failure_detector, public direct_failure_det
 };
 // }}} direct_fd_proxy
 
+// {{{ direct_fd_dead_nodes
+
+// Tracks the nodes which the direct failure detector found dead with an adaptive threshold,
+// so that storage_proxy stops picking them as replicas without waiting for gossip to mark them down.
+class direct_fd_dead_nodes : public direct_failure_detector::listener {
+    const raft_address_map& _address_map;
+    // The addresses of the servers when they were marked alive or dead.
+    std::unordered_map<raft::server_id, gms::inet_address> _alive;
+    std::unordered_map<raft::server_id, gms::inet_address> _dead;
+    // The addresses of the dead servers not shared with an alive one, e.g. after a replace with the same IP.
+    std::unordered_set<gms::inet_address> _dead_addresses;
+
+    void update_dead_addresses() {
+        _dead_addresses.clear();
+        for (auto& [_, addr] : _dead) {
+            _dead_addresses.insert(addr);
+        }
+        for (auto& [_, addr] : _alive) {
+            _dead_addresses.erase(addr);
+        }
+    }
+
+    void mark(raft::server_id id, bool alive) {
+        _alive.erase(id);
+        _dead.erase(id);
+        if (auto addr = _address_map.find(id)) {
+            (alive ? _alive : _dead).emplace(id, *addr);
+        }
+        update_dead_addresses();
+    }
+
+public:
+    explicit direct_fd_dead_nodes(const raft_address_map& address_map) : _address_map(address_map) {}
+
+    future<> mark_alive(direct_failure_detector::pinger::endpoint_id id) override {
+        mark(raft::server_id{id}, true);
+        co_return;
+    }
+
+    future<> mark_dead(direct_failure_detector::pinger::endpoint_id id) override {
+        auto raft_id = raft::server_id{id};
+        rslog.debug("marking Raft server {} as dead for replica selection", raft_id);
+        mark(raft_id, false);
+        co_return;
+    }
+
+    bool is_dead(const gms::inet_address& addr) const {
+        return _dead_addresses.contains(addr);
+    }
+};
+// }}} direct_fd_dead_nodes
+
 // {{{ gossiper_state_change_subscriber_proxy
 
 class gossiper_state_change_subscriber_proxy: public gms::i_endpoint_state_change_subscriber {
@@ -136,7 +188,8 @@ class gossiper_state_change_subscriber_proxy: public gms::i_endpoint_state_chang
 // }}} gossiper_state_change_subscriber_proxy
 
 raft_group_registry::raft_group_registry(bool is_enabled, raft_address_map& address_map,
-        netw::messaging_service& ms, gms::gossiper& gossiper, direct_failure_detector::failure_detector& fd)
+        netw::messaging_service& ms, gms::gossiper& gossiper, direct_failure_detector::failure_detector& fd,
+        std::chrono::milliseconds dead_nodes_min_threshold)
     : _is_enabled(is_enabled)
     , _ms(ms)
     , _gossiper(gossiper)
@@ -144,9 +197,20 @@ raft_group_registry::raft_group_registry(bool is_enabled, raft_address_map& addr
     , _address_map{address_map}
     , _direct_fd(fd)
     , _direct_fd_proxy(make_shared<direct_fd_proxy>())
+    , _direct_fd_dead_nodes(std::make_unique<direct_fd_dead_nodes>(address_map))
+    , _dead_nodes_min_threshold(dead_nodes_min_threshold)
+    , _ticker([this] { tick_servers(); })
 {
 }
 
+void raft_group_registry::tick_servers() {
+    for (auto& [gid, grp] : _servers) {
+        if (!grp.aborted) {
+            grp.server->tick();
+        }
+    }
+}
+
 void raft_group_registry::init_rpc_verbs() {
     auto handle_raft_rpc = [this] (
             const rpc::client_info& cinfo,
@@ -311,6 +375,7 @@ static void ensure_aborted(raft_server_for_group& server_for_group, sstring reas
 }
 
 future<> raft_group_registry::stop_servers() noexcept {
+    _ticker.cancel();
     gate g;
     for (auto it = _servers.begin(); it != _servers.end(); it = _servers.erase(it)) {
         ensure_aborted(it->second, "raft group registry is stopped");
@@ -336,6 +401,16 @@ seastar::future<> raft_group_registry::start(raft::server_id my_id) {
 
     _direct_fd_subscription.emplace(co_await _direct_fd.register_listener(*_direct_fd_proxy,
         direct_fd_clock::base::duration{std::chrono::seconds{1}}.count()));
+
+    // Read replica selection reacts faster than Raft, as long as the pings are regular enough for
+    // the adaptive threshold to be confident. Falsely suspected nodes are only avoided as
+    // replicas until they respond again.
+    _direct_fd_dead_nodes_subscription.emplace(co_await _direct_fd.register_listener(*_direct_fd_dead_nodes,
+        direct_fd_clock::base::duration{std::chrono::seconds{1}}.count(),
+        direct_failure_detector::adaptive_threshold{
+            .phi = 8,
+            .min_threshold = std::chrono::duration_cast<direct_fd_clock::base::duration>(_dead_nodes_min_threshold).count(),
+        }));
 }
 
 const raft::server_id& raft_group_registry::get_my_raft_id() {
@@ -352,6 +427,7 @@ seastar::future<> raft_group_registry::stop() {
     co_await drain_on_shutdown();
     co_await uninit_rpc_verbs();
     _direct_fd_subscription.reset();
+    _direct_fd_dead_nodes_subscription.reset();
     co_await _gossiper.unregister_(_gossiper_proxy);
 }
 
@@ -411,7 +487,7 @@ future<> raft_group_registry::start_server_for_group(raft_server_for_group new_g
     }
 
     try {
-        // start the server instance prior to arming the ticker timer.
+        // start the server instance prior to adding it to the ticked servers.
         // By the time the tick() is executed the server should already be initialized.
         co_await new_grp.server->start();
         new_grp.server->register_metrics();
@@ -424,13 +500,15 @@ future<> raft_group_registry::start_server_for_group(raft_server_for_group new_g
     raft::server& server = *new_grp.server;
 
     try {
-        auto [it, inserted] = _servers.emplace(std::move(gid), std::move(new_grp));
+        _servers.emplace(std::move(gid), std::move(new_grp));
 
         if (_servers.size() == 1 && this_shard_id() == 0) {
             _group0_id = gid;
         }
 
-        it->second.ticker->arm_periodic(raft_tick_interval);
+        if (!_ticker.armed()) {
+            _ticker.arm_periodic(raft_tick_interval);
+        }
     } catch (...) {
         ex = std::current_exception();
     }
@@ -458,6 +536,10 @@ shared_ptr<raft::failure_detector> raft_group_registry::failure_detector() {
     return _direct_fd_proxy;
 }
 
+bool raft_group_registry::is_detected_dead(const gms::inet_address& addr) const {
+    return _is_enabled && _direct_fd_dead_nodes->is_dead(addr);
+}
+
 raft_group_registry::~raft_group_registry() = default;
 
 future<bool> direct_fd_pinger::ping(direct_failure_detector::pinger::endpoint_id id, abort_source& as) {
@@ -16,6 +16,7 @@
 #include "raft/server.hh"
 #include "utils/recent_entries_map.hh"
 #include "direct_failure_detector/failure_detector.hh"
+#include "gms/inet_address.hh"
 #include "service/raft/group0_fwd.hh"
 
 namespace gms {
@@ -49,7 +50,6 @@ struct raft_destination_id_not_correct: public raft::error {
 struct raft_server_for_group {
     raft::group_id gid;
     std::unique_ptr<raft::server> server;
-    std::unique_ptr<raft_ticker_type> ticker;
     raft_rpc& rpc;
     raft_sys_table_storage& persistence;
     std::optional<seastar::future<>> aborted;
@@ -57,6 +57,7 @@ struct raft_server_for_group {
 
 class direct_fd_pinger;
 class direct_fd_proxy;
+class direct_fd_dead_nodes;
 class gossiper_state_change_subscriber_proxy;
 
 // This class is responsible for creating, storing and accessing raft servers.
@@ -74,8 +75,7 @@ class raft_group_registry : public seastar::peering_sharded_service<raft_group_r
     // A proxy class representing subscription to on_change
     // events, and updating the address map on this events.
     shared_ptr<gossiper_state_change_subscriber_proxy> _gossiper_proxy;
-    // Raft servers along with the corresponding timers to tick each instance.
-    // Currently ticking every 100ms.
+    // Raft servers of this shard
     std::unordered_map<raft::group_id, raft_server_for_group> _servers;
     // inet_address:es for remote raft servers known to us
     raft_address_map& _address_map;
@@ -86,8 +86,18 @@ class raft_group_registry : public seastar::peering_sharded_service<raft_group_r
     seastar::shared_ptr<direct_fd_proxy> _direct_fd_proxy;
     // Direct failure detector listener subscription for `_direct_fd_proxy`.
     std::optional<direct_failure_detector::subscription> _direct_fd_subscription;
+    // Listens to notifications from direct failure detector with an adaptive threshold, see `is_detected_dead`.
+    std::unique_ptr<direct_fd_dead_nodes> _direct_fd_dead_nodes;
+    std::optional<direct_failure_detector::subscription> _direct_fd_dead_nodes_subscription;
+    std::chrono::milliseconds _dead_nodes_min_threshold;
+    // Ticks all servers every raft_tick_interval. Sharing the timer aligns
+    // the ticks of all groups, so the heartbeats they send to the same node
+    // go out together and are coalesced by the connection's output batching,
+    // instead of each group waking up the reactor at its own phase.
+    raft_ticker_type _ticker;
 
     void init_rpc_verbs();
+    void tick_servers();
     seastar::future<> uninit_rpc_verbs();
     seastar::future<> stop_servers() noexcept;
 
@@ -107,8 +117,10 @@ class raft_group_registry : public seastar::peering_sharded_service<raft_group_r
 
 public:
     // `is_enabled` must be `true` iff the local RAFT feature is enabled.
+    // `dead_nodes_min_threshold` is the lower bound of the adaptive threshold of `is_detected_dead`.
     raft_group_registry(bool is_enabled, raft_address_map&,
-            netw::messaging_service& ms, gms::gossiper& gs, direct_failure_detector::failure_detector& fd);
+            netw::messaging_service& ms, gms::gossiper& gs, direct_failure_detector::failure_detector& fd,
+            std::chrono::milliseconds dead_nodes_min_threshold);
     ~raft_group_registry();
 
     // If is_enabled(),
@@ -141,12 +153,15 @@ class raft_group_registry : public seastar::peering_sharded_service<raft_group_r
     // after boot/upgrade is complete
     raft::server& group0();
 
-    // Start raft server instance, store in the map of raft servers and
-    // arm the associated timer to tick the server.
+    // Start raft server instance and store in the map of raft servers,
+    // from then on it is ticked with the other servers.
     future<> start_server_for_group(raft_server_for_group grp);
     void abort_server(raft::group_id gid, sstring reason = "");
     unsigned shard_for_group(const raft::group_id& gid) const;
     shared_ptr<raft::failure_detector> failure_detector();
+    // Whether the direct failure detector found the node with this address dead, after it was alive.
+    // Uses an adaptive threshold which detects failures faster than gossip, to stop picking the node as a read replica.
+    bool is_detected_dead(const gms::inet_address& addr) const;
     raft_address_map& address_map() { return _address_map; }
     direct_failure_detector::failure_detector& direct_fd() { return _direct_fd; }
 
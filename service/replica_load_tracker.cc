@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "service/replica_load_tracker.hh"
+
+#include <algorithm>
+
+namespace service {
+
+// Weight of the newest sample in the smoothed latency.
+static constexpr double latency_alpha = 0.25;
+
+void replica_load_tracker::on_request_sent(gms::inet_address ep) noexcept {
+    ++_loads[ep].in_flight;
+}
+
+void replica_load_tracker::on_request_completed(gms::inet_address ep, clock::duration latency, clock::time_point now) noexcept {
+    auto it = _loads.find(ep);
+    if (it == _loads.end()) {
+        return;
+    }
+    auto& load = it->second;
+    if (load.in_flight) {
+        --load.in_flight;
+    }
+    const double sample = std::chrono::duration<double, std::micro>(latency).count();
+    if (!load.latency_us || now - load.last_updated > stale_after) {
+        load.latency_us = sample;
+    } else {
+        load.latency_us += latency_alpha * (sample - load.latency_us);
+    }
+    load.last_updated = now;
+    load.latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+}
+
+double replica_load_tracker::score(gms::inet_address ep, clock::time_point now) const noexcept {
+    auto it = _loads.find(ep);
+    if (it == _loads.end()) {
+        return 0;
+    }
+    auto& load = it->second;
+    if (!load.in_flight && now - load.last_updated > stale_after) {
+        // Either unknown or too old to be trusted.
+        return 0;
+    }
+    // A replica that stalls stops completing requests, but its queue keeps
+    // growing, so it is still penalized even with no recent measurements.
+    const double queue = 1 + load.in_flight;
+    return std::max(load.latency_us, 1.0) * queue * queue * queue;
+}
+
+void replica_load_tracker::rank(inet_address_vector_replica_set::iterator begin, inet_address_vector_replica_set::iterator end,
+        clock::time_point now) const {
+    if (std::distance(begin, end) < 2) {
+        return;
+    }
+    std::stable_sort(begin, end, [&] (gms::inet_address a, gms::inet_address b) {
+        return score(a, now) < score(b, now);
+    });
+}
+
+uint32_t replica_load_tracker::in_flight(gms::inet_address ep) const noexcept {
+    auto it = _loads.find(ep);
+    return it == _loads.end() ? 0 : it->second.in_flight;
+}
+
+std::optional<std::chrono::microseconds> replica_load_tracker::latency_percentile(gms::inet_address ep, double percentile,
+        clock::time_point now) {
+    auto it = _loads.find(ep);
+    if (it == _loads.end()) {
+        return std::nullopt;
+    }
+    auto& load = it->second;
+    if (load.cached_percentile != percentile || now - load.percentile_cache_timestamp > std::chrono::seconds(1)) {
+        load.percentile_cache_timestamp = now;
+        load.cached_percentile = percentile;
+        if (load.latencies.count() < min_percentile_samples) {
+            load.cached_percentile_value = std::chrono::microseconds(0);
+        } else {
+            load.cached_percentile_value = std::chrono::microseconds(std::max(load.latencies.percentile(percentile), int64_t(1)));
+            load.latencies *= 0.9; // decay values a little to give new data points more weight
+        }
+    }
+    if (!load.cached_percentile_value.count()) {
+        return std::nullopt;
+    }
+    return load.cached_percentile_value;
+}
+
+} // namespace service
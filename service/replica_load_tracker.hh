@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+#include "gms/inet_address.hh"
+#include "inet_address_vectors.hh"
+#include "utils/estimated_histogram.hh"
+
+namespace service {
+
+/// Tracks, per replica, the recent latency of the reads this coordinator
+/// shard sent to it and the number of its reads still in flight, to rank
+/// replicas for reads, in the spirit of C3.
+///
+/// A replica is scored by its smoothed response time multiplied by the cube
+/// of its queue size, as seen by this coordinator, so that a replica which
+/// stalls (e.g. in a GC pause or under heavy compaction) loses its reads
+/// quickly and reads spread over replicas in proportion to their speed.
+///
+/// Measurements older than stale_after are ignored for replicas with no
+/// reads in flight, so that a replica that was slow once gets probed again
+/// instead of being avoided forever.
+///
+/// The latencies of each replica are also kept in a histogram, for the
+/// ADAPTIVE speculative retry to wait for as long as the replica read from
+/// usually takes, rather than the table's latency over all replicas.
+class replica_load_tracker {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::seconds stale_after{2};
+
+private:
+    struct replica_load {
+        // Smoothed response time, in microseconds, 0 if unknown.
+        double latency_us = 0;
+        // Requests sent and not completed yet.
+        uint32_t in_flight = 0;
+        clock::time_point last_updated;
+        // Latencies in microseconds, decayed as percentiles are computed.
+        utils::estimated_histogram latencies;
+        double cached_percentile = 0;
+        std::chrono::microseconds cached_percentile_value{0};
+        clock::time_point percentile_cache_timestamp;
+    };
+    std::unordered_map<gms::inet_address, replica_load> _loads;
+
+public:
+    void on_request_sent(gms::inet_address ep) noexcept;
+
+    /// Accounts the completion of a request sent to \p ep. Failed requests
+    /// count with their latency too, for timeouts to penalize the replica.
+    void on_request_completed(gms::inet_address ep, clock::duration latency, clock::time_point now = clock::now()) noexcept;
+
+    /// The lower the better. Idle replicas with no recent measurements score 0.
+    double score(gms::inet_address ep, clock::time_point now = clock::now()) const noexcept;
+
+    /// Stable-sorts the replicas in [begin, end) by score.
+    void rank(inet_address_vector_replica_set::iterator begin, inet_address_vector_replica_set::iterator end,
+            clock::time_point now = clock::now()) const;
+
+    uint32_t in_flight(gms::inet_address ep) const noexcept;
+
+    /// The latency of \p ep at \p percentile (in [0, 1]), or std::nullopt if
+    /// there are not enough samples for it to be meaningful.
+    ///
+    /// Cached for a second, like table::get_coordinator_read_latency_percentile().
+    std::optional<std::chrono::microseconds> latency_percentile(gms::inet_address ep, double percentile,
+            clock::time_point now = clock::now());
+
+    /// The samples needed for latency_percentile() to return a value.
+    static constexpr int64_t min_percentile_samples = 20;
+};
+
+/// Limits the extra requests (e.g. speculative reads) to a fraction of the
+/// requests, so that retries don't amplify an overload: each request
+/// deposits the fraction into the budget and each retry spends a whole one.
+///
+/// Up to max_balance unspent retries accumulate, to absorb short bursts.
+class retry_budget {
+public:
+    static constexpr double max_balance = 10;
+
+private:
+    double _balance = max_balance;
+
+public:
+    /// Accounts for a request, allowing \p ratio (in [0, 1]) extra ones.
+    void on_request(double ratio) noexcept {
+        _balance = std::min(_balance + ratio, max_balance);
+    }
+
+    /// Returns whether a retry is allowed, spending it if it is.
+    bool try_spend() noexcept {
+        if (_balance < 1) {
+            return false;
+        }
+        _balance -= 1;
+        return true;
+    }
+
+    double balance() const noexcept {
+        return _balance;
+    }
+};
+
+} // namespace service
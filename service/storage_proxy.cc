@@ -10,6 +10,7 @@
 
 #include <random>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/util/defer.hh>
 #include "partition_range_compat.hh"
 #include "db/consistency_level.hh"
@@ -72,10 +73,14 @@
 #include "service/paxos/proposal.hh"
 #include "locator/token_metadata.hh"
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/later.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/with_scheduling_group.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/as_future.hh>
 #include <seastar/coroutine/all.hh>
 #include "locator/abstract_replication_strategy.hh"
+#include "locator/tablets.hh"
 #include "service/paxos/cas_request.hh"
 #include "mutation/mutation_partition_view.hh"
 #include "service/paxos/paxos_state.hh"
@@ -157,20 +162,43 @@ class storage_proxy::remote {
     netw::messaging_service& _ms;
     const gms::gossiper& _gossiper;
     migration_manager& _mm;
+    const raft_group_registry& _raft_gr;
 
     netw::connection_drop_slot_t _connection_dropped;
     netw::connection_drop_registration_t _condrop_registration;
 
+    // Mutations waiting for write_batching_window_in_us to be sent to a
+    // replica in a single MUTATION_BATCH message, see send_mutation_batched().
+    // Keyed by replica shard, which is always 0 unless internode connections
+    // are shard-aware, see replica_shard_of().
+    struct mutation_batch {
+        std::vector<frozen_mutation> mutations;
+        std::vector<uint64_t> response_ids;
+        std::vector<db::per_partition_rate_limit::info> rate_limit_infos;
+        // The earliest of the mutations' timeouts.
+        storage_proxy::clock_type::time_point timeout = storage_proxy::clock_type::time_point::max();
+        fencing_token fence;
+        size_t size = 0;
+        shared_promise<> sent;
+    };
+    std::unordered_map<netw::msg_addr, std::unique_ptr<mutation_batch>, netw::msg_addr::shard_hash, netw::msg_addr::shard_equal> _mutation_batches;
+    timer<> _mutation_batches_timer;
+
+    static constexpr size_t max_mutation_batch_count = 64;
+    static constexpr size_t max_mutation_batch_size = 256 * 1024;
+
     bool _stopped{false};
 
 public:
-    remote(storage_proxy& sp, netw::messaging_service& ms, gms::gossiper& g, migration_manager& mm)
-        : _sp(sp), _ms(ms), _gossiper(g), _mm(mm)
+    remote(storage_proxy& sp, netw::messaging_service& ms, gms::gossiper& g, migration_manager& mm, const raft_group_registry& raft_gr)
+        : _sp(sp), _ms(ms), _gossiper(g), _mm(mm), _raft_gr(raft_gr)
         , _connection_dropped(std::bind_front(&remote::connection_dropped, this))
         , _condrop_registration(_ms.when_connection_drops(_connection_dropped))
+        , _mutation_batches_timer([this] { flush_mutation_batches(); })
     {
         ser::storage_proxy_rpc_verbs::register_counter_mutation(&_ms, std::bind_front(&remote::handle_counter_mutation, this));
         ser::storage_proxy_rpc_verbs::register_mutation(&_ms, std::bind_front(&remote::receive_mutation_handler, this, _sp._write_smp_service_group));
+        ser::storage_proxy_rpc_verbs::register_mutation_batch(&_ms, std::bind_front(&remote::handle_mutation_batch, this));
         ser::storage_proxy_rpc_verbs::register_hint_mutation(&_ms, [this] <typename... Args>(Args&&... args) { return receive_mutation_handler(_sp._hints_write_smp_service_group, std::forward<Args>(args)..., std::monostate(), rpc::optional<fencing_token>{}); });
         ser::storage_proxy_rpc_verbs::register_paxos_learn(&_ms, std::bind_front(&remote::handle_paxos_learn, this));
         ser::storage_proxy_rpc_verbs::register_mutation_done(&_ms, std::bind_front(&remote::handle_mutation_done, this));
@@ -178,6 +206,7 @@ class storage_proxy::remote {
         ser::storage_proxy_rpc_verbs::register_read_data(&_ms, std::bind_front(&remote::handle_read_data, this));
         ser::storage_proxy_rpc_verbs::register_read_mutation_data(&_ms, std::bind_front(&remote::handle_read_mutation_data, this));
         ser::storage_proxy_rpc_verbs::register_read_digest(&_ms, std::bind_front(&remote::handle_read_digest, this));
+        ser::storage_proxy_rpc_verbs::register_read_abort(&_ms, std::bind_front(&remote::handle_read_abort, this));
         ser::storage_proxy_rpc_verbs::register_truncate(&_ms, std::bind_front(&remote::handle_truncate, this));
         // Register PAXOS verb handlers
         ser::storage_proxy_rpc_verbs::register_paxos_prepare(&_ms, std::bind_front(&remote::handle_paxos_prepare, this));
@@ -191,6 +220,8 @@ class storage_proxy::remote {
 
     // Must call before destroying the `remote` object.
     future<> stop() {
+        _mutation_batches_timer.cancel();
+        flush_mutation_batches();
         co_await ser::storage_proxy_rpc_verbs::unregister(&_ms);
         _stopped = true;
     }
@@ -203,6 +234,11 @@ class storage_proxy::remote {
         return _gossiper.is_alive(ep);
     }
 
+    // The direct failure detector notices dead nodes before gossip does.
+    bool is_suspected_dead(const gms::inet_address& ep) const {
+        return _raft_gr.is_detected_dead(ep);
+    }
+
     // Note: none of the `send_*` functions use `remote` after yielding - by the first yield,
     // control is delegated to another service (messaging_service). Thus unfinished `send`s
     // do not make it unsafe to destroy the `remote` object.
@@ -221,6 +257,77 @@ class storage_proxy::remote {
                 response_id, trace_info, rate_limit_info, fence);
     }
 
+    // Like send_mutation(), but may delay the mutation for up to
+    // write_batching_window_in_us, to send it to the replica together with
+    // the other mutations sent to it in the meantime. The replica still
+    // responds to each of them separately.
+    //
+    // Mutations which are forwarded or traced are sent right away, as are
+    // those to replicas that don't support MUTATION_BATCH.
+    future<> send_mutation_batched(
+            netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, const std::optional<tracing::trace_info>& trace_info,
+            const frozen_mutation& m, const inet_address_vector_replica_set& forward, gms::inet_address reply_to, unsigned shard,
+            storage_proxy::response_id_type response_id, db::per_partition_rate_limit::info rate_limit_info,
+            fencing_token fence) {
+        const auto window = std::chrono::microseconds(_sp._db.local().get_config().write_batching_window_in_us());
+        if (!window.count() || !forward.empty() || trace_info || !_sp.features().mutation_batch) {
+            return send_mutation(std::move(addr), timeout, trace_info, m, forward, reply_to, shard, response_id, rate_limit_info, fence);
+        }
+        auto it = _mutation_batches.find(addr);
+        if (it != _mutation_batches.end() && it->second->fence != fence) {
+            flush_mutation_batch(addr);
+            it = _mutation_batches.end();
+        }
+        if (it == _mutation_batches.end()) {
+            it = _mutation_batches.emplace(addr, std::make_unique<mutation_batch>()).first;
+            it->second->fence = fence;
+        }
+        auto& batch = *it->second;
+        // The batch needs its own copy, as it outlives the caller's one.
+        batch.mutations.push_back(m);
+        batch.response_ids.push_back(response_id);
+        batch.rate_limit_infos.push_back(rate_limit_info);
+        batch.timeout = std::min(batch.timeout, timeout);
+        batch.size += m.representation().size();
+        auto f = batch.sent.get_shared_future();
+        if (batch.mutations.size() >= max_mutation_batch_count || batch.size >= max_mutation_batch_size) {
+            flush_mutation_batch(addr);
+        } else if (!_mutation_batches_timer.armed()) {
+            _mutation_batches_timer.arm(window);
+        }
+        return f;
+    }
+
+    void flush_mutation_batch(netw::msg_addr addr) {
+        auto node = _mutation_batches.extract(addr);
+        if (!node) {
+            return;
+        }
+        auto batch = std::move(node.mapped());
+        auto& stats = _sp.get_stats();
+        stats.batched_mutations += batch->mutations.size();
+        ++stats.mutation_batches;
+        // All mutations are sent by this shard, so they share the reply address.
+        auto f = ser::storage_proxy_rpc_verbs::send_mutation_batch(
+                &_ms, addr, batch->timeout,
+                batch->mutations, utils::fb_utilities::get_broadcast_address(), this_shard_id(),
+                batch->response_ids, batch->rate_limit_infos, batch->fence);
+        // Waited on by the senders of each mutation, via batch->sent.
+        (void)f.then_wrapped([batch = std::move(batch)] (future<> f) {
+            if (f.failed()) {
+                batch->sent.set_exception(f.get_exception());
+            } else {
+                batch->sent.set_value();
+            }
+        });
+    }
+
+    void flush_mutation_batches() {
+        while (!_mutation_batches.empty()) {
+            flush_mutation_batch(_mutation_batches.begin()->first);
+        }
+    }
+
     future<> send_hint_mutation(
             netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
             const frozen_mutation& m, const inet_address_vector_replica_set& forward, gms::inet_address reply_to, unsigned shard,
@@ -243,11 +350,11 @@ class storage_proxy::remote {
 
     future<> send_mutation_done(
             netw::msg_addr addr, tracing::trace_state_ptr tr_state,
-            unsigned shard, uint64_t response_id, db::view::update_backlog backlog) {
+            unsigned shard, uint64_t response_id, db::view::update_backlog backlog, db::view::update_backlog table_backlog) {
         tracing::trace(tr_state, "Sending mutation_done to /{}", addr.addr);
         return ser::storage_proxy_rpc_verbs::send_mutation_done(
                 &_ms, std::move(addr),
-                shard, response_id, std::move(backlog));
+                shard, response_id, std::move(backlog), std::move(table_backlog));
     }
 
     future<> send_mutation_failed(
@@ -343,6 +450,10 @@ class storage_proxy::remote {
         return ser::storage_proxy_rpc_verbs::send_paxos_prune(&_ms, addr, timeout, schema_id, key, ballot, tracing::make_trace_info(tr_state));
     }
 
+    future<> send_read_abort(netw::msg_addr addr, query_id query_uuid) {
+        return ser::storage_proxy_rpc_verbs::send_read_abort(&_ms, std::move(addr), query_uuid);
+    }
+
     future<> send_truncate_blocking(sstring keyspace, sstring cfname, std::optional<std::chrono::milliseconds> timeout_in_ms) {
         slogger.debug("Starting a blocking truncate operation on keyspace {}, CF {}", keyspace, cfname);
 
@@ -461,6 +572,7 @@ class storage_proxy::remote {
                     try {
                         // FIXME: get_schema_for_write() doesn't timeout
                         schema_ptr s = co_await get_schema_for_write(schema_version, netw::messaging_service::msg_addr{reply_to, shard}, timeout);
+                        auto cf_id = s->id();
                         // Note: blocks due to execution_stage in replica::database::apply()
                         co_await apply_fn(p, trace_state_ptr, std::move(s), m, timeout, fence);
                         // We wait for send_mutation_done to complete, otherwise, if reply_to is busy, we will accumulate
@@ -469,7 +581,7 @@ class storage_proxy::remote {
                         // Usually we will return immediately, since this work only involves appending data to the connection
                         // send buffer.
                         auto f = co_await coroutine::as_future(send_mutation_done(netw::messaging_service::msg_addr{reply_to, shard}, trace_state_ptr,
-                                shard, response_id, p->get_view_update_backlog()));
+                                shard, response_id, p->get_view_update_backlog(), p->get_view_update_backlog_of(cf_id)));
                         f.ignore_ready_future();
                     } catch (...) {
                         std::exception_ptr eptr = std::current_exception();
@@ -543,6 +655,23 @@ class storage_proxy::remote {
                 });
     }
 
+    future<rpc::no_wait_type> handle_mutation_batch(
+            const rpc::client_info& cinfo, rpc::opt_time_point t,
+            std::vector<frozen_mutation> fms, gms::inet_address reply_to, unsigned shard,
+            std::vector<uint64_t> response_ids, std::vector<db::per_partition_rate_limit::info> rate_limit_infos,
+            fencing_token fence) {
+        if (response_ids.size() != fms.size() || rate_limit_infos.size() != fms.size()) {
+            on_internal_error(slogger, format("mutation_batch from {}: {} mutations, {} response ids and {} rate limit infos",
+                    reply_to, fms.size(), response_ids.size(), rate_limit_infos.size()));
+        }
+        // Each mutation is handled, and responded to, as if it was received in its own message.
+        co_await coroutine::parallel_for_each(boost::irange(size_t(0), fms.size()), [&] (size_t i) -> future<> {
+            co_await receive_mutation_handler(_sp._write_smp_service_group, cinfo, t, std::move(fms[i]), inet_address_vector_replica_set{},
+                    reply_to, shard, response_ids[i], std::optional<tracing::trace_info>(), rate_limit_infos[i], fence);
+        });
+        co_return netw::messaging_service::no_wait();
+    }
+
     future<rpc::no_wait_type> handle_paxos_learn(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
             paxos::proposal decision, inet_address_vector_replica_set forward, gms::inet_address reply_to, unsigned shard,
@@ -567,12 +696,13 @@ class storage_proxy::remote {
 
     future<rpc::no_wait_type> handle_mutation_done(
             const rpc::client_info& cinfo,
-            unsigned shard, storage_proxy::response_id_type response_id, rpc::optional<db::view::update_backlog> backlog) {
+            unsigned shard, storage_proxy::response_id_type response_id, rpc::optional<db::view::update_backlog> backlog,
+            rpc::optional<db::view::update_backlog> table_backlog) {
         auto& from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
         _sp.get_stats().replica_cross_shard_ops += shard != this_shard_id();
         return _sp.container().invoke_on(shard, _sp._write_ack_smp_service_group,
-                [from, response_id, backlog = std::move(backlog)] (storage_proxy& sp) mutable {
-            sp.got_response(response_id, from, std::move(backlog));
+                [from, response_id, backlog = std::move(backlog), table_backlog = std::move(table_backlog)] (storage_proxy& sp) mutable {
+            sp.got_response(response_id, from, std::move(backlog), std::move(table_backlog));
             return netw::messaging_service::no_wait();
         });
     }
@@ -731,6 +861,14 @@ class storage_proxy::remote {
             std::move(pr), oda, rate_limit_info_opt, fence);
     }
 
+    future<rpc::no_wait_type> handle_read_abort(const rpc::client_info& cinfo, query_id query_uuid) {
+        slogger.trace("read_abort: query {} from {}", query_uuid, netw::messaging_service::get_source(cinfo).addr);
+        co_await _sp._db.invoke_on_all([query_uuid] (replica::database& db) {
+            db.abort_reads(query_uuid);
+        });
+        co_return netw::messaging_service::no_wait();
+    }
+
     future<> handle_truncate(rpc::opt_time_point timeout, sstring ksname, sstring cfname) {
         return replica::database::truncate_table_on_all_shards(_sp._db, ksname, cfname);
     }
@@ -855,6 +993,9 @@ using fbu = utils::fb_utilities;
 
 static inline
 query::digest_algorithm digest_algorithm(service::storage_proxy& proxy) {
+    if (proxy.features().xxhash3_digest) {
+        return query::digest_algorithm::xxHash3;
+    }
     return proxy.features().digest_for_null_values
             ? query::digest_algorithm::xxHash
             : query::digest_algorithm::legacy_xxHash_without_null_digest;
@@ -928,13 +1069,16 @@ class mutation_holder {
 protected:
     size_t _size = 0;
     schema_ptr _schema;
+    // The token of the partition written to, for the mutation to be sent
+    // to the shard owning it with shard-aware internode connections.
+    std::optional<dht::token> _routing_token;
 public:
     virtual ~mutation_holder() {}
     virtual bool store_hint(db::hints::manager& hm, gms::inet_address ep, tracing::trace_state_ptr tr_state) = 0;
     virtual future<> apply_locally(storage_proxy& sp, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) = 0;
-    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, const inet_address_vector_replica_set& forward,
+    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, unsigned ep_shard, const inet_address_vector_replica_set& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) = 0;
@@ -945,6 +1089,9 @@ class mutation_holder {
     const schema_ptr& schema() {
         return _schema;
     }
+    const std::optional<dht::token>& routing_token() const {
+        return _routing_token;
+    }
     // called only when all replicas replied
     virtual void release_mutation() = 0;
     // called when reply is received
@@ -963,6 +1110,7 @@ class per_destination_mutation : public mutation_holder {
             if (m.second) {
                 _schema = m.second.value().schema();
                 _token = m.second.value().token();
+                _routing_token = _token;
                 fm = make_lw_shared<const frozen_mutation>(freeze(m.second.value()));
                 _size += fm->representation().size();
             }
@@ -988,17 +1136,17 @@ class per_destination_mutation : public mutation_holder {
         }
         return make_ready_future<>();
     }
-    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, const inet_address_vector_replica_set& forward,
+    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, unsigned ep_shard, const inet_address_vector_replica_set& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info, fencing_token fence) override {
         auto m = _mutations[ep];
         if (m) {
             tracing::trace(tr_state, "Sending a mutation to /{}", ep);
-            return sp.remote().send_mutation(netw::messaging_service::msg_addr{ep, 0}, timeout, tracing::make_trace_info(tr_state),
+            return sp.remote().send_mutation_batched(netw::messaging_service::msg_addr{ep, ep_shard}, timeout, tracing::make_trace_info(tr_state),
                     *m, forward, utils::fb_utilities::get_broadcast_address(), this_shard_id(),
                     response_id, rate_limit_info, fence);
         }
-        sp.got_response(response_id, ep, std::nullopt);
+        sp.got_response(response_id, ep, std::nullopt, std::nullopt);
         return make_ready_future<>();
     }
     virtual bool is_shared() override {
@@ -1025,6 +1173,7 @@ class shared_mutation : public mutation_holder {
             : _mutation(make_lw_shared<const frozen_mutation>(std::move(fm_a_s.fm))) {
         _size = _mutation->representation().size();
         _schema = std::move(fm_a_s.s);
+        _routing_token = dht::get_token(*_schema, _mutation->key());
     }
     explicit shared_mutation(const mutation& m) : shared_mutation(frozen_mutation_and_schema{freeze(m), m.schema()}) {
     }
@@ -1037,12 +1186,12 @@ class shared_mutation : public mutation_holder {
         tracing::trace(tr_state, "Executing a mutation locally");
         return sp.apply_fence(sp.mutate_locally(_schema, *_mutation, std::move(tr_state), db::commitlog::force_sync::no, timeout, rate_limit_info), fence, utils::fb_utilities::get_broadcast_address());
     }
-    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, const inet_address_vector_replica_set& forward,
+    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, unsigned ep_shard, const inet_address_vector_replica_set& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) override {
         tracing::trace(tr_state, "Sending a mutation to /{}", ep);
-        return sp.remote().send_mutation(netw::messaging_service::msg_addr{ep, 0}, timeout, tracing::make_trace_info(tr_state),
+        return sp.remote().send_mutation_batched(netw::messaging_service::msg_addr{ep, ep_shard}, timeout, tracing::make_trace_info(tr_state),
                 *_mutation, forward, utils::fb_utilities::get_broadcast_address(), this_shard_id(),
                 response_id, rate_limit_info, fence);
     }
@@ -1068,11 +1217,11 @@ class hint_mutation : public shared_mutation {
         // becomes unavailable - this might include the current node
         return sp.mutate_hint(_schema, *_mutation, std::move(tr_state), timeout);
     }
-    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, const inet_address_vector_replica_set& forward,
+    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, unsigned ep_shard, const inet_address_vector_replica_set& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info, fencing_token) override {
         return sp.remote().send_hint_mutation(
-                netw::messaging_service::msg_addr{ep, 0}, timeout, tr_state,
+                netw::messaging_service::msg_addr{ep, ep_shard}, timeout, tr_state,
                 *_mutation, forward, utils::fb_utilities::get_broadcast_address(), this_shard_id(), response_id, rate_limit_info);
     }
 };
@@ -1121,6 +1270,8 @@ class paxos_response_handler : public enable_shared_from_this<paxos_response_han
 
     // max pruning operations to run in parralel
     static constexpr uint16_t pruning_limit = 1000;
+    // max learn stages to run in the background in parallel
+    static constexpr uint16_t background_learn_limit = 1000;
 
 public:
     tracing::trace_state_ptr tr_state;
@@ -1147,6 +1298,9 @@ class paxos_response_handler : public enable_shared_from_this<paxos_response_han
     future<paxos::prepare_summary> prepare_ballot(utils::UUID ballot);
     future<bool> accept_proposal(lw_shared_ptr<paxos::proposal> proposal, bool timeout_if_partially_accepted = true);
     future<> learn_decision(lw_shared_ptr<paxos::proposal> proposal, bool allow_hints = false);
+    // Whether the client may be replied to before the accepted proposal is learned.
+    bool can_learn_in_background() const;
+    void learn_decision_in_background(lw_shared_ptr<paxos::proposal> proposal);
     void prune(utils::UUID ballot);
     uint64_t id() const {
         return _id;
@@ -1178,6 +1332,7 @@ class cas_mutation : public mutation_holder {
             : _proposal(std::move(proposal)), _handler(std::move(handler)) {
         _size = _proposal->update.representation().size();
         _schema = std::move(s);
+        _routing_token = dht::get_token(*_schema, _proposal->update.key());
     }
     virtual bool store_hint(db::hints::manager& hm, gms::inet_address ep, tracing::trace_state_ptr tr_state) override {
             return false; // CAS does not save hints yet
@@ -1189,13 +1344,13 @@ class cas_mutation : public mutation_holder {
         // TODO: Enforce per partition rate limiting in paxos
         return paxos::paxos_state::learn(sp, _schema, *_proposal, timeout, tr_state);
     }
-    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, const inet_address_vector_replica_set& forward,
+    virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, unsigned ep_shard, const inet_address_vector_replica_set& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info, fencing_token) override {
         tracing::trace(tr_state, "Sending a learn to /{}", ep);
         // TODO: Enforce per partition rate limiting in paxos
         return sp.remote().send_paxos_learn(
-                netw::messaging_service::msg_addr{ep, 0}, timeout, tracing::make_trace_info(tr_state),
+                netw::messaging_service::msg_addr{ep, ep_shard}, timeout, tracing::make_trace_info(tr_state),
                 *_proposal, forward, utils::fb_utilities::get_broadcast_address(), this_shard_id(), response_id);
     }
     virtual bool is_shared() override {
@@ -1248,6 +1403,9 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
     timer<storage_proxy::clock_type> _expire_timer;
     service_permit _permit; // holds admission permit until operation completes
     db::per_partition_rate_limit::info _rate_limit_info;
+    // The highest view update backlog of the written table reported by the
+    // replicas which responded.
+    std::optional<db::view::update_backlog> _view_update_backlog;
 
 protected:
     virtual bool waited_for(gms::inet_address from) = 0;
@@ -1429,6 +1587,30 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
         on_timeout();
         _proxy->remove_response_handler(_id);
     }
+    void on_view_update_backlog(db::view::update_backlog backlog) {
+        _view_update_backlog = _view_update_backlog ? std::max(*_view_update_backlog, backlog) : backlog;
+    }
+    // Above this fraction of their memory budget, the view updates of all the
+    // base tables of a replica are about to be dropped, so all the writes to
+    // tables with views are throttled by the backlog of the whole replica.
+    static constexpr float shared_view_update_backlog_threshold = 0.8;
+    // The backlog the write is throttled by. Writes to tables without views
+    // don't grow the view update backlog so they aren't throttled by it,
+    // and writes to tables with views are throttled by the backlog of the
+    // views of their own table, unless the replicas are running out of memory
+    // for view updates.
+    db::view::update_backlog write_backlog() {
+        auto& s = *get_schema();
+        if (s.is_view()) {
+            return max_backlog();
+        }
+        auto& db = _proxy->local_db();
+        if (!db.column_family_exists(s.id()) || db.find_column_family(s.id()).views().empty()) {
+            return db::view::update_backlog::no_backlog();
+        }
+        auto node_backlog = max_backlog();
+        return std::max(_view_update_backlog.value_or(node_backlog), node_backlog.above(shared_view_update_backlog_threshold));
+    }
     db::view::update_backlog max_backlog() {
         return boost::accumulate(
                 get_targets() | boost::adaptors::transformed([this] (gms::inet_address ep) {
@@ -1459,7 +1641,7 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
     // Calculates how much to delay completing the request. The delay adds to the request's inherent latency.
     template<typename Func>
     void delay(tracing::trace_state_ptr trace, Func&& on_resume) {
-        auto backlog = max_backlog();
+        auto backlog = write_backlog();
         auto delay = calculate_delay(backlog);
         stats().last_mv_flow_control_delay = delay;
         if (delay.count() == 0) {
@@ -1496,7 +1678,9 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
     future<> apply_remotely(gms::inet_address ep, const inet_address_vector_replica_set& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state) {
-        return _mutation_holder->apply_remotely(*_proxy, ep, forward,
+        auto& token = _mutation_holder->routing_token();
+        unsigned ep_shard = token ? _proxy->replica_shard_of(*_effective_replication_map_ptr, *get_schema(), ep, *token) : 0;
+        return _mutation_holder->apply_remotely(*_proxy, ep, ep_shard, forward,
             response_id, timeout, std::move(tr_state), _rate_limit_info,
             {_effective_replication_map_ptr->get_token_metadata().get_version()});
     }
@@ -2175,6 +2359,32 @@ future<> paxos_response_handler::learn_decision(lw_shared_ptr<paxos::proposal> d
     co_await when_all_succeed(std::move(f_cdc), std::move(f_lwt)).discard_result();
 }
 
+// A proposal accepted by a quorum is chosen: a SERIAL read, or the next
+// CAS operation on the key, finds it in the prepare stage and completes its
+// learn if it wasn't learned yet.  So, when the learn has no consistency
+// requirements for non-SERIAL reads, which is the case for the empty proposals
+// of failed conditions and SERIAL reads too, the client doesn't have to wait
+// for it, which saves the last of the round trips of an uncontended CAS.
+bool paxos_response_handler::can_learn_in_background() const {
+    return _cl_for_learn == db::consistency_level::ANY
+            && _proxy->get_db().local().get_config().cas_background_learn()
+            && _proxy->get_stats().cas_now_learning_in_background < background_learn_limit;
+}
+
+void paxos_response_handler::learn_decision_in_background(lw_shared_ptr<paxos::proposal> decision) {
+    _proxy->get_stats().cas_now_learning_in_background++;
+    _proxy->get_stats().cas_background_learns++;
+    // Like prune(), held by the handler, which holds storage_proxy alive.
+    (void)learn_decision(std::move(decision)).then_wrapped([h = shared_from_this()] (future<> f) {
+        h->_proxy->get_stats().cas_now_learning_in_background--;
+        if (f.failed()) {
+            auto ex = f.get_exception();
+            tracing::trace(h->tr_state, "learn_decision in the background failed: {}", ex);
+            paxos::paxos_state::logger.debug("CAS[{}] learn_decision in the background failed: {}", h->_id, ex);
+        }
+    });
+}
+
 void paxos_response_handler::prune(utils::UUID ballot) {
     if ( _proxy->get_stats().cas_now_pruning >= pruning_limit) {
         _proxy->get_stats().cas_coordinator_dropped_prune++;
@@ -2304,10 +2514,16 @@ void storage_proxy::remove_response_handler_entry(response_handlers_map::iterato
     _response_handlers.erase(std::move(entry));
 }
 
-void storage_proxy::got_response(storage_proxy::response_id_type id, gms::inet_address from, std::optional<db::view::update_backlog> backlog) {
+void storage_proxy::got_response(storage_proxy::response_id_type id, gms::inet_address from, std::optional<db::view::update_backlog> backlog,
+        std::optional<db::view::update_backlog> table_backlog) {
     auto it = _response_handlers.find(id);
     if (it != _response_handlers.end()) {
         tracing::trace(it->second->get_trace_state(), "Got a response from /{}", from);
+        // Replicas which don't report the backlog of the table are
+        // accounted with the backlog of all of their views.
+        if (auto b = table_backlog ? table_backlog : backlog) {
+            it->second->on_view_update_backlog(*b);
+        }
         if (it->second->response(from)) {
             remove_response_handler_entry(std::move(it)); // last one, remove entry. Will cancel expiration timer too.
         } else {
@@ -2341,6 +2557,32 @@ db::view::update_backlog storage_proxy::get_view_update_backlog() const {
     return _max_view_update_backlog.add_fetch(this_shard_id(), get_db().local().get_view_update_backlog());
 }
 
+db::view::update_backlog storage_proxy::get_view_update_backlog_of(table_id id) const {
+    auto& db = get_db().local();
+    if (!db.column_family_exists(id)) {
+        return db::view::update_backlog::no_backlog();
+    }
+    return db.find_column_family(id).get_view_update_backlog();
+}
+
+unsigned storage_proxy::replica_shard_of(const locator::effective_replication_map& erm, const schema& s, gms::inet_address ep, const dht::token& token) const {
+    if (!_db.local().get_config().internode_shard_aware_connections()) {
+        // The requests are sent over a single connection per node, and thus
+        // also batched per node, see remote::send_mutation_batched().
+        return 0;
+    }
+    if (erm.get_replication_strategy().uses_tablets()) {
+        // Tablets have their replica shards in the tablet map, not derived
+        // from the token.
+        return 0;
+    }
+    auto* node = erm.get_topology().find_node(ep);
+    if (!node || !node->get_shard_count()) {
+        return 0;
+    }
+    return dht::shard_of(node->get_shard_count(), s.get_sharder().sharding_ignore_msb(), token);
+}
+
 db::view::update_backlog storage_proxy::get_backlog_of(gms::inet_address ep) const {
     auto it = _view_update_backlogs.find(ep);
     if (it == _view_update_backlogs.end()) {
@@ -2530,6 +2772,14 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of background read repairs"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("deferred_read_repairs", read_repair_deferred,
+                       sm::description("number of read repair writes of unreturned partitions done in the background"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("dropped_deferred_read_repairs", read_repair_deferred_dropped,
+                       sm::description("number of read repair writes of unreturned partitions dropped because too many were in flight"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("read_timeouts", [this]{return read_timeouts.count(); },
                        sm::description("number of read request failed due to a timeout"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2562,6 +2812,18 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of speculative data read requests that were sent"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("speculative_reads_over_budget", speculative_reads_over_budget,
+                       sm::description("number of speculative read requests that were not sent since the speculative retry budget was exhausted"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("batched_mutations", batched_mutations,
+                       sm::description("number of mutations sent to replicas batched with other mutations to the same replica"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("mutation_batches", mutation_batches,
+                       sm::description("number of batches of mutations sent to replicas in a single message"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_summary("cas_read_latency_summary", sm::description("CAS read latency summary"), [this] {return to_metrics_summary(cas_read.summary());})(storage_proxy_stats::current_scheduling_group_label()).set_skip_when_empty(),
         sm::make_summary("cas_write_latency_summary", sm::description("CAS write latency summary"), [this] {return to_metrics_summary(cas_write.summary());})(storage_proxy_stats::current_scheduling_group_label()).set_skip_when_empty(),
 
@@ -2610,6 +2872,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("CAS read rounds issued only if previous value is missing on some replica"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("cas_background_learns", cas_background_learns,
+                       sm::description("how many times the learn stage of a CAS operation was completed in the background"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_histogram("cas_read_contention", sm::description("how many contended reads were encountered"),
                        {storage_proxy_stats::current_scheduling_group_label()},
                        [this]{ return cas_read_contention.get_histogram(1, 8);}).set_skip_when_empty(),
@@ -2672,6 +2938,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of operations that crossed a shard boundary"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("cross_shard_write_batches", replica_cross_shard_write_batches,
+                       sm::description("number of cross-shard messages carrying the writes to apply on another shard, several writes per message when batched"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("cas_dropped_prune", cas_replica_dropped_prune,
                        sm::description("how many times a coordinator did not perfom prune after cas"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2781,9 +3051,11 @@ storage_proxy::storage_proxy(distributed<replica::database>& db, storage_proxy::
     , _stats_key(stats_key)
     , _features(feat)
     , _background_write_throttle_threahsold(cfg.available_memory / 10)
+    , _deferred_read_repair_sem(_db.local().get_config().read_repair_deferred_concurrency())
     , _mutate_stage{"storage_proxy_mutate", &storage_proxy::do_mutate}
     , _max_view_update_backlog(max_view_update_backlog)
-    , _cancellable_write_handlers_list(std::make_unique<cancellable_write_handlers_list>()) {
+    , _cancellable_write_handlers_list(std::make_unique<cancellable_write_handlers_list>())
+    , _cross_shard_writes(std::make_unique<cross_shard_writes>(*this)) {
     namespace sm = seastar::metrics;
     _metrics.add_group(storage_proxy_stats::COORDINATOR_STATS_CATEGORY, {
         sm::make_queue_length("current_throttled_writes", [this] { return _throttled_writes.size(); },
@@ -2847,11 +3119,141 @@ storage_proxy::response_id_type storage_proxy::unique_response_handler::release(
     return r;
 }
 
+// The writes to apply on another shard are queued until the tasks which are
+// ready now have run, and then sent to each shard in batches of up to
+// max_batch_size writes per cross-shard message. Under high write rates, e.g.
+// the mutations received from many connections in one poll, this spares the
+// cross-shard queues a message per write. The writes of a batch are applied in
+// parallel and complete individually.
+//
+// A batch only collects the writes of a single smp service group and
+// scheduling group, and is sent from, and thus applied in, that scheduling
+// group.
+class storage_proxy::cross_shard_writes {
+    struct write {
+        global_schema_ptr s;
+        // Kept alive by the caller until the write completes.
+        const frozen_mutation& fm;
+        tracing::global_trace_state_ptr tr_state;
+        db::commitlog::force_sync sync;
+        clock_type::time_point timeout;
+        db::per_partition_rate_limit::info rate_limit_info;
+    };
+
+    struct batch {
+        smp_service_group smp_grp;
+        scheduling_group sched_grp;
+        std::vector<write> writes;
+        std::vector<promise<>> done;
+    };
+
+    static constexpr size_t max_batch_size = 64;
+
+    storage_proxy& _sp;
+    // The batches of each shard which are open to new writes, one per smp service group and scheduling group.
+    std::vector<utils::small_vector<lw_shared_ptr<batch>, 2>> _open;
+    // Held by the batches until they complete.
+    seastar::gate _gate;
+private:
+    void close(unsigned shard, const lw_shared_ptr<batch>& b) noexcept {
+        auto& open = _open[shard];
+        if (auto it = std::ranges::find(open, b); it != open.end()) {
+            open.erase(it);
+        }
+    }
+
+    future<> send(unsigned shard, lw_shared_ptr<batch> b) noexcept {
+        ++_sp.get_stats().replica_cross_shard_write_batches;
+        auto timeout = clock_type::time_point::min();
+        for (auto& w : b->writes) {
+            timeout = std::max(timeout, w.timeout);
+        }
+        return with_scheduling_group(b->sched_grp, [this, shard, b, timeout] {
+            return _sp._db.invoke_on(shard, {b->smp_grp, timeout}, [&writes = b->writes] (replica::database& db) {
+                return do_with(std::vector<std::exception_ptr>(writes.size()), [&db, &writes] (std::vector<std::exception_ptr>& results) {
+                    return parallel_for_each(boost::irange(size_t(0), writes.size()), [&db, &writes, &results] (size_t i) {
+                        auto& w = writes[i];
+                        return futurize_invoke([&] {
+                            return db.apply(w.s, w.fm, w.tr_state.get(), w.sync, w.timeout, w.rate_limit_info);
+                        }).handle_exception([&results, i] (std::exception_ptr ep) {
+                            results[i] = std::move(ep);
+                        });
+                    }).then([&results] {
+                        return std::move(results);
+                    });
+                });
+            });
+        }).then_wrapped([b] (future<std::vector<std::exception_ptr>> f) {
+            if (f.failed()) {
+                auto ep = f.get_exception();
+                for (auto& p : b->done) {
+                    p.set_exception(ep);
+                }
+                return;
+            }
+            auto results = f.get();
+            for (size_t i = 0; i < results.size(); ++i) {
+                if (results[i]) {
+                    b->done[i].set_exception(std::move(results[i]));
+                } else {
+                    b->done[i].set_value();
+                }
+            }
+        });
+    }
+public:
+    explicit cross_shard_writes(storage_proxy& sp)
+        : _sp(sp)
+        , _open(smp::count)
+    { }
+
+    future<> apply(unsigned shard, const schema_ptr& s, const frozen_mutation& fm, tracing::trace_state_ptr tr_state, db::commitlog::force_sync sync,
+            clock_type::time_point timeout, smp_service_group smp_grp, db::per_partition_rate_limit::info rate_limit_info) {
+        auto& open = _open[shard];
+        auto sched_grp = current_scheduling_group();
+        auto it = std::ranges::find_if(open, [smp_grp, sched_grp] (const lw_shared_ptr<batch>& b) {
+            return seastar::internal::smp_service_group_id(b->smp_grp) == seastar::internal::smp_service_group_id(smp_grp)
+                    && b->sched_grp == sched_grp;
+        });
+        if (it == open.end()) {
+            if (_gate.is_closed()) {
+                return make_exception_future<>(gate_closed_exception());
+            }
+            auto b = make_lw_shared<batch>(batch{smp_grp, sched_grp});
+            // Waited on by the writes of the batch, and by stop().
+            (void)seastar::yield().then([this, shard, b, holder = _gate.hold()] () mutable {
+                close(shard, b);
+                return send(shard, std::move(b)).finally([holder = std::move(holder)] {});
+            });
+            open.push_back(b);
+            it = std::prev(open.end());
+        }
+        auto b = *it;
+        b->writes.push_back(write{global_schema_ptr(s), fm, tracing::global_trace_state_ptr(std::move(tr_state)), sync, timeout, rate_limit_info});
+        b->done.emplace_back();
+        auto f = b->done.back().get_future();
+        if (b->writes.size() >= max_batch_size) {
+            // Sent as scheduled above, the next writes open a new batch.
+            close(shard, b);
+        }
+        return f;
+    }
+
+    // Waits for the batches in flight, and fails the writes which come later.
+    future<> stop() {
+        return _gate.close();
+    }
+};
+
 future<>
 storage_proxy::mutate_locally(const mutation& m, tracing::trace_state_ptr tr_state, db::commitlog::force_sync sync, clock_type::time_point timeout, smp_service_group smp_grp, db::per_partition_rate_limit::info rate_limit_info) {
     auto erm = _db.local().find_column_family(m.schema()).get_effective_replication_map();
     auto shard = erm->get_sharder(*m.schema()).shard_of(m.token());
     get_stats().replica_cross_shard_ops += shard != this_shard_id();
+    if (shard != this_shard_id()) {
+        auto fm = make_lw_shared<const frozen_mutation>(freeze(m));
+        return _cross_shard_writes->apply(shard, m.schema(), *fm, std::move(tr_state), sync, timeout, smp_grp, rate_limit_info).finally([fm] {});
+    }
     return _db.invoke_on(shard, {smp_grp, timeout},
             [s = global_schema_ptr(m.schema()),
              m = freeze(m),
@@ -2869,6 +3271,9 @@ storage_proxy::mutate_locally(const schema_ptr& s, const frozen_mutation& m, tra
     auto erm = _db.local().find_column_family(s).get_effective_replication_map();
     auto shard = erm->get_sharder(*s).shard_of(m.token(*s));
     get_stats().replica_cross_shard_ops += shard != this_shard_id();
+    if (shard != this_shard_id()) {
+        return _cross_shard_writes->apply(shard, s, m, std::move(tr_state), sync, timeout, smp_grp, rate_limit_info);
+    }
     return _db.invoke_on(shard, {smp_grp, timeout},
             [&m, gs = global_schema_ptr(s), gtr = tracing::global_trace_state_ptr(std::move(tr_state)), timeout, sync, rate_limit_info] (replica::database& db) mutable -> future<> {
         return db.apply(gs, m, gtr.get(), sync, timeout, rate_limit_info);
@@ -3889,7 +4294,7 @@ void storage_proxy::send_to_live_endpoints(storage_proxy::response_id_type respo
                 .then([response_id, this, my_address, h = std::move(handler_ptr), p = shared_from_this()] {
             // make mutation alive until it is processed locally, otherwise it
             // may disappear if write timeouts before this future is ready
-            got_response(response_id, my_address, get_view_update_backlog());
+            got_response(response_id, my_address, get_view_update_backlog(), get_view_update_backlog_of(h->get_schema()->id()));
         });
     };
 
@@ -3917,7 +4322,7 @@ void storage_proxy::send_to_live_endpoints(storage_proxy::response_id_type respo
 
 
         if (handler.is_counter() && coordinator == my_address) {
-            got_response(response_id, coordinator, std::nullopt);
+            got_response(response_id, coordinator, std::nullopt, std::nullopt);
         } else {
             if (!handler.read_repair_write()) {
                 ++stats.writes_attempts.get_ep_stat(handler_ptr->_effective_replication_map_ptr->get_topology(), coordinator);
@@ -3983,6 +4388,56 @@ future<result<>> storage_proxy::schedule_repair(locator::effective_replication_m
     return mutate_internal(diffs | boost::adaptors::map_values | boost::adaptors::transformed([ermp] (auto& v) { return read_repair_mutation{std::move(v), ermp}; }), cl, false, std::move(trace_state), std::move(permit));
 }
 
+void storage_proxy::schedule_deferred_repair(locator::effective_replication_map_ptr ermp, std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> diffs,
+        db::consistency_level cl, tracing::trace_state_ptr trace_state) {
+    if (diffs.empty()) {
+        return;
+    }
+    auto units = try_get_units(_deferred_read_repair_sem, 1);
+    if (!units) {
+        ++get_stats().read_repair_deferred_dropped;
+        return;
+    }
+    ++get_stats().read_repair_deferred;
+    // All errors are handled, it's OK to discard the result.
+    (void)schedule_repair(std::move(ermp), std::move(diffs), cl, std::move(trace_state), empty_service_permit()).then_wrapped(
+            [units = std::move(*units), p = shared_from_this()] (future<result<>> f) {
+        f.ignore_ready_future();
+    });
+}
+
+// Splits off the repair diffs of the partitions of rr which are beyond the
+// limits of the read, so they are not returned to the client.
+static std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>>
+split_unreturned_diffs(const schema& s, const reconcilable_result& rr, uint64_t row_limit, uint64_t per_partition_row_limit, uint32_t partition_limit,
+        std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>>& diffs) {
+    std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> unreturned;
+    uint64_t rows = 0;
+    uint32_t partitions = 0;
+    std::optional<dht::token> last_returned;
+    for (const auto& p : rr.partitions()) {
+        if (rows >= row_limit || partitions >= partition_limit) {
+            break;
+        }
+        last_returned = p.mut().decorated_key(s).token();
+        auto row_count = std::min<uint64_t>(p.row_count(), per_partition_row_limit);
+        rows += row_count;
+        partitions += !!row_count;
+    }
+    if (!last_returned) {
+        return unreturned;
+    }
+    for (auto it = diffs.begin(); it != diffs.end();) {
+        if (it->first > *last_returned) {
+            unreturned.emplace(it->first, std::move(it->second));
+            it = diffs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return unreturned;
+}
+
 class abstract_read_resolver {
 protected:
     enum class error_kind : uint8_t {
@@ -4679,13 +5134,20 @@ class data_read_resolver : public abstract_read_resolver {
             _is_short_read = query::short_read::yes;
         }
 
+        // The replicas' versions are not needed anymore. Free them before
+        // freezing the reconciled partitions, and free each of those once
+        // it's frozen, so the reconciliation ends up holding just the result
+        // instead of a copy of it from every replica and two of the result.
+        versions = {};
+
         // build reconcilable_result from reconciled data
         // traverse backwards since large keys are at the start
         utils::chunked_vector<partition> vec;
         vec.reserve(_partition_count);
-        for (auto it = reconciled_partitions.rbegin(); it != reconciled_partitions.rend(); it++) {
-            const mutation_and_live_row_count& m_a_rc = *it;
+        while (!reconciled_partitions.empty()) {
+            const mutation_and_live_row_count& m_a_rc = reconciled_partitions.back();
             vec.emplace_back(partition(m_a_rc.live_row_count, freeze(m_a_rc.mut)));
+            reconciled_partitions.pop_back();
             co_await coroutine::maybe_yield();
         }
 
@@ -4767,14 +5229,29 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         return _used_targets;
     }
 
+    const dht::partition_range& partition_range() const {
+        return _partition_range;
+    }
+
+    // Whether the read is a plain read of the local replica: no digests,
+    // no speculation and nothing to wait for from other replicas.
+    bool is_local_data_read() const {
+        return _block_for == 1 && _targets.size() == 1 && _targets.front() == utils::fb_utilities::get_broadcast_address();
+    }
+
 protected:
+    // Addresses the shard of ep owning the partition read.
+    netw::msg_addr replica_addr(gms::inet_address ep) const {
+        const auto& token = _partition_range.start()->value().token();
+        return netw::msg_addr{ep, _proxy->replica_shard_of(*_effective_replication_map_ptr, *_schema, ep, token)};
+    }
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> make_mutation_data_request(lw_shared_ptr<query::read_command> cmd, gms::inet_address ep, clock_type::time_point timeout) {
         ++_proxy->get_stats().mutation_data_read_attempts.get_ep_stat(get_topology(), ep);
         if (fbu::is_me(ep)) {
             tracing::trace(_trace_state, "read_mutation_data: querying locally");
             return _proxy->apply_fence(_proxy->query_mutations_locally(_schema, cmd, _partition_range, timeout, _trace_state), get_fence(), utils::fb_utilities::get_broadcast_address());
         } else {
-            return _proxy->remote().send_read_mutation_data(netw::messaging_service::msg_addr{ep, 0}, timeout,
+            return _proxy->remote().send_read_mutation_data(replica_addr(ep), timeout,
                 _trace_state, *cmd, _partition_range,
                 get_fence());
         }
@@ -4788,7 +5265,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
             tracing::trace(_trace_state, "read_data: querying locally");
             return _proxy->apply_fence(_proxy->query_result_local(_effective_replication_map_ptr, _schema, _cmd, _partition_range, opts, _trace_state, timeout, adjust_rate_limit_for_local_operation(_rate_limit_info)), get_fence(), utils::fb_utilities::get_broadcast_address());
         } else {
-            return _proxy->remote().send_read_data(netw::messaging_service::msg_addr{ep, 0}, timeout,
+            return _proxy->remote().send_read_data(replica_addr(ep), timeout,
                 _trace_state, *_cmd, _partition_range, opts.digest_algo, _rate_limit_info,
                 get_fence());
         }
@@ -4801,21 +5278,57 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                         timeout, digest_algorithm(*_proxy), adjust_rate_limit_for_local_operation(_rate_limit_info)), get_fence(), utils::fb_utilities::get_broadcast_address());
         } else {
             tracing::trace(_trace_state, "read_digest: sending a message to /{}", ep);
-            return _proxy->remote().send_read_digest(netw::messaging_service::msg_addr{ep, 0}, timeout,
+            return _proxy->remote().send_read_digest(replica_addr(ep), timeout,
                 _trace_state, *_cmd, _partition_range, digest_algorithm(*_proxy), _rate_limit_info,
                 get_fence());
         }
     }
+    // The replica didn't respond before the timeout, so nobody is waiting for
+    // its result anymore. Tell it to stop working on the read, instead of
+    // letting it run to completion. Only paged reads can be found by
+    // the replica, through their query id.
+    void maybe_abort_replica_read(gms::inet_address ep, const query::read_command& cmd, const std::exception_ptr& ex) {
+        if (!cmd.query_uuid || fbu::is_me(ep) || !_proxy->features().read_abort || !try_catch<rpc::timeout_error>(ex)) {
+            return;
+        }
+        tracing::trace(_trace_state, "Aborting read on /{}", ep);
+        // Fire and forget, the replica times out the read on its own
+        // eventually anyway.
+        (void)_proxy->remote().send_read_abort(netw::messaging_service::msg_addr{ep, 0}, cmd.query_uuid).handle_exception([ep] (std::exception_ptr ex) {
+            slogger.debug("Failed to abort read on {}: {}", ep, ex);
+        });
+    }
+    // Accounts the request in the replica load tracker until it completes.
+    template <typename Future>
+    Future track_replica_load(gms::inet_address ep, Future f) {
+        if (f.available()) {
+            return f;
+        }
+        auto& tracker = _proxy->get_replica_load_tracker();
+        tracker.on_request_sent(ep);
+        return f.then_wrapped([&tracker, ep, start = replica_load_tracker::clock::now(), p = _proxy] (Future fut) {
+            tracker.on_request_completed(ep, replica_load_tracker::clock::now() - start);
+            return fut;
+        });
+    }
+    // Single-partition reads report the hit rate of the token range read
+    void set_hit_rate(gms::inet_address ep, cache_temperature rate) {
+        if (_partition_range.is_singular()) {
+            _cf->set_hit_rate(ep, _partition_range.start()->value().token(), rate);
+        } else {
+            _cf->set_hit_rate(ep, rate);
+        }
+    }
     void make_mutation_data_requests(lw_shared_ptr<query::read_command> cmd, data_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout) {
         auto start = latency_clock::now();
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
             // Waited on indirectly, shared_from_this keeps `this` alive
-            (void)make_mutation_data_request(cmd, ep, timeout).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> f) {
+            (void)track_replica_load(ep, make_mutation_data_request(cmd, ep, timeout)).then_wrapped([this, cmd, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> f) {
                 std::exception_ptr ex;
                 try {
                   if (!f.failed()) {
                     auto v = f.get0();
-                    _cf->set_hit_rate(ep, std::get<1>(v));
+                    set_hit_rate(ep, std::get<1>(v));
                     resolver->add_mutate_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().mutation_data_read_completed.get_ep_stat(get_topology(), ep);
                     register_request_latency(latency_clock::now() - start);
@@ -4828,6 +5341,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                 }
 
                 ++_proxy->get_stats().mutation_data_read_errors.get_ep_stat(get_topology(), ep);
+                maybe_abort_replica_read(ep, *cmd, ex);
                 resolver->error(ep, std::move(ex));
             });
         }
@@ -4836,12 +5350,12 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         auto start = latency_clock::now();
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
             // Waited on indirectly, shared_from_this keeps `this` alive
-            (void)make_data_request(ep, timeout, want_digest).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> f) {
+            (void)track_replica_load(ep, make_data_request(ep, timeout, want_digest)).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> f) {
                 std::exception_ptr ex;
                 try {
                   if (!f.failed()) {
                     auto v = f.get0();
-                    _cf->set_hit_rate(ep, std::get<1>(v));
+                    set_hit_rate(ep, std::get<1>(v));
                     resolver->add_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().data_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
@@ -4855,6 +5369,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                 }
 
                 ++_proxy->get_stats().data_read_errors.get_ep_stat(get_topology(), ep);
+                maybe_abort_replica_read(ep, *_cmd, ex);
                 resolver->error(ep, std::move(ex));
             });
         }
@@ -4863,12 +5378,12 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         auto start = latency_clock::now();
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
             // Waited on indirectly, shared_from_this keeps `this` alive
-            (void)make_digest_request(ep, timeout).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>> f) {
+            (void)track_replica_load(ep, make_digest_request(ep, timeout)).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>> f) {
                 std::exception_ptr ex;
                 try {
                   if (!f.failed()) {
                     auto v = f.get0();
-                    _cf->set_hit_rate(ep, std::get<2>(v));
+                    set_hit_rate(ep, std::get<2>(v));
                     resolver->add_digest(ep, std::get<0>(v), std::get<1>(v), std::get<3>(std::move(v)));
                     ++_proxy->get_stats().digest_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
@@ -4882,6 +5397,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                 }
 
                 ++_proxy->get_stats().digest_read_errors.get_ep_stat(get_topology(), ep);
+                maybe_abort_replica_read(ep, *_cmd, ex);
                 resolver->error(ep, std::move(ex));
             });
         }
@@ -4936,13 +5452,19 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                 if (rr_opt && (can_send_short_read || data_resolver->all_reached_end() || rr_opt->row_count() >= original_row_limit()
                                || data_resolver->live_partition_count() >= original_partition_limit())
                         && !data_resolver->any_partition_short_read()) {
+                    auto diffs = data_resolver->get_diffs_for_repair();
+                    if (!diffs.empty() && _proxy->get_db().local().get_config().read_repair_defer_unreturned_partitions()) {
+                        _proxy->schedule_deferred_repair(_effective_replication_map_ptr,
+                                split_unreturned_diffs(*_schema, *rr_opt, original_row_limit(), original_per_partition_row_limit(), original_partition_limit(), diffs),
+                                _cl, _trace_state);
+                    }
                     auto result = ::make_foreign(::make_lw_shared<query::result>(
                             co_await to_data_query_result(std::move(*rr_opt), _schema, _cmd->slice, _cmd->get_row_limit(), cmd->partition_limit)));
                     // wait for write to complete before returning result to prevent multiple concurrent read requests to
                     // trigger repair multiple times and to prevent quorum read to return an old value, even after a quorum
                     // another read had returned a newer value (but the newer value had not yet been sent to the other replicas)
                     // Waited on indirectly.
-                    (void)_proxy->schedule_repair(_effective_replication_map_ptr, data_resolver->get_diffs_for_repair(), _cl, _trace_state, _permit).then(utils::result_wrap([this, result = std::move(result)] () mutable {
+                    (void)_proxy->schedule_repair(_effective_replication_map_ptr, std::move(diffs), _cl, _trace_state, _permit).then(utils::result_wrap([this, result = std::move(result)] () mutable {
                         _result_promise.set_value(std::move(result));
                         return make_ready_future<::result<>>(bo::success());
                     })).then_wrapped([this, exec] (future<::result<>>&& f) {
@@ -5144,11 +5666,36 @@ class always_speculating_read_executor : public abstract_read_executor {
 // this executor sends request to an additional replica after some time below timeout
 class speculating_read_executor : public abstract_read_executor {
     timer<storage_proxy::clock_type> _speculate_timer;
+    // The delay of the ADAPTIVE speculative retry: the longest of the latency
+    // percentiles of the replicas read from first, falling back to that of
+    // the table when one of them has too few samples.
+    std::chrono::microseconds adaptive_retry_delay(double percentile) {
+        auto& tracker = _proxy->get_replica_load_tracker();
+        auto now = replica_load_tracker::clock::now();
+        std::chrono::microseconds delay{0};
+        for (auto it = _targets.begin(); it != _targets.end() - 1; ++it) {
+            auto p = tracker.latency_percentile(*it, percentile, now);
+            if (!p) {
+                return _cf->get_coordinator_read_latency_percentile(percentile);
+            }
+            delay = std::max(delay, *p);
+        }
+        return delay;
+    }
 public:
     using abstract_read_executor::abstract_read_executor;
     virtual void make_requests(digest_resolver_ptr resolver, storage_proxy::clock_type::time_point timeout) override {
-        _speculate_timer.set_callback([this, resolver, timeout] {
+        auto& sr = _schema->speculative_retry();
+        const bool adaptive = sr.get_type() == speculative_retry::type::ADAPTIVE;
+        if (adaptive) {
+            _proxy->get_speculative_retry_budget().on_request(_proxy->get_db().local().get_config().speculative_retry_budget_percent() / 100.0);
+        }
+        _speculate_timer.set_callback([this, resolver, timeout, adaptive] {
             if (!resolver->is_completed()) { // at the time the callback runs request may be completed already
+                if (adaptive && !_proxy->get_speculative_retry_budget().try_spend()) {
+                    _proxy->get_stats().speculative_reads_over_budget++;
+                    return;
+                }
                 resolver->add_wait_targets(1); // we send one more request so wait for it too
                 // FIXME: consider disabling for CL=*ONE
                 auto send_request = [&] (bool has_data) {
@@ -5163,10 +5710,15 @@ class speculating_read_executor : public abstract_read_executor {
                 send_request(resolver->has_data());
             }
         });
-        auto& sr = _schema->speculative_retry();
-        auto t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
-            std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
-            std::chrono::milliseconds(unsigned(sr.get_value()));
+        const auto max_delay = std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2);
+        storage_proxy::clock_type::duration t;
+        if (sr.get_type() == speculative_retry::type::PERCENTILE) {
+            t = std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), max_delay);
+        } else if (adaptive) {
+            t = std::min<storage_proxy::clock_type::duration>(adaptive_retry_delay(sr.get_value()), max_delay);
+        } else {
+            t = std::chrono::milliseconds(unsigned(sr.get_value()));
+        }
         _speculate_timer.arm(t);
 
         // if CL + RR result in covering all replicas, getReadExecutor forces AlwaysSpeculating.  So we know
@@ -5231,10 +5783,19 @@ result<::shared_ptr<abstract_read_executor>> storage_proxy::get_read_executor(lw
     // orders the list by proximity to the local endpoint.
     is_read_non_local |= !all_replicas.empty() && all_replicas.front() != utils::fb_utilities::get_broadcast_address();
 
+    const auto& cfg = _db.local().get_config();
+    const bool latency_aware = cfg.latency_aware_read_balancing();
+    if (latency_aware) {
+        // Only reorder the replicas of the local datacenter (the nearest
+        // ones), so that reads don't start crossing datacenters.
+        auto local_end = std::find_if_not(all_replicas.begin(), all_replicas.end(), erm->get_topology().get_local_dc_filter());
+        _replica_load.rank(all_replicas.begin(), local_end);
+    }
+
     auto cf = _db.local().find_column_family(schema).shared_from_this();
     inet_address_vector_replica_set target_replicas = filter_replicas_for_read(cl, *erm, all_replicas, preferred_endpoints, repair_decision,
             retry_type == speculative_retry::type::NONE ? nullptr : &extra_replica,
-            _db.local().get_config().cache_hit_rate_read_balancing() ? &*cf : nullptr);
+            !latency_aware && cfg.cache_hit_rate_read_balancing() ? &*cf : nullptr, &token);
 
     slogger.trace("creating read executor for token {} with all: {} targets: {} rp decision: {}", token, all_replicas, target_replicas, repair_decision);
     tracing::trace(trace_state, "Creating read executor for token {} with all: {} targets: {} repair decision: {}", token, all_replicas, target_replicas, repair_decision);
@@ -5415,6 +5976,40 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
     // keeps sp alive for the co-routine lifetime
     auto p = shared_from_this();
 
+    // Multi-partition reads (IN queries) served by the local replica alone
+    // are executed as a single multishard read of all the partitions,
+    // instead of a read per partition. The shard readers are shared by the
+    // partitions of each shard, and the results come merged, in ring order.
+    // Per-partition rate limiting needs the reads to be accounted one by one.
+    if (exec.size() > 1 && !schema->per_partition_rate_limit_options().get_max_reads_per_second()
+            && std::ranges::all_of(exec, [] (const auto& e) { return e.first->is_local_data_read(); })) {
+        auto batch_cmd = make_lw_shared<query::read_command>(*cmd);
+        if (_features.range_scan_data_variant) {
+            batch_cmd->slice.options.set<query::partition_slice::option::range_scan_data_variant>();
+        }
+        auto ranges = boost::copy_range<dht::partition_range_vector>(exec | boost::adaptors::transformed([] (const auto& e) {
+            return e.first->partition_range();
+        }));
+        tracing::trace(query_options.trace_state, "Querying {} partitions locally in one read", ranges.size());
+        auto me = utils::fb_utilities::get_broadcast_address();
+        auto fence = fencing_token{tm.get_version()};
+        auto start = utils::latency_counter::clock::now();
+        foreign_ptr<lw_shared_ptr<query::result>> res;
+        try {
+            auto r = co_await apply_fence(query_nonsingular_data_locally(schema, batch_cmd, std::move(ranges), query::result_options::only_result(),
+                    query_options.trace_state, query_options.timeout(*this)), fence, me);
+            res = std::move(std::get<0>(r));
+        } catch (...) {
+            handle_read_error(std::current_exception(), false);
+            throw;
+        }
+        table.add_coordinator_read_latency(utils::latency_counter::clock::now() - start);
+        for (auto& [rex, token_range] : exec) {
+            used_replicas.emplace(std::move(token_range), endpoints_to_replica_ids(tm, {me}));
+        }
+        co_return coordinator_query_result(std::move(res), std::move(used_replicas), repair_decision);
+    }
+
     ::result<foreign_ptr<lw_shared_ptr<query::result>>> result = nullptr;
 
     // The following try..catch chain could be converted to an equivalent
@@ -5713,6 +6308,28 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
     }));
 }
 
+// Estimates the partitions of each tablet of the table from the tablets
+// replicated by this shard, or returns nullopt if it replicates none.
+static std::optional<uint64_t> estimate_partitions_per_tablet(replica::table& table, const locator::effective_replication_map& erm) {
+    const auto& tmap = erm.get_token_metadata().tablets().get_tablet_map(table.schema()->id());
+    const auto me = locator::tablet_replica{erm.get_token_metadata().get_my_id(), this_shard_id()};
+    size_t local_tablets = 0;
+    for (const auto& info : tmap.tablets()) {
+        local_tablets += std::ranges::find(info.replicas, me) != info.replicas.end();
+    }
+    if (!local_tablets) {
+        return std::nullopt;
+    }
+    uint64_t partitions = 0;
+    for (const auto& sst : *table.get_sstables()) {
+        partitions += sst->get_estimated_key_count();
+    }
+    for (auto* mt : table.active_memtables()) {
+        partitions += mt->partition_count();
+    }
+    return partitions / local_tablets;
+}
+
 future<result<storage_proxy::coordinator_query_result>>
 storage_proxy::query_partition_key_range(lw_shared_ptr<query::read_command> cmd,
         dht::partition_range_vector partition_ranges,
@@ -5731,6 +6348,20 @@ storage_proxy::query_partition_key_range(lw_shared_ptr<query::read_command> cmd,
     int result_rows_per_range = 0;
     int concurrency_factor = 1;
 
+    // Each range is a whole tablet with tablets, and there are few of them, so
+    // ramping the concurrency up from 1 would read them mostly one by one.
+    // Start with as many tablets as are expected to fill the requested rows
+    // instead, assuming at least one row per partition.
+    if (erm->get_replication_strategy().uses_tablets()) {
+        const auto tablet_count = erm->get_token_metadata().tablets().get_tablet_map(schema->id()).tablet_count();
+        if (auto partitions = estimate_partitions_per_tablet(table, *erm)) {
+            const uint64_t wanted = std::min<uint64_t>(cmd->get_row_limit(), cmd->partition_limit);
+            const uint64_t tablets = *partitions ? wanted / *partitions + bool(wanted % *partitions) : tablet_count;
+            result_rows_per_range = std::min<uint64_t>(*partitions, std::numeric_limits<int>::max());
+            concurrency_factor = std::clamp<uint64_t>(tablets, 1, tablet_count);
+        }
+    }
+
     std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results;
 
     slogger.debug("Estimated result rows per range: {}; requested rows: {}, concurrent range requests: {}",
@@ -6078,15 +6709,20 @@ future<bool> storage_proxy::cas(schema_ptr schema, shared_ptr<cas_request> reque
                 // The majority (aka a QUORUM) has promised the coordinator to
                 // accept the action associated with the computed ballot.
                 // Apply the mutation.
-                try {
-                  co_await handler->learn_decision(std::move(proposal));
-                } catch (unavailable_exception& e) {
-                    // if learning stage encountered unavailablity error lets re-map it to a write error
-                    // since unavailable error means that operation has never ever started which is not
-                    // the case here
-                    schema_ptr schema = handler->schema();
-                    throw mutation_write_timeout_exception(schema->ks_name(), schema->cf_name(),
-                                          e.consistency, e.alive, e.required, db::write_type::CAS);
+                if (handler->can_learn_in_background()) {
+                    tracing::trace(handler->tr_state, "Learning the decision in the background");
+                    handler->learn_decision_in_background(std::move(proposal));
+                } else {
+                    try {
+                        co_await handler->learn_decision(std::move(proposal));
+                    } catch (unavailable_exception& e) {
+                        // if learning stage encountered unavailablity error lets re-map it to a write error
+                        // since unavailable error means that operation has never ever started which is not
+                        // the case here
+                        schema_ptr schema = handler->schema();
+                        throw mutation_write_timeout_exception(schema->ks_name(), schema->cf_name(),
+                                              e.consistency, e.alive, e.required, db::write_type::CAS);
+                    }
                 }
                 paxos::paxos_state::logger.debug("CAS[{}] successful", handler->id());
                 tracing::trace(handler->tr_state, "CAS successful");
@@ -6172,7 +6808,8 @@ storage_proxy::filter_replicas_for_read(
         const inet_address_vector_replica_set& preferred_endpoints,
         db::read_repair_decision repair_decision,
         std::optional<gms::inet_address>* extra,
-        replica::column_family* cf) const {
+        replica::column_family* cf,
+        const dht::token* token) const {
     if (live_endpoints.empty() || only_me(live_endpoints)) {
         // `db::filter_for_query` would return the same thing, but thanks to this branch we avoid having
         // to access `remote` - so we can perform local queries without the need of `remote`.
@@ -6182,7 +6819,16 @@ storage_proxy::filter_replicas_for_read(
     // There are nodes other than us in `live_endpoints`.
     auto& gossiper = remote().gossiper();
 
-    return db::filter_for_query(cl, erm, std::move(live_endpoints), preferred_endpoints, repair_decision, gossiper, extra, cf);
+    // Pick the replicas suspected to be dead last, only if the consistency level needs them.
+    noncopyable_function<bool (const gms::inet_address&)> is_suspected_dead;
+    if (_db.local().get_config().direct_failure_detector_read_replica_selection()) {
+        is_suspected_dead = [this] (const gms::inet_address& ep) {
+            return remote().is_suspected_dead(ep);
+        };
+    }
+
+    return db::filter_for_query(cl, erm, std::move(live_endpoints), preferred_endpoints, repair_decision, gossiper, extra, cf, token,
+            is_suspected_dead);
 }
 
 inet_address_vector_replica_set
@@ -6220,8 +6866,8 @@ future<> storage_proxy::truncate_blocking(sstring keyspace, sstring cfname, std:
     return remote().send_truncate_blocking(std::move(keyspace), std::move(cfname), timeout_in_ms);
 }
 
-void storage_proxy::start_remote(netw::messaging_service& ms, gms::gossiper& g, migration_manager& mm) {
-    _remote = std::make_unique<struct remote>(*this, ms, g, mm);
+void storage_proxy::start_remote(netw::messaging_service& ms, gms::gossiper& g, migration_manager& mm, const raft_group_registry& raft_gr) {
+    _remote = std::make_unique<struct remote>(*this, ms, g, mm, raft_gr);
 }
 
 future<> storage_proxy::stop_remote() {
@@ -6319,19 +6965,16 @@ const db::hints::host_filter& storage_proxy::get_hints_host_filter() const {
     return _hints_manager.get_host_filter();
 }
 
-future<db::hints::sync_point> storage_proxy::create_hint_sync_point(const std::vector<gms::inet_address> target_hosts) const {
+future<db::hints::sync_point> storage_proxy::create_hint_sync_point(const std::vector<gms::inet_address> target_hosts) {
     db::hints::sync_point spoint;
     spoint.regular_per_shard_rps.resize(smp::count);
     spoint.mv_per_shard_rps.resize(smp::count);
     spoint.host_id = _db.local().get_config().host_id;
     co_await coroutine::parallel_for_each(boost::irange<unsigned>(0, smp::count), [this, &target_hosts, &spoint] (unsigned shard) -> future<> {
-        const auto& sharded_sp = container();
-        // sharded::invoke_on does not have a const-method version, so we cannot use it here
-        auto p = co_await smp::submit_to(shard, [&sharded_sp, &target_hosts] {
-            const storage_proxy& sp = sharded_sp.local();
-            auto regular_rp = sp._hints_manager.calculate_current_sync_point(target_hosts);
-            auto mv_rp = sp._hints_for_views_manager.calculate_current_sync_point(target_hosts);
-            return std::make_pair(std::move(regular_rp), std::move(mv_rp));
+        auto p = co_await container().invoke_on(shard, [&target_hosts] (storage_proxy& sp) -> future<std::pair<db::hints::sync_point::shard_rps, db::hints::sync_point::shard_rps>> {
+            auto regular_rp = co_await sp._hints_manager.calculate_current_sync_point(target_hosts);
+            auto mv_rp = co_await sp._hints_for_views_manager.calculate_current_sync_point(target_hosts);
+            co_return std::make_pair(std::move(regular_rp), std::move(mv_rp));
         });
         spoint.regular_per_shard_rps[shard] = std::move(p.first);
         spoint.mv_per_shard_rps[shard] = std::move(p.second);
@@ -6453,7 +7096,7 @@ future<> storage_proxy::drain_on_shutdown() {
 
 future<>
 storage_proxy::stop() {
-    return make_ready_future<>();
+    return _cross_shard_writes->stop();
 }
 
 locator::token_metadata_ptr storage_proxy::get_token_metadata_ptr() const noexcept {
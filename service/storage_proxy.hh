@@ -16,6 +16,7 @@
 #include <seastar/core/distributed.hh>
 #include <seastar/core/execution_stage.hh>
 #include <seastar/core/scheduling_specific.hh>
+#include <seastar/core/semaphore.hh>
 #include "db/read_repair_decision.hh"
 #include "db/write_type.hh"
 #include "db/hints/manager.hh"
@@ -24,6 +25,7 @@
 #include <seastar/core/metrics.hh>
 #include <seastar/rpc/rpc_types.hh>
 #include "storage_proxy_stats.hh"
+#include "replica_load_tracker.hh"
 #include "service_permit.hh"
 #include "cdc/stats.hh"
 #include "locator/abstract_replication_strategy.hh"
@@ -81,6 +83,7 @@ class mutation_holder;
 class view_update_write_response_handler;
 class client_state;
 class migration_manager;
+class raft_group_registry;
 struct hint_wrapper;
 struct read_repair_mutation;
 
@@ -259,6 +262,8 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     std::uniform_real_distribution<> _read_repair_chance = std::uniform_real_distribution<>(0,1);
     seastar::metrics::metric_groups _metrics;
     uint64_t _background_write_throttle_threahsold;
+    // Limits the deferred read repair writes in flight
+    semaphore _deferred_read_repair_sem;
     inheriting_concrete_execution_stage<
             future<result<>>,
             storage_proxy*,
@@ -272,11 +277,17 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
             lw_shared_ptr<cdc::operation_result_tracker>> _mutate_stage;
     db::view::node_update_backlog& _max_view_update_backlog;
     std::unordered_map<gms::inet_address, view_update_backlog_timestamped> _view_update_backlogs;
+    replica_load_tracker _replica_load;
+    retry_budget _speculative_retry_budget;
 
     //NOTICE(sarna): This opaque pointer is here just to avoid moving write handler class definitions from .cc to .hh. It's slow path.
     class cancellable_write_handlers_list;
     std::unique_ptr<cancellable_write_handlers_list> _cancellable_write_handlers_list;
 
+    // Batches the mutations applied on the other shards, see mutate_locally().
+    class cross_shard_writes;
+    std::unique_ptr<cross_shard_writes> _cross_shard_writes;
+
     /* This is a pointer to the shard-local part of the sharded cdc_service:
      * storage_proxy needs access to cdc_service to augument mutations.
      *
@@ -302,7 +313,10 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     response_id_type register_response_handler(shared_ptr<abstract_write_response_handler>&& h);
     void remove_response_handler(response_id_type id);
     void remove_response_handler_entry(response_handlers_map::iterator entry);
-    void got_response(response_id_type id, gms::inet_address from, std::optional<db::view::update_backlog> backlog);
+    // \p table_backlog is the view update backlog of the written table, when
+    // the replica reports it.
+    void got_response(response_id_type id, gms::inet_address from, std::optional<db::view::update_backlog> backlog,
+            std::optional<db::view::update_backlog> table_backlog);
     void got_failure_response(response_id_type id, gms::inet_address from, size_t count, std::optional<db::view::update_backlog> backlog, error err, std::optional<sstring> msg);
     future<result<>> response_wait(response_id_type id, clock_type::time_point timeout);
     ::shared_ptr<abstract_write_response_handler>& get_write_response_handler(storage_proxy::response_id_type id);
@@ -329,7 +343,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     db::hints::manager& hints_manager_for(db::write_type type);
     void sort_endpoints_by_proximity(const locator::topology& topo, inet_address_vector_replica_set& eps) const;
     inet_address_vector_replica_set get_endpoints_for_reading(const sstring& ks_name, const locator::effective_replication_map& erm, const dht::token& token) const;
-    inet_address_vector_replica_set filter_replicas_for_read(db::consistency_level, const locator::effective_replication_map&, inet_address_vector_replica_set live_endpoints, const inet_address_vector_replica_set& preferred_endpoints, db::read_repair_decision, std::optional<gms::inet_address>* extra, replica::column_family*) const;
+    inet_address_vector_replica_set filter_replicas_for_read(db::consistency_level, const locator::effective_replication_map&, inet_address_vector_replica_set live_endpoints, const inet_address_vector_replica_set& preferred_endpoints, db::read_repair_decision, std::optional<gms::inet_address>* extra, replica::column_family*, const dht::token* token = nullptr) const;
     // As above with read_repair_decision=NONE, extra=nullptr.
     inet_address_vector_replica_set filter_replicas_for_read(db::consistency_level, const locator::effective_replication_map&, const inet_address_vector_replica_set& live_endpoints, const inet_address_vector_replica_set& preferred_endpoints, replica::column_family*) const;
     bool is_alive(const gms::inet_address&) const;
@@ -396,6 +410,9 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     future<result<>> mutate_begin(unique_response_handler_vector ids, db::consistency_level cl, tracing::trace_state_ptr trace_state, std::optional<clock_type::time_point> timeout_opt = { });
     future<result<>> mutate_end(future<result<>> mutate_result, utils::latency_counter, write_stats& stats, tracing::trace_state_ptr trace_state);
     future<result<>> schedule_repair(locator::effective_replication_map_ptr ermp, std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> diffs, db::consistency_level cl, tracing::trace_state_ptr trace_state, service_permit permit);
+    // Writes the repair diffs in the background, or drops them if too many
+    // deferred repairs are in flight already
+    void schedule_deferred_repair(locator::effective_replication_map_ptr ermp, std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> diffs, db::consistency_level cl, tracing::trace_state_ptr trace_state);
     bool need_throttle_writes() const;
     void unthrottle();
     void handle_read_error(std::variant<exceptions::coordinator_exception_container, std::exception_ptr> failure, bool range);
@@ -428,10 +445,15 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
             is_cancellable);
 
     db::view::update_backlog get_view_update_backlog() const;
+    // The view update backlog of a base table on this shard, see table::get_view_update_backlog().
+    db::view::update_backlog get_view_update_backlog_of(table_id id) const;
 
     void maybe_update_view_backlog_of(gms::inet_address, std::optional<db::view::update_backlog>);
 
-    db::view::update_backlog get_backlog_of(gms::inet_address) const;
+    // The shard of replica `ep` owning `token`, for requests to be sent to it
+    // directly when internode connections are shard-aware. 0 if unknown, or
+    // if internode connections aren't shard-aware.
+    unsigned replica_shard_of(const locator::effective_replication_map& erm, const schema& s, gms::inet_address ep, const dht::token& token) const;
 
     template<typename Range>
     future<> mutate_counters(Range&& mutations, db::consistency_level cl, tracing::trace_state_ptr tr_state, service_permit permit, clock_type::time_point timeout);
@@ -487,7 +509,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     }
 
     // Start/stop the remote part of `storage_proxy` that is required for performing distributed queries.
-    void start_remote(netw::messaging_service&, gms::gossiper&, migration_manager&);
+    void start_remote(netw::messaging_service&, gms::gossiper&, migration_manager&, const raft_group_registry&);
     future<> stop_remote();
 
 private:
@@ -594,6 +616,10 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     // and use different RPC verb.
     future<> send_hint_to_endpoint(frozen_mutation_and_schema fm_a_s, gms::inet_address target);
 
+    // The last view update backlog of `ep` known to this node, used by hints
+    // to pace their replay.
+    db::view::update_backlog get_backlog_of(gms::inet_address ep) const;
+
     /**
      * Performs the truncate operatoin, which effectively deletes all data from
      * the column family cfname
@@ -659,7 +685,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     future<> change_hints_host_filter(db::hints::host_filter new_filter);
     const db::hints::host_filter& get_hints_host_filter() const;
 
-    future<db::hints::sync_point> create_hint_sync_point(const std::vector<gms::inet_address> target_hosts) const;
+    future<db::hints::sync_point> create_hint_sync_point(const std::vector<gms::inet_address> target_hosts);
     future<> wait_for_hint_sync_point(const db::hints::sync_point spoint, clock_type::time_point deadline);
 
     const stats& get_stats() const {
@@ -681,6 +707,14 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
         return _cdc_stats;
     }
 
+    replica_load_tracker& get_replica_load_tracker() noexcept {
+        return _replica_load;
+    }
+
+    retry_budget& get_speculative_retry_budget() noexcept {
+        return _speculative_retry_budget;
+    }
+
     scheduling_group_key get_stats_key() const {
         return _stats_key;
     }
@@ -107,6 +107,8 @@ struct write_stats {
     uint64_t cas_write_condition_not_met = 0;
     uint64_t cas_write_timeout_due_to_uncertainty = 0;
     uint64_t cas_failed_read_round_optimization = 0;
+    uint64_t cas_background_learns = 0;
+    uint16_t cas_now_learning_in_background = 0;
     uint16_t cas_now_pruning = 0;
     uint64_t cas_prune = 0;
     uint64_t cas_coordinator_dropped_prune = 0;
@@ -140,6 +142,8 @@ struct stats : public write_stats {
     uint64_t read_repair_attempts = 0;
     uint64_t read_repair_repaired_blocking = 0;
     uint64_t read_repair_repaired_background = 0;
+    uint64_t read_repair_deferred = 0;
+    uint64_t read_repair_deferred_dropped = 0;
     uint64_t global_read_repairs_canceled_due_to_concurrent_write = 0;
 
     // number of mutations received as a coordinator
@@ -158,6 +162,8 @@ struct stats : public write_stats {
     uint64_t replica_mutation_data_reads = 0;
 
     uint64_t replica_cross_shard_ops = 0;
+    // Cross-shard messages carrying batches of writes, see replica_cross_shard_ops.
+    uint64_t replica_cross_shard_write_batches = 0;
 
     utils::timed_rate_moving_average_summary_and_histogram read;
     utils::timed_rate_moving_average_summary_and_histogram range;
@@ -168,6 +174,11 @@ struct stats : public write_stats {
     uint64_t read_retries = 0; // read is retried with new limit
     uint64_t speculative_digest_reads = 0;
     uint64_t speculative_data_reads = 0;
+    uint64_t speculative_reads_over_budget = 0; // not sent, to stay within the retry budget
+
+    // mutations sent to replicas in MUTATION_BATCH messages, and the messages
+    uint64_t batched_mutations = 0;
+    uint64_t mutation_batches = 0;
 
     uint64_t cas_read_unfinished_commit = 0;
     uint64_t cas_foreground = 0;
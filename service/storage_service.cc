@@ -485,9 +485,10 @@ future<> storage_service::merge_topology_snapshot(raft_topology_snapshot snp) {
    muts.reserve(snp.topology_mutations.size() + (snp.cdc_generation_mutation ? 1 : 0));
    {
        auto s = _db.local().find_schema(db::system_keyspace::NAME, db::system_keyspace::TOPOLOGY);
-       boost::transform(snp.topology_mutations, std::back_inserter(muts), [s] (const canonical_mutation& m) {
-           return m.to_mutation(s);
-       });
+       for (const canonical_mutation& m : snp.topology_mutations) {
+           muts.push_back(m.to_mutation(s));
+           co_await coroutine::maybe_yield();
+       }
    }
    if (snp.cdc_generation_mutation) {
        auto s = _db.local().find_schema(db::system_keyspace::NAME, db::system_keyspace::CDC_GENERATIONS_V3);
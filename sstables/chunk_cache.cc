@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "chunk_cache.hh"
+
+namespace sstables {
+
+chunk_cache& chunk_cache::local() noexcept {
+    static thread_local chunk_cache cache;
+    return cache;
+}
+
+void chunk_cache::evict_to(size_t bytes) noexcept {
+    while (_stats.bytes > bytes && !_lru.empty()) {
+        auto& e = _lru.back();
+        _stats.bytes -= e.buf.size();
+        _stats.evictions++;
+        _index.erase(e.k);
+        _lru.pop_back();
+    }
+}
+
+void chunk_cache::set_capacity(size_t bytes) noexcept {
+    _capacity = bytes;
+    evict_to(_capacity);
+}
+
+temporary_buffer<char> chunk_cache::get(uint64_t id, uint64_t chunk_start) noexcept {
+    auto it = _index.find(key{id, chunk_start});
+    if (it == _index.end()) {
+        _stats.misses++;
+        return {};
+    }
+    _stats.hits++;
+    _lru.splice(_lru.begin(), _lru, it->second);
+    return it->second->buf.share();
+}
+
+void chunk_cache::put(uint64_t id, uint64_t chunk_start, temporary_buffer<char>& buf) {
+    if (buf.size() > _capacity) {
+        return;
+    }
+    auto k = key{id, chunk_start};
+    if (_index.contains(k)) {
+        return;
+    }
+    evict_to(_capacity - buf.size());
+    _lru.push_front(entry{k, buf.share()});
+    try {
+        _index.emplace(k, _lru.begin());
+    } catch (...) {
+        _lru.pop_front();
+        throw;
+    }
+    _stats.bytes += buf.size();
+}
+
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/temporary_buffer.hh>
+
+#include <list>
+#include <unordered_map>
+
+using namespace seastar;
+
+namespace sstables {
+
+/// A per-shard cache of decompressed chunks of compressed Data components.
+///
+/// Compressed reads covering a chunk or two, that is point reads, look the
+/// chunks up here before reading and decompressing them, so reads with
+/// locality decompress each chunk once. Scans bypass the cache.
+///
+/// Chunks are keyed by compression::cache_id() and their position in the
+/// compressed file. Cache ids are never reused, so the chunks of deleted
+/// sstables are simply evicted in LRU order, like any other chunk.
+class chunk_cache {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t bytes = 0;
+    };
+private:
+    struct key {
+        uint64_t id;
+        uint64_t chunk_start;
+        bool operator==(const key&) const = default;
+    };
+    struct key_hash {
+        size_t operator()(const key& k) const noexcept {
+            return std::hash<uint64_t>()(k.id) ^ (std::hash<uint64_t>()(k.chunk_start) << 1);
+        }
+    };
+    struct entry {
+        key k;
+        temporary_buffer<char> buf;
+    };
+
+    // Most recently used first
+    std::list<entry> _lru;
+    std::unordered_map<key, std::list<entry>::iterator, key_hash> _index;
+    size_t _capacity = 0;
+    stats _stats;
+
+    void evict_to(size_t bytes) noexcept;
+public:
+    bool enabled() const noexcept {
+        return _capacity != 0;
+    }
+    void set_capacity(size_t bytes) noexcept;
+
+    // Returns a buffer sharing the cached chunk, or an empty one on a miss.
+    temporary_buffer<char> get(uint64_t id, uint64_t chunk_start) noexcept;
+    // Keeps a share of buf, which must hold the whole decompressed chunk.
+    void put(uint64_t id, uint64_t chunk_start, temporary_buffer<char>& buf);
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+
+    static chunk_cache& local() noexcept;
+};
+
+}
@@ -14,6 +14,7 @@
 #include <seastar/core/bitops.hh>
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/fstream.hh>
+#include <seastar/core/smp.hh>
 
 #include "../compress.hh"
 #include "compress.hh"
@@ -22,6 +23,7 @@
 #include "segmented_compress_params.hh"
 #include "utils/class_registrator.hh"
 #include "reader_permit.hh"
+#include "chunk_cache.hh"
 
 namespace sstables {
 
@@ -331,20 +333,39 @@ compression::locate(uint64_t position, const compression::segmented_offsets::acc
     return { chunk_start, chunk_end - chunk_start, chunk_offset };
 }
 
+uint64_t compression::next_cache_id() noexcept {
+    static thread_local uint64_t next = 0;
+    return (uint64_t(this_shard_id()) << 48) | next++;
+}
+
 }
 
 template <typename ChecksumType>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_source_impl : public data_source_impl {
+    // Reads covering at most this many chunks go through the chunk_cache
+    static constexpr uint64_t max_cached_read_chunks = 2;
+
     std::optional<input_stream<char>> _input_stream;
     sstables::compression* _compression_metadata;
     sstables::compression::segmented_offsets::accessor _offsets;
     sstables::local_compression _compression;
     reader_permit _permit;
     uint64_t _underlying_pos;
+    // Position of _input_stream, behind _underlying_pos after chunks
+    // served from the chunk_cache
+    uint64_t _stream_pos;
     uint64_t _pos;
     uint64_t _beg_pos;
     uint64_t _end_pos;
+    bool _use_cache = false;
+
+    temporary_buffer<char> serve(temporary_buffer<char> out, const sstables::compression::chunk_and_offset& addr) {
+        out.trim_front(addr.offset);
+        _pos += out.size();
+        _underlying_pos += addr.chunk_len;
+        return out;
+    }
 public:
     compressed_file_data_source_impl(file f, sstables::compression* cm,
                 uint64_t pos, size_t len, file_input_stream_options options, reader_permit permit)
@@ -377,7 +398,10 @@ class compressed_file_data_source_impl : public data_source_impl {
                 end.chunk_start + end.chunk_len - start.chunk_start,
                 std::move(options));
         _underlying_pos = start.chunk_start;
+        _stream_pos = start.chunk_start;
         _pos = _beg_pos;
+        auto chunk_len = _compression_metadata->uncompressed_chunk_length();
+        _use_cache = chunk_cache::local().enabled() && (_end_pos - 1) / chunk_len - _beg_pos / chunk_len < max_cached_read_chunks;
     }
     virtual future<temporary_buffer<char>> get() override {
         if (_pos >= _end_pos) {
@@ -392,7 +416,16 @@ class compressed_file_data_source_impl : public data_source_impl {
         if (!addr.chunk_len) {
             throw sstables::malformed_sstable_exception(format("compressed chunk_len must be greater than zero, chunk_start={}", addr.chunk_start));
         }
-        return _input_stream->read_exactly(addr.chunk_len).then([this, addr](temporary_buffer<char> buf) {
+        if (_use_cache) {
+            if (auto cached = chunk_cache::local().get(_compression_metadata->cache_id(), addr.chunk_start)) {
+                return make_ready_future<temporary_buffer<char>>(serve(std::move(cached), addr));
+            }
+        }
+        auto skip = _stream_pos < addr.chunk_start ? _input_stream->skip(addr.chunk_start - _stream_pos) : make_ready_future<>();
+        _stream_pos = addr.chunk_start + addr.chunk_len;
+        return skip.then([this, addr] {
+            return _input_stream->read_exactly(addr.chunk_len);
+        }).then([this, addr](temporary_buffer<char> buf) {
             if (buf.size() != addr.chunk_len) {
                 throw sstables::malformed_sstable_exception(format("compressed reader hit premature end-of-file at file offset {}, expected chunk_len={}, actual={}", _underlying_pos, addr.chunk_len, buf.size()));
             }
@@ -419,11 +452,11 @@ class compressed_file_data_source_impl : public data_source_impl {
                 auto len = _compression.uncompress(buf.get(), compressed_len, out.get_write(), out.size());
 
                 out.trim(len);
-                out.trim_front(addr.offset);
-                _pos += out.size();
-                _underlying_pos += addr.chunk_len;
+                if (_use_cache) {
+                    chunk_cache::local().put(_compression_metadata->cache_id(), addr.chunk_start, out);
+                }
 
-                return make_tracked_temporary_buffer(std::move(out), std::move(res_units));
+                return make_tracked_temporary_buffer(serve(std::move(out), addr), std::move(res_units));
             });
         });
     }
@@ -442,8 +475,9 @@ class compressed_file_data_source_impl : public data_source_impl {
             return make_ready_future<temporary_buffer<char>>();
         }
         auto addr = _compression_metadata->locate(_pos, _offsets);
-        auto underlying_n = addr.chunk_start - _underlying_pos;
+        auto underlying_n = addr.chunk_start - _stream_pos;
         _underlying_pos = addr.chunk_start;
+        _stream_pos = addr.chunk_start;
         _beg_pos = _pos;
         return _input_stream->skip(underlying_n).then([] {
             return make_ready_future<temporary_buffer<char>>();
@@ -490,26 +524,38 @@ class compressed_file_data_sink_impl : public data_sink_impl {
     sstables::compression* _compression_metadata;
     sstables::compression::segmented_offsets::writer _offsets;
     sstables::local_compression _compression;
+    lw_shared_ptr<sstables::compression_chunk_sampler> _sampler;
+    // Reused for the compressed chunks. The stream writing them copies them
+    // before put() resolves, and the stream feeding us doesn't put() again
+    // before that, so one buffer is enough.
+    temporary_buffer<char> _compressed;
     size_t _pos = 0;
     uint32_t _full_checksum;
 public:
-    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
+    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc,
+            lw_shared_ptr<sstables::compression_chunk_sampler> sampler)
             : _out(std::move(out))
             , _compression_metadata(cm)
             , _offsets(_compression_metadata->offsets.get_writer())
             , _compression(lc)
+            , _sampler(std::move(sampler))
             , _full_checksum(ChecksumType::init_checksum())
     {}
 
     virtual future<> put(net::packet data) override { abort(); }
     virtual future<> put(temporary_buffer<char> buf) override {
+        if (_sampler) {
+            _sampler->sample(buf.get(), buf.size());
+        }
         auto output_len = _compression.compress_max_size(buf.size());
 
         // account space for checksum that goes after compressed data.
-        temporary_buffer<char> compressed(output_len + 4);
+        if (_compressed.size() < output_len + 4) {
+            _compressed = temporary_buffer<char>(output_len + 4);
+        }
 
         // compress flushed data.
-        auto len = _compression.compress(buf.get(), buf.size(), compressed.get_write(), output_len);
+        auto len = _compression.compress(buf.get(), buf.size(), _compressed.get_write(), output_len);
         if (len > output_len) {
             return make_exception_future(std::runtime_error("possible overflow during compression"));
         }
@@ -523,11 +569,11 @@ class compressed_file_data_sink_impl : public data_sink_impl {
         _compression_metadata->set_compressed_file_length(_pos);
 
         // compute 32-bit checksum for compressed data.
-        uint32_t per_chunk_checksum = ChecksumType::checksum(compressed.get(), len);
-        _full_checksum = checksum_combine_or_feed<ChecksumType>(_full_checksum, per_chunk_checksum, compressed.get(), len);
+        uint32_t per_chunk_checksum = ChecksumType::checksum(_compressed.get(), len);
+        _full_checksum = checksum_combine_or_feed<ChecksumType>(_full_checksum, per_chunk_checksum, _compressed.get(), len);
 
         // write checksum into buffer after compressed data.
-        write_be<uint32_t>(compressed.get_write() + len, per_chunk_checksum);
+        write_be<uint32_t>(_compressed.get_write() + len, per_chunk_checksum);
 
         if constexpr (mode == compressed_checksum_mode::checksum_all) {
             uint32_t be_per_chunk_checksum = cpu_to_be(per_chunk_checksum);
@@ -537,10 +583,7 @@ class compressed_file_data_sink_impl : public data_sink_impl {
 
         _compression_metadata->set_full_checksum(_full_checksum);
 
-        compressed.trim(len + 4);
-
-        auto f = _out.write(compressed.get(), compressed.size());
-        return f.then([compressed = std::move(compressed)] {});
+        return _out.write(_compressed.get(), len + 4);
     }
     virtual future<> close() override {
         return _out.close();
@@ -555,28 +598,32 @@ template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_sink : public data_sink {
 public:
-    compressed_file_data_sink(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
+    compressed_file_data_sink(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc,
+            lw_shared_ptr<sstables::compression_chunk_sampler> sampler)
         : data_sink(std::make_unique<compressed_file_data_sink_impl<ChecksumType, mode>>(
-                std::move(out), cm, std::move(lc))) {}
+                std::move(out), cm, std::move(lc), std::move(sampler))) {}
 };
 
 template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 inline output_stream<char> make_compressed_file_output_stream(output_stream<char> out,
          sstables::compression* cm,
-         const compression_parameters& cp) {
+         const compression_parameters& cp,
+         compressor_ptr compressor,
+         lw_shared_ptr<sstables::compression_chunk_sampler> sampler,
+         std::optional<unsigned> chunk_length) {
     // buffer of output stream is set to chunk length, because flush must
     // happen every time a chunk was filled up.
 
-    auto p = cp.get_compressor();
+    auto p = compressor ? std::move(compressor) : cp.get_compressor();
     cm->set_compressor(p);
-    cm->set_uncompressed_chunk_length(cp.chunk_length());
+    cm->set_uncompressed_chunk_length(chunk_length.value_or(cp.chunk_length()));
     // FIXME: crc_check_chance can be configured by the user.
     // probability to verify the checksum of a compressed chunk we read.
     // defaults to 1.0.
     cm->options.elements.push_back({{"crc_check_chance"}, {"1.0"}});
 
-    return output_stream<char>(compressed_file_data_sink<ChecksumType, mode>(std::move(out), cm, p));
+    return output_stream<char>(compressed_file_data_sink<ChecksumType, mode>(std::move(out), cm, p, std::move(sampler)));
 }
 
 input_stream<char> sstables::make_compressed_file_k_l_format_input_stream(file f,
@@ -594,8 +641,11 @@ input_stream<char> sstables::make_compressed_file_m_format_input_stream(file f,
 
 output_stream<char> sstables::make_compressed_file_m_format_output_stream(output_stream<char> out,
         sstables::compression* cm,
-        const compression_parameters& cp) {
+        const compression_parameters& cp,
+        compressor_ptr compressor,
+        lw_shared_ptr<compression_chunk_sampler> sampler,
+        std::optional<unsigned> chunk_length) {
     return make_compressed_file_output_stream<crc32_utils, compressed_checksum_mode::checksum_all>(
-            std::move(out), cm, cp);
+            std::move(out), cm, cp, std::move(compressor), std::move(sampler), chunk_length);
 }
 
@@ -33,14 +33,17 @@
 // are read using O_DIRECT), nor uncompressed data. We intend to cache high-
 // level Cassandra rows, not disk blocks.
 
+#include <array>
 #include <vector>
 #include <cstdint>
 #include <iterator>
+#include <utility>
 
 #include <seastar/core/file.hh>
 #include <seastar/core/seastar.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/fstream.hh>
+#include <seastar/core/bitops.hh>
 
 #include "types/types.hh"
 #include "sstables/types.hh"
@@ -57,6 +60,95 @@ namespace sstables {
 
 struct compression;
 
+// Collects a bounded sample of the uncompressed chunks written by compressed
+// sstable writers, to train compression dictionaries from
+// (see compressor::train_dictionary()).
+class compression_chunk_sampler {
+    size_t _max_bytes;
+    unsigned _period;
+    uint64_t _chunks_seen = 0;
+    size_t _bytes = 0;
+    std::vector<sstring> _samples;
+public:
+    // Longer chunks are truncated, dictionaries mostly help with
+    // matches close to the start of a chunk anyway.
+    static constexpr size_t max_sample_size = 4096;
+
+    // Samples one of every `period` chunks, until `max_bytes` are collected.
+    compression_chunk_sampler(size_t max_bytes, unsigned period)
+        : _max_bytes(max_bytes), _period(std::max(period, 1u)) {}
+
+    void sample(const char* data, size_t size) {
+        if (full() || _chunks_seen++ % _period) {
+            return;
+        }
+        auto len = std::min(size, max_sample_size);
+        _samples.emplace_back(data, len);
+        _bytes += len;
+    }
+
+    bool full() const noexcept {
+        return _bytes >= _max_bytes;
+    }
+
+    const std::vector<sstring>& samples() const noexcept {
+        return _samples;
+    }
+
+    void reset() noexcept {
+        _samples.clear();
+        _bytes = 0;
+    }
+
+    // Returns the samples and starts over.
+    std::vector<sstring> release_samples() noexcept {
+        _bytes = 0;
+        return std::exchange(_samples, {});
+    }
+};
+
+// The distribution of the sizes of the data file reads of a table's sstables,
+// in power-of-two buckets, to pick the compression chunk length of its next
+// sstables. Older reads are forgotten progressively, by halving the counts.
+class read_size_histogram {
+public:
+    static constexpr unsigned min_size_log2 = 10; // 1KiB
+    static constexpr unsigned nr_buckets = 11; // up to 1MiB and larger
+    // The counts are halved when they reach this many reads.
+    static constexpr uint64_t max_reads = 64 * 1024;
+private:
+    std::array<uint64_t, nr_buckets> _buckets = {};
+    uint64_t _reads = 0;
+public:
+    void add(uint64_t size) noexcept {
+        unsigned log2 = size > 1 ? log2ceil(size) : 0;
+        _buckets[std::min(std::max(log2, min_size_log2) - min_size_log2, nr_buckets - 1)]++;
+        if (++_reads >= max_reads) {
+            _reads = 0;
+            for (auto& b : _buckets) {
+                b /= 2;
+                _reads += b;
+            }
+        }
+    }
+
+    uint64_t reads() const noexcept {
+        return _reads;
+    }
+
+    // The smallest power of two not below the median read size, 0 if there were no reads.
+    uint64_t median() const noexcept {
+        uint64_t seen = 0;
+        for (unsigned i = 0; i < nr_buckets; ++i) {
+            seen += _buckets[i];
+            if (seen * 2 >= _reads && seen) {
+                return uint64_t(1) << (min_size_log2 + i);
+            }
+        }
+        return 0;
+    }
+};
+
 struct compression {
     // To reduce the memory footpring of compression-info, n offsets are grouped
     // together into segments, where each segment stores a base absolute offset
@@ -299,7 +391,15 @@ struct compression {
     // Variables *not* found in the "Compression Info" file (added by update()):
     uint64_t _compressed_file_length = 0;
     uint32_t _full_checksum = 0;
+    uint64_t _cache_id = next_cache_id();
+
+    static uint64_t next_cache_id() noexcept;
 public:
+    // Identifies the chunks of this component in the chunk_cache. Unique
+    // across shards, and never reused.
+    uint64_t cache_id() const noexcept {
+        return _cache_id;
+    }
     // Set the compressor algorithm, please check the definition of enum compressor.
     void set_compressor(compressor_ptr c);
     // After changing _compression, update() must be called to update
@@ -375,9 +475,14 @@ input_stream<char> make_compressed_file_m_format_input_stream(file f,
                 sstables::compression* cm, uint64_t offset, size_t len,
                 class file_input_stream_options options, reader_permit permit);
 
+// If `compressor` is set, it's used instead of the compressor of `cp`.
+// If `sampler` is set, the uncompressed chunks are passed to it.
 output_stream<char> make_compressed_file_m_format_output_stream(output_stream<char> out,
                 sstables::compression* cm,
-                const compression_parameters& cp);
+                const compression_parameters& cp,
+                compressor_ptr compressor = {},
+                lw_shared_ptr<compression_chunk_sampler> sampler = {},
+                std::optional<unsigned> chunk_length = {});
 
 }
 
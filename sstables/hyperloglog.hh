@@ -89,6 +89,20 @@ static inline size_t write_unsigned_var_int(unsigned int value, uint8_t* to) {
     return size;
 }
 
+static inline size_t read_unsigned_var_int(const uint8_t* from, const uint8_t* end, unsigned int& value) {
+    size_t size = 0;
+    value = 0;
+    while (from + size < end && size < 5) {
+        uint8_t byte = from[size];
+        value |= unsigned(byte & 0x7F) << (7 * size);
+        size++;
+        if (!(byte & 0x80)) {
+            return size;
+        }
+    }
+    throw std::runtime_error("malformed cardinality metadata");
+}
+
 /** @class HyperLogLog
  *  @brief Implement of 'HyperLogLog' estimate cardinality algorithm
  */
@@ -128,11 +142,37 @@ class HyperLogLog {
         alphaMM_ = alpha * m_ * m_;
     }
 
+    /**
+     * Restores an estimator from the format written by get_bytes(), e.g.
+     * the cardinality of the compaction metadata.
+     *
+     * @exception std::runtime_error the format is not supported.
+     */
     static HyperLogLog from_bytes(temporary_buffer<uint8_t> bytes) {
-        // FIXME: implement class that creates a HyperLogLog from an array of bytes.
-        // This will useful if we need to work with the cardinality data from the
-        // compaction metadata.
-        abort();
+        static constexpr int version = 2;
+
+        const uint8_t* p = bytes.get();
+        const uint8_t* end = p + bytes.size();
+        if (bytes.size() < sizeof(int) || read_be<int32_t>(reinterpret_cast<const char*>(p)) != -version) {
+            throw std::runtime_error("unsupported cardinality metadata version");
+        }
+        p += sizeof(int);
+
+        unsigned int b, sp, type, size;
+        p += read_unsigned_var_int(p, end, b);
+        p += read_unsigned_var_int(p, end, sp);
+        p += read_unsigned_var_int(p, end, type);
+        p += read_unsigned_var_int(p, end, size);
+        // FIXME: add support to SPARSE format.
+        if (type != 0) {
+            throw std::runtime_error("unsupported cardinality metadata type");
+        }
+        if (b < 4 || 16 < b || size != (1u << b) || size_t(end - p) < size) {
+            throw std::runtime_error("malformed cardinality metadata");
+        }
+        HyperLogLog hll(b);
+        memcpy(hll.M_.data(), p, size);
+        return hll;
     }
 
     /**
@@ -375,6 +375,22 @@ class index_comparator {
     }
 };
 
+// Returns the index of the first summary entry at or after `from` which is
+// not less than rp. Entries are first narrowed down by their raw tokens,
+// which compare as plain integers, so decorated keys are only built and
+// compared for the few entries sharing the token of rp.
+inline size_t summary_lower_bound(const summary& sum, size_t from, dht::ring_position_view rp, const schema& s) {
+    auto& entries = sum.entries;
+    auto first = entries.begin() + from;
+    auto last = entries.end();
+    if (rp.token()._kind == dht::token::kind::key) {
+        auto token = rp.token().raw();
+        first = std::partition_point(first, last, [token] (const summary_entry& e) { return e.raw_token < token; });
+        last = std::partition_point(first, last, [token] (const summary_entry& e) { return e.raw_token == token; });
+    }
+    return std::distance(entries.begin(), std::lower_bound(first, last, rp, index_comparator(s)));
+}
+
 // Stores information about open end RT marker
 // of the lower index bound
 struct open_rt_marker {
@@ -637,8 +653,7 @@ class index_reader {
         }
 
         auto& summary = _sstable->get_summary();
-        bound.previous_summary_idx = std::distance(std::begin(summary.entries),
-            std::lower_bound(summary.entries.begin() + bound.previous_summary_idx, summary.entries.end(), pos, index_comparator(*_sstable->_schema)));
+        bound.previous_summary_idx = summary_lower_bound(summary, bound.previous_summary_idx, pos, *_sstable->_schema);
 
         if (bound.previous_summary_idx == 0) {
             sstlog.trace("index {}: first entry", fmt::ptr(this));
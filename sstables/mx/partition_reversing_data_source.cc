@@ -8,6 +8,7 @@
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/iostream.hh>
+#include <seastar/coroutine/as_future.hh>
 #include "partition_reversing_data_source.hh"
 #include "reader_permit.hh"
 #include "sstables/consumer.hh"
@@ -385,6 +386,13 @@ class partition_reversing_data_source_impl final : public data_source_impl {
     uint64_t _current_read_size = 4 * 1024;
     const uint64_t max_read_size = 128 * 1024;
 
+    // Read of the bytes preceding _cached_read, issued when _cached_read is
+    // filled so that it's (at least partly) done by the time the rows in
+    // _cached_read are consumed.
+    std::optional<future<temporary_buffer<char>>> _prefetch;
+    uint64_t _prefetch_start = 0;
+    uint64_t _prefetch_end = 0;
+
     column_translation _cached_column_translation;
 
     enum class state {
@@ -407,14 +415,39 @@ class partition_reversing_data_source_impl final : public data_source_impl {
     future<temporary_buffer<char>> data_read(uint64_t start, uint64_t end) {
         return _sst->data_read(start, end - start, _permit);
     }
+    void start_prefetch() {
+        auto cached_start = _row_end - _cached_read.size();
+        if (cached_start <= _clustering_range_start) {
+            return;
+        }
+        _prefetch_start = cached_start - std::min(_current_read_size, cached_start - _clustering_range_start);
+        _prefetch_end = cached_start;
+        _prefetch = data_read(_prefetch_start, _prefetch_end);
+    }
+    future<> drop_prefetch() noexcept {
+        if (_prefetch) {
+            auto f = co_await coroutine::as_future(std::move(*std::exchange(_prefetch, std::nullopt)));
+            f.ignore_ready_future();
+        }
+    }
     future<input_stream<char>> last_row_stream(size_t row_size) {
         if (_cached_read.size() < row_size) {
-            if (_clustering_range_start + _current_read_size < _row_end) {
-                _cached_read = co_await data_read(std::min(_row_end - _current_read_size, _row_end - row_size), _row_end);
+            auto cached_start = _row_end - _cached_read.size();
+            if (_prefetch && _prefetch_end == cached_start && _prefetch_start <= _row_end - row_size) {
+                auto prefetched = co_await std::exchange(_prefetch, std::nullopt).value();
+                temporary_buffer<char> buf(prefetched.size() + _cached_read.size());
+                std::copy(_cached_read.begin(), _cached_read.end(), std::copy(prefetched.begin(), prefetched.end(), buf.get_write()));
+                _cached_read = std::move(buf);
             } else {
-                _cached_read = co_await data_read(_clustering_range_start, _row_end);
+                co_await drop_prefetch();
+                if (_clustering_range_start + _current_read_size < _row_end) {
+                    _cached_read = co_await data_read(std::min(_row_end - _current_read_size, _row_end - row_size), _row_end);
+                } else {
+                    _cached_read = co_await data_read(_clustering_range_start, _row_end);
+                }
             }
             _current_read_size = std::min(max_read_size, _current_read_size * 2);
+            start_prefetch();
         }
         co_return make_buffer_input_stream(_cached_read.share(_cached_read.size() - row_size, row_size));
     }
@@ -589,6 +622,7 @@ class partition_reversing_data_source_impl final : public data_source_impl {
 
     // Must not be run concurrently with `get()`.
     virtual future<> close() noexcept override {
+        co_await drop_prefetch();
         auto close_partition_header_context = _partition_header_context ? _partition_header_context->close() : make_ready_future<>();
         auto close_row_skipping_context = _row_skipping_context ? _row_skipping_context->close() : make_ready_future();
         co_await when_all(std::move(close_partition_header_context), std::move(close_row_skipping_context));
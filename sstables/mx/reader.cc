@@ -1298,6 +1298,15 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
     // of the reversing data source used underneath (see `partition_reversing_data_source`).
     // Engaged after `_context` is engaged, i.e. after `initialize()`.
     const uint64_t* _reversed_read_sstable_position;
+    // The position of the current partition in the data file, for the resume
+    // hint saved when closing a range read, see sstable::save_resume_hint().
+    uint64_t _partition_data_start = 0;
+    // The end of the data file range of _pr.
+    uint64_t _data_end = 0;
+    // Whether the range read moved past _pr with fast_forward_to().
+    bool _range_forwarded = false;
+    // Where the read of the data file started, for sstable::on_data_read().
+    uint64_t _data_read_start = 0;
 public:
     mx_sstable_mutation_reader(shared_sstable sst,
                             schema_ptr schema,
@@ -1410,6 +1419,7 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
             throw malformed_sstable_exception(format("consumer not at partition boundary, position: {}",
                                                      position_in_partition_view::printer(*_schema, _consumer.position())), _sst->get_filename());
         }
+        _partition_data_start = _context->position();
 
         // It's better to obtain partition information from the index if we already have it.
         // We can save on IO if the user will skip past the front of partition immediately.
@@ -1532,11 +1542,26 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
             }
         } else {
             _sst->get_stats().on_range_partition_read();
+            // A read resuming where an evicted one stopped can start there
+            // right away. The index is looked up lazily, if needed at all.
+            if (auto drr = _sst->take_resume_hint(_pr)) {
+                _sst->get_stats().on_resumed_range_partition_read();
+                auto last_end = _fwd_mr ? _sst->data_size() : drr->end;
+                _read_enabled = bool(*drr);
+                _data_end = drr->end;
+                _data_read_start = drr->start;
+                _context = data_consume_rows<DataConsumeRowsContext>(*_schema, _sst, _consumer, *drr, last_end);
+                _monitor.on_read_started(_context->reader_position());
+                _index_in_current_partition = false;
+                _will_likely_slice = will_likely_slice(_slice);
+                co_return;
+            }
             co_await get_index_reader().advance_to(_pr);
         }
 
         auto [begin, end] = _index_reader->data_file_positions();
         assert(end);
+        _data_read_start = begin;
 
         if (_single_partition_read) {
             _read_enabled = (begin != *end);
@@ -1552,6 +1577,7 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
             sstable::disk_read_range drr{begin, *end};
             auto last_end = _fwd_mr ? _sst->data_size() : drr.end;
             _read_enabled = bool(drr);
+            _data_end = drr.end;
             _context = data_consume_rows<DataConsumeRowsContext>(*_schema, _sst, _consumer, std::move(drr), last_end);
         }
 
@@ -1576,6 +1602,25 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
     bool reversed() const {
         return _slice.is_reversed();
     }
+    // Lets the read resuming this one, if it's evicted, start at the current
+    // partition, or the next one if this one was read entirely.
+    void save_resume_hint() noexcept {
+        if (_single_partition_read || _range_forwarded || _end_of_stream || !_read_enabled || !_current_partition_key) {
+            return;
+        }
+        const bool after_key = _consumer.is_mutation_end();
+        try {
+            _sst->save_resume_hint(sstable::resume_hint{
+                .key = *_current_partition_key,
+                .after_key = after_key,
+                .data_start = after_key ? _context->position() : _partition_data_start,
+                .end = _pr.end(),
+                .data_end = _data_end,
+            });
+        } catch (...) {
+            // Only an optimization of the next read
+        }
+    }
 public:
     void on_out_of_clustering_range() override {
         if (_fwd == streamed_mutation::forwarding::yes) {
@@ -1600,8 +1645,8 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
                 _partition_finished = true;
                 _before_partition = true;
                 _end_of_stream = false;
-                assert(_index_reader);
-                auto f1 = _index_reader->advance_to(pr);
+                _range_forwarded = true;
+                auto f1 = get_index_reader().advance_to(pr);
                 return f1.then([this] {
                     auto [start, end] = _index_reader->data_file_positions();
                     assert(end);
@@ -1689,6 +1734,10 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
     virtual future<> close() noexcept override {
         auto close_context = make_ready_future<>();
         if (_context) {
+            save_resume_hint();
+            if (!reversed() && _context->position() > _data_read_start) {
+                _sst->on_data_read(_context->position() - _data_read_start);
+            }
             _monitor.on_read_completed();
             // move _context to prevent double-close from destructor.
             close_context = _context->close().finally([_ = std::move(_context)] {});
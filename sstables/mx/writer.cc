@@ -795,7 +795,11 @@ class writer : public sstable_writer::writer_impl {
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
-        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format);
+        if (_cfg.split_block_bloom_filter) {
+            _sst._components->filter = utils::i_filter::get_split_block_filter(estimated_partitions, _schema.bloom_filter_fp_chance());
+        } else {
+            _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format);
+        }
         _pi_write_m.promoted_index_block_size = cfg.promoted_index_block_size;
         _pi_write_m.promoted_index_auto_scale_threshold = cfg.promoted_index_auto_scale_threshold;
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
@@ -883,7 +887,10 @@ void writer::init_file_writers() {
             make_compressed_file_m_format_output_stream(
                 output_stream<char>(std::move(out)),
                 &_sst._components->compression,
-                _schema.get_compressor_params()), _sst.filename(component_type::Data));
+                _schema.get_compressor_params(),
+                _cfg.compressor,
+                _cfg.compression_sampler,
+                _cfg.compression_chunk_length), _sst.filename(component_type::Data));
     }
 
     out = _sst._storage->make_data_or_index_sink(_sst, component_type::Index).get0();
@@ -1461,6 +1468,9 @@ void writer::consume_end_of_stream() {
     _sst.write_statistics();
     _sst.write_compression();
     auto features = sstable_enabled_features::all();
+    if (!_cfg.split_block_bloom_filter) {
+        features.disable(sstable_feature::SplitBlockBloomFilter);
+    }
     run_identifier identifier{_run_identifier};
     std::optional<scylla_metadata::large_data_stats> ld_stats(scylla_metadata::large_data_stats{
         .map = {
@@ -38,6 +38,7 @@ class partition_index_cache {
         key_type _key;
         std::variant<lw_shared_ptr<shared_promise<>>, partition_index_page> _page;
         size_t _size_in_allocator = 0;
+        bool _lru_protected = false;
     public:
         entry(partition_index_cache* parent, key_type key)
                 : _parent(parent)
@@ -65,6 +66,12 @@ class partition_index_cache {
 
         void on_evicted() noexcept override;
 
+        bool lru_protected() const noexcept override { return _lru_protected; }
+        bool set_lru_protected(bool v) noexcept override {
+            _lru_protected = v;
+            return true;
+        }
+
         // Returns the amount of memory owned by this entry.
         // Always returns the same value for a given state of _page.
         size_t size_in_allocator() const { return _size_in_allocator; }
@@ -113,6 +120,7 @@ class partition_index_cache {
         {
             if (_ref->is_linked()) {
                 _ref->_parent->_lru.remove(*_ref);
+                _ref->_parent->_lru.mark_referenced(*_ref);
             }
         }
         ~entry_ptr() { *this = nullptr; }
@@ -137,6 +137,8 @@ future<sstables::shared_sstable> sstable_directory::load_sstable(sstables::entry
     if (flags.need_mutate_level) {
         dirlog.trace("Mutating {} to level 0\n", sst->get_filename());
         co_await sst->mutate_sstable_level(0);
+        // Sstables coming from elsewhere weren't repaired with this node's replicas.
+        co_await sst->mutate_repaired_at(0);
     }
     co_return sst;
 }
@@ -255,6 +255,35 @@ partitioned_sstable_set::query(const dht::partition_range& range) const {
     }
 }
 
+void partitioned_sstable_set::update_unleveled_index(size_t from) noexcept {
+    for (auto i = from; i < _unleveled_sstables.size(); ++i) {
+        auto& e = _unleveled_index[i];
+        e.first = _unleveled_sstables[i]->get_first_decorated_key().token();
+        e.last = _unleveled_sstables[i]->get_last_decorated_key().token();
+        e.max_last = i ? std::max(_unleveled_index[i - 1].max_last, e.last) : e.last;
+    }
+}
+
+std::vector<shared_sstable> partitioned_sstable_set::select_unleveled(const dht::partition_range& range) const {
+    auto begin = _unleveled_index.begin();
+    auto end = _unleveled_index.end();
+    std::optional<dht::token> start;
+    if (range.start()) {
+        start = range.start()->value().token();
+        begin = std::ranges::lower_bound(begin, end, *start, std::less<>(), &unleveled_index_entry::max_last);
+    }
+    if (range.end()) {
+        end = std::ranges::upper_bound(begin, end, range.end()->value().token(), std::less<>(), &unleveled_index_entry::first);
+    }
+    std::vector<shared_sstable> r;
+    for (auto it = begin; it != end; ++it) {
+        if (!start || it->last >= *start) {
+            r.push_back(_unleveled_sstables[it - _unleveled_index.begin()]);
+        }
+    }
+    return r;
+}
+
 bool partitioned_sstable_set::store_as_unleveled(const shared_sstable& sst) const {
     return _use_level_metadata && sst->get_sstable_level() == 0;
 }
@@ -299,6 +328,8 @@ partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::v
         , _all(make_lw_shared<sstable_list>(*all))
         , _all_runs(all_runs)
         , _use_level_metadata(use_level_metadata) {
+    _unleveled_index.resize(_unleveled_sstables.size());
+    update_unleveled_index(0);
 }
 
 std::unique_ptr<sstable_set_impl> partitioned_sstable_set::clone() const {
@@ -313,7 +344,7 @@ std::vector<shared_sstable> partitioned_sstable_set::select(const dht::partition
     while (b != e) {
         boost::copy(b++->second, std::inserter(result, result.end()));
     }
-    auto r = _unleveled_sstables;
+    auto r = select_unleveled(range);
     r.insert(r.end(), result.begin(), result.end());
     return r;
 }
@@ -358,7 +389,15 @@ void partitioned_sstable_set::insert(shared_sstable sst) {
     auto undo_all_runs_insert = defer([&] () { _all_runs[sst->run_identifier()].erase(sst); });
 
     if (store_as_unleveled(sst)) {
-        _unleveled_sstables.push_back(sst);
+        _unleveled_sstables.reserve(_unleveled_sstables.size() + 1);
+        _unleveled_index.reserve(_unleveled_sstables.size() + 1);
+        auto first = sst->get_first_decorated_key().token();
+        auto it = std::ranges::upper_bound(_unleveled_index, first, std::less<>(), &unleveled_index_entry::first);
+        auto i = it - _unleveled_index.begin();
+        // Can't throw after the reservations
+        _unleveled_sstables.insert(_unleveled_sstables.begin() + i, sst);
+        _unleveled_index.insert(it, unleveled_index_entry{});
+        update_unleveled_index(i);
     } else {
         _leveled_sstables_change_cnt++;
         _leveled_sstables.add({make_interval(*sst), value_set({sst})});
@@ -376,7 +415,13 @@ void partitioned_sstable_set::erase(shared_sstable sst) {
     }
     _all->erase(sst);
     if (store_as_unleveled(sst)) {
-        _unleveled_sstables.erase(std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst), _unleveled_sstables.end());
+        auto it = std::find(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst);
+        if (it != _unleveled_sstables.end()) {
+            auto i = it - _unleveled_sstables.begin();
+            _unleveled_sstables.erase(it);
+            _unleveled_index.erase(_unleveled_index.begin() + i);
+            update_unleveled_index(i);
+        }
     } else {
         _leveled_sstables_change_cnt++;
         _leveled_sstables.subtract({make_interval(*sst), value_set({sst})});
@@ -548,8 +593,9 @@ std::unique_ptr<incremental_selector_impl> time_series_sstable_set::make_increme
     return std::make_unique<selector>(*this);
 }
 
-// Queue of readers of sstables in a time_series_sstable_set,
-// returning readers in order of the sstables' clustering key lower bounds.
+// Queue of readers of sstables in a time_series_sstable_set, or of the sstables selected
+// for a single partition read from any other set, returning readers in order of the
+// sstables' clustering key lower bounds.
 //
 // For sstable `s` we take `s.min_position()` as the lower bound for non-reversed reads,
 // and `s.max_position().reversed()` for reversed reads (in reversed reads comparisons
@@ -567,7 +613,9 @@ std::unique_ptr<incremental_selector_impl> time_series_sstable_set::make_increme
 // returned as the first on the first `pop(b)` call for any `b`. Its upper bound
 // is `before_all_clustered_rows`.
 class sstable_position_reader_queue : public position_reader_queue {
+public:
     using container_t = time_series_sstable_set::container_t;
+private:
     using value_t = container_t::value_type;
 
     schema_ptr _query_schema;
@@ -598,11 +646,37 @@ class sstable_position_reader_queue : public position_reader_queue {
         return _filter(sst);
     }
 
+    // Opens readers to the sstables with the same position as `_it` which pass the filter,
+    // and moves `_it` past them. Assumes that _it != _end and filter(*_it->second) == true.
+    void pop_sstables(std::vector<reader_and_upper_bound>& ret) {
+        // Find all sstables with the same position as `_it` (they form a contiguous range in the container).
+        auto next = std::find_if(std::next(_it), _end, [this] (const value_t& v) { return _cmp(v.first, _it->first) != 0; });
+
+        // We'll return all sstables in the range [_it, next) which pass the filter
+        do {
+            // loop invariant: filter(*_it->second) == true
+            auto upper_bound = _reversed ? _it->second->min_position().reversed() : _it->second->max_position();
+            ret.emplace_back(create_reader(*_it->second), std::move(upper_bound));
+            // restore loop invariant
+            do {
+                ++_it;
+            } while (_it != next && !filter(*_it->second));
+        } while (_it != next);
+
+        // filter(*_it->second) wasn't called yet since the inner `do..while` above checks _it != next first
+        // restore the `_it` invariant before returning
+        while (_it != _end && !filter(*_it->second)) {
+            ++_it;
+        }
+    }
+
 public:
     // Assumes that `create_reader` returns readers that emit only fragments from partition `pk`.
     //
     // For reversed reads `query_schema` must be reversed (see docs/dev/reverse-reads.md).
-    sstable_position_reader_queue(const time_series_sstable_set& set,
+    //
+    // `sstables` must be ordered by lower_bound() using `query_schema`.
+    sstable_position_reader_queue(lw_shared_ptr<const container_t> sstables,
             schema_ptr query_schema,
             std::function<flat_mutation_reader_v2(sstable&)> create_reader,
             std::function<bool(const sstable&)> filter,
@@ -611,7 +685,7 @@ class sstable_position_reader_queue : public position_reader_queue {
             streamed_mutation::forwarding fwd_sm,
             bool reversed)
         : _query_schema(std::move(query_schema))
-        , _sstables(reversed ? set._sstables_reversed : set._sstables)
+        , _sstables(std::move(sstables))
         , _it(_sstables->begin())
         , _end(_sstables->end())
         , _cmp(*_query_schema)
@@ -628,7 +702,9 @@ class sstable_position_reader_queue : public position_reader_queue {
 
     virtual ~sstable_position_reader_queue() override = default;
 
-    // If the dummy reader was not yet returned, return the dummy reader.
+    // If the dummy reader was not yet returned, return the dummy reader, together with readers
+    // to the sstables whose lower_bound() is before all clustered rows, which include all the
+    // sstables that may have partition tombstones (see sstable::may_have_partition_tombstones()).
     // Otherwise, open sstable readers to all sstables with smallest lower_bound() from the set
     // {S: filter(S) and prev_min_pos < lower_bound(S) <= bound}, where `prev_min_pos` is the lower_bound()
     // of the sstables returned from last non-empty pop() or -infinity if no sstables were previously returned,
@@ -643,9 +719,15 @@ class sstable_position_reader_queue : public position_reader_queue {
             return {};
         }
 
+        std::vector<reader_and_upper_bound> ret;
         if (_dummy_reader) {
-            std::vector<reader_and_upper_bound> ret;
             ret.emplace_back(*std::exchange(_dummy_reader, std::nullopt), position_in_partition::before_all_clustered_rows());
+            // The partition tombstones must be known before the partition start is returned,
+            // so the sstables which may have some are opened right away.
+            if (_it != _end && _cmp(_it->first, position_in_partition_view::before_all_clustered_rows()) <= 0
+                    && _cmp(_it->first, bound) <= 0) {
+                pop_sstables(ret);
+            }
             return ret;
         }
 
@@ -654,27 +736,7 @@ class sstable_position_reader_queue : public position_reader_queue {
         assert(_cmp(_it->first, bound) <= 0);
         // we don't assert(filter(*_it->second)) due to the requirement that `filter` is called at most once for each sstable
 
-        // Find all sstables with the same position as `_it` (they form a contiguous range in the container).
-        auto next = std::find_if(std::next(_it), _end, [this] (const value_t& v) { return _cmp(v.first, _it->first) != 0; });
-
-        // We'll return all sstables in the range [_it, next) which pass the filter
-        std::vector<reader_and_upper_bound> ret;
-        do {
-            // loop invariant: filter(*_it->second) == true
-            auto upper_bound = _reversed ? _it->second->min_position().reversed() : _it->second->max_position();
-            ret.emplace_back(create_reader(*_it->second), std::move(upper_bound));
-            // restore loop invariant
-            do {
-                ++_it;
-            } while (_it != next && !filter(*_it->second));
-        } while (_it != next);
-
-        // filter(*_it->second) wasn't called yet since the inner `do..while` above checks _it != next first
-        // restore the `_it` invariant before returning
-        while (_it != _end && !filter(*_it->second)) {
-            ++_it;
-        }
-
+        pop_sstables(ret);
         return ret;
     }
 
@@ -696,11 +758,26 @@ std::unique_ptr<position_reader_queue> time_series_sstable_set::make_position_re
         std::function<bool(const sstable&)> filter,
         partition_key pk, schema_ptr query_schema, reader_permit permit,
         streamed_mutation::forwarding fwd_sm, bool reversed) const {
-    return std::make_unique<sstable_position_reader_queue>(*this,
+    return std::make_unique<sstable_position_reader_queue>(reversed ? _sstables_reversed : _sstables,
             std::move(query_schema), std::move(create_reader), std::move(filter),
             std::move(pk), std::move(permit), fwd_sm, reversed);
 }
 
+// Like time_series_sstable_set::make_position_reader_queue(), for the given sstables.
+static std::unique_ptr<position_reader_queue> make_sstables_position_reader_queue(
+        const std::vector<shared_sstable>& sstables,
+        std::function<flat_mutation_reader_v2(sstable&)> create_reader,
+        partition_key pk, schema_ptr query_schema, reader_permit permit,
+        streamed_mutation::forwarding fwd_sm, bool reversed) {
+    auto ordered = make_lw_shared<sstable_position_reader_queue::container_t>(position_in_partition::less_compare(*query_schema));
+    for (auto& sst : sstables) {
+        ordered->emplace(reversed ? sst->max_position().reversed() : sst->min_position(), sst);
+    }
+    return std::make_unique<sstable_position_reader_queue>(std::move(ordered),
+            std::move(query_schema), std::move(create_reader), [] (const sstable&) { return true; },
+            std::move(pk), std::move(permit), fwd_sm, reversed);
+}
+
 std::unique_ptr<incremental_selector_impl> partitioned_sstable_set::make_incremental_selector() const {
     return std::make_unique<incremental_selector>(_schema, _unleveled_sstables, _leveled_sstables, _leveled_sstables_change_cnt);
 }
@@ -908,13 +985,33 @@ sstable_set_impl::create_single_key_sstable_reader(
     if (!num_sstables) {
         return make_empty_flat_reader_v2(schema, permit);
     }
-    auto readers = boost::copy_range<std::vector<flat_mutation_reader_v2>>(
-        filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice)
-        | boost::adaptors::transformed([&] (const shared_sstable& sstable) {
-            tracing::trace(trace_state, "Reading key {} from sstable {}", pos, seastar::value_of([&sstable] { return sstable->get_filename(); }));
-            return sstable->make_reader(schema, permit, pr, slice, trace_state, fwd);
-        })
-    );
+    selected_sstables = filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice);
+    auto make_reader = [schema, permit, &pr, &slice, trace_state, fwd] (sstable& sstable) {
+        tracing::trace(trace_state, "Reading key {} from sstable {}", pr.start()->value(), seastar::value_of([&sstable] { return sstable.get_filename(); }));
+        return sstable.make_reader(schema, permit, pr, slice, trace_state, fwd);
+    };
+
+    // Open the readers in clustering order, as the read reaches the min position of each sstable,
+    // so that a read stopping early, e.g. because of a limit, doesn't have to read all of them.
+    // As for the time series sstable set, this requires the sstables to have min/max position
+    // metadata and the schema not to have static columns, since the readers are opened in the
+    // middle of the partition. The sstables that may have partition tombstones are opened first;
+    // the min/max positions of sstables which weren't written by scylla don't account for
+    // partition tombstones, see sstable::may_contain_rows(), so those must have no tombstones.
+    auto has_min_max_positions = [] (const shared_sstable& sst) {
+        return sst->get_version() >= sstable_version_types::md
+                && (sst->has_scylla_component() || sst->get_stats_metadata().estimated_tombstone_drop_time.bin.empty());
+    };
+    if (selected_sstables.size() > 1 && fwd_mr == mutation_reader::forwarding::no && !schema->has_static_columns()
+            && std::ranges::all_of(selected_sstables, has_min_max_positions)) {
+        sstable_histogram.add(selected_sstables.size());
+        return make_clustering_combined_reader(schema, permit, fwd,
+                make_sstables_position_reader_queue(selected_sstables, std::move(make_reader),
+                    *pos.key(), schema, permit, fwd, slice.is_reversed()));
+    }
+
+    auto readers = boost::copy_range<std::vector<flat_mutation_reader_v2>>(selected_sstables
+        | boost::adaptors::transformed([&] (const shared_sstable& sstable) { return make_reader(*sstable); }));
 
     // If filter_sstable_for_reader_by_ck filtered any sstable that contains the partition
     // we want to emit partition_start/end if no rows were found,
@@ -951,16 +1048,21 @@ time_series_sstable_set::create_single_key_sstable_reader(
     // 2. The schema cannot have static columns, since we're going to be opening new readers
     //    into new sstables in the middle of the partition query. TWCS sstables will usually pass
     //    this condition.
-    // 3. The sstables cannot have partition tombstones for the same reason as above.
-    //    TWCS sstables will usually pass this condition.
-    // 4. The optimized query path must be enabled.
+    // 3. The optimized query path must be enabled.
+    // Condition 1. only concerns the sstables which may contain the queried partition.
+    // The metadata is checked first, as the partition filter may have to consult the bloom filter.
+    // The sstables which may have partition tombstones don't have to be avoided for the same
+    // reason as the static columns: their min/max positions cover all the clustered rows, so
+    // the reader queue opens them together with the first reader, before the partition start
+    // is returned, and the merger applies their partition tombstones to it.
     using sst_entry = std::pair<position_in_partition, shared_sstable>;
+    auto sst_filter = make_sstable_filter(pos, *schema, predicate);
     if (!_enable_optimized_twcs_queries
             || schema->has_static_columns()
             || std::any_of(_sstables->begin(), _sstables->end(),
-                [] (const sst_entry& e) {
+                [&sst_filter] (const sst_entry& e) {
                     return e.second->get_version() < sstable_version_types::md
-                        || e.second->may_have_partition_tombstones();
+                        && sst_filter(*e.second);
     })) {
         // Some of the conditions were not satisfied so we use the standard query path.
         return sstable_set_impl::create_single_key_sstable_reader(
@@ -968,7 +1070,6 @@ time_series_sstable_set::create_single_key_sstable_reader(
                 pr, slice, std::move(trace_state), fwd_sm, fwd_mr, predicate);
     }
 
-    auto sst_filter = make_sstable_filter(pos, *schema, predicate);
     auto it = std::find_if(_sstables->begin(), _sstables->end(), [&] (const sst_entry& e) { return sst_filter(*e.second); });
     if (it == _sstables->end()) {
         // No sstables contain data for the queried partition.
@@ -1258,14 +1359,27 @@ sstable_set::make_local_shard_sstable_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor_generator& monitor_generator,
-        const sstable_predicate& predicate) const
+        const sstable_predicate& predicate,
+        replica::cf_stats* ck_filter_stats) const
 {
-    auto reader_factory_fn = [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, &predicate]
+    // The caller guarantees the slice has no partition specific ranges, so the
+    // default ones are the ranges of every partition read.
+    if (ck_filter_stats) {
+        ++ck_filter_stats->range_scan_clustering_filter_count;
+    }
+    auto reader_factory_fn = [s, permit, &slice, trace_state, fwd, fwd_mr, &monitor_generator, &predicate, ck_filter_stats]
             (shared_sstable& sst, const dht::partition_range& pr) mutable {
         assert(!sst->is_shared());
         if (!predicate(*sst)) {
             return make_empty_flat_reader_v2(s, permit);
         }
+        if (ck_filter_stats) {
+            ++ck_filter_stats->range_scan_sstables_checked_by_clustering_filter;
+            if (!sst->may_contain_rows(slice.default_row_ranges())) {
+                return make_empty_flat_reader_v2(s, permit);
+            }
+            ++ck_filter_stats->range_scan_surviving_sstables_after_clustering_filter;
+        }
         return sst->make_reader(s, permit, pr, slice, trace_state, fwd, fwd_mr, monitor_generator(sst));
     };
     if (_impl->size() == 1) [[unlikely]] {
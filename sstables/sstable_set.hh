@@ -21,6 +21,10 @@ namespace utils {
 class estimated_histogram;
 }
 
+namespace replica {
+struct cf_stats;
+}
+
 namespace sstables {
 
 struct sstable_first_key_less_comparator {
@@ -190,6 +194,14 @@ class sstable_set : public enable_lw_shared_from_this<sstable_set> {
         read_monitor_generator& rmg = default_read_monitor_generator()) const;
 
     // Filters out mutations that don't belong to the current shard.
+    //
+    // If ck_filter_stats is set, sstables whose min/max clustering positions
+    // overlap none of the default clustering ranges of the slice, which must
+    // have no partition specific ones, are not read at all,
+    // and the filtering is accounted in ck_filter_stats. Partitions that are
+    // only present in such sstables are then missing from the output, rather
+    // than emitted empty, so this is only for readers whose consumer doesn't
+    // care about them, i.e. not for populating the cache.
     flat_mutation_reader_v2 make_local_shard_sstable_reader(
         schema_ptr,
         reader_permit,
@@ -199,7 +211,8 @@ class sstable_set : public enable_lw_shared_from_this<sstable_set> {
         streamed_mutation::forwarding,
         mutation_reader::forwarding,
         read_monitor_generator& rmg = default_read_monitor_generator(),
-        const sstable_predicate& p = default_sstable_predicate()) const;
+        const sstable_predicate& p = default_sstable_predicate(),
+        replica::cf_stats* ck_filter_stats = nullptr) const;
 
     flat_mutation_reader_v2 make_crawling_reader(
             schema_ptr,
@@ -24,9 +24,23 @@ class partitioned_sstable_set : public sstable_set_impl {
     using interval_map_type = boost::icl::interval_map<compatible_ring_position_or_view, value_set>;
     using interval_type = interval_map_type::interval_type;
     using map_iterator = interval_map_type::const_iterator;
+    // The token range of an unleveled sstable, and the highest last token
+    // of it and the unleveled sstables before it
+    struct unleveled_index_entry {
+        dht::token first;
+        dht::token last;
+        dht::token max_last;
+    };
 private:
     schema_ptr _schema;
+    // Sorted by the token of their first key
     std::vector<shared_sstable> _unleveled_sstables;
+    // Parallel to _unleveled_sstables. Since max_last grows with the index,
+    // the sstables overlapping a range are found by two binary searches,
+    // for the first sstable which may end after its start and the last one
+    // starting before its end, without touching the sstables in between.
+    // The entries which are not in the range are skipped by their tokens.
+    std::vector<unleveled_index_entry> _unleveled_index;
     interval_map_type _leveled_sstables;
     lw_shared_ptr<sstable_list> _all;
     std::unordered_map<run_id, sstable_run> _all_runs;
@@ -41,6 +55,8 @@ class partitioned_sstable_set : public sstable_set_impl {
     interval_type make_interval(const sstable& sst);
     interval_type singular(const dht::ring_position& rp) const;
     std::pair<map_iterator, map_iterator> query(const dht::partition_range& range) const;
+    void update_unleveled_index(size_t from) noexcept;
+    std::vector<shared_sstable> select_unleveled(const dht::partition_range& range) const;
     // SSTables are stored separately to avoid interval map's fragmentation issue when level 0 falls behind.
     bool store_as_unleveled(const shared_sstable& sst) const;
 public:
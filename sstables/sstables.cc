@@ -26,6 +26,7 @@
 #include <seastar/coroutine/all.hh>
 #include <seastar/util/file.hh>
 #include <seastar/util/closeable.hh>
+#include <seastar/util/defer.hh>
 #include <seastar/util/short_streams.hh>
 #include <iterator>
 #include <seastar/core/coroutine.hh>
@@ -46,6 +47,7 @@
 #include "compress.hh"
 #include "unimplemented.hh"
 #include "index_reader.hh"
+#include "chunk_cache.hh"
 #include "replica/memtable.hh"
 #include "downsampling.hh"
 #include <boost/algorithm/string.hpp>
@@ -1322,6 +1324,7 @@ future<> sstable::open_data(sstable_open_config cfg) noexcept {
     }
     _open_mode.emplace(open_flags::ro);
     _stats.on_open_for_reading();
+    _manager.account_filter(*this);
 }
 
 future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
@@ -1369,6 +1372,7 @@ future<> sstable::drop_caches() {
 
 future<> sstable::read_filter(sstable_open_config cfg) {
     if (!cfg.load_bloom_filter || !has_component(component_type::Filter)) {
+        _filter_deferred = has_component(component_type::Filter);
         _components->filter = std::make_unique<utils::filter::always_present_filter>();
         return make_ready_future<>();
     }
@@ -1381,16 +1385,42 @@ future<> sstable::read_filter(sstable_open_config cfg) {
         utils::filter_format format = (_version >= sstable_version_types::mc)
                                       ? utils::filter_format::m_format
                                       : utils::filter_format::k_l_format;
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
+        if (features().is_enabled(sstable_feature::SplitBlockBloomFilter)) {
+            _components->filter = utils::filter::create_split_block_filter(std::move(bs));
+        } else {
+            _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
+        }
     });
 }
 
+future<> sstable::load_deferred_filter() {
+    if (!_filter_deferred || _filter_loading) {
+        co_return;
+    }
+    _filter_loading = true;
+    auto reset = defer([this] { _filter_loading = false; });
+    // Reads keep using the always-present filter until the new one is in place.
+    co_await read_filter();
+    _filter_deferred = false;
+    _manager.account_filter(*this);
+}
+
+size_t sstable::reclaim_filter() noexcept {
+    if (_filter_deferred || _filter_loading || _components_shared || !has_component(component_type::Filter)) {
+        return 0;
+    }
+    _reclaimed_filter_memory = filter_memory_size();
+    _components->filter = std::make_unique<utils::filter::always_present_filter>();
+    _filter_deferred = true;
+    return _reclaimed_filter_memory;
+}
+
 void sstable::write_filter() {
     if (!has_component(component_type::Filter)) {
         return;
     }
 
-    auto f = static_cast<utils::filter::murmur3_bloom_filter *>(_components->filter.get());
+    auto f = static_cast<utils::filter::bloom_filter *>(_components->filter.get());
 
     auto&& bs = f->bits();
     auto filter_ref = sstables::filter_ref(f->num_hashes(), bs.get_storage());
@@ -1425,6 +1455,7 @@ future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
     static_assert(std::is_nothrow_move_constructible_v<sstables::foreign_sstable_open_info>);
     return read_toc().then([this, info = std::move(info)] () mutable {
         _components = std::move(info.components);
+        _components_shared = true;
         _data_file = make_checked_file(_read_error_handler, info.data.to_file());
         _index_file = make_checked_file(_read_error_handler, info.index.to_file());
         _shards = std::move(info.owners);
@@ -1437,6 +1468,7 @@ future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
 }
 
 future<foreign_sstable_open_info> sstable::get_open_info() & {
+    _components_shared = true;
     return _components.copy().then([this] (auto c) mutable {
         return foreign_sstable_open_info{std::move(c), this->get_shards_for_this_sstable(), _data_file.dup(), _index_file.dup(),
             _generation, _version, _format, data_size(), _metadata_size_on_disk};
@@ -1695,7 +1727,7 @@ future<> sstable::seal_sstable(bool backup)
             _marked_for_deletion = mark_for_deletion::none;
         }
         if (backup) {
-            return _storage->snapshot(*this, "backups", storage::absolute_path::no);
+            return _storage->snapshot(*this, "backups", storage::absolute_path::no, storage::sync_links::yes);
         }
         return make_ready_future<>();
     });
@@ -2034,8 +2066,35 @@ std::vector<std::pair<component_type, sstring>> sstable::all_components() const
     return all;
 }
 
+future<input_stream<char>> sstable::make_raw_component_input_stream(component_type c) {
+    return with_file_close_on_failure(open_file(c, open_flags::ro), [this] (file f) {
+        return f.size().then([this, f] (uint64_t size) mutable {
+            file_input_stream_options options;
+            options.buffer_size = sstable_buffer_size;
+            options.read_ahead = 4;
+            return make_file_input_stream(std::move(f), 0, size, std::move(options));
+        });
+    });
+}
+
+void sstable::open_raw(const std::vector<component_type>& components) {
+    _marked_for_deletion = mark_for_deletion::implicit;
+    _recognized_components.clear();
+    _recognized_components.insert(components.begin(), components.end());
+    _recognized_components.insert(component_type::TOC);
+    _storage->open(*this);
+}
+
+future<output_stream<char>> sstable::make_raw_component_output_stream(component_type c) {
+    file_output_stream_options options;
+    options.buffer_size = sstable_buffer_size;
+    return _storage->make_component_sink(*this, c, open_flags::wo | open_flags::create | open_flags::exclusive, std::move(options)).then([] (data_sink sink) {
+        return output_stream<char>(std::move(sink));
+    });
+}
+
 future<> sstable::snapshot(const sstring& dir) const {
-    return _storage->snapshot(*this, dir, storage::absolute_path::yes);
+    return _storage->snapshot(*this, dir, storage::absolute_path::yes, storage::sync_links::no);
 }
 
 future<> sstable::change_state(sstring to, delayed_commit_changes* delay_commit) {
@@ -2199,14 +2258,101 @@ component_type sstable::component_from_sstring(version_types v, const sstring &s
     }
 }
 
+// Accounts the reads of sequential scans to the sstable's stats.
+class sequential_scan_file_impl : public file_impl {
+    file _file;
+    shared_sstable _sst;
+public:
+    sequential_scan_file_impl(file f, shared_sstable sst)
+        : file_impl(*get_file_impl(f))
+        , _file(std::move(f))
+        , _sst(std::move(sst)) {
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, io_intent* intent) override {
+        return get_file_impl(_file)->write_dma(pos, buffer, len, intent);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, io_intent* intent) override {
+        return get_file_impl(_file)->write_dma(pos, std::move(iov), intent);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent* intent) override {
+        return get_file_impl(_file)->read_dma(pos, buffer, len, intent);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent* intent) override {
+        return get_file_impl(_file)->read_dma(pos, iov, intent);
+    }
+
+    virtual future<> flush(void) override {
+        return get_file_impl(_file)->flush();
+    }
+
+    virtual future<struct stat> stat(void) override {
+        return get_file_impl(_file)->stat();
+    }
+
+    virtual future<> truncate(uint64_t length) override {
+        return get_file_impl(_file)->truncate(length);
+    }
+
+    virtual future<> discard(uint64_t offset, uint64_t length) override {
+        return get_file_impl(_file)->discard(offset, length);
+    }
+
+    virtual future<> allocate(uint64_t position, uint64_t length) override {
+        return get_file_impl(_file)->allocate(position, length);
+    }
+
+    virtual future<uint64_t> size(void) override {
+        return get_file_impl(_file)->size();
+    }
+
+    virtual future<> close() override {
+        return get_file_impl(_file)->close();
+    }
+
+    virtual std::unique_ptr<file_handle_impl> dup() override {
+        return get_file_impl(_file)->dup();
+    }
+
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override {
+        return get_file_impl(_file)->list_directory(std::move(next));
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent* intent) override {
+        _sst->get_stats().on_sequential_scan_read(range_size);
+        return get_file_impl(_file)->dma_read_bulk(offset, range_size, intent);
+    }
+};
+
+sstable::sequential_scan sstable::is_sequential_scan(uint64_t len) const {
+    const size_t buffer_size = _manager.config().sstable_scan_buffer_size_in_kb() * 1024;
+    if (buffer_size <= sstable_buffer_size) {
+        return sequential_scan::no;
+    }
+    return sequential_scan(len >= buffer_size * std::max(_manager.config().sstable_scan_read_ahead(), 1u));
+}
+
 input_stream<char> sstable::data_stream(uint64_t pos, size_t len,
-        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw) {
+        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw,
+        sequential_scan scan) {
     file_input_stream_options options;
     options.buffer_size = sstable_buffer_size;
     options.read_ahead = 4;
     options.dynamic_adjustments = std::move(history);
 
     file f = make_tracked_file(_data_file, permit);
+    if (scan) {
+        // The scan history shrinks the reads back when the scan turns out
+        // to skip over most of what it read ahead, e.g. when fast-forwarded.
+        options.buffer_size = std::max<size_t>(_manager.config().sstable_scan_buffer_size_in_kb() * 1024, sstable_buffer_size);
+        options.read_ahead = _manager.config().sstable_scan_read_ahead();
+        options.dynamic_adjustments = _sequential_scan_history;
+        f = file(make_shared<sequential_scan_file_impl>(std::move(f), shared_from_this()));
+        _stats.on_sequential_scan();
+    }
     if (trace_state) {
         f = tracing::make_traced_file(std::move(f), std::move(trace_state), format("{}:", get_filename()));
     }
@@ -2461,6 +2607,37 @@ const dht::decorated_key& sstable::get_last_decorated_key() const {
     return *_last;
 }
 
+void sstable::save_resume_hint(resume_hint hint) {
+    if (_resume_hints.size() == max_resume_hints) {
+        _resume_hints.erase(_resume_hints.begin());
+    }
+    _resume_hints.push_back(std::move(hint));
+}
+
+std::optional<sstable::disk_read_range> sstable::take_resume_hint(const dht::partition_range& pr) {
+    if (_resume_hints.empty() || !pr.start()) {
+        return std::nullopt;
+    }
+    dht::ring_position_comparator cmp(*_schema);
+    auto same_end = [&] (const resume_hint& hint) {
+        if (!hint.end || !pr.end()) {
+            return !hint.end && !pr.end();
+        }
+        return hint.end->is_inclusive() == pr.end()->is_inclusive() && cmp(dht::ring_position_view(hint.end->value()), dht::ring_position_view(pr.end()->value())) == 0;
+    };
+    auto it = std::find_if(_resume_hints.rbegin(), _resume_hints.rend(), [&] (const resume_hint& hint) {
+        return hint.after_key != pr.start()->is_inclusive()
+                && cmp(dht::ring_position_view(hint.key), dht::ring_position_view(pr.start()->value())) == 0
+                && same_end(hint);
+    });
+    if (it == _resume_hints.rend()) {
+        return std::nullopt;
+    }
+    auto range = disk_read_range(it->data_start, it->data_end);
+    _resume_hints.erase(std::next(it).base());
+    return range;
+}
+
 std::strong_ordering sstable::compare_by_first_key(const sstable& other) const {
     return get_first_decorated_key().tri_compare(*_schema, other.get_first_decorated_key());
 }
@@ -2520,6 +2697,33 @@ future<> sstable::mutate_sstable_level(uint32_t new_level) {
     });
 }
 
+future<> sstable::mutate_repaired_at(uint64_t repaired_at) {
+    if (!has_component(component_type::Statistics)) {
+        co_return;
+    }
+
+    auto entry = _components->statistics.contents.find(metadata_type::Stats);
+    if (entry == _components->statistics.contents.end()) {
+        co_return;
+    }
+
+    auto& p = entry->second;
+    if (!p) {
+        throw std::runtime_error("Statistics is malformed");
+    }
+    stats_metadata& s = *static_cast<stats_metadata *>(p.get());
+    if (s.repaired_at == repaired_at) {
+        co_return;
+    }
+
+    sstlog.debug("set repaired_at of {} from {} to {}", get_filename(), s.repaired_at, repaired_at);
+    s.repaired_at = repaired_at;
+    // Like mutate_sstable_level(), rewrites the whole Statistics component.
+    co_await seastar::async([this] {
+        rewrite_statistics();
+    });
+}
+
 int sstable::compare_by_max_timestamp(const sstable& other) const {
     auto ts1 = get_stats_metadata().max_timestamp;
     auto ts2 = other.get_stats_metadata().max_timestamp;
@@ -2665,7 +2869,6 @@ future<> remove_by_toc_name(sstring sstable_toc_name) {
 std::optional<std::pair<uint64_t, uint64_t>> sstable::get_index_pages_for_range(const dht::token_range& range) {
     const auto& entries = _components->summary.entries;
     auto entries_size = entries.size();
-    index_comparator cmp(*_schema);
     dht::ring_position_comparator rp_cmp(*_schema);
     uint64_t left = 0;
     if (range.start()) {
@@ -2681,8 +2884,7 @@ std::optional<std::pair<uint64_t, uint64_t>> sstable::get_index_pages_for_range(
             return std::nullopt;
         }
 
-        left = std::distance(std::begin(entries),
-            std::lower_bound(entries.begin(), entries.end(), pos, cmp));
+        left = summary_lower_bound(_components->summary, 0, pos, *_schema);
 
         if (left) {
             --left;
@@ -2694,8 +2896,7 @@ std::optional<std::pair<uint64_t, uint64_t>> sstable::get_index_pages_for_range(
                                       ? dht::ring_position_view::ending_at(range.end()->value())
                                       : dht::ring_position_view::starting_at(range.end()->value());
 
-        right = std::distance(std::begin(entries),
-            std::lower_bound(entries.begin(), entries.end(), pos, cmp));
+        right = summary_lower_bound(_components->summary, 0, pos, *_schema);
         if (right == 0) {
             // The first key is strictly greater than right.
             return std::nullopt;
@@ -2879,6 +3080,22 @@ future<> init_metrics() {
         sm::make_counter("pi_auto_scale_events", [] { return sstables_stats::get_shard_stats().promoted_index_auto_scale_events; },
             sm::description("Number of promoted index auto-scaling events")),
 
+        sm::make_counter("chunk_cache_hits", [] { return chunk_cache::local().get_stats().hits; },
+            sm::description("Number of decompressed chunks read from the chunk cache")),
+        sm::make_counter("chunk_cache_misses", [] { return chunk_cache::local().get_stats().misses; },
+            sm::description("Number of chunk cache lookups which had to read and decompress the chunk")),
+        sm::make_counter("chunk_cache_evictions", [] { return chunk_cache::local().get_stats().evictions; },
+            sm::description("Number of decompressed chunks evicted from the chunk cache")),
+        sm::make_gauge("chunk_cache_bytes", [] { return chunk_cache::local().get_stats().bytes; },
+            sm::description("Memory used by the chunk cache")),
+
+        sm::make_gauge("bloom_filter_memory_size", [] { return sstables_stats::get_shard_stats().filter_memory; },
+            sm::description("Memory used by the bloom filters of open sstables")),
+        sm::make_counter("bloom_filter_reclaims", [] { return sstables_stats::get_shard_stats().filter_reclaims; },
+            sm::description("Number of bloom filters dropped from memory because filters exceeded bloom_filter_memory_threshold")),
+        sm::make_counter("bloom_filter_reloads", [] { return sstables_stats::get_shard_stats().filter_reloads; },
+            sm::description("Number of dropped bloom filters read back from disk once there was room for them")),
+
         sm::make_counter("range_tombstone_reads", [] { return sstables_stats::get_shard_stats().range_tombstone_reads; },
             sm::description("Number of range tombstones read")),
         sm::make_counter("row_tombstone_reads", [] { return sstables_stats::get_shard_stats().row_tombstone_reads; },
@@ -2893,8 +3110,16 @@ future<> init_metrics() {
             sm::description("Number of partitions read")),
         sm::make_counter("partition_seeks", [] { return sstables_stats::get_shard_stats().partition_seeks; },
             sm::description("Number of partitions seeked")),
+        sm::make_counter("resumed_range_partition_reads", [] { return sstables_stats::get_shard_stats().resumed_range_partition_reads; },
+            sm::description("Number of partition range reads resuming an evicted read, which didn't look up their range in the index")),
         sm::make_counter("row_reads", [] { return sstables_stats::get_shard_stats().row_reads; },
             sm::description("Number of rows read")),
+        sm::make_counter("sequential_scans", [] { return sstables_stats::get_shard_stats().sequential_scans; },
+            sm::description("Number of data file reads detected as sequential scans, which use the scan read-ahead")),
+        sm::make_counter("sequential_scan_reads", [] { return sstables_stats::get_shard_stats().sequential_scan_reads; },
+            sm::description("Number of disk reads issued by sequential scans")),
+        sm::make_counter("sequential_scan_read_bytes", [] { return sstables_stats::get_shard_stats().sequential_scan_read_bytes; },
+            sm::description("Number of bytes read from disk by sequential scans")),
 
         sm::make_counter("capped_local_deletion_time", [] { return sstables_stats::get_shard_stats().capped_local_deletion_time; },
             sm::description("Was local deletion time capped at maximum allowed value in Statistics")),
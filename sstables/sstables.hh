@@ -107,11 +107,22 @@ struct sstable_writer_config {
     mutation_fragment_stream_validation_level validation_level;
     std::optional<db::replay_position> replay_position;
     std::optional<int> sstable_level;
+    std::optional<uint64_t> repaired_at;
     write_monitor* monitor = &default_write_monitor();
     run_id run_identifier = run_id::create_random_id();
     size_t summary_byte_cost;
     sstring origin;
     locator::effective_replication_map_ptr erm;
+    // Write a split-block bloom filter instead of the classic one.
+    bool split_block_bloom_filter = false;
+    // Allows compressing with a trained dictionary, stored in CompressionInfo.
+    bool compression_dictionary = false;
+    // Overrides the schema's compressor, e.g. with one using a trained dictionary.
+    compressor_ptr compressor;
+    // Receives samples of the uncompressed data chunks, if set.
+    lw_shared_ptr<compression_chunk_sampler> compression_sampler;
+    // Overrides the schema's compression chunk length, e.g. with one tuned for the reads of the table.
+    std::optional<unsigned> compression_chunk_length;
 
 private:
     explicit sstable_writer_config() {}
@@ -340,6 +351,18 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return _components->filter->memory_size();
     }
 
+    // True if the sstable was opened with load_bloom_filter = false while
+    // having a Filter component, or if the sstables_manager reclaimed its
+    // filter, so it considers every key present until load_deferred_filter()
+    // is called.
+    bool has_deferred_filter() const noexcept {
+        return _filter_deferred;
+    }
+    // Reads the Filter component of an sstable with a deferred filter and
+    // starts using it. Must be called on the shard owning the components.
+    // Returns immediately if the filter is already being loaded.
+    future<> load_deferred_filter();
+
     version_types get_version() const {
         return _version;
     }
@@ -384,6 +407,20 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     std::vector<std::pair<component_type, sstring>> all_components() const;
 
+    // File-level streaming ships sstables by copying their components
+    // verbatim, instead of re-serializing their contents.
+
+    // Returns a stream of the raw contents of the given component.
+    future<input_stream<char>> make_raw_component_input_stream(component_type c);
+    // Prepares writing raw components into a new sstable, which will consist
+    // of the given ones. The sstable is deleted when destroyed unless
+    // seal_sstable() is called after all the components are written.
+    // Must run in a seastar thread.
+    void open_raw(const std::vector<component_type>& components);
+    future<output_stream<char>> make_raw_component_output_stream(component_type c);
+
+    // Links the sstable into the existing snapshot directory dir. The links are
+    // durable only once the caller syncs the directory.
     future<> snapshot(const sstring& dir) const;
 
     // Delete the sstable by unlinking all sstable files
@@ -480,6 +517,16 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     std::vector<sstring> _unrecognized_components;
 
     foreign_ptr<lw_shared_ptr<shareable_components>> _components = make_foreign(make_lw_shared<shareable_components>());
+    bool _filter_deferred = false;
+    bool _filter_loading = false;
+    // Set once the components were handed to, or taken from, another shard.
+    // The filter of such an sstable is never reclaimed, since the other
+    // shard may be reading it.
+    mutable bool _components_shared = false;
+    // Filter memory counted by the sstables_manager for this sstable, and
+    // the memory of the filter it reclaimed, if any
+    size_t _accounted_filter_memory = 0;
+    size_t _reclaimed_filter_memory = 0;
     column_translation _column_translation;
     std::optional<open_flags> _open_mode;
     // _compaction_ancestors track which sstable generations were used to generate this sstable.
@@ -505,6 +552,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     lw_shared_ptr<file_input_stream_history> _single_partition_history = make_lw_shared<file_input_stream_history>();
     lw_shared_ptr<file_input_stream_history> _partition_range_history = make_lw_shared<file_input_stream_history>();
     lw_shared_ptr<file_input_stream_history> _index_history = make_lw_shared<file_input_stream_history>();
+    lw_shared_ptr<file_input_stream_history> _sequential_scan_history = make_lw_shared<file_input_stream_history>();
 
     schema_ptr _schema;
     generation_type _generation{0};
@@ -542,6 +590,25 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // information in their scylla metadata.
     std::optional<scylla_metadata::large_data_stats> _large_data_stats;
     sstring _origin;
+public:
+    // Where a range read of the data file stopped when its reader was closed,
+    // e.g. because the read was evicted. See save_resume_hint().
+    struct resume_hint {
+        dht::decorated_key key;
+        // Whether data_start is the position after the partition of key,
+        // rather than its start.
+        bool after_key;
+        uint64_t data_start;
+        // The end of the partition range of the read, and its position.
+        std::optional<dht::partition_range::bound> end;
+        uint64_t data_end;
+    };
+private:
+    // The most recently saved hint last
+    std::vector<resume_hint> _resume_hints;
+    static constexpr size_t max_resume_hints = 4;
+    // The sizes of the reads of the data file, shared by the sstables of a table.
+    lw_shared_ptr<read_size_histogram> _read_sizes;
 public:
     const bool has_component(component_type f) const;
     sstables_manager& manager() { return _manager; }
@@ -590,6 +657,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
                                sstring origin);
 
     future<> read_filter(sstable_open_config cfg = {});
+    // Replaces the filter with the always-present one, for
+    // load_deferred_filter() to bring it back. Returns the memory freed.
+    size_t reclaim_filter() noexcept;
 
     void write_filter();
 
@@ -650,9 +720,21 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     //
     // When created with `raw_stream::yes`, the sstable data file will be
     // streamed as-is, without decompressing (if compressed).
+    //
+    // When created with `sequential_scan::yes`, the stream reads ahead in
+    // larger chunks, with a deeper read-ahead, see
+    // sstable_scan_buffer_size_in_kb and sstable_scan_read_ahead. Use
+    // is_sequential_scan() to decide.
     using raw_stream = bool_class<class raw_stream_tag>;
+    using sequential_scan = bool_class<class sequential_scan_tag>;
     input_stream<char> data_stream(uint64_t pos, size_t len,
-            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw = raw_stream::no);
+            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw = raw_stream::no,
+            sequential_scan scan = sequential_scan::no);
+
+    // Whether a read which is going to consume len bytes of the data file
+    // in order is worth reading with the sequential scan read-ahead. Short
+    // reads would only read ahead more than they need.
+    sequential_scan is_sequential_scan(uint64_t len) const;
 
     // Read exactly the specific byte range from the data file (after
     // uncompression, if the file is compressed). This can be used to read
@@ -835,6 +917,18 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> mutate_sstable_level(uint32_t);
 
+    // An sstable is repaired when all its data is known to be on all the
+    // replicas of its token range, so incremental repair doesn't have to
+    // read it. repaired_at is the time of the repair, in milliseconds since
+    // the epoch, or 0 for unrepaired sstables.
+    uint64_t get_repaired_at() const {
+        return get_stats_metadata().repaired_at;
+    }
+    bool is_repaired() const {
+        return get_repaired_at() != 0;
+    }
+    future<> mutate_repaired_at(uint64_t repaired_at);
+
     const summary& get_summary() const {
         return _components->summary;
     }
@@ -851,6 +945,30 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return _stats;
     }
 
+    // Saves where a range read stopped, so that the read resuming it, e.g.
+    // the one recreated by the evictable reader, doesn't have to look up the
+    // data file range in the index again. Only the last few are kept.
+    void save_resume_hint(resume_hint hint);
+
+    // Returns the data file range of the partition range, if it resumes a
+    // read saved by save_resume_hint(), consuming the hint.
+    std::optional<disk_read_range> take_resume_hint(const dht::partition_range& pr);
+
+    // Records the sizes of the data file reads in \p read_sizes.
+    void set_read_size_histogram(lw_shared_ptr<read_size_histogram> read_sizes) noexcept {
+        _read_sizes = std::move(read_sizes);
+    }
+
+    void on_data_read(uint64_t size) noexcept {
+        if (_read_sizes && size) {
+            _read_sizes->add(size);
+        }
+    }
+
+    const sstables_stats& get_stats() const {
+        return _stats;
+    }
+
     bool has_correct_min_max_column_names() const noexcept {
         return _version >= sstable_version_types::md;
     }
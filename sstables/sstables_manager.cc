@@ -15,6 +15,7 @@
 #include "gms/feature_service.hh"
 #include "db/system_keyspace.hh"
 #include "utils/s3/client.hh"
+#include "utils/s3/block_cache.hh"
 
 namespace sstables {
 
@@ -32,6 +33,7 @@ sstables_manager::sstables_manager(
         utils::updateable_value(std::numeric_limits<uint32_t>::max()),
         utils::updateable_value(std::numeric_limits<uint32_t>::max()))
     , _dir_semaphore(dir_sem)
+    , _available_memory(available_memory)
 {
 }
 
@@ -47,6 +49,18 @@ storage_manager::storage_manager(const db::config& cfg)
     for (auto [ep, ecfg] : cfg.object_storage_config()) {
         _s3_endpoints.emplace(std::make_pair(std::move(ep), make_lw_shared<s3::endpoint_config>(std::move(ecfg))));
     }
+    if (!cfg.object_storage_cache_directory().empty() && cfg.object_storage_cache_size_in_mb() != 0) {
+        auto path = std::filesystem::path(cfg.object_storage_cache_directory()) / fmt::format("s3-cache-{}.db", this_shard_id());
+        _block_cache = std::make_unique<s3::block_cache>(std::move(path), (cfg.object_storage_cache_size_in_mb() << 20) / smp::count);
+    }
+}
+
+storage_manager::~storage_manager() = default;
+
+future<> storage_manager::start() {
+    if (_block_cache) {
+        co_await _block_cache->start();
+    }
 }
 
 future<> storage_manager::stop() {
@@ -54,6 +68,10 @@ future<> storage_manager::stop() {
         co_await _config_updater->action.join();
     }
 
+    if (_block_cache) {
+        co_await _block_cache->stop();
+    }
+
     for (auto ep : _s3_endpoints) {
         if (ep.second.client != nullptr) {
             co_await ep.second.client->close();
@@ -126,6 +144,8 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
             ? mutation_fragment_stream_validation_level::clustering_key
             : mutation_fragment_stream_validation_level::token;
     cfg.summary_byte_cost = summary_byte_cost(_db_config.sstable_summary_ratio());
+    cfg.split_block_bloom_filter = _features.split_block_bloom_filter;
+    cfg.compression_dictionary = _features.sstable_compression_dictionary;
 
     cfg.origin = std::move(origin);
 
@@ -140,6 +160,8 @@ void sstables_manager::deactivate(sstable* sst) {
     // At this point, sst has a reference count of zero, since we got here from
     // lw_shared_ptr_deleter<sstables::sstable>::dispose().
     _active.erase(_active.iterator_to(*sst));
+    unaccount_filter(*sst);
+    maybe_reload_filters();
     _undergoing_close.push_back(*sst);
     // guard against sstable::close_files() calling shared_from_this() and immediately destroying
     // the result, which will dispose of the sstable recursively
@@ -174,13 +196,94 @@ future<> sstables_manager::delete_atomically(std::vector<shared_sstable> ssts) {
     co_await deleter(std::move(ssts));
 }
 
+size_t sstables_manager::filter_memory_budget() const noexcept {
+    return _available_memory * _db_config.bloom_filter_memory_threshold();
+}
+
+void sstables_manager::account_filter(sstable& sst) {
+    unaccount_filter(sst);
+    sst._accounted_filter_memory = sst.filter_memory_size();
+    sst._reclaimed_filter_memory = 0;
+    _total_filter_memory += sst._accounted_filter_memory;
+    sstables_stats::on_filter_memory_change(sst._accounted_filter_memory, 0);
+    maybe_reclaim_filters();
+}
+
+void sstables_manager::unaccount_filter(sstable& sst) noexcept {
+    _total_filter_memory -= sst._accounted_filter_memory;
+    sstables_stats::on_filter_memory_change(0, sst._accounted_filter_memory);
+    sst._accounted_filter_memory = 0;
+}
+
+void sstables_manager::maybe_reclaim_filters() {
+    auto budget = filter_memory_budget();
+    while (_total_filter_memory > budget) {
+        sstable* victim = nullptr;
+        for (auto& sst : _active) {
+            if (!sst._components_shared && sst._accounted_filter_memory > (victim ? victim->_accounted_filter_memory : 0)) {
+                victim = &sst;
+            }
+        }
+        if (!victim || !victim->reclaim_filter()) {
+            break;
+        }
+        smlogger.debug("Reclaimed {} bytes of bloom filter of {}, filters use {} bytes out of {}",
+                victim->_reclaimed_filter_memory, victim->get_filename(), _total_filter_memory, budget);
+        unaccount_filter(*victim);
+        sstables_stats::on_filter_reclaim();
+        _filters_reclaimed = true;
+    }
+}
+
+void sstables_manager::maybe_reload_filters() {
+    if (!_filters_reclaimed || _closing || _filter_reload_gate.get_count() || _total_filter_memory >= filter_memory_budget()) {
+        return;
+    }
+    (void)with_gate(_filter_reload_gate, [this] {
+        return reload_filters().handle_exception([] (std::exception_ptr ex) {
+            smlogger.warn("Failed to reload reclaimed bloom filters: {}", ex);
+        });
+    });
+}
+
+future<> sstables_manager::reload_filters() {
+    while (!_closing) {
+        // Smallest first, to bring back as many filters as fit
+        shared_sstable candidate;
+        for (auto& sst : _active) {
+            if (sst._reclaimed_filter_memory && !sst._filter_loading && (!candidate || sst._reclaimed_filter_memory < candidate->_reclaimed_filter_memory)) {
+                candidate = sst.shared_from_this();
+            }
+        }
+        if (!candidate) {
+            _filters_reclaimed = false;
+            co_return;
+        }
+        if (_total_filter_memory + candidate->_reclaimed_filter_memory > filter_memory_budget()) {
+            co_return;
+        }
+        co_await candidate->load_deferred_filter();
+        sstables_stats::on_filter_reload();
+    }
+}
+
 future<> sstables_manager::close() {
     _closing = true;
     maybe_done();
     co_await _done.get_future();
+    co_await _filter_reload_gate.close();
     co_await _sstable_metadata_concurrency_sem.stop();
 }
 
+future<std::optional<sstring>> sstables_manager::train_compression_dictionary(const compressor& base, const std::vector<sstring>& samples) {
+    if (!_compression_training_worker) {
+        _compression_training_worker = std::make_unique<utils::alien_worker>(smlogger, 10);
+    }
+    return _compression_training_worker->submit<std::optional<sstring>>([&base, &samples] {
+        return base.train_dictionary(samples);
+    });
+}
+
 void sstables_manager::plug_system_keyspace(db::system_keyspace& sys_ks) noexcept {
     _sys_ks = sys_ks.shared_from_this();
 }
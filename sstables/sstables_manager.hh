@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <seastar/core/gate.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sharded.hh>
 
@@ -23,6 +24,7 @@
 #include "locator/host_id.hh"
 #include "reader_concurrency_semaphore.hh"
 #include "utils/s3/creds.hh"
+#include "utils/alien_worker.hh"
 #include <boost/intrusive/list.hpp>
 
 namespace db {
@@ -33,7 +35,7 @@ class config;
 
 }   // namespace db
 
-namespace s3 { class client; }
+namespace s3 { class client; class block_cache; }
 
 namespace gms { class feature_service; }
 
@@ -60,12 +62,17 @@ class storage_manager : public peering_sharded_service<storage_manager> {
 
     std::unordered_map<sstring, s3_endpoint> _s3_endpoints;
     std::unique_ptr<config_updater> _config_updater;
+    std::unique_ptr<s3::block_cache> _block_cache;
 
     void update_config(const db::config&);
 
 public:
     storage_manager(const db::config&);
+    ~storage_manager();
     shared_ptr<s3::client> get_endpoint_client(sstring endpoint);
+    // The local cache of the blocks of objects, null if not configured
+    s3::block_cache* block_cache() const noexcept { return _block_cache.get(); }
+    future<> start();
     future<> stop();
 };
 
@@ -100,6 +107,18 @@ class sstables_manager {
     directory_semaphore& _dir_semaphore;
     seastar::shared_ptr<db::system_keyspace> _sys_ks;
 
+    // Bloom filters of the active sstables are kept within
+    // bloom_filter_memory_threshold of the available memory: above it, the
+    // largest filters are dropped, and they are read back from disk once
+    // sstables going away make room for them.
+    size_t _available_memory;
+    size_t _total_filter_memory = 0;
+    bool _filters_reclaimed = false;
+    seastar::gate _filter_reload_gate;
+
+    // Runs the training of compression dictionaries, started on first use.
+    std::unique_ptr<utils::alien_worker> _compression_training_worker;
+
 public:
     explicit sstables_manager(db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat, cache_tracker&, size_t available_memory, directory_semaphore& dir_sem, storage_manager* shared = nullptr);
     virtual ~sstables_manager();
@@ -120,6 +139,10 @@ class sstables_manager {
         return _storage->get_endpoint_client(std::move(endpoint));
     }
 
+    s3::block_cache* get_s3_block_cache() const noexcept {
+        return _storage != nullptr ? _storage->block_cache() : nullptr;
+    }
+
     virtual sstable_writer_config configure_writer(sstring origin) const;
     bool uuid_sstable_identifiers() const;
     const db::config& config() const { return _db_config; }
@@ -154,6 +177,14 @@ class sstables_manager {
 
     future<> delete_atomically(std::vector<shared_sstable> ssts);
 
+    // Trains a dictionary for `base` from `samples` outside of the reactor,
+    // see compressor::train_dictionary(). `samples` must be kept alive until
+    // the returned future resolves.
+    future<std::optional<sstring>> train_compression_dictionary(const compressor& base, const std::vector<sstring>& samples);
+
+    size_t filter_memory() const noexcept { return _total_filter_memory; }
+    size_t filter_memory_budget() const noexcept;
+
 private:
     void add(sstable* sst);
     // Transition the sstable to the "inactive" state. It has no
@@ -163,6 +194,13 @@ class sstables_manager {
     void remove(sstable* sst);
     void maybe_done();
 
+    // Called when the filter of sst was loaded
+    void account_filter(sstable& sst);
+    void unaccount_filter(sstable& sst) noexcept;
+    void maybe_reclaim_filters();
+    void maybe_reload_filters();
+    future<> reload_filters();
+
     static constexpr size_t max_count_sstable_metadata_concurrent_reads{10};
     // Allow at most 10% of memory to be filled with such reads.
     size_t max_memory_sstable_metadata_concurrent_reads(size_t available_memory) { return available_memory * 0.1; }
@@ -25,9 +25,13 @@ class sstables_stats {
         uint64_t cell_tombstone_writes = 0;
         uint64_t single_partition_reads = 0;
         uint64_t range_partition_reads = 0;
+        uint64_t resumed_range_partition_reads = 0;
         uint64_t partition_reads = 0;
         uint64_t partition_seeks = 0;
         uint64_t row_reads = 0;
+        uint64_t sequential_scans = 0;
+        uint64_t sequential_scan_reads = 0;
+        uint64_t sequential_scan_read_bytes = 0;
         uint64_t capped_local_deletion_time = 0;
         uint64_t capped_tombstone_deletion_time = 0;
         uint64_t open_for_reading = 0;
@@ -36,10 +40,21 @@ class sstables_stats {
         uint64_t closed_for_writing = 0;
         uint64_t deleted = 0;
         uint64_t promoted_index_auto_scale_events = 0;
+        uint64_t filter_memory = 0;
+        uint64_t filter_reclaims = 0;
+        uint64_t filter_reloads = 0;
     } _shard_stats;
 
     stats& _stats = _shard_stats;
 
+    // Counts of what reads scanned from this particular sstable.
+    uint64_t _rows_read = 0;
+    uint64_t _row_tombstones_read = 0;
+    uint64_t _range_tombstones_read = 0;
+    // I/O issued by sequential scans of the data file of this sstable.
+    uint64_t _sequential_scan_reads = 0;
+    uint64_t _sequential_scan_read_bytes = 0;
+
 public:
     static const stats& get_shard_stats() noexcept {
         return _shard_stats;
@@ -67,10 +82,13 @@ class sstables_stats {
 
     inline void on_range_tombstone_read() noexcept {
         ++_stats.range_tombstone_reads;
+        ++_range_tombstones_read;
     }
 
+    // Called for deleted rows, in addition to on_row_read().
     inline void on_row_tombstone_read() noexcept {
         ++_stats.row_tombstone_reads;
+        ++_row_tombstones_read;
     }
 
     inline void on_cell_write() noexcept {
@@ -89,6 +107,10 @@ class sstables_stats {
         ++_stats.range_partition_reads;
     }
 
+    inline void on_resumed_range_partition_read() noexcept {
+        ++_stats.resumed_range_partition_reads;
+    }
+
     inline void on_partition_read() noexcept {
         ++_stats.partition_reads;
     }
@@ -99,6 +121,18 @@ class sstables_stats {
 
     inline void on_row_read() noexcept {
         ++_stats.row_reads;
+        ++_rows_read;
+    }
+
+    inline void on_sequential_scan() noexcept {
+        ++_stats.sequential_scans;
+    }
+
+    inline void on_sequential_scan_read(uint64_t bytes) noexcept {
+        ++_stats.sequential_scan_reads;
+        _stats.sequential_scan_read_bytes += bytes;
+        ++_sequential_scan_reads;
+        _sequential_scan_read_bytes += bytes;
     }
 
     inline void on_capped_local_deletion_time() noexcept {
@@ -130,6 +164,37 @@ class sstables_stats {
     inline void on_promoted_index_auto_scale() noexcept {
         ++_stats.promoted_index_auto_scale_events;
     }
+
+    // Bloom filter memory accounting, see sstables_manager
+    static void on_filter_memory_change(size_t added, size_t removed) noexcept {
+        _shard_stats.filter_memory += added;
+        _shard_stats.filter_memory -= removed;
+    }
+    static void on_filter_reclaim() noexcept {
+        ++_shard_stats.filter_reclaims;
+    }
+    static void on_filter_reload() noexcept {
+        ++_shard_stats.filter_reloads;
+    }
+
+    // Number of rows and range tombstones scanned by reads of this sstable.
+    uint64_t fragments_read() const noexcept {
+        return _rows_read + _range_tombstones_read;
+    }
+
+    // Number of deleted rows and range tombstones scanned by reads of this sstable.
+    uint64_t tombstones_read() const noexcept {
+        return _row_tombstones_read + _range_tombstones_read;
+    }
+
+    // Number and total size of the reads sequential scans issued to the
+    // data file of this sstable.
+    uint64_t sequential_scan_reads() const noexcept {
+        return _sequential_scan_reads;
+    }
+    uint64_t sequential_scan_read_bytes() const noexcept {
+        return _sequential_scan_read_bytes;
+    }
 };
 
 }
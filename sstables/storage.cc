@@ -27,6 +27,7 @@
 #include "utils/overloaded_functor.hh"
 #include "utils/memory_data_sink.hh"
 #include "utils/s3/client.hh"
+#include "utils/s3/block_cache.hh"
 
 #include "checked-file-impl.hh"
 
@@ -58,7 +59,7 @@ class filesystem_storage final : public sstables::storage {
     explicit filesystem_storage(sstring dir_) : dir(std::move(dir_)) {}
 
     virtual future<> seal(const sstable& sst) override;
-    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs) const override;
+    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, sync_links sync) const override;
     virtual future<> change_state(const sstable& sst, sstring to, generation_type generation, delayed_commit_changes* delay) override;
     // runs in async context
     virtual void open(sstable& sst) override;
@@ -329,12 +330,29 @@ future<> filesystem_storage::create_links(const sstable& sst, const sstring& dir
     return create_links_common(sst, dir, sst._generation, mark_for_removal::no);
 }
 
-future<> filesystem_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs) const {
+future<> filesystem_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, sync_links sync) const {
     if (!abs) {
         dir = this->dir + "/" + dir + "/";
     }
-    co_await sst.sstable_touch_directory_io_check(dir);
-    co_await create_links(sst, dir);
+    if (sync) {
+        co_await sst.sstable_touch_directory_io_check(dir);
+        co_await create_links(sst, dir);
+        co_return;
+    }
+    // The caller creates the directory, and syncs it once everything is linked. The snapshot doesn't count
+    // before its manifest is written after that, so the links need neither the TemporaryTOC
+    // protocol of create_links() nor syncing the directory for each sstable. The TOC is still
+    // linked last, so that a complete set of components is found for each TOC.
+    auto comps = sst.all_components();
+    auto make_link = [this, &sst, &dir] (component_type type) {
+        auto src = sstable::filename(this->dir, sst._schema->ks_name(), sst._schema->cf_name(), sst._version, sst._generation, sst._format, type);
+        auto dst = sstable::filename(dir, sst._schema->ks_name(), sst._schema->cf_name(), sst._version, sst._generation, sst._format, type);
+        return sst.sstable_write_io_check(idempotent_link_file, std::move(src), std::move(dst));
+    };
+    co_await parallel_for_each(comps, [&make_link] (auto p) {
+        return p.first == component_type::TOC ? make_ready_future<>() : make_link(p.first);
+    });
+    co_await make_link(component_type::TOC);
 }
 
 future<> filesystem_storage::move(const sstable& sst, sstring new_dir, generation_type new_generation, delayed_commit_changes* delay_commit) {
@@ -419,6 +437,7 @@ future<> filesystem_storage::wipe(const sstable& sst) noexcept {
 
 class s3_storage : public sstables::storage {
     shared_ptr<s3::client> _client;
+    s3::block_cache* _block_cache;
     sstring _bucket;
     sstring _location;
     std::optional<sstring> _remote_prefix;
@@ -434,15 +453,16 @@ class s3_storage : public sstables::storage {
     static future<> delete_with_system_keyspace(std::vector<shared_sstable>);
 
 public:
-    s3_storage(shared_ptr<s3::client> client, sstring bucket, sstring dir)
+    s3_storage(shared_ptr<s3::client> client, s3::block_cache* block_cache, sstring bucket, sstring dir)
         : _client(std::move(client))
+        , _block_cache(block_cache)
         , _bucket(std::move(bucket))
         , _location(std::move(dir))
     {
     }
 
     virtual future<> seal(const sstable& sst) override;
-    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs) const override;
+    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, sync_links sync) const override;
     virtual future<> change_state(const sstable& sst, sstring to, generation_type generation, delayed_commit_changes* delay) override;
     // runs in async context
     virtual void open(sstable& sst) override;
@@ -492,7 +512,13 @@ void s3_storage::open(sstable& sst) {
 
 future<file> s3_storage::open_component(const sstable& sst, component_type type, open_flags flags, file_open_options options, bool check_integrity) {
     co_await ensure_remote_prefix(sst);
-    co_return _client->make_readable_file(make_s3_object_name(sst, type));
+    auto object_name = make_s3_object_name(sst, type);
+    auto f = _client->make_readable_file(object_name);
+    // Only the data and index files are read repeatedly, the rest is read once on load
+    if (_block_cache != nullptr && (type == component_type::Data || type == component_type::Index)) {
+        f = s3::make_cached_file(std::move(f), std::move(object_name), *_block_cache);
+    }
+    co_return f;
 }
 
 future<data_sink> s3_storage::make_data_or_index_sink(sstable& sst, component_type type) {
@@ -542,7 +568,7 @@ future<> s3_storage::delete_with_system_keyspace(std::vector<shared_sstable> sst
     });
 }
 
-future<> s3_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs) const {
+future<> s3_storage::snapshot(const sstable& sst, sstring dir, absolute_path abs, sync_links sync) const {
     co_await coroutine::return_exception(std::runtime_error("Snapshotting S3 objects not implemented"));
 }
 
@@ -552,7 +578,7 @@ std::unique_ptr<sstables::storage> make_storage(sstables_manager& manager, const
             return std::make_unique<sstables::filesystem_storage>(std::move(dir));
         },
         [dir, &manager] (const data_dictionary::storage_options::s3& os) mutable -> std::unique_ptr<sstables::storage> {
-            return std::make_unique<sstables::s3_storage>(manager.get_endpoint_client(os.endpoint), os.bucket, std::move(dir));
+            return std::make_unique<sstables::s3_storage>(manager.get_endpoint_client(os.endpoint), manager.get_s3_block_cache(), os.bucket, std::move(dir));
         }
     }, s_opts.value);
 }
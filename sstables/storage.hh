@@ -48,9 +48,12 @@ class storage {
     virtual ~storage() {}
 
     using absolute_path = bool_class<class absolute_path_tag>; // FIXME -- should go away eventually
+    // Whether snapshot() creates the directory and makes the links durable itself, rather than
+    // leaving it to the caller, which syncs the directory once all sstables were linked into it.
+    using sync_links = bool_class<class sync_links_tag>;
 
     virtual future<> seal(const sstable& sst) = 0;
-    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs) const = 0;
+    virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, sync_links sync) const = 0;
     virtual future<> change_state(const sstable& sst, sstring to, generation_type generation, delayed_commit_changes* delay) = 0;
     // runs in async context
     virtual void open(sstable& sst) = 0;
@@ -490,7 +490,8 @@ enum sstable_feature : uint8_t {
     CorrectStaticCompact = 3, // See #4139
     CorrectEmptyCounters = 4, // See #4363
     CorrectUDTsInCollections = 5, // See #6130
-    End = 6,
+    SplitBlockBloomFilter = 6, // Filter.db holds a utils::filter::split_block_bloom_filter
+    End = 7,
 };
 
 // Scylla-specific features enabled for a particular sstable.
@@ -18,6 +18,7 @@
 #include "streaming/stream_reason.hh"
 #include "readers/mutation_fragment_v1_stream.hh"
 #include "locator/abstract_replication_strategy.hh"
+#include "locator/token_range_splitter.hh"
 #include "message/messaging_service.hh"
 
 #include <cfloat>
@@ -164,6 +165,11 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
         nr_sst_current += sst_processed.size();
         auto permit = co_await _db.local().obtain_reader_permit(table, "sstables_loader::load_and_stream()", db::no_timeout, {});
         auto reader = mutation_fragment_v1_stream(table.make_streaming_reader(s, std::move(permit), full_partition_range, sst_set));
+        // The replica set is looked up once per range of the ring sharing it (a vnode or
+        // a tablet), rather than for every partition. Partitions with tokens up to
+        // current_targets_end go to current_targets.
+        auto splitter = erm->make_splitter();
+        std::optional<dht::token> current_targets_end;
         std::exception_ptr eptr;
         bool failed = false;
         try {
@@ -175,12 +181,19 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
                     auto& start = mf->as_partition_start();
                     const auto& current_dk = start.key();
 
-                    current_targets = erm->get_natural_endpoints(current_dk.token());
-                    if (primary_replica_only && current_targets.size() > 1) {
-                        current_targets.resize(1);
+                    if (current_targets_end && current_dk.token() <= *current_targets_end) {
+                        llog.trace("load_and_stream: ops_uuid={}, current_dk={}, current_targets={}", ops_uuid,
+                                current_dk.token(), current_targets);
+                    } else {
+                        splitter->reset(dht::ring_position_view(current_dk));
+                        current_targets_end = splitter->next_token().value_or(dht::maximum_token());
+                        current_targets = erm->get_natural_endpoints(current_dk.token());
+                        if (primary_replica_only && current_targets.size() > 1) {
+                            current_targets.resize(1);
+                        }
+                        llog.trace("load_and_stream: ops_uuid={}, current_dk={}, current_targets_end={}, current_targets={}", ops_uuid,
+                                current_dk.token(), *current_targets_end, current_targets);
                     }
-                    llog.trace("load_and_stream: ops_uuid={}, current_dk={}, current_targets={}", ops_uuid,
-                            current_dk.token(), current_targets);
                     for (auto& node : current_targets) {
                         if (!metas.contains(node)) {
                             auto [sink, source] = co_await ms.make_sink_and_source_for_stream_mutation_fragments(reader.schema()->version(),
@@ -17,6 +17,8 @@
 #include <seastar/core/metrics.hh>
 #include <seastar/core/coroutine.hh>
 #include "db/config.hh"
+#include "replica/database.hh"
+#include "gms/feature_service.hh"
 
 namespace streaming {
 
@@ -37,6 +39,7 @@ stream_manager::stream_manager(db::config& cfg,
         , _gossiper(gossiper)
         , _streaming_group(std::move(sg))
         , _io_throughput_mbs(cfg.stream_io_throughput_mb_per_sec)
+        , _enable_file_streaming(cfg.enable_sstable_file_streaming)
 {
     namespace sm = seastar::metrics;
 
@@ -92,6 +95,10 @@ future<> stream_manager::stop() {
     co_await _io_throughput_updater.join();
 }
 
+bool stream_manager::file_streaming_enabled() const noexcept {
+    return _enable_file_streaming() && _db.local().features().sstable_file_streaming;
+}
+
 future<> stream_manager::update_io_throughput(uint32_t value_mbs) {
     uint64_t bps = ((uint64_t)(value_mbs != 0 ? value_mbs : std::numeric_limits<uint32_t>::max())) << 20;
     return _streaming_group.update_io_bandwidth(bps).then_wrapped([value_mbs] (auto f) {
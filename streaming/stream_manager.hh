@@ -97,6 +97,7 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
     utils::updateable_value<uint32_t> _io_throughput_mbs;
     serialized_action _io_throughput_updater = serialized_action([this] { return update_io_throughput(_io_throughput_mbs()); });
     std::optional<utils::observer<uint32_t>> _io_throughput_option_observer;
+    utils::updateable_value<bool> _enable_file_streaming;
 
 public:
     stream_manager(db::config& cfg, sharded<replica::database>& db,
@@ -124,6 +125,9 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
     replica::database& db() noexcept { return _db.local(); }
     netw::messaging_service& ms() noexcept { return _ms.local(); }
 
+    // Whether sstables can be streamed as files, see STREAM_SSTABLE_FILES.
+    bool file_streaming_enabled() const noexcept;
+
     const std::unordered_map<plan_id, shared_ptr<stream_result_future>>& get_initiated_streams() const {
         return _initiated_streams;
     }
@@ -18,5 +18,23 @@ enum class stream_mutation_fragments_cmd : uint8_t {
     end_of_stream,
 };
 
+// Commands of STREAM_SSTABLE_FILES, which ships whole sstables.
+// Each sstable is sent as:
+//
+//   sstable_start (name: the sstable version, data: the contents of its TOC)
+//   ( component_start (name: the component's TOC entry)
+//     component_data (data: the next chunk of the component)* )*
+//   end_of_sstable
+//
+// and the stream is terminated by end_of_stream, or by error if the sender failed.
+enum class stream_sstable_files_cmd : uint8_t {
+    error,
+    sstable_start,
+    component_start,
+    component_data,
+    end_of_sstable,
+    end_of_stream,
+};
+
 
 }
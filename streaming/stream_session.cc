@@ -36,6 +36,7 @@
 #include "streaming/stream_mutation_fragments_cmd.hh"
 #include "consumer.hh"
 #include "readers/generating_v2.hh"
+#include "sstables/sstables.hh"
 
 namespace streaming {
 
@@ -86,6 +87,113 @@ class offstrategy_trigger {
     }
 };
 
+using sstable_files_source = rpc::source<stream_sstable_files_cmd, sstring, bytes>;
+
+// Receives the sstables sent by send_sstable_files(). They are written as
+// they are, and added to the table if they belong to this shard and don't
+// need view building. Otherwise their contents are distributed and written
+// like streamed mutation fragments.
+static future<uint64_t> receive_sstable_files(sharded<stream_manager>& sm, sharded<replica::database>& db,
+        sharded<db::system_distributed_keyspace>& sys_dist_ks, sharded<db::view::view_update_generator>& vug,
+        schema_ptr s, streaming::plan_id plan_id, gms::inet_address from, stream_reason reason, sstable_files_source source) {
+    return seastar::async([&sm, &db, &sys_dist_ks, &vug, s = std::move(s), plan_id, from, reason, source = std::move(source)] () mutable {
+        auto next = [&source] {
+            auto opt = source().get0();
+            if (!opt) {
+                throw std::runtime_error("Sender did not send end_of_stream");
+            }
+            if (std::get<0>(*opt) == stream_sstable_files_cmd::error) {
+                throw std::runtime_error("Sender failed");
+            }
+            return std::move(*opt);
+        };
+        auto wrong_cmd = [] (stream_sstable_files_cmd cmd) {
+            return std::runtime_error(format("Sender sent wrong cmd {}", int(cmd)));
+        };
+
+        auto& cf = db.local().find_column_family(s->id());
+        auto offstrategy = is_offstrategy_supported(reason);
+        offstrategy_trigger offstrategy_update(db, s->id(), plan_id);
+        auto use_view_update_path = db::view::check_needs_view_update_path(sys_dist_ks.local(), db.local().get_token_metadata(), cf, reason).get0();
+        uint64_t received_sstables = 0;
+
+        for (;;) {
+            auto [cmd, name, data] = next();
+            if (cmd == stream_sstable_files_cmd::end_of_stream) {
+                break;
+            }
+            if (cmd != stream_sstable_files_cmd::sstable_start) {
+                throw wrong_cmd(cmd);
+            }
+            auto version = sstables::version_from_string(name);
+            std::vector<sstables::component_type> components;
+            auto toc = to_sstring_view(data);
+            while (!toc.empty()) {
+                auto end = toc.find('\n');
+                auto entry = toc.substr(0, end);
+                toc.remove_prefix(end == toc.npos ? toc.size() : end + 1);
+                auto c = sstables::sstable::component_from_sstring(version, sstring(entry));
+                if (c == sstables::component_type::Unknown || c == sstables::component_type::TOC) {
+                    throw std::runtime_error(format("Sender sent an sstable with unexpected component {}", entry));
+                }
+                components.push_back(c);
+            }
+
+            auto sst = cf.make_streaming_sstable_for_file_stream(version);
+            sst->open_raw(components);
+            std::tie(cmd, name, data) = next();
+            while (cmd == stream_sstable_files_cmd::component_start) {
+                auto c = sstables::sstable::component_from_sstring(version, name);
+                if (std::find(components.begin(), components.end(), c) == components.end()) {
+                    throw std::runtime_error(format("Sender sent component {} which is not in the TOC", name));
+                }
+                auto out = sst->make_raw_component_output_stream(c).get0();
+                std::exception_ptr ex;
+                try {
+                    for (;;) {
+                        std::tie(cmd, name, data) = next();
+                        if (cmd != stream_sstable_files_cmd::component_data) {
+                            break;
+                        }
+                        out.write(reinterpret_cast<const char*>(data.data()), data.size()).get();
+                        sm.local().update_progress(plan_id, from, progress_info::direction::IN, data.size());
+                    }
+                    out.flush().get();
+                } catch (...) {
+                    ex = std::current_exception();
+                }
+                out.close().get();
+                if (ex) {
+                    std::rethrow_exception(std::move(ex));
+                }
+            }
+            if (cmd != stream_sstable_files_cmd::end_of_sstable) {
+                throw wrong_cmd(cmd);
+            }
+            sst->seal_sstable(false).get();
+            sst->load(s->get_sharder()).get();
+            offstrategy_update.update();
+            ++received_sstables;
+
+            if (sst->get_shards_for_this_sstable() == std::vector<unsigned>{this_shard_id()} && !use_view_update_path) {
+                cf.add_sstable_and_update_cache(sst, offstrategy).get();
+                continue;
+            }
+            // The sstable can't be used as is, write its contents like
+            // received mutation fragments, and drop it.
+            auto permit = db.local().obtain_reader_permit(cf, "stream-sstable-files", db::no_timeout, {}).get0();
+            auto ss = sst->get_schema();
+            mutation_writer::distribute_reader_and_consume_on_shards(ss,
+                sst->make_reader(ss, std::move(permit), query::full_partition_range, ss->full_slice()),
+                make_streaming_consumer("streaming", db, sys_dist_ks, vug, sst->get_estimated_key_count(), reason, offstrategy),
+                cf.stream_in_progress()
+            ).get();
+            sst->mark_for_deletion();
+        }
+        return received_sstables;
+    });
+}
+
 void stream_manager::init_messaging_service_handler(abort_source& as) {
     auto& ms = _ms.local();
 
@@ -202,6 +310,47 @@ void stream_manager::init_messaging_service_handler(abort_source& as) {
         });
       });
     });
+    ms.register_stream_sstable_files([this, &as] (const rpc::client_info& cinfo, streaming::plan_id plan_id, table_schema_version schema_id, table_id cf_id, stream_reason reason, sstable_files_source source) {
+        auto from = netw::messaging_service::get_source(cinfo);
+        sslog.trace("Got stream_sstable_files from {} reason {}", from, int(reason));
+        if (!_sys_dist_ks.local_is_initialized() || !_view_update_generator.local_is_initialized()) {
+            return make_exception_future<rpc::sink<int>>(std::runtime_error(format("Node {} is not fully initialized for streaming, try again later",
+                    utils::fb_utilities::get_broadcast_address())));
+        }
+        // The sstables are read with the table's schema, like any other
+        // sstable; getting the sender's one makes sure it's not older.
+        return _mm.local().get_schema_for_write(schema_id, from, _ms.local(), &as).then([this, from, plan_id, cf_id, source, reason] (schema_ptr s) mutable {
+            auto sink = _ms.local().make_sink_for_stream_sstable_files(source);
+          try {
+            // Make sure the table with cf_id is still present at this point.
+            // Close the sink in case the table is dropped.
+            auto op = _db.local().find_column_family(cf_id).stream_in_progress();
+            //FIXME: discarded future.
+            (void)receive_sstable_files(container(), _db, _sys_dist_ks, _view_update_generator, s, plan_id, from.addr, reason, std::move(source)).then_wrapped(
+                    [s, plan_id, from, sink, op = std::move(op)] (future<uint64_t> f) mutable {
+                int32_t status = 0;
+                if (f.failed()) {
+                    sslog.error("[Stream #{}] Failed to handle STREAM_SSTABLE_FILES (receive phase) for ks={}, cf={}, peer={}: {}",
+                            plan_id, s->ks_name(), s->cf_name(), from.addr, f.get_exception());
+                    status = -1;
+                } else {
+                    sslog.info("[Stream #{}] Received sstable files for ks={}, cf={}, sstables={}", plan_id, s->ks_name(), s->cf_name(), f.get0());
+                }
+                return sink(status).finally([sink] () mutable {
+                    return sink.close();
+                });
+            }).handle_exception([s, plan_id, from, sink] (std::exception_ptr ep) {
+                sslog.error("[Stream #{}] Failed to handle STREAM_SSTABLE_FILES (respond phase) for ks={}, cf={}, peer={}: {}",
+                        plan_id, s->ks_name(), s->cf_name(), from.addr, ep);
+            });
+          } catch (...) {
+            return sink.close().then([sink, eptr = std::current_exception()] () -> future<rpc::sink<int>> {
+                return make_exception_future<rpc::sink<int>>(eptr);
+            });
+          }
+            return make_ready_future<rpc::sink<int>>(sink);
+        });
+    });
     ms.register_stream_mutation_done([this] (const rpc::client_info& cinfo, streaming::plan_id plan_id, dht::token_range_vector ranges, table_id cf_id, unsigned dst_cpu_id) {
         const auto& from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
         return container().invoke_on(dst_cpu_id, [ranges = std::move(ranges), plan_id, cf_id, from] (auto& sm) mutable {
@@ -232,6 +381,7 @@ future<> stream_manager::uninit_messaging_service_handler() {
         ms.unregister_prepare_message(),
         ms.unregister_prepare_done_message(),
         ms.unregister_stream_mutation_fragments(),
+        ms.unregister_stream_sstable_files(),
         ms.unregister_stream_mutation_done(),
         ms.unregister_complete_message()).discard_result();
 }
@@ -30,6 +30,7 @@
 #include "sstables/sstables.hh"
 #include "replica/database.hh"
 #include "gms/feature_service.hh"
+#include <seastar/core/coroutine.hh>
 
 namespace streaming {
 
@@ -56,11 +57,14 @@ struct send_info {
     replica::column_family& cf;
     dht::token_range_vector ranges;
     dht::partition_range_vector prs;
+    // Sstables sent as files, which the reader skips.
+    std::vector<sstables::shared_sstable> files;
+    sstables::sstable_predicate not_sent_as_file;
     mutation_fragment_v1_stream reader;
     noncopyable_function<void(size_t)> update;
     send_info(netw::messaging_service& ms_, streaming::plan_id plan_id_, replica::table& tbl_, reader_permit permit_,
               dht::token_range_vector ranges_, netw::messaging_service::msg_addr id_,
-              uint32_t dst_cpu_id_, stream_reason reason_, noncopyable_function<void(size_t)> update_fn)
+              uint32_t dst_cpu_id_, stream_reason reason_, bool file_streaming, noncopyable_function<void(size_t)> update_fn)
         : ms(ms_)
         , plan_id(plan_id_)
         , cf_id(tbl_.schema()->id())
@@ -70,10 +74,35 @@ struct send_info {
         , cf(tbl_)
         , ranges(std::move(ranges_))
         , prs(dht::to_partition_ranges(ranges))
-        , reader(cf.make_streaming_reader(cf.schema(), std::move(permit_), prs))
+        , files(file_streaming ? select_files() : std::vector<sstables::shared_sstable>())
+        , not_sent_as_file([this] (const sstables::sstable& sst) {
+            return std::none_of(files.begin(), files.end(), [&sst] (const sstables::shared_sstable& f) { return f.get() == &sst; });
+        })
+        , reader(cf.make_streaming_reader(cf.schema(), std::move(permit_), prs, not_sent_as_file))
         , update(std::move(update_fn))
     {
     }
+    // Sstables can be sent as files if all their data is to be streamed, and
+    // if the receiver can use them as they are: they must be in a format it
+    // understands, and not be waiting for view building.
+    std::vector<sstables::shared_sstable> select_files() const {
+        std::vector<sstables::shared_sstable> ret;
+        auto sstables = cf.get_sstables();
+        for (auto& sst : *sstables) {
+            if (sst->get_version() < sstables::sstable_version_types::mc || sst->requires_view_building()
+                    || sst->get_shards_for_this_sstable().size() != 1) {
+                continue;
+            }
+            auto first = sst->get_first_decorated_key().token();
+            auto last = sst->get_last_decorated_key().token();
+            if (std::any_of(ranges.begin(), ranges.end(), [&] (const dht::token_range& r) {
+                return r.contains(first, dht::token_comparator()) && r.contains(last, dht::token_comparator());
+            })) {
+                ret.push_back(sst);
+            }
+        }
+        return ret;
+    }
     future<bool> has_relevant_range_on_this_shard() {
         return do_with(false, ranges.begin(), [this] (bool& found_relevant_range, dht::token_range_vector::iterator& ranges_it) {
             auto stop_cond = [this, &found_relevant_range, &ranges_it] { return ranges_it == ranges.end() || found_relevant_range; };
@@ -185,6 +214,90 @@ future<> send_mutation_fragments(lw_shared_ptr<send_info> si) {
  });
 }
 
+static future<> send_sstable_file(rpc::sink<stream_sstable_files_cmd, sstring, bytes>& sink, sstables::sstable& sst, send_info& si) {
+    // The receiver writes the TOC itself, from the list of components.
+    std::vector<std::pair<sstables::component_type, sstring>> components;
+    sstring toc;
+    for (auto& [c, name] : sst.all_components()) {
+        if (c == sstables::component_type::TOC || c == sstables::component_type::Unknown) {
+            continue;
+        }
+        toc += name + "\n";
+        components.emplace_back(c, name);
+    }
+    co_await sink(stream_sstable_files_cmd::sstable_start, fmt::to_string(sst.get_version()), bytes(to_bytes_view(toc)));
+    for (auto& [c, name] : components) {
+        co_await sink(stream_sstable_files_cmd::component_start, name, bytes());
+        auto in = co_await sst.make_raw_component_input_stream(c);
+        std::exception_ptr ex;
+        try {
+            for (;;) {
+                auto buf = co_await in.read();
+                if (buf.empty()) {
+                    break;
+                }
+                si.update(buf.size());
+                co_await sink(stream_sstable_files_cmd::component_data, sstring(), bytes(reinterpret_cast<const int8_t*>(buf.get()), buf.size()));
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await in.close();
+        if (ex) {
+            std::rethrow_exception(std::move(ex));
+        }
+    }
+    co_await sink(stream_sstable_files_cmd::end_of_sstable, sstring(), bytes());
+}
+
+future<> send_sstable_files(lw_shared_ptr<send_info> si) {
+    if (si->files.empty()) {
+        co_return;
+    }
+    sslog.info("[Stream #{}] Start sending ks={}, cf={}, sstables={}, as files", si->plan_id, si->cf.schema()->ks_name(), si->cf.schema()->cf_name(), si->files.size());
+    auto sink_and_source = co_await si->ms.make_sink_and_source_for_stream_sstable_files(si->cf.schema()->version(), si->plan_id, si->cf_id, si->reason, si->id);
+    auto& sink = std::get<0>(sink_and_source);
+    auto& source = std::get<1>(sink_and_source);
+    bool got_error_from_peer = false;
+
+    auto source_op = [&] () -> future<> {
+        // Read until EOS, see send_mutation_fragments().
+        while (auto status_opt = co_await source()) {
+            auto status = std::get<0>(*status_opt);
+            got_error_from_peer = status == -1;
+            sslog.debug("Got status code from peer={}, plan_id={}, cf_id={}, status={}", si->id.addr, si->plan_id, si->cf_id, status);
+        }
+    };
+
+    auto sink_op = [&] () -> future<> {
+        std::exception_ptr ex;
+        try {
+            for (auto& sst : si->files) {
+                if (got_error_from_peer) {
+                    throw std::runtime_error("Got status error code from peer");
+                }
+                co_await send_sstable_file(sink, *sst, *si);
+            }
+            co_await sink(stream_sstable_files_cmd::end_of_stream, sstring(), bytes());
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        if (ex) {
+            // Notify the receiver the sender has failed
+            co_await sink(stream_sstable_files_cmd::error, sstring(), bytes()).handle_exception([] (std::exception_ptr) {});
+        }
+        co_await sink.close();
+        if (ex) {
+            std::rethrow_exception(std::move(ex));
+        }
+    };
+
+    co_await when_all_succeed(source_op(), sink_op()).discard_result();
+    if (got_error_from_peer) {
+        throw std::runtime_error(format("Peer failed to process sstable files peer={}, plan_id={}, cf_id={}", si->id.addr, si->plan_id, si->cf_id));
+    }
+}
+
 future<> stream_transfer_task::execute() {
     auto plan_id = session->plan_id();
     auto cf_id = this->cf_id;
@@ -197,7 +310,7 @@ future<> stream_transfer_task::execute() {
     return sm.container().invoke_on_all([plan_id, cf_id, id, dst_cpu_id, ranges=this->_ranges, reason] (stream_manager& sm) mutable {
         auto& tbl = sm.db().find_column_family(cf_id);
       return sm.db().obtain_reader_permit(tbl, "stream-transfer-task", db::no_timeout, {}).then([&sm, &tbl, plan_id, cf_id, id, dst_cpu_id, ranges=std::move(ranges), reason] (reader_permit permit) mutable {
-        auto si = make_lw_shared<send_info>(sm.ms(), plan_id, tbl, std::move(permit), std::move(ranges), id, dst_cpu_id, reason, [&sm, plan_id, addr = id.addr] (size_t sz) {
+        auto si = make_lw_shared<send_info>(sm.ms(), plan_id, tbl, std::move(permit), std::move(ranges), id, dst_cpu_id, reason, sm.file_streaming_enabled(), [&sm, plan_id, addr = id.addr] (size_t sz) {
             sm.update_progress(plan_id, addr, streaming::progress_info::direction::OUT, sz);
         });
         return si->has_relevant_range_on_this_shard().then([si, plan_id, cf_id] (bool has_relevant_range_on_this_shard) {
@@ -206,7 +319,9 @@ future<> stream_transfer_task::execute() {
                         plan_id, cf_id, this_shard_id());
                 return make_ready_future<>();
             }
-            return send_mutation_fragments(std::move(si));
+            return send_sstable_files(si).then([si] {
+                return send_mutation_fragments(si);
+            });
         }).finally([si] {
             return si->reader.close();
         });
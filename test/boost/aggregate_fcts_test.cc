@@ -228,6 +228,79 @@ SEASTAR_TEST_CASE(test_aggregate_count) {
     });
 }
 
+// Enough rows to fill several batches of the batch accumulators, grouped so
+// that they are reset between groups.
+SEASTAR_TEST_CASE(test_aggregate_many_rows) {
+    return do_with_cql_env_thread([&] (auto& e) {
+        e.execute_cql("CREATE TABLE test(p int, c int, b bigint, i int, d double, primary key (p, c))").get();
+        const int rows = 600;
+        for (int p : {0, 1}) {
+            for (int c = 0; c < rows; ++c) {
+                auto b = std::numeric_limits<int64_t>::max() - c - p;
+                if (c % 3) {
+                    e.execute_cql(fmt::format("INSERT INTO test(p, c, b, i, d) VALUES ({}, {}, {}, {}, {})", p, c, b, c, c * 0.5)).get();
+                } else {
+                    e.execute_cql(fmt::format("INSERT INTO test(p, c, b, d) VALUES ({}, {}, {}, {})", p, c, b, c * 0.5)).get();
+                }
+            }
+        }
+
+        auto msg = e.execute_cql("SELECT p, avg(b), sum(i), count(i), count(*), min(i), max(i), sum(d), avg(d) FROM test GROUP BY p").get0();
+        std::vector<std::vector<bytes_opt>> expected;
+        for (int p : {0, 1}) {
+            boost::multiprecision::cpp_int b_sum = 0;
+            int32_t i_sum = 0;
+            int64_t i_count = 0;
+            double d_sum = 0;
+            for (int c = 0; c < rows; ++c) {
+                b_sum += std::numeric_limits<int64_t>::max() - c - p;
+                if (c % 3) {
+                    i_sum += c;
+                    ++i_count;
+                }
+                d_sum += c * 0.5;
+            }
+            expected.push_back({
+                int32_type->decompose(p),
+                long_type->decompose(static_cast<int64_t>(b_sum / rows)),
+                int32_type->decompose(i_sum),
+                long_type->decompose(i_count),
+                long_type->decompose(int64_t(rows)),
+                int32_type->decompose(int32_t(1)),
+                int32_type->decompose(int32_t(rows - 1)),
+                double_type->decompose(d_sum),
+                double_type->decompose(d_sum / rows),
+            });
+        }
+        assert_that(msg).is_rows().with_rows_ignore_order(expected);
+    });
+}
+
+SEASTAR_TEST_CASE(test_aggregate_minmax_floating_point) {
+    return do_with_cql_env_thread([&] (auto& e) {
+        e.execute_cql("CREATE TABLE test(p int, c int, f float, d double, primary key (p, c))").get();
+        // Enough rows to fill a few input buffers, ordered as floating_type_impl compares them
+        const int rows = 600;
+        for (int c = 1; c <= rows; ++c) {
+            e.execute_cql(fmt::format("INSERT INTO test(p, c, f, d) VALUES (0, {}, {}, {})", c, -c * 0.5, c * 0.5)).get();
+        }
+        e.execute_cql("INSERT INTO test(p, c, f, d) VALUES (1, 0, 0.0, -0.0)").get();
+        e.execute_cql("INSERT INTO test(p, c, f, d) VALUES (1, 1, -0.0, 0.0)").get();
+        e.execute_cql("INSERT INTO test(p, c, f, d) VALUES (2, 0, NaN, 1.0)").get();
+        e.execute_cql("INSERT INTO test(p, c, f, d) VALUES (2, 1, -Infinity, NaN)").get();
+
+        auto msg = e.execute_cql("SELECT p, min(f), max(f), min(d), max(d) FROM test GROUP BY p").get0();
+        assert_that(msg).is_rows().with_rows_ignore_order({
+            {int32_type->decompose(0), float_type->decompose(float(-rows * 0.5)), float_type->decompose(-0.5f),
+                    double_type->decompose(0.5), double_type->decompose(rows * 0.5)},
+            {int32_type->decompose(1), float_type->decompose(-0.f), float_type->decompose(0.f),
+                    double_type->decompose(-0.), double_type->decompose(0.)},
+            {int32_type->decompose(2), float_type->decompose(-std::numeric_limits<float>::infinity()), float_type->decompose(std::numeric_limits<float>::quiet_NaN()),
+                    double_type->decompose(1.), double_type->decompose(std::numeric_limits<double>::quiet_NaN())},
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_reverse_type_aggregation) {
     return do_with_cql_env_thread([&] (auto& e) {
         e.execute_cql("CREATE TABLE test(p int, c timestamp, v int, primary key (p, c)) with clustering order by (c desc)").get();
@@ -165,4 +165,21 @@ BOOST_AUTO_TEST_CASE(test_magnitude_and_precision) {
     BOOST_CHECK(res.magnitude > 1000);
     res = alternator::internal::get_magnitude_and_precision("1e-1000000000000");
     BOOST_CHECK(res.magnitude < -1000);
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(test_serialize_item_round_trip) {
+    for (auto json : {
+            R"({"S":"hello"})",
+            R"({"S":""})",
+            R"({"N":"12.5"})",
+            R"({"B":"YWJj"})",
+            R"({"BOOL":true})",
+            R"({"BOOL":false})",
+            R"({"L":[{"S":"a"},{"N":"1"}]})",
+            R"({"M":{"k":{"S":"v"}}})",
+            R"({"SS":["a","b"]})",
+            R"({"NULL":true})"}) {
+        auto item = rjson::parse(json);
+        auto serialized = alternator::serialize_item(item);
+        BOOST_REQUIRE_EQUAL(rjson::print(alternator::deserialize_item(serialized)), rjson::print(item));
+    }
+}
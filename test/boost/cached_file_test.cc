@@ -262,6 +262,43 @@ SEASTAR_THREAD_TEST_CASE(test_eviction_via_lru) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(test_reused_page_survives_scan) {
+    auto page = cached_file::page_size;
+    auto pages = 10;
+    test_file tf = make_test_file(page * pages);
+
+    cached_file::metrics metrics;
+    logalloc::region region;
+    cached_file cf(tf.f, metrics, cf_lru, region, tf.contents.size());
+
+    // Page 0 is read twice, which promotes it to the protected segment.
+    BOOST_REQUIRE_EQUAL(tf.contents.substr(0, 1), read_to_string(cf, 0, 1));
+    BOOST_REQUIRE_EQUAL(tf.contents.substr(0, 1), read_to_string(cf, 0, 1));
+    BOOST_REQUIRE_EQUAL(1, metrics.page_hits);
+
+    // Scan the other pages once.
+    for (int i = 1; i < pages; ++i) {
+        BOOST_REQUIRE_EQUAL(tf.contents.substr(page * i, 1), read_to_string(cf, page * i, 1));
+    }
+    BOOST_REQUIRE_EQUAL(pages, metrics.page_misses);
+
+    // Evicting as many pages as the scan brought in must not evict page 0.
+    with_allocator(region.allocator(), [&] {
+        for (int i = 1; i < pages; ++i) {
+            cf_lru.evict();
+        }
+    });
+    BOOST_REQUIRE_EQUAL(pages - 1, metrics.page_evictions);
+
+    BOOST_REQUIRE_EQUAL(tf.contents.substr(0, 1), read_to_string(cf, 0, 1));
+    BOOST_REQUIRE_EQUAL(pages, metrics.page_misses);
+    BOOST_REQUIRE_EQUAL(2, metrics.page_hits);
+
+    with_allocator(region.allocator(), [] {
+        cf_lru.evict_all();
+    });
+}
+
 // A file which serves garbage but is very fast.
 class garbage_file_impl : public file_impl {
 private:
@@ -609,6 +609,23 @@ SEASTAR_THREAD_TEST_CASE(test_pre_post_image_logging) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_pre_image_local_reads) {
+    auto db_cfg_ptr = make_shared<db::config>();
+    db_cfg_ptr->cdc_preimage_local_reads({true}, db::config::config_source::CommandLine);
+
+    do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE ks.tbl (pk int, ck int, val int, PRIMARY KEY(pk, ck)) WITH cdc = {'enabled':'true', 'preimage':'true'}");
+        cquery_nofail(e, "UPDATE ks.tbl SET val = 1 WHERE pk = 0 AND ck = 0");
+        cquery_nofail(e, "UPDATE ks.tbl SET val = 2 WHERE pk = 0 AND ck = 0");
+
+        auto rows = select_log(e, "tbl");
+        auto pre_image = to_bytes_filtered(*rows, cdc::operation::pre_image);
+        BOOST_REQUIRE_EQUAL(pre_image.size(), 1);
+        auto val_index = column_index(*rows, cdc::log_data_column_name("val"));
+        BOOST_REQUIRE_EQUAL(int32_type->decompose(1), *pre_image[0][val_index]);
+    }, db_cfg_ptr).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_pre_post_image_logging_static_row) {
     do_with_cql_env_thread([](cql_test_env& e) {
         auto test = [&e] (bool enabled, bool with_ttl) {
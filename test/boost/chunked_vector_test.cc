@@ -241,3 +241,32 @@ BOOST_AUTO_TEST_CASE(test_amoritzed_reserve) {
     amortized_reserve(v, 1);
     BOOST_REQUIRE_EQUAL(v.capacity(), 8);
 }
+
+BOOST_AUTO_TEST_CASE(test_chunk_pool_reuse) {
+    using vector_type = utils::chunked_vector<uint64_t, 4096>;
+    auto& pool = utils::chunked_vector_chunk_pool<4096>::local();
+    auto pooled = pool.pooled_chunks();
+
+    {
+        vector_type v;
+        v.reserve(vector_type::max_chunk_capacity() * 3);
+        BOOST_REQUIRE_EQUAL(pool.pooled_chunks(), pooled);
+    }
+    // The full chunks are kept for reuse
+    BOOST_REQUIRE_EQUAL(pool.pooled_chunks(), pooled + 3);
+
+    {
+        vector_type v;
+        v.reserve(vector_type::max_chunk_capacity() * 2);
+        BOOST_REQUIRE_EQUAL(pool.pooled_chunks(), pooled + 1);
+        v.push_back(1);
+    }
+    BOOST_REQUIRE_EQUAL(pool.pooled_chunks(), pooled + 3);
+
+    // Small chunks are not pooled
+    {
+        vector_type v;
+        v.push_back(1);
+    }
+    BOOST_REQUIRE_EQUAL(pool.pooled_chunks(), pooled + 3);
+}
@@ -9,6 +9,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/irange.hpp>
 
 #include <stdlib.h>
 #include <iostream>
@@ -24,10 +25,14 @@
 #include <seastar/core/scollectd_api.hh>
 #include <seastar/core/file.hh>
 #include <seastar/core/seastar.hh>
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/when_all.hh>
 #include <seastar/util/noncopyable_function.hh>
 #include <seastar/util/closeable.hh>
 
 #include "utils/UUID_gen.hh"
+#include "utils/crc.hh"
+#include "schema/schema_builder.hh"
 #include "test/lib/tmpdir.hh"
 #include "db/commitlog/commitlog.hh"
 #include "db/commitlog/commitlog_replayer.hh"
@@ -42,6 +47,7 @@
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/mutation_source_test.hh"
 #include "test/lib/key_utils.hh"
+#include "test/lib/random_utils.hh"
 
 using namespace db;
 
@@ -134,6 +140,29 @@ SEASTAR_TEST_CASE(test_commitlog_written_to_disk_no_sync){
         });
 }
 
+// check that concurrent entries marked as sync share the flushes in periodic mode
+SEASTAR_TEST_CASE(test_commitlog_group_commit_sync){
+    commitlog::config cfg;
+    cfg.commitlog_sync_period_in_ms = 10000000000;
+    cfg.batch_group_commit_window = std::chrono::milliseconds(100);
+    return cl_test(cfg, [](commitlog& log) {
+        constexpr size_t n = 10;
+        auto uuid = make_table_id();
+        return parallel_for_each(boost::irange(size_t(0), n), [&log, uuid] (size_t) {
+            sstring tmp = "hej bubba cow";
+            return log.add_mutation(uuid, tmp.size(), db::commitlog::force_sync::yes, [tmp](db::commitlog::output& dst) {
+                        dst.write(tmp.data(), tmp.size());
+                    }).then([](replay_position rp) {
+                        BOOST_CHECK_NE(rp, db::replay_position());
+                    });
+        }).then([&log] {
+            auto flushes = log.get_flush_count();
+            BOOST_REQUIRE(flushes > 0);
+            BOOST_REQUIRE(flushes < n);
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_commitlog_written_to_disk_periodic){
     return cl_test([](commitlog& log) {
             auto state = make_lw_shared<bool>(false);
@@ -724,6 +753,180 @@ SEASTAR_TEST_CASE(test_commitlog_add_entries) {
     });
 }
 
+// Checks that every entry of the segments can be replayed in order, i.e. that
+// its entry or an earlier one of the segment carries its column mapping.
+static size_t check_column_mappings(const std::vector<sstring>& segments) {
+    size_t entries = 0;
+    for (auto& seg : segments) {
+        std::unordered_set<table_schema_version> known;
+        db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, [&](db::commitlog::buffer_and_replay_position buf_rp) {
+            commitlog_entry_reader r(buf_rp.buffer);
+            auto version = r.mutation().schema_version();
+            if (r.get_column_mapping()) {
+                known.emplace(version);
+            }
+            BOOST_REQUIRE_MESSAGE(known.contains(version), format("entry at {} of unknown schema version {}", buf_rp.position, version));
+            ++entries;
+            return make_ready_future<>();
+        }).get();
+    }
+    return entries;
+}
+
+SEASTAR_TEST_CASE(test_commitlog_compressed_entries) {
+    commitlog::config cfg;
+    cfg.use_compression = true;
+    return cl_test(cfg, [](commitlog& log) {
+        return seastar::async([&] {
+            random_mutation_generator gen(random_mutation_generator::generate_counters(false));
+            auto s = gen.schema();
+            std::vector<frozen_mutation> mutations;
+            std::vector<replay_position> rps;
+            for (auto& m : gen(20)) {
+                mutations.emplace_back(freeze(m));
+                commitlog_entry_writer cew(s, mutations.back(), db::commitlog::force_sync::no);
+                rps.emplace_back(log.add_entry(s->id(), cew, db::no_timeout).get0().release());
+            }
+            // One entry which compresses well and one which doesn't, so both entry formats are used.
+            auto uuid = make_table_id();
+            auto random = tests::random::get_bytes(1024);
+            std::vector<sstring> data = { sstring(64 * 1024, 'x'), sstring(reinterpret_cast<const char*>(random.data()), random.size()) };
+            std::vector<replay_position> data_rps;
+            for (auto& d : data) {
+                data_rps.emplace_back(log.add_mutation(uuid, d.size(), db::commitlog::force_sync::no, [&d](db::commitlog::output& dst) {
+                    dst.write(d.data(), d.size());
+                }).get0().release());
+            }
+            log.sync_all_segments().get();
+
+            auto segments = log.get_active_segment_names();
+            BOOST_REQUIRE(!segments.empty());
+            size_t found = 0;
+            for (auto& seg : segments) {
+                BOOST_REQUIRE_EQUAL(commitlog::descriptor(seg).ver, commitlog::descriptor::segment_version_3);
+                db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, [&](db::commitlog::buffer_and_replay_position buf_rp) {
+                    auto& [buf, rp] = buf_rp;
+                    if (auto i = std::find(data_rps.begin(), data_rps.end(), rp); i != data_rps.end()) {
+                        auto linearization_buffer = bytes_ostream();
+                        auto in = buf.get_istream();
+                        auto str = to_sstring_view(in.read_bytes_view(buf.size_bytes(), linearization_buffer));
+                        BOOST_REQUIRE(str == data.at(std::distance(data_rps.begin(), i)));
+                        ++found;
+                    } else if (auto i = std::find(rps.begin(), rps.end(), rp); i != rps.end()) {
+                        commitlog_entry_reader r(buf);
+                        auto& fm = mutations.at(std::distance(rps.begin(), i));
+                        BOOST_CHECK_EQUAL(fm.unfreeze(s), r.mutation().unfreeze(s));
+                        ++found;
+                    }
+                    return make_ready_future<>();
+                }).get();
+            }
+            BOOST_REQUIRE_EQUAL(found, rps.size() + data_rps.size());
+        });
+    });
+}
+
+// An entry of a compressed segment which doesn't fit in a batch mode buffer
+// is retried after a sync. The entries of its schema version written in the
+// meantime must still carry the column mapping.
+SEASTAR_TEST_CASE(test_commitlog_compressed_entries_retried_with_new_schema) {
+    commitlog::config cfg;
+    cfg.use_compression = true;
+    cfg.mode = commitlog::sync_mode::BATCH;
+    return cl_test(cfg, [](commitlog& log) {
+        return seastar::async([&] {
+            using force_sync = commitlog_entry_writer::force_sync;
+
+            std::vector<schema_ptr> schemas;
+            std::deque<frozen_mutation> mutations;
+            std::vector<future<rp_handle>> writes;
+            auto write = [&] (schema_ptr s, bytes value) {
+                mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(int32_t(mutations.size()))));
+                m.set_clustered_cell(clustering_key::make_empty(), to_bytes("v"), data_value(std::move(value)), api::new_timestamp());
+                mutations.emplace_back(freeze(m));
+                commitlog_entry_writer cew(s, mutations.back(), force_sync::no);
+                writes.emplace_back(log.add_entry(s->id(), cew, db::no_timeout));
+            };
+            auto make_schema = [] (int i) {
+                return schema_builder("ks", format("cf{}", i))
+                        .with_column("pk", int32_type, column_kind::partition_key)
+                        .with_column("v", bytes_type)
+                        .build();
+            };
+
+            // The first write is in flight while the second waits in the buffer,
+            // so the large (and incompressible) entries don't fit.
+            schemas.emplace_back(make_schema(0));
+            write(schemas.back(), tests::random::get_bytes(16));
+            write(schemas.back(), tests::random::get_bytes(16));
+            for (int i = 1; i <= 4; ++i) {
+                schemas.emplace_back(make_schema(i));
+                write(schemas.back(), tests::random::get_bytes(200 * 1024));
+                write(schemas.back(), tests::random::get_bytes(16));
+            }
+            for (auto& f : when_all_succeed(writes.begin(), writes.end()).get0()) {
+                f.release();
+            }
+
+            auto segments = log.get_active_segment_names();
+            BOOST_REQUIRE(!segments.empty());
+            BOOST_REQUIRE_EQUAL(check_column_mappings(segments), mutations.size());
+        });
+    });
+}
+
+// Sets the format byte of the entry of a compressed segment at `pos`, and fixes
+// up the entry checksum, so that only decoding the entry fails.
+static future<> corrupt_entry_format(sstring seg, uint64_t pos, uint8_t format) {
+    auto f = co_await open_file_dma(seg, open_flags::rw);
+    auto size = align_up<size_t>(pos + 4096, 4096);
+    auto buf = co_await f.dma_read_exactly<char>(0, size);
+    auto p = buf.get_write() + pos;
+    auto es = read_be<uint32_t>(p);
+    p[2 * sizeof(uint32_t)] = char(format);
+    utils::crc32 crc;
+    crc.process_be(es);
+    crc.process(reinterpret_cast<const uint8_t*>(p + 2 * sizeof(uint32_t)), es - 3 * sizeof(uint32_t));
+    write_be<uint32_t>(p + es - sizeof(uint32_t), crc.get());
+    co_await f.dma_write(0, buf.get(), buf.size());
+    co_await f.close();
+}
+
+SEASTAR_TEST_CASE(test_commitlog_compressed_entry_format_corruption) {
+    commitlog::config cfg;
+    cfg.commitlog_segment_size_in_mb = 1;
+    cfg.use_compression = true;
+    return cl_test(cfg, [](commitlog& log) -> future<> {
+        auto uuid = make_table_id();
+        std::vector<db::replay_position> rps;
+        while (rps.size() < 2) {
+            sstring tmp = "hej bubba cow";
+            auto h = co_await log.add_mutation(uuid, tmp.size(), db::commitlog::force_sync::no, [tmp](db::commitlog::output& dst) {
+                dst.write(tmp.data(), tmp.size());
+            });
+            rps.push_back(h.release());
+        }
+        co_await log.sync_all_segments();
+        auto segments = log.get_active_segment_names();
+        BOOST_REQUIRE(!segments.empty());
+        auto seg = segments[0];
+        co_await corrupt_entry_format(seg, rps.at(1).pos, 0x7f);
+
+        std::vector<db::replay_position> read;
+        try {
+            co_await db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, [&read](db::commitlog::buffer_and_replay_position buf_rp) {
+                read.push_back(buf_rp.position);
+                return make_ready_future<>();
+            });
+            BOOST_FAIL("Expected exception");
+        } catch (commitlog::segment_data_corruption_error& e) {
+            BOOST_REQUIRE(e.bytes() > 0);
+        }
+        BOOST_REQUIRE_EQUAL(read.size(), 1);
+        BOOST_REQUIRE_EQUAL(read.front(), rps.at(0));
+    });
+}
+
 SEASTAR_TEST_CASE(test_commitlog_new_segment_odsync){
     commitlog::config cfg;
     cfg.commitlog_segment_size_in_mb = 1;
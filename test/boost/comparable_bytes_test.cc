@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+#include "test/lib/random_utils.hh"
+
+#include "types/comparable_bytes.hh"
+#include "types/types.hh"
+#include "schema/schema_builder.hh"
+#include "mutation/position_in_partition.hh"
+#include "dht/i_partitioner.hh"
+#include "utils/UUID_gen.hh"
+
+using namespace std::string_view_literals;
+
+// Checks that comparing the encodings gives the same result as the type's
+// compare() for all pairs of values, for the type and its reversed variant.
+static void check_ordering(data_type type, std::vector<managed_bytes> values) {
+    values.emplace_back(); // empty
+    for (auto t : {type, data_type(reversed_type_impl::get_instance(type))}) {
+        BOOST_REQUIRE(comparable_bytes::is_supported(*t));
+        for (auto& a : values) {
+            auto ea = comparable_bytes::from_value(*t, a);
+            for (auto& b : values) {
+                auto eb = comparable_bytes::from_value(*t, b);
+                auto expected = t->compare(a, b);
+                auto actual = compare_unsigned(ea, eb);
+                if (expected != actual) {
+                    BOOST_FAIL(fmt::format("{}: compare({}, {}) = {}, on encodings ({}, {}) = {}", t->name(),
+                            to_hex(a), to_hex(b), expected < 0 ? -1 : int(expected > 0),
+                            to_hex(ea), to_hex(eb), actual < 0 ? -1 : int(actual > 0)));
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+static std::vector<managed_bytes> decompose_all(data_type type, std::vector<T> values) {
+    std::vector<managed_bytes> res;
+    for (auto& v : values) {
+        res.emplace_back(type->decompose(data_value(v)));
+    }
+    return res;
+}
+
+SEASTAR_THREAD_TEST_CASE(test_string_ordering) {
+    std::vector<managed_bytes> values;
+    for (auto s : {"a", "ab", "abc", "b", "\xff", "\xff\xff"}) {
+        values.emplace_back(to_managed_bytes(sstring(s)));
+    }
+    // Values with zero bytes, which need escaping.
+    for (std::string_view s : {"\0"sv, "\0\0"sv, "a\0"sv, "a\0\1"sv, "a\1"sv}) {
+        values.emplace_back(bytes(reinterpret_cast<const int8_t*>(s.data()), s.size()));
+    }
+    check_ordering(utf8_type, values);
+    check_ordering(ascii_type, values);
+    check_ordering(bytes_type, values);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_integer_ordering) {
+    check_ordering(byte_type, decompose_all<int8_t>(byte_type, {-128, -1, 0, 1, 127}));
+    check_ordering(short_type, decompose_all<int16_t>(short_type, {-32768, -256, -1, 0, 1, 255, 256, 32767}));
+    check_ordering(int32_type, decompose_all<int32_t>(int32_type,
+            {std::numeric_limits<int32_t>::min(), -65536, -1, 0, 1, 255, 65536, std::numeric_limits<int32_t>::max()}));
+    check_ordering(long_type, decompose_all<int64_t>(long_type,
+            {std::numeric_limits<int64_t>::min(), -(int64_t(1) << 40), -1, 0, 1, int64_t(1) << 40, std::numeric_limits<int64_t>::max()}));
+    check_ordering(boolean_type, decompose_all<bool>(boolean_type, {false, true}));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_floating_point_ordering) {
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+    auto inf = std::numeric_limits<double>::infinity();
+    check_ordering(double_type, decompose_all<double>(double_type, {-inf, -1e300, -1.5, -0.0, 0.0, 1e-300, 1.5, inf, nan, -nan}));
+    auto fnan = std::numeric_limits<float>::quiet_NaN();
+    auto finf = std::numeric_limits<float>::infinity();
+    check_ordering(float_type, decompose_all<float>(float_type, {-finf, -1.5f, -0.0f, 0.0f, 1.5f, finf, fnan, -fnan}));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_time_ordering) {
+    using namespace std::chrono;
+    std::vector<db_clock::time_point> tps;
+    for (auto ms : {-1000000, -1, 0, 1, 1000000}) {
+        tps.push_back(db_clock::time_point(milliseconds(ms)));
+    }
+    check_ordering(timestamp_type, decompose_all(timestamp_type, tps));
+
+    std::vector<utils::UUID> timeuuids;
+    for (auto ms : {0, 1, 1000, 1000000}) {
+        timeuuids.push_back(utils::UUID_gen::get_time_UUID(milliseconds(ms), 0));
+        timeuuids.push_back(utils::UUID_gen::get_time_UUID(milliseconds(ms), -1));
+        timeuuids.push_back(utils::UUID_gen::get_time_UUID(milliseconds(ms), 0x7f7f7f7f7f7f7f7f));
+    }
+    check_ordering(timeuuid_type, decompose_all(timeuuid_type, timeuuids));
+
+    auto uuids = timeuuids;
+    for (int i = 0; i < 10; ++i) {
+        uuids.push_back(utils::make_random_uuid());
+    }
+    check_ordering(uuid_type, decompose_all(uuid_type, uuids));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_unsupported_types) {
+    BOOST_REQUIRE(!comparable_bytes::is_supported(*varint_type));
+    BOOST_REQUIRE(!comparable_bytes::is_supported(*list_type_impl::get_instance(int32_type, false)));
+    BOOST_REQUIRE_THROW(comparable_bytes::from_value(*varint_type, managed_bytes(varint_type->decompose(data_value(utils::multiprecision_int(1))))),
+            std::invalid_argument);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_clustering_prefix_ordering) {
+    auto s = schema_builder("ks", "cf")
+        .with_column("pk", int32_type, column_kind::partition_key)
+        .with_column("ck1", int32_type, column_kind::clustering_key)
+        .with_column("ck2", reversed_type_impl::get_instance(utf8_type), column_kind::clustering_key)
+        .with_column("v", int32_type)
+        .build();
+    BOOST_REQUIRE(comparable_bytes::clustering_key_is_supported(*s));
+
+    std::vector<position_in_partition> positions;
+    auto add = [&] (clustering_key_prefix ck) {
+        for (auto w : {bound_weight::before_all_prefixed, bound_weight::equal, bound_weight::after_all_prefixed}) {
+            positions.emplace_back(partition_region::clustered, w, ck);
+        }
+    };
+    add(clustering_key_prefix::make_empty());
+    for (int32_t ck1 : {-1, 0, 7}) {
+        add(clustering_key_prefix::from_exploded(*s, {int32_type->decompose(ck1)}));
+        for (auto ck2 : {"", "a", "ab", "b"}) {
+            add(clustering_key_prefix::from_exploded(*s, {int32_type->decompose(ck1), utf8_type->decompose(sstring(ck2))}));
+        }
+    }
+
+    position_in_partition::tri_compare cmp(*s);
+    for (auto& a : positions) {
+        auto ea = comparable_bytes::from_clustering_prefix(*s, a.key(), a.get_bound_weight());
+        for (auto& b : positions) {
+            auto eb = comparable_bytes::from_clustering_prefix(*s, b.key(), b.get_bound_weight());
+            if (cmp(a, b) != compare_unsigned(ea, eb)) {
+                BOOST_FAIL(fmt::format("{} vs {}: encodings {} and {} compare differently", a, b, to_hex(ea), to_hex(eb)));
+            }
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_clustering_prefix_head) {
+    auto s = schema_builder("ks", "cf")
+        .with_column("pk", int32_type, column_kind::partition_key)
+        .with_column("ck1", utf8_type, column_kind::clustering_key)
+        .with_column("ck2", varint_type, column_kind::clustering_key)
+        .with_column("v", int32_type)
+        .build();
+    BOOST_REQUIRE(!comparable_bytes::clustering_key_is_supported(*s));
+
+    std::vector<position_in_partition> positions;
+    auto add = [&] (clustering_key_prefix ck) {
+        for (auto w : {bound_weight::before_all_prefixed, bound_weight::equal, bound_weight::after_all_prefixed}) {
+            positions.emplace_back(partition_region::clustered, w, ck);
+        }
+    };
+    add(clustering_key_prefix::make_empty());
+    for (auto ck1 : {"", "a", "abcdefgh", "abcdefghij", "b"}) {
+        add(clustering_key_prefix::from_exploded(*s, {utf8_type->decompose(sstring(ck1))}));
+        for (int ck2 : {-1, 0, 1}) {
+            add(clustering_key_prefix::from_exploded(*s, {utf8_type->decompose(sstring(ck1)),
+                    varint_type->decompose(data_value(utils::multiprecision_int(ck2)))}));
+        }
+    }
+
+    position_in_partition::tri_compare cmp(*s);
+    auto head = [&] (const position_in_partition& p) {
+        std::array<uint8_t, 8> buf;
+        comparable_bytes::clustering_prefix_head(*s, p.key(), p.get_bound_weight(), buf);
+        return bytes(reinterpret_cast<const int8_t*>(buf.data()), buf.size());
+    };
+    for (auto& a : positions) {
+        auto ha = head(a);
+        for (auto& b : positions) {
+            auto hb = head(b);
+            if (cmp(a, b) < 0 && compare_unsigned(ha, hb) > 0) {
+                BOOST_FAIL(fmt::format("{} < {}, but their heads {} and {} compare the other way round", a, b, to_hex(ha), to_hex(hb)));
+            }
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_decorated_key_ordering) {
+    for (auto pk_type : {int32_type, utf8_type}) {
+        auto s = schema_builder("ks", "cf")
+            .with_column("pk1", pk_type, column_kind::partition_key)
+            .with_column("pk2", int32_type, column_kind::partition_key)
+            .with_column("v", int32_type)
+            .build();
+        std::vector<dht::decorated_key> keys;
+        for (int i = 0; i < 100; ++i) {
+            auto v = pk_type == int32_type ? pk_type->decompose(int32_t(i)) : pk_type->decompose(tests::random::get_sstring(i % 7));
+            auto pk = partition_key::from_exploded(*s, {v, int32_type->decompose(int32_t(i % 3))});
+            auto dk = dht::decorate_key(*s, pk);
+            // Same token, different key.
+            keys.emplace_back(dk.token(), partition_key::from_exploded(*s, {v, int32_type->decompose(int32_t(i % 5))}));
+            keys.push_back(std::move(dk));
+        }
+        for (auto& a : keys) {
+            auto ea = comparable_bytes::from_decorated_key(*s, a);
+            for (auto& b : keys) {
+                auto eb = comparable_bytes::from_decorated_key(*s, b);
+                BOOST_REQUIRE(a.tri_compare(*s, b) == compare_unsigned(ea, eb));
+            }
+        }
+    }
+    BOOST_REQUIRE(compare_unsigned(comparable_bytes::from_token(dht::minimum_token()),
+            comparable_bytes::from_token(dht::token(dht::token::kind::key, std::numeric_limits<int64_t>::min() + 1))) < 0);
+    BOOST_REQUIRE(compare_unsigned(comparable_bytes::from_token(dht::token(dht::token::kind::key, std::numeric_limits<int64_t>::max())),
+            comparable_bytes::from_token(dht::maximum_token())) < 0);
+}
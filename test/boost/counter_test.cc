@@ -7,6 +7,7 @@
  */
 
 #include "counters.hh"
+#include "counter_cache.hh"
 
 #include <random>
 
@@ -478,6 +479,87 @@ SEASTAR_TEST_CASE(test_transfer_updates_to_shards) {
     });
 }
 
+SEASTAR_TEST_CASE(test_counter_cache) {
+    return seastar::async([] {
+        auto s = get_schema();
+        auto host_id = locator::host_id::create_null_id();
+        auto local_id = counter_id(host_id.uuid());
+
+        auto pk = partition_key::from_single_value(*s, int32_type->decompose(0));
+        auto ck = clustering_key::from_single_value(*s, int32_type->decompose(0));
+        auto& col = *s->get_column_definition(utf8_type->decompose(sstring("c1")));
+        auto& scol = *s->get_column_definition(utf8_type->decompose(sstring("s1")));
+
+        auto make_update = [&] (int64_t c, int64_t st) {
+            mutation m(s, pk);
+            m.set_clustered_cell(ck, col, atomic_cell::make_live_counter_update(api::new_timestamp(), c));
+            m.set_static_cell(scol, atomic_cell::make_live_counter_update(api::new_timestamp(), st));
+            return m;
+        };
+
+        counter_cache_tracker tracker(1 << 20);
+        counter_cache cache(s, tracker);
+
+        // Computes the shards of an update like the leader does, with the
+        // current state coming from the cache when cached, from \p state otherwise.
+        auto apply = [&] (mutation& state, int64_t c, int64_t st) {
+            auto m = make_update(c, st);
+            auto generation = cache.generation();
+            auto cached = cache.lookup(m, local_id);
+            transform_counter_updates_to_shards(m, cached ? &*cached : &state, 0, host_id);
+            state.apply(m);
+            cache.update(m, local_id, generation);
+            return bool(cached);
+        };
+
+        mutation state(s, pk);
+        BOOST_REQUIRE(!apply(state, 5, 4));
+        BOOST_REQUIRE(apply(state, 9, 8));
+        BOOST_REQUIRE(apply(state, -1, 1));
+        BOOST_REQUIRE_EQUAL(counter_cell_view(get_counter_cell(state)).total_value(), 13);
+        BOOST_REQUIRE_EQUAL(counter_cell_view(get_static_counter_cell(state)).total_value(), 13);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().hits, 2);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().misses, 0);
+
+        // Updates of cells which aren't cached miss.
+        auto ck2 = clustering_key::from_single_value(*s, int32_type->decompose(1));
+        mutation m(s, pk);
+        m.set_clustered_cell(ck2, col, atomic_cell::make_live_counter_update(api::new_timestamp(), 1));
+        BOOST_REQUIRE(!cache.lookup(m, local_id));
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().misses, 1);
+
+        // Writes which don't carry the local shard leave the cache alone...
+        mutation other(s, pk);
+        other.set_clustered_cell(ck, col, counter_cell_builder::from_single_shard(api::new_timestamp(),
+                counter_shard(counter_id::create_random_id(), 3, 1)));
+        cache.on_write(freeze(other), s, local_id);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().invalidations, 0);
+
+        // ...but deletions invalidate the partition.
+        mutation del(s, pk);
+        del.partition().apply(tombstone(api::new_timestamp(), gc_clock::now()));
+        auto generation = cache.generation();
+        cache.on_write(freeze(del), s, local_id);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().invalidations, 1);
+        BOOST_REQUIRE_EQUAL(tracker.memory_used(), 0);
+        BOOST_REQUIRE(!cache.lookup(make_update(1, 1), local_id));
+        BOOST_REQUIRE_NE(generation, cache.generation());
+
+        // Shards computed before an invalidation are not stored.
+        auto stale = make_update(1, 1);
+        transform_counter_updates_to_shards(stale, &state, 0, host_id);
+        cache.update(stale, local_id, generation);
+        BOOST_REQUIRE_EQUAL(tracker.memory_used(), 0);
+
+        // The least recently updated partitions are evicted to fit the budget.
+        counter_cache_tracker small_tracker(1);
+        counter_cache small_cache(s, small_tracker);
+        small_cache.update(stale, local_id, small_cache.generation());
+        BOOST_REQUIRE_EQUAL(small_tracker.get_stats().evictions, 1);
+        BOOST_REQUIRE_EQUAL(small_tracker.memory_used(), 0);
+    });
+}
+
 SEASTAR_TEST_CASE(test_sanitize_corrupted_cells) {
     return seastar::async([] {
         auto& gen = seastar::testing::local_random_engine;
@@ -80,6 +80,25 @@ SEASTAR_TEST_CASE(test_like_operator_on_clustering_key) {
     });
 }
 
+SEASTAR_TEST_CASE(test_like_operator_prefix_on_clustering_key) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        for (auto order : {"asc", "desc"}) {
+            cquery_nofail(e, format("create table t_{} (p int, s text, primary key(p, s)) with clustering order by (s {})", order, order));
+            for (auto s : {"a", "aa", "ab", "ab%", "abc", "abz", "ac", "b"}) {
+                cquery_nofail(e, format("insert into t_{} (p, s) values (1, '{}')", order, s));
+            }
+            require_rows(e, format("select s from t_{} where p = 1 and s like 'ab%' allow filtering", order),
+                         {{T("ab")}, {T("ab%")}, {T("abc")}, {T("abz")}});
+            require_rows(e, format("select s from t_{} where p = 1 and s like 'ab_' allow filtering", order),
+                         {{T("ab%")}, {T("abc")}, {T("abz")}});
+            require_rows(e, format("select s from t_{} where p = 1 and s like 'ab\\%%' allow filtering", order), {{T("ab%")}});
+            require_rows(e, format("select s from t_{} where p = 1 and s like 'a%c' allow filtering", order), {{T("abc")}, {T("ac")}});
+            require_rows(e, format("select s from t_{} where p = 1 and s like 'ab%' and s < 'abd' allow filtering", order),
+                         {{T("ab")}, {T("ab%")}, {T("abc")}});
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_like_operator_conjunction) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         cquery_nofail(e, "create table t (s1 text primary key, s2 text)");
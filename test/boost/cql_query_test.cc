@@ -420,6 +420,30 @@ SEASTAR_TEST_CASE(test_in_clause_validation) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_in_clause_many_partitions) {
+    do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE tbl (pk int, ck int, v int, PRIMARY KEY (pk, ck))").get();
+        std::vector<std::vector<bytes_opt>> expected;
+        for (int pk = 0; pk < 20; ++pk) {
+            for (int ck = 0; ck < 3; ++ck) {
+                e.execute_cql(format("INSERT INTO tbl (pk, ck, v) VALUES ({}, {}, {})", pk, ck, pk * ck)).get();
+                if (pk % 2 == 0) {
+                    expected.push_back({int32_type->decompose(pk), int32_type->decompose(ck), int32_type->decompose(pk * ck)});
+                }
+            }
+        }
+
+        // Even keys exist, 100, 101 don't
+        auto in = "0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 100, 101";
+        assert_that(e.execute_cql(format("SELECT pk, ck, v FROM tbl WHERE pk IN ({})", in)).get())
+                .is_rows().with_rows_ignore_order(expected);
+        assert_that(e.execute_cql(format("SELECT pk, ck, v FROM tbl WHERE pk IN ({}) LIMIT 7", in)).get())
+                .is_rows().with_size(7);
+        assert_that(e.execute_cql(format("SELECT pk, ck, v FROM tbl WHERE pk IN ({}) PER PARTITION LIMIT 1", in)).get())
+                .is_rows().with_size(10);
+    }).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_in_clause_cartesian_product_limits) {
     do_with_cql_env_thread([] (cql_test_env& e) {
         e.execute_cql("CREATE TABLE tab1 (pk1 int, pk2 int, PRIMARY KEY ((pk1, pk2)))").get();
@@ -4911,6 +4935,49 @@ SEASTAR_THREAD_TEST_CASE(test_query_limit) {
     }, std::move(cfg)).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_adaptive_paging) {
+    auto db_cfg_ptr = make_shared<db::config>();
+    db_cfg_ptr->enable_adaptive_paging({true}, db::config::config_source::CommandLine);
+    // Smaller than a single row, so pages shrink to the minimum.
+    db_cfg_ptr->adaptive_paging_target_page_size_in_kb({1}, db::config::config_source::CommandLine);
+
+    do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE test (pk int, ck int, v text, PRIMARY KEY (pk, ck));").get();
+        auto id = e.prepare("INSERT INTO test (pk, ck, v) VALUES (0, ?, ?);").get0();
+
+        const auto value = cql3::raw_value::make_value(utf8_type->decompose(data_value(sstring(1024, 'a'))));
+        const int num_rows = 2000;
+        for (int i = 0; i != num_rows; ++i) {
+            e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(i)), value}).get();
+        }
+
+        const int32_t page_size = 1000;
+        bool has_more_pages = true;
+        lw_shared_ptr<service::pager::paging_state> paging_state = nullptr;
+        size_t rows_fetched = 0;
+        size_t pages = 0;
+        while (has_more_pages) {
+            auto qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                    cql3::query_options::specific_options{page_size, paging_state, {}, api::new_timestamp()});
+            auto result = e.execute_cql("SELECT * FROM test WHERE pk = 0", std::move(qo)).get0();
+            auto page_rows = count_rows_fetched(result);
+            if (pages) {
+                // The feedback of the previous pages is known.
+                BOOST_REQUIRE_GE(paging_state->get_average_row_size(), 1024);
+                BOOST_REQUIRE_GT(paging_state->get_average_row_latency_ns(), 0);
+                BOOST_REQUIRE_LE(page_rows, 100);
+            }
+            has_more_pages = ::has_more_pages(result);
+            paging_state = extract_paging_state(result);
+            rows_fetched += page_rows;
+            ++pages;
+        }
+        BOOST_REQUIRE_EQUAL(rows_fetched, num_rows);
+        // The first page isn't adapted, the following ones are.
+        BOOST_REQUIRE_GE(pages, 11);
+    }, db_cfg_ptr).get();
+}
+
 // reproduces https://github.com/scylladb/scylla/issues/3552
 // when clustering-key filtering is enabled in filter_sstable_for_reader
 static future<> test_clustering_filtering_with_compaction_strategy(const std::string_view& cs) {
@@ -4992,6 +5059,45 @@ SEASTAR_TEST_CASE(test_clustering_filtering_3) {
             test_clustering_filtering_3_with_compaction_strategy);
 }
 
+SEASTAR_TEST_CASE(test_clustering_filtering_range_scan) {
+    auto db_config = make_shared<db::config>();
+    db_config->sstable_format("me");
+
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE cf(pk text, ck int, v text, PRIMARY KEY(pk, ck)) WITH COMPACTION = {'class': 'TimeWindowCompactionStrategy'}");
+        e.db().invoke_on_all([] (replica::database& db) {
+            auto& table = db.find_column_family("ks", "cf");
+            return table.disable_auto_compaction();
+        }).get();
+        cquery_nofail(e, "INSERT INTO  cf(pk, ck, v) VALUES ('a', 1, 'a1')");
+        e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+        cquery_nofail(e, "INSERT INTO  cf(pk, ck, v) VALUES ('b', 100, 'b100')");
+        cquery_nofail(e, "INSERT INTO  cf(pk, ck, v) VALUES ('a', 101, 'a101')");
+        e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+
+        auto get_stats = [&e] {
+            return e.db().map_reduce0([] (replica::database& db) {
+                auto& stats = *db.cf_stats();
+                return std::make_pair(stats.range_scan_sstables_checked_by_clustering_filter, stats.range_scan_surviving_sstables_after_clustering_filter);
+            }, std::make_pair(int64_t(0), int64_t(0)), [] (auto a, auto b) {
+                return std::make_pair(a.first + b.first, a.second + b.second);
+            }).get();
+        };
+
+        auto before = get_stats();
+        require_rows(e, "SELECT v FROM cf WHERE ck >= 50 ALLOW FILTERING BYPASS CACHE", {{T("a101")}, {T("b100")}});
+        auto after = get_stats();
+        auto checked = after.first - before.first;
+        auto surviving = after.second - before.second;
+        // The sstable with only 'a1' doesn't overlap the queried range
+        BOOST_REQUIRE_GT(checked, 0);
+        BOOST_REQUIRE_EQUAL(checked - surviving, 1);
+
+        require_rows(e, "SELECT v FROM cf BYPASS CACHE", {{T("a1")}, {T("a101")}, {T("b100")}});
+        BOOST_REQUIRE(get_stats() == after);
+    }, cql_test_config(db_config));
+}
+
 SEASTAR_TEST_CASE(test_counter_column_added_into_non_counter_table) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         cquery_nofail(e, "CREATE TABLE t (pk int, ck int, PRIMARY KEY(pk, ck))");
@@ -5332,8 +5438,34 @@ SEASTAR_TEST_CASE(test_parallelized_select_sum_group_by) {
             {int32_type->decompose(int32_t(1)), int32_type->decompose(int32_t((value_count - 1) * value_count / 2))},
             {int32_type->decompose(int32_t(0)), int32_type->decompose(int32_t((value_count - 1) * value_count / 2))}
         });
+        BOOST_CHECK_EQUAL(stat_parallelized + 1, qp.get_cql_stats().select_parallelized);
 
-        BOOST_CHECK_EQUAL(stat_parallelized, qp.get_cql_stats().select_parallelized);
+        // The GROUP BY column isn't selected.
+        msg = e.execute_cql("SELECT COUNT(*) FROM tbl GROUP BY k;").get();
+        assert_that(msg).is_rows().with_rows({
+            {long_type->decompose(int64_t(value_count))},
+            {long_type->decompose(int64_t(value_count))}
+        });
+        BOOST_CHECK_EQUAL(stat_parallelized + 2, qp.get_cql_stats().select_parallelized);
+
+        // Groups within partitions keep their clustering order, and LIMIT
+        // applies to groups.
+        msg = e.execute_cql("SELECT k, c, SUM(v) FROM tbl GROUP BY k, c LIMIT 12;").get();
+        std::vector<std::vector<bytes_opt>> expected;
+        for (int k : {1, 0}) {
+            for (int c = 0; c < value_count && expected.size() < 12; c++) {
+                expected.push_back({int32_type->decompose(k), int32_type->decompose(c), int32_type->decompose(c)});
+            }
+        }
+        assert_that(msg).is_rows().with_rows(expected);
+        BOOST_CHECK_EQUAL(stat_parallelized + 3, qp.get_cql_stats().select_parallelized);
+
+        // Reversed queries aren't parallelized.
+        msg = e.execute_cql("SELECT k, SUM(v) FROM tbl WHERE k = 0 GROUP BY k ORDER BY c DESC;").get();
+        assert_that(msg).is_rows().with_rows({
+            {int32_type->decompose(int32_t(0)), int32_type->decompose(int32_t((value_count - 1) * value_count / 2))}
+        });
+        BOOST_CHECK_EQUAL(stat_parallelized + 3, qp.get_cql_stats().select_parallelized);
     });
 }
 
@@ -5713,3 +5845,62 @@ SEASTAR_TEST_CASE(test_setting_synchronous_updates_property) {
         );
     });
 }
+
+SEASTAR_TEST_CASE(test_query_results_cache_sees_local_writes) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        // The results of the prepared reads of a table with a results TTL
+        // are cached, but the writes coordinated by the same shard must be
+        // seen immediately.
+        e.execute_cql("create table t (k int primary key, v int) with caching = {'results_ttl_in_ms': '3600000'}").get();
+        e.execute_cql("insert into t (k, v) values (1, 2)").get();
+        auto id = e.prepare("select v from t where k = ?").get0();
+        auto k = cql3::raw_value::make_value(int32_type->decompose(1));
+        for (int i = 0; i < 2; ++i) {
+            assert_that(e.execute_prepared(id, {k}).get0()).is_rows().with_rows({
+                {int32_type->decompose(2)},
+            });
+        }
+
+        e.execute_cql("update t set v = 3 where k = 1").get();
+        assert_that(e.execute_prepared(id, {k}).get0()).is_rows().with_rows({
+            {int32_type->decompose(3)},
+        });
+
+        // Other bound values aren't served the cached results
+        assert_that(e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(2))}).get0()).is_rows().is_empty();
+
+        e.execute_cql("alter table t add w int").get();
+        e.execute_cql("update t set w = 4 where k = 1").get();
+        assert_that(e.execute_cql("select * from t").get0()).is_rows().with_rows({
+            {int32_type->decompose(1), int32_type->decompose(3), int32_type->decompose(4)},
+        });
+    });
+}
+
+SEASTAR_TEST_CASE(test_unprepared_statements_see_schema_changes) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        // Unprepared statements are cached, but must still see every schema
+        // change, like statements prepared again would.
+        e.execute_cql("create table t (k int primary key, v int)").get();
+        e.execute_cql("insert into t (k, v) values (1, 2)").get();
+        for (int i = 0; i < 2; ++i) {
+            assert_that(e.execute_cql("select * from t").get0()).is_rows().with_rows({
+                {int32_type->decompose(1), int32_type->decompose(2)},
+            });
+        }
+
+        e.execute_cql("alter table t add w int").get();
+        e.execute_cql("insert into t (k, v, w) values (1, 2, 3)").get();
+        assert_that(e.execute_cql("select * from t").get0()).is_rows().with_rows({
+            {int32_type->decompose(1), int32_type->decompose(2), int32_type->decompose(3)},
+        });
+
+        e.execute_cql("drop table t").get();
+        BOOST_REQUIRE_THROW(e.execute_cql("select * from t").get(), exceptions::invalid_request_exception);
+        e.execute_cql("create table t (k int primary key, v text)").get();
+        e.execute_cql("insert into t (k, v) values (1, 'a')").get();
+        assert_that(e.execute_cql("select * from t").get0()).is_rows().with_rows({
+            {int32_type->decompose(1), utf8_type->decompose("a")},
+        });
+    });
+}
@@ -642,3 +642,34 @@ SEASTAR_THREAD_TEST_CASE(test_size_tracked_region_move_assign) {
     r1 = std::move(r0);
     r1.allocator().free(std::exchange(p, nullptr));
 }
+
+BOOST_AUTO_TEST_CASE(test_flush_predictor) {
+    using namespace std::chrono_literals;
+    constexpr size_t MB = 1 << 20;
+    constexpr size_t limit = 100 * MB;
+
+    flush_predictor p;
+    // Nothing is predicted before a flush was observed
+    p.update(80 * MB, 0, 1s);
+    BOOST_REQUIRE(!p.predicts_pressure(80 * MB, limit, 40 * MB));
+
+    // Writes at 10MB/s, flushes at 20MB/s
+    for (uint64_t i = 1; i <= 100; ++i) {
+        p.update(80 * MB + i * 10 * MB, i * 20 * MB, 1s);
+    }
+    BOOST_REQUIRE_CLOSE(p.write_rate(), double(10 * MB), 0.01);
+    BOOST_REQUIRE_CLOSE(p.flush_rate(), double(20 * MB), 0.01);
+
+    // A 40MB flush takes 2s, during which 20MB more are written
+    BOOST_REQUIRE(p.predicts_pressure(85 * MB, limit, 40 * MB));
+    BOOST_REQUIRE(!p.predicts_pressure(75 * MB, limit, 40 * MB));
+    // Too far from the limit to bother
+    BOOST_REQUIRE(!p.predicts_pressure(limit / 2 - 1, limit, 4000 * MB));
+    // The lookahead is capped, a 4000MB flush would take 200s
+    BOOST_REQUIRE(!p.predicts_pressure(600 * MB, 1000 * MB, 4000 * MB));
+    BOOST_REQUIRE(p.predicts_pressure(900 * MB, 1000 * MB, 4000 * MB));
+
+    // Idle periods don't make flushes look slower
+    p.update(80 * MB + 1000 * MB, 100 * 20 * MB, 1s);
+    BOOST_REQUIRE_CLOSE(p.flush_rate(), double(20 * MB), 0.01);
+}
@@ -109,3 +109,44 @@ BOOST_AUTO_TEST_CASE(test_estimated_statistics) {
     hist *= 0.5;
     BOOST_CHECK_EQUAL(hist.get(1), 1);
 }
+
+BOOST_AUTO_TEST_CASE(test_estimated_percentile) {
+    utils::approx_exponential_histogram<128, 1024, 4> hist;
+    BOOST_CHECK_EQUAL(hist.percentile(0.5), 0);
+    for (int i = 0; i < 98; i++) {
+        hist.add(130);
+    }
+    hist.add(300);
+    hist.add(2000);
+    BOOST_CHECK_EQUAL(hist.percentile(0), 160);
+    BOOST_CHECK_EQUAL(hist.percentile(0.5), 160);
+    BOOST_CHECK_EQUAL(hist.percentile(0.98), 160);
+    BOOST_CHECK_EQUAL(hist.percentile(0.99), 320);
+    BOOST_CHECK_EQUAL(hist.percentile(1), 1024);
+}
+
+BOOST_AUTO_TEST_CASE(test_precise_time_estimated_histogram) {
+    utils::precise_time_estimated_histogram hist;
+    BOOST_CHECK_EQUAL(hist.NUM_BUCKETS, 19 * 8 + 1);
+    BOOST_CHECK_EQUAL(hist.get_bucket_lower_limit(0), 64);
+    BOOST_CHECK_EQUAL(hist.get_bucket_lower_limit(1), 72);
+    BOOST_CHECK_EQUAL(hist.get_bucket_lower_limit(8), 128);
+    BOOST_CHECK_EQUAL(hist.get_bucket_lower_limit(hist.NUM_BUCKETS - 1), 33554432);
+
+    // Every bucket is at most 12.5% wide
+    for (size_t i = 0; i < hist.NUM_BUCKETS - 1; i++) {
+        BOOST_CHECK_LE(hist.get_bucket_lower_limit(i + 1) - hist.get_bucket_lower_limit(i), hist.get_bucket_lower_limit(i) / 8);
+    }
+
+    hist.add(std::chrono::microseconds(1000));
+    hist.add(std::chrono::microseconds(1100));
+    BOOST_CHECK_EQUAL(hist.count(), 2);
+    BOOST_CHECK_EQUAL(hist.min(), 960);
+    BOOST_CHECK_EQUAL(hist.max(), 1152);
+
+    utils::precise_time_estimated_histogram other;
+    other.add(std::chrono::seconds(1));
+    hist.merge(other);
+    BOOST_CHECK_EQUAL(hist.count(), 3);
+    BOOST_CHECK_EQUAL(to_metrics_histogram(hist).sample_count, 3);
+}
@@ -18,6 +18,8 @@
 #include "test/lib/expr_test_utils.hh"
 #include "cql3/expr/evaluate.hh"
 #include "cql3/expr/expr-utils.hh"
+#include "cql3/expr/compiled_predicate.hh"
+#include "cql3/selection/selection.hh"
 #include "cql3/functions/aggregate_fcts.hh"
 
 using namespace cql3;
@@ -4632,3 +4634,50 @@ BOOST_AUTO_TEST_CASE(test_levellize_aggregation_depth) {
     // Somewhat fragile, but easiest way to test entire structure
     BOOST_REQUIRE_EQUAL(fmt::format("{:debug}", e), "foo.my_agg(system.sum(system.$$first$$(r)), system.$$first$$(system.$$first$$(r)))");
 }
+
+// compiled_predicate must agree with is_satisfied_by() on the restrictions it
+// compiles, and refuse the ones it doesn't support.
+BOOST_AUTO_TEST_CASE(compiled_predicate_matches_is_satisfied_by) {
+    schema_ptr s = make_simple_test_schema();
+    auto pk = column_value(&s->partition_key_columns().front());
+    auto ck = column_value(&s->clustering_key_columns().front());
+    auto r = column_value(&s->regular_column_at(0));
+    auto st = column_value(&s->static_column_at(0));
+
+    std::vector<expression> restrictions;
+    for (auto op : {oper_t::EQ, oper_t::NEQ, oper_t::LT, oper_t::LTE, oper_t::GT, oper_t::GTE}) {
+        for (auto& col : {pk, ck, r, st}) {
+            restrictions.push_back(binary_operator(col, op, make_int_const(2)));
+        }
+        restrictions.push_back(binary_operator(r, op, make_bind_variable(0, int32_type)));
+    }
+    restrictions.push_back(conjunction{.children = {
+        binary_operator(ck, oper_t::GT, make_int_const(1)),
+        binary_operator(r, oper_t::LTE, make_bind_variable(0, int32_type)),
+    }});
+    // Comparisons with null are never satisfied.
+    restrictions.push_back(binary_operator(r, oper_t::EQ, make_bind_variable(1, int32_type)));
+
+    auto null = cql3::raw_value::make_null();
+    for (auto& restriction : restrictions) {
+        for (int32_t v : {1, 2, 3}) {
+            for (bool null_r : {false, true}) {
+                auto [inputs, inputs_data] = make_evaluation_inputs(s, {
+                    {"pk", make_int_raw(v)},
+                    {"ck", make_int_raw(4 - v)},
+                    {"r", null_r ? null : make_int_raw(v)},
+                    {"s", make_int_raw(v)},
+                }, {make_int_raw(2), null});
+                auto compiled = compiled_predicate::compile(restriction, *inputs.selection, *inputs.options);
+                BOOST_REQUIRE(compiled);
+                BOOST_REQUIRE_EQUAL(compiled->is_satisfied_by(inputs), is_satisfied_by(restriction, inputs));
+            }
+        }
+    }
+
+    auto [inputs, inputs_data] = make_evaluation_inputs(s, {{"pk", make_int_raw(1)}});
+    auto unsupported = binary_operator(r, oper_t::IN, make_int_list_const({1, 2}));
+    BOOST_REQUIRE(!compiled_predicate::compile(unsupported, *inputs.selection, *inputs.options));
+    auto not_column = binary_operator(make_int_const(1), oper_t::EQ, r);
+    BOOST_REQUIRE(!compiled_predicate::compile(not_column, *inputs.selection, *inputs.options));
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include "utils/frequency_sketch.hh"
+
+
+static uint64_t key_hash(uint64_t k) {
+    // splitmix64, the sketch expects well mixed hashes.
+    k += 0x9e3779b97f4a7c15ull;
+    k = (k ^ (k >> 30)) * 0xbf58476d1ce4e5b9ull;
+    k = (k ^ (k >> 27)) * 0x94d049bb133111ebull;
+    return k ^ (k >> 31);
+}
+
+BOOST_AUTO_TEST_CASE(test_estimate_never_undercounts) {
+    utils::frequency_sketch sketch(1024);
+    for (uint64_t k = 0; k < 100; ++k) {
+        for (uint64_t i = 0; i < k % 10; ++i) {
+            sketch.increment(key_hash(k));
+        }
+    }
+    for (uint64_t k = 0; k < 100; ++k) {
+        BOOST_REQUIRE_GE(sketch.estimate(key_hash(k)), k % 10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_saturation) {
+    utils::frequency_sketch sketch(1024);
+    for (int i = 0; i < 100; ++i) {
+        sketch.increment(key_hash(1));
+    }
+    BOOST_REQUIRE_EQUAL(sketch.estimate(key_hash(1)), utils::frequency_sketch::max_count);
+}
+
+BOOST_AUTO_TEST_CASE(test_unseen_keys_are_mostly_zero) {
+    utils::frequency_sketch sketch(4096);
+    for (uint64_t k = 0; k < 4096; ++k) {
+        sketch.increment(key_hash(k));
+    }
+    unsigned false_positives = 0;
+    for (uint64_t k = 1'000'000; k < 1'010'000; ++k) {
+        false_positives += sketch.estimate(key_hash(k)) != 0;
+    }
+    BOOST_REQUIRE_LT(false_positives, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(test_aging) {
+    utils::frequency_sketch sketch(64);
+    for (int i = 0; i < 9; ++i) {
+        sketch.increment(key_hash(1));
+    }
+    BOOST_REQUIRE_EQUAL(sketch.estimate(key_hash(1)), 9);
+    sketch.age();
+    BOOST_REQUIRE_EQUAL(sketch.estimate(key_hash(1)), 4);
+}
+
+BOOST_AUTO_TEST_CASE(test_automatic_aging) {
+    utils::frequency_sketch sketch(1024);
+    // Each key is seen once per round, estimates must not grow without bound.
+    for (int round = 0; round < 100; ++round) {
+        for (uint64_t k = 0; k < 1024; ++k) {
+            sketch.increment(key_hash(k));
+        }
+    }
+    unsigned saturated = 0;
+    for (uint64_t k = 0; k < 1024; ++k) {
+        saturated += sketch.estimate(key_hash(k)) == utils::frequency_sketch::max_count;
+    }
+    BOOST_REQUIRE_LT(saturated, 1024);
+}
+
+BOOST_AUTO_TEST_CASE(test_clear) {
+    utils::frequency_sketch sketch(64);
+    sketch.increment(key_hash(7));
+    sketch.clear();
+    BOOST_REQUIRE_EQUAL(sketch.estimate(key_hash(7)), 0);
+}
@@ -10,6 +10,7 @@
 #include "test/lib/scylla_test_case.hh"
 #include <seastar/core/smp.hh>
 
+#include "db/hints/resource_manager.hh"
 #include "db/hints/sync_point.hh"
 
 SEASTAR_TEST_CASE(test_hint_sync_point_faithful_reserialization) {
@@ -65,3 +66,32 @@ SEASTAR_TEST_CASE(test_hint_sync_point_faithful_reserialization) {
 
     return make_ready_future<>();
 }
+
+SEASTAR_TEST_CASE(test_hint_replay_rate_limiter) {
+    using namespace std::chrono_literals;
+    using clock = db::hints::replay_rate_limiter::clock;
+    const auto now = clock::now();
+
+    // No limit and no backlog, no delay.
+    db::hints::replay_rate_limiter unlimited;
+    for (int i = 0; i < 10; ++i) {
+        BOOST_REQUIRE(unlimited.delay_for(1 << 20, 0, 0, now) == clock::duration::zero());
+    }
+
+    // 1MB/s: 1MB goes right away, the next one a second later...
+    db::hints::replay_rate_limiter limiter;
+    const uint64_t rate = 1 << 20;
+    BOOST_REQUIRE(limiter.delay_for(1 << 20, rate, 0, now) == clock::duration::zero());
+    BOOST_REQUIRE(limiter.delay_for(1 << 19, rate, 0, now) == std::chrono::duration_cast<clock::duration>(1s));
+    BOOST_REQUIRE(limiter.delay_for(1 << 19, rate, 0, now + 1s) == std::chrono::duration_cast<clock::duration>(500ms));
+    // ...but time not spent sending isn't saved up.
+    BOOST_REQUIRE(limiter.delay_for(1 << 20, rate, 0, now + 10s) == clock::duration::zero());
+    BOOST_REQUIRE(limiter.delay_for(1, rate, 0, now + 10s) == std::chrono::duration_cast<clock::duration>(1s));
+
+    // The backlog adds to the delay, cubically.
+    BOOST_REQUIRE(unlimited.delay_for(1, 0, 1, now) == std::chrono::duration_cast<clock::duration>(db::hints::replay_rate_limiter::max_backlog_delay));
+    BOOST_REQUIRE(unlimited.delay_for(1, 0, 0.5, now) == std::chrono::duration_cast<clock::duration>(db::hints::replay_rate_limiter::max_backlog_delay / 8));
+    BOOST_REQUIRE(unlimited.delay_for(1, 0, 2, now) == std::chrono::duration_cast<clock::duration>(db::hints::replay_rate_limiter::max_backlog_delay));
+
+    return make_ready_future<>();
+}
@@ -443,3 +443,15 @@ BOOST_AUTO_TEST_CASE(test_reset) {
     BOOST_TEST(matches(m, u8"alpha"));
     BOOST_TEST(!matches(m, u8"omega"));
 }
+
+BOOST_AUTO_TEST_CASE(test_literal_prefix) {
+    auto prefix = [] (const char* pattern) { return like_matcher::literal_prefix(bytes(pattern)); };
+    BOOST_TEST(prefix("") == bytes(""));
+    BOOST_TEST(prefix("abc") == bytes("abc"));
+    BOOST_TEST(prefix("abc%") == bytes("abc"));
+    BOOST_TEST(prefix("ab_c%") == bytes("ab"));
+    BOOST_TEST(prefix("%abc") == bytes(""));
+    BOOST_TEST(prefix("_abc") == bytes(""));
+    BOOST_TEST(prefix("a\\%b%") == bytes("a%b"));
+    BOOST_TEST(prefix("a\\") == bytes("a\\"));
+}
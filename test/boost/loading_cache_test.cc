@@ -547,6 +547,39 @@ SEASTAR_TEST_CASE(test_loading_cache_eviction_unprivileged_minimum_size) {
     });
 }
 
+SEASTAR_TEST_CASE(test_loading_cache_frequency_based_eviction) {
+    return seastar::async([] {
+        // Entries used once, flooding the cache, must not evict the
+        // frequently used ones.
+        using namespace std::chrono;
+        utils::loading_cache<int, sstring, 1> loading_cache(20, 1h, testlog);
+        loading_cache.enable_frequency_based_eviction(20);
+        auto stop_cache_reload = seastar::defer([&loading_cache] { loading_cache.stop().get(); });
+
+        prepare().get();
+
+        auto use_hot_entries = [&] {
+            for (int i = 0; i < 10; i++) {
+                loading_cache.get_ptr(i, loader).discard_result().get();
+            }
+        };
+        for (int j = 0; j < 5; j++) {
+            use_hot_entries();
+        }
+        for (int i = 100; i < 1100; i++) {
+            loading_cache.get_ptr(i, loader).discard_result().get();
+            if (i % 10 == 0) {
+                use_hot_entries();
+            }
+        }
+
+        for (int i = 0; i < 10; i++) {
+            BOOST_REQUIRE(loading_cache.find(i) != nullptr);
+        }
+        BOOST_REQUIRE_LE(loading_cache.size(), 20);
+    });
+}
+
 struct sstring_length_entry_size {
     size_t operator()(const sstring& val) {
         return val.size();
@@ -293,4 +293,25 @@ SEASTAR_THREAD_TEST_CASE(test_load_sketch) {
             BOOST_REQUIRE_EQUAL(node3_shards[i], node3_shards[0]);
         }
     }
+
+    // Check that tablets are balanced by their load, when known
+    {
+        auto tm = stm.get();
+        load_sketch load(tm);
+        // The tablets on shard 2 are much hotter than the one on shard 1.
+        load.populate(std::nullopt, [&] (table_id, tablet_id tid) -> load_sketch::load_type {
+            return tid == tablet_id(3) ? 10 : 100;
+        }).get();
+        BOOST_REQUIRE_EQUAL(load.get_load(host3), 310);
+
+        std::vector<unsigned> shards(node3_shard_count, 0);
+        for (int i = 0; i < 5; ++i) {
+            shards[load.next_shard(host3, 100)] += 1;
+        }
+        // Shard loads go from {0, 10, 300} to {300, 210, 300}.
+        BOOST_REQUIRE_EQUAL(shards[0], 3);
+        BOOST_REQUIRE_EQUAL(shards[1], 2);
+        BOOST_REQUIRE_EQUAL(shards[2], 0);
+        BOOST_REQUIRE_EQUAL(load.get_load(host3), 810);
+    }
 }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include "transport/lz4_stream.hh"
+
+using namespace cql_transport;
+
+// Frames which repeat each other, as CQL requests and responses of a
+// connection tend to.
+static bytes make_frame(std::mt19937& rng, size_t size) {
+    static const std::string_view words[] = {"SELECT ", "* FROM ", "ks.cf ", "WHERE ", "pk = ? ", "LIMIT 10 "};
+    bytes b(bytes::initialized_later(), size);
+    size_t i = 0;
+    while (i < size) {
+        auto w = words[rng() % std::size(words)];
+        for (auto c : w) {
+            if (i == size) {
+                break;
+            }
+            b[i++] = int8_t(c);
+        }
+        if (i < size && rng() % 4 == 0) {
+            b[i++] = int8_t(rng());
+        }
+    }
+    return b;
+}
+
+static void check_round_trip(const std::vector<size_t>& sizes) {
+    std::mt19937 rng(1);
+    lz4_stream_compressor c;
+    lz4_stream_decompressor d;
+    for (auto size : sizes) {
+        auto in = make_frame(rng, size);
+        bytes compressed(bytes::initialized_later(), LZ4_COMPRESSBOUND(size));
+        auto len = c.compress(in, compressed);
+        bytes out(bytes::initialized_later(), size);
+        d.decompress(bytes_view(compressed.data(), len), out);
+        BOOST_REQUIRE(in == out);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_small_frames) {
+    std::vector<size_t> sizes;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 2000; ++i) {
+        sizes.push_back(1 + rng() % 2000);
+    }
+    check_round_trip(sizes);
+}
+
+BOOST_AUTO_TEST_CASE(test_mixed_frames) {
+    // Frames around the ring limits, and larger ones processed in place.
+    std::vector<size_t> sizes;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 300; ++i) {
+        switch (rng() % 4) {
+        case 0: sizes.push_back(1 + rng() % 100); break;
+        case 1: sizes.push_back(lz4_stream_history::max_ring_frame_size - 1 + rng() % 3); break;
+        case 2: sizes.push_back(lz4_stream_history::window_size + rng() % lz4_stream_history::window_size); break;
+        case 3: sizes.push_back(lz4_stream_history::ring_size + rng() % lz4_stream_history::ring_size); break;
+        }
+    }
+    check_round_trip(sizes);
+}
+
+BOOST_AUTO_TEST_CASE(test_history_improves_ratio) {
+    std::mt19937 rng(4);
+    auto frame = make_frame(rng, 200);
+    lz4_stream_compressor c;
+    bytes compressed(bytes::initialized_later(), LZ4_COMPRESSBOUND(frame.size()));
+    auto first = c.compress(frame, compressed);
+    auto second = c.compress(frame, compressed);
+    BOOST_REQUIRE_LT(second, first);
+}
+
+BOOST_AUTO_TEST_CASE(test_corrupted_frame) {
+    std::mt19937 rng(5);
+    auto in = make_frame(rng, 1000);
+    lz4_stream_compressor c;
+    bytes compressed(bytes::initialized_later(), LZ4_COMPRESSBOUND(in.size()));
+    auto len = c.compress(in, compressed);
+    lz4_stream_decompressor d;
+    bytes out(bytes::initialized_later(), in.size() + 1);
+    BOOST_REQUIRE_THROW(d.decompress(bytes_view(compressed.data(), len), out), std::runtime_error);
+}
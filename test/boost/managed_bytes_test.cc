@@ -249,6 +249,28 @@ BOOST_AUTO_TEST_CASE(test_inequality) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_compare_unsigned) {
+    fragmenting_allocation_strategy fragmenting_allocator(alloc_size);
+    with_allocator(fragmenting_allocator, [&] {
+        for (size_t size_1 : sizes) {
+            for (size_t size_2 : sizes) {
+                auto b1 = tests::random::get_bytes(size_1);
+                auto b2 = tests::random::get_bytes(size_2);
+                // Also compare values sharing a prefix
+                auto b3 = bytes(b1.begin(), b1.begin() + std::min(size_1, size_2));
+                b3.append(b2.begin() + b3.size(), size_2 - b3.size());
+                auto m1 = managed_bytes(b1);
+                auto m2 = managed_bytes(b2);
+                auto m3 = managed_bytes(b3);
+                BOOST_CHECK(compare_unsigned(mbv(m1), mbv(m2)) == compare_unsigned(bytes_view(b1), bytes_view(b2)));
+                BOOST_CHECK(compare_unsigned(mbv(m1), mbv(m3)) == compare_unsigned(bytes_view(b1), bytes_view(b3)));
+                BOOST_CHECK(compare_unsigned(mbv(m3), mbv(m1)) == compare_unsigned(bytes_view(b3), bytes_view(b1)));
+                BOOST_CHECK(compare_unsigned(mbv(m1), single_fragmented_view(b3)) == compare_unsigned(bytes_view(b1), bytes_view(b3)));
+            }
+        }
+    });
+}
+
 BOOST_AUTO_TEST_CASE(test_prefix) {
     fragmenting_allocation_strategy fragmenting_allocator(alloc_size);
     with_allocator(fragmenting_allocator, [&] {
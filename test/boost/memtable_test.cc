@@ -136,9 +136,8 @@ SEASTAR_TEST_CASE(test_memtable_with_many_versions_conforms_to_mutation_source_r
 }
 
 SEASTAR_TEST_CASE(test_memtable_flush_reader) {
-    // Memtable flush reader is severly limited, it always assumes that
-    // the full partition range is being read and that
-    // streamed_mutation::forwarding is set to no. Therefore, we cannot use
+    // Memtable flush reader is severly limited, it can't be fast-forwarded
+    // and it assumes that streamed_mutation::forwarding is set to no. Therefore, we cannot use
     // run_mutation_source_tests() to test it.
     return seastar::async([] {
         tests::reader_concurrency_semaphore_wrapper semaphore;
@@ -198,6 +197,20 @@ SEASTAR_TEST_CASE(test_memtable_flush_reader) {
                     .produces_partition_start(muts[3].decorated_key(), muts[3].partition().partition_tombstone())
                     .next_partition()
                     .produces_end_of_stream();
+
+                testlog.info("Read split into two token ranges");
+                mt = make_memtable(mgr, tbl_stats, muts);
+                auto split = muts[1].decorated_key().token();
+                auto left = dht::to_partition_range(dht::token_range::make_ending_with({split, true}));
+                auto right = dht::to_partition_range(dht::token_range::make_starting_with({split, false}));
+                assert_that(mt->make_flush_reader(gen.schema(), semaphore.make_permit(), left))
+                    .produces_compacted(compacted_muts[0], now)
+                    .produces_compacted(compacted_muts[1], now)
+                    .produces_end_of_stream();
+                assert_that(mt->make_flush_reader(gen.schema(), semaphore.make_permit(), right))
+                    .produces_compacted(compacted_muts[2], now)
+                    .produces_compacted(compacted_muts[3], now)
+                    .produces_end_of_stream();
             }
         };
 
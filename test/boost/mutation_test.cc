@@ -1350,16 +1350,28 @@ SEASTAR_TEST_CASE(test_query_digest) {
     return seastar::async([] {
         auto now = gc_clock::now();
         auto check_digests_equal = [now] (const mutation& m1, const mutation& m2) {
-            auto ps1 = partition_slice_builder(*m1.schema()).build();
-            auto ps2 = partition_slice_builder(*m2.schema()).build();
-            auto digest1 = *query_mutation(mutation(m1), ps1, query::max_rows, now,
-                    query::result_options::only_digest(query::digest_algorithm::xxHash)).digest();
-            auto digest2 = *query_mutation( mutation(m2), ps2, query::max_rows, now,
-                    query::result_options::only_digest(query::digest_algorithm::xxHash)).digest();
-
-            if (digest1 != digest2) {
-                BOOST_FAIL(format("Digest should be the same for {} and {}", m1, m2));
+            for (auto algo : {query::digest_algorithm::xxHash, query::digest_algorithm::xxHash3}) {
+                auto ps1 = partition_slice_builder(*m1.schema()).build();
+                auto ps2 = partition_slice_builder(*m2.schema()).build();
+                auto digest1 = *query_mutation(mutation(m1), ps1, query::max_rows, now,
+                        query::result_options::only_digest(algo)).digest();
+                auto digest2 = *query_mutation( mutation(m2), ps2, query::max_rows, now,
+                        query::result_options::only_digest(algo)).digest();
+
+                if (digest1 != digest2) {
+                    BOOST_FAIL(format("Digest should be the same for {} and {}", m1, m2));
+                }
+            }
+        };
+        // As the row cache does for digest reads.
+        auto with_cell_hashes = [] (const mutation& m) {
+            auto result = m;
+            auto& s = *result.schema();
+            result.partition().static_row().prepare_hash(s, column_kind::static_column);
+            for (const rows_entry& e : result.partition().clustered_rows()) {
+                e.row().cells().prepare_hash(s, column_kind::regular_column);
             }
+            return result;
         };
 
         for_each_mutation_pair([&] (const mutation& m1, const mutation& m2, are_equal eq) {
@@ -1370,6 +1382,7 @@ SEASTAR_TEST_CASE(test_query_digest) {
             if (eq) {
                 check_digests_equal(compacted(m1, now), m2);
                 check_digests_equal(m1, compacted(m2, now));
+                check_digests_equal(with_cell_hashes(m1), m2);
             } else {
                 testlog.info("If not equal, they should become so after applying diffs mutually");
 
@@ -2144,6 +2157,72 @@ SEASTAR_TEST_CASE(test_v2_merging_in_non_evictable_snapshot) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_v2_apply_appended_rows) {
+    simple_schema table;
+    auto&& s = *table.schema();
+    mutation_application_stats app_stats;
+
+    auto expected = table.new_mutation("pk");
+    mutation_partition_v2 result(s);
+    auto apply = [&] (uint32_t ck, sstring v) {
+        auto m = table.new_mutation("pk");
+        table.add_row(m, table.make_ckey(ck), v);
+        expected.apply(m);
+        apply_resume res;
+        result.apply_monotonically(s, s, mutation_partition_v2(s, m.partition()), no_cache_tracker, app_stats,
+                never_preempt(), res, is_evictable::no);
+    };
+
+    // In clustering order, as time-series are written
+    for (uint32_t ck = 0; ck < 100; ck += 2) {
+        apply(ck, format("v{}", ck));
+    }
+    // The first row creates the partition, the following ones are appended
+    BOOST_REQUIRE_EQUAL(app_stats.rows_appended, 49);
+
+    // Out of order, and overwrites
+    apply(51, "v51");
+    apply(0, "v0'");
+    apply(98, "v98'");
+    apply(99, "v99");
+    BOOST_REQUIRE_EQUAL(app_stats.rows_appended, 50);
+    BOOST_REQUIRE_EQUAL(app_stats.row_hits, 2);
+
+    assert_that(table.schema(), result).is_equal_to_compacted(expected.partition());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_v2_partition_tombstone_drops_covered_range_tombstones) {
+    simple_schema table;
+    auto&& s = *table.schema();
+    mutation_application_stats app_stats;
+
+    auto expected = table.new_mutation("pk");
+    mutation_partition_v2 result(s);
+    auto apply = [&] (mutation m) {
+        expected.apply(m);
+        apply_resume res;
+        result.apply_monotonically(s, s, mutation_partition_v2(s, m.partition()), no_cache_tracker, app_stats,
+                never_preempt(), res, is_evictable::no);
+    };
+
+    // A queue: consumed prefixes deleted one after another
+    for (uint32_t ck = 0; ck < 10; ++ck) {
+        auto m = table.new_mutation("pk");
+        table.delete_range(m, query::clustering_range::make_ending_with({table.make_ckey(ck), true}));
+        table.add_row(m, table.make_ckey(ck + 1), "v");
+        apply(std::move(m));
+    }
+    auto m = table.new_mutation("pk");
+    m.partition().apply(table.new_tombstone());
+    table.add_row(m, table.make_ckey(20), "v");
+    apply(std::move(m));
+
+    for (auto&& e : result.clustered_rows()) {
+        BOOST_REQUIRE(!e.range_tombstone());
+    }
+    assert_that(table.schema(), result).is_equal_to_compacted(expected.partition());
+}
+
 static void clear(cache_tracker& tracker, const schema& s, mutation_partition_v2& p) {
     while (p.clear_gently(&tracker) == stop_iteration::no) {}
     p = mutation_partition_v2(s);
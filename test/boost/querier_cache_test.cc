@@ -186,6 +186,10 @@ class test_querier_cache {
         return _sem;
     }
 
+    const query::querier_cache::stats& get_cache_stats() const {
+        return _cache.get_stats();
+    }
+
     dht::partition_range make_partition_range(bound begin, bound end) const {
         return dht::partition_range::make({_mutations.at(begin.value()).decorated_key(), begin.is_inclusive()},
                 {_mutations.at(end.value()).decorated_key(), end.is_inclusive()});
@@ -478,7 +482,8 @@ SEASTAR_THREAD_TEST_CASE(lookup_with_original_range_drops) {
         .no_misses()
         .drops()
         .no_evictions();
-
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().drops_position_mismatch, 1);
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().drops_schema_mismatch, 0);
 }
 
 SEASTAR_THREAD_TEST_CASE(lookup_with_wrong_slice_drops) {
@@ -526,6 +531,8 @@ SEASTAR_THREAD_TEST_CASE(lookup_with_different_schema_version_drops) {
         .no_misses()
         .drops()
         .no_evictions();
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().drops_schema_mismatch, 1);
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().drops_position_mismatch, 0);
 }
 
 /*
@@ -554,6 +561,13 @@ SEASTAR_THREAD_TEST_CASE(test_time_based_cache_eviction) {
         .misses()
         .no_drops()
         .time_based_evictions();
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().misses_after_eviction, 2);
+
+    // A key that was never cached isn't accounted as evicted.
+    t.assert_cache_lookup_data_querier(90, *t.get_schema(), entry2.expected_range, entry2.expected_slice)
+        .misses()
+        .no_drops();
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().misses_after_eviction, 2);
 
     // There should be no inactive reads, the querier_cache should unregister
     // the expired queriers.
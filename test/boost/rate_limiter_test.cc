@@ -44,6 +44,26 @@ SEASTAR_TEST_CASE(test_rate_limiter_no_rejections_on_sequential) {
     }
 }
 
+SEASTAR_TEST_CASE(test_rate_limiter_entry_count) {
+    // Fewer operations than a lossy counting bucket, so that no entry expires
+    const uint64_t token_count = 4000;
+
+    auto count_tracked = [&] (size_t entry_count) -> future<uint64_t> {
+        test_rate_limiter::label lbl;
+        test_rate_limiter limiter(entry_count);
+        uint64_t tracked = 0;
+        for (uint64_t token = 0; token < token_count; token++) {
+            tracked += limiter.increase_and_get_counter(lbl, token);
+            co_await maybe_yield();
+        }
+        co_return tracked;
+    };
+
+    // Rounded up to 2048 entries
+    BOOST_REQUIRE_LE(co_await count_tracked(1), 2048);
+    BOOST_REQUIRE_EQUAL(co_await count_tracked(1 << 16), token_count);
+}
+
 SEASTAR_TEST_CASE(test_rate_limiter_partition_label_separation) {
     const uint64_t token_count = 30;
     const uint64_t repeat_count = 10;
@@ -1944,3 +1944,115 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_execution_stage_wakeu
 
     permit2_fut.get();
 }
+
+// Reads of a table queued behind many reads of another table are admitted in
+// turns with them, not after all of them.
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_fair_admission) {
+    simple_schema s1;
+    simple_schema s2;
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, 100 * 1024);
+    auto stop_sem = deferred_stop(semaphore);
+
+    auto permit = std::make_optional(semaphore.obtain_permit(s1.schema().get(), get_name(), 1024, db::no_timeout, {}).get());
+
+    std::vector<future<reader_permit>> s1_futs;
+    for (int i = 0; i < 3; ++i) {
+        s1_futs.push_back(semaphore.obtain_permit(s1.schema().get(), get_name(), 1024, db::no_timeout, {}));
+    }
+    auto s2_fut = semaphore.obtain_permit(s2.schema().get(), get_name(), 1024, db::no_timeout, {});
+
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 4);
+    BOOST_REQUIRE_EQUAL(semaphore.get_class_stats(s1.schema()->id()).queued_reads, 3);
+    BOOST_REQUIRE_EQUAL(semaphore.get_class_stats(s2.schema()->id()).queued_reads, 1);
+
+    // The table which started waiting first is served first.
+    permit.reset();
+    BOOST_REQUIRE(s1_futs[0].available());
+    BOOST_REQUIRE(!s2_fut.available());
+    permit.emplace(s1_futs[0].get());
+
+    // Then the other table gets its turn.
+    permit.reset();
+    BOOST_REQUIRE(s2_fut.available());
+    BOOST_REQUIRE(!s1_futs[1].available());
+    permit.emplace(s2_fut.get());
+
+    permit.reset();
+    BOOST_REQUIRE(s1_futs[1].available());
+    permit.emplace(s1_futs[1].get());
+
+    permit.reset();
+    BOOST_REQUIRE(s1_futs[2].available());
+    permit.emplace(s1_futs[2].get());
+    permit.reset();
+
+    const auto s1_stats = semaphore.get_class_stats(s1.schema()->id());
+    BOOST_REQUIRE_EQUAL(s1_stats.queued_reads, 0);
+    BOOST_REQUIRE_EQUAL(s1_stats.reads_enqueued_for_admission, 3);
+    BOOST_REQUIRE_EQUAL(semaphore.get_class_stats(s2.schema()->id()).reads_enqueued_for_admission, 1);
+
+    semaphore.evict_inactive_reads_for_table(s1.schema()->id()).get();
+    BOOST_REQUIRE_EQUAL(semaphore.get_class_stats(s1.schema()->id()).reads_enqueued_for_admission, 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_permit_abort) {
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::no_limits{}, get_name());
+    auto stop_sem = deferred_stop(semaphore);
+
+    simple_schema ss;
+    auto s = ss.schema();
+
+    // Active permit: the read notices the abort on the next check.
+    {
+        auto permit = semaphore.obtain_permit(s.get(), get_name(), 1024, db::no_timeout, {}).get();
+        BOOST_REQUIRE_NO_THROW(permit.check_abort());
+        permit.abort(std::make_exception_ptr(abort_requested_exception()));
+        BOOST_REQUIRE_THROW(permit.check_abort(), abort_requested_exception);
+    }
+
+    // Inactive permit: evicted.
+    {
+        auto permit = semaphore.obtain_permit(s.get(), get_name(), 1024, db::no_timeout, {}).get();
+        auto handle = semaphore.register_inactive_read(make_empty_flat_reader_v2(s, permit));
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().inactive_reads, 1);
+
+        permit.abort(std::make_exception_ptr(abort_requested_exception()));
+        BOOST_REQUIRE(!handle);
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().inactive_reads, 0);
+        BOOST_REQUIRE_EQUAL(permit.get_state(), reader_permit::state::evicted);
+        BOOST_REQUIRE_THROW(permit.check_abort(), abort_requested_exception);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_reader_permit_transient_objects) {
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::no_limits{}, get_name());
+    auto stop_sem = deferred_stop(semaphore);
+
+    simple_schema ss;
+    auto s = ss.schema();
+    auto permit = semaphore.obtain_permit(s.get(), get_name(), 1024, db::no_timeout, {}).get();
+
+    // Memory of the same size class is reused
+    auto p1 = permit.allocate_transient(100);
+    permit.deallocate_transient(p1, 100);
+    auto p2 = permit.allocate_transient(110);
+    BOOST_REQUIRE_EQUAL(p1, p2);
+    auto p3 = permit.allocate_transient(100);
+    BOOST_REQUIRE_NE(p2, p3);
+    permit.deallocate_transient(p2, 110);
+    permit.deallocate_transient(p3, 100);
+
+    // Large objects are not pooled
+    auto big = permit.allocate_transient(64 * 1024);
+    permit.deallocate_transient(big, 64 * 1024);
+
+    // Fragments keep the permit, and so the memory pool, alive
+    std::optional<mutation_fragment_v2> mf;
+    {
+        auto short_lived = semaphore.obtain_permit(s.get(), get_name(), 1024, db::no_timeout, {}).get();
+        mf.emplace(ss.make_row_v2(short_lived, ss.make_ckey(0), "v"));
+        mutation_fragment_v2 copy(*s, short_lived, *mf);
+        mf.emplace(std::move(copy));
+    }
+    mf.reset();
+}
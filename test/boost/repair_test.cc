@@ -10,9 +10,11 @@
 #include "readers/from_fragments_v2.hh"
 #include "readers/upgrading_consumer.hh"
 #include "repair/hash.hh"
+#include "repair/hash_sketch.hh"
 #include "repair/row.hh"
 #include "repair/writer.hh"
 #include "repair/row_level.hh"
+#include "compaction/compaction_manager.hh"
 #include "test/lib/mutation_source_test.hh"
 #include "test/lib/random_utils.hh"
 #include "test/lib/reader_concurrency_semaphore.hh"
@@ -126,10 +128,107 @@ SEASTAR_TEST_CASE(flush_repair_rows_on_wire_to_sstable) {
         std::deque<mutation_fragment_v2> fragments;
         lw_shared_ptr<repair_writer> writer = make_test_repair_writer(s, permit, fragments);
         uint64_t seed = tests::random::get_int<uint64_t>();
-        std::list<repair_row> repair_rows = to_repair_rows_list(std::move(input), s, seed, repair_master::yes, permit, repair_hasher(seed, s)).get();
+        std::list<repair_row> repair_rows = to_repair_rows_list(std::move(input), s, seed, repair_master::yes, permit,
+                repair_hasher(seed, s, row_level_diff_detect_algorithm::send_full_set_rpc_stream)).get();
         flush_rows(s, repair_rows, writer);
         writer->wait_for_writer_done().get();
         compare_readers(*s, m->make_flat_reader(s, permit), make_flat_mutation_reader_from_fragments(s, permit, std::move(fragments)));
     });
 }
 
+
+SEASTAR_TEST_CASE(repair_row_hashes_depend_only_on_algorithm_and_seed) {
+    // Master and followers hash their rows independently and compare the
+    // hashes, so the same rows must hash the same with the same algorithm and
+    // seed, whichever node computes them.
+    return seastar::async([&] {
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        reader_permit permit = semaphore.make_permit();
+        random_mutation_generator gen{random_mutation_generator::generate_counters::no};
+        schema_ptr s = gen.schema();
+        auto m = make_lw_shared<replica::memtable>(s);
+        repair_rows_on_wire input = make_random_repair_rows_on_wire(gen, s, permit, m);
+        uint64_t seed = tests::random::get_int<uint64_t>();
+        auto hashes = [&] (row_level_diff_detect_algorithm algo) {
+            std::vector<repair_hash> ret;
+            for (auto& row : to_repair_rows_list(input, s, seed, repair_master::yes, permit, repair_hasher(seed, s, algo)).get()) {
+                ret.push_back(row.hash());
+            }
+            return ret;
+        };
+        auto xx = hashes(row_level_diff_detect_algorithm::send_full_set_rpc_stream);
+        auto xxh3 = hashes(row_level_diff_detect_algorithm::send_full_set_rpc_stream_xxh3);
+        BOOST_REQUIRE(!xx.empty());
+        BOOST_REQUIRE(xx == hashes(row_level_diff_detect_algorithm::send_full_set_rpc_stream));
+        BOOST_REQUIRE(xxh3 == hashes(row_level_diff_detect_algorithm::send_full_set_rpc_stream_xxh3));
+        BOOST_REQUIRE(xx != xxh3);
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(repair_hash_sketch_decodes_small_differences) {
+    auto random_hashes = [] (size_t n) {
+        repair_hash_set ret;
+        while (ret.size() < n) {
+            ret.emplace(tests::random::get_int<uint64_t>());
+        }
+        return ret;
+    };
+    auto sketch_of = [] (size_t nr_cells, std::initializer_list<const repair_hash_set*> sets) {
+        repair_hash_sketch sketch(nr_cells);
+        for (auto set : sets) {
+            for (auto& h : *set) {
+                sketch.insert(h);
+            }
+        }
+        return sketch;
+    };
+    auto common = random_hashes(10000);
+    auto local_only = random_hashes(30);
+    auto remote_only = random_hashes(50);
+    auto nr_cells = repair_hash_sketch::nr_cells_for(common.size());
+
+    auto local = sketch_of(nr_cells, {&common, &local_only});
+    auto remote = sketch_of(nr_cells, {&common, &remote_only});
+    auto diff = local.decode_difference(remote);
+    BOOST_REQUIRE(diff);
+    BOOST_REQUIRE(diff->local_only == local_only);
+    BOOST_REQUIRE(diff->remote_only == remote_only);
+
+    BOOST_REQUIRE(local.decode_difference(local)->local_only.empty());
+
+    // Far more differences than cells can't be decoded.
+    auto many = random_hashes(nr_cells * 2);
+    BOOST_REQUIRE(!local.decode_difference(sketch_of(nr_cells, {&common, &many})));
+
+    BOOST_REQUIRE_THROW(local.decode_difference(repair_hash_sketch(nr_cells * 2)), std::runtime_error);
+}
+
+SEASTAR_THREAD_TEST_CASE(repair_history_map_is_bounded) {
+    repair_history_map m;
+    auto range = [] (int64_t i) {
+        return dht::token_range(dht::token_range::bound(dht::token::from_int64(i * 10), false),
+                dht::token_range::bound(dht::token::from_int64(i * 10 + 10), true));
+    };
+    auto repair_time = [] (int64_t i) {
+        return gc_clock::time_point(gc_clock::duration(1000 + i % 7));
+    };
+    const int64_t nr_ranges = repair_history_map::max_ranges * 2;
+    for (int64_t i = 0; i < nr_ranges; ++i) {
+        // Leave a few ranges unrepaired.
+        if (i % 100 != 99) {
+            m.update_repair_time(range(i), repair_time(i));
+        }
+    }
+    BOOST_REQUIRE_LE(m.map.iterative_size(), repair_history_map::max_ranges);
+
+    for (int64_t i = 0; i < nr_ranges; ++i) {
+        auto it = m.map.find(dht::token::from_int64(i * 10 + 5));
+        if (i % 100 == 99) {
+            BOOST_REQUIRE(it == m.map.end());
+        } else {
+            // Coalescing may only make ranges look repaired earlier.
+            BOOST_REQUIRE(it != m.map.end());
+            BOOST_REQUIRE_LE(it->second.time_since_epoch().count(), repair_time(i).time_since_epoch().count());
+        }
+    }
+}
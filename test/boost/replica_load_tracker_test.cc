@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <seastar/testing/thread_test_case.hh>
+
+#include "service/replica_load_tracker.hh"
+
+using namespace std::chrono_literals;
+using service::replica_load_tracker;
+using service::retry_budget;
+
+static const gms::inet_address a("127.0.0.1");
+static const gms::inet_address b("127.0.0.2");
+static const gms::inet_address c("127.0.0.3");
+
+SEASTAR_THREAD_TEST_CASE(test_ranking_by_latency) {
+    replica_load_tracker tracker;
+    auto now = replica_load_tracker::clock::now();
+
+    for (auto [ep, latency] : {std::pair(a, 10ms), std::pair(b, 1ms), std::pair(c, 5ms)}) {
+        tracker.on_request_sent(ep);
+        tracker.on_request_completed(ep, latency, now);
+    }
+    BOOST_REQUIRE_EQUAL(tracker.in_flight(a), 0);
+
+    inet_address_vector_replica_set eps{a, b, c};
+    tracker.rank(eps.begin(), eps.end(), now);
+    BOOST_REQUIRE(eps == inet_address_vector_replica_set({b, c, a}));
+
+    // Only the given range is reordered.
+    eps = {a, b, c};
+    tracker.rank(eps.begin() + 1, eps.end(), now);
+    BOOST_REQUIRE(eps == inet_address_vector_replica_set({a, b, c}));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_ranking_by_queue) {
+    replica_load_tracker tracker;
+    auto now = replica_load_tracker::clock::now();
+
+    for (auto ep : {a, b}) {
+        tracker.on_request_sent(ep);
+        tracker.on_request_completed(ep, 1ms, now);
+    }
+    // A stalled replica, with reads piling up.
+    for (int i = 0; i < 3; ++i) {
+        tracker.on_request_sent(a);
+    }
+    BOOST_REQUIRE_EQUAL(tracker.in_flight(a), 3);
+    BOOST_REQUIRE_GT(tracker.score(a, now), tracker.score(b, now));
+
+    inet_address_vector_replica_set eps{a, b};
+    tracker.rank(eps.begin(), eps.end(), now);
+    BOOST_REQUIRE(eps == inet_address_vector_replica_set({b, a}));
+
+    // Stays penalized while its reads are in flight, even without new
+    // measurements.
+    now += 10s;
+    BOOST_REQUIRE_GT(tracker.score(a, now), tracker.score(b, now));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_stale_measurements_are_ignored) {
+    replica_load_tracker tracker;
+    auto now = replica_load_tracker::clock::now();
+
+    tracker.on_request_sent(a);
+    tracker.on_request_completed(a, 100ms, now);
+    BOOST_REQUIRE_GT(tracker.score(a, now), 0);
+
+    now += replica_load_tracker::stale_after + 1s;
+    BOOST_REQUIRE_EQUAL(tracker.score(a, now), 0);
+    BOOST_REQUIRE_EQUAL(tracker.score(c, now), 0);
+
+    // A fresh measurement replaces the stale one instead of being averaged
+    // with it.
+    tracker.on_request_sent(a);
+    tracker.on_request_completed(a, 1ms, now);
+    BOOST_REQUIRE_EQUAL(tracker.score(a, now), 1000);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_latency_percentile) {
+    replica_load_tracker tracker;
+    auto now = replica_load_tracker::clock::now();
+
+    BOOST_REQUIRE(!tracker.latency_percentile(a, 0.99, now));
+
+    auto complete = [&] (gms::inet_address ep, auto latency, int count) {
+        for (int i = 0; i < count; ++i) {
+            tracker.on_request_sent(ep);
+            tracker.on_request_completed(ep, latency, now);
+        }
+    };
+
+    // Too few samples.
+    complete(a, 1ms, replica_load_tracker::min_percentile_samples - 1);
+    BOOST_REQUIRE(!tracker.latency_percentile(a, 0.99, now));
+
+    now += 2s;
+    complete(a, 1ms, 90);
+    complete(a, 50ms, 10);
+    complete(b, 50ms, 100);
+    auto pa50 = tracker.latency_percentile(a, 0.5, now);
+    BOOST_REQUIRE(pa50);
+    BOOST_REQUIRE_LE(pa50->count(), 2000);
+
+    now += 2s;
+    auto pa99 = tracker.latency_percentile(a, 0.99, now);
+    auto pb99 = tracker.latency_percentile(b, 0.99, now);
+    BOOST_REQUIRE(pa99 && pb99);
+    BOOST_REQUIRE_GE(pa99->count(), 40000);
+    BOOST_REQUIRE_GE(pb99->count(), 40000);
+    BOOST_REQUIRE_GT(pb99->count(), pa50->count());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_retry_budget) {
+    retry_budget budget;
+
+    // A full budget absorbs a burst.
+    for (int i = 0; i < int(retry_budget::max_balance); ++i) {
+        BOOST_REQUIRE(budget.try_spend());
+    }
+    BOOST_REQUIRE(!budget.try_spend());
+
+    // Then allows a retry for every 10 requests, at 10%.
+    int retries = 0;
+    for (int i = 0; i < 100; ++i) {
+        budget.on_request(0.1);
+        retries += budget.try_spend();
+    }
+    BOOST_REQUIRE_GE(retries, 9);
+    BOOST_REQUIRE_LE(retries, 10);
+
+    for (int i = 0; i < 1000; ++i) {
+        budget.on_request(0.1);
+    }
+    BOOST_REQUIRE_EQUAL(budget.balance(), retry_budget::max_balance);
+}
@@ -141,6 +141,41 @@ SEASTAR_TEST_CASE(test_cache_delegates_to_underlying) {
     });
 }
 
+SEASTAR_TEST_CASE(test_token_range_hit_rate) {
+    return seastar::async([] {
+        auto s = make_schema();
+        auto m = make_new_mutation(s);
+        auto token = m.decorated_key().token();
+
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(make_source_with(m)), tracker);
+
+        BOOST_REQUIRE(!cache.token_range_hit_rate(token));
+
+        auto pr = dht::partition_range::make_singular(m.decorated_key());
+        assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+            .produces(m)
+            .produces_end_of_stream();
+        BOOST_REQUIRE(cache.token_range_hit_rate(token));
+        auto cold = float(*cache.token_range_hit_rate(token));
+        BOOST_REQUIRE_EQUAL(cold, 0.0f);
+
+        assert_that(cache.make_reader(s, semaphore.make_permit(), pr))
+            .produces(m)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_GT(float(*cache.token_range_hit_rate(token)), cold);
+
+        // Scans don't count
+        auto other = dht::token::from_int64(dht::token::to_int64(token) ^ std::numeric_limits<int64_t>::min());
+        assert_that(cache.make_reader(s, semaphore.make_permit(), query::full_partition_range))
+            .produces(m)
+            .produces_end_of_stream();
+        BOOST_REQUIRE(!cache.token_range_hit_rate(other));
+    });
+}
+
 SEASTAR_TEST_CASE(test_cache_works_after_clearing) {
     return seastar::async([] {
         auto s = make_schema();
@@ -14,14 +14,18 @@
 #include <seastar/core/reactor.hh>
 #include <seastar/core/file.hh>
 #include <seastar/core/fstream.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/http/exception.hh>
 #include <seastar/util/closeable.hh>
+#include <seastar/util/defer.hh>
 #include <seastar/testing/thread_test_case.hh>
 #include "test/lib/log.hh"
 #include "test/lib/random_utils.hh"
 #include "test/lib/test_utils.hh"
 #include "utils/s3/client.hh"
 #include "utils/s3/creds.hh"
+#include "utils/s3/block_cache.hh"
+#include "test/lib/tmpdir.hh"
 #include "gc_clock.hh"
 
 // The test can be run on real AWS-S3 bucket. For that, create a bucket with
@@ -100,11 +104,11 @@ SEASTAR_THREAD_TEST_CASE(test_client_put_get_object) {
     cln->close().get();
 }
 
-void do_test_client_multipart_upload(bool with_copy_upload) {
+void do_test_client_multipart_upload(bool with_copy_upload, s3::endpoint_config_ptr cfg = make_minio_config()) {
     const sstring name(fmt::format("/{}/test{}object-{}", tests::getenv_safe("S3_PUBLIC_BUCKET_FOR_TEST"), with_copy_upload ? "jumbo" : "large", ::getpid()));
 
     testlog.info("Make client\n");
-    auto cln = s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), make_minio_config());
+    auto cln = s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), std::move(cfg));
 
     testlog.info("Upload object (with copy = {})\n", with_copy_upload);
     auto out = output_stream<char>(
@@ -162,6 +166,13 @@ SEASTAR_THREAD_TEST_CASE(test_client_multipart_copy_upload) {
     do_test_client_multipart_upload(true);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_client_multipart_upload_one_part_at_a_time) {
+    auto cfg = make_minio_config();
+    cfg->upload_part_size = 7 << 20;
+    cfg->upload_part_concurrency = 1;
+    do_test_client_multipart_upload(false, std::move(cfg));
+}
+
 SEASTAR_THREAD_TEST_CASE(test_client_readable_file) {
     const sstring name(fmt::format("/{}/testroobject-{}", tests::getenv_safe("S3_PUBLIC_BUCKET_FOR_TEST"), ::getpid()));
 
@@ -205,3 +216,57 @@ SEASTAR_THREAD_TEST_CASE(test_client_readable_file) {
     f.close().get();
     cln->close().get();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_client_cached_readable_file) {
+    const sstring name(fmt::format("/{}/testcachedobject-{}", tests::getenv_safe("S3_PUBLIC_BUCKET_FOR_TEST"), ::getpid()));
+    constexpr size_t bs = s3::block_cache::block_size;
+
+    testlog.info("Make client\n");
+    auto cln = s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), make_minio_config());
+    auto close_client = deferred_close(*cln);
+
+    testlog.info("Put object {}\n", name);
+    auto payload = tests::random::get_sstring(2 * bs + 1000);
+    cln->put_object(name, temporary_buffer<char>(payload.data(), payload.size())).get();
+
+    tmpdir tmp;
+    auto check = [&] (s3::block_cache& cache) {
+        auto f = s3::make_cached_file(cln->make_readable_file(name), name, cache);
+        BOOST_REQUIRE_EQUAL(f.size().get0(), payload.size());
+        // Within a block, across blocks, and past the end of the object
+        for (auto [pos, len] : std::vector<std::pair<size_t, size_t>>{{10, 100}, {bs - 10, 20}, {bs / 2, 2 * bs}, {2 * bs + 900, 500}}) {
+            auto buf = f.dma_read_bulk<char>(pos, len).get0();
+            BOOST_REQUIRE_EQUAL(to_sstring(std::move(buf)), payload.substr(pos, len));
+        }
+        f.close().get();
+    };
+
+    testlog.info("Read through an empty cache\n");
+    {
+        s3::block_cache cache(tmp.path() / "cache.db", 16 * (bs + 4096));
+        cache.start().get();
+        auto stop_cache = defer([&cache] { cache.stop().get(); });
+        check(cache);
+        BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 0);
+        // Let the background writes finish
+        while (cache.get_stats().inserts < 3) {
+            yield().get();
+        }
+        check(cache);
+        BOOST_REQUIRE_GT(cache.get_stats().hits, 0);
+    }
+
+    testlog.info("Read through the cache reopened\n");
+    {
+        s3::block_cache cache(tmp.path() / "cache.db", 16 * (bs + 4096));
+        cache.start().get();
+        auto stop_cache = defer([&cache] { cache.stop().get(); });
+        // Let the index load
+        sleep(std::chrono::milliseconds(100)).get();
+        check(cache);
+        BOOST_REQUIRE_GT(cache.get_stats().hits, 0);
+        BOOST_REQUIRE_EQUAL(cache.get_stats().invalid, 0);
+    }
+
+    cln->delete_object(name).get();
+}
@@ -72,6 +72,7 @@
 #include "readers/from_mutations_v2.hh"
 #include "readers/from_fragments_v2.hh"
 #include "readers/combined.hh"
+#include "exceptions/exceptions.hh"
 
 namespace fs = std::filesystem;
 
@@ -131,6 +132,13 @@ class strategy_control_for_test : public strategy_control {
     bool has_ongoing_compaction(table_state& table_s) const noexcept override {
         return _has_ongoing_compaction;
     }
+
+    std::vector<dht::token_range> ongoing_compaction_ranges(table_state& table_s) const override {
+        if (!_has_ongoing_compaction) {
+            return {};
+        }
+        return {dht::token_range::make_open_ended_both_sides()};
+    }
 };
 
 static std::unique_ptr<strategy_control> make_strategy_control_for_test(bool has_ongoing_compaction) {
@@ -141,6 +149,11 @@ static void assert_table_sstable_count(table_for_tests& t, size_t expected_count
     testlog.info("sstable_set_size={}, live_sstable_count={}, expected={}", t->get_sstables()->size(), t->get_stats().live_sstable_count, expected_count);
     BOOST_REQUIRE(t->get_sstables()->size() == expected_count);
     BOOST_REQUIRE(uint64_t(t->get_stats().live_sstable_count) == expected_count);
+    int64_t partitions = 0;
+    for (auto& sst : *t->get_sstables()) {
+        partitions += sst->get_stats_metadata().estimated_partition_size.count();
+    }
+    BOOST_REQUIRE_EQUAL(t->get_stats().live_sstables.partitions, partitions);
 }
 
 SEASTAR_TEST_CASE(compaction_manager_basic_test) {
@@ -884,6 +897,60 @@ SEASTAR_TEST_CASE(leveled_stcs_on_L0) {
   });
 }
 
+SEASTAR_TEST_CASE(leveled_disjoint_parallel_compaction) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto cf = env.make_table_for_tests();
+    auto stop_cf = deferred_stop(cf);
+
+    const auto keys = tests::generate_partition_keys(24, cf.schema());
+    auto max_sstable_size_in_mb = 1;
+    auto max_sstable_size = max_sstable_size_in_mb*1024*1024;
+
+    // L1 holds more than its target size, in sstables of disjoint key ranges.
+    std::vector<sstables::shared_sstable> l1;
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        l1.push_back(add_sstable_for_leveled_test(env, cf, max_sstable_size, /*level*/1, keys[i].key(), keys[i + 1].key()));
+    }
+    auto token_range_of = [] (const sstables::shared_sstable& sst) {
+        return dht::token_range::make(sst->get_first_decorated_key().token(), sst->get_last_decorated_key().token());
+    };
+    // The first sstable of L1 is being compacted, so it isn't a candidate.
+    auto ongoing = token_range_of(l1.front());
+    auto candidates = get_candidates_for_leveled_strategy(*cf);
+    candidates.erase(std::find(candidates.begin(), candidates.end(), l1.front()));
+
+    std::vector<std::optional<dht::decorated_key>> last_compacted_keys(leveled_manifest::MAX_LEVELS);
+    std::vector<int> compaction_counter(leveled_manifest::MAX_LEVELS);
+    sstables::size_tiered_compaction_strategy_options stcs_options;
+    auto disjoint_from = [] (const dht::token_range& range) {
+        return [range] (const sstables::compaction_descriptor& descriptor) {
+            return !range.overlaps(descriptor.token_range(), dht::token_comparator());
+        };
+    };
+
+    leveled_manifest manifest = leveled_manifest::create(cf.as_table_state(), candidates, max_sstable_size_in_mb, stcs_options);
+    auto candidate = manifest.get_compaction_candidates(last_compacted_keys, compaction_counter, disjoint_from(ongoing));
+    BOOST_REQUIRE_EQUAL(candidate.sstables.size(), 1);
+    BOOST_REQUIRE(candidate.sstables.front() == l1[1]);
+    BOOST_REQUIRE_EQUAL(candidate.level, 2);
+
+    // Nothing can run along with a compaction of the whole ring, but size-tiering L0.
+    auto whole_ring = dht::token_range::make_open_ended_both_sides();
+    candidate = manifest.get_compaction_candidates(last_compacted_keys, compaction_counter, disjoint_from(whole_ring));
+    BOOST_REQUIRE(candidate.sstables.empty());
+
+    std::unordered_set<sstables::shared_sstable> expected;
+    for (auto i = 0; i < cf.schema()->min_compaction_threshold(); i++) {
+        expected.insert(add_sstable_for_leveled_test(env, cf, max_sstable_size / 8, /*level*/0, keys.front().key(), keys.back().key()));
+    }
+    candidates.insert(candidates.end(), expected.begin(), expected.end());
+    leveled_manifest manifest_with_l0 = leveled_manifest::create(cf.as_table_state(), candidates, max_sstable_size_in_mb, stcs_options);
+    candidate = manifest_with_l0.get_compaction_candidates(last_compacted_keys, compaction_counter, disjoint_from(whole_ring));
+    BOOST_REQUIRE_EQUAL(candidate.level, 0);
+    BOOST_REQUIRE(boost::copy_range<std::unordered_set<sstables::shared_sstable>>(candidate.sstables) == expected);
+  });
+}
+
 SEASTAR_TEST_CASE(overlapping_starved_sstables_test) {
   return test_env::do_with_async([] (test_env& env) {
     auto cf = env.make_table_for_tests();
@@ -1306,9 +1373,19 @@ SEASTAR_TEST_CASE(compaction_with_fully_expired_table) {
         auto expired_sst = *expired.begin();
         BOOST_REQUIRE(expired_sst == sst);
 
+        // The strategies pick a fully expired sstable on its own, even below the compaction threshold.
+        auto strategy_c = make_strategy_control_for_test(false);
+        for (auto type : {sstables::compaction_strategy_type::size_tiered, sstables::compaction_strategy_type::leveled}) {
+            auto cs = sstables::make_compaction_strategy(type, {});
+            auto descriptor = cs.get_sstables_for_compaction(cf.as_table_state(), *strategy_c, ssts);
+            BOOST_REQUIRE(descriptor.has_only_fully_expired);
+            BOOST_REQUIRE(descriptor.sstables == ssts);
+        }
+
         auto ret = compact_sstables(sstables::compaction_descriptor(ssts), cf, sst_gen).get0();
         BOOST_REQUIRE(ret.new_sstables.empty());
         BOOST_REQUIRE(ret.stats.end_size == 0);
+        BOOST_REQUIRE_EQUAL(ret.stats.fully_expired_size, sst->bytes_on_disk());
     });
 }
 
@@ -1731,6 +1808,62 @@ SEASTAR_TEST_CASE(size_tiered_beyond_max_threshold_test) {
   });
 }
 
+SEASTAR_TEST_CASE(size_tiered_buckets_whole_runs_test) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto cf = env.make_table_for_tests();
+    auto stop_cf = deferred_stop(cf);
+    const uint64_t fragment_size = 100 * 1024 * 1024;
+    const size_t fragments_per_run = 10;
+
+    // Four runs of ten 100M fragments, and two standalone 100M sstables.
+    // The fragments must be tiered with their runs, as 1G units.
+    std::vector<sstables::shared_sstable> candidates;
+    std::vector<sstables::run_id> run_ids;
+    for (auto r = 0; r < 4; r++) {
+        run_ids.push_back(sstables::run_id::create_random_id());
+        for (size_t f = 0; f < fragments_per_run; f++) {
+            auto sst = cf.make_sstable();
+            sstables::test(sst).set_data_file_size(fragment_size);
+            sstables::test(sst).set_run_identifier(run_ids.back());
+            candidates.push_back(std::move(sst));
+        }
+    }
+    for (auto i = 0; i < 2; i++) {
+        auto sst = cf.make_sstable();
+        sstables::test(sst).set_data_file_size(fragment_size);
+        sstables::test(sst).set_run_identifier(sstables::run_id::create_random_id());
+        candidates.push_back(std::move(sst));
+    }
+
+    auto runs_of = [] (const std::vector<sstables::shared_sstable>& ssts) {
+        return boost::copy_range<std::unordered_set<sstables::run_id>>(ssts | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::run_identifier)));
+    };
+
+    auto bucket = sstables::size_tiered_compaction_strategy::most_interesting_bucket(candidates, 4, 32);
+    BOOST_REQUIRE_EQUAL(bucket.size(), 4 * fragments_per_run);
+    BOOST_REQUIRE(runs_of(bucket) == boost::copy_range<std::unordered_set<sstables::run_id>>(run_ids));
+
+    // Trimming to max_threshold keeps whole runs.
+    bucket = sstables::size_tiered_compaction_strategy::most_interesting_bucket(candidates, 2, 3);
+    BOOST_REQUIRE_EQUAL(bucket.size(), 3 * fragments_per_run);
+    BOOST_REQUIRE_EQUAL(runs_of(bucket).size(), 3);
+
+    // Output is split into fragments only if asked to.
+    auto strategy_c = make_strategy_control_for_test(false);
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {});
+    auto desc = cs.get_sstables_for_compaction(cf.as_table_state(), *strategy_c, candidates);
+    BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, compaction_descriptor::default_max_sstable_bytes);
+
+    cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {{"fragment_size_in_mb", "160"}});
+    desc = cs.get_sstables_for_compaction(cf.as_table_state(), *strategy_c, candidates);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), 4 * fragments_per_run);
+    BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, 160 * 1024 * 1024);
+
+    BOOST_REQUIRE_THROW(sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {{"fragment_size_in_mb", "-1"}}),
+            exceptions::configuration_exception);
+  });
+}
+
 SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     return test_env::do_with_async([] (test_env& env) {
         auto make_schema = [&] (sstables::compaction_strategy_type cst) {
@@ -1840,6 +1973,38 @@ SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
             auto descriptor = cs.get_sstables_for_compaction(cf.as_table_state(), *strategy_c, { sst });
             BOOST_REQUIRE(descriptor.sstables.size() == 0);
         }
+        // sstable below the droppable ratio threshold is included, along with an older sstable
+        // overlapping it, once tombstones make up most of what reads scan from it.
+        {
+            sstables::test(sst).set_data_file_write_time(db_clock::time_point::min());
+            auto older_mt = make_lw_shared<replica::memtable>(s);
+            for (auto i = 0; i < 10; i++) {
+                mutation m(s, partition_key::from_exploded(*s, {to_bytes("key" + to_sstring(i))}));
+                m.set_clustered_cell(clustering_key::from_exploded(*s, {to_bytes("c1")}), "r1", data_value(sstring("b")), api::min_timestamp + 1);
+                older_mt->apply(std::move(m));
+            }
+            auto older = make_sstable_containing(sst_gen, older_mt);
+
+            std::map<sstring, sstring> options;
+            options.emplace("tombstone_threshold", "0.5f");
+            options.emplace("tombstone_read_threshold", "0.5f");
+            // keep the sstables in different tiers.
+            options.emplace("min_sstable_size", "1");
+            auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, options);
+            auto descriptor = cs.get_sstables_for_compaction(cf.as_table_state(), *strategy_c, { sst, older });
+            BOOST_REQUIRE(descriptor.sstables.size() == 0);
+
+            for (auto i = 0; i < 1000; i++) {
+                sst->get_stats().on_row_read();
+                if (i % 3) {
+                    sst->get_stats().on_row_tombstone_read();
+                }
+            }
+            descriptor = cs.get_sstables_for_compaction(cf.as_table_state(), *strategy_c, { sst, older });
+            BOOST_REQUIRE_EQUAL(descriptor.sstables.size(), 2);
+            BOOST_REQUIRE(descriptor.sstables.back() == sst);
+            BOOST_REQUIRE(descriptor.sstables.front() == older);
+        }
     });
 }
 
@@ -1990,6 +2155,59 @@ SEASTAR_TEST_CASE(sstable_cleanup_correctness_test) {
     });
 }
 
+SEASTAR_TEST_CASE(sstable_cleanup_owned_ranges_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "cleanup_owned_ranges_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto make_insert = [&] (dht::decorated_key key) {
+            mutation m(s, std::move(key));
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(1)), api::timestamp_type(0));
+            return m;
+        };
+
+        auto keys = tests::generate_partition_keys(100, s);
+        std::vector<mutation> mutations;
+        for (auto& key : keys) {
+            mutations.push_back(make_insert(key));
+        }
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+        cf->start();
+
+        auto cleanup = [&] (shared_sstable sst, dht::token_range_vector owned) {
+            auto descriptor = sstables::compaction_descriptor({std::move(sst)}, compaction_descriptor::default_level,
+                compaction_descriptor::default_max_sstable_bytes, run_id::create_random_id(), compaction_type_options::make_cleanup(),
+                compaction::make_owned_ranges_ptr(std::move(owned)));
+            return compact_sstables(std::move(descriptor), cf, sst_gen).get0();
+        };
+
+        // Only the partitions of the owned ranges are kept.
+        auto ret = cleanup(make_sstable_containing(sst_gen, mutations), {
+            dht::token_range::make(keys[10].token(), keys[19].token()),
+            dht::token_range::make(keys[50].token(), keys[59].token()),
+        });
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+        auto reader = assert_that(sstable_reader(ret.new_sstables.front(), s, env.make_reader_permit()));
+        for (auto [begin, end] : std::vector<std::pair<size_t, size_t>>{{10, 20}, {50, 60}}) {
+            for (auto i = begin; i < end; i++) {
+                reader.produces(mutations[i]);
+            }
+        }
+        reader.produces_end_of_stream();
+
+        // Nothing is written for an sstable holding no owned partition.
+        ret = cleanup(make_sstable_containing(sst_gen, std::vector<mutation>(mutations.begin() + 10, mutations.begin() + 20)), {
+            dht::token_range::make(keys[50].token(), keys[59].token()),
+        });
+        BOOST_REQUIRE(ret.new_sstables.empty());
+    });
+}
+
 std::vector<mutation_fragment_v2> write_corrupt_sstable(test_env& env, sstable& sst, reader_permit permit,
         std::function<void(mutation_fragment_v2&&, bool)> write_to_secondary) {
     auto schema = sst.get_schema();
@@ -4442,6 +4660,126 @@ SEASTAR_TEST_CASE(twcs_single_key_reader_through_compound_set_test) {
     });
 }
 
+// A partition tombstone in one sstable should only disable the optimized TWCS
+// single partition read path for the partitions that sstable may contain.
+SEASTAR_TEST_CASE(time_series_partition_tombstone_optimized_reads_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "time_series_partition_tombstone_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("cl", int32_type, column_kind::clustering_key)
+                .with_column("value", int32_type);
+        builder.set_compaction_strategy(sstables::compaction_strategy_type::time_window);
+        auto s = builder.build();
+        auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::time_window, s->compaction_strategy_options());
+
+        auto keys = tests::generate_partition_keys(2, s);
+        auto make_row = [&] (const dht::decorated_key& key, int32_t ck) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(ck)), bytes("value"), data_value(ck), api::new_timestamp());
+            return m;
+        };
+        auto old_row = make_row(keys[1], 1);
+        auto deleted = mutation(s, keys[1]);
+        deleted.partition().apply(tombstone(api::new_timestamp(), gc_clock::now()));
+        auto new_row = make_row(keys[1], 2);
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+        cf->start();
+
+        auto sst_gen = env.make_sst_factory(s);
+        auto set = make_lw_shared<sstable_set>(cs.make_sstable_set(s));
+        set->insert(make_sstable_containing(sst_gen, {make_row(keys[0], 1)}));
+        set->insert(make_sstable_containing(sst_gen, {make_row(keys[0], 2)}));
+        set->insert(make_sstable_containing(sst_gen, {old_row}));
+        set->insert(make_sstable_containing(sst_gen, {deleted}));
+        set->insert(make_sstable_containing(sst_gen, {new_row}));
+
+        auto read = [&] (const dht::decorated_key& key, const query::partition_slice& slice) {
+            utils::estimated_histogram eh;
+            auto pr = dht::partition_range::make_singular(key);
+            auto reader = set->create_single_key_sstable_reader(&*cf, s, env.make_reader_permit(), eh, pr, slice,
+                    tracing::trace_state_ptr(), ::streamed_mutation::forwarding::no, ::mutation_reader::forwarding::no);
+            auto close_reader = deferred_close(reader);
+            auto m = read_mutation_from_flat_mutation_reader(reader).get0();
+            BOOST_REQUIRE(m);
+            return *m;
+        };
+
+        // Only the standard path goes through the clustering filter fast path for a full slice.
+        auto m = read(keys[0], s->full_slice());
+        BOOST_REQUIRE_EQUAL(m.partition().clustered_rows().calculate_size(), 2);
+        BOOST_REQUIRE_EQUAL(cf.cf_stats().clustering_filter_fast_path_count, 0);
+
+        // The partition tombstone doesn't disable the optimized path, and applies to
+        // the rows of the sstables opened after it.
+        m = read(keys[1], s->full_slice());
+        assert_that(m).is_equal_to(old_row + deleted + new_row);
+        BOOST_REQUIRE_EQUAL(cf.cf_stats().clustering_filter_fast_path_count, 0);
+
+        auto slice = partition_slice_builder(*s)
+                .with_range(query::clustering_range::make_starting_with(clustering_key::from_single_value(*s, int32_type->decompose(2))))
+                .build();
+        m = read(keys[1], slice);
+        assert_that(m).is_equal_to(deleted + new_row);
+        BOOST_REQUIRE_EQUAL(cf.cf_stats().clustering_filter_fast_path_count, 0);
+    });
+}
+
+SEASTAR_TEST_CASE(clustering_order_single_key_reads_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "clustering_order_single_key_reads_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("cl", int32_type, column_kind::clustering_key)
+                .with_column("value", int32_type);
+        auto s = builder.build();
+        auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, s->compaction_strategy_options());
+
+        auto key = tests::generate_partition_key(s);
+        auto deleted = mutation(s, key);
+        deleted.partition().apply(tombstone(api::new_timestamp(), gc_clock::now()));
+        auto make_rows = [&] (int32_t first, int32_t last) {
+            mutation m(s, key);
+            for (auto ck = first; ck < last; ++ck) {
+                m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(ck)), bytes("value"), data_value(ck), api::new_timestamp());
+            }
+            return m;
+        };
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+        cf->start();
+
+        auto sst_gen = env.make_sst_factory(s);
+        auto set = make_lw_shared<sstable_set>(cs.make_sstable_set(s));
+        auto expected = deleted;
+        for (int32_t first : {20, 0, 10}) {
+            auto m = make_rows(first, first + 10);
+            set->insert(make_sstable_containing(sst_gen, {m}));
+            expected.apply(m);
+        }
+        set->insert(make_sstable_containing(sst_gen, {deleted}));
+
+        auto read = [&] (const query::partition_slice& slice) {
+            utils::estimated_histogram eh;
+            auto pr = dht::partition_range::make_singular(key);
+            auto reader = set->create_single_key_sstable_reader(&*cf, s, env.make_reader_permit(), eh, pr, slice,
+                    tracing::trace_state_ptr(), ::streamed_mutation::forwarding::no, ::mutation_reader::forwarding::no);
+            auto close_reader = deferred_close(reader);
+            auto m = read_mutation_from_flat_mutation_reader(reader).get0();
+            BOOST_REQUIRE(m);
+            return *m;
+        };
+
+        assert_that(read(s->full_slice())).is_equal_to(expected);
+
+        auto ranges = query::clustering_row_ranges{
+                query::clustering_range::make_starting_with(clustering_key::from_single_value(*s, int32_type->decompose(15)))};
+        auto slice = partition_slice_builder(*s).with_ranges(ranges).build();
+        assert_that(read(slice)).is_equal_to(expected.sliced(ranges));
+    });
+}
+
 SEASTAR_TEST_CASE(test_major_does_not_miss_data_in_memtable) {
     return test_env::do_with_async([] (test_env& env) {
         auto builder = schema_builder("tests", "test_major_does_not_miss_data_in_memtable")
@@ -4768,6 +5106,8 @@ SEASTAR_TEST_CASE(test_large_partition_splitting_on_compaction) {
 
         testlog.info("Large partition splitting on compaction created {} sstables", ret.new_sstables.size());
         BOOST_REQUIRE(ret.new_sstables.size() > 1);
+        // All the output holds the single partition, so every new sstable but the first continues it.
+        BOOST_REQUIRE_EQUAL(ret.stats.large_partition_splits, ret.new_sstables.size() - 1);
 
         sstable_run sst_run;
 
@@ -58,6 +58,8 @@
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/reader_concurrency_semaphore.hh"
 #include "test/lib/sstable_utils.hh"
+#include "test/lib/eventually.hh"
+#include "sstables/chunk_cache.hh"
 #include "test/lib/random_utils.hh"
 #include "test/lib/test_utils.hh"
 #include "readers/from_mutations_v2.hh"
@@ -124,6 +126,59 @@ SEASTAR_TEST_CASE(datafile_generation_09) {
     });
 }
 
+SEASTAR_TEST_CASE(test_deferred_bloom_filter_loading) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = make_shared_schema({}, some_keyspace, some_column_family,
+            {{"p1", utf8_type}}, {{"c1", utf8_type}}, {{"r1", int32_type}}, {}, utf8_type);
+
+        const column_definition& r1_col = *s->get_column_definition("r1");
+        auto key = partition_key::from_exploded(*s, {to_bytes("key1")});
+        mutation m(s, key);
+        m.set_clustered_cell(clustering_key::from_exploded(*s, {to_bytes("abc")}), r1_col, make_atomic_cell(int32_type, int32_type->decompose(1)));
+
+        auto sst = make_sstable_containing(env.make_sstable(s), {std::move(m)});
+        auto sst2 = env.make_sstable(s, sst->get_storage().prefix(), sst->generation(), sst->get_version());
+        sst2->load(s->get_sharder(), sstable_open_config{ .load_bloom_filter = false }).get();
+
+        BOOST_REQUIRE(sst2->has_deferred_filter());
+        BOOST_REQUIRE_EQUAL(sst2->filter_memory_size(), 0);
+        BOOST_REQUIRE(sst2->filter_has_key(*s, key.view()));
+
+        sst2->load_deferred_filter().get();
+        BOOST_REQUIRE(!sst2->has_deferred_filter());
+        BOOST_REQUIRE_GT(sst2->filter_memory_size(), 0);
+        BOOST_REQUIRE(sst2->filter_has_key(*s, key.view()));
+    });
+}
+
+SEASTAR_TEST_CASE(test_bloom_filter_reclaim) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = make_shared_schema({}, some_keyspace, some_column_family,
+            {{"p1", utf8_type}}, {{"c1", utf8_type}}, {{"r1", int32_type}}, {}, utf8_type);
+
+        const column_definition& r1_col = *s->get_column_definition("r1");
+        auto make_mutation = [&] (sstring pk) {
+            mutation m(s, partition_key::from_exploded(*s, {to_bytes(pk)}));
+            m.set_clustered_cell(clustering_key::from_exploded(*s, {to_bytes("abc")}), r1_col, make_atomic_cell(int32_type, int32_type->decompose(1)));
+            return m;
+        };
+
+        env.db_config().bloom_filter_memory_threshold.set(0);
+        auto sst = make_sstable_containing(env.make_sstable(s), {make_mutation("key1")});
+        BOOST_REQUIRE(sst->has_deferred_filter());
+        BOOST_REQUIRE_EQUAL(sst->filter_memory_size(), 0);
+        BOOST_REQUIRE_EQUAL(env.manager().filter_memory(), 0);
+        BOOST_REQUIRE(sst->filter_has_key(*s, partition_key::from_exploded(*s, {to_bytes("key1")})));
+
+        // Dropping an sstable makes room for the reclaimed filters
+        env.db_config().bloom_filter_memory_threshold.set(1);
+        make_sstable_containing(env.make_sstable(s), {make_mutation("key2")});
+        REQUIRE_EVENTUALLY_EQUAL(sst->has_deferred_filter(), false);
+        BOOST_REQUIRE_GT(sst->filter_memory_size(), 0);
+        BOOST_REQUIRE_EQUAL(env.manager().filter_memory(), sst->filter_memory_size());
+    });
+}
+
 SEASTAR_TEST_CASE(datafile_generation_11) {
     return test_env::do_with_async([] (test_env& env) {
         auto s = complex_schema();
@@ -500,6 +555,132 @@ SEASTAR_TEST_CASE(check_read_indexes) {
     });
 }
 
+SEASTAR_TEST_CASE(test_summary_lower_bound) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto builder = schema_builder(ss.schema());
+        builder.set_min_index_interval(4);
+        auto s = builder.build();
+
+        auto keys = tests::generate_partition_keys(64, s);
+        std::vector<mutation> muts;
+        for (auto& dk : keys) {
+            mutation m(s, dk);
+            m.set_clustered_cell(clustering_key::from_single_value(*s, serialized(sstring("ck"))), to_bytes("v"), data_value(sstring("v")), api::new_timestamp());
+            muts.push_back(std::move(m));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(s), muts);
+        auto& summary = sst->get_summary();
+        BOOST_REQUIRE_GT(summary.entries.size(), 1);
+
+        auto check = [&] (dht::ring_position_view pos) {
+            for (size_t from = 0; from <= summary.entries.size(); ++from) {
+                auto expected = std::distance(summary.entries.begin(),
+                        std::lower_bound(summary.entries.begin() + from, summary.entries.end(), pos, index_comparator(*s)));
+                BOOST_REQUIRE_EQUAL(summary_lower_bound(summary, from, pos, *s), expected);
+            }
+        };
+        check(dht::ring_position_view::min());
+        check(dht::ring_position_view::max());
+        for (auto& dk : keys) {
+            check(dht::ring_position_view(dk));
+            check(dht::ring_position_view::starting_at(dk.token()));
+            check(dht::ring_position_view::ending_at(dk.token()));
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(test_chunk_cache) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        BOOST_REQUIRE(s->get_compressor_params().get_compressor());
+
+        auto keys = tests::generate_partition_keys(16, s);
+        std::vector<mutation> muts;
+        for (auto& dk : keys) {
+            mutation m(s, dk);
+            ss.add_row(m, ss.make_ckey(0), "v");
+            muts.push_back(std::move(m));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(s), muts);
+
+        auto& cache = chunk_cache::local();
+        cache.set_capacity(1 << 20);
+        auto disable = defer([&cache] { cache.set_capacity(0); });
+        auto hits_before = cache.get_stats().hits;
+
+        auto read = [&] (const mutation& m) {
+            auto pr = dht::partition_range::make_singular(m.decorated_key());
+            auto rd = sst->make_reader(s, env.make_reader_permit(), pr, s->full_slice());
+            auto close_rd = deferred_close(rd);
+            auto res = read_mutation_from_flat_mutation_reader(rd).get0();
+            BOOST_REQUIRE(res);
+            assert_that(*res).is_equal_to(m);
+        };
+        for (int i = 0; i < 2; ++i) {
+            for (auto& m : muts) {
+                read(m);
+            }
+        }
+        BOOST_REQUIRE_GE(cache.get_stats().hits, hits_before + muts.size());
+        BOOST_REQUIRE_GT(cache.get_stats().bytes, 0);
+
+        cache.set_capacity(0);
+        BOOST_REQUIRE_EQUAL(cache.get_stats().bytes, 0);
+    });
+}
+
+SEASTAR_TEST_CASE(test_compression_dictionary) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder(some_keyspace, some_column_family)
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("v", utf8_type)
+            .set_compressor_params(compression_parameters{compressor::create({
+                {"sstable_compression", "org.apache.cassandra.io.compress.ZstdCompressor"}
+            })})
+            .build();
+        const column_definition& v_col = *s->get_column_definition("v");
+        auto make_value = [] (int i) {
+            return format("{{\"id\": {}, \"name\": \"user-{}\", \"email\": \"user-{}@example.com\", \"status\": \"{}\"}}",
+                    i, i, i * 7, i % 3 ? "active" : "suspended");
+        };
+
+        std::vector<sstring> samples;
+        for (int i = 0; i < 4096; ++i) {
+            samples.push_back(make_value(i));
+        }
+        auto base = s->get_compressor_params().get_compressor();
+        auto dictionary = env.manager().train_compression_dictionary(*base, samples).get0();
+        BOOST_REQUIRE(dictionary);
+
+        auto keys = tests::generate_partition_keys(256, s);
+        std::vector<mutation> muts;
+        for (int i = 0; i < int(keys.size()); ++i) {
+            mutation m(s, keys[i]);
+            m.set_clustered_cell(clustering_key::make_empty(), v_col,
+                    make_atomic_cell(utf8_type, utf8_type->decompose(data_value(make_value(i)))));
+            muts.push_back(std::move(m));
+        }
+        auto cfg = env.manager().configure_writer();
+        cfg.compressor = base->with_dictionary(*dictionary);
+        auto sst = make_sstable_easy(env, make_flat_mutation_reader_from_mutations_v2(s, env.make_reader_permit(), muts), cfg,
+                sstables::get_highest_sstable_version(), muts.size());
+
+        // The reopened sstable only knows the dictionary from its CompressionInfo.
+        auto sst2 = env.reusable_sst(sst).get();
+        auto options = get_sstable_compressor(sst2->get_compression())->options();
+        BOOST_REQUIRE(options.contains("dictionary"));
+        BOOST_REQUIRE_EQUAL(options.at("dictionary"), *dictionary);
+
+        auto assertions = assert_that(sstable_reader_v2(sst2, s, env.make_reader_permit()));
+        for (auto& m : muts) {
+            assertions.produces(m);
+        }
+        assertions.produces_end_of_stream();
+    });
+}
+
 SEASTAR_TEST_CASE(check_multi_schema) {
     // Schema used to write sstable:
     // CREATE TABLE multi_schema_test (
@@ -2041,6 +2222,91 @@ SEASTAR_TEST_CASE(sstable_bad_tombstone_histogram_test) {
     });
 }
 
+SEASTAR_TEST_CASE(sstable_cardinality_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "cardinality_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type);
+        auto s = builder.build();
+
+        auto make_sstable = [&] (int first, int last) {
+            std::vector<mutation> mutations;
+            for (auto i = first; i < last; i++) {
+                auto key = partition_key::from_exploded(*s, {to_bytes("key" + to_sstring(i))});
+                mutation m(s, key);
+                m.set_clustered_cell(clustering_key::make_empty(), "value", data_value(i), api::new_timestamp());
+                mutations.push_back(std::move(m));
+            }
+            return env.reusable_sst(make_sstable_containing(env.make_sstable(s), mutations)).get0();
+        };
+        auto get_cardinality = [] (const shared_sstable& sst) {
+            auto& elements = sst->get_compaction_metadata().cardinality.elements;
+            temporary_buffer<uint8_t> bytes(elements.size());
+            std::copy(elements.begin(), elements.end(), bytes.get_write());
+            return hll::HyperLogLog::from_bytes(std::move(bytes));
+        };
+
+        auto c1 = get_cardinality(make_sstable(0, 1000));
+        auto c2 = get_cardinality(make_sstable(500, 1500));
+        BOOST_REQUIRE(c1.estimate() > 500 && c1.estimate() < 2000);
+
+        // Merging the same keys again doesn't change the estimate
+        auto estimate = c1.estimate();
+        c1.merge(c1);
+        BOOST_REQUIRE_EQUAL(c1.estimate(), estimate);
+
+        c1.merge(c2);
+        BOOST_REQUIRE(c1.estimate() >= estimate);
+        BOOST_REQUIRE(c1.estimate() > 750 && c1.estimate() < 3000);
+
+        BOOST_REQUIRE_THROW(hll::HyperLogLog::from_bytes(temporary_buffer<uint8_t>(2)), std::runtime_error);
+    });
+}
+
+SEASTAR_TEST_CASE(sstable_range_read_resume_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        std::vector<mutation> muts;
+        for (auto& dk : ss.make_pkeys(4)) {
+            mutation m(s, dk);
+            for (uint32_t ck = 0; ck < 10; ++ck) {
+                ss.add_row(m, ss.make_ckey(ck), "v");
+            }
+            muts.push_back(std::move(m));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(s), muts);
+        auto resumed_reads = [] {
+            return sstables::sstables_stats::get_shard_stats().resumed_range_partition_reads;
+        };
+
+        // Stop in the middle of the first partition, like an evicted read
+        {
+            auto rd = sst->make_reader(s, env.make_reader_permit(), query::full_partition_range, s->full_slice());
+            auto close_rd = deferred_close(rd);
+            rd.set_max_buffer_size(1);
+            auto mf = rd().get0();
+            BOOST_REQUIRE(mf && mf->is_partition_start());
+        }
+
+        // The read resuming it starts where it stopped, and reads the same
+        auto before = resumed_reads();
+        auto pr = dht::partition_range::make_starting_with({dht::ring_position(muts[0].decorated_key()), true});
+        auto assertions = assert_that(sst->make_reader(s, env.make_reader_permit(), pr, s->full_slice()));
+        for (auto& m : muts) {
+            assertions.produces(m);
+        }
+        assertions.produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(resumed_reads(), before + 1);
+
+        // The hint was consumed, and reads of other ranges don't use it
+        auto other_pr = dht::partition_range::make_starting_with({dht::ring_position(muts[1].decorated_key()), true});
+        assert_that(sst->make_reader(s, env.make_reader_permit(), other_pr, s->full_slice())).produces(muts[1]);
+        assert_that(sst->make_reader(s, env.make_reader_permit(), pr, s->full_slice())).produces(muts[0]);
+        BOOST_REQUIRE_EQUAL(resumed_reads(), before + 1);
+    });
+}
+
 SEASTAR_TEST_CASE(sstable_owner_shards) {
     return test_env::do_with_async([] (test_env& env) {
         auto builder = schema_builder("tests", "test")
@@ -3192,3 +3458,95 @@ SEASTAR_TEST_CASE(test_sstable_set_predicate) {
         }
     });
 }
+
+SEASTAR_TEST_CASE(test_sequential_scan_read_ahead) {
+    return test_env::do_with_async([] (test_env& env) {
+        env.db_config().sstable_scan_buffer_size_in_kb.set(256);
+        env.db_config().sstable_scan_read_ahead.set(1);
+
+        simple_schema ss;
+        auto s = ss.schema();
+
+        std::vector<mutation> muts;
+        for (uint32_t i = 0; i < 512; ++i) {
+            mutation m(s, ss.make_pkey(i));
+            ss.add_row(m, ss.make_ckey(0), make_random_string(1024));
+            muts.push_back(std::move(m));
+        }
+        const auto pkey = muts.front().decorated_key();
+        auto sst = make_sstable_containing(env.make_sstable(s), std::move(muts));
+
+        BOOST_REQUIRE_GT(sst->data_size(), 256 * 1024);
+        BOOST_REQUIRE(sst->is_sequential_scan(sst->data_size()));
+        BOOST_REQUIRE(!sst->is_sequential_scan(4096));
+
+        const auto& shard_stats = sstables_stats::get_shard_stats();
+        const auto scans_before = shard_stats.sequential_scans;
+
+        // Point reads keep the default read-ahead.
+        {
+            auto pr = dht::partition_range::make_singular(pkey);
+            auto rd = sst->make_reader(s, env.make_reader_permit(), pr, s->full_slice());
+            auto close_rd = deferred_close(rd);
+            BOOST_REQUIRE(read_mutation_from_flat_mutation_reader(rd).get0());
+        }
+        BOOST_REQUIRE_EQUAL(shard_stats.sequential_scans, scans_before);
+        BOOST_REQUIRE_EQUAL(sst->get_stats().sequential_scan_reads(), 0);
+
+        // Full scans use the scan read-ahead.
+        {
+            auto rd = sst->make_reader(s, env.make_reader_permit(), query::full_partition_range, s->full_slice());
+            auto close_rd = deferred_close(rd);
+            while (read_mutation_from_flat_mutation_reader(rd).get0()) { }
+        }
+        BOOST_REQUIRE_EQUAL(shard_stats.sequential_scans, scans_before + 1);
+        BOOST_REQUIRE_GT(sst->get_stats().sequential_scan_reads(), 0);
+        BOOST_REQUIRE_GE(sst->get_stats().sequential_scan_read_bytes(), sst->ondisk_data_size());
+    });
+}
+
+// Copying the raw components of an sstable, as file-level streaming does,
+// makes an identical sstable.
+SEASTAR_TEST_CASE(test_raw_component_copy) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+
+        std::vector<mutation> muts;
+        for (uint32_t i = 0; i < 64; ++i) {
+            mutation m(s, ss.make_pkey(i));
+            ss.add_row(m, ss.make_ckey(0), make_random_string(1024));
+            muts.push_back(std::move(m));
+        }
+        boost::sort(muts, mutation_decorated_key_less_comparator());
+        auto sst = make_sstable_containing(env.make_sstable(s), muts);
+
+        std::vector<component_type> components;
+        for (auto& [c, name] : sst->all_components()) {
+            if (c != component_type::TOC) {
+                components.push_back(c);
+            }
+        }
+        auto copy = env.make_sstable(s, sst->get_version());
+        copy->open_raw(components);
+        for (auto c : components) {
+            auto in = sst->make_raw_component_input_stream(c).get0();
+            auto close_in = deferred_close(in);
+            auto out = copy->make_raw_component_output_stream(c).get0();
+            auto close_out = deferred_close(out);
+            for (auto buf = in.read().get0(); !buf.empty(); buf = in.read().get0()) {
+                out.write(buf.get(), buf.size()).get();
+            }
+            out.flush().get();
+        }
+        copy->seal_sstable(false).get();
+        copy->load(s->get_sharder()).get();
+
+        BOOST_REQUIRE_EQUAL(copy->data_size(), sst->data_size());
+        auto rd = assert_that(sstable_reader_v2(copy, s, env.make_reader_permit()));
+        for (auto& m : muts) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+    });
+}
@@ -15,6 +15,7 @@
 #include "sstables/sstables.hh"
 #include "test/lib/simple_schema.hh"
 #include "test/lib/sstable_utils.hh"
+#include "test/lib/key_utils.hh"
 #include "readers/from_mutations_v2.hh"
 
 using namespace sstables;
@@ -99,3 +100,39 @@ SEASTAR_TEST_CASE(test_time_series_sstable_set_read_modify_write) {
         BOOST_REQUIRE(lookup_sst(sst2));
     });
 }
+
+SEASTAR_TEST_CASE(test_partitioned_sstable_set_select_unleveled) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto keys = tests::generate_partition_keys(20, s);
+        std::ranges::sort(keys, dht::decorated_key::less_comparator(s));
+
+        auto set = make_sstable_set(s, make_lw_shared<sstable_list>());
+        std::vector<std::pair<shared_sstable, std::pair<size_t, size_t>>> ssts;
+        std::vector<std::pair<size_t, size_t>> ranges = {{0, 19}, {0, 3}, {2, 5}, {6, 6}, {10, 15}, {4, 12}, {16, 19}, {7, 8}};
+        for (auto [first, last] : ranges) {
+            auto sst = env.make_sstable(s);
+            sstables::test(sst).set_values(keys[first].key(), keys[last].key(), {});
+            set.insert(sst);
+            ssts.emplace_back(sst, std::pair(first, last));
+        }
+        set.erase(ssts[3].first);
+        ssts.erase(ssts.begin() + 3);
+
+        for (size_t b = 0; b < keys.size(); ++b) {
+            for (size_t e = b; e < keys.size(); ++e) {
+                auto pr = dht::partition_range::make({keys[b], true}, {keys[e], true});
+                auto selected = boost::copy_range<std::set<shared_sstable>>(set.select(pr));
+                std::set<shared_sstable> expected;
+                for (auto& [sst, r] : ssts) {
+                    if (r.first <= e && r.second >= b) {
+                        expected.insert(sst);
+                    }
+                }
+                BOOST_REQUIRE(selected == expected);
+            }
+        }
+        BOOST_REQUIRE_EQUAL(set.select(query::full_partition_range).size(), ssts.size());
+    });
+}
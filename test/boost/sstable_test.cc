@@ -460,6 +460,28 @@ SEASTAR_TEST_CASE(statistics_rewrite) {
     });
 }
 
+SEASTAR_TEST_CASE(repaired_at_rewrite) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto dir = env.tempdir().path();
+        for (const auto& entry : std::filesystem::directory_iterator(uncompressed_dir().c_str())) {
+            std::filesystem::copy(entry.path(), dir / entry.path().filename());
+        }
+
+        auto sstp = env.reusable_sst(uncompressed_schema(), dir.native()).get0();
+        BOOST_REQUIRE(!sstp->is_repaired());
+        sstp->mutate_repaired_at(1700000000000).get();
+        BOOST_REQUIRE(sstp->is_repaired());
+
+        sstp = env.reusable_sst(uncompressed_schema(), dir.native()).get0();
+        BOOST_REQUIRE(sstp->is_repaired());
+        BOOST_REQUIRE_EQUAL(sstp->get_repaired_at(), 1700000000000);
+
+        sstp->mutate_repaired_at(0).get();
+        sstp = env.reusable_sst(uncompressed_schema(), dir.native()).get0();
+        BOOST_REQUIRE(!sstp->is_repaired());
+    });
+}
+
 // Tests for reading a large partition for which the index contains a
 // "promoted index", i.e., a sample of the column names inside the partition,
 // with which we can avoid reading the entire partition when we look only
@@ -774,6 +796,30 @@ SEASTAR_TEST_CASE(test_skipping_in_compressed_stream) {
     });
 }
 
+BOOST_AUTO_TEST_CASE(test_read_size_histogram_median) {
+    sstables::read_size_histogram h;
+    BOOST_REQUIRE_EQUAL(h.median(), 0);
+
+    for (int i = 0; i < 10; ++i) {
+        h.add(100);
+    }
+    // Reads smaller than the first bucket count in it.
+    BOOST_REQUIRE_EQUAL(h.median(), 1024);
+
+    for (int i = 0; i < 20; ++i) {
+        h.add(6000);
+    }
+    BOOST_REQUIRE_EQUAL(h.reads(), 30);
+    BOOST_REQUIRE_EQUAL(h.median(), 8192);
+
+    // Halving the counts keeps the distribution.
+    for (uint64_t i = h.reads(); i < sstables::read_size_histogram::max_reads; ++i) {
+        h.add(i % 3 ? 6000 : 100);
+    }
+    BOOST_REQUIRE_LT(h.reads(), sstables::read_size_histogram::max_reads);
+    BOOST_REQUIRE_EQUAL(h.median(), 8192);
+}
+
 // Test that sstables::key_view::tri_compare(const schema& s, partition_key_view other)
 // should correctly compare empty keys. The fact we did this incorrectly was
 // noticed while fixing #9375, and a separate issue on it is #10178.
@@ -8,13 +8,19 @@
 
 
 #include <seastar/core/thread.hh>
+#include <seastar/core/when_all.hh>
+#include <seastar/util/defer.hh>
 #include "test/lib/scylla_test_case.hh"
 #include "query-result-writer.hh"
 
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/mutation_source_test.hh"
 #include "test/lib/result_set_assertions.hh"
+#include "test/lib/cql_assertions.hh"
 #include "service/storage_proxy.hh"
+#include "db/consistency_level.hh"
+#include "gms/gossiper.hh"
+#include "replica/database.hh"
 #include "query_ranges_to_vnodes.hh"
 #include "partition_slice_builder.hh"
 #include "schema/schema_builder.hh"
@@ -133,3 +139,101 @@ SEASTAR_THREAD_TEST_CASE(test_split_stats) {
     stats1->register_metrics_for("DC1", ep1);
     stats2->register_metrics_for("DC1", ep1);
 }
+
+// Writes to other shards are batched, see storage_proxy::cross_shard_writes.
+SEASTAR_TEST_CASE(test_cross_shard_writes) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.t (pk int PRIMARY KEY, v int)").get();
+        auto s = e.local_db().find_schema("ks", "t");
+        auto& proxy = e.get_storage_proxy().local();
+        auto sg = create_scheduling_group("cross_shard_writes", 100).get();
+        auto destroy_sg = defer([&sg] () noexcept { destroy_scheduling_group(sg).get(); });
+
+        // Enough writes for several batches per shard, from two scheduling groups.
+        // Every third write is already timed out, and must fail alone.
+        const int32_t nr_writes = 300;
+        std::vector<mutation> mutations;
+        for (int32_t pk = 0; pk < nr_writes; ++pk) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(pk)));
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("v"), data_value(pk), api::new_timestamp());
+            mutations.push_back(std::move(m));
+        }
+        std::vector<future<>> writes;
+        for (int32_t pk = 0; pk < nr_writes; ++pk) {
+            auto timeout = pk % 3 ? db::no_timeout : db::timeout_clock::now() - std::chrono::seconds(1);
+            auto write = [&, pk, timeout] {
+                return proxy.mutate_locally(mutations[pk], nullptr, db::commitlog::force_sync::no, timeout);
+            };
+            writes.push_back(pk % 2 ? with_scheduling_group(sg, write) : write());
+        }
+        auto results = when_all(writes.begin(), writes.end()).get();
+        for (int32_t pk = 0; pk < nr_writes; ++pk) {
+            if (pk % 3) {
+                BOOST_REQUIRE(!results[pk].failed());
+            } else {
+                BOOST_REQUIRE_THROW(results[pk].get(), timed_out_error);
+            }
+        }
+
+        // The reads are executed by the shard owning the partition.
+        for (int32_t pk = 0; pk < nr_writes; ++pk) {
+            auto rows = e.execute_cql(format("SELECT v FROM ks.t WHERE pk = {}", pk)).get();
+            if (pk % 3) {
+                assert_that(rows).is_rows().with_rows({{int32_type->decompose(pk)}});
+            } else {
+                assert_that(rows).is_rows().is_empty();
+            }
+        }
+    });
+}
+
+// Replicas suspected to be dead by the direct failure detector are picked last,
+// also by the cache hit-rate based selection and by the client preference.
+SEASTAR_TEST_CASE(test_filter_for_query_demotes_suspected_replicas) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.t (pk int PRIMARY KEY, v int)").get();
+        auto& cf = e.local_db().find_column_family("ks", "t");
+        auto erm = cf.get_effective_replication_map();
+        auto& gossiper = e.gossiper().local();
+
+        // The suspected replica has the best hit rate, so it is the one the
+        // hit-rate based selection prefers the most.
+        auto suspected = gms::inet_address("127.0.0.2");
+        auto healthy_hot = gms::inet_address("127.0.0.3");
+        auto healthy_cold = gms::inet_address("127.0.0.4");
+        cf.set_hit_rate(suspected, cache_temperature(0.9f));
+        cf.set_hit_rate(healthy_hot, cache_temperature(0.9f));
+        cf.set_hit_rate(healthy_cold, cache_temperature(0.1f));
+        const inet_address_vector_replica_set live_endpoints{suspected, healthy_hot, healthy_cold};
+        noncopyable_function<bool (const gms::inet_address&)> is_suspected_dead = [&] (const gms::inet_address& ep) {
+            return ep == suspected;
+        };
+
+        bool picked_suspected_unfiltered = false;
+        for (int i = 0; i < 100; ++i) {
+            std::optional<gms::inet_address> extra;
+            auto selected = db::filter_for_query(db::consistency_level::ONE, *erm, live_endpoints, {},
+                    db::read_repair_decision::NONE, gossiper, &extra, &cf, nullptr, is_suspected_dead);
+            BOOST_REQUIRE_EQUAL(selected.size(), 1);
+            BOOST_REQUIRE(selected.front() != suspected);
+            BOOST_REQUIRE(extra);
+            BOOST_REQUIRE(*extra != suspected);
+
+            selected = db::filter_for_query(db::consistency_level::ONE, *erm, live_endpoints, {},
+                    db::read_repair_decision::NONE, gossiper, nullptr, &cf);
+            picked_suspected_unfiltered = picked_suspected_unfiltered || selected.front() == suspected;
+        }
+        // Check the test exercises the hit-rate based selection.
+        BOOST_REQUIRE(picked_suspected_unfiltered);
+
+        // The suspected replica is still picked when the consistency level needs it.
+        auto selected = db::filter_for_query(db::consistency_level::ONE, *erm, {suspected}, {},
+                db::read_repair_decision::NONE, gossiper, nullptr, &cf, nullptr, is_suspected_dead);
+        BOOST_REQUIRE(selected == inet_address_vector_replica_set{suspected});
+
+        // A preferred replica which is suspected loses its preference.
+        selected = db::filter_for_query(db::consistency_level::ONE, *erm, live_endpoints, {suspected, healthy_cold},
+                db::read_repair_decision::NONE, gossiper, nullptr, &cf, nullptr, is_suspected_dead);
+        BOOST_REQUIRE(selected == inet_address_vector_replica_set{healthy_cold});
+    });
+}
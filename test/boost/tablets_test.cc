@@ -427,3 +427,67 @@ SEASTAR_THREAD_TEST_CASE(test_token_ownership_splitting) {
         }
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_tablet_split_and_merge) {
+    auto h1 = host_id(utils::UUID_gen::get_time_UUID());
+    auto h2 = host_id(utils::UUID_gen::get_time_UUID());
+    auto h3 = host_id(utils::UUID_gen::get_time_UUID());
+
+    tablet_map tmap(2);
+    auto tid0 = tmap.first_tablet();
+    auto tid1 = *tmap.next_tablet(tid0);
+    tmap.set_tablet(tid0, tablet_info {
+        tablet_replica_set {
+            tablet_replica {h1, 0},
+            tablet_replica {h2, 3},
+        }
+    });
+    tmap.set_tablet(tid1, tablet_info {
+        tablet_replica_set {
+            tablet_replica {h2, 1},
+            tablet_replica {h3, 2},
+        }
+    });
+    BOOST_REQUIRE(!tmap.can_merge());
+    BOOST_REQUIRE_THROW(tmap.merge(), std::logic_error);
+
+    auto split = tmap.split();
+    BOOST_REQUIRE_EQUAL(split.tablet_count(), 4);
+    for (tablet_id id : split.tablet_ids()) {
+        auto parent = tablet_id(size_t(id) / 2);
+        BOOST_REQUIRE(split.get_tablet_info(id) == tmap.get_tablet_info(parent));
+        // Every token stays on the same replicas.
+        BOOST_REQUIRE_EQUAL(tmap.get_tablet_id(split.get_first_token(id)), parent);
+        BOOST_REQUIRE_EQUAL(tmap.get_tablet_id(split.get_last_token(id)), parent);
+    }
+    BOOST_REQUIRE_EQUAL(split.get_last_token(tablet_id(1)), tmap.get_last_token(tid0));
+    BOOST_REQUIRE_EQUAL(split.get_last_token(tablet_id(3)), tmap.get_last_token(tid1));
+
+    BOOST_REQUIRE(split.can_merge());
+    BOOST_REQUIRE_EQUAL(split.merge(), tmap);
+
+    uint64_t target = 1000;
+    BOOST_REQUIRE_EQUAL(decide_tablet_resize(split, 4 * target, target), tablet_resize::none);
+    BOOST_REQUIRE_EQUAL(decide_tablet_resize(split, 4 * 2 * target + 4, target), tablet_resize::split);
+    BOOST_REQUIRE_EQUAL(decide_tablet_resize(split, 4 * target / 2 - 4, target), tablet_resize::merge);
+    BOOST_REQUIRE_EQUAL(decide_tablet_resize(tmap, 0, target), tablet_resize::none);
+
+    // Siblings with different replicas can't be merged.
+    split.set_tablet(tablet_id(3), tablet_info {
+        tablet_replica_set {
+            tablet_replica {h3, 2},
+            tablet_replica {h1, 1},
+        }
+    });
+    BOOST_REQUIRE(!split.can_merge());
+
+    // ...nor can tablets in transition be split.
+    tmap.set_tablet_transition_info(tid0, tablet_transition_info {
+        tablet_replica_set {
+            tablet_replica {h1, 0},
+            tablet_replica {h3, 3},
+        },
+        tablet_replica {h3, 3}
+    });
+    BOOST_REQUIRE_THROW(tmap.split(), std::logic_error);
+}
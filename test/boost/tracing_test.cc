@@ -87,3 +87,46 @@ SEASTAR_TEST_CASE(tracing_slow_query_fast_mode) {
         return make_ready_future<>();
     });
 }
+
+SEASTAR_TEST_CASE(tracing_sampled_sessions_in_memory) {
+    return do_with_tracing_env([](auto &e) {
+        tracing::tracing &t = tracing::tracing::get_local_tracing_instance();
+        t.set_sampled_sessions_in_memory();
+        BOOST_CHECK(t.get_sampled_sessions().empty());
+
+        tracing::trace_state_props_set trace_props;
+        trace_props.set(tracing::trace_state_props::full_tracing);
+
+        auto run_session = [&] (tracing::trace_state_props_set props) {
+            tracing::trace_state_ptr trace_state = t.create_session(tracing::trace_type::QUERY, props);
+            tracing::begin(trace_state, "SELECT * FROM ks.t", gms::inet_address("127.0.0.1"));
+            tracing::trace(trace_state, "trace 1");
+            tracing::trace(trace_state, "trace 2");
+            return trace_state->session_id();
+        };
+
+        auto id = run_session(trace_props);
+        auto recs = t.get_sampled_sessions();
+        BOOST_REQUIRE_EQUAL(recs.size(), 1);
+        BOOST_CHECK_EQUAL(recs[0].session_id, id);
+        BOOST_CHECK_EQUAL(recs[0].request_view(), "SELECT * FROM ks.t");
+        BOOST_CHECK_EQUAL(recs[0].events, 2);
+        BOOST_CHECK(recs[0].primary);
+
+        // Sessions requested by the client are written to the tables
+        auto client_props = trace_props;
+        client_props.set(tracing::trace_state_props::write_on_close);
+        run_session(client_props);
+        BOOST_CHECK_EQUAL(t.get_sampled_sessions().size(), 1);
+
+        // The oldest sessions are overwritten once the buffer is full
+        for (size_t i = 0; i < tracing::tracing::max_sampled_sessions; ++i) {
+            id = run_session(trace_props);
+        }
+        recs = t.get_sampled_sessions();
+        BOOST_REQUIRE_EQUAL(recs.size(), tracing::tracing::max_sampled_sessions);
+        BOOST_CHECK_EQUAL(recs.back().session_id, id);
+
+        return make_ready_future<>();
+    });
+}
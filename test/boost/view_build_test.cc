@@ -304,6 +304,40 @@ SEASTAR_TEST_CASE(test_builder_across_tokens_with_small_partitions) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_builder_with_concurrent_batches) {
+    cql_test_config test_cfg;
+    test_cfg.db_config->view_building_concurrency(8);
+    test_cfg.db_config->view_building_throughput_mb_per_sec(100);
+
+    do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
+
+        // Small partitions make for many batches, and a large one for batches of a single partition.
+        for (auto i = 0; i < 1000; ++i) {
+            e.execute_cql(format("insert into cf (p, c, v) values ({:d}, {:d}, 0)", i, i)).get();
+        }
+        for (auto i = 0; i < 1000; ++i) {
+            e.execute_cql(format("insert into cf (p, c, v) values (-1, {:d}, 0)", i)).get();
+        }
+
+        auto f1 = e.local_view_builder().wait_until_built("ks", "vcf1");
+        auto f2 = e.local_view_builder().wait_until_built("ks", "vcf2");
+        e.execute_cql("create materialized view vcf1 as select * from cf "
+                      "where p is not null and c is not null and v is not null "
+                      "primary key (v, c, p)").get();
+        e.execute_cql("create materialized view vcf2 as select * from cf "
+                      "where p is not null and c is not null and v is not null "
+                      "primary key (v, p, c)").get();
+        f1.get();
+        f2.get();
+
+        for (auto view : {"vcf1", "vcf2"}) {
+            auto msg = e.execute_cql(format("select count(*) from {} where v = 0", view)).get0();
+            assert_that(msg).is_rows().with_rows({{{long_type->decompose(2000L)}}});
+        }
+    }, std::move(test_cfg)).get();
+}
+
 SEASTAR_TEST_CASE(test_builder_with_tombstones) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         e.execute_cql("create table cf (p int, c1 int, c2 int, v int, primary key (p, c1, c2))").get();
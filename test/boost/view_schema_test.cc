@@ -9,6 +9,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/irange.hpp>
 #include <fmt/ostream.h>
 #include <fmt/ranges.h>
 #include "replica/database.hh"
@@ -2582,6 +2583,16 @@ SEASTAR_THREAD_TEST_CASE(node_view_update_backlog) {
     BOOST_REQUIRE(b.load() == backlog(100));
 }
 
+SEASTAR_THREAD_TEST_CASE(view_update_backlog_above) {
+    auto backlog = db::view::update_backlog{900, 1000};
+    BOOST_REQUIRE_EQUAL(backlog.above(0.8).current, 100u);
+    BOOST_REQUIRE_EQUAL(backlog.above(0.8).max, 200u);
+    BOOST_REQUIRE_EQUAL(backlog.above(0.8).relative_size(), 0.5);
+    BOOST_REQUIRE_EQUAL(db::view::update_backlog{500, 1000}.above(0.8).relative_size(), 0);
+    BOOST_REQUIRE_EQUAL(backlog.above(0).relative_size(), backlog.relative_size());
+    BOOST_REQUIRE(db::view::update_backlog::no_backlog().above(0.8).relative_size() == 0);
+}
+
 SEASTAR_TEST_CASE(hide_ttl_and_writetime_for_virtual_columns) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         e.execute_cql("CREATE TABLE t (k int, c int, a int, b int, e int, f int, g int, primary key(k, c))").get();
@@ -3162,3 +3173,38 @@ SEASTAR_TEST_CASE(test_mv_allow_some_column_drops) {
         BOOST_REQUIRE_THROW(e.execute_cql("alter table cf2 drop d").get(), exceptions::invalid_request_exception);
     });
 }
+
+// Concurrent writes to the same partition share the read of the existing
+// base rows, and still generate the right view updates.
+SEASTAR_TEST_CASE(test_view_update_read_coalescing) {
+    auto cfg = make_shared<db::config>();
+    cfg->view_update_read_coalescing_window_in_us(100000);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
+        e.execute_cql("create materialized view vcf as select * from cf "
+                      "where p is not null and c is not null and v is not null "
+                      "primary key (v, p, c)").get();
+        const int rows = 10;
+        for (int c = 0; c < rows; ++c) {
+            e.execute_cql(format("insert into cf (p, c, v) values (0, {}, {})", c, c)).get();
+        }
+
+        parallel_for_each(boost::irange(0, rows), [&e] (int c) {
+            return e.execute_cql(format("update cf set v = {} where p = 0 and c = {}", c + rows, c)).discard_result();
+        }).get();
+
+        auto coalesced = e.db().map_reduce0([] (replica::database& db) {
+            return db.cf_stats()->coalesced_view_update_reads;
+        }, uint64_t(0), std::plus<uint64_t>()).get0();
+        BOOST_REQUIRE_GT(coalesced, 0);
+
+        eventually([&] {
+            for (int c = 0; c < rows; ++c) {
+                auto msg = e.execute_cql(format("select c from vcf where v = {}", c)).get0();
+                assert_that(msg).is_rows().is_empty();
+                msg = e.execute_cql(format("select c from vcf where v = {}", c + rows)).get0();
+                assert_that(msg).is_rows().with_rows({{ {int32_type->decompose(c)} }});
+            }
+        });
+    }, cfg);
+}
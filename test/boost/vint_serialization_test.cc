@@ -14,8 +14,11 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstdint>
+#include <limits>
 #include <random>
 
 using namespace seastar;
@@ -106,6 +109,20 @@ BOOST_AUTO_TEST_CASE(sanity_unsigned_sweep) {
     check_roundtrip_sweep<unsigned_vint>(100'000, random_engine());
 }
 
+BOOST_AUTO_TEST_CASE(sanity_unsigned_sizes) {
+    // The boundaries of every encoded size
+    for (unsigned bits = 0; bits < 64; ++bits) {
+        for (uint64_t value : {(uint64_t(1) << bits) - 1, uint64_t(1) << bits, (uint64_t(1) << bits) + 1}) {
+            const auto expected_size = std::min<vint_size_type>(9, std::max<vint_size_type>(1, (std::bit_width(value) + 6) / 7));
+            check_bytes_and_roundtrip<unsigned_vint>(value, [&] (bytes_view v) {
+                BOOST_REQUIRE_EQUAL(v.size(), expected_size);
+                BOOST_REQUIRE_EQUAL(unsigned_vint::serialized_size(value), expected_size);
+            });
+        }
+    }
+    check_roundtrip<unsigned_vint>(std::numeric_limits<uint64_t>::max());
+}
+
 BOOST_AUTO_TEST_CASE(sanity_signed_examples) {
     using vint = signed_vint;
 
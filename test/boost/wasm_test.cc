@@ -14,6 +14,7 @@
 #include <seastar/core/lowres_clock.hh>
 #include "test/lib/scylla_test_case.hh"
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/thread.hh>
 
 SEASTAR_TEST_CASE(test_long_udf_yields) {
     auto wasm_engine = wasmtime::create_engine(1024 * 1024);
@@ -101,3 +102,43 @@ SEASTAR_TEST_CASE(test_long_udf_yields) {
     BOOST_CHECK_EQUAL(rets->pop_val()->i64(), 267914296);
     co_return;
 }
+
+SEASTAR_TEST_CASE(test_prewarmed_instance_is_reused) {
+    auto wasm_engine = wasmtime::create_engine(1024 * 1024);
+    wasm::alien_thread_runner alien_runner;
+    auto wasm_cache = std::make_unique<wasm::instance_cache>(100 * 1024 * 1024, 1024 * 1024, std::chrono::seconds(1));
+    auto wasm_ctx = wasm::context(*wasm_engine, "inc", *wasm_cache, 100000, 100000000000);
+    co_await wasm::precompile(alien_runner, wasm_ctx, {}, R"(
+(module
+  (type (;0;) (func (param i64) (result i64)))
+  (func (;0;) (type 0) (param i64) (result i64)
+    local.get 0
+    i64.const 1
+    i64.add)
+  (memory (;0;) 2)
+  (global (;0;) i32 (i32.const 1024))
+  (export "memory" (memory 0))
+  (export "inc" (func 0))
+  (export "_scylla_abi" (global 0))
+  (data (;0;) (i32.const 1024) "01"))
+)");
+    db::functions::function_name name("ks", "inc");
+    std::vector<data_type> arg_types{long_type};
+    auto& stats = wasm_cache->shard_stats();
+    auto misses = stats.cache_misses;
+    auto hits = stats.cache_hits;
+
+    co_await wasm_cache->prewarm(name, arg_types, wasm_ctx);
+    BOOST_REQUIRE_EQUAL(stats.cache_misses, misses + 1);
+
+    std::vector<bytes_opt> params{long_type->decompose(int64_t(41))};
+    auto ret = co_await seastar::async([&] {
+        return wasm::run_script(name, wasm_ctx, arg_types, params, long_type, false).get0();
+    });
+    BOOST_REQUIRE_EQUAL(value_cast<int64_t>(long_type->deserialize(*ret)), 42);
+    BOOST_REQUIRE_EQUAL(stats.cache_misses, misses + 1);
+    BOOST_REQUIRE_EQUAL(stats.cache_hits, hits + 1);
+
+    wasm_cache->remove(name, arg_types);
+    co_await wasm_cache->stop();
+}
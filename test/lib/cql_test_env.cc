@@ -646,6 +646,10 @@ class single_node_cql_env : public cql_test_env {
                     .available_memory = dbcfg.available_memory,
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
+                    .subrange_parallelism = cfg->compaction_subrange_parallelism,
+                    .leveled_parallelism = cfg->compaction_leveled_parallelism,
+                    .latency_sensitive_sched_group = dbcfg.statement_scheduling_group,
+                    .latency_target_us = cfg->compaction_latency_target_us,
                 };
             });
             cm.start(std::move(get_cm_cfg), std::ref(abort_sources), std::ref(task_manager)).get();
@@ -683,7 +687,7 @@ class single_node_cql_env : public cql_test_env {
             if (cfg_in.qp_mcfg) {
                 qp_mcfg = *cfg_in.qp_mcfg;
             } else {
-                qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560};
+                qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560, memory::stats().total_memory() / 2560};
             }
             auto local_data_dict = seastar::sharded_parameter([] (const replica::database& db) { return db.as_data_dictionary(); }, std::ref(db));
 
@@ -792,7 +796,8 @@ class single_node_cql_env : public cql_test_env {
             });
 
             raft_gr.start(cfg->consistent_cluster_management(),
-                std::ref(raft_address_map), std::ref(ms), std::ref(gossiper), std::ref(fd)).get();
+                std::ref(raft_address_map), std::ref(ms), std::ref(gossiper), std::ref(fd),
+                std::chrono::milliseconds(cfg->direct_failure_detector_min_threshold_in_ms())).get();
             auto stop_raft_gr = deferred_stop(raft_gr);
 
             stream_manager.start(std::ref(*cfg), std::ref(db), std::ref(sys_dist_ks), std::ref(view_update_generator), std::ref(ms), std::ref(mm), std::ref(gossiper), scheduling_groups.streaming_scheduling_group).get();
@@ -75,6 +75,14 @@ class size_calculator {
         std::cout << "\n";
 
         std::cout << prefix() << "sizeof(atomic_cell_or_collection) = " << sizeof(atomic_cell_or_collection) << "\n";
+        {
+            // Bytes, including the timestamp, stored in each cell besides its value
+            auto live = atomic_cell::make_live(*bytes_type, 1, bytes_view());
+            auto live_with_ttl = atomic_cell::make_live(*bytes_type, 1, bytes_view(), gc_clock::now(), gc_clock::duration(1));
+            nest n;
+            std::cout << prefix() << "live cell header size = " << live.serialize().size() << "\n";
+            std::cout << prefix() << "live cell with ttl header size = " << live_with_ttl.serialize().size() << "\n";
+        }
         std::cout << prefix() << "btree::linear_node_size(1) = " << mutation_partition::rows_type::node::linear_node_size(1) << "\n";
         std::cout << prefix() << "btree::inner_node_size = " << mutation_partition::rows_type::node::inner_node_size << "\n";
         std::cout << prefix() << "btree::leaf_node_size = " << mutation_partition::rows_type::node::leaf_node_size << "\n";
@@ -54,6 +54,15 @@ operator<<(std::ostream& os, const perf_result& result) {
     return os;
 }
 
+std::ostream& operator<<(std::ostream& os, const utils::precise_time_estimated_histogram& latencies) {
+    auto to_ms = [] (uint64_t micros) {
+        return float(micros) / 1e3;
+    };
+    fmt::print(os, "{{50%: {:.3f} [ms], 99%: {:.3f} [ms], 99.9%: {:.3f} [ms], max: {:.3f} [ms]}}",
+            to_ms(latencies.percentile(0.5)), to_ms(latencies.percentile(0.99)), to_ms(latencies.percentile(0.999)), to_ms(latencies.max()));
+    return os;
+}
+
 aio_writes_result_mixin::aio_writes_result_mixin()
     : aio_writes(engine().get_io_stats().aio_writes)
     , aio_write_bytes(engine().get_io_stats().aio_write_bytes)
@@ -13,6 +13,9 @@
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
 #include <seastar/coroutine/as_future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
 #include "seastarx.hh"
 #include "utils/extremum_tracking.hh"
 #include "utils/estimated_histogram.hh"
@@ -22,6 +25,7 @@
 
 #include <chrono>
 #include <iosfwd>
+#include <random>
 #include <boost/range/irange.hpp>
 
 template <typename Func>
@@ -225,6 +229,153 @@ std::vector<perf_result> time_parallel(Func func, unsigned concurrency_per_core,
     return time_parallel_ex<perf_result>(std::move(func), concurrency_per_core, iterations, operations_per_shard, stop_on_error);
 }
 
+struct open_loop_shard_stats {
+    executor_shard_stats stats;
+    utils::precise_time_estimated_histogram latencies;
+};
+
+inline
+open_loop_shard_stats
+operator+(open_loop_shard_stats a, const open_loop_shard_stats& b) {
+    a.stats = a.stats + b.stats;
+    a.latencies.merge(b.latencies);
+    return a;
+}
+
+// Drives an open-loop load of given asynchronous action until a deadline:
+// calls start at Poisson-distributed arrival times, at the given average
+// rate, without waiting for the previous calls to complete, unless
+// max_in_flight calls are pending.
+//
+// Latencies are measured from the intended arrival of each call rather than
+// from its actual start, so that calls delayed by the in-flight limit or a
+// busy reactor account for the queueing they suffered, instead of being
+// omitted as they are by closed-loop measurements (coordinated omission).
+template <typename Func>
+class open_loop_executor {
+    using clock = std::chrono::steady_clock;
+
+    const Func _func;
+    const double _rate;
+    const clock::time_point _end_at;
+    const bool _stop_on_error;
+    semaphore _in_flight;
+    gate _pending;
+    std::default_random_engine _rng{std::random_device()()};
+    uint64_t _count = 0;
+    uint64_t _errors = 0;
+    std::exception_ptr _ex;
+    utils::precise_time_estimated_histogram _latencies;
+    linux_perf_event _instructions_retired_counter = linux_perf_event::user_instructions_retired();
+private:
+    executor_shard_stats executor_shard_stats_snapshot() {
+        return executor_shard_stats{
+            .invocations = _count,
+            .allocations = perf_mallocs(),
+            .tasks_executed = perf_tasks_processed(),
+            .instructions_retired = _instructions_retired_counter.read(),
+            .errors = _errors,
+        };
+    }
+
+    future<> issue(clock::time_point intended, semaphore_units<> units) {
+        ++_count;
+        future<> f = co_await coroutine::as_future(_func());
+        _latencies.add(clock::now() - intended);
+        if (f.failed()) {
+            ++_errors;
+            auto ex = f.get_exception();
+            if (_stop_on_error && !_ex) {
+                _ex = std::move(ex);
+            }
+        }
+    }
+
+    future<> run_arrivals() {
+        std::exponential_distribution<double> interval(_rate);
+        auto next = clock::now();
+        while (!_ex) {
+            next += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(interval(_rng)));
+            if (next >= _end_at) {
+                break;
+            }
+            // Calls which are late are issued right away, to catch up
+            auto now = clock::now();
+            if (next > now) {
+                co_await seastar::sleep(next - now);
+            }
+            auto units = co_await get_units(_in_flight, 1);
+            // The gate is closed only once no more calls are issued
+            (void)with_gate(_pending, [this, next, units = std::move(units)] () mutable {
+                return issue(next, std::move(units));
+            });
+        }
+        co_await _pending.close();
+        if (_ex) {
+            co_await coroutine::return_exception_ptr(std::move(_ex));
+        }
+    }
+public:
+    open_loop_executor(double rate, unsigned max_in_flight, Func func, clock::time_point end_at, bool stop_on_error = true)
+            : _func(std::move(func))
+            , _rate(rate)
+            , _end_at(end_at)
+            , _stop_on_error(stop_on_error)
+            , _in_flight(max_in_flight)
+    { }
+
+    future<open_loop_shard_stats> run() {
+        auto stats_start = executor_shard_stats_snapshot();
+        _instructions_retired_counter.enable();
+        co_await run_arrivals();
+        _instructions_retired_counter.disable();
+        co_return open_loop_shard_stats{executor_shard_stats_snapshot() - stats_start, _latencies};
+    }
+
+    future<> stop() {
+        return make_ready_future<>();
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const utils::precise_time_estimated_histogram& latencies);
+
+/**
+ * Like time_parallel(), but for an open-loop load of rate_per_core calls
+ * per second on each core, with at most max_in_flight_per_core of them
+ * pending. Prints the latency percentiles of each iteration along with its
+ * throughput.
+ */
+template <typename Func>
+static
+std::vector<perf_result> time_open_loop(Func func, double rate_per_core, unsigned max_in_flight_per_core, int iterations = 5, bool stop_on_error = true) {
+    using clk = std::chrono::steady_clock;
+    std::vector<perf_result> results;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = clk::now();
+        auto end_at = start + std::chrono::seconds(1);
+        distributed<open_loop_executor<Func>> exec;
+        perf_result result;
+        exec.start(rate_per_core, max_in_flight_per_core, func, end_at, stop_on_error).get();
+        auto stop_exec = defer([&exec] {
+            exec.stop().get();
+        });
+        auto stats = exec.map_reduce0(std::mem_fn(&open_loop_executor<Func>::run),
+                open_loop_shard_stats(), std::plus<open_loop_shard_stats>()).get0();
+        auto end = clk::now();
+        auto duration = std::chrono::duration<double>(end - start).count();
+
+        result.throughput = static_cast<double>(stats.stats.invocations) / duration;
+        result.mallocs_per_op = double(stats.stats.allocations) / stats.stats.invocations;
+        result.tasks_per_op = double(stats.stats.tasks_executed) / stats.stats.invocations;
+        result.instructions_per_op = double(stats.stats.instructions_retired) / stats.stats.invocations;
+        result.errors = stats.stats.errors;
+
+        std::cout << result << ", latency " << stats.latencies << std::endl;
+        results.emplace_back(result);
+    }
+    return results;
+}
+
 template<typename Func>
 auto duration_in_seconds(Func&& f) {
     using clk = std::chrono::steady_clock;
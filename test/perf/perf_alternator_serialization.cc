@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/perf_tests.hh>
+
+#include "alternator/serialization.hh"
+#include "utils/rjson.hh"
+
+// Conversions between the JSON attribute values of requests and responses
+// and the cell values they are stored as.
+class alternator_serialization {
+    rjson::value _string = rjson::parse(R"({"S":"abcdefghijklmnopqrstuvwxyz0123456789"})");
+    rjson::value _number = rjson::parse(R"({"N":"1234567.89"})");
+    rjson::value _boolean = rjson::parse(R"({"BOOL":true})");
+    rjson::value _list = rjson::parse(R"({"L":[{"S":"a"},{"N":"1"},{"BOOL":false},{"S":"abcdefghijklmnopqrstuvwxyz"}]})");
+    bytes _string_cell = alternator::serialize_item(_string);
+    bytes _number_cell = alternator::serialize_item(_number);
+    bytes _boolean_cell = alternator::serialize_item(_boolean);
+    bytes _list_cell = alternator::serialize_item(_list);
+public:
+    const rjson::value& string() const { return _string; }
+    const rjson::value& number() const { return _number; }
+    const rjson::value& boolean() const { return _boolean; }
+    const rjson::value& list() const { return _list; }
+    bytes_view string_cell() const { return _string_cell; }
+    bytes_view number_cell() const { return _number_cell; }
+    bytes_view boolean_cell() const { return _boolean_cell; }
+    bytes_view list_cell() const { return _list_cell; }
+};
+
+PERF_TEST_F(alternator_serialization, serialize_string) {
+    perf_tests::do_not_optimize(alternator::serialize_item(string()));
+}
+
+PERF_TEST_F(alternator_serialization, serialize_number) {
+    perf_tests::do_not_optimize(alternator::serialize_item(number()));
+}
+
+PERF_TEST_F(alternator_serialization, serialize_boolean) {
+    perf_tests::do_not_optimize(alternator::serialize_item(boolean()));
+}
+
+PERF_TEST_F(alternator_serialization, serialize_list) {
+    perf_tests::do_not_optimize(alternator::serialize_item(list()));
+}
+
+PERF_TEST_F(alternator_serialization, deserialize_string) {
+    perf_tests::do_not_optimize(alternator::deserialize_item(string_cell()));
+}
+
+PERF_TEST_F(alternator_serialization, deserialize_number) {
+    perf_tests::do_not_optimize(alternator::deserialize_item(number_cell()));
+}
+
+PERF_TEST_F(alternator_serialization, deserialize_boolean) {
+    perf_tests::do_not_optimize(alternator::deserialize_item(boolean_cell()));
+}
+
+PERF_TEST_F(alternator_serialization, deserialize_list) {
+    perf_tests::do_not_optimize(alternator::deserialize_item(list_cell()));
+}
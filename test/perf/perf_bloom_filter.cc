@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "utils/bloom_filter.hh"
+#include "utils/bloom_calculations.hh"
+#include "test/lib/random_utils.hh"
+
+#include <seastar/testing/perf_tests.hh>
+
+// Compares the classic and the split-block bloom filters at the same
+// target false-positive rate. The filters are large enough not to fit
+// in the CPU caches, as is the case for the filters of a real node.
+struct bloom_filter_test {
+    static constexpr int64_t nr_keys = 4'000'000;
+    static constexpr size_t nr_probes = 1000;
+    static constexpr double fp_chance = 0.01;
+
+    utils::filter_ptr classic;
+    utils::filter_ptr split_block;
+    std::vector<utils::hashed_key> absent;
+    std::vector<utils::hashed_key> present;
+
+    static bytes make_key(int64_t i) {
+        return bytes(reinterpret_cast<const int8_t*>(&i), sizeof(i));
+    }
+
+    bloom_filter_test() {
+        auto buckets_per_element = bloom_calculations::max_buckets_per_element(nr_keys);
+        auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, fp_chance);
+        classic = utils::filter::create_filter(spec.K, nr_keys, spec.buckets_per_element, utils::filter_format::m_format);
+        split_block = utils::filter::create_split_block_filter(nr_keys, fp_chance);
+        for (int64_t i = 0; i < nr_keys; ++i) {
+            auto k = make_key(i);
+            classic->add(k);
+            split_block->add(k);
+        }
+        for (size_t i = 0; i < nr_probes; ++i) {
+            present.push_back(utils::make_hashed_key(make_key(tests::random::get_int<int64_t>(0, nr_keys - 1))));
+            absent.push_back(utils::make_hashed_key(make_key(nr_keys + tests::random::get_int<int64_t>(0, nr_keys))));
+        }
+        auto false_positives = [&] (utils::i_filter& f) {
+            size_t n = 0;
+            for (int64_t i = nr_keys; i < 2 * nr_keys; ++i) {
+                n += f.is_present(make_key(i));
+            }
+            return double(n) / nr_keys;
+        };
+        fmt::print("classic: {} bytes, fp rate {:.5f}; split-block: {} bytes, fp rate {:.5f}\n",
+                classic->memory_size(), false_positives(*classic),
+                split_block->memory_size(), false_positives(*split_block));
+    }
+
+    size_t probe(utils::i_filter& f, const std::vector<utils::hashed_key>& keys) {
+        size_t n = 0;
+        for (auto& k : keys) {
+            n += f.is_present(k);
+        }
+        perf_tests::do_not_optimize(n);
+        return keys.size();
+    }
+};
+
+PERF_TEST_F(bloom_filter_test, classic_absent) {
+    return probe(*classic, absent);
+}
+
+PERF_TEST_F(bloom_filter_test, split_block_absent) {
+    return probe(*split_block, absent);
+}
+
+PERF_TEST_F(bloom_filter_test, classic_present) {
+    return probe(*classic, present);
+}
+
+PERF_TEST_F(bloom_filter_test, split_block_present) {
+    return probe(*split_block, present);
+}
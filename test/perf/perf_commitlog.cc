@@ -29,6 +29,7 @@
 #include "db/config.hh"
 #include "db/extensions.hh"
 #include "db/commitlog/commitlog.hh"
+#include "utils/estimated_histogram.hh"
 #include "utils/UUID_gen.hh"
 
 struct test_config {
@@ -41,6 +42,9 @@ struct test_config {
 
     uint64_t min_flush_delay_in_ms;
     uint64_t max_flush_delay_in_ms;
+
+    // Whether each write waits for the data to be on disk, like in batch mode
+    bool force_sync = false;
 };
 
 using clperf_result = perf_result_with_aio_writes;
@@ -57,6 +61,7 @@ static void write_json_result(std::string result_file, const test_config& cfg, c
     params["max-data-size"] = cfg.max_data_size;
     params["min-flush-delay-in-ms"] = cfg.min_flush_delay_in_ms;
     params["max-flush-delay-in-ms"] = cfg.max_flush_delay_in_ms;
+    params["force-sync"] = cfg.force_sync;
 
     params["concurrency,cpus,duration"] = fmt::format("{},{},{}", cfg.concurrency, smp::count, cfg.duration_in_seconds);
     results["parameters"] = std::move(params);
@@ -109,6 +114,7 @@ struct commitlog_service {
     std::optional<db::commitlog> log;
     std::optional<db::commitlog::flush_handler_anchor> fa;
     timer<> flush_timer;
+    utils::precise_time_estimated_histogram latencies;
 
     commitlog_service(const test_config& c)
         : cfg(c)
@@ -127,6 +133,11 @@ struct commitlog_service {
             co_await log->clear();
         }
     }
+    // Stops discarding segments, so the ones left can be replayed
+    void stop_flushing() {
+        fa.reset();
+        flush_timer.cancel();
+    }
     void flush_handler(db::cf_id_type id, db::replay_position pos) {
         if (!flush_timer.armed()) {
             flush_timer.set_callback([id, this] { log->discard_completed_segments(id); });
@@ -141,14 +152,89 @@ static std::vector<clperf_result> do_commitlog_test(distributed<commitlog_servic
     return time_parallel_ex<clperf_result>([&] {
         auto& log = cls.local();
         size_t size = log.size_dist(tests::random::gen());
-        return log.log->add_mutation(uuid, size, db::commitlog::force_sync::no, [size](db::commitlog::output& dst) {
+        auto start = utils::precise_time_estimated_histogram::clock::now();
+        return log.log->add_mutation(uuid, size, db::commitlog::force_sync(cfg.force_sync), [size](db::commitlog::output& dst) {
             dst.fill('1', size);
-        }).then([](db::rp_handle h) {
+        }).then([&log, start](db::rp_handle h) {
+            log.latencies.add(utils::precise_time_estimated_histogram::clock::now() - start);
             h.release();
         });
     }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, true, &clperf_result::update);
 }
 
+static future<> print_latencies(distributed<commitlog_service>& cls) {
+    auto latencies = co_await cls.map_reduce0([] (commitlog_service& cl) {
+        return std::exchange(cl.latencies, {});
+    }, utils::precise_time_estimated_histogram{}, [] (utils::precise_time_estimated_histogram a, const utils::precise_time_estimated_histogram& b) {
+        return std::move(a.merge(b));
+    });
+    std::cout << format("latency: p50 {}us, p90 {}us, p99 {}us, p999 {}us, max {}us\n",
+            latencies.percentile(0.5), latencies.percentile(0.9), latencies.percentile(0.99), latencies.percentile(0.999), latencies.max());
+}
+
+struct segment_stats {
+    uint64_t created = 0;
+    uint64_t destroyed = 0;
+    uint64_t blocked_on_new_segment = 0;
+    uint64_t flush_limit_exceeded = 0;
+    uint64_t disk_footprint = 0;
+
+    segment_stats& operator+=(const segment_stats& o) {
+        created += o.created;
+        destroyed += o.destroyed;
+        blocked_on_new_segment += o.blocked_on_new_segment;
+        flush_limit_exceeded += o.flush_limit_exceeded;
+        disk_footprint += o.disk_footprint;
+        return *this;
+    }
+};
+
+// Segments destroyed are the ones deleted or recycled once flushed. Allocations
+// blocked on a new segment show whether segment creation and recycling keep up
+// with the writes.
+static future<> print_segment_stats(distributed<commitlog_service>& cls) {
+    auto stats = co_await cls.map_reduce0([] (commitlog_service& cl) {
+        return segment_stats{
+            .created = cl.log->get_num_segments_created(),
+            .destroyed = cl.log->get_num_segments_destroyed(),
+            .blocked_on_new_segment = cl.log->get_num_blocked_on_new_segment(),
+            .flush_limit_exceeded = cl.log->get_flush_limit_exceeded_count(),
+            .disk_footprint = cl.log->disk_footprint(),
+        };
+    }, segment_stats{}, [] (segment_stats a, const segment_stats& b) {
+        return a += b;
+    });
+    std::cout << format("segments: {} created, {} destroyed, {} allocations blocked on a new segment, {} flush limit exceeded, {} bytes on disk\n",
+            stats.created, stats.destroyed, stats.blocked_on_new_segment, stats.flush_limit_exceeded, stats.disk_footprint);
+}
+
+// Reads back the segments left on all shards concurrently, like commitlog_replayer
+// does on startup, without applying the entries to a database.
+static future<> replay_test(distributed<commitlog_service>& cls) {
+    co_await cls.invoke_on_all([] (commitlog_service& cl) -> future<> {
+        cl.stop_flushing();
+        co_await cl.log->sync_all_segments();
+    });
+    auto start = std::chrono::steady_clock::now();
+    auto [entries, bytes] = co_await cls.map_reduce0([] (commitlog_service& cl) -> future<std::pair<uint64_t, uint64_t>> {
+        uint64_t entries = 0;
+        uint64_t bytes = 0;
+        for (auto& seg : cl.log->get_active_segment_names()) {
+            co_await db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, [&] (db::commitlog::buffer_and_replay_position buf_rp) {
+                ++entries;
+                bytes += buf_rp.buffer.size_bytes();
+                return make_ready_future<>();
+            });
+        }
+        co_return std::pair(entries, bytes);
+    }, std::pair<uint64_t, uint64_t>(), [] (std::pair<uint64_t, uint64_t> a, std::pair<uint64_t, uint64_t> b) {
+        return std::pair(a.first + b.first, a.second + b.second);
+    });
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << format("replay: {} entries, {} bytes in {:.3f}s: {:.0f} entries/s, {:.2f} MB/s\n",
+            entries, bytes, elapsed, entries / elapsed, bytes / elapsed / (1 << 20));
+}
+
 int main(int argc, char** argv) {
     namespace bpo = boost::program_options;
     app_template app;
@@ -156,6 +242,7 @@ int main(int argc, char** argv) {
         ("random-seed", boost::program_options::value<unsigned>(), "Random number generator seed")
         ("duration", bpo::value<unsigned>()->default_value(5), "test duration in seconds")
         ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core")
+        ("concurrency-sweep", bpo::value<std::vector<unsigned>>()->multitoken(), "run the test once per given number of workers per core, to measure scaling")
         ("operations-per-shard", bpo::value<unsigned>(), "run this many operations per shard (overrides duration)")
 
         ("commitlog-sync", bpo::value<sstring>(), "commitlog sync method (pediodic/batch)")
@@ -164,6 +251,8 @@ int main(int argc, char** argv) {
         ("commitlog-sync-period-in-ms", bpo::value<unsigned>(), "how long the system waits for other writes before performing a sync in \"periodic\" mode")
         ("commitlog-use-o-dsync", bpo::value<bool>()->default_value(true), "whether or not to use O_DSYNC mode for commitlog segments io")
         ("commitlog-use-hard-size-limit", bpo::value<bool>()->default_value(true), "whether or not to use a hard size limit for commitlog disk usage")
+        ("force-sync", bpo::value<bool>()->default_value(false), "whether or not each write waits for its data to be synced to disk")
+        ("replay", bpo::value<bool>()->default_value(false), "read back the segments left after the test, measuring replay throughput")
 
         ("min-data-size", bpo::value<size_t>()->default_value(200), "minimum size of data element added")
         ("max-data-size", bpo::value<size_t>()->default_value(32/2 * 1024 * 1024 - 1), "maximum size of data element added")
@@ -218,6 +307,7 @@ int main(int argc, char** argv) {
         cfg.max_data_size = app.configuration()["max-data-size"].as<size_t>();
         cfg.min_flush_delay_in_ms = app.configuration()["min-flush-delay-in-ms"].as<uint64_t>();
         cfg.max_flush_delay_in_ms = app.configuration()["min-flush-delay-in-ms"].as<uint64_t>();
+        cfg.force_sync = app.configuration()["force-sync"].as<bool>();
 
         if (cfg.min_data_size > cfg.max_data_size) {
             cfg.max_data_size = cfg.min_data_size;
@@ -242,6 +332,19 @@ int main(int argc, char** argv) {
             if (cfg.max_data_size > test_commitlog.local().log->max_record_size()) {
                 throw std::invalid_argument(sstring("Too large max data size: ") + std::to_string(cfg.max_data_size));
             }
+            if (app.configuration().contains("concurrency-sweep")) {
+                for (auto concurrency : app.configuration()["concurrency-sweep"].as<std::vector<unsigned>>()) {
+                    auto level_cfg = cfg;
+                    level_cfg.concurrency = concurrency;
+                    auto results = co_await seastar::async([&] {
+                        return do_commitlog_test(test_commitlog, level_cfg);
+                    });
+                    std::sort(results.begin(), results.end(), [] (perf_result a, perf_result b) { return a.throughput < b.throughput; });
+                    std::cout << format("\nconcurrency {}: median {:.2f} tps\n", concurrency, results[results.size() / 2].throughput);
+                    co_await print_latencies(test_commitlog);
+                }
+            }
+
             // test "framework" expects seastar thread
             auto results = co_await seastar::async([&] {
                 return do_commitlog_test(test_commitlog, cfg);
@@ -260,10 +363,16 @@ int main(int argc, char** argv) {
             std::sort(absolute_deviations.begin(), absolute_deviations.end());
             auto mad = absolute_deviations[results.size() / 2];
             std::cout << format("\nmedian {}\nmedian absolute deviation: {:.2f}\nmaximum: {:.2f}\nminimum: {:.2f}\n", median_result, mad, max, min);
+            co_await print_latencies(test_commitlog);
+            co_await print_segment_stats(test_commitlog);
 
             if (app.configuration().contains("json-result")) {
                 write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, median_result, mad, max, min);
             }
+
+            if (app.configuration()["replay"].as<bool>()) {
+                co_await replay_test(test_commitlog);
+            }
         } catch (...) {
             ex = std::current_exception();
         }
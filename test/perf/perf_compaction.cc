@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/closeable.hh>
+#include "seastarx.hh"
+#include "compaction/compaction_manager.hh"
+#include "compaction/compaction_strategy.hh"
+#include "replica/database.hh"
+#include "schema/schema_builder.hh"
+#include "test/lib/random_utils.hh"
+#include "test/lib/sstable_test_env.hh"
+#include "test/lib/sstable_utils.hh"
+#include "test/lib/test_services.hh"
+
+// Measures compaction_manager running a compaction strategy against a stream
+// of flushed sstables, for evaluating changes to compaction.
+//
+// Each round writes --rows-per-round rows into one sstable, adds it to the
+// table, and waits for the compactions it triggers to finish. The rounds are
+// spaced by --round-interval seconds of simulated time, ending at the start of
+// the run, so time-window compaction and TTLs see the history of a table
+// written to for that long. After each round, the following are reported:
+// * the compaction throughput so far;
+// * the write amplification so far: bytes written by flushes and compactions
+//   over bytes written by flushes;
+// * the read amplification: the average number of sstables which a read of
+//   a written partition has to look into, after bloom filtering;
+// * the disk space used. Once all rounds are done, the table is compacted
+//   by a major compaction, and the space amplification of each round is its
+//   disk space over the one left by the major compaction.
+//
+// The workloads are:
+// * overwrite: rows of --partitions partitions with --clustering-rows rows
+//   each, overwritten in a uniformly random order;
+// * ttl: overwrite, with the rows expiring after --ttl seconds;
+// * tombstone: overwrite, with a quarter of the writes deleting a partition;
+// * wide: rows appended to few partitions (--partitions / 1000).
+
+namespace {
+
+struct round_result {
+    unsigned round;
+    double elapsed;
+    size_t sstables;
+    uint64_t disk_space;
+    double write_amplification;
+    double read_amplification;
+};
+
+enum class workload { overwrite, ttl, tombstone, wide };
+
+workload parse_workload(const sstring& name) {
+    if (name == "overwrite") {
+        return workload::overwrite;
+    } else if (name == "ttl") {
+        return workload::ttl;
+    } else if (name == "tombstone") {
+        return workload::tombstone;
+    } else if (name == "wide") {
+        return workload::wide;
+    }
+    throw std::invalid_argument(format("Unknown workload: {}", name));
+}
+
+uint64_t disk_space(replica::table& t) {
+    uint64_t bytes = 0;
+    for (auto& sst : *t.get_sstables()) {
+        bytes += sst->bytes_on_disk();
+    }
+    return bytes;
+}
+
+double read_amplification(replica::table& t, const schema& s, const std::vector<dht::decorated_key>& keys, unsigned reads) {
+    if (keys.empty() || !reads) {
+        return 0;
+    }
+    uint64_t sstables = 0;
+    for (unsigned i = 0; i < reads; ++i) {
+        auto& dk = keys[tests::random::get_int<size_t>(0, keys.size() - 1)];
+        for (auto& sst : t.get_sstable_set().select(dht::partition_range::make_singular(dk))) {
+            sstables += sst->filter_has_key(s, dk);
+        }
+        thread::maybe_yield();
+    }
+    return double(sstables) / reads;
+}
+
+void wait_for_compactions(compaction_manager& cm) {
+    while (cm.get_stats().pending_tasks || cm.get_stats().active_tasks) {
+        sleep(std::chrono::milliseconds(10)).get();
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("strategy", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy"), "Compaction strategy: SizeTieredCompactionStrategy, LeveledCompactionStrategy or TimeWindowCompactionStrategy")
+        ("workload", bpo::value<sstring>()->default_value("overwrite"), "Workload: overwrite, ttl, tombstone or wide")
+        ("rounds", bpo::value<unsigned>()->default_value(100), "Number of sstables flushed")
+        ("rows-per-round", bpo::value<unsigned>()->default_value(10000), "Number of rows written to each flushed sstable")
+        ("partitions", bpo::value<unsigned>()->default_value(100000), "Number of partitions written to")
+        ("clustering-rows", bpo::value<unsigned>()->default_value(1), "Number of clustering rows of each partition, for the overwrite workloads")
+        ("value-size", bpo::value<unsigned>()->default_value(100), "Size of the value of each row, in bytes")
+        ("ttl", bpo::value<unsigned>()->default_value(3600), "TTL of the rows of the ttl workload, in seconds")
+        ("round-interval", bpo::value<unsigned>()->default_value(60), "Simulated time between rounds, in seconds")
+        ("reads", bpo::value<unsigned>()->default_value(1000), "Number of partition reads sampled for the read amplification")
+        ("strategy-option", bpo::value<std::vector<sstring>>()->default_value({}, ""), "Compaction strategy option, as name=value, can be repeated")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        return sstables::test_env::do_with_async([&app] (sstables::test_env& env) {
+            auto& cfg = app.configuration();
+            auto strategy = sstables::compaction_strategy::type(cfg["strategy"].as<sstring>());
+            auto wl = parse_workload(cfg["workload"].as<sstring>());
+            auto rounds = cfg["rounds"].as<unsigned>();
+            auto rows_per_round = cfg["rows-per-round"].as<unsigned>();
+            auto partitions = wl == workload::wide ? std::max(1u, cfg["partitions"].as<unsigned>() / 1000) : cfg["partitions"].as<unsigned>();
+            auto clustering_rows = std::max(1u, cfg["clustering-rows"].as<unsigned>());
+            auto ttl = std::chrono::seconds(cfg["ttl"].as<unsigned>());
+            auto round_interval = std::chrono::seconds(cfg["round-interval"].as<unsigned>());
+            auto reads = cfg["reads"].as<unsigned>();
+
+            std::map<sstring, sstring> strategy_options;
+            for (auto& opt : cfg["strategy-option"].as<std::vector<sstring>>()) {
+                auto pos = opt.find('=');
+                if (pos == sstring::npos) {
+                    throw std::invalid_argument(format("Invalid strategy option {}, expected name=value", opt));
+                }
+                strategy_options[opt.substr(0, pos)] = opt.substr(pos + 1);
+            }
+
+            auto s = schema_builder("perf", "compaction")
+                    .with_column("pk", int32_type, column_kind::partition_key)
+                    .with_column("ck", int64_type, column_kind::clustering_key)
+                    .with_column("v", bytes_type)
+                    .set_compaction_strategy(strategy)
+                    .set_compaction_strategy_options(std::move(strategy_options))
+                    .set_gc_grace_seconds(0)
+                    .build();
+            auto& v_def = *s->get_column_definition("v");
+
+            auto cf = env.make_table_for_tests(s);
+            auto close_cf = deferred_stop(cf);
+            auto& cm = cf.get_compaction_manager();
+            auto sst_gen = cf.make_sst_factory();
+
+            std::vector<dht::decorated_key> keys;
+            keys.reserve(partitions);
+            for (unsigned pk = 0; pk < partitions; ++pk) {
+                keys.push_back(dht::decorate_key(*s, partition_key::from_single_value(*s, int32_type->decompose(int32_t(pk)))));
+            }
+            const auto value = tests::random::get_bytes(cfg["value-size"].as<unsigned>());
+
+            // The simulated write time of the first round, the last one is now.
+            auto start_time = gc_clock::now() - round_interval * (rounds - 1);
+            int64_t next_ck = 0;
+            uint64_t flushed_bytes = 0;
+            uint64_t rows_written = 0;
+            std::vector<round_result> results;
+            std::vector<dht::decorated_key> written_keys;
+            std::unordered_set<unsigned> written;
+            auto start = std::chrono::steady_clock::now();
+            std::chrono::duration<double> compaction_time{0};
+
+            for (unsigned round = 0; round < rounds; ++round) {
+                auto write_time = start_time + round_interval * round;
+                auto ts = api::timestamp_type(std::chrono::duration_cast<std::chrono::microseconds>(write_time.time_since_epoch()).count());
+                auto mt = make_lw_shared<replica::memtable>(s);
+                for (unsigned i = 0; i < rows_per_round; ++i) {
+                    auto pk = tests::random::get_int<unsigned>(0, partitions - 1);
+                    if (written.insert(pk).second) {
+                        written_keys.push_back(keys[pk]);
+                    }
+                    mutation m(s, keys[pk]);
+                    if (wl == workload::tombstone && i % 4 == 3) {
+                        m.partition().apply(tombstone(ts, write_time));
+                    } else {
+                        auto ck_value = wl == workload::wide ? next_ck++ : tests::random::get_int<int64_t>(0, clustering_rows - 1);
+                        auto ck = clustering_key::from_single_value(*s, int64_type->decompose(ck_value));
+                        auto cell = wl == workload::ttl
+                                ? atomic_cell::make_live(*v_def.type, ts, value, write_time + ttl, ttl)
+                                : atomic_cell::make_live(*v_def.type, ts, value);
+                        m.set_clustered_cell(ck, v_def, std::move(cell));
+                    }
+                    mt->apply(std::move(m));
+                    thread::maybe_yield();
+                }
+                auto sst = make_sstable_containing(sst_gen, std::move(mt));
+                flushed_bytes += sst->bytes_on_disk();
+                rows_written += rows_per_round;
+
+                auto compaction_start = std::chrono::steady_clock::now();
+                cf->add_sstable_and_update_cache(sst).get();
+                cf->trigger_compaction();
+                wait_for_compactions(cm);
+                compaction_time += std::chrono::steady_clock::now() - compaction_start;
+
+                results.push_back(round_result{
+                    .round = round,
+                    .elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+                    .sstables = cf->sstables_count(),
+                    .disk_space = disk_space(*cf),
+                    .write_amplification = double(flushed_bytes + cm.get_stats().bytes_written) / flushed_bytes,
+                    .read_amplification = read_amplification(*cf, *s, written_keys, reads),
+                });
+                auto& r = results.back();
+                fmt::print("round {}: {:.3f}s, {} sstables, {} bytes, write amp {:.2f}, read amp {:.2f}, compaction {:.2f} MB/s\n",
+                        r.round, r.elapsed, r.sstables, r.disk_space, r.write_amplification, r.read_amplification,
+                        cm.get_stats().bytes_compacted / compaction_time.count() / (1 << 20));
+            }
+
+            auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+            auto stats = cm.get_stats();
+            cf->compact_all_sstables().get();
+            auto compacted_space = std::max<uint64_t>(1, disk_space(*cf));
+
+            fmt::print("\n{:>6} {:>10} {:>9} {:>14} {:>10} {:>10} {:>10}\n", "round", "elapsed", "sstables", "disk space", "write amp", "read amp", "space amp");
+            for (auto& r : results) {
+                fmt::print("{:>6} {:>10.3f} {:>9} {:>14} {:>10.2f} {:>10.2f} {:>10.2f}\n", r.round, r.elapsed, r.sstables, r.disk_space,
+                        r.write_amplification, r.read_amplification, double(r.disk_space) / compacted_space);
+            }
+            fmt::print("\n{}, {} workload: {:.0f} rows/s, {} bytes flushed, {} bytes compacted, {} bytes written by compaction, {} bytes after major compaction\n",
+                    sstables::compaction_strategy::name(strategy), cfg["workload"].as<sstring>(), rows_written / elapsed.count(),
+                    flushed_bytes, stats.bytes_compacted, stats.bytes_written, compacted_space);
+        });
+    });
+}
@@ -903,6 +903,24 @@ static test_result slice_rows_by_ck(replica::column_family& cf, clustered_ds& ds
     return test_reading_all(rd);
 }
 
+// Reads the rows [offset, offset + n_read) in reverse clustering order
+static test_result slice_rows_reversed(replica::column_family& cf, clustered_ds& ds, int offset = 0, int n_read = 1) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto s = cf.schema();
+    auto slice = partition_slice_builder(*s)
+        .with_range(query::clustering_range::make(
+            ds.make_ck(*s, offset),
+            ds.make_ck(*s, offset + n_read - 1)))
+        .build();
+    auto reversed_schema = s->make_reversed();
+    auto reversed_slice = query::reverse_slice(*s, std::move(slice));
+    auto pr = dht::partition_range::make_singular(dht::decorate_key(*s, ds.make_pk(*s)));
+    auto rd = cf.make_reader_v2(reversed_schema, semaphore.make_permit(), pr, reversed_slice);
+    auto close_rd = deferred_close(rd);
+
+    return test_reading_all(rd);
+}
+
 static test_result select_spread_rows(replica::column_family& cf, clustered_ds& ds, int stride = 0, int n_read = 1) {
     tests::reader_concurrency_semaphore_wrapper semaphore;
     auto sb = partition_slice_builder(*cf.schema());
@@ -1567,6 +1585,33 @@ void test_large_partition_slicing_clustering_keys(app_template &app, replica::co
     test(n_rows / 2, 4096);
 }
 
+void test_large_partition_slicing_reversed(app_template &app, replica::column_family& cf, clustered_ds& ds) {
+    auto n_rows = ds.n_rows(cfg);
+
+    output_mgr->set_test_param_names({{"offset", "{:<7}"}, {"read", "{:<7}"}}, test_result::stats_names());
+    auto test = [&] (int offset, int read) {
+      run_test_case(app, [&] {
+        auto r = slice_rows_reversed(cf, ds, offset, read);
+        r.set_params(to_sstrings(offset, read));
+        check_fragment_count(r, std::min(n_rows - offset, read));
+        return r;
+      });
+    };
+
+    test(0, 1);
+    test(0, 32);
+    test(0, 256);
+    test(0, 4096);
+
+    test(n_rows / 2, 1);
+    test(n_rows / 2, 32);
+    test(n_rows / 2, 256);
+    test(n_rows / 2, 4096);
+
+    // The whole partition, read backwards from its end
+    test(0, n_rows);
+}
+
 void test_large_partition_slicing_single_partition_reader(app_template &app, replica::column_family& cf, clustered_ds& ds) {
     auto n_rows = ds.n_rows(cfg);
 
@@ -1824,6 +1869,13 @@ static std::initializer_list<test_group> test_groups = {
         test_group::type::large_partition,
         make_test_fn(test_large_partition_slicing_clustering_keys),
     },
+    {
+        "large-partition-slicing-reversed",
+        "Testing reversed slicing of large partition using clustering keys",
+        test_group::requires_cache::no,
+        test_group::type::large_partition,
+        make_test_fn(test_large_partition_slicing_reversed),
+    },
     {
         "large-partition-slicing-single-key-reader",
         "Testing slicing of large partition, single-partition reader",
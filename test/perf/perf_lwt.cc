@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/range/irange.hpp>
+#include "seastarx.hh"
+#include "test/lib/cql_test_env.hh"
+#include "test/lib/log.hh"
+#include "test/lib/random_utils.hh"
+#include "test/perf/perf.hh"
+#include <seastar/core/app-template.hh>
+#include <seastar/core/reactor.hh>
+#include "replica/database.hh"
+#include "db/config.hh"
+#include "service/storage_proxy.hh"
+#include "transport/messages/result_message.hh"
+
+/// Measures the throughput of uncontended LWT operations, i.e. of the paxos
+/// rounds, on keys owned by the coordinator shard.
+///
+/// Workloads:
+///
+///  - insert: INSERT ... IF NOT EXISTS of new keys, the condition is met,
+///  - update-failing: UPDATE ... IF of existing keys, the condition isn't met,
+///  - serial-read: SELECT of existing keys with SERIAL consistency.
+///
+/// The proposals of update-failing and serial-read are empty and those of
+/// insert are learned with --commit-cl, so that, with --background-learn
+/// (cas_background_learn), the learn stage is skipped by the ones which can
+/// skip it.
+///
+/// Example run:
+///
+///    $ build/release/test/perf/perf_lwt -c1 -m1G --workload insert --commit-cl any --background-learn 1
+///
+/// Prints the throughput of each iteration and the count of learns completed
+/// in the background, summed over all shards.
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct shard_keys {
+    // Keys owned by this shard, for update-failing and serial-read.
+    std::vector<int32_t> existing;
+    // The next key to try for insert.
+    int32_t next = 0;
+};
+
+thread_local shard_keys keys;
+
+bool is_local_key(const schema& s, int32_t k) {
+    auto pk = partition_key::from_single_value(s, int32_type->decompose(k));
+    return s.table().shard_of(dht::get_token(s, pk)) == this_shard_id();
+}
+
+cql3::raw_value make_key(int32_t k) {
+    return cql3::raw_value::make_value(int32_type->decompose(k));
+}
+
+uint64_t get_background_learns(cql_test_env& env) {
+    return env.get_storage_proxy().map_reduce0([] (service::storage_proxy& sp) {
+        return sp.get_stats().cas_background_learns;
+    }, uint64_t(0), std::plus<uint64_t>()).get0();
+}
+
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("workload", bpo::value<sstring>()->default_value("insert"), "One of: insert, update-failing, serial-read")
+        ("commit-cl", bpo::value<sstring>()->default_value("quorum"), "Commit consistency of insert: quorum or any")
+        ("background-learn", bpo::value<bool>()->default_value(true), "Sets cas_background_learn")
+        ("partitions", bpo::value<unsigned>()->default_value(10000), "Number of partitions to populate the table with, for update-failing and serial-read")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "Operations in flight per shard")
+        ("duration", bpo::value<unsigned>()->default_value(5), "Duration of the test [s]")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        auto cfg_ptr = make_shared<db::config>();
+        cfg_ptr->enable_commitlog(false);
+        cfg_ptr->cas_background_learn(app.configuration()["background-learn"].as<bool>());
+
+        return do_with_cql_env_thread([&app] (cql_test_env& env) {
+            auto& opts = app.configuration();
+            const auto workload = opts["workload"].as<sstring>();
+            const auto partitions = opts["partitions"].as<unsigned>();
+            const auto commit_cl_name = opts["commit-cl"].as<sstring>();
+            if (commit_cl_name != "quorum" && commit_cl_name != "any") {
+                throw std::invalid_argument(format("Unknown commit consistency: {}", commit_cl_name));
+            }
+            const auto commit_cl = commit_cl_name == "any" ? db::consistency_level::ANY : db::consistency_level::QUORUM;
+
+            env.execute_cql("CREATE TABLE ks.cf (pk int PRIMARY KEY, v int)").get();
+            if (workload != "insert") {
+                testlog.info("Populating {} partitions", partitions);
+                auto id = env.prepare("INSERT INTO ks.cf (pk, v) VALUES (?, 0)").get0();
+                for (int32_t pk = 0; pk < int32_t(partitions); ++pk) {
+                    env.execute_prepared(id, {make_key(pk)}).get();
+                }
+            }
+            // LWT operations have to be coordinated by the shard owning the key.
+            smp::invoke_on_all([&env, partitions, workload] {
+                auto s = env.local_db().find_schema("ks", "cf");
+                if (workload == "insert") {
+                    keys.next = partitions;
+                    return;
+                }
+                for (int32_t pk = 0; pk < int32_t(partitions); ++pk) {
+                    if (is_local_key(*s, pk)) {
+                        keys.existing.push_back(pk);
+                    }
+                }
+                if (keys.existing.empty()) {
+                    throw std::invalid_argument(format("No partition owned by shard {}, use more partitions", this_shard_id()));
+                }
+            }).get();
+
+            sstring query;
+            db::consistency_level cl;
+            if (workload == "insert") {
+                query = "INSERT INTO ks.cf (pk, v) VALUES (?, 0) IF NOT EXISTS";
+                cl = commit_cl;
+            } else if (workload == "update-failing") {
+                query = "UPDATE ks.cf SET v = 1 WHERE pk = ? IF v = 1";
+                cl = commit_cl;
+            } else if (workload == "serial-read") {
+                query = "SELECT * FROM ks.cf WHERE pk = ?";
+                cl = db::consistency_level::SERIAL;
+            } else {
+                throw std::invalid_argument(format("Unknown workload: {}", workload));
+            }
+            auto id = env.prepare(query).get0();
+
+            const auto background_learns_before = get_background_learns(env);
+            auto results = time_parallel([&env, id, cl, insert = workload == "insert"] {
+                int32_t pk;
+                if (insert) {
+                    auto s = env.local_db().find_schema("ks", "cf");
+                    do {
+                        pk = keys.next++;
+                    } while (!is_local_key(*s, pk));
+                } else {
+                    pk = keys.existing[tests::random::get_int<size_t>(keys.existing.size() - 1)];
+                }
+                return env.execute_prepared(id, {make_key(pk)}, cl).discard_result();
+            }, opts["concurrency"].as<unsigned>(), opts["duration"].as<unsigned>());
+
+            std::sort(results.begin(), results.end(), [] (const perf_result& a, const perf_result& b) {
+                return a.throughput < b.throughput;
+            });
+            std::cout << format("median {:.0f} tps, {} learns in the background", results[results.size() / 2].throughput,
+                    get_background_learns(env) - background_learns_before) << std::endl;
+        }, cfg_ptr);
+    });
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/range/irange.hpp>
+#include "seastarx.hh"
+#include "test/lib/cql_test_env.hh"
+#include "test/lib/log.hh"
+#include <seastar/core/app-template.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/sleep.hh>
+#include "replica/database.hh"
+#include "readers/multishard.hh"
+#include "db/config.hh"
+#include "cql3/query_options.hh"
+#include "transport/messages/result_message.hh"
+#include "service/pager/paging_state.hh"
+
+/// Measures paged full scans, which are executed as multishard reads, and
+/// how well the querier cache keeps the shard readers alive between pages.
+///
+/// A delay between pages, simulating a slow client, shows the effect of the
+/// querier TTL on the hit-rate.
+///
+/// Example run:
+///
+///    $ build/release/test/perf/perf_multishard_scan -c4 -m2G --partitions 100000 --page-delay-ms 20
+///
+/// Prints the duration of each scan and the querier cache lookups, misses
+/// (by reason) and drops of the scan, summed over all shards, as well as the
+/// read-aheads of the shard readers which were waited for or not, and the
+/// adjustments of how much data they read ahead.
+
+using namespace std::chrono_literals;
+
+struct cache_stats {
+    uint64_t lookups = 0;
+    uint64_t misses = 0;
+    uint64_t misses_after_eviction = 0;
+    uint64_t drops_schema_mismatch = 0;
+    uint64_t drops_position_mismatch = 0;
+
+    cache_stats operator-(const cache_stats& o) const {
+        return {lookups - o.lookups, misses - o.misses, misses_after_eviction - o.misses_after_eviction,
+                drops_schema_mismatch - o.drops_schema_mismatch, drops_position_mismatch - o.drops_position_mismatch};
+    }
+};
+
+static cache_stats get_cache_stats(cql_test_env& env) {
+    return env.db().map_reduce0([] (replica::database& db) {
+        auto& s = db.get_querier_cache_stats();
+        return cache_stats{s.lookups, s.misses, s.misses_after_eviction, s.drops_schema_mismatch, s.drops_position_mismatch};
+    }, cache_stats{}, [] (cache_stats a, const cache_stats& b) {
+        a.lookups += b.lookups;
+        a.misses += b.misses;
+        a.misses_after_eviction += b.misses_after_eviction;
+        a.drops_schema_mismatch += b.drops_schema_mismatch;
+        a.drops_position_mismatch += b.drops_position_mismatch;
+        return a;
+    }).get0();
+}
+
+static multishard_reader_stats get_read_ahead_stats() {
+    return smp::map_reduce(boost::irange(0u, smp::count), [] (unsigned) {
+        return get_multishard_reader_stats();
+    }, multishard_reader_stats{}, [] (multishard_reader_stats a, const multishard_reader_stats& b) {
+        a.read_ahead_waits += b.read_ahead_waits;
+        a.read_ahead_hits += b.read_ahead_hits;
+        a.read_ahead_grows += b.read_ahead_grows;
+        a.read_ahead_shrinks += b.read_ahead_shrinks;
+        return a;
+    }).get0();
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("partitions", bpo::value<unsigned>()->default_value(10000), "Number of partitions to populate the table with")
+        ("rows-per-partition", bpo::value<unsigned>()->default_value(10), "Number of rows per partition")
+        ("value-size", bpo::value<unsigned>()->default_value(100), "Size of the values [bytes]")
+        ("page-size", bpo::value<int32_t>()->default_value(1000), "Page size [rows]")
+        ("page-delay-ms", bpo::value<unsigned>()->default_value(0), "Delay between pages [ms]")
+        ("querier-ttl-s", bpo::value<unsigned>(), "Override the TTL of the queriers of active scans [s]")
+        ("scans", bpo::value<unsigned>()->default_value(5), "Number of full scans to run")
+        ("flush", "Flush memtables before scanning, so the scans read from sstables")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        auto cfg_ptr = make_shared<db::config>();
+        cfg_ptr->enable_commitlog(false);
+
+        return do_with_cql_env_thread([&app] (cql_test_env& env) {
+            auto& opts = app.configuration();
+            const auto partitions = opts["partitions"].as<unsigned>();
+            const auto rows_per_partition = opts["rows-per-partition"].as<unsigned>();
+            const auto page_size = opts["page-size"].as<int32_t>();
+            const auto page_delay = std::chrono::milliseconds(opts["page-delay-ms"].as<unsigned>());
+
+            if (opts.contains("querier-ttl-s")) {
+                auto ttl = std::chrono::seconds(opts["querier-ttl-s"].as<unsigned>());
+                env.db().invoke_on_all([ttl] (replica::database& db) {
+                    db.get_querier_cache().set_active_scan_entry_ttl(ttl);
+                }).get();
+            }
+
+            env.execute_cql("CREATE TABLE ks.cf (pk int, ck int, v text, PRIMARY KEY (pk, ck))").get();
+            auto id = env.prepare("INSERT INTO ks.cf (pk, ck, v) VALUES (?, ?, ?)").get0();
+            const auto value = cql3::raw_value::make_value(utf8_type->decompose(sstring(opts["value-size"].as<unsigned>(), 'v')));
+
+            testlog.info("Populating {} partitions of {} rows", partitions, rows_per_partition);
+            for (unsigned pk = 0; pk < partitions; ++pk) {
+                for (unsigned ck = 0; ck < rows_per_partition; ++ck) {
+                    env.execute_prepared(id, {
+                        cql3::raw_value::make_value(int32_type->decompose(int32_t(pk))),
+                        cql3::raw_value::make_value(int32_type->decompose(int32_t(ck))),
+                        value}).get();
+                }
+            }
+            if (opts.contains("flush")) {
+                env.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+            }
+
+            for (unsigned scan = 0; scan < opts["scans"].as<unsigned>(); ++scan) {
+                const auto stats_before = get_cache_stats(env);
+                const auto read_ahead_before = get_read_ahead_stats();
+                const auto start = std::chrono::steady_clock::now();
+                lw_shared_ptr<service::pager::paging_state> paging_state;
+                uint64_t rows = 0;
+                uint64_t pages = 0;
+                bool has_more_pages = true;
+                while (has_more_pages) {
+                    auto qo = std::make_unique<cql3::query_options>(db::consistency_level::ONE, std::vector<cql3::raw_value>{},
+                            cql3::query_options::specific_options{page_size, paging_state, {}, api::new_timestamp()});
+                    auto msg = env.execute_cql("SELECT * FROM ks.cf", std::move(qo)).get0();
+                    auto result = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(msg);
+                    rows += result->rs().result_set().size();
+                    ++pages;
+                    auto& metadata = result->rs().get_metadata();
+                    has_more_pages = metadata.flags().contains(cql3::metadata::flag::HAS_MORE_PAGES);
+                    paging_state = metadata.paging_state() ? make_lw_shared<service::pager::paging_state>(*metadata.paging_state()) : nullptr;
+                    if (has_more_pages && page_delay.count()) {
+                        seastar::sleep(page_delay).get();
+                    }
+                }
+                const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+                const auto stats = get_cache_stats(env) - stats_before;
+                const auto read_ahead = get_read_ahead_stats();
+                std::cout << format("scan {}: {:.3f} [s], {} rows, {} pages, {:.0f} rows/s, querier cache: {} lookups, {} misses"
+                        " ({} after eviction), {} drops ({} schema mismatch, {} position mismatch),"
+                        " read-ahead: {} waits, {} hits, {} grows, {} shrinks",
+                        scan, duration.count(), rows, pages, rows / duration.count(),
+                        stats.lookups, stats.misses, stats.misses_after_eviction,
+                        stats.drops_schema_mismatch + stats.drops_position_mismatch, stats.drops_schema_mismatch,
+                        stats.drops_position_mismatch,
+                        read_ahead.read_ahead_waits - read_ahead_before.read_ahead_waits,
+                        read_ahead.read_ahead_hits - read_ahead_before.read_ahead_hits,
+                        read_ahead.read_ahead_grows - read_ahead_before.read_ahead_grows,
+                        read_ahead.read_ahead_shrinks - read_ahead_before.read_ahead_shrinks) << std::endl;
+            }
+        }, cfg_ptr);
+    });
+}
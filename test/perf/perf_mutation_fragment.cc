@@ -12,6 +12,7 @@
 #include "test/perf/perf.hh"
 
 #include "mutation/mutation_fragment.hh"
+#include "mutation/mutation_fragment_v2.hh"
 
 namespace tests {
 
@@ -88,6 +89,21 @@ PERF_TEST_F(clustering_row, make_1M)
     perf_tests::do_not_optimize(mf);
 }
 
+// Fragments created and destroyed in turn like in a reader buffer, which
+// reuses the memory the permit kept from the previously consumed ones.
+PERF_TEST_F(clustering_row, make_v2_buffer_4)
+{
+    std::deque<mutation_fragment_v2> buffer;
+    for (int i = 0; i < 1000; ++i) {
+        buffer.emplace_back(*schema(), permit(), ::clustering_row(*schema(), clustering_row_4().as_clustering_row()));
+        if (buffer.size() == 100) {
+            buffer.clear();
+        }
+    }
+    perf_tests::do_not_optimize(buffer);
+    return 1000;
+}
+
 PERF_TEST_F(clustering_row, copy_4)
 {
     auto mf = mutation_fragment(*schema(), permit(), clustering_row_4());
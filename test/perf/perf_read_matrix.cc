@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/closeable.hh>
+#include "seastarx.hh"
+#include "partition_slice_builder.hh"
+#include "readers/combined.hh"
+#include "readers/mutation_source.hh"
+#include "replica/memtable.hh"
+#include "row_cache.hh"
+#include "schema/schema_builder.hh"
+#include "test/lib/reader_concurrency_semaphore.hh"
+#include "test/lib/random_utils.hh"
+#include "test/lib/sstable_test_env.hh"
+#include "test/lib/sstable_utils.hh"
+#include "test/perf/perf.hh"
+
+// Measures full scans through the read path of a table: a combined reader
+// over the memtable and either the row cache or the sstables directly, for
+// every combination of the given:
+// * --sstables: number of sstables; each row is written to one of them, so a
+//   partition read merges all of them;
+// * --memtable-overlap: fraction of the partitions overwritten in the memtable;
+// * --cache: none (the sstables are read directly), cold (the cache is
+//   invalidated before each scan) or warm (the cache is populated);
+// * --rows-per-partition: partition width;
+// * --tombstone-density: fraction of the rows deleted by a row tombstone,
+//   written in a different sstable than the row;
+// * --projection: all regular columns, or only one of them.
+//
+// For each combination, the scan with the median duration is reported, per
+// fragment read: time, instructions, allocations and tasks, and per scan:
+// aio reads and bytes read.
+
+namespace {
+
+struct matrix_point {
+    unsigned sstables;
+    double memtable_overlap;
+    sstring cache;
+    unsigned rows_per_partition;
+    double tombstone_density;
+    sstring projection;
+};
+
+struct scan_result {
+    double duration;
+    uint64_t fragments;
+    uint64_t instructions;
+    uint64_t allocations;
+    uint64_t tasks;
+    uint64_t aio_reads;
+    uint64_t aio_read_bytes;
+};
+
+struct data_config {
+    unsigned partitions;
+    unsigned columns;
+    unsigned value_size;
+    unsigned iterations;
+};
+
+schema_ptr make_schema(unsigned columns) {
+    auto builder = schema_builder("perf", "read_matrix")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("ck", int32_type, column_kind::clustering_key);
+    for (unsigned i = 0; i < columns; ++i) {
+        builder.with_column(to_bytes(format("v{}", i)), bytes_type);
+    }
+    return builder.build();
+}
+
+scan_result scan(flat_mutation_reader_v2 rd) {
+    auto close_rd = deferred_close(rd);
+    auto instructions = linux_perf_event::user_instructions_retired();
+    auto& io_stats = engine().get_io_stats();
+    auto aio_reads = io_stats.aio_reads;
+    auto aio_read_bytes = io_stats.aio_read_bytes;
+    auto allocations = perf_mallocs();
+    auto tasks = perf_tasks_processed();
+    uint64_t fragments = 0;
+
+    instructions.enable();
+    auto duration = duration_in_seconds([&] {
+        rd.consume_pausable([&fragments] (mutation_fragment_v2) {
+            ++fragments;
+            return stop_iteration::no;
+        }).get();
+    });
+    instructions.disable();
+
+    return scan_result{
+        .duration = duration.count(),
+        .fragments = fragments,
+        .instructions = instructions.read(),
+        .allocations = perf_mallocs() - allocations,
+        .tasks = perf_tasks_processed() - tasks,
+        .aio_reads = engine().get_io_stats().aio_reads - aio_reads,
+        .aio_read_bytes = engine().get_io_stats().aio_read_bytes - aio_read_bytes,
+    };
+}
+
+void run(sstables::test_env& env, const data_config& cfg, const matrix_point& p) {
+    auto s = make_schema(cfg.columns);
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    const auto value = tests::random::get_bytes(cfg.value_size);
+
+    std::vector<lw_shared_ptr<replica::memtable>> sstable_contents;
+    for (unsigned i = 0; i < p.sstables; ++i) {
+        sstable_contents.push_back(make_lw_shared<replica::memtable>(s));
+    }
+    auto mt = make_lw_shared<replica::memtable>(s);
+    auto overlapping_partitions = unsigned(p.memtable_overlap * cfg.partitions);
+    auto ts = api::new_timestamp();
+
+    for (unsigned pk = 0; pk < cfg.partitions; ++pk) {
+        auto dk = dht::decorate_key(*s, partition_key::from_single_value(*s, int32_type->decompose(int32_t(pk))));
+        for (unsigned ck = 0; ck < p.rows_per_partition; ++ck) {
+            auto key = clustering_key::from_single_value(*s, int32_type->decompose(int32_t(ck)));
+            auto sst_index = (pk + ck) % p.sstables;
+            mutation m(s, dk);
+            for (auto& cdef : s->regular_columns()) {
+                m.set_clustered_cell(key, cdef, atomic_cell::make_live(*cdef.type, ts, value));
+            }
+            sstable_contents[sst_index]->apply(m);
+            if (pk < overlapping_partitions) {
+                mutation overwrite(s, dk);
+                overwrite.set_clustered_cell(key, s->regular_begin()[0], atomic_cell::make_live(*bytes_type, ts + 2, value));
+                mt->apply(overwrite);
+            }
+            if (tests::random::with_probability(p.tombstone_density)) {
+                mutation del(s, dk);
+                del.partition().apply_delete(*s, key, tombstone(ts + 1, gc_clock::now()));
+                sstable_contents[(sst_index + 1) % p.sstables]->apply(del);
+            }
+            thread::maybe_yield();
+        }
+    }
+
+    std::vector<mutation_source> sstable_sources;
+    std::vector<sstables::shared_sstable> ssts;
+    for (auto& contents : sstable_contents) {
+        ssts.push_back(make_sstable_containing(env.make_sst_factory(s), contents));
+        sstable_sources.push_back(ssts.back()->as_mutation_source());
+    }
+    sstable_contents.clear();
+    auto sstables_source = make_combined_mutation_source(std::move(sstable_sources));
+
+    cache_tracker tracker;
+    row_cache cache(s, snapshot_source([&] { return sstables_source; }), tracker, is_continuous::no);
+
+    auto slice = p.projection == "all"
+            ? s->full_slice()
+            : partition_slice_builder(*s).with_regular_column(s->regular_begin()[0].name()).build();
+
+    auto make_reader = [&] {
+        auto permit = semaphore.make_permit();
+        std::vector<flat_mutation_reader_v2> readers;
+        readers.push_back(mt->make_flat_reader(s, permit, query::full_partition_range, slice));
+        if (p.cache == "none") {
+            readers.push_back(sstables_source.make_reader_v2(s, permit, query::full_partition_range, slice));
+        } else {
+            readers.push_back(cache.make_reader(s, permit, query::full_partition_range, slice));
+        }
+        return make_combined_reader(s, std::move(permit), std::move(readers));
+    };
+
+    if (p.cache == "warm") {
+        scan(make_reader());
+    }
+    std::vector<scan_result> results;
+    for (unsigned i = 0; i < cfg.iterations; ++i) {
+        if (p.cache == "cold") {
+            cache.invalidate(row_cache::external_updater([] {})).get();
+        }
+        results.push_back(scan(make_reader()));
+    }
+    std::ranges::sort(results, std::less<>{}, &scan_result::duration);
+    auto& r = results[results.size() / 2];
+    auto fragments = double(std::max<uint64_t>(r.fragments, 1));
+
+    fmt::print("{:>8} {:>8.2f} {:>6} {:>8} {:>10.2f} {:>10} {:>10} {:>10.1f} {:>10.0f} {:>10.2f} {:>10.3f} {:>10} {:>12}\n",
+            p.sstables, p.memtable_overlap, p.cache, p.rows_per_partition, p.tombstone_density, p.projection,
+            r.fragments, r.duration * 1e9 / fragments, r.instructions / fragments, r.allocations / fragments, r.tasks / fragments,
+            r.aio_reads, r.aio_read_bytes);
+
+    cache.invalidate(row_cache::external_updater([] {})).get();
+    tracker.cleaner().drain().get();
+}
+
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("sstables", bpo::value<std::vector<unsigned>>()->multitoken()->default_value({1, 4, 16}, "1 4 16"), "Numbers of sstables")
+        ("memtable-overlap", bpo::value<std::vector<double>>()->multitoken()->default_value({0, 1}, "0 1"), "Fractions of the partitions overwritten in the memtable")
+        ("cache", bpo::value<std::vector<sstring>>()->multitoken()->default_value({"none", "cold", "warm"}, "none cold warm"), "Cache states: none, cold or warm")
+        ("rows-per-partition", bpo::value<std::vector<unsigned>>()->multitoken()->default_value({1, 100}, "1 100"), "Partition widths")
+        ("tombstone-density", bpo::value<std::vector<double>>()->multitoken()->default_value({0, 0.1}, "0 0.1"), "Fractions of the rows deleted")
+        ("projection", bpo::value<std::vector<sstring>>()->multitoken()->default_value({"all", "one"}, "all one"), "Projections: all or one regular column")
+        ("partitions", bpo::value<unsigned>()->default_value(1000), "Number of partitions")
+        ("columns", bpo::value<unsigned>()->default_value(4), "Number of regular columns")
+        ("value-size", bpo::value<unsigned>()->default_value(32), "Size of each cell value, in bytes")
+        ("iterations", bpo::value<unsigned>()->default_value(5), "Number of scans of each combination")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        return sstables::test_env::do_with_async([&app] (sstables::test_env& env) {
+            auto& opts = app.configuration();
+            auto cfg = data_config{
+                .partitions = opts["partitions"].as<unsigned>(),
+                .columns = std::max(1u, opts["columns"].as<unsigned>()),
+                .value_size = opts["value-size"].as<unsigned>(),
+                .iterations = std::max(1u, opts["iterations"].as<unsigned>()),
+            };
+            for (auto& cache : opts["cache"].as<std::vector<sstring>>()) {
+                if (cache != "none" && cache != "cold" && cache != "warm") {
+                    throw std::invalid_argument(format("Invalid cache state: {}", cache));
+                }
+            }
+            for (auto& projection : opts["projection"].as<std::vector<sstring>>()) {
+                if (projection != "all" && projection != "one") {
+                    throw std::invalid_argument(format("Invalid projection: {}", projection));
+                }
+            }
+
+            fmt::print("{:>8} {:>8} {:>6} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>12}\n",
+                    "sstables", "overlap", "cache", "rows", "tombstones", "projection",
+                    "fragments", "ns/frag", "insns/frag", "allocs/frag", "tasks/frag", "aio reads", "bytes read");
+            for (auto sstables : opts["sstables"].as<std::vector<unsigned>>()) {
+                for (auto overlap : opts["memtable-overlap"].as<std::vector<double>>()) {
+                    for (auto& cache : opts["cache"].as<std::vector<sstring>>()) {
+                        for (auto rows : opts["rows-per-partition"].as<std::vector<unsigned>>()) {
+                            for (auto density : opts["tombstone-density"].as<std::vector<double>>()) {
+                                for (auto& projection : opts["projection"].as<std::vector<sstring>>()) {
+                                    run(env, cfg, matrix_point{
+                                        .sstables = std::max(1u, sstables),
+                                        .memtable_overlap = overlap,
+                                        .cache = cache,
+                                        .rows_per_partition = std::max(1u, rows),
+                                        .tombstone_density = density,
+                                        .projection = projection,
+                                    });
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        });
+    });
+}
@@ -46,6 +46,10 @@
 /// The second row which starts with "read:" has high max latency (106 ms),
 /// which is an indication of the following bug: https://github.com/scylladb/scylla/issues/8153
 ///
+/// Pass --transparent-hugepages 1 to compare with the LSA segments backed by
+/// transparent huge pages, which matters with caches much larger than the
+/// TLB reach (e.g. -m8G).
+///
 
 static const int cell_size = 128;
 static bool cancelled = false;
@@ -220,14 +224,20 @@ void test_scan_with_range_delete_over_rows() {
 }
 
 int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
     app_template app;
-    return app.run(argc, argv, [] {
+    app.add_options()
+        ("transparent-hugepages", bpo::value<bool>()->default_value(false), "Back the LSA segments with transparent huge pages");
+    return app.run(argc, argv, [&app] {
         return seastar::async([&] {
             engine().at_exit([] {
                 cancelled = true;
                 return make_ready_future();
             });
             logalloc::prime_segment_pool(memory::stats().total_memory(), memory::min_free_memory()).get();
+            if (app.configuration()["transparent-hugepages"].as<bool>()) {
+                logalloc::use_transparent_hugepages().get();
+            }
             test_scans_with_dummy_entries();
             test_scan_with_range_delete_over_rows();
         });
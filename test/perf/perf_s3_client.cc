@@ -20,11 +20,15 @@ seastar::logger plog("perf");
 class tester {
     std::chrono::seconds _duration;
     unsigned _parallel;
+    // "contiguous" GETs chunks in turn, "random" and "sequential" read the
+    // object through a readable file, at random offsets or one after another
+    std::string _mode;
     std::string _object_name;
     size_t _object_size;
     shared_ptr<s3::client> _client;
     utils::estimated_histogram _reads_hist;
     unsigned _errors = 0;
+    uint64_t _bytes_read = 0;
 
     static s3::endpoint_config_ptr make_config() {
         s3::endpoint_config cfg;
@@ -43,9 +47,10 @@ class tester {
     std::chrono::steady_clock::time_point now() const { return std::chrono::steady_clock::now(); }
 
 public:
-    tester(std::chrono::seconds dur, unsigned prl, size_t obj_size)
+    tester(std::chrono::seconds dur, unsigned prl, std::string mode, size_t obj_size)
             : _duration(dur)
             , _parallel(prl)
+            , _mode(std::move(mode))
             , _object_name(fmt::format("/{}/perfobject-{}-{}", tests::getenv_safe("S3_PUBLIC_BUCKET_FOR_TEST"), ::getpid(), this_shard_id()))
             , _object_size(obj_size)
             , _client(s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), make_config()))
@@ -76,13 +81,47 @@ class tester {
 
 private:
 
+    future<> do_run_file() {
+        static constexpr size_t random_read_size = 4096;
+        static constexpr size_t sequential_read_size = 128 * 1024;
+        auto f = _client->make_readable_file(_object_name);
+        auto until = now() + _duration;
+        uint64_t off = 0;
+        do {
+            auto len = _mode == "random" ? random_read_size : sequential_read_size;
+            if (_mode == "random") {
+                off = tests::random::get_int<uint64_t>(0, _object_size - len);
+            } else if (off + len > _object_size) {
+                // Start over, with a new file to drop what it fetched ahead
+                co_await f.close();
+                f = _client->make_readable_file(_object_name);
+                off = 0;
+            }
+            auto start = now();
+            try {
+                auto buf = co_await f.dma_read_bulk<char>(off, len);
+                _bytes_read += buf.size();
+                off += len;
+                _reads_hist.add(std::chrono::duration_cast<std::chrono::milliseconds>(now() - start).count());
+            } catch (...) {
+                _errors++;
+            }
+        } while (now() < until);
+        co_await f.close();
+    }
+
     future<> do_run() {
+        if (_mode != "contiguous") {
+            co_await do_run_file();
+            co_return;
+        }
         auto until = now() + _duration;
         uint64_t off = 0;
         do {
             auto start = now();
             try {
-                co_await _client->get_object_contiguous(_object_name, s3::range{off, chunk_size});
+                auto buf = co_await _client->get_object_contiguous(_object_name, s3::range{off, chunk_size});
+                _bytes_read += buf.size();
                 off = (off + chunk_size) % (_object_size - chunk_size);
                 _reads_hist.add(std::chrono::duration_cast<std::chrono::milliseconds>(now() - start).count());
             } catch (...) {
@@ -116,6 +155,7 @@ class tester {
             );
         };
         plog.info("reads total: {:5}, errors: {:5}; latencies: {}", _reads_hist._count, _errors, print_percentiles(_reads_hist));
+        plog.info("throughput: {:.3f} MiB/s", double(_bytes_read) / (1 << 20) / _duration.count());
     }
 };
 
@@ -125,16 +165,18 @@ int main(int argc, char** argv) {
     app.add_options()
         ("duration", bpo::value<unsigned>()->default_value(10), "seconds to run")
         ("parallel", bpo::value<unsigned>()->default_value(1), "number of parallel fibers")
+        ("mode", bpo::value<std::string>()->default_value("contiguous"), "contiguous (GET chunks), random (small random file reads) or sequential (file reads one after another)")
         ("object_size", bpo::value<size_t>()->default_value(1 << 20), "size of test object")
     ;
 
     return app.run(argc, argv, [&app] () -> future<> {
         auto dur = std::chrono::seconds(app.configuration()["duration"].as<unsigned>());
         auto prl = app.configuration()["parallel"].as<unsigned>();
+        auto mode = app.configuration()["mode"].as<std::string>();
         auto osz = app.configuration()["object_size"].as<size_t>();
         sharded<tester> test;
         plog.info("Creating");
-        co_await test.start(dur, prl, osz);
+        co_await test.start(dur, prl, mode, osz);
         plog.info("Starting");
         co_await test.invoke_on_all(&tester::start);
         try {
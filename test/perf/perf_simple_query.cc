@@ -74,6 +74,11 @@ struct test_config {
     bool stop_on_error;
     sstring timeout;
     bool bypass_cache;
+    // Operations per second per shard of an open-loop load, 0 for a
+    // closed-loop one (concurrency workers issuing calls back to back)
+    double rate = 0;
+    // The share of writes among the operations of the read test
+    double write_ratio = 0;
 };
 
 std::ostream& operator<<(std::ostream& os, const test_config::run_mode& m) {
@@ -100,6 +105,8 @@ std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
            << ", frontend=" << cfg.frontend
            << ", query_single_key=" << (cfg.query_single_key ? "yes" : "no")
            << ", counters=" << (cfg.counters ? "yes" : "no")
+           << ", rate=" << cfg.rate
+           << ", write_ratio=" << cfg.write_ratio
            << "}";
 }
 
@@ -127,6 +134,28 @@ static bytes make_random_key(test_config& cfg) {
     return make_key(make_random_seq(cfg));
 }
 
+template <typename Func>
+static std::vector<perf_result> run_load(test_config& cfg, Func func) {
+    if (cfg.rate) {
+        return time_open_loop(std::move(func), cfg.rate, cfg.concurrency, cfg.duration_in_seconds, cfg.stop_on_error);
+    }
+    return time_parallel(std::move(func), cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+}
+
+static sstring make_write_query(test_config& cfg) {
+    sstring usings;
+    if (!cfg.timeout.empty()) {
+        usings += "USING TIMEOUT " + cfg.timeout;
+    }
+    return format("UPDATE cf {}SET "
+            "\"C0\" = 0x8f75da6b3dcec90c8a404fb9a5f6b0621e62d39c69ba5758e5f41b78311fbb26cc7a,"
+            "\"C1\" = 0xa8761a2127160003033a8f4f3d1069b7833ebe24ef56b3beee728c2b686ca516fa51,"
+            "\"C2\" = 0x583449ce81bfebc2e1a695eb59aad5fcc74d6d7311fc6197b10693e1a161ca2e1c64,"
+            "\"C3\" = 0x62bcb1dbc0ff953abc703bcb63ea954f437064c0c45366799658bd6b91d0f92908d7,"
+            "\"C4\" = 0x222fcbe31ffa1e689540e1499b87fa3f9c781065fccd10e4772b4c7039c2efd0fb27 "
+            "WHERE \"KEY\" = ?", usings);
+}
+
 static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
     create_partitions(env, cfg);
     sstring query = "select \"C0\", \"C1\", \"C2\", \"C3\", \"C4\" from cf where \"KEY\" = ?";
@@ -137,29 +166,25 @@ static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
         query += " using timeout " + cfg.timeout;
     }
     auto id = env.prepare(query).get0();
-    return time_parallel([&env, &cfg, id] {
+    if (cfg.write_ratio > 0) {
+        auto write_id = env.prepare(make_write_query(cfg)).get0();
+        return run_load(cfg, [&env, &cfg, id, write_id] {
+            bytes key = make_random_key(cfg);
+            return env.execute_prepared(tests::random::with_probability(cfg.write_ratio) ? write_id : id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
+        });
+    }
+    return run_load(cfg, [&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        });
 }
 
 static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg) {
-    sstring usings;
-    if (!cfg.timeout.empty()) {
-        usings += "USING TIMEOUT " + cfg.timeout;
-    }
-    sstring query = format("UPDATE cf {}SET "
-            "\"C0\" = 0x8f75da6b3dcec90c8a404fb9a5f6b0621e62d39c69ba5758e5f41b78311fbb26cc7a,"
-            "\"C1\" = 0xa8761a2127160003033a8f4f3d1069b7833ebe24ef56b3beee728c2b686ca516fa51,"
-            "\"C2\" = 0x583449ce81bfebc2e1a695eb59aad5fcc74d6d7311fc6197b10693e1a161ca2e1c64,"
-            "\"C3\" = 0x62bcb1dbc0ff953abc703bcb63ea954f437064c0c45366799658bd6b91d0f92908d7,"
-            "\"C4\" = 0x222fcbe31ffa1e689540e1499b87fa3f9c781065fccd10e4772b4c7039c2efd0fb27 "
-            "WHERE \"KEY\" = ?", usings);
-    auto id = env.prepare(query).get0();
-    return time_parallel([&env, &cfg, id] {
+    auto id = env.prepare(make_write_query(cfg)).get0();
+    return run_load(cfg, [&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        });
 }
 
 static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg) {
@@ -170,10 +195,10 @@ static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg)
     }
     sstring query = format("DELETE \"C0\", \"C1\", \"C2\", \"C3\", \"C4\" FROM cf {}WHERE \"KEY\" = ?", usings);
     auto id = env.prepare(query).get0();
-    return time_parallel([&env, &cfg, id] {
+    return run_load(cfg, [&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        });
 }
 
 static std::vector<perf_result> test_counter_update(cql_test_env& env, test_config& cfg) {
@@ -189,10 +214,10 @@ static std::vector<perf_result> test_counter_update(cql_test_env& env, test_conf
             "\"C4\" = \"C4\" + 5 "
             "WHERE \"KEY\" = ?", usings);
     auto id = env.prepare(query).get0();
-    return time_parallel([&env, &cfg, id] {
+    return run_load(cfg, [&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        });
 }
 
 static schema_ptr make_counter_schema(std::string_view ks_name) {
@@ -521,6 +546,10 @@ int scylla_simple_query_main(int argc, char** argv) {
         ("stop-on-error", bpo::value<bool>()->default_value(true), "stop after encountering the first error")
         ("timeout", bpo::value<std::string>()->default_value(""), "use timeout")
         ("bypass-cache", "use bypass cache when querying")
+        ("rate", bpo::value<double>()->default_value(0), "run an open-loop load of this many operations per second per shard, "
+                "arriving at random (Poisson) intervals, with up to concurrency of them in flight, and report latencies "
+                "measured from the intended arrival of operations; 0 runs concurrency workers back to back")
+        ("write-ratio", bpo::value<double>()->default_value(0), "share of writes, between 0 and 1, in a read test, for a mixed workload")
         ;
 
     set_abort_on_internal_error(true);
@@ -567,6 +596,8 @@ int scylla_simple_query_main(int argc, char** argv) {
             cfg.stop_on_error = app.configuration()["stop-on-error"].as<bool>();
             cfg.timeout = app.configuration()["timeout"].as<std::string>();
             cfg.bypass_cache = app.configuration().contains("bypass-cache");
+            cfg.rate = app.configuration()["rate"].as<double>();
+            cfg.write_ratio = app.configuration()["write-ratio"].as<double>();
             auto results = cfg.frontend == test_config::frontend_type::cql
                     ? do_cql_test(env, cfg)
                     : do_alternator_test(app.configuration()["alternator"].as<std::string>(),
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/thread.hh>
+#include "seastarx.hh"
+#include "sstables/sstable_set.hh"
+#include "test/lib/key_utils.hh"
+#include "test/lib/random_utils.hh"
+#include "test/lib/simple_schema.hh"
+#include "test/lib/sstable_test_env.hh"
+#include "test/lib/sstable_utils.hh"
+
+// Measures the selection of the sstables for single-partition reads from a
+// set of many level 0 sstables with narrow token ranges, like the ones left
+// by repair and streaming.
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("sstables", bpo::value<unsigned>()->default_value(10000), "Number of sstables in the set")
+        ("lookups", bpo::value<unsigned>()->default_value(100000), "Number of single-partition selections")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        return sstables::test_env::do_with_async([&app] (sstables::test_env& env) {
+            auto nr_sstables = app.configuration()["sstables"].as<unsigned>();
+            auto nr_lookups = app.configuration()["lookups"].as<unsigned>();
+
+            simple_schema ss;
+            auto s = ss.schema();
+            auto keys = tests::generate_partition_keys(2 * nr_sstables, s);
+            std::ranges::sort(keys, dht::decorated_key::less_comparator(s));
+
+            auto set = sstables::make_partitioned_sstable_set(s);
+            for (unsigned i = 0; i < nr_sstables; ++i) {
+                auto sst = env.make_sstable(s);
+                sstables::test(sst).set_values(keys[2 * i].key(), keys[2 * i + 1].key(), {});
+                set.insert(std::move(sst));
+            }
+
+            uint64_t selected = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned i = 0; i < nr_lookups; ++i) {
+                auto& dk = keys[tests::random::get_int<size_t>(0, keys.size() - 1)];
+                selected += set.select(dht::partition_range::make_singular(dk)).size();
+                thread::maybe_yield();
+            }
+            auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+            fmt::print("{} sstables: {:.0f} selections/s, {:.2f} sstables selected on average\n",
+                    nr_sstables, nr_lookups / elapsed.count(), double(selected) / nr_lookups);
+        });
+    });
+}
@@ -109,6 +109,26 @@ static future<> test_basic_operations(app_template& app) {
 
         testlog.info("Cleared in {:.6f} [ms]", time_to_clear.count() * 1000);
 
+        std::vector<dht::token> tokens;
+        for (int i = 0; i < 1024 * 1024; ++i) {
+            tokens.push_back(dht::token::get_random_token());
+        }
+        size_t nr_lookups = 0;
+        size_t replica_sink = 0;
+        auto time_to_lookup = duration_in_seconds([&] {
+            for (auto id : ids) {
+                auto& tmap = tm.get_tablet_map(id);
+                for (auto& t : tokens) {
+                    replica_sink += tmap.get_tablet_info(tmap.get_tablet_id(t)).replicas.size();
+                    thread::maybe_yield();
+                }
+                nr_lookups += tokens.size();
+            }
+        });
+        assert(replica_sink == nr_lookups * rf);
+
+        testlog.info("Looked up replicas of {} tokens at {:.3f} [Mlookups/s]", nr_lookups, nr_lookups / time_to_lookup.count() / 1e6);
+
         auto time_to_save = duration_in_seconds([&] {
             save_tablet_metadata(e.local_db(), tm, api::new_timestamp()).get();
         });
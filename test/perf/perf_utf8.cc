@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/perf_tests.hh>
+
+#include "utils/ascii.hh"
+#include "utils/utf8.hh"
+#include "utils/fragmented_temporary_buffer.hh"
+
+class text_validation {
+public:
+    static constexpr size_t size = 64 * 1024;
+    static constexpr size_t fragment_size = 8 * 1024 + 3;
+private:
+    bytes _ascii;
+    bytes _utf8;
+    fragmented_temporary_buffer _utf8_fragmented;
+
+    static bytes make(std::string_view pattern) {
+        bytes b(bytes::initialized_later(), size);
+        for (size_t i = 0; i < size; i += pattern.size()) {
+            std::copy_n(pattern.begin(), std::min(pattern.size(), size - i), b.begin() + i);
+        }
+        // Don't end in the middle of a codepoint
+        std::fill(b.end() - pattern.size(), b.end(), 'x');
+        return b;
+    }
+
+    static fragmented_temporary_buffer fragmentize(bytes_view b) {
+        std::vector<temporary_buffer<char>> frags;
+        for (size_t i = 0; i < b.size(); i += fragment_size) {
+            auto n = std::min(fragment_size, b.size() - i);
+            frags.emplace_back(reinterpret_cast<const char*>(b.data() + i), n);
+        }
+        return fragmented_temporary_buffer(std::move(frags), b.size());
+    }
+public:
+    text_validation()
+        : _ascii(make("The quick brown fox jumps over the lazy dog. "))
+        , _utf8(make("Zw\xc3\xb6lf Boxk\xc3\xa4mpfer jagen \xe2\x82\xac \xf0\x9f\x98\x80 "))
+        , _utf8_fragmented(fragmentize(_utf8))
+    {}
+
+    bytes_view ascii() const { return _ascii; }
+    bytes_view utf8() const { return _utf8; }
+    fragmented_temporary_buffer::view utf8_fragmented() const { return fragmented_temporary_buffer::view(_utf8_fragmented); }
+};
+
+PERF_TEST_F(text_validation, ascii) {
+    perf_tests::do_not_optimize(utils::ascii::validate(ascii()));
+    return size;
+}
+
+PERF_TEST_F(text_validation, utf8_ascii_only) {
+    perf_tests::do_not_optimize(utils::utf8::validate(ascii()));
+    return size;
+}
+
+PERF_TEST_F(text_validation, utf8) {
+    perf_tests::do_not_optimize(utils::utf8::validate(utf8()));
+    return size;
+}
+
+PERF_TEST_F(text_validation, utf8_fragmented) {
+    perf_tests::do_not_optimize(utils::utf8::validate_with_error_position_fragmented(utf8_fragmented()));
+    return size;
+}
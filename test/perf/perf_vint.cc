@@ -9,6 +9,7 @@
 #include <seastar/testing/perf_tests.hh>
 #include <seastar/testing/test_runner.hh>
 
+#include <limits>
 #include <random>
 
 #include "vint-serialization.hh"
@@ -20,12 +21,15 @@ class vint {
     std::vector<uint64_t> _integers;
     bytes _serialized;
 public:
-    vint()
+    // With max_bits of 64 almost all values take the full 9 bytes. Smaller
+    // values, like the timestamp deltas and lengths in sstables, spread
+    // over the shorter encodings.
+    explicit vint(unsigned max_bits = 64)
         : _integers(count)
         , _serialized(bytes::initialized_later{}, count * max_vint_length)
     {
         auto eng = seastar::testing::local_random_engine;
-        auto dist = std::uniform_int_distribution<uint64_t>{};
+        auto dist = std::uniform_int_distribution<uint64_t>{0, max_bits == 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << max_bits) - 1};
         std::generate_n(_integers.begin(), count, [&] { return dist(eng); });
 
         auto dst = _serialized.data();
@@ -39,6 +43,11 @@ class vint {
     bytes_view serialized() const { return bytes_view(_serialized.data()); }
 };
 
+class small_vint : public vint {
+public:
+    small_vint() : vint(28) { }
+};
+
 PERF_TEST_F(vint, serialize) {
     std::array<int8_t, max_vint_length> output;
     auto dst = output.data();
@@ -58,3 +67,23 @@ PERF_TEST_F(vint, deserialize) {
     }
     return count;
 }
+
+PERF_TEST_F(small_vint, serialize) {
+    std::array<int8_t, max_vint_length> output;
+    auto dst = output.data();
+    for (auto v : integers()) {
+        perf_tests::do_not_optimize(unsigned_vint::serialize(v, dst));
+        perf_tests::do_not_optimize(dst);
+    }
+    return count;
+}
+
+PERF_TEST_F(small_vint, deserialize) {
+    auto src = serialized();
+    for (auto i = 0u; i < count; i++) {
+        auto len = unsigned_vint::serialized_size_from_first_byte(src.front());
+        perf_tests::do_not_optimize(unsigned_vint::deserialize(src));
+        src.remove_prefix(len);
+    }
+    return count;
+}
@@ -1570,6 +1570,36 @@ BOOST_AUTO_TEST_CASE(test_non_voter_stays_pipeline) {
     BOOST_CHECK(A.get_progress(B_id).state == raft::follower_progress::state::PIPELINE);
 }
 
+BOOST_AUTO_TEST_CASE(test_pipeline_in_flight_limit) {
+    // Check that in PIPELINE mode the leader sends no more than
+    // max_in_flight_append_requests requests to a follower
+    // before they are acknowledged.
+    server_id A_id = id(), B_id = id();
+    raft::log log(raft::snapshot_descriptor{.idx = index_t{0}, .config = config_from_ids({A_id, B_id})});
+    auto cfg = fsm_cfg;
+    cfg.max_in_flight_append_requests = 2;
+    fsm_debug A(A_id, raft::term_t{}, raft::server_id{}, log, trivial_failure_detector, cfg);
+    fsm_debug B(B_id, raft::term_t{}, raft::server_id{}, log, trivial_failure_detector, cfg);
+    election_timeout(A);
+    communicate(A, B);
+    BOOST_CHECK(A.is_leader());
+    BOOST_CHECK(A.get_progress(B_id).state == raft::follower_progress::state::PIPELINE);
+    for (int i = 0; i < 5; ++i) {
+        A.add_entry(log_entry::dummy{});
+    }
+    auto output = A.get_output();
+    size_t append_requests = 0;
+    for (const auto& [to, msg] : output.messages) {
+        append_requests += to == B_id && std::holds_alternative<raft::append_request>(msg);
+    }
+    BOOST_CHECK_EQUAL(append_requests, 2);
+    // Acknowledging the requests lets the rest through
+    raft_routing_map routes{{A_id, &A}, {B_id, &B}};
+    deliver(routes, A_id, std::move(output.messages));
+    communicate(A, B);
+    BOOST_CHECK_EQUAL(A.get_progress(B_id).match_idx, A.log_last_idx());
+}
+
 BOOST_AUTO_TEST_CASE(test_leader_change_to_non_voter) {
     // Test a two-node cluster, change a leader to a non-voter.
     server_id A_id = id(), B_id = id();
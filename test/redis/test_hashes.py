@@ -151,3 +151,16 @@ def test_hexists(redis_host, redis_port):
     assert r.hexists(key, field) == 0
     assert r.hset(key, field, random_string(10)) == 1
     assert r.hexists(key, field) == 1
+
+def test_hmget(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    fields = [random_string(10) for _ in range(3)]
+    vals = [random_string(10) for _ in range(3)]
+    missing = random_string(10)
+
+    for field, val in zip(fields, vals):
+        assert r.hset(key, field, val) == 1
+    # The values come in the order of the fields, with None for missing fields
+    assert r.hmget(key, [fields[2], missing, fields[0], fields[2]]) == [vals[2], None, vals[0], vals[2]]
+    assert r.hmget(random_string(10), fields) == [None, None, None]
@@ -0,0 +1,32 @@
+#
+# Copyright (C) 2023-present ScyllaDB
+#
+
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_push_lrange(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.lrange(key, 0, -1) == []
+    # Pushing returns the length of the list
+    assert r.rpush(key, 'b', 'c') == 2
+    assert r.lpush(key, 'a') == 3
+    assert r.rpush(key, 'd') == 4
+    assert r.lpush(key, 'y', 'z') == 6
+    assert r.lrange(key, 0, -1) == ['z', 'y', 'a', 'b', 'c', 'd']
+    assert r.lrange(key, 1, 2) == ['y', 'a']
+    assert r.lrange(key, -2, -1) == ['c', 'd']
+    assert r.lrange(key, 4, 100) == ['c', 'd']
+    assert r.lrange(key, 3, 1) == []
+    assert r.delete(key) == 1
+    assert r.lrange(key, 0, -1) == []
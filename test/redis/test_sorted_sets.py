@@ -0,0 +1,65 @@
+#
+# Copyright (C) 2023-present ScyllaDB
+#
+
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from concurrent.futures import ThreadPoolExecutor
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_zadd_zscore_zrem(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.zadd(key, {'a': 1, 'b': 2.5}) == 2
+    assert r.zscore(key, 'a') == 1
+    assert r.zscore(key, 'b') == 2.5
+    assert r.zscore(key, 'c') == None
+    # Changing the score of a member doesn't add it
+    assert r.zadd(key, {'a': 3, 'c': -1}) == 1
+    assert r.zscore(key, 'a') == 3
+    assert r.zrangebyscore(key, '-inf', '+inf') == ['c', 'b', 'a']
+    assert r.zrem(key, 'a', 'd') == 1
+    assert r.zscore(key, 'a') == None
+    assert r.zrangebyscore(key, '-inf', '+inf') == ['c', 'b']
+    assert r.delete(key) == 1
+    assert r.zrangebyscore(key, '-inf', '+inf') == []
+
+def test_zrangebyscore(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    # Members with the same score are ordered by member
+    r.zadd(key, {'a': -2, 'b': 0, 'c': 0, 'd': 1.5, 'e': 10})
+    assert r.zrangebyscore(key, 0, 10) == ['b', 'c', 'd', 'e']
+    assert r.zrangebyscore(key, '(0', '(10') == ['d']
+    assert r.zrangebyscore(key, '-inf', 0, withscores=True) == [('a', -2), ('b', 0), ('c', 0)]
+    assert r.zrangebyscore(key, 5, 1) == []
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.zrangebyscore(key, 'x', 1)
+    assert "min or max is not a float" in str(excinfo.value)
+    r.delete(key)
+
+def test_concurrent_zadd(redis_host, redis_port):
+    key = random_string(10)
+    connections = [connect(redis_host, redis_port) for _ in range(4)]
+
+    # Concurrent changes of the score of a member leave it once in the set,
+    # with the score of one of them
+    with ThreadPoolExecutor(len(connections)) as executor:
+        for i in range(20):
+            scores = [i * len(connections) + j for j in range(len(connections))]
+            list(executor.map(lambda c, score: c.zadd(key, {'a': score}), connections, scores))
+            members = connections[0].zrangebyscore(key, '-inf', '+inf', withscores=True)
+            assert len(members) == 1
+            assert members[0][0] == 'a'
+            assert members[0][1] in scores
+            assert connections[0].zscore(key, 'a') == members[0][1]
+    connections[0].delete(key)
@@ -231,3 +231,32 @@ def test_strlen_wrongtype(redis_host, redis_port):
         r.strlen(key1)
     except redis.exceptions.ResponseError as ex:
         assert str(ex) == 'WRONGTYPE Operation against a key holding the wrong kind of value'
+
+def test_mset_mget(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    keys = [random_string(10) for _ in range(5)]
+    vals = [random_string(10) for _ in range(5)]
+    missing = random_string(10)
+    r.delete(missing)
+
+    assert r.mset(dict(zip(keys, vals))) == True
+    assert r.mget(keys) == vals
+    # The values come in the order of the keys, with None for missing keys
+    assert r.mget([keys[3], missing, keys[0], keys[3]]) == [vals[3], None, vals[0], vals[3]]
+
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command("MSET", keys[0])
+    assert "wrong number of arguments for 'mset' command" in str(excinfo.value)
+
+def test_pipeline(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    keys = [random_string(10) for _ in range(50)]
+    vals = [random_string(10) for _ in range(50)]
+
+    p = r.pipeline(transaction=False)
+    for key, val in zip(keys, vals):
+        p.set(key, val)
+    for key in keys:
+        p.get(key)
+    # The replies come in the order of the requests
+    assert p.execute() == [True] * len(keys) + vals
@@ -161,9 +161,50 @@ gc_clock::time_point tombstone_gc_state::get_gc_before_for_key(schema_ptr s, con
     std::abort();
 }
 
+void repair_history_map::update_repair_time(const dht::token_range& range, gc_clock::time_point repair_time) {
+    map += std::make_pair(locator::token_metadata::range_to_interval(range), repair_time);
+    if (map.iterative_size() > max_ranges) {
+        // Halve the map, so it's not coalesced again by each of the next updates.
+        coalesce(max_ranges / 2);
+    }
+}
+
+void repair_history_map::coalesce(size_t target) {
+    // The repair time difference between each range and the previous one, if they touch.
+    std::vector<gc_clock::duration> gaps;
+    gaps.reserve(map.iterative_size());
+    for (auto prev = map.begin(), it = std::next(prev); it != map.end(); prev = it++) {
+        if (boost::icl::touches(prev->first, it->first)) {
+            gaps.push_back(prev->second > it->second ? prev->second - it->second : it->second - prev->second);
+        }
+    }
+    auto to_merge = std::min(gaps.size(), map.iterative_size() - std::min(target, map.iterative_size()));
+    if (!to_merge) {
+        return;
+    }
+    std::nth_element(gaps.begin(), gaps.begin() + (to_merge - 1), gaps.end());
+    const auto max_gap = gaps[to_merge - 1];
+
+    decltype(map) coalesced;
+    std::pair<decltype(map)::interval_type, gc_clock::time_point> merged = *map.begin();
+    for (auto it = std::next(map.begin()); it != map.end(); ++it) {
+        auto gap = merged.second > it->second ? merged.second - it->second : it->second - merged.second;
+        if (boost::icl::touches(merged.first, it->first) && gap <= max_gap) {
+            merged.first = boost::icl::hull(merged.first, it->first);
+            merged.second = std::min(merged.second, it->second);
+        } else {
+            coalesced.add(merged);
+            merged = *it;
+        }
+    }
+    coalesced.add(merged);
+    dblog.debug("Coalesced repair history from {} to {} ranges", map.iterative_size(), coalesced.iterative_size());
+    map = std::move(coalesced);
+}
+
 void tombstone_gc_state::update_repair_time(table_id id, const dht::token_range& range, gc_clock::time_point repair_time) {
     auto m = get_or_create_repair_history_map_for_table(id);
-    m->map += std::make_pair(locator::token_metadata::range_to_interval(range), repair_time);
+    m->update_repair_time(range, repair_time);
 }
 
 static bool needs_repair_before_gc(const replica::database& db, sstring ks_name) {
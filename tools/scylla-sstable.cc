@@ -8,11 +8,13 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/join.hpp>
+#include <boost/range/irange.hpp>
 #include <filesystem>
 #include <source_location>
 #include <fmt/chrono.h>
 #include <seastar/core/app-template.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/util/closeable.hh>
 
 #include "compaction/compaction.hh"
@@ -671,6 +673,177 @@ class dumping_consumer : public sstable_consumer {
     virtual future<> consume_stream_end() override { return _consumer->consume_stream_end(); }
 };
 
+// Writes the live rows as CSV to stdout, a line per row, with a column per
+// column of the schema. Deletions are applied as far as they are found in the
+// stream, so sstables have to be merged to get what CQL would return.
+class csv_exporting_consumer : public sstable_consumer {
+    schema_ptr _schema;
+    gc_clock::time_point _now = gc_clock::now();
+    std::vector<sstring> _partition_key;
+    std::vector<sstring> _static_values;
+    tombstone _partition_tombstone;
+    tombstone _range_tombstone;
+    bool _has_live_static_row = false;
+    bool _wrote_row = false;
+    sstring _line;
+
+private:
+    static void append_field(sstring& line, std::string_view value) {
+        if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+            line.append(value.data(), value.size());
+            return;
+        }
+        line += "\"";
+        for (auto c : value) {
+            if (c == '"') {
+                line += "\"";
+            }
+            line.append(&c, 1);
+        }
+        line += "\"";
+    }
+    sstring atomic_value(atomic_cell_view cell, const abstract_type& type) const {
+        if (type.is_counter()) {
+            return cell.is_counter_update() ? to_sstring(cell.counter_update_value()) : to_sstring(counter_cell_view(cell).total_value());
+        }
+        return type.to_string(cell.value().linearize());
+    }
+    sstring collection_value(collection_mutation_view_description mv, const abstract_type& type, tombstone t) const {
+        t.apply(mv.tomb);
+        std::vector<sstring> elements;
+        for (size_t i = 0; i < mv.cells.size(); ++i) {
+            auto& [key, cell] = mv.cells[i];
+            if (!cell.is_live(t, _now, false)) {
+                continue;
+            }
+            if (auto map = dynamic_cast<const map_type_impl*>(&type)) {
+                elements.push_back(format("{}: {}", map->get_keys_type()->to_string(key), atomic_value(cell, *map->get_values_type())));
+            } else if (auto set = dynamic_cast<const set_type_impl*>(&type)) {
+                elements.push_back(set->get_elements_type()->to_string(key));
+            } else if (auto list = dynamic_cast<const list_type_impl*>(&type)) {
+                elements.push_back(atomic_value(cell, *list->get_elements_type()));
+            } else if (auto user = dynamic_cast<const user_type_impl*>(&type)) {
+                auto index = deserialize_field_index(key);
+                elements.push_back(format("{}: {}", user->field_name_as_string(index), atomic_value(cell, *user->type(index))));
+            }
+        }
+        if (elements.empty()) {
+            return "";
+        }
+        auto joined = boost::algorithm::join(elements, ", ");
+        return type.is_list() ? format("[{}]", joined) : format("{{{}}}", joined);
+    }
+    sstring cell_value(const atomic_cell_or_collection& cell, const column_definition& cdef, tombstone t) const {
+        if (cdef.is_atomic()) {
+            auto acv = cell.as_atomic_cell(cdef);
+            return acv.is_live(t, _now, cdef.is_counter()) ? atomic_value(acv, *cdef.type) : sstring();
+        }
+        sstring value;
+        cell.as_collection_mutation().with_deserialized(*cdef.type, [&] (collection_mutation_view_description mv) {
+            value = collection_value(std::move(mv), *cdef.type, t);
+        });
+        return value;
+    }
+    std::vector<sstring> row_values(const row& r, column_kind kind, tombstone t) const {
+        std::vector<sstring> values(kind == column_kind::static_column ? _schema->static_columns_count() : _schema->regular_columns_count());
+        r.for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
+            values[id] = cell_value(cell, _schema->column_at(kind, id), t);
+        });
+        return values;
+    }
+    void write_line(const std::vector<sstring>& clustering_key, const std::vector<sstring>& regular_values) {
+        _line = "";
+        bool first = true;
+        auto append = [&] (const std::vector<sstring>& values, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                if (!std::exchange(first, false)) {
+                    _line += ",";
+                }
+                append_field(_line, i < values.size() ? std::string_view(values[i]) : std::string_view());
+            }
+        };
+        append(_partition_key, _schema->partition_key_size());
+        append(clustering_key, _schema->clustering_key_size());
+        append(_static_values, _schema->static_columns_count());
+        append(regular_values, _schema->regular_columns_count());
+        _line += "\n";
+        std::cout.write(_line.data(), _line.size());
+        _wrote_row = true;
+    }
+    static std::vector<sstring> key_values(const schema& s, const std::vector<bytes>& components, const schema::const_iterator_range_type& columns) {
+        std::vector<sstring> values;
+        values.reserve(components.size());
+        auto it = columns.begin();
+        for (auto& c : components) {
+            values.push_back(it++->type->to_string(c));
+        }
+        return values;
+    }
+
+public:
+    explicit csv_exporting_consumer(schema_ptr s, reader_permit, const bpo::variables_map&) : _schema(std::move(s)) { }
+    virtual future<> consume_stream_start() override {
+        std::vector<sstring> names;
+        for (auto& cdef : _schema->all_columns()) {
+            names.push_back(cdef.name_as_text());
+        }
+        _line = "";
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (i) {
+                _line += ",";
+            }
+            append_field(_line, names[i]);
+        }
+        _line += "\n";
+        std::cout.write(_line.data(), _line.size());
+        return make_ready_future<>();
+    }
+    virtual future<stop_iteration> consume_sstable_start(const sstables::sstable* const sst) override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_start&& ps) override {
+        _partition_key = key_values(*_schema, ps.key().key().explode(*_schema), _schema->partition_key_columns());
+        _static_values.clear();
+        _partition_tombstone = ps.partition_tombstone();
+        _range_tombstone = {};
+        _has_live_static_row = false;
+        _wrote_row = false;
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(static_row&& sr) override {
+        _static_values = row_values(sr.cells(), column_kind::static_column, _partition_tombstone);
+        _has_live_static_row = sr.is_live(*_schema, _now);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(clustering_row&& cr) override {
+        auto t = _partition_tombstone;
+        t.apply(_range_tombstone);
+        t.apply(cr.tomb().tomb());
+        if (cr.is_live(*_schema, t, _now)) {
+            write_line(key_values(*_schema, cr.key().explode(*_schema), _schema->clustering_key_columns()), row_values(cr.cells(), column_kind::regular_column, t));
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(range_tombstone_change&& rtc) override {
+        _range_tombstone = rtc.tombstone();
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_end&& pe) override {
+        // Like CQL, a partition with only static data has a row with null clustering columns.
+        if (!_wrote_row && _has_live_static_row) {
+            write_line({}, {});
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume_sstable_end() override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<> consume_stream_end() override {
+        std::cout.flush();
+        return make_ready_future<>();
+    }
+};
+
 class writetime_histogram_collecting_consumer : public sstable_consumer {
 private:
     enum class bucket {
@@ -1036,6 +1209,26 @@ class operation {
     }
 };
 
+// Runs func for each sstable, on up to --parallel sstables concurrently, and
+// calls report with the results in the order of the sstables, as soon as all
+// sstables before it are reported.
+template <typename Result>
+void for_each_sstable_in_parallel(const std::vector<sstables::shared_sstable>& sstables, const bpo::variables_map& vm,
+        std::function<future<Result>(const sstables::shared_sstable&)> func,
+        std::function<void(const sstables::shared_sstable&, const Result&)> report) {
+    const auto parallel = std::max(vm["parallel"].as<unsigned>(), 1u);
+    std::vector<std::optional<Result>> results(sstables.size());
+    size_t next_to_report = 0;
+    max_concurrent_for_each(boost::irange(size_t(0), sstables.size()), parallel, [&] (size_t i) {
+        return func(sstables[i]).then([&, i] (Result result) {
+            results[i] = std::move(result);
+            for (; next_to_report < results.size() && results[next_to_report]; ++next_to_report) {
+                report(sstables[next_to_report], *results[next_to_report]);
+            }
+        });
+    }).get();
+}
+
 void validate_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
         sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
     if (sstables.empty()) {
@@ -1043,10 +1236,11 @@ void validate_operation(schema_ptr schema, reader_permit permit, const std::vect
     }
 
     abort_source abort;
-    for (const auto& sst : sstables) {
-        const auto errors = sst->validate(permit, abort, [] (sstring what) { sst_log.info("{}", what); }).get();
+    for_each_sstable_in_parallel<uint64_t>(sstables, vm, [&] (const sstables::shared_sstable& sst) {
+        return sst->validate(permit, abort, [&sst] (sstring what) { sst_log.info("{}: {}", sst->get_filename(), what); });
+    }, [] (const sstables::shared_sstable& sst, const uint64_t& errors) {
         fmt::print("{}: {}\n", sst->get_filename(), errors == 0 ? "valid" : "invalid");
-    }
+    });
 }
 
 void scrub_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
@@ -1637,15 +1831,16 @@ void dump_scylla_metadata_operation(schema_ptr schema, reader_permit permit, con
 }
 
 void validate_checksums_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
-        sstables::sstables_manager& sst_man, const bpo::variables_map&) {
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
     if (sstables.empty()) {
         throw std::invalid_argument("no sstables specified on the command line");
     }
 
-    for (auto& sst : sstables) {
-        const auto valid = sstables::validate_checksums(sst, permit).get();
+    for_each_sstable_in_parallel<bool>(sstables, vm, [&] (const sstables::shared_sstable& sst) {
+        return sstables::validate_checksums(sst, permit);
+    }, [] (const sstables::shared_sstable& sst, const bool& valid) {
         sst_log.info("validated the checksums of {}: {}", sst->get_filename(), valid ? "valid" : "invalid");
-    }
+    });
 }
 
 void decompress_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
@@ -2704,6 +2899,7 @@ const std::vector<operation_option> all_options {
     typed_option<std::string>("script-file", "script file to load and execute"),
     typed_option<program_options::string_map>("script-arg", {}, "parameter(s) for the script"),
     typed_option<std::string>("scrub-mode", "scrub mode to use, one of (abort, skip, segregate, validate)"),
+    typed_option<unsigned>("parallel", 1, "number of sstables to process concurrently, the results are still reported in the order of the sstables"),
     typed_option<>("unsafe-accept-nonempty-output-dir", "allow the operation to write into a non-empty output directory, acknowledging the risk that this may result in sstable clash"),
 };
 
@@ -2838,6 +3034,28 @@ following example python script:
 )",
             {"bucket"},
             sstable_consumer_operation<writetime_histogram_collecting_consumer>},
+/* export */
+    {"export",
+            "Export the live rows of the sstable(s) as CSV",
+R"(
+Write the live rows of the data component to stdout as CSV, without going
+through CQL, for consumption by external analytics tools. The first line is a
+header with the names of the columns, in the order of the partition key,
+clustering key, static and regular columns. Each following line is a row, with
+its values printed in their CQL text form. Null values are empty fields.
+Collections and non-frozen user types are printed with only their live
+elements. A partition with only static data is exported as a row with empty
+clustering columns, like CQL does.
+
+Deletions are applied as far as they are found in the mutation fragment stream,
+so use --merge to export what CQL would return when the table has more than one
+sstable. Expired cells are considered dead as of the time of the export.
+
+It is possible to filter the partitions to export via the --partitions or
+--partitions-file options.
+)",
+            {"partition", "partitions-file", "merge", "no-skips"},
+            sstable_consumer_operation<csv_exporting_consumer>},
 /* validate */
     {"validate",
             "Validate the sstable(s), same as scrub in validate mode",
@@ -2851,7 +3069,7 @@ validation will happen on the fragment level.
 See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#validate
 for more information on this operation.
 )",
-            {},
+            {"parallel"},
             validate_operation},
 /* scrub */
     {"scrub",
@@ -2884,6 +3102,7 @@ component.
 See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#validate-checksums
 for more information on this operation.
 )",
+            {"parallel"},
             validate_checksums_operation},
 /* decompress */
     {"decompress",
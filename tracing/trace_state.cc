@@ -108,11 +108,16 @@ void trace_state::add_prepared_query_options(const cql3::query_options& prepared
 }
 
 void trace_state::build_parameters_map() {
+    auto& params_map = _records->session_rec.parameters;
+
+    if (!_read_profile.empty()) {
+        params_map.emplace("read_profile", fmt::to_string(_read_profile));
+    }
+
     if (!_params_ptr) {
         return;
     }
 
-    auto& params_map = _records->session_rec.parameters;
     params_values& vals = *_params_ptr;
 
     if (vals.batchlog_endpoints) {
@@ -210,6 +215,11 @@ void trace_state::stop_foreground_and_write() noexcept {
     }
 
     if (is_in_state(state::foreground)) {
+        // Primary sessions report the profile in their parameters
+        if (!is_primary() && !_read_profile.empty()) {
+            trace("Read profile: {}", _read_profile);
+        }
+
         auto e = elapsed();
         _records->do_log_slow_query = should_log_slow_query(e);
 
@@ -232,7 +242,7 @@ void trace_state::stop_foreground_and_write() noexcept {
             // These events should be really rare however, therefore we don't
             // want to optimize this flow (e.g. rollback the corresponding
             // events' records that have already been sent to I/O).
-            if (should_write_records()) {
+            if (should_write_records() && !write_to_memory()) {
                 try {
                     build_parameters_map();
                 } catch (...) {
@@ -249,13 +259,36 @@ void trace_state::stop_foreground_and_write() noexcept {
 
     trace_state_logger.trace("{}: Current records count is {}",  session_id(), _records->size());
 
-    if (should_write_records()) {
+    if (should_write_records() && write_to_memory()) {
+        record_sampled_session();
+        _records->drop_records();
+    } else if (should_write_records()) {
         _local_tracing_ptr->write_session_records(_records, write_on_close());
     } else {
         _records->drop_records();
     }
 }
 
+void trace_state::record_sampled_session() noexcept {
+    sampled_session_record rec;
+    const session_record& session_rec = _records->session_rec;
+    rec.session_id = session_id();
+    rec.command = type();
+    rec.primary = is_primary();
+    rec.events = _records->events_recs.size();
+    if (is_primary()) {
+        rec.started_at = session_rec.started_at;
+        rec.elapsed = session_rec.elapsed;
+        rec.client = session_rec.client;
+        rec.request_size = std::min(session_rec.request.size(), sampled_session_record::max_request_size);
+        std::copy_n(session_rec.request.begin(), rec.request_size, rec.request.begin());
+    } else {
+        rec.elapsed = elapsed();
+        rec.started_at = std::chrono::system_clock::now() - std::chrono::duration_cast<std::chrono::system_clock::duration>(rec.elapsed);
+    }
+    _local_tracing_ptr->record_sampled_session(rec);
+}
+
 sstring trace_state::raw_value_to_sstring(const cql3::raw_value_view& v, bool is_unset, const data_type& t) {
     static constexpr int max_val_bytes = 64;
 
@@ -285,3 +318,8 @@ sstring trace_state::raw_value_to_sstring(const cql3::raw_value_view& v, bool is
     }
 }
 }
+
+auto fmt::formatter<tracing::read_profile>::format(const tracing::read_profile& p, fmt::format_context& ctx) const -> decltype(ctx.out()) {
+    return fmt::format_to(ctx.out(), "sstables_read={} bytes_read={} cache_row_hits={} cache_row_misses={} tombstones={} admission_wait={}us cpu_time={}us",
+            p.sstables_read, p.bytes_read, p.cache_row_hits, p.cache_row_misses, p.tombstones, p.admission_wait.count(), p.cpu_time.count());
+}
@@ -38,6 +38,30 @@ extern logging::logger trace_state_logger;
 
 using prepared_checked_weak_ptr = seastar::checked_ptr<seastar::weak_ptr<cql3::statements::prepared_statement>>;
 
+/**
+ * Counters of the work done by the reads of a traced session.
+ *
+ * They are updated by the reader_permit of each read as the read proceeds
+ * and reported in the session parameters (for a primary session, so that
+ * they also reach the slow query log) or as an event (for a secondary one).
+ */
+struct read_profile {
+    uint64_t sstables_read = 0;
+    uint64_t bytes_read = 0;
+    uint64_t cache_row_hits = 0;
+    uint64_t cache_row_misses = 0;
+    uint64_t tombstones = 0;
+    std::chrono::microseconds admission_wait{0};
+    // Time the reads spent needing CPU without awaiting I/O. Other tasks
+    // may run in between, so it's an upper bound of the CPU time.
+    std::chrono::microseconds cpu_time{0};
+
+    bool empty() const noexcept {
+        return !sstables_read && !bytes_read && !cache_row_hits && !cache_row_misses && !tombstones
+                && !admission_wait.count() && !cpu_time.count();
+    }
+};
+
 class trace_state final {
 public:
     // A primary session may be in 3 states:
@@ -72,6 +96,7 @@ class trace_state final {
     std::optional<uint64_t> _supplied_start_ts_us; // Parent's `_start`, as microseconds from POSIX epoch.
     std::chrono::microseconds _slow_query_threshold;
     state _state = state::inactive;
+    read_profile _read_profile;
 
     struct params_values;
     struct params_values_deleter {
@@ -155,6 +180,10 @@ class trace_state final {
         return _records->session_rec.command;
     }
 
+    read_profile& get_read_profile() noexcept {
+        return _read_profile;
+    }
+
     bool is_primary() const {
         return _state_props.contains(trace_state_props::primary);
     }
@@ -242,6 +271,24 @@ class trace_state final {
         return full_tracing() || _records->do_log_slow_query;
     }
 
+    /**
+     * Sampled sessions are the fully traced ones not requested by the client
+     * (clients requests are write_on_close). They are kept in memory if so
+     * configured, unless they are to be logged as slow queries.
+     */
+    bool keep_in_memory() const {
+        return full_tracing() && !write_on_close() && _local_tracing_ptr->sampled_sessions_in_memory();
+    }
+
+    bool write_to_memory() const {
+        return keep_in_memory() && !_records->do_log_slow_query;
+    }
+
+    /**
+     * Summarizes the session in the sampled sessions ring buffer.
+     */
+    void record_sampled_session() noexcept;
+
     /**
      * Returns the amount of time passed since the beginning of this tracing session.
      *
@@ -557,7 +604,7 @@ inline void trace_state::trace_internal(std::string&& message) {
         // We don't want to write records of a tracing session if we trace only
         // slow queries and the elapsed time is still below the slow query
         // logging threshold.
-        if (_records->events_recs.size() >= tracing::exp_trace_events_per_session && (full_tracing() || should_log_slow_query(e))) {
+        if (_records->events_recs.size() >= tracing::exp_trace_events_per_session && ((full_tracing() && !keep_in_memory()) || should_log_slow_query(e))) {
             _local_tracing_ptr->schedule_for_write(_records);
             _local_tracing_ptr->write_maybe();
         }
@@ -586,6 +633,10 @@ inline elapsed_clock::duration trace_state::elapsed() {
     return elapsed;
 }
 
+inline read_profile* get_read_profile(const trace_state_ptr& p) noexcept {
+    return p ? &p->get_read_profile() : nullptr;
+}
+
 inline void set_page_size(const trace_state_ptr& p, int32_t val) {
     if (p) {
         p->set_page_size(val);
@@ -796,3 +847,7 @@ class global_trace_state_ptr {
     operator trace_state_ptr() const { return get(); }
 };
 }
+
+template <> struct fmt::formatter<tracing::read_profile> : fmt::formatter<std::string_view> {
+    auto format(const tracing::read_profile&, fmt::format_context& ctx) const -> decltype(ctx.out());
+};
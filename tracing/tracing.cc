@@ -50,6 +50,9 @@ tracing::tracing(sstring tracing_backend_helper_class_name)
         sm::make_counter("trace_errors", stats.trace_errors,
                         sm::description("Counts a number of trace records dropped due to an error (e.g. OOM).")),
 
+        sm::make_counter("sampled_sessions", stats.sampled_sessions,
+                        sm::description("Counts a number of sampled sessions kept in memory instead of being written to the tables.")),
+
         sm::make_gauge("active_sessions", _active_sessions,
                         sm::description("Holds a number of a currently active tracing sessions.")),
 
@@ -193,6 +196,36 @@ future<> tracing::stop() {
     return make_ready_future<>();
 }
 
+void tracing::set_sampled_sessions_in_memory(bool enable) {
+    if (enable) {
+        _sampled_sessions.reserve(max_sampled_sessions);
+    }
+    _sampled_sessions_in_memory = enable;
+}
+
+void tracing::record_sampled_session(const sampled_session_record& rec) noexcept {
+    // Never allocates, the capacity is reserved when enabled
+    if (_sampled_sessions.size() < max_sampled_sessions) {
+        _sampled_sessions.push_back(rec);
+    } else {
+        _sampled_sessions[_sampled_sessions_next] = rec;
+    }
+    _sampled_sessions_next = (_sampled_sessions_next + 1) % max_sampled_sessions;
+    ++stats.sampled_sessions;
+}
+
+std::vector<sampled_session_record> tracing::get_sampled_sessions() const {
+    std::vector<sampled_session_record> ret;
+    ret.reserve(_sampled_sessions.size());
+    if (_sampled_sessions.size() == max_sampled_sessions) {
+        ret.insert(ret.end(), _sampled_sessions.begin() + _sampled_sessions_next, _sampled_sessions.end());
+        ret.insert(ret.end(), _sampled_sessions.begin(), _sampled_sessions.begin() + _sampled_sessions_next);
+    } else {
+        ret = _sampled_sessions;
+    }
+    return ret;
+}
+
 void tracing::set_trace_probability(double p) {
     if (p < 0 || p > 1) {
         throw std::out_of_range("trace probability must be in a [0,1] range");
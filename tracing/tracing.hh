@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <array>
 #include <vector>
 #include <atomic>
 #include <random>
@@ -221,6 +222,31 @@ struct session_record {
     }
 };
 
+/**
+ * A summary of a sampled tracing session, kept in memory instead of being
+ * written to the system_traces tables.
+ *
+ * Records have a fixed size, so that the per-shard ring buffer holding them
+ * doesn't allocate once it's created.
+ */
+struct sampled_session_record {
+    static constexpr size_t max_request_size = 128;
+
+    utils::UUID session_id;
+    std::chrono::system_clock::time_point started_at;
+    elapsed_clock::duration elapsed;
+    gms::inet_address client;
+    trace_type command = trace_type::NONE;
+    bool primary = false;
+    uint32_t events = 0;
+    uint32_t request_size = 0;
+    std::array<char, max_request_size> request;
+
+    std::string_view request_view() const {
+        return std::string_view(request.data(), request_size);
+    }
+};
+
 class one_session_records {
 private:
     shared_ptr<tracing> _local_tracing_ptr;
@@ -305,6 +331,8 @@ class tracing : public seastar::async_sharded_service<tracing> {
     static constexpr int write_event_records_threshold = write_event_sessions_threshold * exp_trace_events_per_session;
     // Number of events when an info message is printed
     static constexpr int log_warning_period = 10000;
+    // Number of sampled sessions kept in memory per shard
+    static constexpr size_t max_sampled_sessions = 4096;
 
     static const std::chrono::microseconds default_slow_query_duraion_threshold;
     static const std::chrono::seconds default_slow_query_record_ttl;
@@ -314,6 +342,7 @@ class tracing : public seastar::async_sharded_service<tracing> {
         uint64_t dropped_records = 0;
         uint64_t trace_records_count = 0;
         uint64_t trace_errors = 0;
+        uint64_t sampled_sessions = 0;
     } stats;
 
 private:
@@ -391,6 +420,15 @@ class tracing : public seastar::async_sharded_service<tracing> {
     std::ranlux48_base _gen;
     std::chrono::microseconds _slow_query_duration_threshold;
     std::chrono::seconds _slow_query_record_ttl;
+    // If _sampled_sessions_in_memory is enabled, sessions traced because of
+    // the trace probability are summarized in the _sampled_sessions ring
+    // buffer instead of being written to the tables, unless they turn out to
+    // be slow queries to be logged. Sessions requested by clients are
+    // written as usual.
+    bool _sampled_sessions_in_memory = false;
+    std::vector<sampled_session_record> _sampled_sessions;
+    // Where the next record goes, once _sampled_sessions is full
+    size_t _sampled_sessions_next = 0;
 
 public:
     uint64_t get_next_rand_uint64() {
@@ -520,6 +558,21 @@ class tracing : public seastar::async_sharded_service<tracing> {
         return _trace_probability;
     }
 
+    /**
+     * Keep sampled sessions in memory (see _sampled_sessions_in_memory).
+     *
+     * Allocates the ring buffer when enabled for the first time.
+     */
+    void set_sampled_sessions_in_memory(bool enable = true);
+    bool sampled_sessions_in_memory() const {
+        return _sampled_sessions_in_memory;
+    }
+
+    void record_sampled_session(const sampled_session_record& rec) noexcept;
+
+    // The sampled sessions kept in memory, oldest first
+    std::vector<sampled_session_record> get_sampled_sessions() const;
+
     bool trace_next_query() {
         return _normalized_trace_probability != 0 && _gen() < _normalized_trace_probability;
     }
@@ -92,6 +92,7 @@ future<> controller::do_start_server() {
             return cql_server_config {
               .timeout_config = updateable_timeout_config(cfg),
               .max_request_size = _mem_limiter.local().total_memory(),
+              .max_request_memory_per_connection = std::max<size_t>(_mem_limiter.local().total_memory() * std::clamp(cfg.cql_connection_memory_fraction(), 0.0, 1.0), 1),
               .partitioner_name = cfg.partitioner(),
               .sharding_ignore_msb = cfg.murmur3_partitioner_ignore_msb_bits(),
               .shard_aware_transport_port = shard_aware_transport_port,
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "transport/lz4_stream.hh"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace cql_transport {
+
+lz4_stream_compressor::lz4_stream_compressor() {
+    LZ4_initStream(&_stream, sizeof(_stream));
+}
+
+size_t lz4_stream_compressor::compress(bytes_view in, bytes_mutable_view out) {
+    int ret;
+    if (in.size() <= max_ring_frame_size) {
+        auto p = reserve(in.size());
+        std::memcpy(p, in.data(), in.size());
+        ret = LZ4_compress_fast_continue(&_stream, p, reinterpret_cast<char*>(out.data()), in.size(), out.size(), 1);
+    } else {
+        ret = LZ4_compress_fast_continue(&_stream, reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), out.size(), 1);
+        _pos = LZ4_saveDict(&_stream, _ring.get(), window_size);
+    }
+    if (ret <= 0) {
+        throw std::runtime_error("CQL frame LZ4 stream compression failure");
+    }
+    return ret;
+}
+
+lz4_stream_decompressor::lz4_stream_decompressor() {
+    LZ4_setStreamDecode(&_stream, nullptr, 0);
+}
+
+void lz4_stream_decompressor::decompress(bytes_view in, bytes_mutable_view out) {
+    auto src = reinterpret_cast<const char*>(in.data());
+    int ret;
+    if (out.size() <= max_ring_frame_size) {
+        auto p = reserve(out.size());
+        ret = LZ4_decompress_safe_continue(&_stream, src, p, in.size(), out.size());
+        if (ret > 0) {
+            std::memcpy(out.data(), p, ret);
+        }
+    } else {
+        auto dst = reinterpret_cast<char*>(out.data());
+        ret = LZ4_decompress_safe_continue(&_stream, src, dst, in.size(), out.size());
+        if (ret > 0) {
+            // The output buffer won't outlive the call, keep the history.
+            std::memcpy(_ring.get(), dst + ret - window_size, window_size);
+            LZ4_setStreamDecode(&_stream, _ring.get(), window_size);
+            _pos = window_size;
+        }
+    }
+    if (ret < 0) {
+        throw std::runtime_error("CQL frame LZ4 stream uncompression failure");
+    }
+    if (static_cast<size_t>(ret) != out.size()) {
+        throw std::runtime_error("Malformed CQL frame - provided uncompressed size different than real uncompressed size");
+    }
+}
+
+} // namespace cql_transport
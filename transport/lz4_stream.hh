@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <lz4.h>
+#include <memory>
+
+#include "bytes.hh"
+
+namespace cql_transport {
+
+// Stream-mode LZ4 compression of CQL frames, enabled by the
+// SCYLLA_LZ4_STREAM_COMPRESSION protocol extension.
+//
+// Each compressed frame of a connection may refer to the last 64 KiB of the
+// uncompressed contents of the frames compressed before it in the same
+// direction, which gives a much better ratio for small, repetitive frames
+// than compressing them independently. The LZ4 block format is unchanged.
+//
+// The history is kept in a ring buffer, large enough for the last history
+// window to stay in place while the next frame is appended after it. Frames
+// too large for that are processed in place and the history window copied
+// into the ring afterwards.
+class lz4_stream_history {
+public:
+    static constexpr size_t window_size = 64 * 1024;
+    static constexpr size_t ring_size = 4 * window_size;
+    // Larger frames don't go through the ring. The limit guarantees that a
+    // frame wrapped around to the start of the ring doesn't overwrite the
+    // window of history in front of it.
+    static constexpr size_t max_ring_frame_size = (ring_size - window_size) / 2;
+protected:
+    std::unique_ptr<char[]> _ring;
+    size_t _pos = 0;
+
+    lz4_stream_history() : _ring(std::make_unique<char[]>(ring_size)) { }
+
+    // Where to place a frame of the given size in the ring.
+    char* reserve(size_t size) {
+        if (_pos + size > ring_size) {
+            _pos = 0;
+        }
+        auto p = _ring.get() + _pos;
+        _pos += size;
+        return p;
+    }
+};
+
+class lz4_stream_compressor : private lz4_stream_history {
+    LZ4_stream_t _stream;
+public:
+    lz4_stream_compressor();
+
+    // Compresses the next frame into out, which must be at least
+    // LZ4_COMPRESSBOUND(in.size()) bytes long. Returns the compressed size.
+    size_t compress(bytes_view in, bytes_mutable_view out);
+};
+
+class lz4_stream_decompressor : private lz4_stream_history {
+    LZ4_streamDecode_t _stream;
+public:
+    lz4_stream_decompressor();
+
+    // Decompresses the next frame into out, which must be exactly as large as
+    // its uncompressed contents.
+    void decompress(bytes_view in, bytes_mutable_view out);
+};
+
+} // namespace cql_transport
@@ -13,12 +13,23 @@
 #include <seastar/core/sstring.hh>
 
 #include "seastarx.hh"
+#include "locator/tablets.hh"
 
 namespace cql_transport {
 namespace messages {
 
+// The replicas of the tablet owning the partition of a request, and the range
+// of tokens (first exclusive, last inclusive) of the tablet, for the client
+// to route the next requests to that partition. See TABLETS_ROUTING_V1 in
+// docs/dev/protocol-extensions.md.
+struct tablet_info {
+    locator::tablet_replica_set replicas;
+    std::pair<dht::token, dht::token> token_range;
+};
+
 class result_message {
     std::vector<sstring> _warnings;
+    std::optional<messages::tablet_info> _tablet_info;
 public:
     class visitor;
     class visitor_base;
@@ -35,6 +46,14 @@ class result_message {
         return _warnings;
     }
 
+    void add_tablet_info(locator::tablet_replica_set replicas, std::pair<dht::token, dht::token> token_range) {
+        _tablet_info = messages::tablet_info{std::move(replicas), std::move(token_range)};
+    }
+
+    const std::optional<messages::tablet_info>& get_tablet_info() const {
+        return _tablet_info;
+    }
+
     virtual std::optional<unsigned> move_to_shard() const {
         return std::nullopt;
     }
@@ -73,6 +73,7 @@ class response {
     void write_consistency(db::consistency_level c);
     void write_string_map(std::map<sstring, sstring> string_map);
     void write_string_multimap(std::multimap<sstring, sstring> string_map);
+    void write_bytes_map(const std::unordered_map<sstring, bytes>& bytes_map);
     void write_value(bytes_opt value);
     void write_value(std::optional<managed_bytes_view> value);
     void write(const cql3::metadata& m, bool skip = false);
@@ -80,7 +81,8 @@ class response {
 
     // Make a non-owning scattered_message of the response. Remains valid as long
     // as the response object is alive.
-    scattered_message<char> make_message(uint8_t version, cql_compression compression);
+    // With lz4 compression, lz4_stream selects the stream mode, see lz4_stream_compressor.
+    scattered_message<char> make_message(uint8_t version, cql_compression compression, lz4_stream_compressor* lz4_stream = nullptr);
 
     cql_binary_opcode opcode() const {
         return _opcode;
@@ -89,8 +91,8 @@ class response {
         return _body.size();
     }
 private:
-    void compress(cql_compression compression);
-    void compress_lz4();
+    void compress(cql_compression compression, lz4_stream_compressor* lz4_stream);
+    void compress_lz4(lz4_stream_compressor* lz4_stream);
     void compress_snappy();
 
     template <typename CqlFrameHeaderType>
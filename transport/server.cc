@@ -54,6 +54,7 @@
 
 #include <snappy-c.h>
 #include <lz4.h>
+#include "transport/lz4_stream.hh"
 
 #include "response.hh"
 #include "request.hh"
@@ -267,9 +268,16 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
                         sm::description(
                             seastar::format("Holds an incrementing counter with the requests that ever blocked due to reaching the memory quota limit ({}B). "
                                             "The first derivative of this value shows how often we block due to memory exhaustion in the \"CQL transport\" component.", _max_request_size))),
+        sm::make_counter("requests_blocked_connection_memory", _stats.requests_blocked_connection_memory,
+                        sm::description("Holds an incrementing counter with the requests that ever blocked because the requests of their connection used up "
+                                            "its share of the memory quota (configured via cql_connection_memory_fraction). Reading from such connections pauses until memory is released.")),
         sm::make_counter("requests_shed", _stats.requests_shed,
                         sm::description("Holds an incrementing counter with the requests that were shed due to overload (threshold configured via max_concurrent_requests_per_shard). "
                                             "The first derivative of this value shows how often we shed requests due to overload in the \"CQL transport\" component.")),
+        sm::make_counter("requests_forwarded", _stats.requests_forwarded,
+                        sm::description("Counts requests forwarded to the shard owning their data.")),
+        sm::make_counter("forwarded_request_batches", _stats.forwarded_request_batches,
+                        sm::description("Counts the cross-shard calls which forwarded requests to the shard owning their data. Requests forwarded to the same shard at the same time share a call.")),
         sm::make_gauge("requests_memory_available", [this] { return _memory_available.current(); },
                         sm::description(
                             seastar::format("Holds the amount of available memory for admitting new requests (max is {}B)."
@@ -325,6 +333,13 @@ cql_server::unadvertise_connection(shared_ptr<generic_server::connection> raw_co
     return make_ready_future<>();
 }
 
+future<std::vector<generic_server::server::shard_load>>
+cql_server::get_shard_loads() {
+    return container().map([] (cql_server& server) {
+        return server.get_shard_load();
+    });
+}
+
 unsigned
 cql_server::connection::frame_size() const {
     return 9;
@@ -593,6 +608,7 @@ cql_server::connection::connection(cql_server& server, socket_address server_add
     , _server(server)
     , _server_addr(server_addr)
     , _client_state(service::client_state::external_tag{}, server._auth_service, &server._sl_controller, server.timeout_config(), addr)
+    , _request_memory_available(server._config.max_request_memory_per_connection)
 {
     _shedding_timer.set_callback([this] {
         clogger.debug("Shedding all incoming requests due to overload");
@@ -624,6 +640,8 @@ client_data cql_server::connection::make_client_data() const {
     if (const auto user_ptr = _client_state.user(); user_ptr) {
         cd.username = user_ptr->name;
     }
+    cd.request_memory_used = _server._config.max_request_memory_per_connection - _request_memory_available.current();
+    cd.requests_blocked_memory = _requests_blocked_memory;
     if (_ready) {
         cd.connection_stage = client_connection_stage::ready;
     } else if (_authenticating) {
@@ -666,7 +684,7 @@ future<> cql_server::connection::process_request() {
         const bool allow_shedding = _client_state.get_workload_type() == service::client_state::workload_type::interactive;
         if (allow_shedding && _shed_incoming_requests) {
             ++_server._stats.requests_shed;
-            return _read_buf.skip(f.length).then([this, stream = f.stream] {
+            return skip_frame(f.length, f.flags).then([this, stream = f.stream] {
                 const char* message = "request shed due to coordinator overload";
                 clogger.debug("{}: {}, stream {}", _client_state.get_remote_address(), message);
                 write_response(make_error(stream, exceptions::exception_code::OVERLOADED,
@@ -699,7 +717,7 @@ future<> cql_server::connection::process_request() {
 
         if (_server._stats.requests_serving > _server._max_concurrent_requests) {
             ++_server._stats.requests_shed;
-            return _read_buf.skip(f.length).then([this, stream = f.stream] {
+            return skip_frame(f.length, f.flags).then([this, stream = f.stream] {
                 const auto message = format("too many in-flight requests (configured via max_concurrent_requests_per_shard): {}",
                                             _server._stats.requests_serving);
                 clogger.debug("{}: {}, request dropped", _client_state.get_remote_address(), message);
@@ -710,28 +728,42 @@ future<> cql_server::connection::process_request() {
             });
         }
 
-        const auto shedding_timeout = std::chrono::milliseconds(50);
-        auto fut = allow_shedding
-                ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length = f.length] (auto f) {
-                    try {
-                        return make_ready_future<semaphore_units<>>(f.get0());
-                    } catch (semaphore_timed_out& sto) {
-                        // Cancel shedding in case no more requests are going to do that on completion
-                        if (_pending_requests_gate.get_count() == 0) {
-                            _shed_incoming_requests = false;
+        // The connection's budget is waited for first, and without a timeout:
+        // a client which has too much in flight is throttled by not reading
+        // its requests until some complete, rather than by taking the
+        // memory of the shard, and of all other clients, first.
+        auto connection_mem_estimate = std::min(mem_estimate, _server._config.max_request_memory_per_connection);
+        if (_request_memory_available.waiters() || _request_memory_available.available_units() < ssize_t(connection_mem_estimate)) {
+            ++_requests_blocked_memory;
+            ++_server._stats.requests_blocked_connection_memory;
+        }
+        auto fut = get_units(_request_memory_available, connection_mem_estimate).then([this, allow_shedding, mem_estimate, length = f.length, flags = f.flags] (semaphore_units<> connection_mem_permit) {
+            const auto shedding_timeout = std::chrono::milliseconds(50);
+            auto fut = allow_shedding
+                    ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length, flags] (auto f) {
+                        try {
+                            return make_ready_future<semaphore_units<>>(f.get0());
+                        } catch (semaphore_timed_out& sto) {
+                            // Cancel shedding in case no more requests are going to do that on completion
+                            if (_pending_requests_gate.get_count() == 0) {
+                                _shed_incoming_requests = false;
+                            }
+                            return skip_frame(length, flags).then([sto = std::move(sto)] () mutable {
+                                return make_exception_future<semaphore_units<>>(std::move(sto));
+                            });
                         }
-                        return _read_buf.skip(length).then([sto = std::move(sto)] () mutable {
-                            return make_exception_future<semaphore_units<>>(std::move(sto));
-                        });
-                    }
-                })
-                : get_units(_server._memory_available, mem_estimate);
-        if (_server._memory_available.waiters()) {
-            if (allow_shedding && !_shedding_timer.armed()) {
-                _shedding_timer.arm(shedding_timeout);
+                    })
+                    : get_units(_server._memory_available, mem_estimate);
+            if (_server._memory_available.waiters()) {
+                if (allow_shedding && !_shedding_timer.armed()) {
+                    _shedding_timer.arm(shedding_timeout);
+                }
+                ++_server._stats.requests_blocked_memory;
             }
-            ++_server._stats.requests_blocked_memory;
-        }
+            return fut.then([connection_mem_permit = std::move(connection_mem_permit)] (semaphore_units<> mem_permit) mutable {
+                return std::make_pair(std::move(mem_permit), std::move(connection_mem_permit));
+            });
+        });
 
         return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested] (auto mem_permit_fut) {
           if (mem_permit_fut.failed()) {
@@ -739,8 +771,9 @@ future<> cql_server::connection::process_request() {
               mem_permit_fut.ignore_ready_future();
               return make_ready_future<>();
           }
-          semaphore_units<> mem_permit = mem_permit_fut.get0();
-          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
+          auto [mem_permit, connection_mem_permit] = mem_permit_fut.get0();
+          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit)),
+                  connection_mem_permit = std::move(connection_mem_permit)] (fragmented_temporary_buffer buf) mutable {
 
             ++_server._stats.requests_served;
             ++_server._stats.requests_serving;
@@ -765,7 +798,8 @@ future<> cql_server::connection::process_request() {
                     _process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit) :
                     process_request_one(istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit);
 
-            future<> request_response_future = request_process_future.then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave), stream] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
+            future<> request_response_future = request_process_future.then_wrapped([this, buf = std::move(buf), mem_permit, connection_mem_permit = std::move(connection_mem_permit),
+                    leave = std::move(leave), stream] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
                 try {
                     if (response_f.failed()) {
                         const auto message = format("request processing failed, error [{}]", response_f.get_exception());
@@ -776,7 +810,7 @@ future<> cql_server::connection::process_request() {
                     } else {
                         write_response(response_f.get0(), std::move(mem_permit), _compression);
                     }
-                    _ready_to_respond = _ready_to_respond.finally([leave = std::move(leave)] {});
+                    _ready_to_respond = _ready_to_respond.finally([leave = std::move(leave), connection_mem_permit = std::move(connection_mem_permit)] {});
                 } catch (...) {
                     clogger.error("{}: request processing failed: {}",
                                   _client_state.get_remote_address(), std::current_exception());
@@ -815,7 +849,7 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
             if (length < 4) {
                 throw std::runtime_error(fmt::format("CQL frame truncated: expected to have at least 4 bytes, got {}", length));
             }
-            return _buffer_reader.read_exactly(_read_buf, length).then([] (fragmented_temporary_buffer buf) {
+            return _buffer_reader.read_exactly(_read_buf, length).then([this] (fragmented_temporary_buffer buf) {
                 auto input_buffer = input_buffer_guard();
                 auto output_buffer = output_buffer_guard();
                 auto v = fragmented_temporary_buffer::view(buf);
@@ -824,7 +858,11 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
                     throw std::runtime_error("CQL frame uncompressed length is negative: " + std::to_string(uncomp_len));
                 }
                 auto in = input_buffer.get_linearized_view(v);
-                return output_buffer.make_fragmented_temporary_buffer(uncomp_len, [&in] (bytes_mutable_view out) {
+                return output_buffer.make_fragmented_temporary_buffer(uncomp_len, [this, &in] (bytes_mutable_view out) {
+                    if (_lz4_stream_decompressor) {
+                        _lz4_stream_decompressor->decompress(in, out);
+                        return out.size();
+                    }
                     auto ret = LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), out.size());
                     if (ret < 0) {
                         throw std::runtime_error("CQL frame LZ4 uncompression failure");
@@ -862,6 +900,14 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
     return _buffer_reader.read_exactly(_read_buf, length);
 }
 
+future<> cql_server::connection::skip_frame(size_t length, uint8_t flags) {
+    // In lz4 stream mode the frames which follow depend on this one.
+    if (_lz4_stream_decompressor && (flags & cql_frame_flags::compression)) {
+        return read_and_decompress_frame(length, flags).discard_result();
+    }
+    return _read_buf.skip(length);
+}
+
 future<std::unique_ptr<cql_server::response>> cql_server::connection::process_startup(uint16_t stream, request_reader in, service::client_state& client_state,
         tracing::trace_state_ptr trace_state) {
     auto options = in.read_string_map();
@@ -891,6 +937,10 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
             cql_proto_exts.set(ext);
         }
     }
+    if (cql_proto_exts.contains(cql_protocol_extension::LZ4_STREAM_COMPRESSION) && _compression == cql_compression::lz4) {
+        _lz4_stream_compressor = std::make_unique<lz4_stream_compressor>();
+        _lz4_stream_decompressor = std::make_unique<lz4_stream_decompressor>();
+    }
     _client_state.set_protocol_extensions(std::move(cql_proto_exts));
     std::unique_ptr<cql_server::response> res;
     if (auto& a = client_state.get_auth_service()->underlying_authenticator(); a.require_authentication()) {
@@ -951,14 +1001,85 @@ std::unique_ptr<cql_server::response>
 make_result(int16_t stream, messages::result_message& msg, const tracing::trace_state_ptr& tr_state,
         cql_protocol_version_type version, bool skip_metadata = false);
 
+future<cql_server::result_with_foreign_response_ptr>
+cql_server::connection::forward_to_shard(unsigned shard, noncopyable_function<future<result_with_foreign_response_ptr> (cql_server&)> process) {
+    auto& q = _forwarding_queues[shard];
+    auto& req = *q.pending.emplace_back(std::make_unique<forwarded_request>(std::move(process)));
+    auto f = req.result.get_future();
+    if (!q.sending) {
+        q.sending = true;
+        // The gate is held open by the request being forwarded.
+        (void)with_gate(_pending_requests_gate, [this, shard] {
+            return send_forwarded_requests(shard);
+        });
+    }
+    return f;
+}
+
+// Hands the queued requests over to the shard in a single cross-shard call.
+// They are processed independently there and each result is sent back as
+// soon as it's ready, so the requests of a batch don't wait for each other.
+future<> cql_server::connection::send_forwarded_requests(unsigned shard) {
+    auto& q = _forwarding_queues[shard];
+    while (!q.pending.empty()) {
+        auto batch = std::exchange(q.pending, {});
+        _server._stats.requests_forwarded += batch.size();
+        ++_server._stats.forwarded_request_batches;
+        std::vector<forwarded_request*> reqs;
+        reqs.reserve(batch.size());
+        for (auto& r : batch) {
+            reqs.push_back(r.get());
+        }
+        std::exception_ptr ex;
+        try {
+            co_await _server.container().invoke_on(shard, _server._config.bounce_request_smp_service_group,
+                    [reqs = std::move(reqs), origin = this_shard_id()] (cql_server& server) {
+                for (auto* req : reqs) {
+                    (void)futurize_invoke(req->process, server).then_wrapped([req, origin] (future<result_with_foreign_response_ptr> f) {
+                        std::optional<result_with_foreign_response_ptr> res;
+                        std::exception_ptr ex;
+                        if (f.failed()) {
+                            ex = f.get_exception();
+                        } else {
+                            res.emplace(f.get0());
+                        }
+                        return smp::submit_to(origin, [req, res = std::move(res), ex = std::move(ex)] () mutable {
+                            std::unique_ptr<forwarded_request> r(req);
+                            if (ex) {
+                                r->result.set_exception(std::move(ex));
+                            } else {
+                                r->result.set_value(std::move(*res));
+                            }
+                        });
+                    });
+                }
+            });
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        if (ex) {
+            // The requests didn't reach the shard.
+            for (auto& r : batch) {
+                r->result.set_exception(ex);
+            }
+        } else {
+            // Owned by the shard now, until their results are back.
+            for (auto& r : batch) {
+                (void)r.release();
+            }
+        }
+    }
+    q.sending = false;
+}
+
 template<typename Process>
 future<cql_server::result_with_foreign_response_ptr>
 cql_server::connection::process_on_shard(::shared_ptr<messages::result_message::bounce_to_shard> bounce_msg, uint16_t stream, fragmented_temporary_buffer::istream is,
         service::client_state& cs, service_permit permit, tracing::trace_state_ptr trace_state, Process process_fn) {
-    return _server.container().invoke_on(*bounce_msg->move_to_shard(), _server._config.bounce_request_smp_service_group,
+    return forward_to_shard(*bounce_msg->move_to_shard(),
             [this, is = std::move(is), cs = cs.move_to_other_shard(), stream, permit = std::move(permit), process_fn,
              gt = tracing::global_trace_state_ptr(std::move(trace_state)),
-             cached_vals = std::move(bounce_msg->take_cached_pk_function_calls())] (cql_server& server) {
+             cached_vals = std::move(bounce_msg->take_cached_pk_function_calls())] (cql_server& server) mutable {
         service::client_state client_state = cs.get();
         return do_with(bytes_ostream(), std::move(client_state), std::move(cached_vals),
                 [this, &server, is = std::move(is), stream, process_fn,
@@ -1051,20 +1172,25 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_pr
     tracing::add_query(trace_state, query);
     tracing::begin(trace_state, "Preparing CQL3 query", client_state.get_client_address());
 
-    auto cpu_id = this_shard_id();
-    auto cpus = boost::irange(0u, smp::count);
-    return parallel_for_each(cpus.begin(), cpus.end(), [this, query, cpu_id, &client_state] (unsigned int c) mutable {
-        if (c != cpu_id) {
-            return smp::submit_to(c, [this, query, &client_state] () mutable {
-                return _server._query_processor.local().prepare(std::move(query), client_state, false).discard_result();
-            });
-        } else {
-            return make_ready_future<>();
-        }
-    }).then([this, query, stream, &client_state, trace_state] () mutable {
-        tracing::trace(trace_state, "Done preparing on remote shards");
-        return _server._query_processor.local().prepare(std::move(query), client_state, false).then([this, stream, trace_state] (auto msg) {
-            tracing::trace(trace_state, "Done preparing on a local shard - preparing a result. ID is [{}]", seastar::value_of([&msg] {
+    // Prepare on this shard first, so that the statement is verified once, and
+    // only let the other shards know about it: they prepare it on first use,
+    // see query_processor::defer_prepare().
+    auto keyspace = sstring(client_state.get_raw_keyspace());
+    return _server._query_processor.local().prepare(query, client_state, false).then([this, query, keyspace = std::move(keyspace), stream, trace_state] (auto msg) {
+        tracing::trace(trace_state, "Done preparing on a local shard");
+        auto cache_key = cql3::prepared_cache_key_type(messages::result_message::prepared::cql::get_id(msg));
+        auto cpu_id = this_shard_id();
+        auto cpus = boost::irange(0u, smp::count);
+        return parallel_for_each(cpus.begin(), cpus.end(), [this, query, cpu_id, cache_key, keyspace] (unsigned int c) {
+            if (c != cpu_id) {
+                return smp::submit_to(c, [this, query, cache_key, keyspace] () mutable {
+                    return _server._query_processor.local().defer_prepare(std::move(cache_key), std::move(query), std::move(keyspace));
+                });
+            } else {
+                return make_ready_future<>();
+            }
+        }).then([this, stream, trace_state, msg = std::move(msg)] {
+            tracing::trace(trace_state, "Done deferring preparation on remote shards - preparing a result. ID is [{}]", seastar::value_of([&msg] {
                 return messages::result_message::prepared::cql::get_id(msg);
             }));
             return make_result(stream, *msg, trace_state, _version);
@@ -1072,10 +1198,27 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_pr
     });
 }
 
+// A statement prepared on another shard may not be prepared on this one
+// yet, see query_processor::defer_prepare(). Prepares it and processes the
+// request again, or fails the request with prepared_query_not_found_exception.
+template <typename Retry>
+static future<process_fn_return_type>
+retry_after_deferred_prepare(distributed<cql3::query_processor>& qp, cql3::prepared_cache_key_type cache_key, Retry retry) {
+    return do_with(std::move(cache_key), [&qp, retry = std::move(retry)] (const cql3::prepared_cache_key_type& cache_key) mutable {
+        return qp.local().prepare_deferred(cache_key).then([&cache_key, retry = std::move(retry)] (bool prepared) mutable {
+            if (!prepared) {
+                throw exceptions::prepared_query_not_found_exception(cql3::prepared_cache_key_type::cql_id(cache_key));
+            }
+            return retry();
+        });
+    });
+}
+
 static future<process_fn_return_type>
 process_execute_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
         uint16_t stream, cql_protocol_version_type version,
         service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
+    const auto request = in;
     cql3::prepared_cache_key_type cache_key(in.read_short_bytes());
     auto& id = cql3::prepared_cache_key_type::cql_id(cache_key);
     bool needs_authorization = false;
@@ -1089,7 +1232,10 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
     }
 
     if (!prepared) {
-        throw exceptions::prepared_query_not_found_exception(id);
+        return retry_after_deferred_prepare(qp, std::move(cache_key), [&client_state, &qp, request, stream, version, permit = std::move(permit),
+                trace_state = std::move(trace_state), init_trace, cached_pk_fn_calls = std::move(cached_pk_fn_calls)] () mutable {
+            return process_execute_internal(client_state, qp, request, stream, version, std::move(permit), std::move(trace_state), init_trace, std::move(cached_pk_fn_calls));
+        });
     }
 
     auto q_state = std::make_unique<cql_query_state>(client_state, trace_state, std::move(permit));
@@ -1151,6 +1297,7 @@ static future<process_fn_return_type>
 process_batch_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
         uint16_t stream, cql_protocol_version_type version,
         service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
+    const auto request = in;
     const auto type = in.read_byte();
     const unsigned n = in.read_short();
 
@@ -1184,7 +1331,6 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
         }
         case 1: {
             cql3::prepared_cache_key_type cache_key(in.read_short_bytes());
-            auto& id = cql3::prepared_cache_key_type::cql_id(cache_key);
 
             // First, try to lookup in the cache of already authorized statements. If the corresponding entry is not found there
             // look for the prepared statement and then authorize it.
@@ -1192,7 +1338,12 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
             if (!ps) {
                 ps = qp.local().get_prepared(cache_key);
                 if (!ps) {
-                    throw exceptions::prepared_query_not_found_exception(id);
+                    // The statements seen so far are looked up again, and the
+                    // trace started again, on retry.
+                    return retry_after_deferred_prepare(qp, std::move(cache_key), [&client_state, &qp, request, stream, version, permit = std::move(permit),
+                            trace_state = std::move(trace_state), init_trace, cached_pk_fn_calls = std::move(cached_pk_fn_calls)] () mutable {
+                        return process_batch_internal(client_state, qp, request, stream, version, std::move(permit), std::move(trace_state), init_trace, std::move(cached_pk_fn_calls));
+                    });
                 }
                 // authorize a particular prepared statement only once
                 needs_authorization = pending_authorization_entries.emplace(std::move(cache_key), ps->checked_weak_from_this()).second;
@@ -1531,6 +1682,25 @@ class cql_server::fmt_visitor : public messages::result_message::visitor_base {
     }
 };
 
+// The value of the "tablets-routing-v1" custom payload entry, a
+// tuple<bigint, bigint, list<tuple<uuid, int>>> of the token range of the
+// tablet and of its replicas. See docs/dev/protocol-extensions.md.
+static bytes serialize_tablet_info(const messages::tablet_info& info) {
+    static thread_local const auto replica_type = tuple_type_impl::get_instance({uuid_type, int32_type});
+    static thread_local const auto routing_type = tuple_type_impl::get_instance({long_type, long_type,
+            list_type_impl::get_instance(replica_type, false)});
+    std::vector<data_value> replicas;
+    replicas.reserve(info.replicas.size());
+    for (auto& r : info.replicas) {
+        replicas.push_back(make_tuple_value(replica_type, {data_value(r.host.uuid()), data_value(int32_t(r.shard))}));
+    }
+    auto value = make_tuple_value(routing_type, {
+            data_value(dht::token::to_int64(info.token_range.first)),
+            data_value(dht::token::to_int64(info.token_range.second)),
+            make_list_value(routing_type->type(2), std::move(replicas))});
+    return value.serialize_nonnull();
+}
+
 std::unique_ptr<cql_server::response>
 make_result(int16_t stream, messages::result_message& msg, const tracing::trace_state_ptr& tr_state,
         cql_protocol_version_type version, bool skip_metadata) {
@@ -1539,6 +1709,10 @@ make_result(int16_t stream, messages::result_message& msg, const tracing::trace_
         response->set_frame_flag(cql_frame_flags::warning);
         response->write_string_list(msg.warnings());
     }
+    if (msg.get_tablet_info() && version > 3) {
+        response->set_frame_flag(cql_frame_flags::custom_payload);
+        response->write_bytes_map({{"tablets-routing-v1", serialize_tablet_info(*msg.get_tablet_info())}});
+    }
     cql_server::fmt_visitor fmt{version, *response, skip_metadata};
     msg.accept(fmt);
     return response;
@@ -1575,18 +1749,25 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
 
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
+    ++_pending_responses;
     _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
-        auto message = response->make_message(_version, compression);
+        --_pending_responses;
+        auto message = response->make_message(_version, compression, _lz4_stream_compressor.get());
         message.on_delete([response = std::move(response)] { });
         return _write_buf.write(std::move(message)).then([this] {
+            // If more responses are queued, leave the flush to the last one,
+            // so that they all go out together, in a single writev().
+            if (_pending_responses) {
+                return make_ready_future<>();
+            }
             return _write_buf.flush();
         });
     });
 }
 
-scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression) {
+scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression, lz4_stream_compressor* lz4_stream) {
     if (compression != cql_compression::none) {
-        compress(compression);
+        compress(compression, lz4_stream);
     }
     scattered_message<char> msg;
     auto frame = make_frame(version, _body.size());
@@ -1597,11 +1778,11 @@ scattered_message<char> cql_server::response::make_message(uint8_t version, cql_
     return msg;
 }
 
-void cql_server::response::compress(cql_compression compression)
+void cql_server::response::compress(cql_compression compression, lz4_stream_compressor* lz4_stream)
 {
     switch (compression) {
     case cql_compression::lz4:
-        compress_lz4();
+        compress_lz4(lz4_stream);
         break;
     case cql_compression::snappy:
         compress_snappy();
@@ -1612,18 +1793,21 @@ void cql_server::response::compress(cql_compression compression)
     set_frame_flag(cql_frame_flags::compression);
 }
 
-void cql_server::response::compress_lz4()
+void cql_server::response::compress_lz4(lz4_stream_compressor* lz4_stream)
 {
     auto input_buffer = input_buffer_guard();
     auto output_buffer = output_buffer_guard();
 
     auto in = input_buffer.get_linearized_view(_body);
     size_t output_len = LZ4_COMPRESSBOUND(in.size()) + 4;
-    _body = output_buffer.make_bytes_ostream(output_len, [&in] (bytes_mutable_view out) {
+    _body = output_buffer.make_bytes_ostream(output_len, [&in, lz4_stream] (bytes_mutable_view out) {
         out.data()[0] = (in.size() >> 24) & 0xFF;
         out.data()[1] = (in.size() >> 16) & 0xFF;
         out.data()[2] = (in.size() >> 8) & 0xFF;
         out.data()[3] = in.size() & 0xFF;
+        if (lz4_stream) {
+            return lz4_stream->compress(in, bytes_mutable_view(out.data() + 4, out.size() - 4)) + 4;
+        }
         auto ret = LZ4_compress_default(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data() + 4), in.size(), out.size() - 4);
         if (ret == 0) {
             throw std::runtime_error("CQL frame LZ4 compression failure");
@@ -1770,6 +1954,15 @@ void cql_server::response::write_string_map(std::map<sstring, sstring> string_ma
     }
 }
 
+void cql_server::response::write_bytes_map(const std::unordered_map<sstring, bytes>& bytes_map)
+{
+    write_short(cast_if_fits<uint16_t>(bytes_map.size()));
+    for (auto&& [key, value] : bytes_map) {
+        write_string(key);
+        write_bytes(value);
+    }
+}
+
 void cql_server::response::write_string_multimap(std::multimap<sstring, sstring> string_map)
 {
     std::vector<sstring> keys;
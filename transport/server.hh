@@ -64,6 +64,8 @@ namespace cql_transport {
 
 class request_reader;
 class response;
+class lz4_stream_compressor;
+class lz4_stream_decompressor;
 enum class cql_binary_opcode : uint8_t;
 
 enum class cql_compression {
@@ -75,6 +77,7 @@ enum class cql_compression {
 enum cql_frame_flags {
     compression = 0x01,
     tracing     = 0x02,
+    custom_payload = 0x04,
     warning     = 0x08,
 };
 
@@ -103,6 +106,8 @@ struct cql_query_state {
 struct cql_server_config {
     updateable_timeout_config timeout_config;
     size_t max_request_size;
+    // Memory budget for the requests of a single connection.
+    size_t max_request_memory_per_connection;
     sstring partitioner_name;
     unsigned sharding_ignore_msb;
     std::optional<uint16_t> shard_aware_transport_port;
@@ -138,7 +143,10 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         uint64_t requests_served = 0;
         uint32_t requests_serving = 0;
         uint64_t requests_blocked_memory = 0;
+        uint64_t requests_blocked_connection_memory = 0;
         uint64_t requests_shed = 0;
+        uint64_t requests_forwarded = 0;
+        uint64_t forwarded_request_batches = 0;
 
         std::unordered_map<exceptions::exception_code, uint64_t> errors;
     };
@@ -190,12 +198,34 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         fragmented_temporary_buffer::reader _buffer_reader;
         cql_protocol_version_type _version = 0;
         cql_compression _compression = cql_compression::none;
+        // Set for lz4 compression in stream mode, see lz4_stream_compressor.
+        std::unique_ptr<lz4_stream_compressor> _lz4_stream_compressor;
+        std::unique_ptr<lz4_stream_decompressor> _lz4_stream_decompressor;
         service::client_state _client_state;
         timer<lowres_clock> _shedding_timer;
         bool _shed_incoming_requests = false;
         unsigned _request_cpu = 0;
         bool _ready = false;
         bool _authenticating = false;
+        // Responses waiting for their turn to be written, see write_response().
+        unsigned _pending_responses = 0;
+        // The connection's share of the shard's request memory. Requests wait
+        // for it before reading their body, which stops reading from the socket.
+        semaphore _request_memory_available;
+        uint64_t _requests_blocked_memory = 0;
+
+        // Requests bounced to another shard are forwarded in batches: while a
+        // batch is being handed over to a shard, further requests bounced to
+        // it queue up to go together in the next one.
+        struct forwarded_request {
+            noncopyable_function<future<result_with_foreign_response_ptr> (cql_server&)> process;
+            promise<result_with_foreign_response_ptr> result;
+        };
+        struct forwarding_queue {
+            std::vector<std::unique_ptr<forwarded_request>> pending;
+            bool sending = false;
+        };
+        std::unordered_map<unsigned, forwarding_queue> _forwarding_queues;
 
         enum class tracing_request_type : uint8_t {
             not_requested,
@@ -229,6 +259,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         unsigned pick_request_cpu();
         cql_binary_frame_v3 parse_frame(temporary_buffer<char> buf) const;
         future<fragmented_temporary_buffer> read_and_decompress_frame(size_t length, uint8_t flags);
+        future<> skip_frame(size_t length, uint8_t flags);
         future<std::optional<cql_binary_frame_v3>> read_frame();
         future<std::unique_ptr<cql_server::response>> process_startup(uint16_t stream, request_reader in, service::client_state& client_state, tracing::trace_state_ptr trace_state);
         future<std::unique_ptr<cql_server::response>> process_auth_response(uint16_t stream, request_reader in, service::client_state& client_state, tracing::trace_state_ptr trace_state);
@@ -267,6 +298,9 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         future<result_with_foreign_response_ptr>
         process_on_shard(::shared_ptr<messages::result_message::bounce_to_shard> bounce_msg, uint16_t stream, fragmented_temporary_buffer::istream is, service::client_state& cs,
                 service_permit permit, tracing::trace_state_ptr trace_state, Process process_fn);
+        future<result_with_foreign_response_ptr> forward_to_shard(unsigned shard,
+                noncopyable_function<future<result_with_foreign_response_ptr> (cql_server&)> process);
+        future<> send_forwarded_requests(unsigned shard);
 
         void write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit = empty_service_permit(), cql_compression compression = cql_compression::none);
 
@@ -279,6 +313,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     virtual shared_ptr<generic_server::connection> make_connection(socket_address server_addr, connected_socket&& fd, socket_address addr) override;
     future<> advertise_new_connection(shared_ptr<generic_server::connection> conn) override;
     future<> unadvertise_connection(shared_ptr<generic_server::connection> conn) override;
+    future<std::vector<shard_load>> get_shard_loads() override;
 
     ::timeout_config timeout_config() const { return _config.timeout_config.current_values(); }
 };
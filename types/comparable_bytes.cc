@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "types/comparable_bytes.hh"
+
+#include <bit>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <fmt/format.h>
+
+#include "types/types.hh"
+#include "schema/schema.hh"
+#include "keys.hh"
+#include "compound_compat.hh"
+#include "dht/i_partitioner.hh"
+#include "mutation/position_in_partition.hh"
+#include "utils/fragment_range.hh"
+
+namespace comparable_bytes {
+
+namespace {
+
+constexpr int8_t next_component = 0x40;
+constexpr int8_t next_component_empty = 0x3f;
+constexpr int8_t next_component_empty_reversed = 0x41;
+constexpr int8_t terminator_before = 0x20;
+constexpr int8_t terminator_equal = 0x38;
+constexpr int8_t terminator_after = 0x60;
+
+enum class encoding {
+    unsupported,
+    escaped_bytes,
+    boolean,
+    signed_integer,
+    unsigned_integer,
+    floating_point,
+    uuid,
+    timeuuid,
+};
+
+encoding encoding_of(const abstract_type& t) noexcept {
+    using kind = abstract_type::kind;
+    switch (t.get_kind()) {
+    case kind::ascii:
+    case kind::utf8:
+    case kind::bytes:
+    case kind::inet:
+    case kind::duration:
+        return encoding::escaped_bytes;
+    case kind::boolean:
+        return encoding::boolean;
+    case kind::byte:
+    case kind::short_kind:
+    case kind::int32:
+    case kind::long_kind:
+    case kind::timestamp:
+    case kind::time:
+        return encoding::signed_integer;
+    case kind::date:
+    case kind::simple_date:
+        return encoding::unsigned_integer;
+    case kind::float_kind:
+    case kind::double_kind:
+        return encoding::floating_point;
+    case kind::uuid:
+        return encoding::uuid;
+    case kind::timeuuid:
+        return encoding::timeuuid;
+    default:
+        return encoding::unsupported;
+    }
+}
+
+// Serialized size of the fixed-size types handled by the integer and
+// floating point encodings. value_length_if_fixed() is not set for all
+// of them.
+size_t fixed_size(const abstract_type& t) {
+    using kind = abstract_type::kind;
+    switch (t.get_kind()) {
+    case kind::byte:
+        return 1;
+    case kind::short_kind:
+        return 2;
+    case kind::int32:
+    case kind::simple_date:
+    case kind::float_kind:
+        return 4;
+    case kind::long_kind:
+    case kind::timestamp:
+    case kind::time:
+    case kind::date:
+    case kind::double_kind:
+        return 8;
+    default:
+        abort();
+    }
+}
+
+// Where an encoding goes: either a vector, which grows as needed, or a
+// fixed buffer, which keeps the leading bytes and drops the rest.
+class output {
+    std::vector<int8_t>* _vec = nullptr;
+    std::span<uint8_t> _buf;
+    size_t _size = 0;
+public:
+    explicit output(std::vector<int8_t>& vec) noexcept : _vec(&vec) { }
+    explicit output(std::span<uint8_t> buf) noexcept : _buf(buf) { }
+    void push_back(int8_t b) {
+        if (_vec) {
+            _vec->push_back(b);
+        } else if (_size < _buf.size()) {
+            _buf[_size++] = uint8_t(b);
+        }
+    }
+    bool full() const noexcept {
+        return !_vec && _size == _buf.size();
+    }
+    // Zeroes the part of a fixed buffer which was not written.
+    void pad() noexcept {
+        if (!_vec) {
+            std::fill(_buf.begin() + _size, _buf.end(), 0);
+        }
+    }
+};
+
+// Accumulates an encoding. When inverted, all bytes are complemented,
+// which reverses the order of everything written through this writer.
+class writer {
+    output& _out;
+    bool _inverted;
+public:
+    writer(output& out, bool inverted) : _out(out), _inverted(inverted) { }
+    void put(uint8_t b) {
+        _out.push_back(int8_t(_inverted ? ~b : b));
+    }
+    bool full() const noexcept {
+        return _out.full();
+    }
+    void put_be(uint64_t v, unsigned size) {
+        for (unsigned i = size; i > 0; --i) {
+            put(uint8_t(v >> (8 * (i - 1))));
+        }
+    }
+};
+
+// Reads a fixed-size value as a big-endian unsigned integer.
+uint64_t read_be(managed_bytes_view v, size_t size, const abstract_type& t) {
+    if (v.size_bytes() != size) {
+        throw marshal_exception(fmt::format("cannot encode {} value: expected {} bytes, got {}", t.name(), size, v.size_bytes()));
+    }
+    uint64_t res = 0;
+    for (auto frag : fragment_range(v)) {
+        for (auto b : frag) {
+            res = (res << 8) | uint8_t(b);
+        }
+    }
+    return res;
+}
+
+void encode_escaped(managed_bytes_view v, writer& w) {
+    for (auto frag : fragment_range(v)) {
+        // Long values need not be walked to the end into a fixed buffer.
+        if (w.full()) {
+            return;
+        }
+        for (auto b : frag) {
+            w.put(uint8_t(b));
+            if (b == 0) {
+                w.put(0xff);
+            }
+        }
+    }
+    w.put(0x00);
+}
+
+void encode_uuid_time_ordered(managed_bytes_view v, uint64_t lsb_flip, writer& w) {
+    std::array<int8_t, 16> buf;
+    if (v.size_bytes() != buf.size()) {
+        throw marshal_exception(fmt::format("cannot encode uuid value: expected 16 bytes, got {}", v.size_bytes()));
+    }
+    auto out = buf.begin();
+    for (auto frag : fragment_range(v)) {
+        out = std::copy(frag.begin(), frag.end(), out);
+    }
+    w.put_be(utils::timeuuid_read_msb(buf.data()), 8);
+    w.put_be(utils::uuid_read_lsb(buf.data()) ^ lsb_flip, 8);
+}
+
+// Encodes a non-empty value of a non-reversed type.
+void encode_nonempty(const abstract_type& t, encoding e, managed_bytes_view v, writer& w) {
+    switch (e) {
+    case encoding::unsupported:
+        throw std::invalid_argument(fmt::format("type {} has no byte-comparable encoding", t.name()));
+    case encoding::escaped_bytes:
+        encode_escaped(v, w);
+        return;
+    case encoding::boolean:
+        w.put(read_be(v, 1, t) != 0);
+        return;
+    case encoding::signed_integer: {
+        auto size = fixed_size(t);
+        w.put_be(read_be(v, size, t) ^ (uint64_t(1) << (8 * size - 1)), size);
+        return;
+    }
+    case encoding::unsigned_integer: {
+        auto size = fixed_size(t);
+        w.put_be(read_be(v, size, t), size);
+        return;
+    }
+    case encoding::floating_point: {
+        auto size = fixed_size(t);
+        uint64_t bits = read_be(v, size, t);
+        uint64_t sign = uint64_t(1) << (8 * size - 1);
+        uint64_t all = size == 8 ? ~uint64_t(0) : (uint64_t(1) << (8 * size)) - 1;
+        bool nan = size == 8 ? std::isnan(std::bit_cast<double>(bits)) : std::isnan(std::bit_cast<float>(uint32_t(bits)));
+        if (nan) {
+            // NaNs are equal to each other and greater than everything else.
+            w.put_be(all, size);
+        } else {
+            // -0 sorts before 0, as in the type's compare().
+            w.put_be((bits & sign) ? (~bits & all) : (bits | sign), size);
+        }
+        return;
+    }
+    case encoding::uuid: {
+        if (v.size_bytes() < 16) {
+            // Shorter values compare equal to each other and less than
+            // all others, like empty ones.
+            return;
+        }
+        std::array<int8_t, 16> buf;
+        auto out = buf.begin();
+        for (auto frag : fragment_range(v)) {
+            out = std::copy(frag.begin(), frag.end(), out);
+        }
+        auto version = (uint8_t(buf[6]) >> 4) & 0x0f;
+        w.put(version);
+        if (version == 1) {
+            encode_uuid_time_ordered(v, 0, w);
+        } else {
+            for (auto b : buf) {
+                w.put(uint8_t(b));
+            }
+        }
+        return;
+    }
+    case encoding::timeuuid:
+        encode_uuid_time_ordered(v, 0x8080808080808080ull, w);
+        return;
+    }
+}
+
+bool sorts_as_empty(encoding e, managed_bytes_view v) {
+    return v.empty() || (e == encoding::uuid && v.size_bytes() < 16);
+}
+
+void encode_component(const abstract_type& t, managed_bytes_view v, output& out) {
+    auto& type = t.without_reversed();
+    auto e = encoding_of(type);
+    if (e == encoding::unsupported) {
+        throw std::invalid_argument(fmt::format("type {} has no byte-comparable encoding", t.name()));
+    }
+    if (sorts_as_empty(e, v)) {
+        out.push_back(t.is_reversed() ? next_component_empty_reversed : next_component_empty);
+        return;
+    }
+    out.push_back(next_component);
+    writer w(out, t.is_reversed());
+    encode_nonempty(type, e, v, w);
+}
+
+int8_t terminator_of(bound_weight w) noexcept {
+    switch (w) {
+    case bound_weight::before_all_prefixed:
+        return terminator_before;
+    case bound_weight::equal:
+        return terminator_equal;
+    case bound_weight::after_all_prefixed:
+        return terminator_after;
+    }
+    abort();
+}
+
+bytes to_bytes(const std::vector<int8_t>& out) {
+    return bytes(out.data(), out.size());
+}
+
+void encode_token(const dht::token& t, output& out) {
+    writer w(out, false);
+    w.put(uint8_t(t._kind));
+    if (t._kind == dht::token::kind::key) {
+        w.put_be(uint64_t(t._data) ^ (uint64_t(1) << 63), 8);
+    }
+}
+
+} // anonymous namespace
+
+bool is_supported(const abstract_type& t) noexcept {
+    return encoding_of(t.without_reversed()) != encoding::unsupported;
+}
+
+bool clustering_key_is_supported(const schema& s) noexcept {
+    for (auto& cdef : s.clustering_key_columns()) {
+        if (!is_supported(*cdef.type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bytes from_value(const abstract_type& t, managed_bytes_view v) {
+    std::vector<int8_t> out;
+    output o(out);
+    encode_component(t, v, o);
+    return to_bytes(out);
+}
+
+bytes from_clustering_prefix(const schema& s, const clustering_key_prefix& p) {
+    return from_clustering_prefix(s, p, bound_weight::equal);
+}
+
+bytes from_clustering_prefix(const schema& s, const clustering_key_prefix& p, bound_weight w) {
+    std::vector<int8_t> out;
+    out.reserve(p.representation().size() + 8);
+    output o(out);
+    auto types = s.clustering_key_prefix_type()->types().begin();
+    for (managed_bytes_view component : p.components(s)) {
+        encode_component(**types++, component, o);
+    }
+    o.push_back(terminator_of(w));
+    return to_bytes(out);
+}
+
+void clustering_prefix_head(const schema& s, const clustering_key_prefix& p, bound_weight w, std::span<uint8_t> out) {
+    output o(out);
+    auto types = s.clustering_key_prefix_type()->types().begin();
+    for (managed_bytes_view component : p.components(s)) {
+        if (o.full()) {
+            return;
+        }
+        auto& t = **types++;
+        if (!is_supported(t)) {
+            // Sorts after the terminators of the shorter prefixes and
+            // after empty values, so stopping here keeps the order.
+            o.push_back(next_component);
+            o.pad();
+            return;
+        }
+        encode_component(t, component, o);
+    }
+    o.push_back(terminator_of(w));
+    o.pad();
+}
+
+bytes from_token(const dht::token& t) {
+    std::vector<int8_t> out;
+    output o(out);
+    encode_token(t, o);
+    return to_bytes(out);
+}
+
+bytes from_decorated_key(const schema& s, const dht::decorated_key& dk) {
+    std::vector<int8_t> out;
+    output o(out);
+    encode_token(dk.token(), o);
+    // The legacy form orders keys of the same token as decorated_key does,
+    // see legacy_compound_view::tri_comparator.
+    legacy_compound_view<compound_type<allow_prefixes::no>> lv(*s.partition_key_type(), dk.key().representation());
+    out.insert(out.end(), lv.begin(), lv.end());
+    return to_bytes(out);
+}
+
+} // namespace comparable_bytes
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <span>
+
+#include "bytes.hh"
+#include "utils/managed_bytes.hh"
+
+class abstract_type;
+class schema;
+class clustering_key_prefix;
+enum class bound_weight : int8_t;
+
+namespace dht {
+class decorated_key;
+class token;
+}
+
+// Byte-comparable (order preserving) encoding of values and keys.
+//
+// The encoding of a value is a byte string such that comparing the
+// encodings of two values with compare_unsigned() (memcmp) gives the same
+// result as comparing the values with their type's compare(). In
+// particular, two values have the same encoding iff they compare equal.
+// Encodings are meant for places where a key is compared many times
+// against other keys, so the per-component, per-type comparison is paid
+// once, at encoding time; see position_prefix_encoder in the combined
+// reader.
+//
+// The encoding is not meant to be decoded and is not stable across
+// versions, so it must not be persisted without versioning.
+//
+// Values are framed like a single clustering key component (see below),
+// which is what allows empty values of reversed types to sort last.
+// Within the frame:
+//  - ascii, text, blob, inet, duration: the bytes, with 0x00 escaped
+//    as 0x00 0xff, terminated by 0x00.
+//  - boolean: a single 0x00 or 0x01 byte.
+//  - tinyint, smallint, int, bigint, timestamp, time: big-endian, with
+//    the sign bit flipped.
+//  - date, simple_date: big-endian.
+//  - float, double: big-endian, with the sign bit flipped for positive
+//    numbers and all bits flipped for negative ones. All NaNs are
+//    mapped to the same, greatest, encoding.
+//  - uuid: the version nibble followed by the time-ordered form for
+//    version 1 uuids, or by the raw bytes otherwise.
+//  - timeuuid: the time-ordered form, with the version masked off.
+//  - reversed types: the encoding of the underlying type, complemented.
+//  - other types (collections, tuples, user types, varint, decimal,
+//    counters) are not supported, see is_supported().
+//
+// Clustering key prefixes, with a bound weight:
+//
+//     ( <0x40> <value> | <0x3f> | <0x41> )* <terminator>
+//
+// 0x40 precedes every non-empty value, 0x3f stands for an empty value of
+// a non-reversed type and 0x41 for an empty value of a reversed type
+// (empty values sort before all others). The terminator is 0x20 for
+// before_all_prefixed, 0x38 for equal and 0x60 for after_all_prefixed,
+// so the outcome of comparing a prefix with its extensions follows
+// clustering_bounds_comparator.
+//
+// Partition keys are encoded in ring order: the token followed by the
+// legacy form of the key, see legacy_compound_view.
+namespace comparable_bytes {
+
+// Whether values of the type can be encoded.
+bool is_supported(const abstract_type& t) noexcept;
+
+// Whether all clustering key columns of the schema can be encoded.
+bool clustering_key_is_supported(const schema& s) noexcept;
+
+// Throws std::invalid_argument if the type is not supported and
+// marshal_exception if the value is not valid for the type.
+bytes from_value(const abstract_type& t, managed_bytes_view v);
+
+// Throws std::invalid_argument if clustering_key_is_supported(s) is false.
+bytes from_clustering_prefix(const schema& s, const clustering_key_prefix& p);
+bytes from_clustering_prefix(const schema& s, const clustering_key_prefix& p, bound_weight w);
+
+// Fills `out` with the leading bytes of from_clustering_prefix(s, p, w),
+// padded with zeros, without allocating. Works for any schema: the
+// encoding stops at the first component of an unsupported type. So the
+// results of two prefixes, compared with compare_unsigned(), never order
+// them the wrong way round, but may be equal for different prefixes.
+// Throws marshal_exception if a component is not valid for its type.
+void clustering_prefix_head(const schema& s, const clustering_key_prefix& p, bound_weight w, std::span<uint8_t> out);
+
+bytes from_token(const dht::token& t);
+bytes from_decorated_key(const schema& s, const dht::decorated_key& dk);
+
+} // namespace comparable_bytes
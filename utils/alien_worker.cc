@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <seastar/core/posix.hh>
+
+#include "utils/alien_worker.hh"
+
+namespace utils {
+
+std::optional<alien_worker::task> alien_worker::pop_front() {
+    std::unique_lock lock(_mut);
+    _cv.wait(lock, [this] { return !_pending.empty(); });
+    auto t = std::move(_pending.front());
+    _pending.pop();
+    return t;
+}
+
+void alien_worker::push_back(std::optional<task> t) {
+    std::unique_lock lock(_mut);
+    _pending.emplace(std::move(t));
+    lock.unlock();
+    _cv.notify_one();
+}
+
+alien_worker::alien_worker(seastar::logger& logger, int niceness)
+    : _thread([this, &logger, niceness] {
+        sigset_t mask;
+        sigfillset(&mask);
+        auto r = ::pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+        seastar::throw_pthread_error(r);
+
+        errno = 0;
+        int nice_value = nice(niceness);
+        if (nice_value == -1 && errno != 0) {
+            logger.warn("Unable to renice the alien worker thread (system error number {}); the thread will compete with reactor. Try adding CAP_SYS_NICE", errno);
+        }
+
+        while (auto t = pop_front()) {
+            (*t)();
+        }
+    })
+{ }
+
+alien_worker::~alien_worker() {
+    push_back(std::nullopt);
+    _thread.join();
+}
+
+} // namespace utils
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+
+#include <seastar/core/alien.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/util/log.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+namespace utils {
+
+/// Runs functions on a dedicated OS thread, outside of the reactor.
+///
+/// Meant for long non-preemptible work, like calls into third-party
+/// libraries, which would stall the shard. The thread is reniced, so it
+/// yields the CPU to the reactor threads.
+class alien_worker {
+    using task = seastar::noncopyable_function<void() noexcept>;
+
+    std::mutex _mut;
+    std::condition_variable _cv;
+    // A disengaged task stops the thread.
+    std::queue<std::optional<task>> _pending;
+    // Initialized last, as the thread uses the members above.
+    std::thread _thread;
+
+    std::optional<task> pop_front();
+    void push_back(std::optional<task> t);
+public:
+    alien_worker(seastar::logger& logger, int niceness);
+    // Waits for the pending functions to run.
+    ~alien_worker();
+    alien_worker(const alien_worker&) = delete;
+    alien_worker& operator=(const alien_worker&) = delete;
+
+    /// Runs `f` on the worker thread, and returns its result on the current
+    /// shard. `f` runs concurrently with the shard, so it must not touch
+    /// any data owned by the shard, except what is captured for it and kept
+    /// alive until the returned future resolves.
+    template <typename T>
+    seastar::future<T> submit(seastar::noncopyable_function<T()> f) {
+        seastar::promise<T> p;
+        auto fut = p.get_future();
+        push_back([&p, f = std::move(f), &alien = seastar::engine().alien(), shard = seastar::this_shard_id()] () mutable noexcept {
+            try {
+                T v = f();
+                seastar::alien::run_on(alien, shard, [&p, v = std::move(v)] () mutable noexcept {
+                    p.set_value(std::move(v));
+                });
+            } catch (...) {
+                seastar::alien::run_on(alien, shard, [&p, ex = std::current_exception()] () mutable noexcept {
+                    p.set_exception(std::move(ex));
+                });
+            }
+        });
+        // Keeps the promise alive until the worker sets it.
+        co_return co_await std::move(fut);
+    }
+};
+
+} // namespace utils
@@ -17,7 +17,9 @@
 #include <seastar/core/loop.hh>
 #include "utils/large_bitset.hh"
 #include <array>
+#include <cmath>
 #include <cstdlib>
+#include <seastar/core/bitops.hh>
 #include "bloom_filter.hh"
 
 namespace utils {
@@ -73,6 +75,81 @@ bool bloom_filter::is_present(const bytes_view& key) {
     return is_present(make_hashed_key(key));
 }
 
+// Odd constants used to derive the bit set in each word of the block, see
+// "Cache-, Hash- and Space-Efficient Bloom Filters" (Putze et al.) and the
+// Parquet split-block bloom filter specification.
+static constexpr std::array<uint32_t, split_block_bloom_filter::hashes_per_key> split_block_salts = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+};
+
+split_block_bloom_filter::split_block_bloom_filter(bitmap&& bs) noexcept
+    : bloom_filter(hashes_per_key, std::move(bs), filter_format::m_format)
+    , _blocks(bits().size() / block_bits)
+{
+}
+
+size_t split_block_bloom_filter::block_of(const hashed_key& key) const noexcept {
+    // Maps the first hash onto [0, _blocks) without a division.
+    return static_cast<size_t>((static_cast<unsigned __int128>(key.hash()[0]) * _blocks) >> 64);
+}
+
+std::array<uint64_t, split_block_bloom_filter::words_per_block>
+split_block_bloom_filter::block_mask(const hashed_key& key) noexcept {
+    auto h = static_cast<uint32_t>(key.hash()[1]);
+    std::array<uint64_t, words_per_block> mask;
+    for (size_t w = 0; w < words_per_block; ++w) {
+        uint32_t lo = (h * split_block_salts[2 * w]) >> 27;
+        uint32_t hi = (h * split_block_salts[2 * w + 1]) >> 27;
+        mask[w] = (uint64_t(1) << lo) | (uint64_t(1) << (hi + 32));
+    }
+    return mask;
+}
+
+void split_block_bloom_filter::add(const bytes_view& key) {
+    auto hk = make_hashed_key(key);
+    auto base = block_of(hk) * words_per_block;
+    auto mask = block_mask(hk);
+    for (size_t w = 0; w < words_per_block; ++w) {
+        for (auto m = mask[w]; m; m &= m - 1) {
+            bits().set((base + w) * 64 + count_trailing_zeros(m));
+        }
+    }
+}
+
+bool split_block_bloom_filter::is_present(hashed_key key) {
+    auto& storage = bits().get_storage();
+    auto base = block_of(key) * words_per_block;
+    auto mask = block_mask(key);
+    uint64_t missing = 0;
+    for (size_t w = 0; w < words_per_block; ++w) {
+        missing |= mask[w] & ~storage[base + w];
+    }
+    return !missing;
+}
+
+bool split_block_bloom_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
+size_t split_block_bloom_filter::bits_for(int64_t num_elements, double max_false_pos_prob) {
+    // Each of the eight words behaves like a one-hash bloom filter over the
+    // keys mapped to the block, so the false-positive rate is the eighth
+    // power of the per-word one.
+    double bits_per_key = -double(hashes_per_key) / std::log(1.0 - std::pow(max_false_pos_prob, 1.0 / hashes_per_key));
+    auto nr_blocks = static_cast<size_t>(std::ceil(bits_per_key * std::max<int64_t>(num_elements, 1) / block_bits));
+    return std::max<size_t>(nr_blocks, 1) * block_bits;
+}
+
+filter_ptr create_split_block_filter(large_bitset&& bitset) {
+    return std::make_unique<split_block_bloom_filter>(std::move(bitset));
+}
+
+filter_ptr create_split_block_filter(int64_t num_elements, double max_false_pos_prob) {
+    large_bitset bitset(split_block_bloom_filter::bits_for(num_elements, max_false_pos_prob));
+    return std::make_unique<split_block_bloom_filter>(std::move(bitset));
+}
+
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format) {
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
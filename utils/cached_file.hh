@@ -62,6 +62,7 @@ class cached_file {
         logalloc::lsa_buffer _lsa_buf;
         temporary_buffer<char> _buf; // Empty when not shared. May mirror _lsa_buf when shared.
         size_t _use_count = 0;
+        bool _lru_protected = false;
     public:
         struct cached_page_del {
             void operator()(cached_page* cp) {
@@ -81,6 +82,7 @@ class cached_file {
             if (_use_count++ == 0) {
                 if (is_linked()) {
                     parent->_lru.remove(*this);
+                    parent->_lru.mark_referenced(*this);
                 }
             }
             return std::unique_ptr<cached_page, cached_page_del>(this);
@@ -109,6 +111,12 @@ class cached_file {
 
         void on_evicted() noexcept override;
 
+        bool lru_protected() const noexcept override { return _lru_protected; }
+        bool set_lru_protected(bool v) noexcept override {
+            _lru_protected = v;
+            return true;
+        }
+
         temporary_buffer<char> get_buf() {
             auto self = share();
             if (!_buf) {
@@ -39,12 +39,18 @@
 // This is why std::deque chose small 512-byte chunks. chunked_vector solves
 // this problem differently: It makes the last chunk variable in size,
 // possibly smaller than a full 128 KB.
+//
+// Large vectors are often short-lived (e.g. partition ranges, repair rows,
+// query results), so full-size chunks freed by one vector are kept in a
+// small per-thread pool, from which the next vector takes its chunks
+// instead of going through the allocator.
 
 #include "utils/small_vector.hh"
 
 #include <boost/range/algorithm/equal.hpp>
 #include <boost/algorithm/clamp.hpp>
 #include <boost/version.hpp>
+#include <array>
 #include <memory>
 #include <type_traits>
 #include <iterator>
@@ -57,14 +63,56 @@
 
 namespace utils {
 
+// Per-thread pool of free chunks of chunk_size bytes, shared by all
+// chunked_vectors with that max_contiguous_allocation. At most
+// max_pooled_bytes are kept, the rest is returned to the allocator.
+template <size_t chunk_size>
+class chunked_vector_chunk_pool {
+    static constexpr size_t max_pooled_bytes = 2 * 1024 * 1024;
+    static constexpr size_t max_pooled_chunks = std::max(max_pooled_bytes / chunk_size, size_t(1));
+    std::array<void*, max_pooled_chunks> _chunks;
+    size_t _nr_chunks = 0;
+public:
+    chunked_vector_chunk_pool() = default;
+    chunked_vector_chunk_pool(const chunked_vector_chunk_pool&) = delete;
+    ~chunked_vector_chunk_pool() {
+        while (_nr_chunks) {
+            ::free(_chunks[--_nr_chunks]);
+        }
+    }
+    static chunked_vector_chunk_pool& local() noexcept {
+        static thread_local chunked_vector_chunk_pool pool;
+        return pool;
+    }
+    // Returns a block of at least chunk_size bytes, or nullptr if out of memory
+    void* allocate() noexcept {
+        return _nr_chunks ? _chunks[--_nr_chunks] : ::malloc(chunk_size);
+    }
+    void free(void* x) noexcept {
+        // Blocks with a bit more room than chunk_size can be reused too,
+        // as allocators round sizes up.
+        auto size = ::malloc_usable_size(x);
+        if (size >= chunk_size && size < 2 * chunk_size && _nr_chunks < max_pooled_chunks) {
+            _chunks[_nr_chunks++] = x;
+        } else {
+            ::free(x);
+        }
+    }
+    size_t pooled_chunks() const noexcept {
+        return _nr_chunks;
+    }
+};
+
+template <size_t chunk_size>
 struct chunked_vector_free_deleter {
-    void operator()(void* x) const { ::free(x); }
+    void operator()(void* x) const { chunked_vector_chunk_pool<chunk_size>::local().free(x); }
 };
 
 template <typename T, size_t max_contiguous_allocation = 128*1024>
 class chunked_vector {
     static_assert(std::is_nothrow_move_constructible<T>::value, "T must be nothrow move constructible");
-    using chunk_ptr = std::unique_ptr<T[], chunked_vector_free_deleter>;
+    using chunk_pool = chunked_vector_chunk_pool<max_contiguous_allocation>;
+    using chunk_ptr = std::unique_ptr<T[], chunked_vector_free_deleter<max_contiguous_allocation>>;
     // Each chunk holds max_chunk_capacity() items, except possibly the last
     utils::small_vector<chunk_ptr, 1> _chunks;
     size_t _size = 0;
@@ -382,7 +430,11 @@ chunked_vector<T, max_contiguous_allocation>::~chunked_vector() {
 template <typename T, size_t max_contiguous_allocation>
 typename chunked_vector<T, max_contiguous_allocation>::chunk_ptr
 chunked_vector<T, max_contiguous_allocation>::new_chunk(size_t n) {
-    auto p = malloc(n * sizeof(T));
+    // Chunks of more than half the pooled size, the full ones in particular, are taken from the pool
+    auto bytes = n * sizeof(T);
+    auto p = bytes > max_contiguous_allocation / 2 && bytes <= max_contiguous_allocation
+            ? chunk_pool::local().allocate()
+            : ::malloc(bytes);
     if (!p) {
         throw std::bad_alloc();
     }
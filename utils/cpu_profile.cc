@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <fmt/format.h>
+#include "utils/cpu_profile.hh"
+
+namespace utils {
+
+cpu_profile::cpu_profile()
+    : _drain_timer([this] { drain(); })
+{}
+
+void cpu_profile::start(std::chrono::nanoseconds period) {
+    _stacks.clear();
+    _dropped = 0;
+    engine().set_cpu_profiler_period(period);
+    engine().set_cpu_profiler_enabled(true);
+    // Drop what an earlier run left behind
+    engine().profiler_results(_samples);
+    _samples.clear();
+    _drain_timer.arm_periodic(drain_period);
+}
+
+void cpu_profile::stop() {
+    if (!running()) {
+        return;
+    }
+    drain();
+    _drain_timer.cancel();
+    engine().set_cpu_profiler_enabled(false);
+}
+
+void cpu_profile::drain() {
+    engine().profiler_results(_samples);
+    for (auto& sample : _samples) {
+        stack s{sample.sg.name(), std::move(sample.user_backtrace)};
+        auto it = _stacks.find(s);
+        if (it != _stacks.end()) {
+            ++it->second;
+        } else if (_stacks.size() < max_stacks) {
+            _stacks.emplace(std::move(s), 1);
+        } else {
+            ++_dropped;
+        }
+    }
+    _samples.clear();
+}
+
+void cpu_profile::fold(std::unordered_map<sstring, uint64_t>& folded) {
+    if (running()) {
+        drain();
+    }
+    for (auto& [s, count] : _stacks) {
+        auto line = fmt::memory_buffer();
+        fmt::format_to(std::back_inserter(line), "{}", s.scheduling_group);
+        auto& frames = s.backtrace.frames();
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            if (it->so->name.empty()) {
+                fmt::format_to(std::back_inserter(line), ";0x{:x}", it->addr);
+            } else {
+                fmt::format_to(std::back_inserter(line), ";{}+0x{:x}", it->so->name, it->addr);
+            }
+        }
+        folded[sstring(line.data(), line.size())] += count;
+    }
+}
+
+cpu_profile& local_cpu_profile() {
+    static thread_local cpu_profile profile;
+    return profile;
+}
+
+}
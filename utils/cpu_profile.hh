@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/util/backtrace.hh>
+#include "seastarx.hh"
+
+namespace utils {
+
+/// Aggregates the samples of the seastar CPU profiler of a shard.
+///
+/// The profiler only keeps the last few samples, so they are drained
+/// periodically and counted by scheduling group and stack, which allows
+/// profiling a running node for as long as needed.
+class cpu_profile {
+    struct stack {
+        sstring scheduling_group;
+        simple_backtrace backtrace;
+
+        bool operator==(const stack&) const = default;
+    };
+    struct stack_hash {
+        size_t operator()(const stack& s) const {
+            return std::hash<simple_backtrace>()(s.backtrace) ^ std::hash<sstring>()(s.scheduling_group);
+        }
+    };
+
+    std::unordered_map<stack, uint64_t, stack_hash> _stacks;
+    std::vector<cpu_profiler_trace> _samples;
+    timer<lowres_clock> _drain_timer;
+    uint64_t _dropped = 0;
+
+    void drain();
+public:
+    // At least as often as the profiler fills its buffer at the
+    // highest sampling frequency worth using in production
+    static constexpr std::chrono::milliseconds drain_period{50};
+    // Bounds the memory used by a long profile of a varied workload
+    static constexpr size_t max_stacks = 100000;
+
+    cpu_profile();
+
+    // Starts sampling, every period of CPU time on average, and clears
+    // the previous profile
+    void start(std::chrono::nanoseconds period);
+    void stop();
+    bool running() const {
+        return _drain_timer.armed();
+    }
+
+    /// Adds the profile to folded, keyed by the folded stack: the
+    /// scheduling group and the frames, outermost first, separated by ';',
+    /// as flamegraph.pl expects once the addresses are symbolized.
+    void fold(std::unordered_map<sstring, uint64_t>& folded);
+
+    // Samples not counted because of max_stacks
+    uint64_t dropped() const {
+        return _dropped;
+    }
+};
+
+cpu_profile& local_cpu_profile();
+
+}
@@ -17,6 +17,9 @@ enum class digest_algorithm : uint8_t {
     MD5 = 1,
     legacy_xxHash_without_null_digest = 2,
     xxHash = 3, // default algorithm
+    // xxHash, with XXH3 combining the (cached) hashes of cells, which are
+    // still XXH64 ones.
+    xxHash3 = 4,
 };
 
 }
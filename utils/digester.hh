@@ -23,7 +23,7 @@ struct noop_hasher {
 };
 
 class digester final {
-    std::variant<noop_hasher, md5_hasher, xx_hasher, legacy_xx_hasher_without_null_digest> _impl;
+    std::variant<noop_hasher, md5_hasher, xx_hasher, legacy_xx_hasher_without_null_digest, xxh3_hasher> _impl;
 
 public:
     explicit digester(digest_algorithm algo) {
@@ -37,6 +37,9 @@ class digester final {
         case digest_algorithm::legacy_xxHash_without_null_digest:
             _impl = legacy_xx_hasher_without_null_digest();
             break;
+        case digest_algorithm::xxHash3:
+            _impl = xxh3_hasher();
+            break;
         case digest_algorithm ::none:
             _impl = noop_hasher();
             break;
@@ -58,6 +61,8 @@ class digester final {
     }
 };
 
+// The hasher of cells, whose hashes are cached (see cell_and_hash) and fed
+// to the digests instead of the cells, by all the hash-of-hash algorithms.
 using default_hasher = xx_hasher;
 
 template<typename Hasher>
@@ -214,6 +214,29 @@ class approx_exponential_histogram {
         return 0;
     }
 
+    /*!
+     * \brief returns an estimation of the value at the given quantile (0 to 1).
+     * This method returns the upper limit of the bucket holding the quantile,
+     * or Max if it's the overflow bucket.
+     *
+     * It will return 0 if the histogram is empty.
+     */
+    uint64_t percentile(double quantile) const {
+        auto total = count();
+        if (!total) {
+            return 0;
+        }
+        auto target = std::max<uint64_t>(1, std::ceil(quantile * total));
+        uint64_t sum = 0;
+        for (size_t i = 0; i < NUM_BUCKETS - 1; i++) {
+            sum += _buckets[i];
+            if (sum >= target) {
+                return get_bucket_upper_limit(i);
+            }
+        }
+        return Max;
+    }
+
     /*!
      * \brief merge a histogram to the current one.
      */
@@ -349,6 +372,32 @@ class time_estimated_histogram : public approx_exponential_histogram<512, 335544
     }
 };
 
+/*!
+ * \brief fine-grained estimated histogram for duration values
+ * precise_time_estimated_histogram covers the range of 64us to 33s with a
+ * precision of 8, so values are counted within 12.5% of their bucket's
+ * lower limit, for accurate tail percentiles.
+ *
+ * 64us, 72us, 80us, 88us, 96us, 104us, 112us, 120us, 128us, 144us...29s, 31s, 33s (33554432us)
+ */
+class precise_time_estimated_histogram : public approx_exponential_histogram<64, 33554432, 8> {
+public:
+    using clock = std::chrono::steady_clock;
+    using duration = clock::duration;
+    precise_time_estimated_histogram& merge(const precise_time_estimated_histogram& b) {
+        approx_exponential_histogram<64, 33554432, 8>::merge(b);
+        return *this;
+    }
+
+    void add_micro(uint64_t n) {
+        approx_exponential_histogram<64, 33554432, 8>::add(n);
+    }
+
+    void add(const duration& latency) {
+        add_micro(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+    }
+};
+
 inline time_estimated_histogram time_estimated_histogram_merge(time_estimated_histogram a, const time_estimated_histogram& b) {
     return a.merge(b);
 }
@@ -275,6 +275,16 @@ void skip_empty_fragments(View& v) {
 
 template<FragmentedView V1, FragmentedView V2>
 std::strong_ordering compare_unsigned(V1 v1, V2 v2) {
+    // Most values (cells, key components) fit in a single fragment
+    if (v1.current_fragment().size() == v1.size_bytes() && v2.current_fragment().size() == v2.size_bytes()) [[likely]] {
+        size_t n = std::min(v1.size_bytes(), v2.size_bytes());
+        if (n) {
+            if (int d = memcmp(v1.current_fragment().data(), v2.current_fragment().data(), n)) {
+                return d <=> 0;
+            }
+        }
+        return v1.size_bytes() <=> v2.size_bytes();
+    }
     while (!v1.empty() && !v2.empty()) {
         size_t n = std::min(v1.current_fragment().size(), v2.current_fragment().size());
         if (int d = memcmp(v1.current_fragment().data(), v2.current_fragment().data(), n)) {
@@ -298,6 +308,13 @@ void write_fragmented(Dest& dest, Src src) {
     if (dest.size_bytes() < src.size_bytes()) [[unlikely]] {
         throw std::out_of_range(format("tried to copy a buffer of size {} to a buffer of smaller size {}", src.size_bytes(), dest.size_bytes()));
     }
+    if (src.current_fragment().size() == src.size_bytes() && dest.current_fragment().size() >= src.size_bytes()) [[likely]] {
+        if (!src.empty()) {
+            memcpy(dest.current_fragment().data(), src.current_fragment().data(), src.size_bytes());
+            dest.remove_prefix(src.size_bytes());
+        }
+        return;
+    }
     while (!src.empty()) {
         size_t n = std::min(dest.current_fragment().size(), src.current_fragment().size());
         memcpy(dest.current_fragment().data(), src.current_fragment().data(), n);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+// Approximate, aging frequency counter for a stream of keys, as used by the
+// TinyLFU admission policy:
+//
+//  [1] Einziger, G., Friedman, R., & Manes, B. (2017).
+//      TinyLFU: A Highly Efficient Cache Admission Policy.
+//      ACM Transactions on Storage, 13(4).
+//
+// It is a count-min sketch with 4-bit saturating counters packed sixteen to
+// a 64-bit word. Each key updates one counter in each of four rows, and its
+// estimate is the minimum of them, so estimates never undercount (except
+// after aging). Once sample_size() increments were recorded all counters are
+// halved, which keeps the estimates reflecting recent history only.
+//
+// Keys are given as 64-bit hashes, which should be well mixed.
+class frequency_sketch {
+public:
+    static constexpr unsigned max_count = 15;
+private:
+    static constexpr unsigned depth = 4;
+    static constexpr uint64_t seeds[depth] = {
+        0xc3a5c85c97cb3127ull, 0xb492b66fbe98f273ull, 0x9ae16a3b2f90404full, 0xcbf29ce484222325ull,
+    };
+
+    std::vector<uint64_t> _table;
+    uint64_t _mask;
+    uint64_t _sample_size;
+    uint64_t _additions = 0;
+private:
+    static uint64_t mix(uint64_t h, uint64_t seed) noexcept {
+        h = (h + seed) * 0x9e3779b97f4a7c15ull;
+        h ^= h >> 32;
+        return h;
+    }
+    // Position of the counter for the given hash in row i: a word, and a
+    // nibble within it. Rows use disjoint nibbles of the word, so the four
+    // counters of a key are independent even if they land in the same word.
+    std::pair<size_t, unsigned> slot(uint64_t hash, unsigned i) const noexcept {
+        auto h = mix(hash, seeds[i]);
+        return {h & _mask, 4 * (i * 4 + ((h >> 60) & 3))};
+    }
+public:
+    // Sized to track about expected_keys distinct keys.
+    explicit frequency_sketch(size_t expected_keys)
+        : _table(std::bit_ceil(std::max<size_t>(expected_keys, 8)))
+        , _mask(_table.size() - 1)
+        , _sample_size(std::max<uint64_t>(expected_keys, 1) * 10)
+    { }
+
+    // Records an occurrence of the key.
+    void increment(uint64_t hash) noexcept {
+        bool added = false;
+        for (unsigned i = 0; i < depth; ++i) {
+            auto [idx, shift] = slot(hash, i);
+            auto& w = _table[idx];
+            if (((w >> shift) & 0xf) != max_count) {
+                w += uint64_t(1) << shift;
+                added = true;
+            }
+        }
+        if (added && ++_additions >= _sample_size) {
+            age();
+        }
+    }
+
+    // Returns the estimated number of recent occurrences of the key,
+    // saturated at max_count.
+    unsigned estimate(uint64_t hash) const noexcept {
+        unsigned res = max_count;
+        for (unsigned i = 0; i < depth; ++i) {
+            auto [idx, shift] = slot(hash, i);
+            res = std::min(res, unsigned((_table[idx] >> shift) & 0xf));
+        }
+        return res;
+    }
+
+    // Halves all counters. Done automatically every sample_size() increments.
+    void age() noexcept {
+        // Shift the words and drop the bits which crossed over from the
+        // neighbouring counters.
+        for (auto& w : _table) {
+            w = (w >> 1) & 0x7777777777777777ull;
+        }
+        _additions /= 2;
+    }
+
+    uint64_t sample_size() const noexcept {
+        return _sample_size;
+    }
+
+    void clear() noexcept {
+        std::fill(_table.begin(), _table.end(), 0);
+        _additions = 0;
+    }
+};
+
+} // namespace utils
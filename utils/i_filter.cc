@@ -31,6 +31,18 @@ filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_proba
     return filter::create_filter(spec.K, num_elements, spec.buckets_per_element, fformat);
 }
 
+filter_ptr i_filter::get_split_block_filter(int64_t num_elements, double max_false_pos_probability) {
+    if (max_false_pos_probability > 1.0) {
+        throw std::invalid_argument(format("Invalid probability {:f}: must be lower than 1.0", max_false_pos_probability));
+    }
+
+    if (max_false_pos_probability == 1.0) {
+        return std::make_unique<filter::always_present_filter>();
+    }
+
+    return filter::create_split_block_filter(num_elements, max_false_pos_probability);
+}
+
 hashed_key make_hashed_key(bytes_view b) {
     std::array<uint64_t, 2> h;
     utils::murmur_hash::hash3_x64_128(b, 0, h);
@@ -53,5 +53,11 @@ struct i_filter {
      *         filter.
      */
     static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format);
+
+    /**
+     * @return A split-block bloom filter (see utils::filter::split_block_bloom_filter)
+     *         sized for the given false positive probability and number of elements.
+     */
+    static filter_ptr get_split_block_filter(int64_t num_elements, double max_false_pos_prob);
 };
 }
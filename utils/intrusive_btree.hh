@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/intrusive/parent_from_member.hpp>
 #include <seastar/util/alloc_failure_injector.hh>
 #include <cassert>
@@ -1041,10 +1042,18 @@ struct searcher<K, Key, Hook, Compare, key_search::linear> {
     static key_index ge(const K& k, const node_base& node, const Compare& cmp, bool& match) {
         key_index i;
 
+        // The keys are scattered in memory, so comparing them one after
+        // another stalls on a cache miss per key. Issuing the loads of
+        // the next few keys ahead lets the misses overlap.
+        constexpr key_index prefetch_distance = 4;
+        for (i = 0; i < std::min<key_index>(prefetch_distance, node.num_keys); i++) {
+            __builtin_prefetch(node.keys[i]->to_key<Key, Hook>());
+        }
+
         match = false;
         for (i = 0; i < node.num_keys; i++) {
-            if (i + 1 < node.num_keys) {
-                __builtin_prefetch(node.keys[i + 1]->to_key<Key, Hook>());
+            if (i + prefetch_distance < node.num_keys) {
+                __builtin_prefetch(node.keys[i + prefetch_distance]->to_key<Key, Hook>());
             }
             auto x = cmp(k, *node.keys[i]->to_key<Key, Hook>());
             if (x <= 0) {
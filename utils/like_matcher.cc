@@ -12,7 +12,13 @@
 
 #include <boost/regex/icu.hpp>
 #include <boost/locale/encoding.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -75,34 +81,140 @@ wstring regex_from_pattern(bytes_view pattern) {
     return re;
 }
 
+/// An element of a LIKE pattern: either a wildcard or a run of literal characters, with escapes removed.
+struct pattern_token {
+    bytes::value_type wildcard = 0; ///< '%' or '_', or 0 for a literal.
+    bytes literal;
+};
+
+/// Splits a LIKE pattern into wildcards and literals.  The special characters are all ASCII, so this works
+/// on the UTF-8 bytes without decoding them.
+std::vector<pattern_token> tokenize(bytes_view pattern) {
+    std::vector<pattern_token> tokens;
+    bytes literal;
+    auto flush_literal = [&] {
+        if (!literal.empty()) {
+            tokens.push_back(pattern_token{.literal = std::exchange(literal, bytes())});
+        }
+    };
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        const auto c = pattern[i];
+        if (c == '\\') {
+            // A backslash at the end matches itself, like in regex_from_pattern().
+            literal.push_back(i + 1 < pattern.size() ? pattern[++i] : c);
+        } else if (c == '%' || c == '_') {
+            flush_literal();
+            tokens.push_back(pattern_token{.wildcard = c});
+        } else {
+            literal.push_back(c);
+        }
+    }
+    flush_literal();
+    return tokens;
+}
+
 } // anonymous namespace
 
 class like_matcher::impl {
+    /// Patterns with no '_' and '%' only at their ends are matched by comparing bytes, which is also correct for
+    /// UTF-8.  Other patterns are matched by the regex, after checking that the text contains their longest
+    /// literal.
+    enum class shape {
+        exact,     ///< 'abc'
+        prefix,    ///< 'abc%'
+        suffix,    ///< '%abc'
+        substring, ///< '%abc%'
+        any,       ///< '%'
+        general,
+    };
+
     bytes _pattern;
-    boost::u32regex _re; // Performs pattern matching.
+    shape _shape;
+    bytes _literal; ///< The literal of the pattern, or its longest one for shape::general.
+    std::optional<boost::u32regex> _re; // Performs pattern matching, for shape::general.
   public:
     explicit impl(bytes_view pattern);
     bool operator()(bytes_view text) const;
     void reset(bytes_view pattern);
   private:
-    void init_re() {
-        _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+    void init() {
+        classify();
+        if (_shape == shape::general) {
+            _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+        } else {
+            _re.reset();
+            // Reject patterns which aren't valid UTF-8, like boost::make_u32regex() does.
+            using namespace boost::locale::conv;
+            const bytes_view pattern = _pattern;
+            utf_to_utf<wchar_t>(pattern.begin(), pattern.end(), stop);
+        }
+    }
+
+    void classify() {
+        const auto tokens = tokenize(_pattern);
+        auto is_percent = [] (const pattern_token& t) { return t.wildcard == '%'; };
+        auto first = std::find_if_not(tokens.begin(), tokens.end(), is_percent);
+        auto last = std::find_if_not(tokens.rbegin(), std::make_reverse_iterator(first), is_percent).base();
+        const bool leading_percent = first != tokens.begin();
+        const bool trailing_percent = last != tokens.end();
+        _literal = bytes();
+        if (first == last) {
+            _shape = leading_percent ? shape::any : shape::exact;
+        } else if (std::next(first) == last && !first->wildcard) {
+            _literal = first->literal;
+            _shape = leading_percent
+                    ? (trailing_percent ? shape::substring : shape::suffix)
+                    : (trailing_percent ? shape::prefix : shape::exact);
+        } else {
+            _shape = shape::general;
+            for (auto& t : tokens) {
+                if (t.literal.size() > _literal.size()) {
+                    _literal = t.literal;
+                }
+            }
+        }
+    }
+
+    bool contains_literal(bytes_view text) const {
+        return _literal.empty() || ::memmem(text.data(), text.size(), _literal.data(), _literal.size());
     }
 };
 
 like_matcher::impl::impl(bytes_view pattern) : _pattern(pattern) {
-    init_re();
+    init();
 }
 
 bool like_matcher::impl::operator()(bytes_view text) const {
-    return boost::u32regex_match(text.begin(), text.end(), _re);
+    switch (_shape) {
+    case shape::exact:
+        return text == bytes_view(_literal);
+    case shape::prefix:
+        return text.starts_with(bytes_view(_literal));
+    case shape::suffix:
+        return text.ends_with(bytes_view(_literal));
+    case shape::substring:
+        return contains_literal(text);
+    case shape::any:
+        return true;
+    case shape::general:
+        return contains_literal(text) && boost::u32regex_match(text.begin(), text.end(), *_re);
+    }
+    __builtin_unreachable();
 }
 
 void like_matcher::impl::reset(bytes_view pattern) {
     if (pattern != _pattern) {
         _pattern = bytes(pattern);
-        init_re();
+        init();
+    }
+}
+
+bytes like_matcher::literal_prefix(bytes_view pattern) {
+    auto tokens = tokenize(pattern);
+    if (tokens.empty() || tokens.front().wildcard) {
+        return bytes();
     }
+    return std::move(tokens.front().literal);
 }
 
 like_matcher::like_matcher(bytes_view pattern)
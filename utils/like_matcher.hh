@@ -41,4 +41,10 @@ class like_matcher {
 
     /// Resets pattern if different from the current one.
     void reset(bytes_view pattern);
+
+    /// Returns the text preceding the first wildcard of \c pattern, with escapes removed.
+    ///
+    /// Every text matching \c pattern starts with it, so e.g. a range of sorted texts can be narrowed down
+    /// to the ones starting with it before matching them.
+    static bytes literal_prefix(bytes_view pattern);
 };
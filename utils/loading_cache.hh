@@ -28,6 +28,7 @@
 #include "exceptions/exceptions.hh"
 #include "utils/loading_shared_values.hh"
 #include "utils/chunked_vector.hh"
+#include "utils/frequency_sketch.hh"
 #include "log.hh"
 
 namespace bi = boost::intrusive;
@@ -88,6 +89,12 @@ struct do_nothing_loading_cache_stats {
 /// If cache size is still too big event after there are no more entries in the unprivileged section the least recently used entries
 /// from the privileged section are going to be evicted till the cache size restriction is met.
 ///
+/// With enable_frequency_based_eviction(), the cache also keeps an approximate count of recent reads of each key,
+/// including the keys which are no longer cached (see utils::frequency_sketch). A privileged entry which would be
+/// evicted to make room is then kept, and the least recently used unprivileged one evicted in its place, if the
+/// latter was read less frequently. This protects the frequently used entries from floods of entries used only once
+/// or twice, down to a smaller minimum of the unprivileged section.
+///
 /// The size of the cache is defined as a sum of sizes of all cached entries.
 /// The size of each entry is defined by the value returned by the \tparam EntrySize predicate applied on it.
 ///
@@ -270,6 +277,12 @@ class loading_cache {
         _lru_list.erase_and_dispose(_lru_list.begin(), _lru_list.end(), value_destroyer);
     }
 
+    /// Enables the frequency based choice between the privileged and the unprivileged eviction candidates,
+    /// see the class description. The frequencies are tracked for about expected_entries keys.
+    void enable_frequency_based_eviction(size_t expected_entries) {
+        _frequency_sketch.emplace(expected_entries);
+    }
+
     void reset() noexcept {
         _logger.info("Resetting cache");
 
@@ -475,6 +488,24 @@ class loading_cache {
         return _cfg.expiry != lowres_clock::duration(0);
     }
 
+    static uint64_t frequency_hash(const Key& key) noexcept {
+        // The sketch expects well mixed hashes, std::hash is often the identity.
+        uint64_t h = Hash()(key);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+        return h ^ (h >> 31);
+    }
+
+    // Whether the LRU unprivileged entry should be evicted instead of the LRU privileged one.
+    bool prefer_unprivileged_eviction() const noexcept {
+        if (!_frequency_sketch || _unprivileged_lru_list.empty() || _lru_list.empty()
+                || _unprivileged_section_size <= _cfg.max_size / 8) {
+            return false;
+        }
+        return _frequency_sketch->estimate(frequency_hash(_unprivileged_lru_list.rbegin()->key()))
+                < _frequency_sketch->estimate(frequency_hash(_lru_list.rbegin()->key()));
+    }
+
     static void destroy_ts_value(ts_value_lru_entry* val) noexcept {
         Alloc().delete_object(val);
     }
@@ -488,6 +519,9 @@ class loading_cache {
     ///
     /// \param lru_entry Cache item that has been "touched"
     void touch_lru_entry_2_sections(ts_value_lru_entry& lru_entry) {
+        if (_frequency_sketch) {
+            _frequency_sketch->increment(frequency_hash(lru_entry.key()));
+        }
         if (lru_entry.is_linked()) {
             lru_list_type& lru_list = container_list(lru_entry);
             lru_list.erase(lru_list.iterator_to(lru_entry));
@@ -607,7 +641,11 @@ class loading_cache {
         }
 
         while (memory_footprint() >= _cfg.max_size && !_lru_list.empty()) {
-            drop_privileged_entry();
+            if (prefer_unprivileged_eviction()) {
+                drop_unprivileged_entry();
+            } else {
+                drop_privileged_entry();
+            }
         }
 
         // If dropping entries from privileged section did not help,
@@ -695,6 +733,7 @@ class loading_cache {
     std::function<future<Tp>(const Key&)> _load;
     timer<loading_cache_clock_type> _timer;
     seastar::gate _timer_reads_gate;
+    std::optional<utils::frequency_sketch> _frequency_sketch;
 };
 
 template<typename Key, typename Tp, int SectionHitThreshold, loading_cache_reload_enabled ReloadEnabled, typename EntrySize, typename Hash, typename EqualPred, typename LoadingSharedValuesStats, typename LoadingCacheStats, typename Alloc>
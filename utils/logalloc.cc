@@ -36,6 +36,7 @@
 #include "utils/coarse_steady_clock.hh"
 
 #include <random>
+#include <cstring>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -356,23 +357,34 @@ static thread_local tracker& tracker_instance = get_tracker_instance();
 
 using clock = std::chrono::steady_clock;
 
+// Reclaims memory in the background when free memory runs low, and compacts
+// sparse segments ahead of the need, while it's cheap, so that foreground
+// allocations rarely have to compact synchronously.
 class background_reclaimer {
     scheduling_group _sg;
     noncopyable_function<void (size_t target)> _reclaim;
+    noncopyable_function<bool ()> _has_compaction_work;
+    noncopyable_function<void ()> _compact;
     timer<lowres_clock> _adjust_shares_timer;
     // If engaged, main loop is not running, set_value() to wake it.
     promise<>* _main_loop_wait = nullptr;
     future<> _done;
     bool _stopping = false;
+public:
     static constexpr size_t free_memory_threshold = 60'000'000;
+    // Compaction ahead of the need is a budgeted, low priority work
+    static constexpr float compaction_shares = 50;
 private:
-    bool have_work() const {
+    bool have_reclaim_work() const {
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
         return memory::free_memory() < free_memory_threshold;
 #else
         return false;
 #endif
     }
+    bool have_work() const {
+        return have_reclaim_work() || _has_compaction_work();
+    }
     void main_loop_wake() {
         llogger.debug("background_reclaimer::main_loop_wake: waking {}", bool(_main_loop_wait));
         if (_main_loop_wait) {
@@ -394,14 +406,20 @@ class background_reclaimer {
             if (_stopping) {
                 break;
             }
-            _reclaim(free_memory_threshold - memory::free_memory());
+            if (have_reclaim_work()) {
+                _reclaim(free_memory_threshold - memory::free_memory());
+            } else {
+                _compact();
+            }
             co_await coroutine::maybe_yield();
         }
         llogger.debug("background_reclaimer::main_loop: exit");
     }
     void adjust_shares() {
         if (have_work()) {
-            auto shares = 1 + (1000 * (free_memory_threshold - memory::free_memory())) / free_memory_threshold;
+            auto shares = have_reclaim_work()
+                    ? 1 + (1000 * (free_memory_threshold - memory::free_memory())) / free_memory_threshold
+                    : compaction_shares;
             _sg.set_shares(shares);
             llogger.trace("background_reclaimer::adjust_shares: {}", shares);
             if (_main_loop_wait) {
@@ -410,9 +428,12 @@ class background_reclaimer {
         }
     }
 public:
-    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim)
+    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim,
+            noncopyable_function<bool ()> has_compaction_work, noncopyable_function<void ()> compact)
             : _sg(sg)
             , _reclaim(std::move(reclaim))
+            , _has_compaction_work(std::move(has_compaction_work))
+            , _compact(std::move(compact))
             , _adjust_shares_timer(default_scheduling_group(), [this] { adjust_shares(); })
             , _done(with_scheduling_group(_sg, [this] { return main_loop(); })) {
         if (sg != default_scheduling_group()) {
@@ -432,6 +453,10 @@ struct reclaim_timer;
 class tracker::impl {
     std::unique_ptr<logalloc::segment_pool> _segment_pool;
     std::optional<background_reclaimer> _background_reclaimer;
+    struct background_compaction_stats {
+        uint64_t segments_compacted = 0;
+        clock::duration time{};
+    } _background_compaction_stats;
     std::vector<region::impl*> _regions;
     seastar::metrics::metric_groups _metrics;
     unsigned _reclaiming_disabled_depth = 0;
@@ -480,6 +505,15 @@ class tracker::impl {
     // Compacts one segment at a time from sparsest segment to least sparse until work_waiting_on_reactor returns true
     // or there are no more segments to compact.
     idle_cpu_handler_result compact_on_idle(work_waiting_on_reactor check_for_work);
+    // The region whose sparsest segment is worth compacting ahead of the need, if any.
+    //
+    // Compacting a segment with used fraction u copies u of a segment to free
+    // 1 - u of one. Only the segments which cost no more than they free are
+    // compacted so, and only with free memory getting short and not enough
+    // free segments in the pool already, not to defragment memory nobody needs.
+    region::impl* background_compaction_candidate() const noexcept;
+    // Compacts the segments worth it, until preempted.
+    void compact_in_background();
     // Releases whole segments back to the segment pool.
     // After the call, if there is enough evictable memory, the amount of free segments in the pool
     // will be at least reserve_segments + div_ceil(bytes, segment::size).
@@ -501,6 +535,10 @@ class tracker::impl {
         assert(!_background_reclaimer);
         _background_reclaimer.emplace(sg, [this] (size_t target) {
             reclaim(target, is_preemptible::yes);
+        }, [this] {
+            return !_reclaiming_disabled_depth && background_compaction_candidate() != nullptr;
+        }, [this] {
+            compact_in_background();
         });
     }
     // const bool&, so interested parties can save a reference and see updates.
@@ -846,6 +884,9 @@ class contiguous_memory_segment_store {
     bool can_allocate_more_segments() const noexcept {
         return _backend->can_allocate_more_segments(non_lsa_reserve);
     }
+    memory::memory_layout memory_layout() const noexcept {
+        return _backend->memory_layout();
+    }
 };
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
 using segment_store = contiguous_memory_segment_store;
@@ -1024,6 +1065,7 @@ class segment_pool {
     logalloc::tracker::impl& tracker() { return _tracker; }
     void prime(size_t available_memory, size_t min_free_memory);
     void use_standard_allocator_segment_pool_backend(size_t available_memory);
+    void use_transparent_hugepages();
     segment* new_segment(region::impl* r);
     const segment_descriptor& descriptor(const segment* seg) const noexcept {
         uintptr_t index = idx_from_segment(seg);
@@ -1392,6 +1434,30 @@ void segment_pool::use_standard_allocator_segment_pool_backend(size_t available_
     _lsa_free_segments_bitmap = utils::dynamic_bitset(max_segments());
 }
 
+// The segments are carved from the top of the shard's memory (see prime()),
+// and released to the seastar allocator from the bottom, so the memory which
+// the pool owns after priming is where its segments will mostly live.
+void segment_pool::use_transparent_hugepages() {
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    static constexpr uintptr_t huge_page_size = 2 * 1024 * 1024;
+    auto first = _lsa_owned_segments_bitmap.find_first_set();
+    if (first == utils::dynamic_bitset::npos) {
+        llogger.warn("No segments to back with transparent huge pages, the pool wasn't primed");
+        return;
+    }
+    auto start = align_up(reinterpret_cast<uintptr_t>(segment_from_idx(first)), huge_page_size);
+    auto end = align_down(_store.memory_layout().end, huge_page_size);
+    if (start >= end) {
+        return;
+    }
+    if (madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE)) {
+        llogger.warn("Failed to back segments with transparent huge pages: {}", strerror(errno));
+        return;
+    }
+    llogger.debug("Backing {} MiB of segments with transparent huge pages", (end - start) >> 20);
+#endif
+}
+
 inline void segment_pool::on_segment_compaction(size_t used_size) noexcept {
     _stats.segments_compacted++;
     _stats.memory_compacted += used_size;
@@ -2567,6 +2633,44 @@ idle_cpu_handler_result tracker::impl::compact_on_idle(work_waiting_on_reactor c
     return idle_cpu_handler_result::interrupted_by_higher_priority_task;
 }
 
+region::impl* tracker::impl::background_compaction_candidate() const noexcept {
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    static constexpr float max_used_fraction = 0.5;
+    static constexpr size_t free_memory_threshold = 2 * background_reclaimer::free_memory_threshold;
+    if (memory::free_memory() + _segment_pool->unreserved_free_segments() * segment::size >= free_memory_threshold) {
+        return nullptr;
+    }
+    region::impl* candidate = nullptr;
+    for (region::impl* r : _regions) {
+        if (r->is_compactible() && r->min_occupancy().used_fraction() <= max_used_fraction
+                && (!candidate || r->min_occupancy() < candidate->min_occupancy())) {
+            candidate = r;
+        }
+    }
+    return candidate;
+#else
+    return nullptr;
+#endif
+}
+
+void tracker::impl::compact_in_background() {
+    if (_reclaiming_disabled_depth) {
+        return;
+    }
+    reclaiming_lock rl(*this);
+    segment_pool::reservation_goal open_emergency_pool(*_segment_pool, 0);
+
+    auto start = clock::now();
+    while (auto* r = background_compaction_candidate()) {
+        r->compact();
+        _background_compaction_stats.segments_compacted++;
+        if (need_preempt()) {
+            break;
+        }
+    }
+    _background_compaction_stats.time += clock::now() - start;
+}
+
 size_t tracker::impl::reclaim(size_t memory_to_release, is_preemptible preempt) {
     if (_reclaiming_disabled_depth) {
         return 0;
@@ -2788,6 +2892,12 @@ tracker::impl::impl() : _segment_pool(std::make_unique<logalloc::segment_pool>(*
         sm::make_counter("segments_compacted", [this] { return _segment_pool->statistics().segments_compacted; },
                         sm::description("Counts a number of compacted segments.")),
 
+        sm::make_counter("segments_compacted_in_background", [this] { return _background_compaction_stats.segments_compacted; },
+                        sm::description("Counts a number of segments compacted in the background, ahead of memory pressure.")),
+
+        sm::make_counter("background_compaction_time_ms", [this] { return std::chrono::duration_cast<std::chrono::milliseconds>(_background_compaction_stats.time).count(); },
+                        sm::description("Counts the time spent compacting segments in the background, ahead of memory pressure, which allocations would otherwise have spent compacting them synchronously.")),
+
         sm::make_counter("memory_compacted", [this] { return _segment_pool->statistics().memory_compacted; },
                         sm::description("Counts number of bytes which were copied as part of segment compaction.")),
 
@@ -2916,6 +3026,12 @@ future<> prime_segment_pool(size_t available_memory, size_t min_free_memory) {
     });
 }
 
+future<> use_transparent_hugepages() {
+    return smp::invoke_on_all([] {
+        shard_tracker().get_impl().segment_pool().use_transparent_hugepages();
+    });
+}
+
 future<> use_standard_allocator_segment_pool_backend(size_t available_memory) {
     return smp::invoke_on_all([=] {
         shard_tracker().get_impl().segment_pool().use_standard_allocator_segment_pool_backend(available_memory);
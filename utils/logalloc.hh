@@ -525,6 +525,12 @@ class allocating_section {
 
 future<> prime_segment_pool(size_t available_memory, size_t min_free_memory);
 
+// Asks the kernel to back the memory of the segments with transparent huge
+// pages, cutting the TLB misses of walking the objects in them. Call after
+// prime_segment_pool(). Explicit huge pages back all the memory, with
+// seastar's --hugepages option.
+future<> use_transparent_hugepages();
+
 // Use the segment pool appropriate for the standard allocator.
 //
 // In debug mode, this will use the release standard allocator store.
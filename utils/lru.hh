@@ -41,6 +41,13 @@ class evictable {
     // Used for testing to avoid cascading eviction of the containing object.
     virtual void on_evicted_shallow() noexcept { on_evicted(); }
 
+    // Segment of the lru this element belongs to, see lru.
+    // The storage is provided by the derived class, usually in a spare bit.
+    // Elements which don't provide it always stay in the probationary segment.
+    virtual bool lru_protected() const noexcept { return false; }
+    // Returns false if the element can't be protected.
+    virtual bool set_lru_protected(bool) noexcept { return false; }
+
     bool is_linked() const {
         return _lru_link.is_linked();
     }
@@ -50,48 +57,147 @@ class evictable {
     }
 };
 
+// Segmented LRU.
+//
+// Newly added elements enter the probationary segment. Elements which are
+// used again while in the lru (touch()), or while temporarily unlinked (see
+// mark_referenced()), are promoted to the protected segment. The protected
+// segment is limited to protected_share of all elements, its least recently
+// used elements are demoted back to probation. Eviction takes from the
+// probationary segment first, so elements used only once, e.g. by a scan,
+// don't push out the ones which are used repeatedly.
 class lru {
 private:
     friend class evictable;
     using lru_type = boost::intrusive::list<evictable,
         boost::intrusive::member_hook<evictable, evictable::lru_link_type, &evictable::_lru_link>,
         boost::intrusive::constant_time_size<false>>; // we need this to have bi::auto_unlink on hooks.
-    lru_type _list;
+public:
+    struct stats {
+        uint64_t probation_size = 0;
+        uint64_t protected_size = 0;
+        uint64_t promotions = 0;
+        uint64_t demotions = 0;
+        uint64_t probation_evictions = 0;
+        uint64_t protected_evictions = 0;
+    };
+private:
+    lru_type _probation;
+    lru_type _protected;
+    stats _stats;
+    float _protected_share = 0.8;
+private:
+    lru_type& segment_of(const evictable& e) noexcept {
+        return e.lru_protected() ? _protected : _probation;
+    }
+    void link(evictable& e) noexcept {
+        if (e.lru_protected()) {
+            _protected.push_back(e);
+            ++_stats.protected_size;
+            rebalance();
+        } else {
+            _probation.push_back(e);
+            ++_stats.probation_size;
+        }
+    }
+    void rebalance() noexcept {
+        while (_stats.protected_size > _protected_share * (_stats.protected_size + _stats.probation_size)) {
+            evictable& e = _protected.front();
+            _protected.pop_front();
+            --_stats.protected_size;
+            e.set_lru_protected(false);
+            _probation.push_back(e);
+            ++_stats.probation_size;
+            ++_stats.demotions;
+        }
+    }
 public:
     using reclaiming_result = seastar::memory::reclaiming_result;
 
     ~lru() {
-        _list.clear_and_dispose([] (evictable* e) {
+        auto dispose = [] (evictable* e) {
             e->on_evicted();
-        });
+        };
+        _probation.clear_and_dispose(dispose);
+        _protected.clear_and_dispose(dispose);
+    }
+
+    // Sets the maximum fraction of elements in the protected segment.
+    void set_protected_share(float share) noexcept {
+        _protected_share = share;
+        rebalance();
+    }
+
+    const stats& get_stats() const noexcept {
+        return _stats;
     }
 
     void remove(evictable& e) noexcept {
-        _list.erase(_list.iterator_to(e));
+        if (e.lru_protected()) {
+            --_stats.protected_size;
+        } else {
+            --_stats.probation_size;
+        }
+        e._lru_link.unlink();
     }
 
+    // Adds e to the segment it was in last time (probation for new elements).
     void add(evictable& e) noexcept {
-        _list.push_back(e);
+        link(e);
     }
 
     // Like add(e) but makes sure that e is evicted right before "more_recent" in the absence of later touches.
+    // e joins the segment of more_recent, if it can.
     void add_before(evictable& more_recent, evictable& e) noexcept {
-        _list.insert(_list.iterator_to(more_recent), e);
+        bool prot = more_recent.lru_protected() && e.set_lru_protected(true);
+        if (!prot) {
+            e.set_lru_protected(false);
+        }
+        if (prot != more_recent.lru_protected()) {
+            return link(e);
+        }
+        segment_of(more_recent).insert(lru_type::s_iterator_to(more_recent), e);
+        if (prot) {
+            ++_stats.protected_size;
+            rebalance();
+        } else {
+            ++_stats.probation_size;
+        }
+    }
+
+    // Records a use of an element which is not linked (e.g. held by a reader),
+    // so that it's promoted when added back.
+    void mark_referenced(evictable& e) noexcept {
+        if (!e.lru_protected() && e.set_lru_protected(true)) {
+            ++_stats.promotions;
+        }
     }
 
+    // Marks e as most recently used and promotes it to the protected segment.
     void touch(evictable& e) noexcept {
         remove(e);
+        mark_referenced(e);
         add(e);
     }
 
     // Evicts a single element from the LRU
     template <bool Shallow = false>
     reclaiming_result do_evict() noexcept {
-        if (_list.empty()) {
-            return reclaiming_result::reclaimed_nothing;
+        lru_type* list = &_probation;
+        if (_probation.empty()) {
+            if (_protected.empty()) {
+                return reclaiming_result::reclaimed_nothing;
+            }
+            list = &_protected;
+            --_stats.protected_size;
+            ++_stats.protected_evictions;
+        } else {
+            --_stats.probation_size;
+            ++_stats.probation_evictions;
         }
-        evictable& e = _list.front();
-        _list.pop_front();
+        evictable& e = list->front();
+        list->pop_front();
+        e.set_lru_protected(false);
         if constexpr (!Shallow) {
             e.on_evicted();
         } else {
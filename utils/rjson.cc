@@ -224,7 +224,17 @@ std::string print(const rjson::value& value, size_t max_nested_level) {
     string_buffer buffer;
     guarded_yieldable_json_handler<writer, false> writer(buffer, max_nested_level);
     value.Accept(writer);
-    return std::string(buffer.GetString());
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+bytes print_to_bytes(const rjson::value& value, bytes_view prefix, size_t max_nested_level) {
+    string_buffer buffer;
+    guarded_yieldable_json_handler<writer, false> writer(buffer, max_nested_level);
+    value.Accept(writer);
+    bytes ret(bytes::initialized_later(), prefix.size() + buffer.GetSize());
+    auto out = std::copy(prefix.begin(), prefix.end(), ret.begin());
+    std::copy_n(reinterpret_cast<const int8_t*>(buffer.GetString()), buffer.GetSize(), out);
+    return ret;
 }
 
 // This class implements RapidJSON Handler and batches Put() calls into output_stream writes.
@@ -142,6 +142,10 @@ inline rjson::value empty_string() {
 // The representation is dense - without any redundant indentation.
 std::string print(const rjson::value& value, size_t max_nested_level = default_max_nested_level);
 
+// Like print(), but returns the JSON text preceded by `prefix` as bytes, for
+// storing it in a cell without copying it through intermediate strings.
+bytes print_to_bytes(const rjson::value& value, bytes_view prefix, size_t max_nested_level = default_max_nested_level);
+
 // Writes the JSON value to the output_stream, similar to print() -> string, but
 // directly. Note this has potentially more data copy overhead and should be 
 // reserved for larger values where not creating huge linear strings is useful.
@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/core/byteorder.hh>
+#include <boost/range/irange.hpp>
+#include <numeric>
+#include "utils/s3/block_cache.hh"
+#include "utils/crc.hh"
+#include "log.hh"
+
+namespace s3 {
+
+static logging::logger bcl("s3_block_cache");
+
+// The header of a slot, at its beginning, little endian:
+//   magic        u32
+//   header crc   u32, of the rest of the header, up to the end of the name
+//   block        u64
+//   data size    u32
+//   data crc     u32
+//   name size    u16
+//   name         name size bytes
+static constexpr uint32_t header_magic = 0x53334243; // "S3BC"
+static constexpr size_t header_fixed_size = 26;
+
+static uint32_t checksum(const char* p, size_t size) {
+    utils::crc32 c;
+    c.process(reinterpret_cast<const uint8_t*>(p), size);
+    return c.get();
+}
+
+size_t block_cache::key_hash::operator()(const key& k) const {
+    return std::hash<sstring>()(k.object_name) ^ std::hash<uint64_t>()(k.block);
+}
+
+block_cache::block_cache(std::filesystem::path path, uint64_t size)
+        : _path(std::move(path))
+        , _slots(size / slot_size)
+{
+    namespace sm = seastar::metrics;
+    _metrics.add_group("s3_block_cache", {
+        sm::make_counter("hits", sm::description("number of blocks read from the cache"), _stats.hits),
+        sm::make_counter("misses", sm::description("number of blocks not found in the cache"), _stats.misses),
+        sm::make_counter("inserts", sm::description("number of blocks written to the cache"), _stats.inserts),
+        sm::make_counter("evictions", sm::description("number of blocks evicted from the cache"), _stats.evictions),
+        sm::make_counter("invalid", sm::description("number of cached blocks which failed verification"), _stats.invalid),
+    });
+}
+
+future<> block_cache::start() {
+    if (_slots.empty()) {
+        bcl.warn("{}: cache size is smaller than a block, not caching", _path.native());
+        co_return;
+    }
+    _file = co_await open_file_dma(_path.native(), open_flags::rw | open_flags::create);
+    co_await _file.truncate(_slots.size() * slot_size);
+    bcl.info("{}: caching {} blocks of {} bytes", _path.native(), _slots.size(), block_size);
+    // Serve misses until the index is loaded, rather than delay the start
+    (void)load_index();
+}
+
+future<> block_cache::stop() {
+    co_await _gate.close();
+    if (_file) {
+        co_await _file.close();
+    }
+}
+
+future<> block_cache::load_index() {
+    auto holder = _gate.hold();
+    size_t loaded = 0;
+    try {
+        for (size_t idx = 0; idx < _slots.size() && !_gate.is_closed(); idx++) {
+            auto buf = co_await _file.dma_read<char>(slot_offset(idx), header_size);
+            auto& s = _slots[idx];
+            // Skip the slots claimed by put() while reading
+            if (s.k || s.busy || buf.size() < header_fixed_size) {
+                continue;
+            }
+            const char* p = buf.get();
+            auto name_size = read_le<uint16_t>(p + 24);
+            if (read_le<uint32_t>(p) != header_magic || name_size > header_size - header_fixed_size
+                    || read_le<uint32_t>(p + 4) != checksum(p + 8, header_fixed_size - 8 + name_size)) {
+                continue;
+            }
+            key k{sstring(p + header_fixed_size, name_size), read_le<uint64_t>(p + 8)};
+            if (_index.emplace(k, idx).second) {
+                s.k = std::move(k);
+                loaded++;
+            }
+        }
+    } catch (...) {
+        bcl.warn("{}: failed to load the index, after {} blocks: {}", _path.native(), loaded, std::current_exception());
+        co_return;
+    }
+    bcl.info("{}: loaded {} cached blocks", _path.native(), loaded);
+}
+
+std::optional<size_t> block_cache::claim_slot() {
+    for (size_t n = 0; n < 2 * _slots.size(); n++) {
+        auto idx = _hand;
+        _hand = (_hand + 1) % _slots.size();
+        auto& s = _slots[idx];
+        if (s.busy) {
+            continue;
+        }
+        if (s.referenced) {
+            s.referenced = false;
+            continue;
+        }
+        if (s.k) {
+            release_slot(idx);
+            _stats.evictions++;
+        }
+        return idx;
+    }
+    return std::nullopt;
+}
+
+void block_cache::release_slot(size_t idx) noexcept {
+    auto& s = _slots[idx];
+    if (s.k) {
+        _index.erase(*s.k);
+        s.k.reset();
+    }
+    s.referenced = false;
+    s.busy = false;
+}
+
+future<std::optional<temporary_buffer<char>>> block_cache::get(const sstring& object_name, uint64_t block) {
+    key k{object_name, block};
+    auto it = _index.find(k);
+    if (it == _index.end() || _slots[it->second].busy || _gate.is_closed()) {
+        _stats.misses++;
+        co_return std::nullopt;
+    }
+    auto idx = it->second;
+    _slots[idx].referenced = true;
+    auto holder = _gate.hold();
+
+    temporary_buffer<char> buf;
+    try {
+        buf = co_await _file.dma_read<char>(slot_offset(idx), slot_size);
+    } catch (...) {
+        bcl.warn("{}: failed to read block {} of {}: {}", _path.native(), block, object_name, std::current_exception());
+        _stats.misses++;
+        co_return std::nullopt;
+    }
+
+    // The slot may have been reused since, or the write of it torn
+    const char* p = buf.get();
+    auto valid = [&] {
+        if (buf.size() < header_size || read_le<uint32_t>(p) != header_magic) {
+            return false;
+        }
+        auto name_size = read_le<uint16_t>(p + 24);
+        auto data_size = read_le<uint32_t>(p + 16);
+        return name_size == object_name.size() && data_size <= block_size
+                && read_le<uint64_t>(p + 8) == block
+                && std::equal(object_name.begin(), object_name.end(), p + header_fixed_size)
+                && read_le<uint32_t>(p + 4) == checksum(p + 8, header_fixed_size - 8 + name_size)
+                && read_le<uint32_t>(p + 20) == checksum(p + header_size, std::min(data_size, uint32_t(buf.size() - header_size)));
+    };
+    if (!valid()) {
+        _stats.invalid++;
+        _stats.misses++;
+        if (_slots[idx].k == k && !_slots[idx].busy) {
+            release_slot(idx);
+        }
+        co_return std::nullopt;
+    }
+    _stats.hits++;
+    auto data_size = read_le<uint32_t>(p + 16);
+    buf.trim_front(header_size);
+    buf.trim(data_size);
+    co_return std::move(buf);
+}
+
+void block_cache::put(const sstring& object_name, uint64_t block, const temporary_buffer<char>& data) {
+    if (!_file || _gate.is_closed() || data.size() > block_size
+            || object_name.size() > header_size - header_fixed_size) {
+        return;
+    }
+    key k{object_name, block};
+    if (_index.contains(k)) {
+        return;
+    }
+    auto idx = claim_slot();
+    if (!idx) {
+        return;
+    }
+
+    auto buf = temporary_buffer<char>::aligned(_file.memory_dma_alignment(), slot_size);
+    std::fill_n(buf.get_write(), header_size, 0);
+    char* p = buf.get_write();
+    write_le<uint32_t>(p, header_magic);
+    write_le<uint64_t>(p + 8, block);
+    write_le<uint32_t>(p + 16, data.size());
+    write_le<uint32_t>(p + 20, checksum(data.get(), data.size()));
+    write_le<uint16_t>(p + 24, object_name.size());
+    std::copy(object_name.begin(), object_name.end(), p + header_fixed_size);
+    write_le<uint32_t>(p + 4, checksum(p + 8, header_fixed_size - 8 + object_name.size()));
+    std::copy_n(data.get(), data.size(), p + header_size);
+
+    auto& s = _slots[*idx];
+    s.busy = true;
+    s.k = k;
+    _index.emplace(std::move(k), *idx);
+
+    // Only write the header and data, rounded up to the disk's alignment
+    auto len = align_up(header_size + data.size(), _file.disk_write_dma_alignment());
+    (void)_file.dma_write(slot_offset(*idx), buf.get(), len).then_wrapped(
+            [this, idx = *idx, buf = std::move(buf), holder = _gate.hold()] (future<size_t> f) {
+        auto& s = _slots[idx];
+        if (f.failed()) {
+            bcl.warn("{}: failed to write block: {}", _path.native(), f.get_exception());
+            release_slot(idx);
+            return;
+        }
+        s.busy = false;
+        _stats.inserts++;
+    });
+}
+
+class cached_file : public file_impl {
+    file _remote;
+    sstring _object_name;
+    // Null for the duplicates, which read the object directly
+    block_cache* _cache;
+    std::optional<uint64_t> _size;
+
+    [[noreturn]] void unsupported() {
+        throw_with_backtrace<std::logic_error>("unsupported operation on cached s3 file");
+    }
+
+    class handle_impl final : public file_handle_impl {
+        file_handle _remote;
+        sstring _object_name;
+    public:
+        handle_impl(file_handle remote, sstring object_name)
+                : _remote(std::move(remote))
+                , _object_name(std::move(object_name))
+        {}
+
+        virtual std::unique_ptr<file_handle_impl> clone() const override {
+            return std::make_unique<handle_impl>(_remote, _object_name);
+        }
+
+        // The cache is shard-local, and the duplicates are for other shards
+        virtual shared_ptr<file_impl> to_file() && override {
+            return make_shared<cached_file>(_remote.to_file(), std::move(_object_name), nullptr);
+        }
+    };
+
+    future<uint64_t> object_size() {
+        if (!_size) {
+            _size = co_await _remote.size();
+        }
+        co_return *_size;
+    }
+
+    future<temporary_buffer<char>> read_block(uint64_t block) {
+        auto size = co_await object_size();
+        auto offset = block * block_cache::block_size;
+        if (offset >= size) {
+            co_return temporary_buffer<char>();
+        }
+        auto len = std::min<uint64_t>(block_cache::block_size, size - offset);
+        if (!_cache) {
+            co_return co_await _remote.dma_read_bulk<char>(offset, len);
+        }
+        if (auto buf = co_await _cache->get(_object_name, block)) {
+            co_return std::move(*buf);
+        }
+        auto buf = co_await _remote.dma_read_bulk<char>(offset, len);
+        _cache->put(_object_name, block, buf);
+        co_return buf;
+    }
+
+    // Reads [pos, pos + len), clipped to the object, with the cache's blocks
+    future<temporary_buffer<char>> read(uint64_t pos, size_t len) {
+        auto size = co_await object_size();
+        if (pos >= size) {
+            co_return temporary_buffer<char>();
+        }
+        len = std::min<uint64_t>(len, size - pos);
+        auto first = pos / block_cache::block_size;
+        auto last = (pos + len - 1) / block_cache::block_size;
+
+        if (first == last) {
+            auto buf = co_await read_block(first);
+            buf.trim_front(std::min(buf.size(), pos - first * block_cache::block_size));
+            buf.trim(std::min(buf.size(), len));
+            co_return buf;
+        }
+
+        std::vector<temporary_buffer<char>> blocks(last - first + 1);
+        co_await coroutine::parallel_for_each(boost::irange<uint64_t>(first, last + 1), [&] (uint64_t block) -> future<> {
+            blocks[block - first] = co_await read_block(block);
+        });
+        temporary_buffer<char> ret(len);
+        size_t copied = 0;
+        for (uint64_t block = first; block <= last && copied < len; block++) {
+            auto& b = blocks[block - first];
+            auto skip = std::min(b.size(), pos + copied - block * block_cache::block_size);
+            auto n = std::min(b.size() - skip, len - copied);
+            std::copy_n(b.get() + skip, n, ret.get_write() + copied);
+            copied += n;
+            if (b.size() < block_cache::block_size) {
+                break;
+            }
+        }
+        ret.trim(copied);
+        co_return ret;
+    }
+public:
+    cached_file(file remote, sstring object_name, block_cache* cache)
+            : _remote(std::move(remote))
+            , _object_name(std::move(object_name))
+            , _cache(cache)
+    {}
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, io_intent*) override { unsupported(); }
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override { unsupported(); }
+    virtual future<> truncate(uint64_t length) override { unsupported(); }
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override { unsupported(); }
+
+    virtual future<> flush(void) override { return make_ready_future<>(); }
+    virtual future<> allocate(uint64_t position, uint64_t length) override { return make_ready_future<>(); }
+    virtual future<> discard(uint64_t offset, uint64_t length) override { return make_ready_future<>(); }
+
+    virtual std::unique_ptr<file_handle_impl> dup() override {
+        return std::make_unique<handle_impl>(_remote.dup(), _object_name);
+    }
+
+    virtual future<uint64_t> size(void) override {
+        return object_size();
+    }
+
+    virtual future<struct stat> stat(void) override {
+        return _remote.stat();
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent*) override {
+        auto buf = co_await read(pos, len);
+        std::copy_n(buf.get(), buf.size(), reinterpret_cast<char*>(buffer));
+        co_return buf.size();
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override {
+        auto len = std::accumulate(iov.begin(), iov.end(), size_t(0), [] (size_t s, const iovec& v) { return s + v.iov_len; });
+        auto buf = co_await read(pos, len);
+        uint64_t off = 0;
+        for (auto& v : iov) {
+            auto sz = std::min(v.iov_len, buf.size() - off);
+            if (sz == 0) {
+                break;
+            }
+            std::copy_n(buf.get() + off, sz, reinterpret_cast<char*>(v.iov_base));
+            off += sz;
+        }
+        co_return off;
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent*) override {
+        auto buf = co_await read(offset, range_size);
+        co_return temporary_buffer<uint8_t>(reinterpret_cast<uint8_t*>(buf.get_write()), buf.size(), buf.release());
+    }
+
+    virtual future<> close() override {
+        return _remote.close();
+    }
+};
+
+file make_cached_file(file remote, sstring object_name, block_cache& cache) {
+    return file(make_shared<cached_file>(std::move(remote), std::move(object_name), &cache));
+}
+
+} // s3 namespace
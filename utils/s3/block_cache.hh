@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/file.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
+
+#include <filesystem>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+using namespace seastar;
+
+namespace s3 {
+
+/// A cache of fixed-size blocks of S3 objects, in a local file.
+///
+/// The cache file is divided into slots, each holding one block preceded by
+/// a header naming the block and checksumming it. A block is written with
+/// its header in a single write and verified on every read, so torn writes
+/// and slots reused by another block read as misses. This makes the cache
+/// safe across crashes without a separate index file: the in-memory index
+/// of the slots is rebuilt from their headers on start, in the background.
+///
+/// Slots are reused in clock order. Objects are assumed to be immutable,
+/// which sstable components on S3 are once written.
+class block_cache {
+public:
+    static constexpr size_t block_size = 128 * 1024;
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t inserts = 0;
+        uint64_t evictions = 0;
+        uint64_t invalid = 0;
+    };
+private:
+    static constexpr size_t header_size = 4096;
+    static constexpr size_t slot_size = header_size + block_size;
+
+    struct key {
+        sstring object_name;
+        uint64_t block;
+        bool operator==(const key&) const = default;
+    };
+    struct key_hash {
+        size_t operator()(const key& k) const;
+    };
+    struct slot {
+        std::optional<key> k;
+        // Whether it was read since the clock hand last passed it.
+        bool referenced = false;
+        // Whether it is being written. Reads of it miss.
+        bool busy = false;
+    };
+
+    std::filesystem::path _path;
+    file _file;
+    std::vector<slot> _slots;
+    // Maps the blocks to their slots, including those being written.
+    std::unordered_map<key, size_t, key_hash> _index;
+    size_t _hand = 0;
+    gate _gate;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+
+    future<> load_index();
+    std::optional<size_t> claim_slot();
+    void release_slot(size_t idx) noexcept;
+    uint64_t slot_offset(size_t idx) const noexcept {
+        return idx * slot_size;
+    }
+public:
+    /// \param path the cache file, created if it doesn't exist
+    /// \param size the size of the cache file, rounded down to whole slots
+    block_cache(std::filesystem::path path, uint64_t size);
+
+    future<> start();
+    future<> stop();
+
+    /// Returns the cached block of the object, or std::nullopt if it isn't cached.
+    future<std::optional<temporary_buffer<char>>> get(const sstring& object_name, uint64_t block);
+
+    /// Caches a block of the object, in the background. \p data must hold
+    /// block_size bytes, but for the last block of the object.
+    void put(const sstring& object_name, uint64_t block, const temporary_buffer<char>& data);
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
+
+/// Wraps \p remote, a file reading S3 object \p object_name, into a file
+/// serving reads from \p cache, and filling it with the blocks it misses.
+/// \p cache must outlive the file.
+file make_cached_file(file remote, sstring object_name, block_cache& cache);
+
+} // s3 namespace
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <deque>
 #include <memory>
 #include <rapidxml.h>
 #include <boost/algorithm/string/split.hpp>
@@ -14,6 +15,7 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/seastar.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_future.hh>
 #include <seastar/coroutine/all.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
@@ -316,6 +318,7 @@ class client::upload_sink_base : public data_sink_impl {
     sstring _upload_id;
     utils::chunked_vector<sstring> _part_etags;
     gate _bg_flushes;
+    semaphore _part_uploads;
 
     future<> start_upload();
     future<> finalize_upload();
@@ -331,6 +334,7 @@ class client::upload_sink_base : public data_sink_impl {
     upload_sink_base(shared_ptr<client> cln, sstring object_name)
         : _client(std::move(cln))
         , _object_name(std::move(object_name))
+        , _part_uploads(std::max(_client->_cfg->upload_part_concurrency, 1u))
     {
     }
 
@@ -483,6 +487,10 @@ future<> client::upload_sink_base::upload_part(memory_data_sink_buffers bufs) {
     //
     // In case part upload goes wrong and doesn't happen, the _part_etags[part]
     // is not set, so the finalize_upload() sees it and aborts the whole thing.
+    //
+    // The parts in flight hold their data in memory, so their number is
+    // bounded, making the writer wait for one of them to complete first.
+    auto units = co_await get_units(_part_uploads, 1);
     auto gh = _bg_flushes.hold();
     (void)_client->make_request(std::move(req), [this, part_number] (const http::reply& rep, input_stream<char>&& in_) mutable -> future<> {
         auto etag = rep.get_header("ETag");
@@ -492,7 +500,7 @@ future<> client::upload_sink_base::upload_part(memory_data_sink_buffers bufs) {
     }).handle_exception([this, part_number] (auto ex) {
         // ... the exact exception only remains in logs
         s3l.warn("couldn't upload part {}: {} (upload id {})", part_number, ex, _upload_id);
-    }).finally([gh = std::move(gh)] {});
+    }).finally([gh = std::move(gh), units = std::move(units)] {});
 }
 
 future<> client::upload_sink_base::abort_upload() {
@@ -541,9 +549,10 @@ class client::upload_sink final : public client::upload_sink_base {
     // https://docs.aws.amazon.com/AmazonS3/latest/API/API_UploadPart.html
     static constexpr size_t minimum_part_size = 5 << 20;
 
+    const size_t _part_size;
     memory_data_sink_buffers _bufs;
     future<> maybe_flush() {
-        if (_bufs.size() >= minimum_part_size) {
+        if (_bufs.size() >= _part_size) {
             co_await upload_part(std::move(_bufs));
         }
     }
@@ -551,6 +560,7 @@ class client::upload_sink final : public client::upload_sink_base {
 public:
     upload_sink(shared_ptr<client> cln, sstring object_name)
         : upload_sink_base(std::move(cln), std::move(object_name))
+        , _part_size(std::max(_client->_cfg->upload_part_size, minimum_part_size))
     {}
 
     virtual future<> put(temporary_buffer<char> buf) override {
@@ -684,11 +694,105 @@ data_sink client::make_upload_jumbo_sink(sstring object_name, std::optional<unsi
 class client::readable_file : public file_impl {
     shared_ptr<client> _client;
     sstring _object_name;
+    std::optional<uint64_t> _size;
+
+    // Ranges of the object recently fetched, or being fetched, which the
+    // reads falling within are served from rather than with a GET of their
+    // own. Small reads are rounded up to min_fetch_size, so that nearby ones
+    // share a GET, and sequential reads prefetch up to max_readahead bytes
+    // ahead of them, in GETs issued in parallel.
+    struct fetched_range {
+        uint64_t pos;
+        uint64_t len;
+        // Shorter than len if the GET failed, in which case readers refetch
+        // what they need themselves, and see the error if it persists
+        shared_future<lw_shared_ptr<temporary_buffer<char>>> data;
+    };
+    static constexpr size_t min_fetch_size = 64 * 1024;
+    static constexpr size_t max_readahead = 1024 * 1024;
+    static constexpr size_t max_fetched_ranges = 16;
+    std::deque<fetched_range> _fetched;
+    uint64_t _sequential_pos = 0;
+    size_t _readahead = 0;
 
     [[noreturn]] void unsupported() {
         throw_with_backtrace<std::logic_error>("unsupported operation on s3 readable file");
     }
 
+    future<uint64_t> object_size() {
+        if (!_size) {
+            _size = co_await _client->get_object_size(_object_name);
+        }
+        co_return *_size;
+    }
+
+    const fetched_range* find_fetched(uint64_t pos, uint64_t len) const noexcept {
+        for (auto& r : _fetched) {
+            if (r.pos <= pos && pos + len <= r.pos + r.len) {
+                return &r;
+            }
+        }
+        return nullptr;
+    }
+
+    const fetched_range& fetch(uint64_t pos, uint64_t len) {
+        auto f = _client->get_object_contiguous(_object_name, range{ pos, len }).then_wrapped([this, pos] (future<temporary_buffer<char>> f) {
+            if (f.failed()) {
+                s3l.debug("Failed to fetch {} at {}: {}", _object_name, pos, f.get_exception());
+                return make_lw_shared<temporary_buffer<char>>();
+            }
+            return make_lw_shared<temporary_buffer<char>>(f.get());
+        });
+        if (_fetched.size() == max_fetched_ranges) {
+            _fetched.pop_front();
+        }
+        _fetched.push_back(fetched_range{ pos, len, shared_future<lw_shared_ptr<temporary_buffer<char>>>(std::move(f)) });
+        return _fetched.back();
+    }
+
+    future<temporary_buffer<char>> read(uint64_t pos, size_t len) {
+        auto size = co_await object_size();
+        if (pos >= size) {
+            co_return temporary_buffer<char>();
+        }
+        len = std::min<uint64_t>(len, size - pos);
+
+        if (pos == _sequential_pos) {
+            _readahead = std::min(std::max(_readahead * 2, min_fetch_size), max_readahead);
+        } else {
+            _readahead = 0;
+        }
+        _sequential_pos = pos + len;
+
+        const fetched_range* r = find_fetched(pos, len);
+        if (!r) {
+            r = &fetch(pos, std::min<uint64_t>(std::max(len, min_fetch_size), size - pos));
+        }
+        auto data_pos = r->pos;
+        auto data_len = r->len;
+        auto data = r->data;
+
+        // Keep the object ahead of sequential reads fetched, in pieces of the
+        // size of the reads, which usually come from an input stream
+        auto ahead = pos + len;
+        auto ahead_end = std::min<uint64_t>(size, ahead + _readahead);
+        auto piece = std::max(len, min_fetch_size);
+        while (ahead < ahead_end) {
+            auto* next = find_fetched(ahead, 1);
+            if (!next) {
+                next = &fetch(ahead, std::min<uint64_t>(piece, size - ahead));
+            }
+            ahead = next->pos + next->len;
+        }
+
+        auto buf = co_await data.get_future();
+        if (buf->size() < pos - data_pos + len) {
+            std::erase_if(_fetched, [&] (const fetched_range& r) { return r.pos == data_pos && r.len == data_len; });
+            co_return co_await _client->get_object_contiguous(_object_name, range{ pos, len });
+        }
+        co_return buf->share(pos - data_pos, len);
+    }
+
 public:
     readable_file(shared_ptr<client> cln, sstring object_name)
         : _client(std::move(cln))
@@ -729,7 +833,7 @@ class client::readable_file : public file_impl {
     }
 
     virtual future<uint64_t> size(void) override {
-        return _client->get_object_size(_object_name);
+        return object_size();
     }
 
     virtual future<struct stat> stat(void) override {
@@ -747,13 +851,13 @@ class client::readable_file : public file_impl {
     }
 
     virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent*) override {
-        auto buf = co_await _client->get_object_contiguous(_object_name, range{ pos, len });
+        auto buf = co_await read(pos, len);
         std::copy_n(buf.get(), buf.size(), reinterpret_cast<uint8_t*>(buffer));
         co_return buf.size();
     }
 
     virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override {
-        auto buf = co_await _client->get_object_contiguous(_object_name, range{ pos, utils::iovec_len(iov) });
+        auto buf = co_await read(pos, utils::iovec_len(iov));
         uint64_t off = 0;
         for (auto& v : iov) {
             auto sz = std::min(v.iov_len, buf.size() - off);
@@ -767,7 +871,7 @@ class client::readable_file : public file_impl {
     }
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent*) override {
-        auto buf = co_await _client->get_object_contiguous(_object_name, range{ offset, range_size });
+        auto buf = co_await read(offset, range_size);
         co_return temporary_buffer<uint8_t>(reinterpret_cast<uint8_t*>(buf.get_write()), buf.size(), buf.release());
     }
 
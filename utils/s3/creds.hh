@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <seastar/core/shared_ptr.hh>
 
@@ -24,6 +25,13 @@ struct endpoint_config {
     };
 
     std::optional<aws_config> aws;
+
+    // Size of the parts of multipart uploads. S3 requires at least 5MiB.
+    size_t upload_part_size = 5 << 20;
+    // How many parts of an upload can be uploaded concurrently. Once that
+    // many are in flight, the writer waits, so an upload holds at most about
+    // upload_part_size * (upload_part_concurrency + 1) bytes of memory.
+    unsigned upload_part_concurrency = 8;
 };
 
 using endpoint_config_ptr = seastar::lw_shared_ptr<endpoint_config>;
@@ -55,6 +55,46 @@ class xx_hasher {
     }
 };
 
+// Same interface and digest format as xx_hasher, but using the XXH3 variant
+// of xxHash, which is considerably faster on the short inputs digests are
+// mostly fed with (keys, timestamps and the hashes of cells).
+class xxh3_hasher {
+    static constexpr size_t digest_size = 16;
+    XXH3_state_t _state;
+
+public:
+    explicit xxh3_hasher(uint64_t seed = 0) noexcept {
+        XXH3_64bits_reset_withSeed(&_state, seed);
+    }
+
+    void update(const char* ptr, size_t length) noexcept {
+        XXH3_64bits_update(&_state, ptr, length);
+    }
+
+    bytes finalize() {
+        bytes digest{bytes::initialized_later(), digest_size};
+        serialize_to(digest.begin());
+        return digest;
+    }
+
+    std::array<uint8_t, digest_size> finalize_array() {
+        std::array<uint8_t, digest_size> digest;
+        serialize_to(digest.begin());
+        return digest;
+    }
+
+    uint64_t finalize_uint64() {
+        return XXH3_64bits_digest(&_state);
+    }
+
+private:
+    template<typename OutIterator>
+    void serialize_to(OutIterator&& out) {
+        serialize_int64(out, 0);
+        serialize_int64(out, finalize_uint64());
+    }
+};
+
 // Used to specialize templates in order to fix a bug
 // in handling null values: #4567
 class legacy_xx_hasher_without_null_digest : public xx_hasher {
@@ -11,6 +11,7 @@
 #include "vint-serialization.hh"
 
 #include <seastar/core/bitops.hh>
+#include <seastar/core/byteorder.hh>
 
 #include <algorithm>
 #include <array>
@@ -68,19 +69,24 @@ static vint_size_type count_extra_bytes(int8_t first_byte) {
     return count_leading_zero_bits(static_cast<uint64_t>(~v)) - vint_size_type(64 - 8);
 }
 
+// Writes the value as one big-endian word carrying the length prefix, rather
+// than byte by byte.
 static void encode(uint64_t value, vint_size_type size, bytes::iterator out) {
-    std::array<int8_t, 9> buffer({});
-
-    // `size` is always in the range [1, 9].
+    // `size` is always in the range [2, 9].
     const auto extra_bytes_size = size - 1;
 
-    for (vint_size_type i = 0; i <= extra_bytes_size; ++i) {
-        buffer[extra_bytes_size - i] = static_cast<int8_t>(value & 0xff);
-        value >>= 8;
+    if (extra_bytes_size == 8) [[unlikely]] {
+        // The first byte is all prefix, the value follows it.
+        *out++ = static_cast<int8_t>(0xff);
+        value = cpu_to_be(value);
+        std::copy_n(reinterpret_cast<const int8_t*>(&value), sizeof(value), out);
+        return;
     }
 
-    buffer[0] |= ~first_byte_value_mask(extra_bytes_size);
-    std::copy_n(buffer.cbegin(), size, out);
+    // The value fits below the sentinel zero bit of the first byte.
+    value |= (~first_byte_value_mask(extra_bytes_size) & 0xff) << (extra_bytes_size * 8);
+    value = cpu_to_be(value << (64 - size * 8));
+    std::copy_n(reinterpret_cast<const int8_t*>(&value), size, out);
 }
 
 vint_size_type unsigned_vint::serialize(uint64_t value, bytes::iterator out) {
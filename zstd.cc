@@ -12,19 +12,87 @@
 // which are available only when the library is linked statically.
 #define ZSTD_STATIC_LINKING_ONLY
 #include "zstd.h"
+#include "zdict.h"
 
 #include "compress.hh"
+#include "log.hh"
 #include "utils/class_registrator.hh"
 #include "utils/reusable_buffer.hh"
 #include <concepts>
+#include <unordered_map>
+
+static logging::logger zstdlog("zstd");
 
 static const sstring COMPRESSION_LEVEL = "compression_level";
+// Not settable by users: only present in the options of compressors returned
+// by with_dictionary(), and thus in the CompressionInfo of sstables
+// written with them. Holds the raw dictionary.
+static const sstring DICTIONARY = "dictionary";
 static const sstring COMPRESSOR_NAME = compressor::namespace_prefix + "ZstdCompressor";
 static const size_t DCTX_SIZE = ZSTD_estimateDCtxSize();
 
+// The dictionary is stored as a CompressionInfo option, whose value is
+// limited to 64 KiB. Small dictionaries are also the most useful ones,
+// as they are meant for small chunks.
+static constexpr size_t MAX_DICTIONARY_SIZE = 16 * 1024;
+
+// Digested forms of a dictionary, shared by all zstd_processor instances
+// of a shard using the same dictionary. Sstable readers create a compressor
+// for every data source they open, so digesting the dictionary each time
+// would be prohibitive.
+class zstd_dictionary {
+    sstring _raw;
+    ZSTD_DDict* _ddict = nullptr;
+    std::unordered_map<int, ZSTD_CDict*> _cdicts; // by compression level
+public:
+    explicit zstd_dictionary(sstring raw) : _raw(std::move(raw)) {}
+    zstd_dictionary(const zstd_dictionary&) = delete;
+    ~zstd_dictionary() {
+        ZSTD_freeDDict(_ddict);
+        for (auto& [level, cdict] : _cdicts) {
+            ZSTD_freeCDict(cdict);
+        }
+    }
+    const sstring& raw() const { return _raw; }
+    const ZSTD_DDict* ddict() {
+        if (!_ddict) {
+            _ddict = ZSTD_createDDict(_raw.data(), _raw.size());
+            if (!_ddict) {
+                throw std::runtime_error("Unable to create ZSTD decompression dictionary");
+            }
+        }
+        return _ddict;
+    }
+    const ZSTD_CDict* cdict(int level, const ZSTD_compressionParameters& cparams) {
+        auto& cdict = _cdicts[level];
+        if (!cdict) {
+            cdict = ZSTD_createCDict_advanced(_raw.data(), _raw.size(), ZSTD_dlm_byCopy, ZSTD_dct_auto, cparams, ZSTD_defaultCMem);
+            if (!cdict) {
+                _cdicts.erase(level);
+                throw std::runtime_error("Unable to create ZSTD compression dictionary");
+            }
+        }
+        return cdict;
+    }
+
+    static lw_shared_ptr<zstd_dictionary> get(const sstring& raw) {
+        static thread_local std::unordered_map<sstring, lw_shared_ptr<zstd_dictionary>> cache;
+        auto it = cache.find(raw);
+        if (it != cache.end()) {
+            return it->second;
+        }
+        // Drop the dictionaries which are not used by any compressor anymore.
+        std::erase_if(cache, [] (auto& e) { return e.second.use_count() == 1; });
+        return cache.emplace(raw, make_lw_shared<zstd_dictionary>(raw)).first->second;
+    }
+};
+
 class zstd_processor : public compressor {
     int _compression_level = 3;
     size_t _cctx_size;
+    int32_t _chunk_len;
+    ZSTD_compressionParameters _cparams;
+    lw_shared_ptr<zstd_dictionary> _dict;
 
     static auto with_dctx(std::invocable<ZSTD_DCtx*> auto f) {
         // The decompression context has a fixed size of ~128 KiB,
@@ -73,6 +141,7 @@ class zstd_processor : public compressor {
 
 public:
     zstd_processor(const opt_getter&);
+    zstd_processor(const zstd_processor& base, sstring dictionary);
 
     size_t uncompress(const char* input, size_t input_len, char* output,
                     size_t output_len) const override;
@@ -82,6 +151,10 @@ class zstd_processor : public compressor {
 
     std::set<sstring> option_names() const override;
     std::map<sstring, sstring> options() const override;
+
+    bool supports_dictionary() const override;
+    std::optional<sstring> train_dictionary(const std::vector<sstring>& samples) const override;
+    ptr_type with_dictionary(sstring dictionary) const override;
 };
 
 zstd_processor::zstd_processor(const opt_getter& opts)
@@ -107,19 +180,37 @@ zstd_processor::zstd_processor(const opt_getter& opts)
     if (!chunk_len_kb) {
         chunk_len_kb = opts(compression_parameters::CHUNK_LENGTH_KB_ERR);
     }
-    auto chunk_len = chunk_len_kb
+    _chunk_len = chunk_len_kb
        // This parameter has already been validated.
        ? std::stoi(*chunk_len_kb) * 1024
        : compression_parameters::DEFAULT_CHUNK_LENGTH;
 
+    auto dictionary = opts(DICTIONARY);
+    if (dictionary) {
+        _dict = zstd_dictionary::get(*dictionary);
+    }
+
     // We assume that the uncompressed input length is always <= chunk_len.
-    auto cparams = ZSTD_getCParams(_compression_level, chunk_len, 0);
-    _cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams);
+    _cparams = ZSTD_getCParams(_compression_level, _chunk_len, _dict ? _dict->raw().size() : 0);
+    _cctx_size = ZSTD_estimateCCtxSize_usingCParams(_cparams);
+
+}
 
+zstd_processor::zstd_processor(const zstd_processor& base, sstring dictionary)
+    : compressor(COMPRESSOR_NAME)
+    , _compression_level(base._compression_level)
+    , _chunk_len(base._chunk_len)
+    , _dict(zstd_dictionary::get(dictionary))
+{
+    _cparams = ZSTD_getCParams(_compression_level, _chunk_len, _dict->raw().size());
+    _cctx_size = ZSTD_estimateCCtxSize_usingCParams(_cparams);
 }
 
 size_t zstd_processor::uncompress(const char* input, size_t input_len, char* output, size_t output_len) const {
     auto ret = with_dctx([&] (ZSTD_DCtx* dctx) {
+        if (_dict) {
+            return ZSTD_decompress_usingDDict(dctx, output, output_len, input, input_len, _dict->ddict());
+        }
         return ZSTD_decompressDCtx(dctx, output, output_len, input, input_len);
     });
     if (ZSTD_isError(ret)) {
@@ -131,6 +222,9 @@ size_t zstd_processor::uncompress(const char* input, size_t input_len, char* out
 
 size_t zstd_processor::compress(const char* input, size_t input_len, char* output, size_t output_len) const {
     auto ret = with_cctx(_cctx_size, [&] (ZSTD_CCtx* cctx) {
+        if (_dict) {
+            return ZSTD_compress_usingCDict(cctx, output, output_len, input, input_len, _dict->cdict(_compression_level, _cparams));
+        }
         return ZSTD_compressCCtx(cctx, output, output_len, input, input_len, _compression_level);
     });
     if (ZSTD_isError(ret)) {
@@ -148,7 +242,37 @@ std::set<sstring> zstd_processor::option_names() const {
 }
 
 std::map<sstring, sstring> zstd_processor::options() const {
-    return {{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    std::map<sstring, sstring> opts{{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    if (_dict) {
+        opts.emplace(DICTIONARY, _dict->raw());
+    }
+    return opts;
+}
+
+bool zstd_processor::supports_dictionary() const {
+    return true;
+}
+
+std::optional<sstring> zstd_processor::train_dictionary(const std::vector<sstring>& samples) const {
+    std::vector<char> samples_buffer;
+    std::vector<size_t> sample_sizes;
+    for (auto& s : samples) {
+        samples_buffer.insert(samples_buffer.end(), s.begin(), s.end());
+        sample_sizes.push_back(s.size());
+    }
+    sstring dictionary(sstring::initialized_later(), MAX_DICTIONARY_SIZE);
+    auto size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples_buffer.data(), sample_sizes.data(), sample_sizes.size());
+    if (ZDICT_isError(size)) {
+        // Typically means there were too few samples, or they were not compressible.
+        zstdlog.debug("Failed to train dictionary from {} samples: {}", samples.size(), ZDICT_getErrorName(size));
+        return std::nullopt;
+    }
+    dictionary.resize(size);
+    return dictionary;
+}
+
+compressor::ptr_type zstd_processor::with_dictionary(sstring dictionary) const {
+    return seastar::make_shared<zstd_processor>(*this, std::move(dictionary));
 }
 
 static const class_registrator<compressor, zstd_processor, const compressor::opt_getter&>